@@ -39,6 +39,17 @@ MsgRange::MsgRange(const QDateTime& inFrom, const QDateTime& inTo) :
     m_to(inTo)
 {
 
+}
+//-----------------------------------------------------------------------------
+// MsgCursor
+//-----------------------------------------------------------------------------
+MsgCursor::MsgCursor(const QDateTime& inTime, const eMsgPageDirection inDirection, const std::size_t inLimit, const QUuid& inMessageUUID) :
+    m_time(inTime),
+    m_message(inMessageUUID),
+    m_direction(inDirection),
+    m_limit(inLimit)
+{
+
 }
 //-----------------------------------------------------------------------------
 // HMGroupInfoMessage
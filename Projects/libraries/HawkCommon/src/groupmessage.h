@@ -6,6 +6,8 @@
  * @brief Содержит описание сообщения группы
  */
 
+#include <cstddef>
+
 #include <QUuid>
 #include <QString>
 #include <QDateTime>
@@ -89,6 +91,48 @@ struct MsgRange
     QDateTime m_to;     ///< Окончание временного промежутка
 };
 //-----------------------------------------------------------------------------
+/**
+ * @brief The eMsgPageDirection enum - Перечень направлений выборки страницы сообщений
+ */
+enum class eMsgPageDirection
+{
+    pdBefore,           ///< Сообщения, предшествующие курсору
+    pdAfter,            ///< Сообщения, следующие за курсором
+
+    pdCount
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The MsgCursor struct - Структура, описывающая курсор постраничной выборки сообщений
+ * Сообщения упорядочены по паре {время создания, строковое представление UUID}.
+ * Позиция курсора в выборку не входит, поэтому курсор по времени с пустым UUID
+ * включает сообщения с этим временем при выборке "после" и исключает при выборке "до".
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+struct MsgCursor
+{
+    /**
+     * @brief MsgCursor - Инициализирующий конструктор
+     * @param inTime - Время позиции курсора
+     * @param inDirection - Направление выборки
+     * @param inLimit - Максимальное количество сообщений на странице
+     * @param inMessageUUID - UUID сообщения позиции курсора (пустой для курсора по времени)
+     */
+    MsgCursor(const QDateTime& inTime, const eMsgPageDirection inDirection, const std::size_t inLimit, const QUuid& inMessageUUID = QUuid());
+
+    /**
+     * @brief ~MsgCursor - Деструктор по умолчанию
+     */
+    ~MsgCursor() = default;
+
+    QDateTime m_time;                   ///< Время позиции курсора
+    QUuid m_message;                    ///< UUID сообщения позиции курсора
+    eMsgPageDirection m_direction;      ///< Направление выборки
+    std::size_t m_limit;                ///< Максимальное количество сообщений на странице
+};
+//-----------------------------------------------------------------------------
 /**
  * @brief The HMGroupInfoMessage class - Класс, описывающий сообщение группы
  *
@@ -61,6 +61,8 @@ std::string DataStorageErrorCategory::message(int inCode) const
         case eDataStorageError::dsMessageTypeCorrupted:             { Result = "Тип сообщения повреждён"; break; }
         case eDataStorageError::dsMessageDataCorrupted:             { Result = "Данные сообщения повреждены"; break; }
 
+        case eDataStorageError::dsTransactionNotStarted:            { Result = "Транзакция не начата"; break; }
+
         default: Result = C_ERROR_UNKNOWN_TEXT + std::to_string(inCode);
     }
 
@@ -65,6 +65,9 @@ enum class eDataStorageError
     dsMessageTypeCorrupted,                         ///< Тип сообщения повреждён
     dsMessageDataCorrupted,                         ///< Данные сообщения повреждены
 
+    // Транзакции
+    dsTransactionNotStarted,                        ///< Транзакция не начата (или уже отменена)
+
     dsCount                                         ///< Количество
 };
 //-----------------------------------------------------------------------------
@@ -27,6 +27,12 @@ std::string NetErrorCategory::message(int inCode) const
         case eNetError::neClientNotFound:                       { Result = "Указанный клиент не найден"; break; }
         case eNetError::neClientIdAlredyExists:                 { Result = "Клиент с таким ID уже существует"; break; }
         case eNetError::neCreateConnectionFail:                 { Result = "Не удалось установить соединение"; break; }
+        case eNetError::neInvalidFrame:                         { Result = "Принят повреждённый заголовок кадра"; break; }
+        case eNetError::neFrameTooLarge:                        { Result = "Длина кадра превышает допустимую"; break; }
+        case eNetError::neSendQueueFull:                        { Result = "Очередь отправки соединения переполнена"; break; }
+        case eNetError::neCompressionError:                     { Result = "Ошибка сжатия или распаковки кадра"; break; }
+        case eNetError::neIdleTimeout:                          { Result = "Соединение разорвано по простою"; break; }
+        case eNetError::neRateLimited:                          { Result = "Входящие кадры превысили предел частоты"; break; }
 
         // Qt Implementation
 
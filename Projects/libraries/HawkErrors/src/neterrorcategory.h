@@ -29,6 +29,12 @@ enum class eNetError
     neClientNotFound,                               ///< Указанный клиент не найден
     neClientIdAlredyExists,                         ///< Клиент с таким ID уже существует
     neCreateConnectionFail,                         ///< Не удалось установить соединение
+    neInvalidFrame,                                 ///< Принят повреждённый заголовок кадра
+    neFrameTooLarge,                                ///< Длина кадра превышает допустимую
+    neSendQueueFull,                                ///< Очередь отправки соединения переполнена
+    neCompressionError,                             ///< Ошибка сжатия или распаковки кадра
+    neIdleTimeout,                                  ///< Соединение разорвано по простою
+    neRateLimited,                                  ///< Входящие кадры превысили предел частоты
 
     // Qt Implementation
     neUnknownQtSocketError,                         ///< Неизвестная ошибка QtSocket
@@ -7,6 +7,7 @@
  */
 
 #include <atomic>
+#include <memory>
 
 #include "Interface/connection.h"
 
@@ -45,6 +46,14 @@ public:
      */
     std::size_t getID() const;
 
+    /**
+     * @brief retire - Метод разорвёт снятое с учёта соединение и освободит последнюю ссылку на него
+     * Разрыв не ожидается: ссылка освобождается в потоке соединения после обработки текущего события,
+     * поэтому сервер может снимать соединение с учёта прямо из его обработчиков.
+     * @param inSelf - Последняя ссылка на это соединение
+     */
+    virtual void retire(std::shared_ptr<HMAbstractConnection>&& inSelf) = 0;
+
 private:
 
     std::atomic<std::size_t> m_id; ///< Уникальный идентификатор соединения
@@ -1,35 +1,19 @@
 #include "abstractserver.h"
 
-#include <algorithm>
-#include <functional>
+#include <vector>
 
 #include <neterrorcategory.h>
 
 using namespace net;
 
-//-----------------------------------------------------------------------------
-HMAbstractServer::HMAbstractServer()
-{
-    m_threadControl.start();
-    m_deleterThread = std::thread(std::bind(&HMAbstractServer::deleteConnectionThread, this)); // Запускаем удаляющий соединения поток
-}
-//-----------------------------------------------------------------------------
-HMAbstractServer::~HMAbstractServer()
-{
-    m_threadControl.stop();
-    if (m_deleterThread.joinable())
-        m_deleterThread.join(); // Ожидаем заверешния потока
-}
 //-----------------------------------------------------------------------------
 bool HMAbstractServer::connected(const std::size_t inID) const
 {
-    std::lock_guard lg(m_clientsDefender);
-    return m_clients.find(inID) != m_clients.end();
+    return m_clients.find(inID) != nullptr;
 }
 //-----------------------------------------------------------------------------
 std::size_t HMAbstractServer::connectionCount() const
 {
-    std::lock_guard lg(m_clientsDefender);
     return m_clients.size();
 }
 //-----------------------------------------------------------------------------
@@ -38,57 +22,63 @@ errors::error_code HMAbstractServer::changeConnectionID(const std::size_t inCurr
     errors::error_code Error = make_error_code(errors::eNetError::neSuccess);
 
     if (inCurrentID != inNewID) // Нет смысла заменять если ID одинаковые
-    {
-        std::lock_guard lg(m_clientsDefender);
-        auto Node = m_clients.extract(inCurrentID); // Извлекаем из контенера ноду { ключ, значение(соединение) }
-
-        if (Node.empty()) // Если не удалось найти ноду по ключу
-            Error = make_error_code(errors::eNetError::neClientNotFound);
-        else // Нода успешно найдена
-        {
-            Node.key() = inNewID; // Заменяем ключ ноды
-            auto InsertRes = m_clients.insert(std::move(Node)); // И пытаемся проталкнуть её обратно в контейнер
-
-            if (!InsertRes.inserted) // Если при вставке произошло столкновение по ключам
-            {
-                Error = make_error_code(errors::eNetError::neClientIdAlredyExists); // Взводим признак ошибки
-                InsertRes.node.key() = inCurrentID; // Возвращаем ноде прежний ключ
-                m_clients.insert(std::move(InsertRes.node)); // Возвращаем её на прежнее место
-            }
-            else // Нода с новым ID успешно добавилась в контенер
-                InsertRes.position->second->setID(inNewID); // Меняем идентификатор самого соединения
-        }
-    }
+        Error = m_clients.rename(inCurrentID, inNewID);
 
     return Error;
 }
 //-----------------------------------------------------------------------------
-errors::error_code HMAbstractServer::send(const size_t inID, oByteStream&& inData)
+errors::error_code HMAbstractServer::send(const size_t inID, HMByteBuffer&& inData)
 {
     errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
-    std::lock_guard lg(m_clientsDefender);
+    std::shared_ptr<HMAbstractConnection> Connection = findConnection(inID); // Ищим клиента
 
-    auto FindRes = m_clients.find(inID); // Ищим клиента
+    if (!Connection) // Клиент не найден
+        Error = make_error_code(errors::eNetError::neClientNotFound);
+    else // Клиент найден
+        Error = Connection->send(std::move(inData)); // Отправляем данные без блокировки контейнера
 
-    if (FindRes == m_clients.end()) // Клиент не найден
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractServer::request(const std::size_t inID, HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                             const std::chrono::milliseconds inTimeout)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    std::shared_ptr<HMAbstractConnection> Connection = findConnection(inID); // Ищим клиента
+
+    if (!Connection) // Клиент не найден
         Error = make_error_code(errors::eNetError::neClientNotFound);
     else // Клиент найден
-        Error = FindRes->second->send(std::move(inData)); // Отправляем данные
+        Error = Connection->request(std::move(inData), std::move(inCallback), inTimeout);
 
     return Error;
 }
 //-----------------------------------------------------------------------------
-std::map<std::size_t, errors::error_code> HMAbstractServer::sendToAll(oByteStream&& inData)
+errors::error_code HMAbstractServer::respond(const std::size_t inID, const std::uint32_t inRequestID, HMByteBuffer&& inData)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    std::shared_ptr<HMAbstractConnection> Connection = findConnection(inID); // Ищим клиента
+
+    if (!Connection) // Клиент не найден
+        Error = make_error_code(errors::eNetError::neClientNotFound);
+    else // Клиент найден
+        Error = Connection->respond(inRequestID, std::move(inData));
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::map<std::size_t, errors::error_code> HMAbstractServer::sendToAll(HMByteBuffer&& inData)
 {
     std::map<std::size_t, errors::error_code> Result;
-    std::lock_guard lg(m_clientsDefender);
+    const SharedPayload Payload = std::make_shared<const HMByteBuffer>(std::move(inData)); // Данные переходят всем получателям без копирования
+    const std::vector<std::shared_ptr<HMAbstractConnection>> Recipients = m_clients.snapshot(); // Под блокировками только копируем указатели
 
-    for (auto& ConnectionPair : m_clients)
+    for (const auto& Connection : Recipients)
     {
-        errors::error_code Error = ConnectionPair.second->send(oByteStream(inData.str())); // Отправляем копию данных клиенту
+        errors::error_code Error = Connection->sendShared(Payload); // Очередь клиента ссылается на общие данные
 
         if (Error) // Ошибку добавляем в перечень ошибок
-            Result.insert(std::make_pair(ConnectionPair.second->getID(), Error));
+            Result.insert(std::make_pair(Connection->getID(), Error));
     }
 
     return Result;
@@ -97,103 +87,121 @@ std::map<std::size_t, errors::error_code> HMAbstractServer::sendToAll(oByteStrea
 void HMAbstractServer::closeConnection(const size_t inID)
 {
     /*
-     * Есть 3 возможных сценария попадания в этот метод:
-     * 1) Вызов из вне
-     * 2) Вызов из closeAllConnections
-     * 3) Вызов из onDisconnect
-     *
-     * При удалении соединения есть побочный эффект:
-     *  - closeConnection удаляет соединение из контейнера
-     *  - срабатывает деструктор соединения, вызывающий disconnect
-     *  - происходит событие onDisconnect, который вызывает closeConnection
-     * В итоге чего происходит дедлок при создании std::lock_guard.
-     *
-     * Решением данной проблемы стал рекурсивный мьютекс.
-     * Он позволяет произойти повторному входу в closeConnection, во
-     * время которого m_clients.find(inID) уже не сможет вернуть
-     * валидный итератор и выполнение прекратится.
-     *
-     * НО! Рекурсивный мьютекс гарантирует повторный доступ к блокировке
-     * для потока, который уже его заблокировал. В случай QtServer\QtSocket
-     * имею подозрения в небезопасности такого решения в силу того, что
-     * сигнал disconnected вызовет слот в главном потоке самого приложения,
-     * что может привести к ситуации когда одновременно будет вызван closeConnection
-     * в рамках одного потока, что может привести к краху на доступе к инвалидированным
-     * итераторам контейнера соединений.
-     * TODO: Проверить надёжность, возможно поменять решение.
-     *
-     * А может дело в том что уже первый час ночи и я реально верю что один поток
-     * одновременно может быть в разных местах...
+     * Разрыв извлечённого соединения вызывает onDisconnect, а тот - повторно closeConnection.
+     * Соединение извлекается и разрывается при снятой блокировке, поэтому повторный вход
+     * просто не найдёт его в реестре.
      */
+    std::shared_ptr<HMAbstractConnection> Connection = m_clients.extract(inID); // Извлекаем соединение из реестра
 
-    ClientsContainer::node_type Node; // Формируем пустую ноду
-
-    {
-        std::lock_guard lg(m_clientsDefender);
-        Node = m_clients.extract(inID); // Извлекаем ноду из контейнера соединений
-    }
-
-    if (!Node.empty()) // Если по указанному ключу существовали данные
-        deleteConnection(std::move(Node.mapped())); // Отправляем соединение на удаление
-    // А пустая нода будет уничтожена
+    if (Connection) // Соединение разорвётся и освободится в своём потоке, без ожидания
+        Connection->retire(std::move(Connection));
 }
 //-----------------------------------------------------------------------------
 void HMAbstractServer::closeAllConnections()
 {
-    if (m_clients.empty())
-        return;
-
-    std::vector<std::size_t> IDs(connectionCount()); // Список ключей
-
-    {
-        std::lock_guard lg(m_clientsDefender);
-        std::transform(m_clients.begin(), m_clients.end(), IDs.begin(), [](const auto& inPair){ return inPair.first; }); // Получам список ключей
-    }
+    for (auto& Connection : m_clients.extractAll()) // Забираем все соединения разом и разрываем каждое вне блокировки
+        Connection->retire(std::move(Connection));
+}
+//-----------------------------------------------------------------------------
+void HMAbstractServer::setSendQueueLimits(const SendQueueLimits& inLimits)
+{
+    std::lock_guard lg(m_sendLimitsDefender); // Соединение, добавленное параллельно, не получит устаревшие пределы
+    m_sendLimits = inLimits;
 
-    for (const std::size_t& ID : IDs) // Перебираем все соединения
-        closeConnection(ID); // Закрываем каждое
+    m_clients.forEach([&inLimits](const std::shared_ptr<HMAbstractConnection>& inConnection) // Уже подключённым соединениям пределы меняем сразу
+    { inConnection->setSendQueueLimits(inLimits); });
 }
 //-----------------------------------------------------------------------------
-std::size_t HMAbstractServer::onNewConnection(std::unique_ptr<HMAbstractConnection>&& inConnection)
+void HMAbstractServer::setCompression(const CompressionSettings& inSettings)
 {
-    if (!inConnection)
-        return 0;
+    std::lock_guard lg(m_sendLimitsDefender); // Соединение, добавленное параллельно, не получит устаревшие настройки
+    m_compression = inSettings;
 
-    while(connected(inConnection->getID())) // Если идентификатор занят
-        inConnection->setID(inConnection->getID() + 1); // Подменяем идентификатор
+    m_clients.forEach([&inSettings](const std::shared_ptr<HMAbstractConnection>& inConnection)
+    { inConnection->setCompression(inSettings); });
+}
+//-----------------------------------------------------------------------------
+void HMAbstractServer::setHeartbeat(const HeartbeatSettings& inSettings)
+{
+    std::lock_guard lg(m_sendLimitsDefender); // Соединение, добавленное параллельно, не получит устаревшие настройки
+    m_heartbeat = inSettings;
 
-    std::lock_guard lg(m_clientsDefender);
-    auto InsertRes = m_clients.insert(std::make_pair(inConnection->getID(), std::move(inConnection))); // Помещаем в контейнер нового клиента
+    m_clients.forEach([&inSettings](const std::shared_ptr<HMAbstractConnection>& inConnection)
+    { inConnection->setHeartbeat(inSettings); });
+}
+//-----------------------------------------------------------------------------
+void HMAbstractServer::setRateLimits(const RateLimits& inLimits)
+{
+    std::lock_guard lg(m_sendLimitsDefender); // Соединение, добавленное параллельно, не получит устаревшие пределы
+    m_rateLimits = inLimits;
 
-    return (InsertRes.second) ? InsertRes.first->first : 0;
+    m_clients.forEach([&inLimits](const std::shared_ptr<HMAbstractConnection>& inConnection)
+    { inConnection->setRateLimits(inLimits); });
 }
 //-----------------------------------------------------------------------------
-void HMAbstractServer::onDisconnect(const size_t inConnectionID)
+void HMAbstractServer::setAcceptLimits(const AcceptLimits& inLimits)
 {
-    closeConnection(inConnectionID);
+    m_acceptBucket.configure(inLimits.m_connectionsPerSecond, inLimits.m_burst);
 }
 //-----------------------------------------------------------------------------
-void HMAbstractServer::deleteConnection(std::unique_ptr<HMAbstractConnection>&& inConnection)
+ServerStats HMAbstractServer::stats() const
 {
-    inConnection->disconnect(); // Разрываем соединение
-    std::lock_guard lg(m_m_deletingClientsDefender);
-    m_deletingClients.emplace_back(std::move(inConnection)); // Помещаем на удаление
+    ServerStats Result;
+    Result.m_acceptedConnections = m_acceptedConnections;
+    Result.m_rejectedConnections = m_rejectedConnections;
+
+    return Result;
 }
 //-----------------------------------------------------------------------------
-void HMAbstractServer::deleteConnectionThread()
+errors::error_code HMAbstractServer::connectionStats(const std::size_t inID, ConnectionStats& outStats) const
 {
-    while (m_threadControl.doWork())
-    {
-        {
-            std::lock_guard lg(m_m_deletingClientsDefender);
-            // Произведём "сортировку" на удаление
-            auto RemoveStartIt = std::remove_if(m_deletingClients.begin(), m_deletingClients.end(), [](const std::unique_ptr<HMAbstractConnection>& Connection)
-            { return (Connection) ? Connection->status() == eConnectionStatus::csDisconnected : false; }); // Удаляем только соединения, полностью разорвавшие соединения
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    std::shared_ptr<HMAbstractConnection> Connection = findConnection(inID); // Ищим клиента
 
-            m_deletingClients.erase(RemoveStartIt, m_deletingClients.end()); // Удалим с полученной позиции до конца
-        }
+    if (!Connection) // Клиент не найден
+        Error = make_error_code(errors::eNetError::neClientNotFound);
+    else // Клиент найден
+        outStats = Connection->stats();
 
-        m_threadControl.wait_for(std::chrono::seconds(5));
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMAbstractServer::onNewConnection(std::unique_ptr<HMAbstractConnection>&& inConnection)
+{
+    std::size_t Result = 0;
+
+    if (inConnection)
+    {
+        std::lock_guard lg(m_sendLimitsDefender);
+        inConnection->setSendQueueLimits(m_sendLimits); // Соединение получает пределы до того, как ему станут отправлять данные
+        inConnection->setCompression(m_compression);
+        inConnection->setHeartbeat(m_heartbeat);
+        inConnection->setRateLimits(m_rateLimits);
+        Result = m_clients.insert(std::shared_ptr<HMAbstractConnection>(std::move(inConnection))); // Реестр присвоит соединению идентификатор
     }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractServer::admitConnection()
+{
+    const bool Result = m_acceptBucket.tryTake(1);
+
+    if (Result)
+        ++m_acceptedConnections;
+    else
+        ++m_rejectedConnections;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractServer::onDisconnect(const size_t inConnectionID)
+{
+    closeConnection(inConnectionID);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMAbstractConnection> HMAbstractServer::findConnection(const std::size_t inID) const
+{
+    return m_clients.find(inID);
 }
 //-----------------------------------------------------------------------------
@@ -6,16 +6,13 @@
  * @brief Содержит описание абстрактного сервера
  */
 
-#include <set>
-#include <list>
 #include <mutex>
-#include <thread>
-#include <unordered_map>
-
-#include <threadwaitcontrol.h>
+#include <atomic>
 
 #include "Interface/server.h"
 #include "Abstract/abstractconnection.h"
+#include "Abstract/connectionregistry.h"
+#include "Abstract/tokenbucket.h"
 
 namespace net
 {
@@ -33,12 +30,12 @@ public:
     /**
      * @brief HMAbstractServer - Конструктор по умолчанию
      */
-    HMAbstractServer();
+    HMAbstractServer() = default;
 
     /**
-     * @brief ~HMAbstractServer - Виртуальный деструктор
+     * @brief ~HMAbstractServer - Виртуальный деструктор по умолчанию
      */
-    virtual ~HMAbstractServer() override;
+    virtual ~HMAbstractServer() override = default;
 
     /**
      * @brief connected - Метод проверит наличие соединения
@@ -67,14 +64,34 @@ public:
      * @param inData - Отправляемые данные
      * @return Вернёт признак ошибки
      */
-    virtual errors::error_code send(const size_t inID, oByteStream&& inData) override;
+    virtual errors::error_code send(const size_t inID, HMByteBuffer&& inData) override;
+
+    /**
+     * @brief request - Метод отправит запрос клиенту с указанным идентификатором
+     * @param inID - Идентификатор клиента-получателя
+     * @param inData - Данные запроса
+     * @param inCallback - Обработчик ответа (вызывается ровно один раз, если запрос принят к отправке)
+     * @param inTimeout - Время ожидания ответа
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code request(const std::size_t inID, HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                       const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) override;
+
+    /**
+     * @brief respond - Метод отправит ответ на запрос клиента с указанным идентификатором
+     * @param inID - Идентификатор клиента, приславшего запрос
+     * @param inRequestID - Идентификатор запроса, переданный обработчику запросов
+     * @param inData - Данные ответа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code respond(const std::size_t inID, const std::uint32_t inRequestID, HMByteBuffer&& inData) override;
 
     /**
      * @brief sendToAll - Метод отправит данные всем подключённым клиентам
      * @param inData - Отправляемые данные
      * @return Вернёт контейнер, хранящий список ошибок (ключём является идентификатор соединения)
      */
-    virtual std::map<std::size_t, errors::error_code> sendToAll(oByteStream&& inData) override;
+    virtual std::map<std::size_t, errors::error_code> sendToAll(HMByteBuffer&& inData) override;
 
     /**
      * @brief closeConnection - Метод разорвёт соединение
@@ -87,44 +104,97 @@ public:
      */
     virtual void closeAllConnections() override;
 
+    /**
+     * @brief setSendQueueLimits - Метод задаст пределы очереди отправки подключённым и будущим соединениям
+     * @param inLimits - Пределы очереди и реакция на их превышение
+     */
+    virtual void setSendQueueLimits(const SendQueueLimits& inLimits) override;
+
+    /**
+     * @brief setCompression - Метод задаст сжатие отправляемых кадров подключённым и будущим соединениям
+     * @param inSettings - Настройки сжатия
+     */
+    virtual void setCompression(const CompressionSettings& inSettings) override;
+
+    /**
+     * @brief setHeartbeat - Метод задаст проверку связи и разрыв по простою подключённым и будущим соединениям
+     * @param inSettings - Настройки проверки связи
+     */
+    virtual void setHeartbeat(const HeartbeatSettings& inSettings) override;
+
+    /**
+     * @brief setRateLimits - Метод задаст пределы частоты входящих кадров подключённым и будущим соединениям
+     * @param inLimits - Пределы частоты
+     */
+    virtual void setRateLimits(const RateLimits& inLimits) override;
+
+    /**
+     * @brief setAcceptLimits - Метод задаст предел частоты подключений к серверу
+     * @param inLimits - Предел частоты подключений
+     */
+    virtual void setAcceptLimits(const AcceptLimits& inLimits) override;
+
+    /**
+     * @brief stats - Метод вернёт статистику сервера
+     * @return Вернёт статистику сервера
+     */
+    virtual ServerStats stats() const override;
+
+    /**
+     * @brief connectionStats - Метод вернёт статистику соединения
+     * @param inID - Идентификатор соединения
+     * @param outStats - Статистика соединения
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code connectionStats(const std::size_t inID, ConnectionStats& outStats) const override;
+
 protected:
 
     /**
      * @brief onNewConnection - Метод обработает подключение нового соединения
+     * Идентификатор выдаётся реестром за O(1) и не повторяется для разорванных соединений.
      * @param inConnection - Новое соединение
-     * @return Вернёт идентификатор, присвоеный  соединению
+     * @return Вернёт идентификатор, присвоеный  соединению (0 - реестр исчерпан, соединение не принято)
      */
     virtual std::size_t onNewConnection(std::unique_ptr<HMAbstractConnection>&& inConnection);
 
+    /**
+     * @brief admitConnection - Метод решит, принимать ли подключение, по пределу частоты подключений
+     * Реализация вызывает метод сразу после приёма сокета и закрывает отклонённый, не создавая соединения.
+     * @return Вернёт признак того, что подключение принимается
+     */
+    bool admitConnection();
+
     /**
      * @brief onDisconnect - Метод обработает отключение соединения
      * @param inConnectionID - ID соединения
      */
     virtual void onDisconnect(const std::size_t inConnectionID);
 
-private:
-
-    typedef std::unordered_map<std::size_t, std::unique_ptr<HMAbstractConnection>> ClientsContainer;
-
-    mutable std::recursive_mutex m_clientsDefender; ///< Мьютекс, защищающий контейнер авторизированных клиентов
-    ClientsContainer m_clients; ///< Контейнер, содержащий перечень авторизированных клиентов
-
-    mutable std::recursive_mutex m_m_deletingClientsDefender; ///< Мьютекс, защищающий контейнер с удаляемыми клиентами
-    std::list<std::unique_ptr<HMAbstractConnection>> m_deletingClients; ///< Контейнер с удаляемыми клиентами
-
-    hmcommon::HMThreadWaitControl m_threadControl;   ///< Контролёр потока
-    std::thread m_deleterThread;                    ///< Дескриптер потока, выполняющего удаление клиентов
-
     /**
-     * @brief deleteConnection - Метод отправит отключённого клиента на удаление
-     * @param inConnection - Удаляемый клиент
+     * @brief findConnection - Метод вернёт соединение по идентификатору
+     * @param inID - Идентификатор соединения
+     * @return Вернёт соединение или nullptr
      */
-    void deleteConnection(std::unique_ptr<HMAbstractConnection>&& inConnection);
+    std::shared_ptr<HMAbstractConnection> findConnection(const std::size_t inID) const;
 
-    /**
-     * @brief deleteConnectionThread - Поток, выполняющий удаление клиентов
+private:
+
+    /*
+     * Соединения разделяются с отправкой, которая выполняется без блокировки реестра:
+     * закрытое во время отправки соединение будет разрушено после её завершения.
      */
-    void deleteConnectionThread();
+    HMConnectionRegistry m_clients; ///< Реестр авторизированных клиентов
+
+    std::mutex m_sendLimitsDefender; ///< Мьютекс, защищающий настройки новых соединений (берётся до блокировок реестра)
+    SendQueueLimits m_sendLimits; ///< Пределы очереди отправки, назначаемые новым соединениям
+    CompressionSettings m_compression; ///< Сжатие отправляемых кадров, назначаемое новым соединениям
+    HeartbeatSettings m_heartbeat; ///< Проверка связи и разрыв по простою, назначаемые новым соединениям
+    RateLimits m_rateLimits; ///< Пределы частоты входящих кадров, назначаемые новым соединениям
+
+    HMTokenBucket m_acceptBucket; ///< Ведро жетонов подключений
+    std::atomic<std::uint64_t> m_acceptedConnections { 0 }; ///< Количество принятых подключений
+    std::atomic<std::uint64_t> m_rejectedConnections { 0 }; ///< Количество отклонённых подключений
 };
 //-----------------------------------------------------------------------------
 } // namespace net
@@ -0,0 +1,303 @@
+#include "connectionregistry.h"
+
+#include <neterrorcategory.h>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+std::size_t HMConnectionRegistry::insert(const std::shared_ptr<HMAbstractConnection>& inConnection)
+{
+    std::size_t Result = 0;
+    std::size_t Index = 0;
+
+    if (inConnection && acquireSlot(Index))
+    {
+        std::shared_lock AliasesLock(m_aliasesDefender); // Дескриптор не должен совпасть с назначенным пользователем идентификатором
+        std::lock_guard lg(slotDefender(Index));
+        Slot& Cell = *slot(Index);
+
+        Result = makeHandle(Index, Cell.m_generation);
+
+        while (m_aliases.find(Result) != m_aliases.end()) // Такое поколение пропускаем
+        {
+            Cell.m_generation = nextGeneration(Cell.m_generation);
+            Result = makeHandle(Index, Cell.m_generation);
+        }
+
+        Cell.m_id = Result;
+        Cell.m_connection = inConnection;
+        inConnection->setID(Result);
+        m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMAbstractConnection> HMConnectionRegistry::find(const std::size_t inID) const
+{
+    std::shared_ptr<HMAbstractConnection> Result = connectionAt(handleIndex(inID), inID); // Дескриптор указывает на ячейку сам
+    std::size_t Index = 0;
+
+    if (!Result)
+    {
+        std::shared_lock AliasesLock(m_aliasesDefender);
+
+        if (aliasIndex(inID, Index))
+            Result = connectionAt(Index, inID);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMAbstractConnection> HMConnectionRegistry::extract(const std::size_t inID)
+{
+    std::shared_ptr<HMAbstractConnection> Result = nullptr;
+    std::size_t Index = handleIndex(inID);
+    bool IsAlias = false; // Соединение было зарегистрировано под псевдонимом
+
+    if (!connectionAt(Index, inID)) // Не дескриптор, ищем среди псевдонимов
+    {
+        std::shared_lock AliasesLock(m_aliasesDefender);
+
+        if (!aliasIndex(inID, Index))
+            Index = C_MAX_SLOTS;
+    }
+
+    if (Slot* Cell = slot(Index))
+    {
+        std::lock_guard lg(slotDefender(Index));
+
+        if (Cell->m_connection && Cell->m_id == inID) // Соединение могли извлечь параллельно
+        {
+            IsAlias = inID != makeHandle(Index, Cell->m_generation);
+            Result = vacate(*Cell);
+        }
+    }
+
+    if (Result)
+    {
+        if (IsAlias)
+            forgetAlias(inID, Index);
+
+        releaseSlot(Index);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<HMAbstractConnection>> HMConnectionRegistry::extractAll()
+{
+    std::vector<std::shared_ptr<HMAbstractConnection>> Result;
+    std::vector<std::size_t> Indexes; // Освобождённые ячейки
+
+    {
+        std::unique_lock AliasesLock(m_aliasesDefender); // Псевдонимы освобождаются все разом
+        const std::size_t Capacity = m_capacity.load(std::memory_order_acquire);
+
+        for (std::size_t Lock = 0; Lock < C_LOCKS; ++Lock) // Каждый сегмент блокируется один раз
+        {
+            std::lock_guard lg(m_slotsDefenders[Lock]);
+
+            for (std::size_t Index = Lock; Index < Capacity; Index += C_LOCKS)
+            {
+                Slot& Cell = *slot(Index);
+
+                if (Cell.m_connection)
+                {
+                    Result.push_back(vacate(Cell));
+                    Indexes.push_back(Index);
+                }
+            }
+        }
+
+        m_aliases.clear();
+    }
+
+    for (const std::size_t Index : Indexes)
+        releaseSlot(Index);
+
+    m_size.fetch_sub(Result.size(), std::memory_order_relaxed);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMConnectionRegistry::rename(const std::size_t inCurrentID, const std::size_t inNewID)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess);
+    std::unique_lock AliasesLock(m_aliasesDefender); // Переименования выполняются по одному, выдача дескрипторов ждёт
+    std::size_t Index = handleIndex(inCurrentID);
+
+    if (!connectionAt(Index, inCurrentID) && !aliasIndex(inCurrentID, Index))
+        Error = make_error_code(errors::eNetError::neClientNotFound);
+    else if (exists(inNewID))
+        Error = make_error_code(errors::eNetError::neClientIdAlredyExists);
+    else
+    {
+        std::lock_guard lg(slotDefender(Index));
+        Slot& Cell = *slot(Index);
+
+        if (!Cell.m_connection || Cell.m_id != inCurrentID) // Соединение извлекли параллельно
+            Error = make_error_code(errors::eNetError::neClientNotFound);
+        else
+        {
+            Cell.m_id = inNewID;
+            Cell.m_connection->setID(inNewID); // Меняем идентификатор самого соединения
+            m_aliases.erase(inCurrentID);
+
+            if (inNewID != makeHandle(Index, Cell.m_generation)) // Собственный дескриптор ячейки в псевдониме не нуждается
+                m_aliases[inNewID] = Index;
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<HMAbstractConnection>> HMConnectionRegistry::snapshot() const
+{
+    std::vector<std::shared_ptr<HMAbstractConnection>> Result;
+    Result.reserve(size());
+
+    forEach([&Result](const std::shared_ptr<HMAbstractConnection>& inConnection) { Result.push_back(inConnection); });
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMConnectionRegistry::forEach(const std::function<void(const std::shared_ptr<HMAbstractConnection>&)>& inFunction) const
+{
+    const std::size_t Capacity = m_capacity.load(std::memory_order_acquire);
+
+    for (std::size_t Lock = 0; Lock < C_LOCKS; ++Lock) // Каждый сегмент блокируется один раз
+    {
+        std::lock_guard lg(m_slotsDefenders[Lock]);
+
+        for (std::size_t Index = Lock; Index < Capacity; Index += C_LOCKS)
+        {
+            const Slot& Cell = *slot(Index);
+
+            if (Cell.m_connection)
+                inFunction(Cell.m_connection);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+std::size_t HMConnectionRegistry::size() const
+{
+    return m_size.load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMConnectionRegistry::makeHandle(const std::size_t inIndex, const std::size_t inGeneration)
+{
+    return ((inIndex + 1) << C_HALF_BITS) | (inGeneration & C_GENERATION_MASK);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMConnectionRegistry::nextGeneration(const std::size_t inGeneration)
+{
+    return (inGeneration % C_GENERATION_MASK) + 1;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMConnectionRegistry::handleIndex(const std::size_t inHandle)
+{
+    return (inHandle >> C_HALF_BITS) - 1; // Для нулевой старшей половины получится заведомо невыделенный номер
+}
+//-----------------------------------------------------------------------------
+HMConnectionRegistry::Slot* HMConnectionRegistry::slot(const std::size_t inIndex) const
+{
+    Slot* Result = nullptr;
+
+    if (inIndex < m_capacity.load(std::memory_order_acquire)) // Блок ячейки опубликован
+        Result = &m_chunks[inIndex >> C_CHUNK_BITS][inIndex & (C_CHUNK_SIZE - 1)];
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::mutex& HMConnectionRegistry::slotDefender(const std::size_t inIndex) const
+{
+    return m_slotsDefenders[inIndex % C_LOCKS]; // Соседние ячейки защищены разными сегментами
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMAbstractConnection> HMConnectionRegistry::connectionAt(const std::size_t inIndex, const std::size_t inID) const
+{
+    std::shared_ptr<HMAbstractConnection> Result = nullptr;
+
+    if (const Slot* Cell = slot(inIndex))
+    {
+        std::lock_guard lg(slotDefender(inIndex));
+
+        if (Cell->m_id == inID)
+            Result = Cell->m_connection;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMConnectionRegistry::aliasIndex(const std::size_t inID, std::size_t& outIndex) const
+{
+    auto FindRes = m_aliases.find(inID);
+    const bool Result = FindRes != m_aliases.end();
+
+    if (Result)
+        outIndex = FindRes->second;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMConnectionRegistry::exists(const std::size_t inID) const
+{
+    std::size_t Index = 0;
+    return connectionAt(handleIndex(inID), inID) || (aliasIndex(inID, Index) && connectionAt(Index, inID));
+}
+//-----------------------------------------------------------------------------
+bool HMConnectionRegistry::acquireSlot(std::size_t& outIndex)
+{
+    bool Result = true;
+    std::lock_guard lg(m_freeDefender);
+
+    if (!m_freeSlots.empty()) // Повторно используем освобождённую ячейку
+    {
+        outIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else if (const std::size_t Capacity = m_capacity.load(std::memory_order_relaxed); Capacity < C_MAX_SLOTS) // Выделяем новый блок
+    {
+        m_chunks[Capacity >> C_CHUNK_BITS] = std::make_unique<Slot[]>(C_CHUNK_SIZE);
+
+        for (std::size_t Index = Capacity + C_CHUNK_SIZE - 1; Index > Capacity; --Index) // Младшие ячейки выдаются первыми
+            m_freeSlots.push_back(Index);
+
+        outIndex = Capacity;
+        m_capacity.store(Capacity + C_CHUNK_SIZE, std::memory_order_release); // Блок становится виден читателям
+    }
+    else // Реестр исчерпан
+        Result = false;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMConnectionRegistry::releaseSlot(const std::size_t inIndex)
+{
+    std::lock_guard lg(m_freeDefender);
+    m_freeSlots.push_back(inIndex);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMAbstractConnection> HMConnectionRegistry::vacate(Slot& ioSlot)
+{
+    std::shared_ptr<HMAbstractConnection> Result = std::move(ioSlot.m_connection);
+
+    ioSlot.m_connection = nullptr;
+    ioSlot.m_id = 0;
+    ioSlot.m_generation = nextGeneration(ioSlot.m_generation); // Выданные дескрипторы ячейки становятся недействительными
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMConnectionRegistry::forgetAlias(const std::size_t inID, const std::size_t inIndex)
+{
+    std::unique_lock AliasesLock(m_aliasesDefender);
+    std::size_t Index = 0;
+
+    // Ячейку могли уже занять и переименовать так же
+    if (aliasIndex(inID, Index) && Index == inIndex && !connectionAt(inIndex, inID))
+        m_aliases.erase(inID);
+}
+//-----------------------------------------------------------------------------
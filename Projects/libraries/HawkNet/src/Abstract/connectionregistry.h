@@ -0,0 +1,237 @@
+#ifndef HMCONNECTIONREGISTRY_H
+#define HMCONNECTIONREGISTRY_H
+
+/**
+ * @file connectionregistry.h
+ * @brief Содержит описание реестра соединений сервера
+ */
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <HawkCommon.h>
+#include <errorcode.h>
+
+#include "Abstract/abstractconnection.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMConnectionRegistry class - Класс, описывающий реестр соединений сервера
+ * Соединения хранятся в ячейках, выделяемых блоками и никогда не перемещаемых. Освобождённые
+ * ячейки возвращаются в список свободных, поэтому выдача идентификатора стоит O(1).
+ *
+ * Идентификатор (дескриптор) состоит из номера ячейки, увеличенного на 1 (старшая половина), и
+ * поколения ячейки (младшая половина). Поколение меняется при каждом освобождении ячейки, поэтому
+ * дескриптор разорванного соединения не найдёт соединение, занявшее ту же ячейку позже. Старшая
+ * половина дескриптора не бывает нулевой: небольшие идентификаторы остаются пользователю.
+ *
+ * Ячейки защищены сегментированными блокировками, под которыми только ищутся, добавляются и
+ * извлекаются соединения. Идентификаторы, назначенные пользователем (rename), хранятся в
+ * отдельном перечне псевдонимов и всегда проверяются по самой ячейке.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMConnectionRegistry : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMConnectionRegistry - Конструктор по умолчанию
+     */
+    HMConnectionRegistry() = default;
+
+    /**
+     * @brief ~HMConnectionRegistry - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMConnectionRegistry() override = default;
+
+    /**
+     * @brief insert - Метод зарегистрирует соединение и присвоит ему дескриптор
+     * @param inConnection - Соединение
+     * @return Вернёт дескриптор соединения (0 - реестр исчерпан)
+     */
+    std::size_t insert(const std::shared_ptr<HMAbstractConnection>& inConnection);
+
+    /**
+     * @brief find - Метод вернёт соединение по идентификатору
+     * @param inID - Идентификатор соединения
+     * @return Вернёт соединение или nullptr
+     */
+    std::shared_ptr<HMAbstractConnection> find(const std::size_t inID) const;
+
+    /**
+     * @brief extract - Метод снимет соединение с учёта и освободит его ячейку
+     * @param inID - Идентификатор соединения
+     * @return Вернёт соединение или nullptr
+     */
+    std::shared_ptr<HMAbstractConnection> extract(const std::size_t inID);
+
+    /**
+     * @brief extractAll - Метод снимет с учёта все соединения
+     * @return Вернёт снятые соединения
+     */
+    std::vector<std::shared_ptr<HMAbstractConnection>> extractAll();
+
+    /**
+     * @brief rename - Метод перерегистрирует соединение под новым идентификатором
+     * @param inCurrentID - Актуальный идентификатор соединения
+     * @param inNewID - Новый идентификатор соединения
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code rename(const std::size_t inCurrentID, const std::size_t inNewID);
+
+    /**
+     * @brief snapshot - Метод вернёт все зарегистрированные соединения
+     * @return Вернёт перечень соединений
+     */
+    std::vector<std::shared_ptr<HMAbstractConnection>> snapshot() const;
+
+    /**
+     * @brief forEach - Метод вызовет функцию для каждого соединения под блокировкой его сегмента
+     * Функция не должна обращаться к реестру.
+     * @param inFunction - Вызываемая функция
+     */
+    void forEach(const std::function<void(const std::shared_ptr<HMAbstractConnection>&)>& inFunction) const;
+
+    /**
+     * @brief size - Метод вернёт количество зарегистрированных соединений
+     * @return Вернёт количество зарегистрированных соединений
+     */
+    std::size_t size() const;
+
+private:
+
+    static constexpr std::size_t C_HALF_BITS = sizeof(std::size_t) * 4;                 ///< Разрядность половины дескриптора
+    static constexpr std::size_t C_GENERATION_MASK = (std::size_t(1) << C_HALF_BITS) - 1; ///< Маска поколения в дескрипторе
+
+    static constexpr std::size_t C_CHUNK_BITS = 10;                     ///< Разрядность номера ячейки в блоке
+    static constexpr std::size_t C_CHUNK_SIZE = 1 << C_CHUNK_BITS;      ///< Количество ячеек в блоке
+    static constexpr std::size_t C_MAX_CHUNKS = 4096;                   ///< Предельное количество блоков (4М соединений)
+    static constexpr std::size_t C_LOCKS = 64;                          ///< Количество сегментов блокировок ячеек
+    /// Предельное количество ячеек (номер ячейки должен помещаться в половину дескриптора)
+    static constexpr std::size_t C_MAX_SLOTS = std::min(C_MAX_CHUNKS * C_CHUNK_SIZE, (std::size_t(1) << C_HALF_BITS) - C_CHUNK_SIZE);
+
+    /**
+     * @brief The Slot struct - Ячейка реестра (защищена блокировкой своего сегмента, свободна без соединения)
+     */
+    struct Slot
+    {
+        std::size_t m_generation = 1;                               ///< Поколение ячейки (не бывает нулевым)
+        std::size_t m_id = 0;                                       ///< Идентификатор занявшего ячейку соединения
+        std::shared_ptr<HMAbstractConnection> m_connection = nullptr; ///< Соединение
+    };
+
+    std::array<std::unique_ptr<Slot[]>, C_MAX_CHUNKS> m_chunks;     ///< Блоки ячеек (выделяются по мере роста)
+    std::atomic_size_t m_capacity { 0 };                            ///< Количество выделенных ячеек (публикует блоки)
+    std::atomic_size_t m_size { 0 };                                ///< Количество зарегистрированных соединений
+
+    mutable std::array<std::mutex, C_LOCKS> m_slotsDefenders;       ///< Сегменты блокировок ячеек
+
+    std::mutex m_freeDefender;                  ///< Мьютекс, защищающий список свободных ячеек и выделение блоков
+    std::vector<std::size_t> m_freeSlots;       ///< Номера свободных ячеек
+
+    // Порядок блокировок: псевдонимы, затем сегмент ячейки
+    mutable std::shared_mutex m_aliasesDefender;                    ///< Мьютекс, защищающий перечень псевдонимов
+    std::unordered_map<std::size_t, std::size_t> m_aliases;         ///< Идентификаторы, назначенные пользователем { идентификатор, номер ячейки }
+
+    /**
+     * @brief makeHandle - Метод сформирует дескриптор ячейки
+     * @param inIndex - Номер ячейки
+     * @param inGeneration - Поколение ячейки
+     * @return Вернёт дескриптор
+     */
+    static std::size_t makeHandle(const std::size_t inIndex, const std::size_t inGeneration);
+
+    /**
+     * @brief nextGeneration - Метод вернёт следующее поколение ячейки (нулевое пропускается)
+     * @param inGeneration - Текущее поколение
+     * @return Вернёт следующее поколение
+     */
+    static std::size_t nextGeneration(const std::size_t inGeneration);
+
+    /**
+     * @brief handleIndex - Метод вернёт номер ячейки дескриптора
+     * @param inHandle - Дескриптор
+     * @return Вернёт номер ячейки (заведомо невыделенный для идентификаторов без номера)
+     */
+    static std::size_t handleIndex(const std::size_t inHandle);
+
+    /**
+     * @brief slot - Метод вернёт ячейку по номеру
+     * @param inIndex - Номер ячейки
+     * @return Вернёт ячейку или nullptr, если она ещё не выделена
+     */
+    Slot* slot(const std::size_t inIndex) const;
+
+    /**
+     * @brief slotDefender - Метод вернёт мьютекс сегмента, защищающего ячейку
+     * @param inIndex - Номер ячейки
+     * @return Вернёт мьютекс
+     */
+    std::mutex& slotDefender(const std::size_t inIndex) const;
+
+    /**
+     * @brief connectionAt - Метод вернёт соединение ячейки, если оно зарегистрировано под указанным идентификатором
+     * @param inIndex - Номер ячейки
+     * @param inID - Идентификатор соединения
+     * @return Вернёт соединение или nullptr
+     */
+    std::shared_ptr<HMAbstractConnection> connectionAt(const std::size_t inIndex, const std::size_t inID) const;
+
+    /**
+     * @brief aliasIndex - Метод найдёт ячейку, за которой закреплён псевдоним (под m_aliasesDefender)
+     * @param inID - Идентификатор-псевдоним
+     * @param outIndex - Номер ячейки
+     * @return Вернёт признак того, что псевдоним найден
+     */
+    bool aliasIndex(const std::size_t inID, std::size_t& outIndex) const;
+
+    /**
+     * @brief exists - Метод проверит, зарегистрировано ли соединение под указанным идентификатором (под m_aliasesDefender)
+     * @param inID - Идентификатор соединения
+     * @return Вернёт результат проверки
+     */
+    bool exists(const std::size_t inID) const;
+
+    /**
+     * @brief acquireSlot - Метод выдаст номер свободной ячейки
+     * @param outIndex - Номер ячейки
+     * @return Вернёт false, если реестр исчерпан
+     */
+    bool acquireSlot(std::size_t& outIndex);
+
+    /**
+     * @brief releaseSlot - Метод вернёт ячейку в список свободных
+     * @param inIndex - Номер ячейки
+     */
+    void releaseSlot(const std::size_t inIndex);
+
+    /**
+     * @brief vacate - Метод освободит ячейку и сменит её поколение (под блокировкой сегмента)
+     * @param ioSlot - Ячейка
+     * @return Вернёт соединение, занимавшее ячейку
+     */
+    static std::shared_ptr<HMAbstractConnection> vacate(Slot& ioSlot);
+
+    /**
+     * @brief forgetAlias - Метод удалит псевдоним освобождённой ячейки, если его не занял новый владелец
+     * @param inID - Идентификатор-псевдоним
+     * @param inIndex - Номер ячейки
+     */
+    void forgetAlias(const std::size_t inID, const std::size_t inIndex);
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMCONNECTIONREGISTRY_H
@@ -0,0 +1,66 @@
+#include "tokenbucket.h"
+
+#include <algorithm>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMTokenBucket::HMTokenBucket() :
+    hmcommon::HMNotCopyable()
+{
+    std::atomic_init(&m_rate, std::uint64_t(0));
+    std::atomic_init(&m_tolerance, std::int64_t(0));
+    std::atomic_init(&m_full, std::int64_t(0));
+}
+//-----------------------------------------------------------------------------
+void HMTokenBucket::configure(const std::uint64_t inRate, const std::uint64_t inBurst)
+{
+    const std::uint64_t Burst = (inBurst == 0) ? inRate : inBurst;
+    const double Tolerance = (inRate == 0) ? 0.0 : static_cast<double>(Burst) * 1e9 / static_cast<double>(inRate);
+
+    // Порядок записи не важен: изъятие, прочитавшее старую частоту с новым запасом, ошибётся лишь однажды
+    m_tolerance.store(std::max<std::int64_t>(static_cast<std::int64_t>(Tolerance), 1), std::memory_order_relaxed);
+    m_full.store(0, std::memory_order_relaxed);
+    m_rate.store(inRate, std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+bool HMTokenBucket::isLimited() const
+{
+    return m_rate.load(std::memory_order_relaxed) != 0;
+}
+//-----------------------------------------------------------------------------
+bool HMTokenBucket::tryTake(const std::uint64_t inAmount, const std::chrono::steady_clock::time_point inNow)
+{
+    bool Result = true;
+    const std::uint64_t Rate = m_rate.load(std::memory_order_relaxed);
+
+    if (Rate != 0)
+    {
+        const std::int64_t Now = std::chrono::duration_cast<std::chrono::nanoseconds>(inNow.time_since_epoch()).count();
+        const std::int64_t Cost = static_cast<std::int64_t>(static_cast<double>(inAmount) * 1e9 / static_cast<double>(Rate));
+        const std::int64_t Tolerance = m_tolerance.load(std::memory_order_relaxed);
+
+        std::int64_t Full = m_full.load(std::memory_order_relaxed);
+        bool Stored = false;
+
+        while (Result && !Stored)
+        {
+            const std::int64_t Start = std::max(Full, Now); // Полное ведро не копит жетоны сверх запаса
+            Result = Start - Now + Cost <= Tolerance || Full <= Now; // Жетонов хватает или ведро полно (изъятие больше запаса уходит в долг)
+
+            if (Result) // При неудаче Full получит значение, записанное другим потоком
+                Stored = m_full.compare_exchange_weak(Full, Start + Cost, std::memory_order_relaxed);
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMTokenBucket::refund(const std::uint64_t inAmount)
+{
+    const std::uint64_t Rate = m_rate.load(std::memory_order_relaxed);
+
+    if (Rate != 0) // Сдвиг момента наполнения обратен изъятию и не зависит от порядка с другими изъятиями
+        m_full.fetch_sub(static_cast<std::int64_t>(static_cast<double>(inAmount) * 1e9 / static_cast<double>(Rate)), std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+#ifndef HMTOKENBUCKET_H
+#define HMTOKENBUCKET_H
+
+/**
+ * @file tokenbucket.h
+ * @brief Содержит описание ведра жетонов, ограничивающего частоту событий
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <HawkCommon.h>
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMTokenBucket class - Класс, описывающий ведро жетонов без блокировок
+ * Состояние ведра - один момент времени, к которому ведро наполнится снова (алгоритм GCRA):
+ * каждое изъятие сдвигает его на стоимость изъятия, а запас ведра - допустимое опережение
+ * этого момента относительно текущего. Изъятие - одна операция compare-exchange, поэтому
+ * ведро можно разделять между потоками.
+ *
+ * Изъятие больше всего запаса проходит из полного ведра и уводит его в долг: следующие изъятия
+ * ждут погашения. Поэтому событие больше запаса (крупный кадр) не блокируется навсегда.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMTokenBucket : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMTokenBucket - Конструктор по умолчанию (ведро без ограничения)
+     */
+    HMTokenBucket();
+
+    /**
+     * @brief ~HMTokenBucket - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMTokenBucket() override = default;
+
+    /**
+     * @brief configure - Метод задаст частоту пополнения и запас ведра (ведро наполняется заново)
+     * @param inRate - Количество жетонов в секунду (0 - без ограничения)
+     * @param inBurst - Запас жетонов (0 - равен секундной частоте)
+     */
+    void configure(const std::uint64_t inRate, const std::uint64_t inBurst);
+
+    /**
+     * @brief isLimited - Метод вернёт признак того, что ведро ограничивает изъятия
+     * @return Вернёт признак ограничения
+     */
+    bool isLimited() const;
+
+    /**
+     * @brief tryTake - Метод попытается изъять жетоны
+     * @param inAmount - Количество жетонов
+     * @param inNow - Текущий момент
+     * @return Вернёт false, если запас исчерпан (жетоны не изъяты)
+     */
+    bool tryTake(const std::uint64_t inAmount, const std::chrono::steady_clock::time_point inNow = std::chrono::steady_clock::now());
+
+    /**
+     * @brief refund - Метод вернёт в ведро жетоны, изъятые напрасно (например, событие отклонил другой предел)
+     * @param inAmount - Количество жетонов, успешно изъятых ранее
+     */
+    void refund(const std::uint64_t inAmount);
+
+private:
+
+    std::atomic<std::uint64_t> m_rate;      ///< Количество жетонов в секунду (0 - без ограничения)
+    std::atomic<std::int64_t> m_tolerance;  ///< Запас ведра, выраженный во времени его пополнения (нс)
+    std::atomic<std::int64_t> m_full;       ///< Момент, к которому ведро наполнится (нс часов steady_clock)
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMTOKENBUCKET_H
@@ -1,5 +1,8 @@
 #include "abstractasyncconnection.h"
 
+#include <cassert>
+#include <algorithm>
+
 #include <neterrorcategory.h>
 
 using namespace net;
@@ -10,6 +13,14 @@ HMAbstractAsyncConnection::HMAbstractAsyncConnection(const ConCallbacks &inCallb
     m_Callbacks(inCallbacks)
 {
     std::atomic_init(&m_isWrite, false);
+    std::atomic_init(&m_framingMode, eFramingMode::fmSeparator);
+    std::atomic_init(&m_peerCapabilities, std::uint8_t(0));
+    std::atomic_init(&m_helloSent, false);
+    std::atomic_init(&m_lastReceived, std::chrono::steady_clock::rep(0));
+    std::atomic_init(&m_lastPing, std::chrono::steady_clock::rep(0));
+    std::atomic_init(&m_limitedFrames, std::uint64_t(0));
+    std::atomic_init(&m_limitedBytes, std::uint64_t(0));
+    std::atomic_init(&m_rateLimited, false);
 }
 //-----------------------------------------------------------------------------
 bool HMAbstractAsyncConnection::isConnected() const
@@ -19,13 +30,38 @@ bool HMAbstractAsyncConnection::isConnected() const
 //-----------------------------------------------------------------------------
 void HMAbstractAsyncConnection::disconnect()
 {
-    std::lock_guard lg(m_dataDefender);
-    // Очищаем очередь сообщений
-    while (!m_dataQueue.empty())
-        m_dataQueue.pop();
+    {
+        std::lock_guard lg(m_dataDefender);
+        // Очищаем очередь сообщений
+        while (!m_dataQueue.empty())
+            m_dataQueue.pop();
+
+        m_queuedBytes = 0;
+        m_queueOverflowed = false;
+        m_isWrite = false; // Незавершённая запись не должна блокировать очередь после переподключения
+
+        m_peerCapabilities = 0; // Новый сеанс согласуется заново
+        m_helloSent = false;
+
+        m_lastReceived = 0; // Простой нового сеанса отсчитывается от его установки
+        m_lastPing = 0;
+
+        {
+            std::lock_guard dlg(m_deflateDefender);
+            m_deflater.reset();
+        }
+
+        {
+            std::lock_guard ilg(m_inflateDefender);
+            m_inflater.reset();
+        }
+    }
+
+    // Ответы на запросы прежнего сеанса уже не придут (обработчики вызываются без блокировок)
+    failRequests(make_error_code(errors::eNetError::neNotConnected));
 }
 //-----------------------------------------------------------------------------
-errors::error_code HMAbstractAsyncConnection::send(oByteStream &&inData)
+errors::error_code HMAbstractAsyncConnection::send(HMByteBuffer&& inData)
 {
     errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
 
@@ -33,67 +69,565 @@ errors::error_code HMAbstractAsyncConnection::send(oByteStream &&inData)
         Error = make_error_code(errors::eNetError::neNotConnected);
     else // Соединение установлено
     {
-        inData.seekp(0, inData.end); // Принудительно переместим "курсор записи" в самый конец
-        if (inData.str().back() != C_DATA_SEPARATOR) // Если данные не завершаются разделителем
-            inData << C_DATA_SEPARATOR; // Добавляем разделитель в самый конец
+        OutFrame Frame;
+        Frame.m_mode = m_framingMode; // Режим фиксируется в момент постановки в очередь
 
+        if (Frame.m_mode == eFramingMode::fmLengthPrefixed) // Заголовок добавится при записи, экранирование не требуется
         {
-           std::lock_guard lg(m_dataDefender);
-           m_dataQueue.push(std::move(inData)); // Перемещаем данные в очередь
+            if (inData.size() > C_FRAME_MAX_LENGTH) // Длина не поместится в заголовок
+                Error = make_error_code(errors::eNetError::neFrameTooLarge);
         }
+        else if (inData.empty() || inData.view().back() != C_DATA_SEPARATOR) // Если данные не завершаются разделителем
+            inData.push_back(C_DATA_SEPARATOR); // Добавляем разделитель в самый конец
 
-        if (beforeWrite()) // Если разрешается начать запись
-            afterWrite(); // Вызываем функцию, выполняющую запись следующей порции данных
+        if (!Error)
+        {
+            Frame.m_data = std::move(inData);
+            Error = enqueue(std::move(Frame)); // Перемещаем данные в очередь
+        }
     }
 
     return Error;
 }
 //-----------------------------------------------------------------------------
-bool HMAbstractAsyncConnection::beforeWrite()
+errors::error_code HMAbstractAsyncConnection::sendShared(const SharedPayload& inData)
 {
-    if (!m_isWrite) // Запись не идёт
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    assert(inData != nullptr); // Данные должны быть валидными
+
+    if (!isConnected()) // Если нет соединения
+        Error = make_error_code(errors::eNetError::neNotConnected);
+    else // Соединение установлено
+    {
+        OutFrame Frame;
+        Frame.m_mode = m_framingMode; // Режим фиксируется в момент постановки в очередь
+
+        if (Frame.m_mode == eFramingMode::fmLengthPrefixed && inData->size() > C_FRAME_MAX_LENGTH) // Длина не поместится в заголовок
+            Error = make_error_code(errors::eNetError::neFrameTooLarge);
+        else
+        {
+            Frame.m_shared = inData; // Очередь ссылается на данные, а не копирует их
+            Error = enqueue(std::move(Frame));
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::request(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                                      const std::chrono::milliseconds inTimeout)
+{
+    return sendAwaiting(C_FRAME_FLAG_REQUEST, std::move(inData), std::move(inCallback), inTimeout);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::sendAcked(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                                        const std::chrono::milliseconds inTimeout)
+{
+    return sendAwaiting(C_FRAME_FLAG_ACKED, std::move(inData), std::move(inCallback), inTimeout);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::sendAwaiting(const std::uint8_t inFlags, HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                                           const std::chrono::milliseconds inTimeout)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    assert(inCallback != nullptr); // Обработчик ответа должен быть задан
+
+    if (!isConnected()) // Если нет соединения
+        Error = make_error_code(errors::eNetError::neNotConnected);
+    else if (inData.size() > C_FRAME_MAX_LENGTH - C_REQUEST_ID_SIZE) // Длина с идентификатором не поместится в заголовок
+        Error = make_error_code(errors::eNetError::neFrameTooLarge);
+    else
     {
-        m_isWrite = true; // Взводим флаг что запись идёт
-        return true; // Разрешаем запись
+        std::uint32_t RequestID = 0;
+        bool IsEarliest = false; // Признак того, что срок запроса наступит раньше остальных
+
+        {
+            std::lock_guard lg(m_requestsDefender);
+
+            do // Нулевой идентификатор не выдаётся, занятые пропускаются после переполнения счётчика
+                RequestID = ++m_lastRequestID;
+            while (RequestID == 0 || m_requests.count(RequestID) != 0);
+
+            PendingRequest& Request = m_requests[RequestID];
+            Request.m_callback = std::move(inCallback);
+            Request.m_deadline = std::chrono::steady_clock::now() + inTimeout;
+
+            const auto Deadline = m_requestDeadlines.emplace(Request.m_deadline, RequestID).first;
+            IsEarliest = Deadline == m_requestDeadlines.begin();
+        }
+
+        Error = sendTagged(inFlags, RequestID, std::move(inData));
+
+        if (Error)
+        {
+            ResponseCallBackFn Callback = nullptr;
+
+            // Если запрос уже завершён разрывом соединения, его обработчик вызван: об ошибке не сообщаем
+            if (!takeRequest(RequestID, Callback))
+                Error = make_error_code(errors::eNetError::neSuccess);
+        }
+        else if (IsEarliest) // Таймер соединения должен сработать к сроку нового запроса
+            armTimers();
     }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::respond(const std::uint32_t inRequestID, HMByteBuffer&& inData)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    if (!isConnected()) // Если нет соединения
+        Error = make_error_code(errors::eNetError::neNotConnected);
+    else if (inData.size() > C_FRAME_MAX_LENGTH - C_REQUEST_ID_SIZE) // Длина с идентификатором не поместится в заголовок
+        Error = make_error_code(errors::eNetError::neFrameTooLarge);
     else
-        return false; // Запрещаем начинать новую запись запись
+        Error = sendTagged(C_FRAME_FLAG_RESPONSE, inRequestID, std::move(inData));
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::setFramingMode(const eFramingMode inMode)
+{
+    assert(inMode != eFramingMode::fmCount); // Режим должен быть валидным
+
+    const eFramingMode PrevMode = m_framingMode.exchange(inMode);
+
+    if (PrevMode != inMode && isConnected()) // Режим изменён на установленном соединении
+    {
+        errors::error_code Error = announceFraming(); // Сообщаем партнёру о двоичных заголовках
+
+        if (Error)
+            onError(Error);
+    }
+}
+//-----------------------------------------------------------------------------
+eFramingMode HMAbstractAsyncConnection::framingMode() const
+{
+    return m_framingMode;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::setSendQueueLimits(const SendQueueLimits& inLimits)
+{
+    assert(inLimits.m_policy != eQueueOverflowPolicy::qpCount); // Политика должна быть валидной
+
+    std::lock_guard lg(m_dataDefender);
+    m_limits = inLimits;
+}
+//-----------------------------------------------------------------------------
+SendQueueLimits HMAbstractAsyncConnection::sendQueueLimits() const
+{
+    std::lock_guard lg(m_dataDefender);
+    return m_limits;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::setCompression(const CompressionSettings& inSettings)
+{
+    std::lock_guard lg(m_deflateDefender);
+    m_compression = inSettings;
+}
+//-----------------------------------------------------------------------------
+CompressionSettings HMAbstractAsyncConnection::compression() const
+{
+    std::lock_guard lg(m_deflateDefender);
+    return m_compression;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::setHeartbeat(const HeartbeatSettings& inSettings)
+{
+    {
+        std::lock_guard lg(m_dataDefender);
+        m_heartbeat = inSettings;
+    }
+
+    armTimers(); // Срок проверки пересчитывается по новым настройкам
+}
+//-----------------------------------------------------------------------------
+HeartbeatSettings HMAbstractAsyncConnection::heartbeat() const
+{
+    std::lock_guard lg(m_dataDefender);
+    return m_heartbeat;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::setRateLimits(const RateLimits& inLimits)
+{
+    std::lock_guard lg(m_dataDefender);
+    m_rateLimits = inLimits;
+
+    m_frameBucket.configure(inLimits.m_framesPerSecond, inLimits.m_frameBurst);
+    m_byteBucket.configure(inLimits.m_bytesPerSecond, inLimits.m_byteBurst);
+}
+//-----------------------------------------------------------------------------
+RateLimits HMAbstractAsyncConnection::rateLimits() const
+{
+    std::lock_guard lg(m_dataDefender);
+    return m_rateLimits;
+}
+//-----------------------------------------------------------------------------
+ConnectionStats HMAbstractAsyncConnection::stats() const
+{
+    std::scoped_lock lg(m_deflateDefender, m_inflateDefender);
+    ConnectionStats Result = m_stats;
+    Result.m_limitedFrames = m_limitedFrames;
+    Result.m_limitedBytes = m_limitedBytes;
+
+    if (Result.m_compressInBytes != 0)
+        Result.m_compressionRatio = static_cast<double>(Result.m_compressOutBytes) / static_cast<double>(Result.m_compressInBytes);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractAsyncConnection::beforeWrite()
+{
+    return !m_isWrite.exchange(true); // Взводим флаг что запись идёт, запись начинает только взведший его поток
 }
 //-----------------------------------------------------------------------------
 void HMAbstractAsyncConnection::afterWrite()
 {
-    m_isWrite = writeNext(); // Пытаемся продолжить запись, если в очереди есть данные
+    writeNext(); // Пытаемся продолжить запись, если в очереди есть данные (флаг сбрасывается при опустевшей очереди)
 }
 //-----------------------------------------------------------------------------
-bool HMAbstractAsyncConnection::getNextData(oByteStream& outData)
+FrameView HMAbstractAsyncConnection::encodePayload(const OutFrame& inFrame, std::uint8_t& outFlags)
 {
-    bool Result = true;
+    FrameView Result = (inFrame.m_shared) ? inFrame.m_shared->view() : inFrame.m_data.view();
+    outFlags = inFrame.m_flags;
+
+    // Сжимаются только кадры с заголовком и только для партнёра, сообщившего о распаковке
+    if (inFrame.m_mode == eFramingMode::fmLengthPrefixed && !(inFrame.m_flags & C_FRAME_SERVICE_FLAGS) &&
+        (m_peerCapabilities & C_FRAME_CAPABILITY_DEFLATE))
+    {
+        std::lock_guard lg(m_deflateDefender);
+
+        if (m_compression.m_enabled && Result.size() >= m_compression.m_threshold)
+        {
+            const auto Start = std::chrono::steady_clock::now();
+            const errors::error_code Error = m_deflater.compress(Result, m_compression.m_level, m_deflated);
+            m_stats.m_compressTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+
+            /*
+             * Несжатый кадр уходит как есть, но окно сжатия уже содержит его данные. Сеанс начинается
+             * заново: новый сеанс не ссылается на прежние данные, поэтому окно партнёра остаётся верным.
+             */
+            if (Error || m_deflated.size() > C_FRAME_MAX_LENGTH)
+                m_deflater.reset();
+            else
+            {
+                ++m_stats.m_compressedFrames;
+                m_stats.m_compressInBytes += Result.size();
+                m_stats.m_compressOutBytes += m_deflated.size();
+
+                outFlags |= C_FRAME_FLAG_DEFLATE;
+                Result = m_deflated.view(); // Буфер не изменится до следующего кадра: пачку собирает один поток
+            }
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractAsyncConnection::getNextBatch(std::vector<OutFrame>& outBatch, bool& outDrained)
+{
+    std::size_t BatchSize = 0; // Объём полезной нагрузки пачки
     std::lock_guard lg(m_dataDefender);
 
-    if (m_dataQueue.empty()) // Если очередь пуста
-        Result = false; // Взводим флаг ошибки
-    else // Если данные успешно получены
+    while (!m_dataQueue.empty() && (outBatch.empty() || BatchSize < C_WRITE_BATCH_LIMIT)) // Берём хотя бы одно сообщение
     {
-        outData = std::move(m_dataQueue.front()); // Перемещаем данные в возвращаемые
+        OutFrame& Frame = m_dataQueue.front();
+        BatchSize += frameSize(Frame);
+
+        outBatch.push_back(std::move(Frame)); // Перемещаем данные в возвращаемые
         m_dataQueue.pop(); // Выкидываем опустевший набор данных из очереди
     }
 
-    return Result;
+    m_queuedBytes -= BatchSize;
+
+    // Производителей будим с запасом, чтобы очередь не пустела в ожидании их реакции
+    outDrained = m_queueOverflowed &&
+                 (m_limits.m_maxBytes == 0 || m_queuedBytes <= m_limits.m_maxBytes / 2) &&
+                 (m_limits.m_maxMessages == 0 || m_dataQueue.size() <= m_limits.m_maxMessages / 2);
+
+    if (outDrained)
+        m_queueOverflowed = false;
+
+    // Флаг сбрасывается под блокировкой очереди: завершение записи в другом потоке не затрёт его после постановки нового сообщения
+    if (outBatch.empty())
+        m_isWrite = false;
+
+    return !outBatch.empty();
 }
 //-----------------------------------------------------------------------------
 bool HMAbstractAsyncConnection::writeNext()
 {
     bool Result = true;
-    oByteStream Data; // Запрашиваем данные из очереди для отправки
+    bool Drained = false; // Признак освобождения переполнявшейся очереди
+    std::vector<OutFrame> Batch; // Запрашиваем данные из очереди для отправки
 
-    if (!getNextData(Data)) // Если не удалось получить данные из очереди
+    if (!getNextBatch(Batch, Drained)) // Если не удалось получить данные из очереди
         Result = false;
     else // Данные успешно получены
     {
-        prepateNextData(std::move(Data)); // Отправляем данные на подготовку перед записью
+        for (OutFrame& Frame : Batch) // Собираем всю пачку в одну запись
+            prepateNextData(std::move(Frame));
+
         write(); // Вызываем запись
     }
 
+    if (Drained) // Обработчик может сразу отправить новые данные, поэтому вызывается вне блокировки очереди
+        onDrained();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::enqueue(OutFrame&& inFrame)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    const std::size_t FrameSize = frameSize(inFrame);
+    eQueueOverflowPolicy Policy = eQueueOverflowPolicy::qpReject;
+
+    {
+        std::lock_guard lg(m_dataDefender);
+        Policy = m_limits.m_policy;
+
+        // Сообщение, не помещающееся даже в пустую очередь, не должно вытеснять остальные
+        const bool Fits = m_limits.m_maxBytes == 0 || FrameSize <= m_limits.m_maxBytes;
+
+        while (Policy == eQueueOverflowPolicy::qpDropOldest && Fits && !m_dataQueue.empty() && exceedsLimits(FrameSize))
+        {
+            m_queuedBytes -= frameSize(m_dataQueue.front()); // Выбрасываем самое старое сообщение
+            m_dataQueue.pop();
+            m_queueOverflowed = true;
+        }
+
+        if (exceedsLimits(FrameSize)) // Места в очереди нет
+        {
+            Error = make_error_code(errors::eNetError::neSendQueueFull);
+            m_queueOverflowed = true;
+        }
+        else
+        {
+            m_queuedBytes += FrameSize;
+            m_dataQueue.push(std::move(inFrame)); // Перемещаем данные в очередь
+        }
+    }
+
+    if (!Error)
+    {
+        if (beforeWrite()) // Если разрешается начать запись
+            afterWrite(); // Вызываем функцию, выполняющую запись следующей порции данных
+    }
+    else if (Policy == eQueueOverflowPolicy::qpDisconnect) // Партнёр не успевает принимать данные
+        disconnectLater(Error);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractAsyncConnection::exceedsLimits(const std::size_t inFrameSize) const
+{
+    return (m_limits.m_maxMessages != 0 && m_dataQueue.size() >= m_limits.m_maxMessages) ||
+           (m_limits.m_maxBytes != 0 && m_queuedBytes + inFrameSize > m_limits.m_maxBytes);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMAbstractAsyncConnection::frameSize(const OutFrame& inFrame)
+{
+    std::size_t Result = 0;
+
+    if (inFrame.m_shared) // Разделяемые данные
+        Result = inFrame.m_shared->size();
+    else
+        Result = inFrame.m_data.size();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::announceFraming()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    if (m_framingMode == eFramingMode::fmLengthPrefixed) // Согласование требуется только для двоичных заголовков
+    {
+        if (!isConnected()) // Если нет соединения
+            Error = make_error_code(errors::eNetError::neNotConnected);
+        else
+        {
+            OutFrame Hello; // Служебный кадр, полезная нагрузка - возможности соединения
+            Hello.m_mode = eFramingMode::fmLengthPrefixed;
+            Hello.m_flags = C_FRAME_FLAG_HELLO;
+            Hello.m_data.push_back(static_cast<char>((HMFrameDeflater::isSupported()) ? C_FRAME_CAPABILITY_DEFLATE : 0));
+
+            m_helloSent = true;
+            Error = enqueue(std::move(Hello));
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::chrono::steady_clock::time_point HMAbstractAsyncConnection::checkHeartbeat(const std::chrono::steady_clock::time_point inNow)
+{
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    typedef std::chrono::steady_clock::duration Duration;
+
+    TimePoint Result = TimePoint::max(); // Изначально проверка не требуется
+    const HeartbeatSettings Settings = heartbeat();
+
+    if (isConnected() && (Settings.m_interval.count() > 0 || Settings.m_idleTimeout.count() > 0))
+    {
+        if (m_lastReceived == 0) // Простой отсчитывается от первой проверки установленного соединения
+            m_lastReceived = inNow.time_since_epoch().count();
+
+        const TimePoint LastReceived { Duration(m_lastReceived) };
+        TimePoint LastPing = std::max(LastReceived, TimePoint(Duration(m_lastPing)));
+
+        if (Settings.m_idleTimeout.count() > 0 && inNow - LastReceived >= Settings.m_idleTimeout)
+            disconnectLater(make_error_code(errors::eNetError::neIdleTimeout)); // Разрыв пройдёт обычным путём с оповещением
+        else
+        {
+            if (Settings.m_interval.count() > 0)
+            {
+                if (inNow - LastPing >= Settings.m_interval)
+                {
+                    // Переполненная очередь отклонит кадр, тогда простой разрешится разрывом по m_idleTimeout
+                    [[maybe_unused]] const errors::error_code Error = sendService(C_FRAME_FLAG_PING);
+                    LastPing = inNow;
+                    m_lastPing = inNow.time_since_epoch().count();
+                }
+
+                Result = LastPing + Settings.m_interval;
+            }
+
+            if (Settings.m_idleTimeout.count() > 0)
+                Result = std::min(Result, LastReceived + Settings.m_idleTimeout);
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::chrono::steady_clock::time_point HMAbstractAsyncConnection::checkTimers(const std::chrono::steady_clock::time_point inNow)
+{
+    return std::min(checkHeartbeat(inNow), expireRequests(inNow));
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::markActivity()
+{
+    m_lastReceived = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::sendService(const std::uint8_t inFlags)
+{
+    OutFrame Frame; // Служебный кадр всегда с заголовком: партнёр принимает кадры обоих режимов
+    Frame.m_mode = eFramingMode::fmLengthPrefixed;
+    Frame.m_flags = inFlags;
+
+    return enqueue(std::move(Frame));
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMAbstractAsyncConnection::sendTagged(const std::uint8_t inFlags, const std::uint32_t inRequestID, HMByteBuffer&& inData)
+{
+    OutFrame Frame; // Запрос и ответ всегда с заголовком: партнёр принимает кадры обоих режимов
+    Frame.m_mode = eFramingMode::fmLengthPrefixed;
+    Frame.m_flags = inFlags;
+
+    Frame.m_data.reserve(C_REQUEST_ID_SIZE + inData.size());
+    char* ID = Frame.m_data.extend(C_REQUEST_ID_SIZE);
+
+    for (std::size_t Index = 0; Index < C_REQUEST_ID_SIZE; ++Index) // Little-endian, как и длина в заголовке
+        ID[Index] = static_cast<char>((inRequestID >> (Index * 8)) & 0xFF);
+
+    Frame.m_data.append(inData.view());
+    inData.clear();
+
+    return enqueue(std::move(Frame));
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractAsyncConnection::takeRequest(const std::uint32_t inRequestID, ResponseCallBackFn& outCallback)
+{
+    bool Result = false;
+    std::lock_guard lg(m_requestsDefender);
+
+    auto It = m_requests.find(inRequestID);
+
+    if (It != m_requests.end())
+    {
+        m_requestDeadlines.erase({ It->second.m_deadline, inRequestID });
+        outCallback = std::move(It->second.m_callback);
+        m_requests.erase(It);
+        Result = true;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::chrono::steady_clock::time_point HMAbstractAsyncConnection::expireRequests(const std::chrono::steady_clock::time_point inNow)
+{
+    std::chrono::steady_clock::time_point Result = std::chrono::steady_clock::time_point::max();
+    std::vector<ResponseCallBackFn> Expired;
+
+    {
+        std::lock_guard lg(m_requestsDefender);
+
+        while (!m_requestDeadlines.empty() && m_requestDeadlines.begin()->first <= inNow)
+        {
+            auto It = m_requests.find(m_requestDeadlines.begin()->second);
+            assert(It != m_requests.end()); // Срок есть только у ожидающего запроса
+
+            Expired.push_back(std::move(It->second.m_callback));
+            m_requests.erase(It);
+            m_requestDeadlines.erase(m_requestDeadlines.begin());
+        }
+
+        if (!m_requestDeadlines.empty())
+            Result = m_requestDeadlines.begin()->first;
+    }
+
+    // Обработчики вызываются без блокировки: они могут отправить новый запрос
+    for (ResponseCallBackFn& Callback : Expired)
+        Callback(make_error_code(errors::eNetError::neTimeOut), HMByteBuffer());
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::failRequests(const errors::error_code inError)
+{
+    std::unordered_map<std::uint32_t, PendingRequest> Pending;
+
+    {
+        std::lock_guard lg(m_requestsDefender);
+        Pending.swap(m_requests);
+        m_requestDeadlines.clear();
+    }
+
+    for (auto& Request : Pending)
+        Request.second.m_callback(inError, HMByteBuffer());
+}
+//-----------------------------------------------------------------------------
+bool HMAbstractAsyncConnection::admitFrame(const std::size_t inSize)
+{
+    bool Result = true;
+
+    if (m_frameBucket.isLimited() || m_byteBucket.isLimited()) // Без пределов не тратимся даже на часы
+    {
+        const auto Now = std::chrono::steady_clock::now();
+        Result = m_frameBucket.tryTake(1, Now);
+
+        if (Result && !m_byteBucket.tryTake(inSize, Now))
+        {
+            m_frameBucket.refund(1); // Отброшенный кадр не должен расходовать предел кадров
+            Result = false;
+        }
+
+        if (Result)
+            m_rateLimited = false;
+        else
+        {
+            ++m_limitedFrames;
+            m_limitedBytes += inSize;
+
+            if (!m_rateLimited.exchange(true)) // Первый отброшенный кадр серии
+                onError(make_error_code(errors::eNetError::neRateLimited));
+        }
+    }
+
     return Result;
 }
 //-----------------------------------------------------------------------------
@@ -103,12 +637,143 @@ bool HMAbstractAsyncConnection::writeNext()
 // ===================
 
 //-----------------------------------------------------------------------------
-void HMAbstractAsyncConnection::onReadEnd(iByteStream&& inData) const
+void HMAbstractAsyncConnection::onReadEnd(HMByteBuffer&& inData) const
 {
     if (m_Callbacks.m_DataCallBack)
         m_Callbacks.m_DataCallBack(std::move(inData), getID());
 }
 //-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onReadFrame(const FrameInfo& inFrame, const FrameView inData)
+{
+    const bool IsHeartbeat = (inFrame.m_flags & (C_FRAME_FLAG_PING | C_FRAME_FLAG_PONG)) != 0; // Служебный кадр проверки связи
+
+    // Кадры проверки связи всегда идут с заголовком и о режиме партнёра не говорят
+    if (inFrame.m_mode == eFramingMode::fmLengthPrefixed && !IsHeartbeat) // Партнёр поддерживает двоичные заголовки
+        m_framingMode = eFramingMode::fmLengthPrefixed; // Отвечаем ему в том же режиме
+
+    const bool IsService = (inFrame.m_flags & C_FRAME_FLAG_HELLO) != 0; // Служебный кадр согласования
+    const bool IsCompressed = (inFrame.m_flags & C_FRAME_FLAG_DEFLATE) != 0; // Сжатый кадр
+    const bool IsEmptySeparated = inFrame.m_mode == eFramingMode::fmSeparator && inFrame.m_length == 0; // Пустые сообщения режима fmSeparator не передаются
+    const bool IsAdmitted = IsService || admitFrame(inData.size()); // Согласование идёт раз за сеанс и не ограничивается
+
+    if (IsHeartbeat)
+    {
+        if (IsAdmitted && (inFrame.m_flags & C_FRAME_FLAG_PING)) // Ответ на проверку связи, ответ партнёра (PONG) лишь сбрасывает простой
+        {
+            errors::error_code Error = sendService(C_FRAME_FLAG_PONG);
+
+            if (Error)
+                onError(Error);
+        }
+    }
+    else if (IsService)
+        onHello(inData);
+    else if (IsCompressed)
+        onCompressedFrame(inFrame.m_flags, inData, IsAdmitted);
+    else if (!IsAdmitted)
+    {
+        // Кадр сверх пределов частоты отбрасывается (уже учтён в статистике)
+    }
+    else if (inFrame.m_flags & C_FRAME_TAGGED_FLAGS)
+        onTaggedFrame(inFrame.m_flags, inData);
+    else if (!IsEmptySeparated)
+    {
+        if (m_Callbacks.m_DataViewCallBack) // Обработчик принимает данные прямо из буфера приёма
+            m_Callbacks.m_DataViewCallBack(inData, getID());
+        else
+            onReadEnd(HMByteBuffer(inData)); // Единственная копия: из буфера приёма в буфер, который обработчик может забрать
+    }
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onHello(const FrameView inData)
+{
+    // Кадр согласования без полезной нагрузки отправляет партнёр без сжатия
+    m_peerCapabilities = (inData.empty()) ? std::uint8_t(0) : static_cast<std::uint8_t>(inData.front());
+
+    if (!m_helloSent) // Согласование начал партнёр, сообщаем ему свои возможности
+    {
+        errors::error_code Error = announceFraming();
+
+        if (Error)
+            onError(Error);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onCompressedFrame(const std::uint8_t inFlags, const FrameView inData, const bool inAdmitted)
+{
+    errors::error_code Error;
+
+    {
+        std::lock_guard lg(m_inflateDefender);
+
+        const auto Start = std::chrono::steady_clock::now();
+        Error = m_inflater.decompress(inData, C_FRAME_MAX_LENGTH, m_inflated);
+        m_stats.m_decompressTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start);
+
+        if (!Error)
+        {
+            ++m_stats.m_decompressedFrames;
+            m_stats.m_decompressInBytes += inData.size();
+            m_stats.m_decompressOutBytes += m_inflated.size();
+        }
+    }
+
+    if (Error) // Окно рассинхронизировано с партнёром, следующие кадры распаковать невозможно
+        disconnectLater(Error);
+    else if (!inAdmitted)
+    {
+        // Кадр сверх пределов частоты распакован только ради окна сжатия и отбрасывается
+    }
+    else if (inFlags & C_FRAME_TAGGED_FLAGS)
+        onTaggedFrame(inFlags, m_inflated.view());
+    else if (m_Callbacks.m_DataViewCallBack) // Обработчик принимает данные прямо из буфера распаковки
+        m_Callbacks.m_DataViewCallBack(m_inflated.view(), getID());
+    else
+        onReadEnd(std::move(m_inflated)); // Распакованный буфер переходит обработчику без копирования
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onTaggedFrame(const std::uint8_t inFlags, const FrameView inData)
+{
+    if (inData.size() < C_REQUEST_ID_SIZE) // Кадр без идентификатора сопоставить невозможно
+        onError(make_error_code(errors::eNetError::neInvalidFrame));
+    else
+    {
+        std::uint32_t RequestID = 0;
+
+        for (std::size_t Index = 0; Index < C_REQUEST_ID_SIZE; ++Index)
+            RequestID |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(inData[Index])) << (Index * 8);
+
+        const FrameView Payload = inData.substr(C_REQUEST_ID_SIZE);
+
+        if (inFlags & C_FRAME_FLAG_REQUEST)
+        {
+            // Без обработчика запрос отбрасывается, у партнёра он завершится по сроку
+            if (m_Callbacks.m_RequestCallBack)
+                m_Callbacks.m_RequestCallBack(Payload, getID(), RequestID);
+        }
+        else if (inFlags & C_FRAME_FLAG_ACKED)
+        {
+            if (m_Callbacks.m_DataViewCallBack)
+                m_Callbacks.m_DataViewCallBack(Payload, getID());
+            else
+                onReadEnd(HMByteBuffer(Payload));
+
+            // Подтверждение уходит после обработки: разрыв до него заставит партнёра отправить данные повторно
+            errors::error_code Error = sendTagged(C_FRAME_FLAG_RESPONSE, RequestID, HMByteBuffer());
+
+            if (Error)
+                onError(Error);
+        }
+        else
+        {
+            ResponseCallBackFn Callback = nullptr;
+
+            if (takeRequest(RequestID, Callback)) // Запоздавший ответ на истёкший запрос отбрасывается
+                Callback(make_error_code(errors::eNetError::neSuccess), HMByteBuffer(Payload));
+        }
+    }
+}
+//-----------------------------------------------------------------------------
 void HMAbstractAsyncConnection::onError(const errors::error_code inError) const
 {
     // Если ошика не игнорируемая и есть калбэк
@@ -122,3 +787,15 @@ void HMAbstractAsyncConnection::onDisconnect() const
         m_Callbacks.m_DisconnectCallBack(getID());
 }
 //-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onConnected(const errors::error_code inError) const
+{
+    if (m_Callbacks.m_ConnectCallBack)
+        m_Callbacks.m_ConnectCallBack(inError, getID());
+}
+//-----------------------------------------------------------------------------
+void HMAbstractAsyncConnection::onDrained() const
+{
+    if (m_Callbacks.m_DrainedCallBack)
+        m_Callbacks.m_DrainedCallBack(getID());
+}
+//-----------------------------------------------------------------------------
@@ -7,22 +7,34 @@
  * @brief Содержит описание абстрактного асинхронного соединения
  */
 
+#include <set>
 #include <queue>
 #include <mutex>
+#include <vector>
 #include <future>
 #include <atomic>
+#include <unordered_map>
 
 #include "Abstract/abstractconnection.h"
+#include "Abstract/tokenbucket.h"
+#include "Buffers/framecompressor.h"
 
 namespace net
 {
 //-----------------------------------------------------------------------------
 /**
  * @brief DataCallBackFn - Тип функции-обработчика полученных данных
- * @param inData - Полученные данные
+ * @param inData - Полученные данные (обработчик может забрать буфер себе без копирования)
  * @param inSenderID - Идентификатор соединения
  */
-typedef std::function<void(iByteStream&& inData, const std::size_t inSenderID)> DataCallBackFn;
+typedef std::function<void(HMByteBuffer&& inData, const std::size_t inSenderID)> DataCallBackFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief DataViewCallBackFn - Тип функции-обработчика полученных данных без копирования
+ * @param inData - Представление полученных данных (указывает в буфер приёма, копировать при необходимости хранения)
+ * @param inSenderID - Идентификатор соединения
+ */
+typedef std::function<void(const FrameView inData, const std::size_t inSenderID)> DataViewCallBackFn;
 //-----------------------------------------------------------------------------
 /**
  * @brief ErrorCallBackFn - Тип функции-обработчика произошедших ошибок
@@ -37,14 +49,53 @@ typedef std::function<void(const errors::error_code inError, const std::size_t i
  */
 typedef std::function<void(const std::size_t inSenderID)> DisconnectCallBackFn;
 //-----------------------------------------------------------------------------
+/**
+ * @brief ConnectCallBackFn - Тип функции-обработчика завершения подключения, начатого connectAsync
+ * @param inError - Признак ошибки (neSuccess - соединение установлено)
+ * @param inSenderID - Идентификатор соединения
+ */
+typedef std::function<void(const errors::error_code inError, const std::size_t inSenderID)> ConnectCallBackFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief DrainedCallBackFn - Тип функции-обработчика освобождения переполнявшейся очереди отправки
+ * @param inSenderID - Идентификатор соединения
+ */
+typedef std::function<void(const std::size_t inSenderID)> DrainedCallBackFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief RequestCallBackFn - Тип функции-обработчика запросов партнёра
+ * Ответ отправляется методом respond с переданным идентификатором запроса, в любой момент и из любого потока.
+ * @param inData - Представление данных запроса (указывает в буфер приёма, копировать при необходимости хранения)
+ * @param inSenderID - Идентификатор соединения
+ * @param inRequestID - Идентификатор запроса
+ */
+typedef std::function<void(const FrameView inData, const std::size_t inSenderID, const std::uint32_t inRequestID)> RequestCallBackFn;
+//-----------------------------------------------------------------------------
 /**
  * @brief The Callbacks struct - Структура, хранящая сторонние обработчики
  */
 struct ConCallbacks
 {
     DataCallBackFn m_DataCallBack = nullptr;                ///< Обработчик полученных данных
+    DataViewCallBackFn m_DataViewCallBack = nullptr;        ///< Обработчик полученных данных без копирования (если задан, m_DataCallBack не вызывается)
     ErrorCallBackFn m_ErrorCallBack = nullptr;              ///< Обработчик произошедших ошибок соединения
     DisconnectCallBackFn m_DisconnectCallBack = nullptr;    ///< Обработчик закрытия соединения
+    DrainedCallBackFn m_DrainedCallBack = nullptr;          ///< Обработчик освобождения очереди отправки (можно возобновить отправку)
+    RequestCallBackFn m_RequestCallBack = nullptr;          ///< Обработчик запросов партнёра (без него запросы отбрасываются и истекают у партнёра)
+    ConnectCallBackFn m_ConnectCallBack = nullptr;          ///< Обработчик завершения подключения, начатого connectAsync
+};
+//-----------------------------------------------------------------------------
+constexpr std::size_t C_WRITE_BATCH_LIMIT = 64 * 1024; ///< Предельный объём сообщений, объединяемых в одну запись (64 КБ)
+//-----------------------------------------------------------------------------
+/**
+ * @brief The OutFrame struct - Структура, описывающая сообщение в очереди отправки
+ */
+struct OutFrame
+{
+    eFramingMode m_mode = eFramingMode::fmSeparator;    ///< Режим кадрирования, выбранный при постановке в очередь
+    std::uint8_t m_flags = 0;                           ///< Флаги кадра (только fmLengthPrefixed)
+    HMByteBuffer m_data;                                ///< Полезная нагрузка
+    SharedPayload m_shared = nullptr;                   ///< Разделяемая полезная нагрузка (если задана, m_data не используется, разделитель не добавлен)
 };
 //-----------------------------------------------------------------------------
 /**
@@ -84,7 +135,120 @@ public:
      * @param inData - Отправлемые данные
      * @return Вернёт признак ошибки
      */
-    virtual errors::error_code send(oByteStream &&inData) override;
+    virtual errors::error_code send(HMByteBuffer&& inData) override;
+
+    /**
+     * @brief sendShared - Метод отправит разделяемые данные без копирования в очередь отправки
+     * @param inData - Отправлемые данные (не должны изменяться до завершения отправки)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code sendShared(const SharedPayload& inData) override;
+
+    /**
+     * @brief request - Метод отправит запрос, не дожидаясь ответов на предыдущие
+     * Запрос всегда идёт кадром fmLengthPrefixed: партнёр принимает кадры обоих режимов.
+     * Ответ, пришедший после истечения срока, отбрасывается. Разрыв соединения завершает ожидающие запросы ошибкой neNotConnected.
+     * @param inData - Данные запроса
+     * @param inCallback - Обработчик ответа (вызывается ровно один раз, если запрос принят к отправке)
+     * @param inTimeout - Время ожидания ответа
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code request(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                       const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) override;
+
+    /**
+     * @brief sendAcked - Метод отправит данные, доставку которых подтвердит партнёр
+     * Данные идут кадром C_FRAME_FLAG_ACKED, подтверждение ожидается так же, как ответ на запрос:
+     * разрыв соединения завершает ожидание ошибкой neNotConnected, истечение срока - neTimeOut.
+     * @param inData - Отправляемые данные
+     * @param inCallback - Обработчик подтверждения (вызывается ровно один раз, если данные приняты к отправке)
+     * @param inTimeout - Время ожидания подтверждения
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code sendAcked(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                         const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) override;
+
+    /**
+     * @brief respond - Метод отправит ответ на запрос партнёра
+     * @param inRequestID - Идентификатор запроса, переданный обработчику запросов
+     * @param inData - Данные ответа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code respond(const std::uint32_t inRequestID, HMByteBuffer&& inData) override;
+
+    /**
+     * @brief setFramingMode - Метод задаст режим кадрирования отправляемых сообщений
+     * При переходе в режим fmLengthPrefixed установленного соединения партнёру отправляется кадр согласования,
+     * после которого он тоже переходит на двоичные заголовки. Принимаются кадры обоих режимов.
+     * @param inMode - Режим кадрирования
+     */
+    virtual void setFramingMode(const eFramingMode inMode) override;
+
+    /**
+     * @brief framingMode - Метод вернёт текущий режим кадрирования отправляемых сообщений
+     * @return Вернёт режим кадрирования
+     */
+    virtual eFramingMode framingMode() const override;
+
+    /**
+     * @brief setSendQueueLimits - Метод задаст пределы очереди отправки
+     * Новые пределы применяются к следующим сообщениям, уже стоящие в очереди не выбрасываются.
+     * @param inLimits - Пределы очереди и реакция на их превышение
+     */
+    virtual void setSendQueueLimits(const SendQueueLimits& inLimits) override;
+
+    /**
+     * @brief sendQueueLimits - Метод вернёт пределы очереди отправки
+     * @return Вернёт пределы очереди отправки
+     */
+    virtual SendQueueLimits sendQueueLimits() const override;
+
+    /**
+     * @brief setCompression - Метод задаст сжатие отправляемых кадров
+     * Кадры сжимаются только в режиме fmLengthPrefixed и только после того, как партнёр сообщил
+     * о поддержке распаковки в кадре согласования. Уровень сжатия применяется к новому сеансу.
+     * @param inSettings - Настройки сжатия
+     */
+    virtual void setCompression(const CompressionSettings& inSettings) override;
+
+    /**
+     * @brief compression - Метод вернёт настройки сжатия отправляемых кадров
+     * @return Вернёт настройки сжатия
+     */
+    virtual CompressionSettings compression() const override;
+
+    /**
+     * @brief setHeartbeat - Метод задаст проверку связи и разрыв по простою
+     * Сроки отслеживает таймер потока соединения; простаивающее соединение разрывается
+     * обычным путём с ошибкой neIdleTimeout и оповещением о разрыве.
+     * @param inSettings - Настройки проверки связи
+     */
+    virtual void setHeartbeat(const HeartbeatSettings& inSettings) override;
+
+    /**
+     * @brief heartbeat - Метод вернёт настройки проверки связи и разрыва по простою
+     * @return Вернёт настройки проверки связи
+     */
+    virtual HeartbeatSettings heartbeat() const override;
+
+    /**
+     * @brief setRateLimits - Метод задаст пределы частоты входящих кадров
+     * Вёдра жетонов проверяются без блокировок в потоке чтения. Кадры согласования не ограничиваются.
+     * @param inLimits - Пределы частоты
+     */
+    virtual void setRateLimits(const RateLimits& inLimits) override;
+
+    /**
+     * @brief rateLimits - Метод вернёт пределы частоты входящих кадров
+     * @return Вернёт пределы частоты
+     */
+    virtual RateLimits rateLimits() const override;
+
+    /**
+     * @brief stats - Метод вернёт статистику соединения (накапливается за всё время жизни соединения)
+     * @return Вернёт статистику соединения
+     */
+    virtual ConnectionStats stats() const override;
 
 protected:
 
@@ -102,16 +266,62 @@ protected:
     virtual void afterWrite();
 
     /**
-     * @brief prepateNextData - Метод подготовит данные перед началом записи
-     * @param inData - Данные, подготовленные к отправке
+     * @brief prepateNextData - Метод добавит сообщение к подготавливаемой записи
+     * Вызывается для каждого сообщения пачки, после чего вся пачка отправляется одним вызовом write().
+     * @param inFrame - Сообщение, подготовленное к отправке
      */
-    virtual void prepateNextData(oByteStream&& inData) = 0;
+    virtual void prepateNextData(OutFrame&& inFrame) = 0;
 
     /**
-     * @brief write - Отправка данных
+     * @brief encodePayload - Метод вернёт полезную нагрузку сообщения в том виде, в котором она записывается в сокет
+     * Вызывается из prepateNextData в порядке очереди: сжатые кадры должны приходить партнёру в порядке сжатия.
+     * @param inFrame - Сообщение пачки
+     * @param outFlags - Флаги заголовка кадра
+     * @return Вернёт представление данных (сжатые действительны до следующего вызова)
+     */
+    FrameView encodePayload(const OutFrame& inFrame, std::uint8_t& outFlags);
+
+    /**
+     * @brief write - Отправка подготовленной пачки данных
      */
     virtual void write() = 0;
 
+    /**
+     * @brief disconnectLater - Метод разорвёт соединение в его собственном потоке, не дожидаясь разрыва
+     * Вызывается из send при политике qpDisconnect: синхронный разрыв из чужого потока
+     * мог бы заблокироваться на потоке, который сам ожидает отправителя.
+     * @param inReason - Причина разрыва (передаётся обработчику ошибок)
+     */
+    virtual void disconnectLater(const errors::error_code inReason) = 0;
+
+    /**
+     * @brief armTimers - Метод переставит таймер сроков соединения на срок, который вернёт checkTimers
+     * Реализация вызывает checkTimers в потоке соединения (вызов из чужого потока туда передаётся)
+     * и по срабатыванию таймера повторяет проверку. Вызывается при установке соединения, изменении
+     * настроек проверки связи и появлении запроса с самым ранним сроком.
+     */
+    virtual void armTimers() = 0;
+
+    /**
+     * @brief checkTimers - Метод обработает наступившие сроки соединения: простой и ожидание ответов (в потоке соединения)
+     * @param inNow - Текущий момент
+     * @return Вернёт ближайший срок (time_point::max(), если сроков нет)
+     */
+    std::chrono::steady_clock::time_point checkTimers(const std::chrono::steady_clock::time_point inNow);
+
+    /**
+     * @brief checkHeartbeat - Метод проверит простой соединения (в потоке соединения)
+     * Превышение m_idleTimeout разрывает соединение, превышение m_interval отправляет партнёру кадр проверки связи.
+     * @param inNow - Текущий момент
+     * @return Вернёт срок следующей проверки (time_point::max(), если проверка не требуется)
+     */
+    std::chrono::steady_clock::time_point checkHeartbeat(const std::chrono::steady_clock::time_point inNow);
+
+    /**
+     * @brief markActivity - Метод отметит приём данных от партнёра (сбрасывает отсчёт простоя)
+     */
+    void markActivity();
+
     // ===================
     // Обработчики эвентов
     // ===================
@@ -120,7 +330,23 @@ protected:
      * @brief onReadEnd - Метод, принимающий прочитанные данные
      * @param inData - Прочитанные данные
      */
-    void onReadEnd(iByteStream&& inData) const;
+    void onReadEnd(HMByteBuffer&& inData) const;
+
+    /**
+     * @brief onReadFrame - Метод, принимающий прочитанный кадр
+     * Кадр режима fmLengthPrefixed переводит отправку в этот же режим (согласование с партнёром),
+     * служебные кадры обработчику не передаются.
+     * @param inFrame - Описание кадра
+     * @param inData - Полезная нагрузка кадра
+     */
+    void onReadFrame(const FrameInfo& inFrame, const FrameView inData);
+
+    /**
+     * @brief announceFraming - Метод отправит партнёру кадр согласования, если выбран режим fmLengthPrefixed
+     * Полезная нагрузка кадра - возможности соединения (C_FRAME_CAPABILITY_*).
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code announceFraming();
 
     /**
      * @brief onError - Метод, принимающий принак ошибки
@@ -133,25 +359,185 @@ protected:
      */
     void onDisconnect() const;
 
+    /**
+     * @brief onConnected - Метод, оповещающий о завершении подключения, начатого connectAsync
+     * @param inError - Признак ошибки подключения
+     */
+    void onConnected(const errors::error_code inError) const;
+
+    /**
+     * @brief onDrained - Метод, оповещающий об освобождении переполнявшейся очереди отправки
+     */
+    void onDrained() const;
+
 private:
 
-    std::mutex m_dataDefender; ///< Мьютекс, защищающий очередь данных
-    std::queue<oByteStream> m_dataQueue; ///< Очередь данных на отправку
+    mutable std::mutex m_dataDefender; ///< Мьютекс, защищающий очередь данных
+    std::queue<OutFrame> m_dataQueue; ///< Очередь данных на отправку
+    std::size_t m_queuedBytes = 0; ///< Объём сообщений в очереди
+    SendQueueLimits m_limits; ///< Пределы очереди отправки
+    bool m_queueOverflowed = false; ///< Признак достигнутого предела очереди (ожидается оповещение об освобождении)
+    HeartbeatSettings m_heartbeat; ///< Настройки проверки связи (под m_dataDefender)
+    RateLimits m_rateLimits; ///< Пределы частоты входящих кадров (под m_dataDefender, вёдра читаются без него)
+
+    HMTokenBucket m_frameBucket; ///< Ведро жетонов входящих кадров
+    HMTokenBucket m_byteBucket; ///< Ведро жетонов входящих байт
+    std::atomic<std::uint64_t> m_limitedFrames; ///< Количество отброшенных пределами кадров
+    std::atomic<std::uint64_t> m_limitedBytes; ///< Объём отброшенных пределами кадров
+    std::atomic_bool m_rateLimited; ///< Признак серии отброшенных кадров (об ошибке сообщается один раз на серию)
+
+    // Отсчёты простоя - моменты steady_clock в его тактах (0 - отсчёт не начат)
+    std::atomic<std::chrono::steady_clock::rep> m_lastReceived; ///< Момент последнего приёма данных
+    std::atomic<std::chrono::steady_clock::rep> m_lastPing; ///< Момент последней отправки кадра проверки связи
+
+    /**
+     * @brief The PendingRequest struct - Структура, описывающая запрос, ожидающий ответа
+     */
+    struct PendingRequest
+    {
+        ResponseCallBackFn m_callback = nullptr;        ///< Обработчик ответа
+        std::chrono::steady_clock::time_point m_deadline; ///< Срок ожидания ответа
+    };
+
+    std::mutex m_requestsDefender; ///< Мьютекс, защищающий ожидающие запросы
+    std::uint32_t m_lastRequestID = 0; ///< Последний выданный идентификатор запроса
+    std::unordered_map<std::uint32_t, PendingRequest> m_requests; ///< Запросы, ожидающие ответа
+    std::set<std::pair<std::chrono::steady_clock::time_point, std::uint32_t>> m_requestDeadlines; ///< Сроки запросов по возрастанию
 
     std::atomic_bool m_isWrite; ///< Флаг "идёт запись"
+    std::atomic<eFramingMode> m_framingMode; ///< Режим кадрирования отправляемых сообщений
+    std::atomic_uint8_t m_peerCapabilities; ///< Возможности партнёра из его кадра согласования
+    std::atomic_bool m_helloSent; ///< Признак того, что партнёру отправлен кадр согласования
+
+    // Сжатие выполняет пишущий поток, распаковку - читающий, поэтому их состояния защищены раздельно
+    mutable std::mutex m_deflateDefender; ///< Мьютекс, защищающий сжатие и его статистику
+    CompressionSettings m_compression; ///< Настройки сжатия отправляемых кадров
+    HMFrameDeflater m_deflater; ///< Сеанс сжатия отправляемых кадров
+    HMByteBuffer m_deflated; ///< Сжатая полезная нагрузка записываемого кадра
+
+    mutable std::mutex m_inflateDefender; ///< Мьютекс, защищающий распаковку и её статистику
+    HMFrameInflater m_inflater; ///< Сеанс распаковки принятых кадров
+    HMByteBuffer m_inflated; ///< Распакованная полезная нагрузка принятого кадра
+
+    ConnectionStats m_stats; ///< Статистика соединения (поля сжатия под m_deflateDefender, распаковки - под m_inflateDefender)
 
     /**
-     * @brief getNextData - Метод вернёт следующий набор данных для отправки или признак ошибки
-     * @param outData - Принимающий набор данных
+     * @brief getNextBatch - Метод извлечёт из очереди пачку сообщений объёмом не более C_WRITE_BATCH_LIMIT
+     * Сообщение, превышающее предел, извлекается отдельной пачкой. Пустая очередь сбрасывает флаг записи.
+     * @param outBatch - Принимающая пачка сообщений
+     * @param outDrained - Признак того, что переполнявшаяся очередь освободилась до половины пределов
      * @return Вернёт признак получения данных из очереди
      */
-    bool getNextData(oByteStream& outData);
+    bool getNextBatch(std::vector<OutFrame>& outBatch, bool& outDrained);
 
     /**
-     * @brief writeNext - Метод начнёт запись следующих данных из очереди
+     * @brief writeNext - Метод начнёт запись следующей пачки данных из очереди
      * @return Вернёт признак успеха операции
      */
     bool writeNext();
+
+    /**
+     * @brief enqueue - Метод поместит сообщение в очередь и начнёт запись, если она не идёт
+     * При переполнении очереди поступает согласно политике m_limits.
+     * @param inFrame - Сообщение
+     * @return Вернёт признак ошибки (neSendQueueFull, если сообщение не принято)
+     */
+    errors::error_code enqueue(OutFrame&& inFrame);
+
+    /**
+     * @brief exceedsLimits - Метод проверит, превысит ли очередь пределы после добавления сообщения (под m_dataDefender)
+     * @param inFrameSize - Объём добавляемого сообщения
+     * @return Вернёт true, если сообщение не помещается в очередь
+     */
+    bool exceedsLimits(const std::size_t inFrameSize) const;
+
+    /**
+     * @brief frameSize - Метод вернёт объём полезной нагрузки сообщения очереди
+     * @param inFrame - Сообщение
+     * @return Вернёт объём в байтах
+     */
+    static std::size_t frameSize(const OutFrame& inFrame);
+
+    /**
+     * @brief onHello - Метод обработает кадр согласования партнёра
+     * Если партнёр начал согласование первым, ему в ответ отправляются возможности соединения.
+     * @param inData - Полезная нагрузка кадра согласования
+     */
+    void onHello(const FrameView inData);
+
+    /**
+     * @brief admitFrame - Метод проверит принятый кадр пределами частоты
+     * @param inSize - Размер полезной нагрузки кадра
+     * @return Вернёт false, если кадр должен быть отброшен
+     */
+    bool admitFrame(const std::size_t inSize);
+
+    /**
+     * @brief onCompressedFrame - Метод распакует сжатый кадр и передаст его обработчику
+     * Ошибка распаковки разрывает соединение: окно сжатия рассинхронизировано с партнёром.
+     * @param inFlags - Флаги кадра
+     * @param inData - Сжатая полезная нагрузка кадра
+     * @param inAdmitted - Признак кадра, прошедшего пределы частоты (иначе кадр только распаковывается для окна сжатия)
+     */
+    void onCompressedFrame(const std::uint8_t inFlags, const FrameView inData, const bool inAdmitted);
+
+    /**
+     * @brief sendService - Метод поставит в очередь служебный кадр без полезной нагрузки
+     * @param inFlags - Флаги кадра (C_FRAME_FLAG_PING или C_FRAME_FLAG_PONG)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code sendService(const std::uint8_t inFlags);
+
+    /**
+     * @brief sendAwaiting - Метод отправит кадр, ожидающий ответа партнёра (запрос или данные с подтверждением)
+     * @param inFlags - Флаги кадра (C_FRAME_FLAG_REQUEST или C_FRAME_FLAG_ACKED)
+     * @param inData - Данные кадра
+     * @param inCallback - Обработчик ответа
+     * @param inTimeout - Время ожидания ответа
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    errors::error_code sendAwaiting(const std::uint8_t inFlags, HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                    const std::chrono::milliseconds inTimeout);
+
+    /**
+     * @brief sendTagged - Метод поставит в очередь кадр с идентификатором запроса
+     * Идентификатор записывается перед данными, поэтому они копируются в кадр один раз.
+     * @param inFlags - Флаги кадра (одиночный флаг C_FRAME_TAGGED_FLAGS)
+     * @param inRequestID - Идентификатор запроса
+     * @param inData - Данные запроса или ответа
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code sendTagged(const std::uint8_t inFlags, const std::uint32_t inRequestID, HMByteBuffer&& inData);
+
+    /**
+     * @brief takeRequest - Метод извлечёт ожидающий запрос
+     * @param inRequestID - Идентификатор запроса
+     * @param outCallback - Обработчик ответа запроса
+     * @return Вернёт false, если запрос не ожидает ответа (истёк или не отправлялся)
+     */
+    bool takeRequest(const std::uint32_t inRequestID, ResponseCallBackFn& outCallback);
+
+    /**
+     * @brief expireRequests - Метод завершит ошибкой neTimeOut запросы с наступившим сроком
+     * @param inNow - Текущий момент
+     * @return Вернёт срок ближайшего из оставшихся запросов (time_point::max(), если их нет)
+     */
+    std::chrono::steady_clock::time_point expireRequests(const std::chrono::steady_clock::time_point inNow);
+
+    /**
+     * @brief failRequests - Метод завершит все ожидающие запросы ошибкой
+     * @param inError - Ошибка, передаваемая обработчикам ответа
+     */
+    void failRequests(const errors::error_code inError);
+
+    /**
+     * @brief onTaggedFrame - Метод обработает кадр с идентификатором запроса
+     * Запрос передаётся обработчику запросов, ответ - обработчику ожидающего его запроса.
+     * Данные с подтверждением передаются обработчику данных, после чего партнёру уходит пустой ответ.
+     * @param inFlags - Флаги кадра
+     * @param inData - Полезная нагрузка кадра (начинается с идентификатора запроса)
+     */
+    void onTaggedFrame(const std::uint8_t inFlags, const FrameView inData);
 };
 //-----------------------------------------------------------------------------
 } // namespace net
@@ -1,5 +1,7 @@
 #include "abstractasyncserver.h"
 
+#include <functional>
+
 #include <neterrorcategory.h>
 
 using namespace net;
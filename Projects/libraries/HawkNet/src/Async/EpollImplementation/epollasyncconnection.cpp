@@ -0,0 +1,426 @@
+#include "epollasyncconnection.h"
+
+#include <cerrno>
+#include <cassert>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <neterrorcategory.h>
+
+#include "netutils.h"
+#include "Async/Posix/posixsocket.h"
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMEpollAsyncConnection::HMEpollAsyncConnection(const std::string& inHost, const uint16_t inPort, const ConCallbacks& inCallbacks) :
+    HMAbstractAsyncConnection(inCallbacks),
+    HMEpollHandler(),
+    m_host(inHost),
+    m_port(inPort),
+    m_ownLoop(std::make_unique<HMEpollLoop>())
+{
+    m_loop = m_ownLoop.get();
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+    m_connectTimer.setCallback([this]() { finishConnect(make_error_code(errors::eNetError::neTimeOut)); });
+    std::atomic_init(&m_status, eConnectionStatus::csDisconnected);
+}
+//-----------------------------------------------------------------------------
+HMEpollAsyncConnection::HMEpollAsyncConnection(const int inFd, HMEpollLoop& inLoop, const ConCallbacks& inCallbacks) :
+    HMAbstractAsyncConnection(inCallbacks),
+    HMEpollHandler(),
+    m_host(peerHost(inFd)),
+    m_port(localPort(inFd)),
+    m_loop(&inLoop),
+    m_fd(inFd)
+{
+    assert(m_fd >= 0); // Сокет должен быть валидным
+    std::atomic_init(&m_status, eConnectionStatus::csConnected);
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+}
+//-----------------------------------------------------------------------------
+HMEpollAsyncConnection::~HMEpollAsyncConnection()
+{
+    disconnect(); // Сокет снимается с цикла до освобождения памяти обработчика
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollAsyncConnection::connect(const std::chrono::milliseconds inWaitTime)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int NewFd = -1;
+
+    disconnect(); // Принудительный разрыв соединения
+
+    if (!m_ownLoop) // Серверное соединение не переподключается
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (!m_ownLoop->isRunning()) // Цикл клиента запускается при первом подключении
+        Error = m_ownLoop->start();
+
+    if (!Error)
+    {
+        m_status = eConnectionStatus::csConnecting;
+        NewFd = connectSocket(m_host, m_port, inWaitTime, Error);
+    }
+
+    if (!Error) // Сокет подключён, передаём его циклу
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = NewFd;
+        }
+
+        m_loop->invoke([this, &Error]() { Error = attach(); });
+    }
+
+    if (Error) // Подключение не состоялось
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = -1;
+        }
+
+        if (NewFd >= 0)
+            ::close(NewFd);
+
+        m_status = eConnectionStatus::csDisconnected;
+    }
+    else
+        Error = announceFraming(); // Согласуем режим кадрирования с сервером
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollAsyncConnection::connectAsync(const std::chrono::milliseconds inWaitTime)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int NewFd = -1;
+
+    disconnect(); // Принудительный разрыв соединения
+
+    if (!m_ownLoop) // Серверное соединение не переподключается
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (!m_ownLoop->isRunning()) // Цикл клиента запускается при первом подключении
+        Error = m_ownLoop->start();
+
+    if (!Error)
+    {
+        m_status = eConnectionStatus::csConnecting;
+        NewFd = startConnect(m_host, m_port, Error);
+    }
+
+    if (!Error) // Подключение идёт, его завершение цикл обнаружит по готовности сокета к записи
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = NewFd;
+        }
+
+        m_loop->invoke([this, &Error, inWaitTime]()
+        {
+            // Сокет, подключившийся сразу, цикл сообщит готовым при регистрации
+            Error = m_loop->add(m_fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, this);
+
+            if (!Error)
+                m_loop->timers().schedule(m_connectTimer, std::chrono::steady_clock::now() + inWaitTime);
+        });
+    }
+
+    if (Error) // Подключение не началось
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = -1;
+        }
+
+        if (NewFd >= 0)
+            ::close(NewFd);
+
+        m_status = eConnectionStatus::csDisconnected;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::disconnect()
+{
+    if (m_status != eConnectionStatus::csDisconnected) // Закрытый сокет уже снят с цикла
+        m_loop->invoke([this]() { closeSocket(make_error_code(errors::eNetError::neSuccess)); });
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::disconnectLater(const errors::error_code inReason)
+{
+    if (m_status != eConnectionStatus::csDisconnected) // Деструктор снимает соединение через invoke, поэтому задача выполнится раньше
+        m_loop->post([this, inReason]() { closeSocket(inReason); });
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::armTimers()
+{
+    if (!m_loop->inLoopThread())
+    {
+        if (m_status != eConnectionStatus::csDisconnected) // Как и у disconnectLater, задача выполнится раньше разрушения
+            m_loop->post([this]() { armTimers(); });
+    }
+    else
+    {
+        const std::chrono::steady_clock::time_point Next = (m_fd >= 0) ? checkTimers(std::chrono::steady_clock::now()) :
+                                                                         std::chrono::steady_clock::time_point::max();
+
+        if (Next == std::chrono::steady_clock::time_point::max())
+            m_deadlineTimer.cancel();
+        else
+            m_loop->timers().schedule(m_deadlineTimer, Next);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::retire(std::shared_ptr<HMAbstractConnection>&& inSelf)
+{
+    std::shared_ptr<HMAbstractConnection> Self = std::move(inSelf);
+
+    // Задача выполнится после текущей пачки событий, поэтому соединение не удаляется из своего же обработчика
+    if (!m_loop->post([this, Self]() { closeSocket(make_error_code(errors::eNetError::neSuccess)); }))
+        disconnect(); // Цикл остановлен: закрываем сразу, ссылка освободится при выходе
+}
+//-----------------------------------------------------------------------------
+eConnectionStatus HMEpollAsyncConnection::status() const
+{
+    return m_status;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollAsyncConnection::attach()
+{
+    // EPOLLOUT по фронту приходит только при освобождении места в переполненном сокете, поэтому подписка на него бесплатна
+    errors::error_code Error = m_loop->add(m_fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, this);
+
+    if (!Error)
+    {
+        m_status = eConnectionStatus::csConnected;
+        armTimers(); // Отсчёт простоя начинается с установки соединения
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::string HMEpollAsyncConnection::getHost() const
+{
+    return m_host;
+}
+//-----------------------------------------------------------------------------
+uint16_t HMEpollAsyncConnection::getPort() const
+{
+    return m_port;
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::afterWrite()
+{
+    bool Continue = true;
+
+    while (Continue) // Пока пачки уходят в сокет целиком, продолжаем циклом, а не рекурсией через write()
+    {
+        HMAbstractAsyncConnection::afterWrite();
+
+        std::lock_guard lg(m_writeDefender);
+        Continue = m_batchSentBy == std::this_thread::get_id(); // Недописанную пачку продолжит цикл, а не этот поток
+        m_batchSentBy = std::thread::id();
+    }
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::prepateNextData(OutFrame&& inFrame)
+{
+    // Данные сообщения (собственные, разделяемые или сжатые) копируются только в буфер записи
+    std::uint8_t Flags = 0;
+    const FrameView Payload = encodePayload(inFrame, Flags);
+
+    std::lock_guard lg(m_writeDefender);
+
+    if (inFrame.m_mode == eFramingMode::fmLengthPrefixed) // Заголовок добавляется перед полезной нагрузкой, без экранирования
+    {
+        char Header[C_FRAME_HEADER_SIZE];
+        encodeFrameHeader(static_cast<std::uint32_t>(Payload.size()), Flags, Header);
+        m_writeBuffer.append(Header, C_FRAME_HEADER_SIZE);
+    }
+
+    m_writeBuffer.append(Payload); // Дописываем сообщение к пачке
+
+    // Собственным данным разделитель добавлен при постановке в очередь, разделяемые изменять нельзя
+    if (inFrame.m_shared && inFrame.m_mode != eFramingMode::fmLengthPrefixed && (Payload.empty() || Payload.back() != C_DATA_SEPARATOR))
+        m_writeBuffer.push_back(C_DATA_SEPARATOR);
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::write()
+{
+    std::lock_guard lg(m_writeDefender);
+
+    if (flush()) // Пачка принята сокетом целиком, следующую начнёт этот же поток
+        m_batchSentBy = std::this_thread::get_id();
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::onEvents(const std::uint32_t inEvents)
+{
+    if (m_fd < 0) // Сокет закрыт обработчиком другого события той же пачки
+        return;
+
+    if (m_status == eConnectionStatus::csConnecting) // Первое событие подключающегося сокета - завершение подключения
+    {
+        finishConnect(connectResult(m_fd));
+
+        // Обработчик неудавшегося подключения мог начать следующую попытку: её сокет этому событию не принадлежит
+        if (m_status != eConnectionStatus::csConnected)
+            return;
+    }
+
+    if (m_fd >= 0 && (inEvents & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) // Данные, закрытие или ошибка выясняются чтением
+        readAll();
+
+    if (m_fd >= 0 && (inEvents & EPOLLOUT)) // В сокете освободилось место
+    {
+        bool Continue = false;
+
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            if (m_waitWritable) // Дописываем пачку, недописанную потоком-отправителем
+            {
+                m_waitWritable = false;
+                Continue = flush();
+            }
+        }
+
+        if (Continue) // Пачка дописана, цикл становится владельцем записи
+            afterWrite();
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMEpollAsyncConnection::flush()
+{
+    bool Result = true;
+    bool Proceed = m_fd >= 0; // Данные закрытого сокета отбрасываются, очередь при этом досушивается
+
+    while (Proceed && m_writeOffset < m_writeBuffer.size())
+    {
+        const ssize_t Sent = ::send(m_fd, m_writeBuffer.data() + m_writeOffset, m_writeBuffer.size() - m_writeOffset, MSG_NOSIGNAL);
+
+        if (Sent > 0)
+            m_writeOffset += static_cast<std::size_t>(Sent);
+        else if (Sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) // Сокет переполнен, ждём EPOLLOUT
+        {
+            m_waitWritable = true;
+            Result = false;
+            Proceed = false;
+        }
+        else if (Sent < 0 && errno != EINTR) // Разрыв обнаружит цикл по EPOLLERR/EPOLLHUP
+            Proceed = false;
+    }
+
+    if (Result)
+    {
+        m_writeBuffer.clear();
+        m_writeOffset = 0;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::readAll()
+{
+    bool Proceed = true;
+
+    // В режиме edge-triggered сокет вычитывается до EAGAIN, иначе следующего события не будет
+    while (Proceed && m_fd >= 0)
+    {
+        char* WritePos = m_readBuffer.prepare(C_RECEIVE_BUFFER_INITIAL_CAPACITY);
+        const ssize_t Received = ::recv(m_fd, WritePos, C_RECEIVE_BUFFER_INITIAL_CAPACITY, 0);
+
+        if (Received > 0)
+        {
+            markActivity();
+            m_readBuffer.commit(static_cast<std::size_t>(Received));
+            readFrames();
+        }
+        else if (Received == 0) // Партнёр закрыл соединение штатно
+        {
+            closeSocket(make_error_code(errors::eNetError::neSuccess));
+            Proceed = false;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) // Сокет вычитан
+            Proceed = false;
+        else if (errno != EINTR)
+        {
+            closeSocket(convertingSocketError(errno));
+            Proceed = false;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::readFrames()
+{
+    FrameInfo Frame; // Описание очередного кадра
+    errors::error_code Error;
+
+    // Обработчик может разорвать соединение и очистить буфер, поэтому его размер проверяется на каждой итерации
+    while (!m_readBuffer.empty() && nextFrame(m_readBuffer.data(), m_readBuffer.size(), Frame, Error)) // Пока в буфере есть полные кадры
+    {
+        onReadFrame(Frame, FrameView(m_readBuffer.data() + Frame.m_offset, Frame.m_length)); // Передаём кадр без копирования
+        m_readBuffer.consume(Frame.m_size); // Отбрасываем обработанный кадр сдвигом смещения
+    }
+
+    if (Error) // Поток повреждён, восстановить границы кадров невозможно
+    {
+        m_readBuffer.clear();
+        onError(Error);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::finishConnect(const errors::error_code inError)
+{
+    m_connectTimer.cancel();
+
+    if (m_fd < 0 || m_status != eConnectionStatus::csConnecting) // Подключение уже завершено или прервано
+        return;
+
+    if (inError)
+        closeSocket(inError);
+    else
+    {
+        m_status = eConnectionStatus::csConnected;
+        armTimers(); // Отсчёт простоя начинается с установки соединения
+        onConnected(announceFraming()); // Согласуем режим кадрирования с сервером
+    }
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncConnection::closeSocket(const errors::error_code inError)
+{
+    if (m_fd < 0) // Сокет уже закрыт
+        return;
+
+    const bool WasConnecting = m_status == eConnectionStatus::csConnecting; // Соединение ещё не было установлено
+
+    m_loop->remove(m_fd);
+
+    {
+        std::lock_guard lg(m_writeDefender); // Дожидаемся записи, идущей из чужого потока
+        ::close(m_fd);
+        m_fd = -1;
+        m_writeBuffer.clear();
+        m_writeOffset = 0;
+        m_waitWritable = false;
+    }
+
+    m_readBuffer.clear();
+    m_deadlineTimer.cancel();
+    m_connectTimer.cancel();
+    m_status = eConnectionStatus::csDisconnected;
+    HMAbstractAsyncConnection::disconnect(); // Очищаем очередь отправки
+
+    if (WasConnecting) // Неустановленное соединение сообщает о неудавшемся подключении, а не о разрыве
+        onConnected((inError) ? inError : make_error_code(errors::eNetError::neNotConnected));
+    else
+    {
+        if (inError)
+            onError(inError);
+
+        onDisconnect(); // Как и у реализаций Qt, разрыв с любой стороны оповещает обработчик
+    }
+}
+//-----------------------------------------------------------------------------
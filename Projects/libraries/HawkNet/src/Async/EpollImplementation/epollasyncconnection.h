@@ -0,0 +1,191 @@
+#ifndef HMEPOLLASYNCCONNECTION_H
+#define HMEPOLLASYNCCONNECTION_H
+
+/**
+ * @file epollasyncconnection.h
+ * @brief Содержит описание асинхронного соединения на неблокирующем сокете и epoll
+ */
+
+#include <mutex>
+#include <memory>
+#include <string>
+
+#include "Buffers/receivebuffer.h"
+#include "Async/Abstract/abstractasyncconnection.h"
+#include "epollloop.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMEpollAsyncConnection class - Класс, описывающий асинхронное TCP соединение на epoll
+ * Сокет обслуживается циклом epoll в режиме edge-triggered: калбеки вызываются в потоке цикла.
+ * Клиентское соединение владеет собственным циклом, серверное - использует цикл принявшего его сервера.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMEpollAsyncConnection : public HMAbstractAsyncConnection, public HMEpollHandler
+{
+public:
+
+    /**
+     * @brief HMEpollAsyncConnection - Инициализирующий конструктор (Сторона клиента)
+     * @param inHost - Адрес хоста
+     * @param inPort - Рабочий порт хоста
+     * @param inCallbacks - Перечень калбеков
+     */
+    HMEpollAsyncConnection(const std::string& inHost, const uint16_t inPort, const ConCallbacks& inCallbacks);
+
+    /**
+     * @brief HMEpollAsyncConnection - Инициализирующий конструктор (Сторона сервера)
+     * @param inFd - Дескриптор принятого неблокирующего сокета
+     * @param inLoop - Цикл, обслуживающий сокет
+     * @param inCallbacks - Перечень калбеков
+     */
+    HMEpollAsyncConnection(const int inFd, HMEpollLoop& inLoop, const ConCallbacks& inCallbacks);
+
+    /**
+     * @brief ~HMEpollAsyncConnection - Виртуальный деструктор
+     */
+    virtual ~HMEpollAsyncConnection() override;
+
+    /**
+     * @brief connect - Метод произведёт подключение
+     * @param inWaitTime - Время ожидания подключения
+     * @return  Вернёт признак ошибки
+     */
+    virtual errors::error_code connect(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
+
+    /**
+     * @brief connectAsync - Метод начнёт подключение, не дожидаясь его завершения
+     * Завершение подключения сокета обнаруживает цикл по его готовности к записи.
+     * @param inWaitTime - Время ожидания подключения
+     * @return Вернёт признак ошибки начала подключения
+     */
+    virtual errors::error_code connectAsync(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
+
+    /**
+     * @brief disconnect - Метод разорвёт соединение (сокет закрывается в потоке цикла)
+     */
+    virtual void disconnect() override;
+
+    /**
+     * @brief retire - Метод передаст циклу закрытие сокета вместе с последней ссылкой на соединение
+     * @param inSelf - Последняя ссылка на это соединение
+     */
+    virtual void retire(std::shared_ptr<HMAbstractConnection>&& inSelf) override;
+
+    /**
+     * @brief status - Метод вернёт текущий статус соединения
+     * @return Вернёт текущий статус соединения
+     */
+    virtual eConnectionStatus status() const override;
+
+    /**
+     * @brief attach - Метод зарегистрирует сокет в цикле (только поток цикла)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code attach();
+
+    /**
+     * @brief getHost - Метод вернёт адрес хоста
+     * @return Вернёт адрес хоста
+     */
+    std::string getHost() const;
+
+    /**
+     * @brief getPort - Метод вернёт рабочй порт
+     * @return Вернёт рабочй порт
+     */
+    uint16_t getPort() const;
+
+protected:
+
+    /**
+     * @brief afterWrite - Метод продолжит запись циклом, пока пачки уходят в сокет целиком
+     */
+    virtual void afterWrite() override;
+
+    /**
+     * @brief prepateNextData - Метод добавит сообщение к подготавливаемой записи
+     * @param inFrame - Сообщение, подготовленное к отправке
+     */
+    virtual void prepateNextData(OutFrame&& inFrame) override;
+
+    /**
+     * @brief write - Отправка подготовленной пачки данных
+     * Пишет прямо из вызывающего потока, а остаток, не принятый сокетом, дописывает цикл по EPOLLOUT.
+     */
+    virtual void write() override;
+
+    /**
+     * @brief disconnectLater - Метод передаст закрытие сокета циклу, не дожидаясь его выполнения
+     * @param inReason - Причина разрыва (передаётся обработчику ошибок)
+     */
+    virtual void disconnectLater(const errors::error_code inReason) override;
+
+    /**
+     * @brief armTimers - Метод переставит таймер сроков соединения на колесе цикла (вызов из чужого потока передаётся циклу)
+     */
+    virtual void armTimers() override;
+
+    /**
+     * @brief onEvents - Метод обработает события сокета (поток цикла)
+     * @param inEvents - Маска событий epoll
+     */
+    virtual void onEvents(const std::uint32_t inEvents) override;
+
+private:
+
+    std::string m_host = "";                            ///< Адрес хоста
+    uint16_t m_port = 0;                                ///< Рабочий порт
+
+    std::unique_ptr<HMEpollLoop> m_ownLoop = nullptr;   ///< Собственный цикл клиентского соединения
+    HMEpollLoop* m_loop = nullptr;                      ///< Цикл, обслуживающий сокет
+    std::atomic<eConnectionStatus> m_status;            ///< Текущий статус соединения
+
+    std::mutex m_writeDefender;         ///< Мьютекс, защищающий дескриптор и буфер отправки от закрытия во время записи
+    int m_fd = -1;                      ///< Дескриптор сокета
+    std::string m_writeBuffer;          ///< Буфер, из которого происходит отправка
+    std::size_t m_writeOffset = 0;      ///< Количество байт буфера отправки, принятых сокетом
+    bool m_waitWritable = false;        ///< Сокет переполнен, остаток допишет цикл по EPOLLOUT
+    std::thread::id m_batchSentBy;      ///< Поток, чья пачка принята сокетом целиком (он и продолжает запись)
+
+    HMReceiveBuffer m_readBuffer;       ///< Буфер, в который происходит чтение (только поток цикла)
+    HMWheelTimer m_deadlineTimer;      ///< Таймер сроков (проверки связи и запросов) на колесе цикла (только поток цикла)
+    HMWheelTimer m_connectTimer;       ///< Таймер ожидания подключения, начатого connectAsync (только поток цикла)
+
+    /**
+     * @brief flush - Метод отправит в сокет остаток буфера отправки (под m_writeDefender)
+     * @return Вернёт true, если буфер отправлен целиком
+     */
+    bool flush();
+
+    /**
+     * @brief readAll - Метод вычитает сокет до EAGAIN и передаст обработчику полные кадры (поток цикла)
+     */
+    void readAll();
+
+    /**
+     * @brief readFrames - Метод передаст обработчику все полные кадры буфера приёма (поток цикла)
+     */
+    void readFrames();
+
+    /**
+     * @brief finishConnect - Метод завершит подключение, начатое connectAsync, и оповестит обработчик (поток цикла)
+     * @param inError - Исход подключения
+     */
+    void finishConnect(const errors::error_code inError);
+
+    /**
+     * @brief closeSocket - Метод закроет сокет и оповестит обработчиков (поток цикла)
+     * Подключение, начатое connectAsync и прерванное закрытием, сообщается обработчику подключения, а не разрыва.
+     * @param inError - Причина закрытия (ошибка передаётся обработчику, если задана)
+     */
+    void closeSocket(const errors::error_code inError);
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMEPOLLASYNCCONNECTION_H
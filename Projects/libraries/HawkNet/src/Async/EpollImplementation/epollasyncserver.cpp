@@ -0,0 +1,141 @@
+#include "epollasyncserver.h"
+
+#include <cerrno>
+#include <thread>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+#include <neterrorcategory.h>
+
+#include "epollasyncconnection.h"
+#include "Async/Posix/posixsocket.h"
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+// Acceptor
+//-----------------------------------------------------------------------------
+HMEpollAsyncServer::Acceptor::Acceptor(HMEpollAsyncServer& inServer, const int inFd) :
+    HMEpollHandler(),
+    m_server(inServer),
+    m_fd(inFd),
+    m_loop(std::make_unique<HMEpollLoop>())
+{
+
+}
+//-----------------------------------------------------------------------------
+HMEpollAsyncServer::Acceptor::~Acceptor()
+{
+    m_loop->stop(); // Сначала останавливаем цикл, чтобы он не обратился к закрытому сокету
+    ::close(m_fd);
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncServer::Acceptor::onEvents(const std::uint32_t)
+{
+    bool Proceed = true;
+
+    while (Proceed) // В режиме edge-triggered принимаем все ожидающие подключения
+    {
+        const int NewFd = ::accept4(m_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (NewFd >= 0 && !m_server.admitConnection()) // Подключение сверх предела частоты закрываем, не создавая соединения
+            ::close(NewFd);
+        else if (NewFd >= 0)
+        {
+            auto NewConnection = std::make_unique<HMEpollAsyncConnection>(NewFd, *m_loop, m_server.m_Callbacks.m_conCalbacks);
+            errors::error_code Error = NewConnection->attach(); // Соединение обслуживается циклом, принявшим его
+
+            if (!Error)
+                m_server.onNewConnection(std::move(NewConnection)); // Отправляем его на регистрацию
+            else if (m_server.m_Callbacks.m_ErrorCallBack)
+                m_server.m_Callbacks.m_ErrorCallBack(Error);
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) // Очередь подключений пуста
+            Proceed = false;
+        else if (errno != EINTR && errno != ECONNABORTED) // Например, исчерпаны дескрипторы
+        {
+            if (m_server.m_Callbacks.m_ErrorCallBack)
+                m_server.m_Callbacks.m_ErrorCallBack(convertingSocketError(errno));
+
+            Proceed = false;
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+// HMEpollAsyncServer
+//-----------------------------------------------------------------------------
+HMEpollAsyncServer::HMEpollAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops) :
+    HMAbstractAsyncServer(inCallbacks),
+    m_port(inPort),
+    m_loopsCount(inLoops)
+{
+
+}
+//-----------------------------------------------------------------------------
+HMEpollAsyncServer::~HMEpollAsyncServer()
+{
+    stop(); // При завершении обязательно останавливаем сервер
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollAsyncServer::start()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    stop(); // Принудительная остановка
+
+    std::size_t LoopsCount = m_loopsCount;
+
+    if (LoopsCount == 0) // Количество не задано, занимаем все ядра
+        LoopsCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (!portIsFree(m_port))
+        Error = make_error_code(errors::eNetError::neStartListenFail);
+
+    while (!Error && m_acceptors.size() < LoopsCount)
+    {
+        const int ListenFd = makeReusePortListener(m_port, Error);
+
+        if (!Error)
+        {
+            auto NewAcceptor = std::make_unique<Acceptor>(*this, ListenFd);
+            Error = NewAcceptor->m_loop->start();
+
+            if (!Error)
+            {
+                Acceptor* Handler = NewAcceptor.get();
+                NewAcceptor->m_loop->invoke([Handler, &Error]() { Error = Handler->m_loop->add(Handler->m_fd, EPOLLIN | EPOLLET, Handler); });
+            }
+
+            m_acceptors.push_back(std::move(NewAcceptor)); // При ошибке будет освобождён вместе с остальными
+        }
+    }
+
+    if (Error) // Сервер не запущен целиком
+        m_acceptors.clear();
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMEpollAsyncServer::isStarted() const
+{
+    return !m_acceptors.empty();
+}
+//-----------------------------------------------------------------------------
+void HMEpollAsyncServer::stop()
+{
+    if (!isStarted()) // Если сервер не запущен то нет смысла
+        return;
+
+    for (const auto& CurrentAcceptor : m_acceptors) // Прекращаем приём, чтобы не пропустить соединения при закрытии
+    {
+        Acceptor* Handler = CurrentAcceptor.get();
+        Handler->m_loop->invoke([Handler]() { Handler->m_loop->remove(Handler->m_fd); });
+    }
+
+    closeAllConnections(); // Закрываем все соединения (каждое в своём цикле)
+    m_acceptors.clear(); // Останавливаем циклы и закрываем слушающие сокеты
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+#ifndef HMEPOLLASYNCSERVER_H
+#define HMEPOLLASYNCSERVER_H
+
+/**
+ * @file epollasyncserver.h
+ * @brief Содержит описание асинхронного сервера на неблокирующих сокетах и epoll
+ */
+
+#include <memory>
+#include <vector>
+
+#include "Async/Abstract/abstractasyncserver.h"
+#include "epollloop.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMEpollAsyncServer class - Класс, описывающий асинхронный TCP сервер на epoll
+ * Каждый цикл (по одному на ядро) слушает порт собственным сокетом с SO_REUSEPORT,
+ * поэтому ядро само распределяет подключения, а соединение живёт в принявшем его цикле.
+ * Калбеки соединений вызываются в потоках циклов.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMEpollAsyncServer : public HMAbstractAsyncServer
+{
+public:
+
+    /**
+     * @brief HMEpollAsyncServer - Инициализирующий конструктор
+     * @param inPort - Прослушиваемый порт
+     * @param inCallbacks - Перечень калбеков
+     * @param inLoops - Количество циклов epoll (0 - по количеству ядер)
+     */
+    HMEpollAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops = 0);
+
+    /**
+     * @brief ~HMEpollAsyncServer - Виртуальный деструктор
+     */
+    virtual ~HMEpollAsyncServer() override;
+
+    /**
+     * @brief start - Метод запустит сервер
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code start() override;
+
+    /**
+     * @brief isStarted - Метод вернёт состояние сервера
+     * @return Вернёт состояние сервера
+     */
+    virtual bool isStarted() const override;
+
+    /**
+     * @brief stop - Метод остановит сервер
+     */
+    virtual void stop() override;
+
+private:
+
+    /**
+     * @brief The Acceptor class - Класс, принимающий подключения на сокете одного цикла
+     */
+    class Acceptor : public HMEpollHandler
+    {
+    public:
+
+        /**
+         * @brief Acceptor - Инициализирующий конструктор
+         * @param inServer - Сервер, регистрирующий соединения
+         * @param inFd - Слушающий сокет
+         */
+        Acceptor(HMEpollAsyncServer& inServer, const int inFd);
+
+        /**
+         * @brief ~Acceptor - Виртуальный деструктор (закрывает слушающий сокет)
+         */
+        virtual ~Acceptor() override;
+
+        /**
+         * @brief onEvents - Метод примет все ожидающие подключения (поток цикла)
+         * @param inEvents - Маска событий epoll
+         */
+        virtual void onEvents(const std::uint32_t inEvents) override;
+
+        HMEpollAsyncServer& m_server;               ///< Сервер, регистрирующий соединения
+        const int m_fd = -1;                        ///< Слушающий сокет
+        std::unique_ptr<HMEpollLoop> m_loop = nullptr; ///< Цикл, обслуживающий принятые соединения
+    };
+
+    std::uint16_t m_port = 0;                           ///< Рабочий порт
+    const std::size_t m_loopsCount = 0;                 ///< Количество циклов
+    std::vector<std::unique_ptr<Acceptor>> m_acceptors; ///< Приёмники подключений со своими циклами
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMEPOLLASYNCSERVER_H
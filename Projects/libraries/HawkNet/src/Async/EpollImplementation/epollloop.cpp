@@ -0,0 +1,224 @@
+#include "epollloop.h"
+
+#include <future>
+#include <cerrno>
+#include <cassert>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include <neterrorcategory.h>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMEpollLoop::HMEpollLoop() : hmcommon::HMNotCopyable()
+{
+    std::atomic_init(&m_threadID, std::thread::id());
+    std::atomic_init(&m_stopRequested, false);
+}
+//-----------------------------------------------------------------------------
+HMEpollLoop::~HMEpollLoop()
+{
+    stop();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollLoop::start()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    stop(); // Принудительная остановка
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_epollFd < 0 || m_wakeFd < 0)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+    else
+    {
+        epoll_event Event {};
+        Event.events = EPOLLIN; // Дескриптор пробуждения обрабатывается по уровню
+        Event.data.ptr = nullptr; // Пустой обработчик отличает его от сокетов
+
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &Event) != 0)
+            Error = make_error_code(errors::eNetError::neSocketResourceError);
+    }
+
+    if (!Error)
+    {
+        {
+            std::lock_guard lg(m_tasksDefender);
+            m_acceptTasks = true;
+        }
+
+        m_stopRequested = false;
+        m_thread = std::thread(&HMEpollLoop::run, this);
+    }
+    else
+        stop(); // Освобождаем частично созданные дескрипторы
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::stop()
+{
+    if (m_thread.joinable())
+    {
+        assert(!inLoopThread()); // Поток не может дождаться сам себя
+        m_stopRequested = true;
+        wake();
+        m_thread.join();
+    }
+
+    if (m_wakeFd >= 0)
+    {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+
+    if (m_epollFd >= 0)
+    {
+        ::close(m_epollFd);
+        m_epollFd = -1;
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMEpollLoop::isRunning() const
+{
+    std::lock_guard lg(m_tasksDefender);
+    return m_acceptTasks;
+}
+//-----------------------------------------------------------------------------
+bool HMEpollLoop::inLoopThread() const
+{
+    return m_threadID.load() == std::this_thread::get_id();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMEpollLoop::add(const int inFd, const std::uint32_t inEvents, HMEpollHandler* inHandler)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    assert(inHandler != nullptr);
+
+    epoll_event Event {};
+    Event.events = inEvents;
+    Event.data.ptr = inHandler;
+
+    if (m_epollFd < 0)
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, inFd, &Event) != 0)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::remove(const int inFd)
+{
+    if (m_epollFd >= 0)
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, inFd, nullptr);
+}
+//-----------------------------------------------------------------------------
+bool HMEpollLoop::post(LoopTaskFn&& inTask)
+{
+    bool Result = false;
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+
+        if (m_acceptTasks) // Остановленный цикл задачи не принимает, иначе они никогда не выполнятся
+        {
+            m_tasks.push_back(std::move(inTask));
+            Result = true;
+        }
+    }
+
+    if (Result)
+        wake();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::invoke(LoopTaskFn&& inTask)
+{
+    if (inLoopThread())
+        inTask();
+    else
+    {
+        std::promise<void> Done;
+        std::future<void> DoneFuture = Done.get_future();
+        LoopTaskFn Task = std::move(inTask);
+
+        if (post([&Task, &Done]() { Task(); Done.set_value(); }))
+            DoneFuture.wait();
+        else // Цикл остановлен: доступ к дескрипторам уже не конкурирует с ним
+            Task();
+    }
+}
+//-----------------------------------------------------------------------------
+HMTimerWheel& HMEpollLoop::timers()
+{
+    return m_timers;
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::run()
+{
+    m_threadID = std::this_thread::get_id();
+    std::vector<epoll_event> Events(C_EPOLL_MAX_EVENTS);
+
+    while (!m_stopRequested)
+    {
+        const int Timeout = static_cast<int>(m_timers.nextTimeout(std::chrono::steady_clock::now()).count()); // Без таймеров ждём бесконечно
+        const int Count = ::epoll_wait(m_epollFd, Events.data(), static_cast<int>(Events.size()), Timeout);
+
+        if (Count < 0 && errno != EINTR) // Дескриптор epoll испорчен, продолжать бессмысленно
+            break;
+
+        for (int Index = 0; Index < Count; ++Index)
+        {
+            HMEpollHandler* Handler = static_cast<HMEpollHandler*>(Events[Index].data.ptr);
+
+            if (Handler)
+                Handler->onEvents(Events[Index].events);
+            else // Пробуждение: сбрасываем счётчик eventfd
+            {
+                std::uint64_t Counter = 0;
+                while (::read(m_wakeFd, &Counter, sizeof(Counter)) > 0) {}
+            }
+        }
+
+        runTasks(); // Задачи выполняются после всей пачки событий, чтобы не снимать обработчики посреди неё
+        m_timers.advance(std::chrono::steady_clock::now()); // Сработавшие таймеры, как и задачи, вне обработки пачки
+    }
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+        m_acceptTasks = false;
+    }
+
+    runTasks(); // Выполняем задачи, принятые до остановки: их могут ожидать чужие потоки
+    m_threadID = std::thread::id();
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::runTasks()
+{
+    std::vector<LoopTaskFn> Tasks;
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+        Tasks.swap(m_tasks);
+    }
+
+    for (LoopTaskFn& Task : Tasks)
+        Task();
+}
+//-----------------------------------------------------------------------------
+void HMEpollLoop::wake() const
+{
+    const std::uint64_t One = 1;
+
+    if (m_wakeFd >= 0)
+    {
+        [[maybe_unused]] const ssize_t Written = ::write(m_wakeFd, &One, sizeof(One)); // Переполнение счётчика означает, что цикл и так разбужен
+    }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,161 @@
+#ifndef HMEPOLLLOOP_H
+#define HMEPOLLLOOP_H
+
+/**
+ * @file epollloop.h
+ * @brief Содержит описание цикла событий epoll
+ */
+
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+#include <HawkCommon.h>
+#include <errorcode.h>
+
+#include "Timers/timerwheel.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+constexpr int C_EPOLL_MAX_EVENTS = 256; ///< Количество событий, забираемых за один вызов epoll_wait
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMEpollHandler class - Интерфейс обработчика событий файлового дескриптора
+ */
+class HMEpollHandler
+{
+public:
+
+    /**
+     * @brief ~HMEpollHandler - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMEpollHandler() = default;
+
+    /**
+     * @brief onEvents - Метод обработает события дескриптора (вызывается в потоке цикла)
+     * @param inEvents - Маска событий epoll
+     */
+    virtual void onEvents(const std::uint32_t inEvents) = 0;
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief LoopTaskFn - Тип задачи, выполняемой в потоке цикла
+ */
+typedef std::function<void()> LoopTaskFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMEpollLoop class - Класс, описывающий цикл событий epoll в собственном потоке
+ * Дескрипторы регистрируются и снимаются только в потоке цикла, чужие потоки передают ему задачи.
+ * Колесо таймеров цикла продвигается после каждой пачки событий, epoll_wait ждёт не дольше ближайшего срока.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMEpollLoop : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMEpollLoop - Конструктор по умолчанию
+     */
+    HMEpollLoop();
+
+    /**
+     * @brief ~HMEpollLoop - Виртуальный деструктор (останавливает цикл)
+     */
+    virtual ~HMEpollLoop() override;
+
+    /**
+     * @brief start - Метод запустит поток цикла
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code start();
+
+    /**
+     * @brief stop - Метод остановит поток цикла, выполнив уже переданные задачи
+     */
+    void stop();
+
+    /**
+     * @brief isRunning - Метод вернёт признак работы цикла (приёма задач)
+     * @return Вернёт признак работы цикла
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief inLoopThread - Метод проверит, выполняется ли вызов в потоке цикла
+     * @return Вернёт true для потока цикла
+     */
+    bool inLoopThread() const;
+
+    /**
+     * @brief add - Метод зарегистрирует дескриптор (только поток цикла или до запуска)
+     * @param inFd - Файловый дескриптор
+     * @param inEvents - Маска ожидаемых событий
+     * @param inHandler - Обработчик событий
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code add(const int inFd, const std::uint32_t inEvents, HMEpollHandler* inHandler);
+
+    /**
+     * @brief remove - Метод снимет дескриптор с учёта (только поток цикла или после остановки)
+     * @param inFd - Файловый дескриптор
+     */
+    void remove(const int inFd);
+
+    /**
+     * @brief post - Метод передаст задачу в поток цикла
+     * @param inTask - Задача
+     * @return Вернёт false, если цикл остановлен и задача не принята
+     */
+    bool post(LoopTaskFn&& inTask);
+
+    /**
+     * @brief invoke - Метод выполнит задачу в потоке цикла и дождётся её завершения
+     * В потоке цикла или у остановленного цикла задача выполняется сразу.
+     * @param inTask - Задача
+     */
+    void invoke(LoopTaskFn&& inTask);
+
+    /**
+     * @brief timers - Метод вернёт колесо таймеров цикла (только поток цикла)
+     * @return Вернёт колесо таймеров
+     */
+    HMTimerWheel& timers();
+
+private:
+
+    int m_epollFd = -1;                     ///< Дескриптор epoll
+    int m_wakeFd = -1;                      ///< Дескриптор eventfd для пробуждения цикла
+    std::thread m_thread;                   ///< Поток цикла
+    std::atomic<std::thread::id> m_threadID; ///< Идентификатор потока цикла
+    std::atomic_bool m_stopRequested;       ///< Флаг запроса остановки
+
+    mutable std::mutex m_tasksDefender;     ///< Мьютекс, защищающий очередь задач
+    std::vector<LoopTaskFn> m_tasks;        ///< Задачи, переданные из чужих потоков
+    bool m_acceptTasks = false;             ///< Признак приёма задач
+
+    HMTimerWheel m_timers;                  ///< Колесо таймеров цикла
+
+    /**
+     * @brief run - Метод, выполняемый в потоке цикла
+     */
+    void run();
+
+    /**
+     * @brief runTasks - Метод выполнит накопленные задачи
+     */
+    void runTasks();
+
+    /**
+     * @brief wake - Метод разбудит поток цикла
+     */
+    void wake() const;
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMEPOLLLOOP_H
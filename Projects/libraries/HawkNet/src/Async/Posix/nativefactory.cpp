@@ -0,0 +1,32 @@
+#include "nativefactory.h"
+
+#include "Async/EpollImplementation/epollasyncserver.h"
+#include "Async/EpollImplementation/epollasyncconnection.h"
+#include "Async/UringImplementation/uringasyncserver.h"
+#include "Async/UringImplementation/uringasyncconnection.h"
+
+//-----------------------------------------------------------------------------
+std::unique_ptr<net::HMServer> net::makeNativeServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops)
+{
+    std::unique_ptr<HMServer> Result = nullptr;
+
+    if (HMUringLoop::isSupported())
+        Result = std::make_unique<HMUringAsyncServer>(inPort, inCallbacks, inLoops);
+    else // Старое ядро или io_uring запрещён настройками системы
+        Result = std::make_unique<HMEpollAsyncServer>(inPort, inCallbacks, inLoops);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::unique_ptr<net::HMConnection> net::makeNativeConnection(const std::string& inHost, const std::uint16_t inPort, const ConCallbacks& inCallbacks)
+{
+    std::unique_ptr<HMConnection> Result = nullptr;
+
+    if (HMUringLoop::isSupported())
+        Result = std::make_unique<HMUringAsyncConnection>(inHost, inPort, inCallbacks);
+    else // Старое ядро или io_uring запрещён настройками системы
+        Result = std::make_unique<HMEpollAsyncConnection>(inHost, inPort, inCallbacks);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+#ifndef HMNATIVEFACTORY_H
+#define HMNATIVEFACTORY_H
+
+/**
+ * @file nativefactory.h
+ * @brief Содержит описание функций выбора системной сетевой реализации (io_uring или epoll)
+ */
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#include "Interface/server.h"
+#include "Interface/connection.h"
+#include "Async/Abstract/abstractasyncserver.h"
+#include "Async/Abstract/abstractasyncconnection.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeNativeServer - Функция сформирует сервер на io_uring, а если ядро его не поддерживает - на epoll
+ * @param inPort - Прослушиваемый порт
+ * @param inCallbacks - Перечень калбеков
+ * @param inLoops - Количество циклов (0 - по количеству ядер)
+ * @return Вернёт указатель на интерфейс сервера
+ */
+std::unique_ptr<HMServer> makeNativeServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops = 0);
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeNativeConnection - Функция сформирует соединение на io_uring, а если ядро его не поддерживает - на epoll
+ * @param inHost - Адрес хоста
+ * @param inPort - Рабочий порт хоста
+ * @param inCallbacks - Перечень калбеков
+ * @return Вернёт указатель на интерфейс соединения
+ */
+std::unique_ptr<HMConnection> makeNativeConnection(const std::string& inHost, const std::uint16_t inPort, const ConCallbacks& inCallbacks);
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMNATIVEFACTORY_H
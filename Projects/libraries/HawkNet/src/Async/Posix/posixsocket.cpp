@@ -0,0 +1,210 @@
+#include "posixsocket.h"
+
+#include <cerrno>
+
+#include <poll.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <neterrorcategory.h>
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief anyAddress - Функция сформирует адрес IPv4 всех интерфейсов с заданным портом
+ * @param inPort - Порт
+ * @return Вернёт адрес сокета
+ */
+static sockaddr_in anyAddress(const std::uint16_t inPort)
+{
+    sockaddr_in Result {};
+    Result.sin_family = AF_INET;
+    Result.sin_addr.s_addr = htonl(INADDR_ANY);
+    Result.sin_port = htons(inPort);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code net::convertingSocketError(const int inErrno)
+{
+    errors::eNetError neErrorCode;
+
+    switch (inErrno)
+    {
+        case ECONNREFUSED:      { neErrorCode = errors::eNetError::neConnectionRefusedError; break; }
+        case ECONNRESET:
+        case EPIPE:             { neErrorCode = errors::eNetError::neRemoteHostClosedError; break; }
+        case EACCES:
+        case EPERM:             { neErrorCode = errors::eNetError::neSocketAccessError; break; }
+        case EMFILE:
+        case ENFILE:
+        case ENOBUFS:
+        case ENOMEM:            { neErrorCode = errors::eNetError::neSocketResourceError; break; }
+        case ETIMEDOUT:         { neErrorCode = errors::eNetError::neSocketTimeoutError; break; }
+        case ENETDOWN:
+        case ENETUNREACH:
+        case EHOSTUNREACH:      { neErrorCode = errors::eNetError::neNetworkError; break; }
+        case EADDRINUSE:        { neErrorCode = errors::eNetError::neAddressInUseError; break; }
+        case EADDRNOTAVAIL:     { neErrorCode = errors::eNetError::neSocketAddressNotAvailableError; break; }
+        case EAGAIN:            { neErrorCode = errors::eNetError::neTemporaryError; break; }
+        default:                { neErrorCode = errors::eNetError::neOperationError; }
+    }
+
+    return make_error_code(neErrorCode);
+}
+//-----------------------------------------------------------------------------
+int net::startConnect(const std::string& inHost, const std::uint16_t inPort, errors::error_code& outError)
+{
+    outError = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int Result = -1;
+
+    addrinfo Hints {};
+    Hints.ai_family = AF_UNSPEC;
+    Hints.ai_socktype = SOCK_STREAM;
+    addrinfo* Address = nullptr;
+
+    if (::getaddrinfo(inHost.c_str(), std::to_string(inPort).c_str(), &Hints, &Address) != 0 || !Address)
+        outError = make_error_code(errors::eNetError::neHostNotFoundError);
+    else
+    {
+        Result = ::socket(Address->ai_family, Address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, Address->ai_protocol);
+
+        if (Result < 0)
+            outError = convertingSocketError(errno);
+        else if (::connect(Result, Address->ai_addr, Address->ai_addrlen) != 0 && errno != EINPROGRESS)
+            outError = convertingSocketError(errno);
+
+        ::freeaddrinfo(Address);
+    }
+
+    if (outError && Result >= 0) // Подключение не началось
+    {
+        ::close(Result);
+        Result = -1;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code net::connectResult(const int inFd)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    int SocketError = 0;
+    socklen_t SocketErrorSize = sizeof(SocketError);
+
+    if (::getsockopt(inFd, SOL_SOCKET, SO_ERROR, &SocketError, &SocketErrorSize) != 0)
+        Error = convertingSocketError(errno);
+    else if (SocketError != 0)
+        Error = convertingSocketError(SocketError);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+int net::connectSocket(const std::string& inHost, const std::uint16_t inPort, const std::chrono::milliseconds inWaitTime, errors::error_code& outError)
+{
+    int Result = startConnect(inHost, inPort, outError);
+
+    if (outError && outError != make_error_code(errors::eNetError::neHostNotFoundError)) // Как и у Qt, отказ сообщается истечением ожидания
+        outError = make_error_code(errors::eNetError::neTimeOut);
+    else if (!outError)
+    {
+        pollfd Poll {};
+        Poll.fd = Result;
+        Poll.events = POLLOUT;
+
+        if (::poll(&Poll, 1, static_cast<int>(inWaitTime.count())) <= 0 || connectResult(Result))
+            outError = make_error_code(errors::eNetError::neTimeOut);
+    }
+
+    if (outError && Result >= 0) // Подключение не состоялось
+    {
+        ::close(Result);
+        Result = -1;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+int net::makeReusePortListener(const std::uint16_t inPort, errors::error_code& outError)
+{
+    outError = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int Result = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (Result < 0)
+        outError = make_error_code(errors::eNetError::neStartListenFail);
+    else
+    {
+        const int Enable = 1;
+        const sockaddr_in Address = anyAddress(inPort);
+
+        if (::setsockopt(Result, SOL_SOCKET, SO_REUSEADDR, &Enable, sizeof(Enable)) != 0 ||
+            ::setsockopt(Result, SOL_SOCKET, SO_REUSEPORT, &Enable, sizeof(Enable)) != 0 ||
+            ::bind(Result, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) != 0 ||
+            ::listen(Result, SOMAXCONN) != 0)
+        {
+            outError = make_error_code(errors::eNetError::neStartListenFail);
+            ::close(Result);
+            Result = -1;
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool net::portIsFree(const std::uint16_t inPort)
+{
+    bool Result = false;
+    const int ProbeFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (ProbeFd >= 0)
+    {
+        const int Enable = 1;
+        const sockaddr_in Address = anyAddress(inPort);
+
+        // SO_REUSEADDR только пропускает соединения в TIME_WAIT, слушающий сокет он не обходит
+        Result = ::setsockopt(ProbeFd, SOL_SOCKET, SO_REUSEADDR, &Enable, sizeof(Enable)) == 0 &&
+                 ::bind(ProbeFd, reinterpret_cast<const sockaddr*>(&Address), sizeof(Address)) == 0;
+
+        ::close(ProbeFd);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::string net::peerHost(const int inFd)
+{
+    char Buffer[INET6_ADDRSTRLEN] = {};
+    sockaddr_storage Address {};
+    socklen_t AddressSize = sizeof(Address);
+
+    if (::getpeername(inFd, reinterpret_cast<sockaddr*>(&Address), &AddressSize) == 0)
+    {
+        if (Address.ss_family == AF_INET)
+            ::inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in&>(Address).sin_addr, Buffer, sizeof(Buffer));
+        else if (Address.ss_family == AF_INET6)
+            ::inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6&>(Address).sin6_addr, Buffer, sizeof(Buffer));
+    }
+
+    return Buffer;
+}
+//-----------------------------------------------------------------------------
+std::uint16_t net::localPort(const int inFd)
+{
+    std::uint16_t Result = 0;
+    sockaddr_storage Address {};
+    socklen_t AddressSize = sizeof(Address);
+
+    if (::getsockname(inFd, reinterpret_cast<sockaddr*>(&Address), &AddressSize) == 0)
+    {
+        if (Address.ss_family == AF_INET)
+            Result = ntohs(reinterpret_cast<const sockaddr_in&>(Address).sin_port);
+        else if (Address.ss_family == AF_INET6)
+            Result = ntohs(reinterpret_cast<const sockaddr_in6&>(Address).sin6_port);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+#ifndef HMPOSIXSOCKET_H
+#define HMPOSIXSOCKET_H
+
+/**
+ * @file posixsocket.h
+ * @brief Содержит описание общих функций работы с сокетами POSIX для реализаций epoll и io_uring
+ */
+
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+#include <errorcode.h>
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief convertingSocketError - Функция преобразует системную ошибку сокета в стандартную
+ * @param inErrno - Значение errno
+ * @return Вернтёт стандартную ошибка
+ */
+errors::error_code convertingSocketError(const int inErrno);
+//-----------------------------------------------------------------------------
+/**
+ * @brief startConnect - Функция начнёт подключение неблокирующего сокета к хосту, не дожидаясь его завершения
+ * Готовность сокета к записи означает завершение подключения, его исход вернёт connectResult.
+ * @param inHost - Адрес хоста (имя разрешается синхронно)
+ * @param inPort - Порт хоста
+ * @param outError - Признак ошибки
+ * @return Вернёт дескриптор подключающегося сокета или -1
+ */
+int startConnect(const std::string& inHost, const std::uint16_t inPort, errors::error_code& outError);
+//-----------------------------------------------------------------------------
+/**
+ * @brief connectResult - Функция вернёт исход подключения сокета, начатого startConnect
+ * @param inFd - Дескриптор сокета
+ * @return Вернёт признак ошибки подключения
+ */
+errors::error_code connectResult(const int inFd);
+//-----------------------------------------------------------------------------
+/**
+ * @brief connectSocket - Функция подключит неблокирующий сокет к хосту, дождавшись завершения подключения
+ * Как и у реализаций Qt, неудавшееся подключение сообщается истечением ожидания.
+ * @param inHost - Адрес хоста
+ * @param inPort - Порт хоста
+ * @param inWaitTime - Время ожидания подключения
+ * @param outError - Признак ошибки
+ * @return Вернёт дескриптор подключённого сокета или -1
+ */
+int connectSocket(const std::string& inHost, const std::uint16_t inPort, const std::chrono::milliseconds inWaitTime, errors::error_code& outError);
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeReusePortListener - Функция сформирует неблокирующий слушающий сокет с SO_REUSEPORT
+ * @param inPort - Прослушиваемый порт
+ * @param outError - Признак ошибки
+ * @return Вернёт дескриптор сокета или -1
+ */
+int makeReusePortListener(const std::uint16_t inPort, errors::error_code& outError);
+//-----------------------------------------------------------------------------
+/**
+ * @brief portIsFree - Функция проверит, что порт не занят другим сервером
+ * SO_REUSEPORT позволил бы второму серверу молча разделить порт, поэтому занятость проверяется пробной привязкой без него.
+ * @param inPort - Проверяемый порт
+ * @return Вернёт true, если порт свободен
+ */
+bool portIsFree(const std::uint16_t inPort);
+//-----------------------------------------------------------------------------
+/**
+ * @brief peerHost - Функция вернёт адрес партнёра подключённого сокета
+ * @param inFd - Дескриптор сокета
+ * @return Вернёт адрес хоста (пустую строку при ошибке)
+ */
+std::string peerHost(const int inFd);
+//-----------------------------------------------------------------------------
+/**
+ * @brief localPort - Функция вернёт локальный порт сокета
+ * @param inFd - Дескриптор сокета
+ * @return Вернёт порт (0 при ошибке)
+ */
+std::uint16_t localPort(const int inFd);
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMPOSIXSOCKET_H
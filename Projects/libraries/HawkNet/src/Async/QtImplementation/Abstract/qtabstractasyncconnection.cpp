@@ -1,10 +1,13 @@
 #include "qtabstractasyncconnection.h"
 
 #include <QHostAddress>
+#include <QAbstractEventDispatcher>
 
 #include <cassert>
 #include <neterrorcategory.h>
 
+#include "netutils.h"
+
 using namespace net;
 
 //-----------------------------------------------------------------------------
@@ -16,6 +19,8 @@ HMQtAbstractAsyncConnection::HMQtAbstractAsyncConnection(const std::string& inHo
     m_socket(std::move(inSocket))
 {
     assert(m_socket != nullptr); // Сокет должен быть валидным
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+    m_connectTimer.setCallback([this]() { finishConnect(make_error_code(errors::eNetError::neTimeOut)); });
 }
 //-----------------------------------------------------------------------------
 HMQtAbstractAsyncConnection::HMQtAbstractAsyncConnection(std::unique_ptr<QTcpSocket>&& inSocket, const ConCallbacks& inCallbacks) :
@@ -26,6 +31,8 @@ HMQtAbstractAsyncConnection::HMQtAbstractAsyncConnection(std::unique_ptr<QTcpSoc
     assert(m_socket != nullptr); // Сокет должен быть валидным
     m_host = m_socket->peerAddress().toString().toStdString();
     m_port = m_socket->localPort();
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+    m_connectTimer.setCallback([this]() { finishConnect(make_error_code(errors::eNetError::neTimeOut)); });
 }
 //-----------------------------------------------------------------------------
 errors::error_code HMQtAbstractAsyncConnection::connect(const std::chrono::milliseconds inWaitTime)
@@ -33,41 +40,124 @@ errors::error_code HMQtAbstractAsyncConnection::connect(const std::chrono::milli
     errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
 
     disconnect(); // Принудительный разрыв соединения
+    Error = beginConnect();
 
-    if (!m_socket)  // Сокет не инициализирован
+    // Защищённому соединению достаточно подключения сокета: запись дождётся рукопожатия
+    if (!Error && m_socket->state() != QAbstractSocket::ConnectedState) // Всё ещё не подключён
+        if (!m_socket->waitForConnected(inWaitTime.count())) // Ожидаем подключения указанное время
+            Error = make_error_code(errors::eNetError::neTimeOut);
+
+    if (!Error) // Соединение установлено
+    {
+        armTimers(); // Отсчёт простоя начинается с установки соединения
+        Error = announceFraming(); // Согласуем режим кадрирования с сервером
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMQtAbstractAsyncConnection::connectAsync(const std::chrono::milliseconds inWaitTime)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    if (!m_socket) // Сокет не инициализирован
         Error = make_error_code(errors::eNetError::neSocketNotInit);
-    else // Если сокет успешно сформирован
+    else if (QThread::currentThread() != thread()) // Сокетом можно управлять только из его потока
     {
-        m_socket->connectToHost(QString::fromStdString(m_host), static_cast<quint16>(m_port),
-                               QIODevice::ReadWrite, QAbstractSocket::AnyIPProtocol);
+        QMetaObject::invokeMethod(this, [this, inWaitTime]()
+        {
+            const errors::error_code StartError = startConnecting(inWaitTime);
 
-        if (m_socket->state() != QAbstractSocket::ConnectedState) // Всё ещё не подключён
-            if (!m_socket->waitForConnected(inWaitTime.count())) // Ожидаем подключения указанное время
-                Error = make_error_code(errors::eNetError::neTimeOut);
+            if (StartError) // Вызывающему ошибку уже не вернуть
+                onConnected(StartError);
+        }, Qt::QueuedConnection);
     }
+    else
+        Error = startConnecting(inWaitTime);
 
     return Error;
 }
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::disconnect()
 {
-    if (!isConnected())
-        return;
+    // Сокетом рабочего потока можно управлять только из этого потока (пока он жив)
+    const bool InWorker = m_homeThread && thread() != m_homeThread && thread()->isRunning();
 
-    if (m_socket) // Только если сокет инициализирован
+    if (InWorker && QThread::currentThread() != thread()) // Разрыв ставится в очередь потока сокета без ожидания
+        QMetaObject::invokeMethod(this, [this]() { disconnect(); }, Qt::QueuedConnection);
+    else
     {
-        m_socket->abort(); // Прерываем текущее действие
-        m_socket->close(); // Закрываем соединение
+        finishConnect(make_error_code(errors::eNetError::neNotConnected)); // Прерываем подключение, начатое connectAsync
+
+        if (m_socket && isConnected())
+            m_socket->abort(); // Сокет закрывается сразу, неотправленные данные отбрасываются
 
-        if (m_socket->state() != QAbstractSocket::UnconnectedState) // Всё ещё не отключён
-            m_socket->waitForDisconnected(); // Ожидаем разрыва соединения
+        resetSession(); // После разрыва партнёром сокет уже не подключён, но сеанс всё равно сбрасывается
+        leaveWorker(); // Разорванное соединение удаляется вне рабочего потока
     }
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::retire(std::shared_ptr<HMAbstractConnection>&& inSelf)
+{
+    std::shared_ptr<HMAbstractConnection> Self = std::move(inSelf);
+    QAbstractEventDispatcher* Dispatcher = QAbstractEventDispatcher::instance(thread());
 
-    // И очищаем буферы
-    m_writeBuffer.clear();
-    m_readBuffer.clear();
+    if (!Dispatcher) // Поток соединения не обрабатывает события: разрываем сразу, ссылка освободится при выходе
+        disconnect();
+    else // Событие адресуется диспетчеру потока: удалять получателя события из его же обработки нельзя
+    {
+        QMetaObject::invokeMethod(Dispatcher, [this, Self]() mutable
+        {
+            disconnect(); // Соединение рабочего потока при разрыве возвращается в исходный поток
+
+            if (thread() != QThread::currentThread()) // Освобождаем соединение уже в исходном потоке
+                retire(std::move(Self));
+        }, Qt::QueuedConnection);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::disconnectLater(const errors::error_code inReason)
+{
+    // Событие, адресованное удалённому объекту, Qt отбросит сам
+    QMetaObject::invokeMethod(this, [this, inReason]()
+    {
+        if (isConnected())
+        {
+            onError(inReason);
+            disconnect();
+        }
+    }, Qt::QueuedConnection);
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::armTimers()
+{
+    if (QThread::currentThread() != thread()) // Колесо таймеров принадлежит потоку соединения
+        QMetaObject::invokeMethod(this, [this]() { armTimers(); }, Qt::QueuedConnection);
+    else
+    {
+        const std::chrono::steady_clock::time_point Next = checkTimers(std::chrono::steady_clock::now());
 
-    HMAbstractAsyncConnection::disconnect(); // Вызываем метод предка
+        if (Next == std::chrono::steady_clock::time_point::max())
+            m_deadlineTimer.cancel();
+        else
+            HMQtTimerWheel::local().schedule(m_deadlineTimer, Next);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::moveToWorker(WorkerLease&& inLease)
+{
+    assert(inLease != nullptr);
+    assert(QThread::currentThread() == thread()); // Qt позволяет переносить объект только из его потока
+
+    m_homeThread = thread();
+    m_workerLease = std::move(inLease);
+    m_deadlineTimer.cancel(); // Таймер переходит на колесо рабочего потока
+
+    // Сокет не является потомком соединения, поэтому переносится отдельно
+    m_socket->moveToThread(m_workerLease.get());
+    moveToThread(m_workerLease.get());
+
+    armTimers(); // Из чужого теперь потока вызов уйдёт в очередь рабочего
 }
 //-----------------------------------------------------------------------------
 eConnectionStatus HMQtAbstractAsyncConnection::status() const
@@ -103,17 +193,74 @@ uint16_t HMQtAbstractAsyncConnection::getPort() const
     return m_port;
 }
 //-----------------------------------------------------------------------------
-void HMQtAbstractAsyncConnection::prepateNextData(oByteStream&& inData)
+void HMQtAbstractAsyncConnection::prepateNextData(OutFrame&& inFrame)
+{
+    // Данные сообщения (собственные, разделяемые или сжатые) копируются только в буфер записи
+    std::uint8_t Flags = 0;
+    const FrameView Payload = encodePayload(inFrame, Flags);
+
+    if (inFrame.m_mode == eFramingMode::fmLengthPrefixed) // Заголовок добавляется перед полезной нагрузкой, без экранирования
+    {
+        char Header[C_FRAME_HEADER_SIZE];
+        encodeFrameHeader(static_cast<std::uint32_t>(Payload.size()), Flags, Header);
+        m_writeBuffer.append(Header, static_cast<int>(C_FRAME_HEADER_SIZE));
+    }
+
+    m_writeBuffer.append(Payload.data(), static_cast<int>(Payload.size())); // Дописываем сообщение к пачке
+
+    // Собственным данным разделитель добавлен при постановке в очередь, разделяемые изменять нельзя
+    if (inFrame.m_shared && inFrame.m_mode != eFramingMode::fmLengthPrefixed && (Payload.empty() || Payload.back() != C_DATA_SEPARATOR))
+        m_writeBuffer.append(C_DATA_SEPARATOR);
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::afterWrite()
 {
-    m_writeBuffer = QByteArray::fromStdString(inData.str()); // Преобразуем в понятный Qt контейнер
+    if (QThread::currentThread() == thread()) // Сокет принадлежит текущему потоку
+        HMAbstractAsyncConnection::afterWrite();
+    else // Флаг записи уже взведён, поэтому остальные отправки лишь пополнят очередь
+        QMetaObject::invokeMethod(this, [this]() { HMAbstractAsyncConnection::afterWrite(); }, Qt::QueuedConnection);
 }
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::write()
 {
-    if (!isConnected() || m_writeBuffer.isEmpty())
+    // Флаг записи не даст другим потокам тронуть пачку до её отправки, поэтому её можно передать потоку сокета
+    if (QThread::currentThread() != thread())
+        QMetaObject::invokeMethod(this, [this]() { write(); }, Qt::QueuedConnection);
+    else if (isConnected() && !m_writeBuffer.isEmpty())
+        m_socket->write(m_writeBuffer); // Начинаем отправку
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMQtAbstractAsyncConnection::beginConnect()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    if (!m_socket)  // Сокет не инициализирован
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else
+        m_socket->connectToHost(QString::fromStdString(m_host), static_cast<quint16>(m_port),
+                                QIODevice::ReadWrite, QAbstractSocket::AnyIPProtocol);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::finishConnect(const errors::error_code inError)
+{
+    if (!m_connecting) // Подключение не идёт или уже завершено
         return;
 
-    m_socket->write(m_writeBuffer); // Начинаем отправку
+    errors::error_code Error = inError;
+    m_connecting = false;
+    m_connectTimer.cancel();
+
+    if (Error) // Незавершённое подключение прерывается
+        m_socket->abort();
+    else
+    {
+        armTimers(); // Отсчёт простоя начинается с установки соединения
+        Error = announceFraming(); // Согласуем режим кадрирования с сервером
+    }
+
+    onConnected(Error);
 }
 //-----------------------------------------------------------------------------
 std::unique_ptr<QTcpSocket>& HMQtAbstractAsyncConnection::getSocket()
@@ -121,6 +268,44 @@ std::unique_ptr<QTcpSocket>& HMQtAbstractAsyncConnection::getSocket()
     return m_socket;
 }
 //-----------------------------------------------------------------------------
+errors::error_code HMQtAbstractAsyncConnection::startConnecting(const std::chrono::milliseconds inWaitTime)
+{
+    disconnect(); // Принудительный разрыв соединения
+
+    m_connecting = true; // Сокет может сообщить об ошибке ещё внутри beginConnect
+    errors::error_code Error = beginConnect();
+
+    if (!m_connecting) // Исход уже сообщён сигналом сокета
+        Error = make_error_code(errors::eNetError::neSuccess);
+    else if (Error) // Подключение не началось, исход сообщает вызывающему код ошибки
+        m_connecting = false;
+    else // Исход сообщат сигналы сокета или таймер ожидания
+        HMQtTimerWheel::local().schedule(m_connectTimer, std::chrono::steady_clock::now() + inWaitTime);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::leaveWorker()
+{
+    if (!m_workerLease || QThread::currentThread() != thread()) // Не обслуживается рабочим потоком или он уже остановлен
+        return;
+
+    m_socket->moveToThread(m_homeThread);
+    moveToThread(m_homeThread);
+    m_workerLease = nullptr; // Снимаем соединение с учёта загрузки потока
+}
+//-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::resetSession()
+{
+    // Как и closeSocket реализаций epoll и io_uring: следующий сеанс начинается с чистого состояния
+    m_writeBuffer.clear();
+    m_writeOffset = 0;
+    m_readBuffer.clear();
+    m_deadlineTimer.cancel(); // Таймер снимается в потоке своего колеса
+
+    HMAbstractAsyncConnection::disconnect(); // Очередь, флаг записи, согласование, сжатие и ожидающие запросы
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMQtAbstractAsyncConnection::convertingError(const QAbstractSocket::SocketError inQtSocketError)
 {
     errors::eNetError neErrorCode;
@@ -158,12 +343,18 @@ errors::error_code HMQtAbstractAsyncConnection::convertingError(const QAbstractS
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::slot_onBytesWritten(qint64 inBytes)
 {
-    m_writeBuffer = m_writeBuffer.mid(inBytes); // Выкидываем из контейнера отправленые байты
+    /*
+     * Сокет уже принял всю пачку в свой буфер и досылает её сам,
+     * поэтому частичная запись только сдвигает смещение, без повторной записи и нарезки буфера.
+     */
+    m_writeOffset += inBytes;
 
-    if (!m_writeBuffer.isEmpty()) // Если отправлена не вся последовательность
-        write(); // Продолжаем запись
-    else // Если вся последовательнось отправлена
+    if (m_writeOffset >= m_writeBuffer.size()) // Если вся пачка отправлена
+    {
+        m_writeBuffer.resize(0); // Очищаем, сохраняя выделенную память для следующей пачки
+        m_writeOffset = 0;
         afterWrite(); // Обрабатываем завершение записи
+    }
 }
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::slot_onReadyRead()
@@ -171,28 +362,55 @@ void HMQtAbstractAsyncConnection::slot_onReadyRead()
     if (!m_socket)
         return;
 
-    m_readBuffer += m_socket->readAll(); // Читаем пришедший объём данных
+    const qint64 Available = m_socket->bytesAvailable(); // Объём пришедших данных
 
-    auto SepPos = m_readBuffer.indexOf(C_DATA_SEPARATOR); // Ищим разделитель потока
+    if (Available > 0) // Читаем прямо в свободный хвост буфера, минуя промежуточный QByteArray
+    {
+        char* WritePos = m_readBuffer.prepare(static_cast<std::size_t>(Available));
+        const qint64 ReadBytes = m_socket->read(WritePos, Available);
+
+        if (ReadBytes > 0)
+        {
+            markActivity();
+            m_readBuffer.commit(static_cast<std::size_t>(ReadBytes));
+        }
+    }
+
+    FrameInfo Frame; // Описание очередного кадра
+    errors::error_code Error;
 
-    while (SepPos > 0) // Если в буфере найден разделитель потока
+    // Обработчик может разорвать соединение и очистить буфер, поэтому его размер проверяется на каждой итерации
+    while (!m_readBuffer.empty() && nextFrame(m_readBuffer.data(), m_readBuffer.size(), Frame, Error)) // Пока в буфере есть полные кадры
     {
-        iByteStream OutData(m_readBuffer.left(SepPos).data()); // Формируем поток из полученных данных
-        onReadEnd(std::move(OutData)); // Завершаем чтение порции данных
+        onReadFrame(Frame, FrameView(m_readBuffer.data() + Frame.m_offset, Frame.m_length)); // Передаём кадр без копирования
+        m_readBuffer.consume(Frame.m_size); // Отбрасываем обработанный кадр сдвигом смещения
+    }
 
-        m_readBuffer = m_readBuffer.mid(SepPos + 1); // Удаляем из буфера прочитанные данные
-        SepPos = m_readBuffer.indexOf(C_DATA_SEPARATOR); // Ещё раз ищим разделитель потока
+    if (Error) // Поток повреждён, восстановить границы кадров невозможно
+    {
+        m_readBuffer.clear();
+        onError(Error);
     }
 }
 //-----------------------------------------------------------------------------
+void HMQtAbstractAsyncConnection::slot_onConnected()
+{
+    finishConnect(make_error_code(errors::eNetError::neSuccess));
+}
+//-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::slot_onDisconnected()
 {
+    resetSession(); // Разрыв партнёром сбрасывает сеанс так же, как и собственный
     onDisconnect();
 }
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncConnection::slot_onErrorOccurred(QAbstractSocket::SocketError inError)
 {
     qDebug() << inError;
-    onError(convertingError(inError)); // Преобразуем ошибку QtSocket в стандартную и отправляем обработчику
+
+    if (m_connecting) // Ошибка подключения, начатого connectAsync, передаётся обработчику подключения
+        finishConnect(convertingError(inError));
+    else
+        onError(convertingError(inError)); // Преобразуем ошибку QtSocket в стандартную и отправляем обработчику
 }
 //-----------------------------------------------------------------------------
@@ -10,7 +10,10 @@
 
 #include <QTcpSocket>
 
+#include "Buffers/receivebuffer.h"
 #include "Async/Abstract/abstractasyncconnection.h"
+#include "qtworkerpool.h"
+#include "qttimerwheel.h"
 
 namespace net
 {
@@ -54,11 +57,36 @@ public:
      */
     virtual errors::error_code connect(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
 
+    /**
+     * @brief connectAsync - Метод начнёт подключение, не дожидаясь его завершения
+     * Из чужого потока подключение ставится в очередь потока сокета, поэтому ему требуется цикл событий.
+     * Ошибка начала подключения, поставленного в очередь, передаётся обработчику подключения.
+     * @param inWaitTime - Время ожидания подключения
+     * @return Вернёт признак ошибки начала подключения
+     */
+    virtual errors::error_code connectAsync(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
+
     /**
      * @brief disconnect - Метод разорвёт соединение
+     * Для соединения рабочего потока из чужого потока разрыв ставится в очередь рабочего потока
+     * и завершается после возврата (соединение сервера освобождается через retire).
+     * Подключение, начатое connectAsync, прерывается с ошибкой neNotConnected.
      */
     virtual void disconnect() override;
 
+    /**
+     * @brief retire - Метод поставит разрыв соединения и освобождение последней ссылки в очередь событий потока сокета
+     * @param inSelf - Последняя ссылка на это соединение
+     */
+    virtual void retire(std::shared_ptr<HMAbstractConnection>&& inSelf) override;
+
+    /**
+     * @brief moveToWorker - Метод перенесёт соединение вместе с сокетом в рабочий поток
+     * Вызывается из текущего потока соединения. При разрыве соединение возвращается в исходный поток.
+     * @param inLease - Аренда рабочего потока
+     */
+    void moveToWorker(WorkerLease&& inLease);
+
     /**
      * @brief status - Метод вернёт текущий статус соединения
      * @return Вернёт текущий статус соединения
@@ -87,16 +115,48 @@ public:
 protected:
 
     /**
-     * @brief prepateNextData - Метод подготовит данные перед началом записи
-     * @param inData - Данные, подготовленные к отправке
+     * @brief prepateNextData - Метод добавит сообщение к подготавливаемой записи
+     * @param inFrame - Сообщение, подготовленное к отправке
      */
-    virtual void prepateNextData(oByteStream&& inData) override;
+    virtual void prepateNextData(OutFrame&& inFrame) override;
 
     /**
-     * @brief write - Отправка данных
+     * @brief afterWrite - Метод продолжит запись в потоке сокета
+     * Сокет Qt не потокобезопасен, поэтому запись, начатая из чужого потока, переносится в поток сокета
+     */
+    virtual void afterWrite() override;
+
+    /**
+     * @brief write - Отправка подготовленной пачки данных
+     * Запись из чужого потока переносится в поток сокета.
      */
     virtual void write() override;
 
+    /**
+     * @brief beginConnect - Метод начнёт подключение сокета к хосту (в потоке сокета)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginConnect();
+
+    /**
+     * @brief finishConnect - Метод завершит подключение, начатое connectAsync, и оповестит обработчик (в потоке сокета)
+     * Вызов без идущего подключения ничего не делает.
+     * @param inError - Исход подключения (при ошибке сокет прерывается)
+     */
+    void finishConnect(const errors::error_code inError);
+
+    /**
+     * @brief disconnectLater - Метод поставит разрыв соединения в очередь событий потока сокета
+     * @param inReason - Причина разрыва (передаётся обработчику ошибок)
+     */
+    virtual void disconnectLater(const errors::error_code inReason) override;
+
+    /**
+     * @brief armTimers - Метод переставит таймер сроков соединения на колесе потока соединения
+     * Вызов из чужого потока ставится в очередь событий потока соединения.
+     */
+    virtual void armTimers() override;
+
     /**
      * @brief getSocket - Метод вернёт сокет соединения
      * @return Вернёт сокет соединения
@@ -111,7 +171,33 @@ private:
     std::unique_ptr<QTcpSocket> m_socket = nullptr; ///< Простой сокет Qt
 
     QByteArray m_writeBuffer;           ///< Буфер, из которого происходит отправка
-    QByteArray m_readBuffer;            ///< Буфер, в который происходит чтение
+    qint64 m_writeOffset = 0;           ///< Количество байт буфера отправки, подтверждённых сокетом
+    HMReceiveBuffer m_readBuffer;       ///< Буфер, в который происходит чтение
+
+    WorkerLease m_workerLease = nullptr;    ///< Аренда рабочего потока, обслуживающего соединение
+    QThread* m_homeThread = nullptr;        ///< Поток, из которого соединение перенесено в рабочий
+
+    HMWheelTimer m_deadlineTimer;          ///< Таймер сроков (проверки связи и запросов) на колесе потока соединения
+    HMWheelTimer m_connectTimer;           ///< Таймер ожидания подключения, начатого connectAsync
+    bool m_connecting = false;              ///< Признак идущего подключения, начатого connectAsync (только поток сокета)
+
+    /**
+     * @brief startConnecting - Метод начнёт подключение, завершение которого сообщит finishConnect (в потоке сокета)
+     * @param inWaitTime - Время ожидания подключения
+     * @return Вернёт признак ошибки начала подключения
+     */
+    errors::error_code startConnecting(const std::chrono::milliseconds inWaitTime);
+
+    /**
+     * @brief leaveWorker - Метод вернёт соединение из рабочего потока в исходный
+     */
+    void leaveWorker();
+
+    /**
+     * @brief resetSession - Метод сбросит состояние сеанса (буферы, очередь, согласование, сжатие) и завершит ожидающие
+     * запросы ошибкой neNotConnected (в потоке сокета)
+     */
+    void resetSession();
 
 protected slots:
 
@@ -126,6 +212,11 @@ protected slots:
      */
     void slot_onReadyRead();
 
+    /**
+     * @brief slot_onConnected - Слот, обрабатывающий установку соединения
+     */
+    void slot_onConnected();
+
     /**
      * @brief slot_onDisconnected - Слот, обрабытывающий закрытие соединениея
      */
@@ -5,10 +5,11 @@
 using namespace net;
 
 //-----------------------------------------------------------------------------
-HMQtAbstractAsyncServer::HMQtAbstractAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks) :
+HMQtAbstractAsyncServer::HMQtAbstractAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inWorkers) :
     QObject(nullptr),
     HMAbstractAsyncServer(inCallbacks),
-    m_port(inPort)
+    m_port(inPort),
+    m_workersCount(inWorkers)
 {
 
 }
@@ -34,6 +35,8 @@ errors::error_code HMQtAbstractAsyncServer::start()
         {
             if (!m_server->listen(QHostAddress::Any, m_port)) // Пытаемся запустить
                 Error = make_error_code(errors::eNetError::neStartListenFail);
+            else if (m_workersCount > 0) // Запускаем рабочие потоки только у слушающего сервера
+                m_workers = std::make_unique<HMQtWorkerPool>(m_workersCount);
         }
     }
 
@@ -55,10 +58,12 @@ void HMQtAbstractAsyncServer::stop()
     if (!isStarted()) // Если сервер не запущен то нет смысла
         return;
 
-    closeAllConnections(); // Закрываем все соединения
+    closeAllConnections(); // Закрываем все соединения (они возвращаются из рабочих потоков)
 
     if (m_server)
         m_server->close();
+
+    m_workers = nullptr; // Останавливаем рабочие потоки
 }
 //-----------------------------------------------------------------------------
 errors::error_code HMQtAbstractAsyncServer::serverSigSlotConnect()
@@ -87,10 +92,28 @@ void HMQtAbstractAsyncServer::slot_newConnection()
 
     std::unique_ptr<QTcpSocket> NewSocket(m_server->nextPendingConnection());
     NewSocket->setParent(nullptr); // У объекта сокета не должно быть предка (отключаем механихм удаления потомков)
+
+    if (!admitConnection()) // Подключение сверх предела частоты закрываем, не создавая соединения
+    {
+        NewSocket->abort();
+        return;
+    }
+
     std::unique_ptr<HMQtAbstractAsyncConnection> NewConnection = makeConnection(std::move(NewSocket)); // Формируем новое соединение
 
     if (NewConnection) // Если соединение успешно сформировано
-        onNewConnection(std::move(NewConnection)); // Отправляем его на регистрацию
+    {
+        const std::size_t ConnectionID = onNewConnection(std::move(NewConnection)); // Отправляем его на регистрацию
+
+        if (m_workers && ConnectionID) // Переносим зарегистрированное соединение в наименее загруженный рабочий поток
+        {
+            // Удерживаем соединение: обработчик подключения мог успеть его закрыть
+            std::shared_ptr<HMAbstractConnection> Connection = findConnection(ConnectionID);
+
+            if (Connection && Connection->isConnected())
+                std::static_pointer_cast<HMQtAbstractAsyncConnection>(Connection)->moveToWorker(m_workers->acquire());
+        }
+    }
 }
 //-----------------------------------------------------------------------------
 void HMQtAbstractAsyncServer::slot_acceptError(QAbstractSocket::SocketError socketError)
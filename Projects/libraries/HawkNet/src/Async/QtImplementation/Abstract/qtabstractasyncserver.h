@@ -13,6 +13,7 @@
 
 #include "Async/Abstract/abstractasyncserver.h"
 #include "qtabstractasyncconnection.h"
+#include "qtworkerpool.h"
 
 namespace net
 {
@@ -29,8 +30,12 @@ public:
 
     /**
      * @brief HMQtAbstractAsyncServer - Инициализирующий конструктор
+     * @param inPort - Прослушиваемый порт
+     * @param inCallbacks - Перечень калбеков
+     * @param inWorkers - Количество рабочих потоков, обслуживающих соединения (0 - соединения живут в потоке сервера)
+     * При наличии рабочих потоков калбеки соединений вызываются в них
      */
-    HMQtAbstractAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks);
+    HMQtAbstractAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inWorkers = 0);
 
     /**
      * @brief ~HMQtSimpleAsyncServer - Виртуальный деструктор
@@ -80,6 +85,8 @@ private:
 
     std::unique_ptr<QTcpServer> m_server = nullptr; ///< Простой сервер Qt
     std::uint16_t m_port = 0;                       ///< Рабочий порт
+    const std::size_t m_workersCount = 0;           ///< Количество рабочих потоков
+    std::unique_ptr<HMQtWorkerPool> m_workers = nullptr; ///< Рабочие потоки соединений (только у запущенного сервера)
 
 private slots:
 
@@ -0,0 +1,45 @@
+#include "qttimerwheel.h"
+
+#include <QThreadStorage>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMQtTimerWheel::HMQtTimerWheel() : hmcommon::HMNotCopyable()
+{
+    m_timer.setSingleShot(true);
+
+    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]()
+    {
+        m_wheel.advance(std::chrono::steady_clock::now());
+        rearm(); // Сработавшие таймеры могли поставить себя заново
+    });
+}
+//-----------------------------------------------------------------------------
+HMQtTimerWheel& HMQtTimerWheel::local()
+{
+    static QThreadStorage<HMQtTimerWheel*> Wheels; // Колесо потока удаляется при его завершении
+
+    if (!Wheels.hasLocalData())
+        Wheels.setLocalData(new HMQtTimerWheel());
+
+    return *Wheels.localData();
+}
+//-----------------------------------------------------------------------------
+void HMQtTimerWheel::schedule(HMWheelTimer& inTimer, const std::chrono::steady_clock::time_point inDeadline)
+{
+    m_wheel.schedule(inTimer, inDeadline);
+    rearm();
+}
+//-----------------------------------------------------------------------------
+void HMQtTimerWheel::rearm()
+{
+    // Снятые таймеры колесо не перевзводят: лишнее срабатывание просто ничего не найдёт
+    const std::chrono::milliseconds Timeout = m_wheel.nextTimeout(std::chrono::steady_clock::now());
+
+    if (Timeout.count() < 0)
+        m_timer.stop();
+    else
+        m_timer.start(static_cast<int>(Timeout.count()));
+}
+//-----------------------------------------------------------------------------
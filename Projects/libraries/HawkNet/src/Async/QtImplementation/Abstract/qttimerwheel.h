@@ -0,0 +1,69 @@
+#ifndef HMQTTIMERWHEEL_H
+#define HMQTTIMERWHEEL_H
+
+/**
+ * @file qttimerwheel.h
+ * @brief Содержит описание колеса таймеров потока Qt
+ */
+
+#include <chrono>
+
+#include <QTimer>
+
+#include <HawkCommon.h>
+
+#include "Timers/timerwheel.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMQtTimerWheel class - Класс, описывающий колесо таймеров потока Qt
+ * У каждого потока своё колесо, которое продвигает один однократный QTimer, взводимый на ближайший срок,
+ * поэтому тысячи соединений потока не создают тысяч системных таймеров.
+ * Таймеры ставятся и снимаются только в потоке колеса.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMQtTimerWheel : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMQtTimerWheel - Конструктор по умолчанию
+     */
+    HMQtTimerWheel();
+
+    /**
+     * @brief ~HMQtTimerWheel - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMQtTimerWheel() override = default;
+
+    /**
+     * @brief local - Метод вернёт колесо текущего потока (создаётся при первом обращении, разрушается с потоком)
+     * @return Вернёт колесо текущего потока
+     */
+    static HMQtTimerWheel& local();
+
+    /**
+     * @brief schedule - Метод поставит таймер на колесо (поставленный ранее переносится)
+     * @param inTimer - Таймер
+     * @param inDeadline - Срок срабатывания
+     */
+    void schedule(HMWheelTimer& inTimer, const std::chrono::steady_clock::time_point inDeadline);
+
+private:
+
+    HMTimerWheel m_wheel;   ///< Колесо таймеров
+    QTimer m_timer;         ///< Однократный таймер, взведённый на ближайший срок колеса
+
+    /**
+     * @brief rearm - Метод взведёт таймер на ближайший срок колеса
+     */
+    void rearm();
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMQTTIMERWHEEL_H
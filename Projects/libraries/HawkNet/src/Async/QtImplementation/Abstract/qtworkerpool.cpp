@@ -0,0 +1,72 @@
+#include "qtworkerpool.h"
+
+#include <QAbstractEventDispatcher>
+
+#include <cassert>
+#include <algorithm>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMQtWorkerPool::HMQtWorkerPool(const std::size_t inWorkers) : hmcommon::HMNotCopyable()
+{
+    m_workers.resize((inWorkers) ? inWorkers : idealWorkersCount()); // Количество не задано, занимаем все ядра
+
+    for (Worker& CurrentWorker : m_workers)
+    {
+        CurrentWorker.m_thread = std::make_unique<QThread>();
+        CurrentWorker.m_load = std::make_shared<std::atomic_size_t>(0);
+        CurrentWorker.m_thread->start(); // QThread::run по умолчанию крутит собственный цикл событий
+    }
+}
+//-----------------------------------------------------------------------------
+HMQtWorkerPool::~HMQtWorkerPool()
+{
+    for (Worker& CurrentWorker : m_workers)
+    {
+        QAbstractEventDispatcher* Dispatcher = QAbstractEventDispatcher::instance(CurrentWorker.m_thread.get());
+
+        // Выход ставится в очередь за уже отправленными событиями, чтобы потоки успели освободить свои соединения
+        if (Dispatcher)
+            QMetaObject::invokeMethod(Dispatcher, [Thread = CurrentWorker.m_thread.get()]() { Thread->quit(); }, Qt::QueuedConnection);
+        else
+            CurrentWorker.m_thread->quit();
+    }
+
+    for (Worker& CurrentWorker : m_workers)
+        CurrentWorker.m_thread->wait();
+}
+//-----------------------------------------------------------------------------
+WorkerLease HMQtWorkerPool::acquire()
+{
+    assert(!m_workers.empty());
+
+    auto Selected = m_workers.begin();
+
+    for (auto It = std::next(m_workers.begin()); It != m_workers.end(); ++It) // Ищем наименее загруженный поток
+        if (It->m_load->load(std::memory_order_relaxed) < Selected->m_load->load(std::memory_order_relaxed))
+            Selected = It;
+
+    std::shared_ptr<std::atomic_size_t> Load = Selected->m_load;
+    Load->fetch_add(1, std::memory_order_relaxed);
+
+    // Аренда не владеет потоком, её освобождение только снимает соединение с учёта
+    return WorkerLease(Selected->m_thread.get(), [Load](QThread*) { Load->fetch_sub(1, std::memory_order_relaxed); });
+}
+//-----------------------------------------------------------------------------
+std::size_t HMQtWorkerPool::size() const
+{
+    return m_workers.size();
+}
+//-----------------------------------------------------------------------------
+std::size_t HMQtWorkerPool::load(const std::size_t inIndex) const
+{
+    assert(inIndex < m_workers.size());
+    return m_workers[inIndex].m_load->load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMQtWorkerPool::idealWorkersCount()
+{
+    return static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+#ifndef HMQTWORKERPOOL_H
+#define HMQTWORKERPOOL_H
+
+/**
+ * @file qtworkerpool.h
+ * @brief Содержит описание пула рабочих потоков Qt для обслуживания соединений
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QThread>
+
+#include <HawkCommon.h>
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief WorkerLease - Тип "аренды" рабочего потока
+ * Пока аренда жива, поток учитывает обслуживаемое соединение в своей загрузке
+ */
+typedef std::shared_ptr<QThread> WorkerLease;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMQtWorkerPool class - Класс, описывающий пул рабочих потоков Qt с собственными циклами событий
+ * Соединения распределяются на наименее загруженный поток.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMQtWorkerPool : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMQtWorkerPool - Инициализирующий конструктор
+     * @param inWorkers - Количество рабочих потоков (0 - по количеству ядер)
+     */
+    HMQtWorkerPool(const std::size_t inWorkers);
+
+    /**
+     * @brief ~HMQtWorkerPool - Виртуальный деструктор (завершает циклы событий потоков)
+     */
+    virtual ~HMQtWorkerPool() override;
+
+    /**
+     * @brief acquire - Метод выберет наименее загруженный поток
+     * @return Вернёт аренду рабочего потока
+     */
+    WorkerLease acquire();
+
+    /**
+     * @brief size - Метод вернёт количество рабочих потоков
+     * @return Вернёт количество рабочих потоков
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief load - Метод вернёт количество соединений, обслуживаемых потоком
+     * @param inIndex - Индекс рабочего потока
+     * @return Вернёт количество соединений
+     */
+    std::size_t load(const std::size_t inIndex) const;
+
+    /**
+     * @brief idealWorkersCount - Метод вернёт количество рабочих потоков, занимающее все ядра
+     * @return Вернёт количество рабочих потоков (не меньше одного)
+     */
+    static std::size_t idealWorkersCount();
+
+private:
+
+    /**
+     * @brief The Worker struct - Структура, описывающая рабочий поток
+     */
+    struct Worker
+    {
+        std::unique_ptr<QThread> m_thread = nullptr;            ///< Поток с циклом событий
+        std::shared_ptr<std::atomic_size_t> m_load = nullptr;   ///< Количество арендованных соединений (переживает пул)
+    };
+
+    std::vector<Worker> m_workers;  ///< Рабочие потоки
+
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMQTWORKERPOOL_H
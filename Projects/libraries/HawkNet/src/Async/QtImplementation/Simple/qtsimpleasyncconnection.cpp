@@ -37,6 +37,7 @@ errors::error_code HMQtSimpleAsyncConnection::connectionSigSlotConnect()
         Error = make_error_code(errors::eNetError::neSocketNotInit);
     else
     {
+        QObject::connect(CurrentSocket.get(), &QTcpSocket::connected, this, &HMQtSimpleAsyncConnection::slot_onConnected); // Линкуем событие "Соединение установлено"
         QObject::connect(CurrentSocket.get(), &QTcpSocket::readyRead, this, &HMQtSimpleAsyncConnection::slot_onReadyRead); // Линкуем событие "К чтению готов"
         QObject::connect(CurrentSocket.get(), &QTcpSocket::bytesWritten, this, &HMQtSimpleAsyncConnection::slot_onBytesWritten); // Линкуем событие "Байт записано"
         QObject::connect(CurrentSocket.get(), &QTcpSocket::errorOccurred, this, &HMQtSimpleAsyncConnection::slot_onErrorOccurred); // Линкуем событие "Произошла ошибка"
@@ -7,8 +7,8 @@
 using namespace net;
 
 //-----------------------------------------------------------------------------
-HMQtSimpleAsyncServer::HMQtSimpleAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks) :
-    HMQtAbstractAsyncServer(inPort, inCallbacks)
+HMQtSimpleAsyncServer::HMQtSimpleAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inWorkers) :
+    HMQtAbstractAsyncServer(inPort, inCallbacks, inWorkers)
 {
 
 }
@@ -26,8 +26,11 @@ public:
 
     /**
      * @brief HMQtSimpleAsyncServer - Инициализирующий конструктор
+     * @param inPort - Прослушиваемый порт
+     * @param inCallbacks - Перечень калбеков
+     * @param inWorkers - Количество рабочих потоков, обслуживающих соединения (0 - соединения живут в потоке сервера)
      */
-    HMQtSimpleAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks);
+    HMQtSimpleAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inWorkers = 0);
 
     /**
      * @brief ~HMQtSimpleAsyncServer - Виртуальный деструктор по умолчанию
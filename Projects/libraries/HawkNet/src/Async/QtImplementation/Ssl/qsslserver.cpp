@@ -2,12 +2,15 @@
 
 #include <memory>
 
-#include <QSslSocket>
+#if defined(HAWKNET_SHARED_SSL_CONTEXT)
+#include <QtNetwork/private/qsslsocket_p.h>
+#endif
 
 //-----------------------------------------------------------------------------
 QSslServer::QSslServer(QSslConfiguration &inSslConfig, QObject *parent) :
     QTcpServer(parent),
-    m_sslConfig(inSslConfig)
+    m_sslConfig(inSslConfig),
+    m_sharedContext(std::make_shared<SharedContext>())
 {
 
 }
@@ -18,10 +21,32 @@ void QSslServer::incomingConnection(qintptr handle)
 
     if (NewSslSocket->setSocketDescriptor(handle)) {
         NewSslSocket->setSslConfiguration(m_sslConfig);
-        auto* s = NewSslSocket.release();
-        addPendingConnection(s); // Добавляем во внутренний список ожидающих подключений
-        //connect(NewSslSocket, &QSslSocket::encrypted, this, &QSslServer::ready);
-        s->startServerEncryption();
+        shareContext(NewSslSocket.get());
+        // Рукопожатие (подпись и обмен ключами) запустит соединение в своём потоке, не занимая поток приёма
+        addPendingConnection(NewSslSocket.release()); // Добавляем во внутренний список ожидающих подключений
     }
 }
 //-----------------------------------------------------------------------------
+void QSslServer::shareContext(QSslSocket* inSocket)
+{
+#if defined(HAWKNET_SHARED_SSL_CONTEXT)
+    std::shared_ptr<SharedContext> Shared = m_sharedContext;
+    std::lock_guard lg(Shared->m_defender);
+
+    if (Shared->m_context) // Сокет не станет заново загружать сертификат и получит общие ключи билетов сеансов
+        QSslSocketPrivate::checkSettingSslContext(inSocket, Shared->m_context);
+    else // Контекст создаётся при рукопожатии, поэтому его передаст остальным первый зашифрованный сокет
+    {
+        connect(inSocket, &QSslSocket::encrypted, inSocket, [inSocket, Shared]()
+        {
+            std::lock_guard lg(Shared->m_defender);
+
+            if (!Shared->m_context)
+                Shared->m_context = QSslSocketPrivate::sslContext(inSocket);
+        });
+    }
+#else
+    (void)inSocket; // Без закрытого API Qt каждый сокет создаёт собственный контекст, сеансы не возобновляются
+#endif
+}
+//-----------------------------------------------------------------------------
@@ -9,12 +9,21 @@
 // https://github.com/GuiTeK/Qt-SslServer
 // https://github.com/Skycoder42/QSslServer
 
+#include <mutex>
+#include <memory>
+
 #include <QTcpServer>
+#include <QSslSocket>
 #include <QSslConfiguration>
 
+class QSslContext; // Контекст TLS сокетов Qt (закрытый API Qt)
+
 //-----------------------------------------------------------------------------
 /**
  * @brief The QSslServer class - Класс, описывающий реализация SSL TCP сервера
+ * Рукопожатие принятых сокетов не начинается в потоке приёма: его запускает соединение в своём потоке.
+ * При сборке с закрытым API Qt (опция USE_QT_PRIVATE_NETWORK, определение HAWKNET_SHARED_SSL_CONTEXT) сокеты используют общий контекст TLS:
+ * ключи билетов и кэш сеансов общие, поэтому переподключившиеся клиенты возобновляют сеанс без полного рукопожатия.
  *
  * @authors Alekseev_s
  * @date 19.04.2021
@@ -46,7 +55,24 @@ protected:
 
 private:
 
+    /**
+     * @brief The SharedContext struct - Общий контекст TLS серверных сокетов
+     * Захватывается сокетами, поэтому переживает сервер: рукопожатия завершаются в рабочих потоках
+     */
+    struct SharedContext
+    {
+        std::mutex m_defender;                  ///< Мьютекс, защищающий контекст
+        std::shared_ptr<QSslContext> m_context; ///< Контекст первого сокета, завершившего рукопожатие
+    };
+
     QSslConfiguration m_sslConfig; ///< Конфигурации SSL
+    std::shared_ptr<SharedContext> m_sharedContext; ///< Общий контекст TLS
+
+    /**
+     * @brief shareContext - Метод передаст сокету общий контекст TLS (или захватит его с первого сокета)
+     * @param inSocket - Сокет нового входящего соединения
+     */
+    void shareContext(QSslSocket* inSocket);
 
 };
 //-----------------------------------------------------------------------------
@@ -4,6 +4,8 @@
 
 #include <neterrorcategory.h>
 
+#include "sslfuncs.h"
+
 using namespace net;
 
 //-----------------------------------------------------------------------------
@@ -21,6 +23,9 @@ HMQtSslAsyncConnection::HMQtSslAsyncConnection(std::unique_ptr<QTcpSocket>&& inS
     errors::error_code ConnectError = connectionSigSlotConnect(); // Линкуем сигналы\сокеты
     assert(!ConnectError); // Сигналы должны слинковаться успешно
     ConnectError.clear();
+
+    // Событие переносится в рабочий поток вместе с соединением: поток приёма не выполняет рукопожатие
+    QMetaObject::invokeMethod(this, [this]() { startServerEncryption(); }, Qt::QueuedConnection);
 }
 //-----------------------------------------------------------------------------
 HMQtSslAsyncConnection::~HMQtSslAsyncConnection()
@@ -28,35 +33,6 @@ HMQtSslAsyncConnection::~HMQtSslAsyncConnection()
     disconnect();
 }
 //-----------------------------------------------------------------------------
-errors::error_code HMQtSslAsyncConnection::connect(const std::chrono::milliseconds inWaitTime)
-{
-    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
-    QSslSocket* CurrentSocket = getSslSocket(); // Получаем указатель на текущий сокет
-
-    disconnect(); // Принудительный разрыв соединения
-
-    if (!CurrentSocket) // Сокет не инициализирован
-        Error = make_error_code(errors::eNetError::neSocketNotInit);
-    else // Если сокет успешно сформирован
-    {
-        if (!QSslSocket::supportsSsl()) // Проверяем поддержку SSL
-            Error = make_error_code(errors::eNetError::neNoSslSupport);
-        else
-        {   // Пытаемся подключиться
-            CurrentSocket->setPeerVerifyMode(QSslSocket::QueryPeer);
-
-            CurrentSocket->connectToHostEncrypted(QString::fromStdString(getHost()), static_cast<quint16>(getPort()),
-                                   QIODevice::ReadWrite, QAbstractSocket::AnyIPProtocol);
-
-            //if (!sslSocket()->waitForEncrypted(inWaitTime.count())) // По хорошему требуется, но блокирует поток в тестах...
-            if (!CurrentSocket->waitForConnected(inWaitTime.count()))
-                Error = make_error_code(errors::eNetError::neTimeOut);
-        }
-    }
-
-    return Error;
-}
-//-----------------------------------------------------------------------------
 errors::error_code HMQtSslAsyncConnection::convertingError(const QSslError &inQSslError)
 {
     errors::eNetError neErrorCode;
@@ -121,9 +97,57 @@ errors::error_code HMQtSslAsyncConnection::convertingError(const QSslError &inQS
     return make_error_code(neErrorCode);
 }
 //-----------------------------------------------------------------------------
+void HMQtSslAsyncConnection::write()
+{
+    const QSslSocket* CurrentSocket = getSslSocket();
+
+    if (CurrentSocket && CurrentSocket->mode() != QSslSocket::UnencryptedMode) // Отложенную запись продолжит startServerEncryption
+        HMQtAbstractAsyncConnection::write();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMQtSslAsyncConnection::beginConnect()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    QSslSocket* CurrentSocket = getSslSocket(); // Получаем указатель на текущий сокет
+
+    if (!CurrentSocket) // Сокет не инициализирован
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (!QSslSocket::supportsSsl()) // Проверяем поддержку SSL
+        Error = make_error_code(errors::eNetError::neNoSslSupport);
+    else
+    {   // Пытаемся подключиться
+        CurrentSocket->setPeerVerifyMode(QSslSocket::QueryPeer);
+
+        QSslConfiguration Config = CurrentSocket->sslConfiguration();
+        Config.setSslOption(QSsl::SslOptionDisableSessionPersistence, false); // Разрешаем сохранять и предъявлять билеты
+        Config.setSessionTicket(findSessionTicket(getHost(), getPort())); // Без билета выполнится полное рукопожатие
+        CurrentSocket->setSslConfiguration(Config);
+
+        CurrentSocket->connectToHostEncrypted(QString::fromStdString(getHost()), static_cast<quint16>(getPort()),
+                                              QIODevice::ReadWrite, QAbstractSocket::AnyIPProtocol);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
 void HMQtSslAsyncConnection::slot_onEncrypted()
 {
-    qInfo() << "An encrypted connection is established!";
+    storeSessionTicket(); // До TLS 1.3 билет известен по завершении рукопожатия
+    finishConnect(make_error_code(errors::eNetError::neSuccess)); // Подключение, начатое connectAsync, завершается рукопожатием
+}
+//-----------------------------------------------------------------------------
+void HMQtSslAsyncConnection::slot_onNewSessionTicketReceived()
+{
+    storeSessionTicket();
+}
+//-----------------------------------------------------------------------------
+void HMQtSslAsyncConnection::slot_onEncryptedReadyRead()
+{
+    const QSslSocket* CurrentSocket = getSslSocket();
+
+    // До начала рукопожатия приветствие клиента остаётся в буфере сокета: его прочтёт startServerEncryption
+    if (CurrentSocket && CurrentSocket->mode() != QSslSocket::UnencryptedMode)
+        slot_onReadyRead();
 }
 //-----------------------------------------------------------------------------
 void HMQtSslAsyncConnection::slot_onPeerVerifyError(const QSslError &inSslError)
@@ -144,7 +168,10 @@ void HMQtSslAsyncConnection::slot_onEncryptedBytesWritten(qint64 inBytesWritten)
 //-----------------------------------------------------------------------------
 void HMQtSslAsyncConnection::slot_onHandshakeInterruptedOnError(const QSslError &inSslError)
 {
-    onError(convertingError(inSslError)); // Отправляем ошибку на верхний уровень абстракции
+    const errors::error_code Error = convertingError(inSslError);
+
+    onError(Error); // Отправляем ошибку на верхний уровень абстракции
+    finishConnect(Error); // Подключение, начатое connectAsync, не состоялось
     disconnect(); // Нет рукопожатия, нет защищённого соединения
 }
 //-----------------------------------------------------------------------------
@@ -160,6 +187,30 @@ QSslSocket* HMQtSslAsyncConnection::getSslSocket()
     return dynamic_cast<QSslSocket*>(getSocket().get());
 }
 //-----------------------------------------------------------------------------
+void HMQtSslAsyncConnection::startServerEncryption()
+{
+    QSslSocket* CurrentSocket = getSslSocket();
+
+    if (CurrentSocket && CurrentSocket->state() == QAbstractSocket::ConnectedState && CurrentSocket->mode() == QSslSocket::UnencryptedMode)
+    {
+        CurrentSocket->startServerEncryption(); // Подпись и обмен ключами выполняются в потоке соединения
+        write(); // Данные, отправленные до начала рукопожатия, сокет зашифрует по его завершении
+    }
+}
+//-----------------------------------------------------------------------------
+void HMQtSslAsyncConnection::storeSessionTicket()
+{
+    QSslSocket* CurrentSocket = getSslSocket();
+
+    if (CurrentSocket && CurrentSocket->mode() == QSslSocket::SslClientMode)
+    {
+        const QByteArray Ticket = CurrentSocket->sslConfiguration().sessionTicket();
+
+        if (!Ticket.isEmpty())
+            net::storeSessionTicket(getHost(), getPort(), Ticket);
+    }
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMQtSslAsyncConnection::connectionSigSlotConnect()
 {
     errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
@@ -169,11 +220,12 @@ errors::error_code HMQtSslAsyncConnection::connectionSigSlotConnect()
         Error = make_error_code(errors::eNetError::neSocketNotInit);
     else
     {
-        QObject::connect(CurrentSocket, &QSslSocket::readyRead, this, &HMQtSslAsyncConnection::slot_onReadyRead); // Линкуем событие "К чтению готов"
+        QObject::connect(CurrentSocket, &QSslSocket::readyRead, this, &HMQtSslAsyncConnection::slot_onEncryptedReadyRead); // Линкуем событие "К чтению готов"
         QObject::connect(CurrentSocket, &QSslSocket::errorOccurred, this, &HMQtSslAsyncConnection::slot_onErrorOccurred); // Линкуем событие "Произошла ошибка"
         QObject::connect(CurrentSocket, &QSslSocket::disconnected, this, &HMQtSslAsyncConnection::slot_onDisconnected); // Линкуем событие "разрыв соеденения"
 
         QObject::connect(CurrentSocket, &QSslSocket::encrypted, this, &HMQtSslAsyncConnection::slot_onEncrypted); // Линкуем событие "Установлено защищённое соединение"
+        QObject::connect(CurrentSocket, &QSslSocket::newSessionTicketReceived, this, &HMQtSslAsyncConnection::slot_onNewSessionTicketReceived); // Линкуем событие "Получен билет сеанса"
         QObject::connect(CurrentSocket, &QSslSocket::peerVerifyError, this, &HMQtSslAsyncConnection::slot_onPeerVerifyError); // Линкуем событие "Ошибка идентификации надежно однорангового узла"
         QObject::connect(CurrentSocket, &QSslSocket::sslErrors, this, &HMQtSslAsyncConnection::slot_onSslErrors); // Линкуем событие "Ошибка SSL"
 
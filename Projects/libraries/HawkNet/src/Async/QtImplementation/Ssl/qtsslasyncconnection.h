@@ -16,6 +16,8 @@ namespace net
 //-----------------------------------------------------------------------------
 /**
  * @brief The HMQtSslAsyncConnection class - Абстракция, описывающая асинхронное TCP соединение, использующее SSL
+ * Серверное соединение начинает рукопожатие в своём потоке (рабочем, если сервер их использует).
+ * Клиентское соединение сохраняет билет сеанса и предъявляет его при следующем подключении к тому же серверу.
  *
  * @authors Alekseev_s
  * @date 19.04.2021
@@ -45,13 +47,6 @@ public:
      */
     virtual ~HMQtSslAsyncConnection() override;
 
-    /**
-     * @brief connect - Метод произведёт подключение
-     * @param inWaitTime - Время ожидания подключения
-     * @return  Вернёт признак ошибки
-     */
-    virtual errors::error_code connect(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
-
     /**
      * @brief convertingError - Метод преобразует ошибку QSslError в стандартную
      * @param inQSslError - Признак ошибки QSslError
@@ -59,6 +54,21 @@ public:
      */
     static errors::error_code convertingError(const QSslError& inQSslError);
 
+protected:
+
+    /**
+     * @brief write - Отправка подготовленной пачки данных
+     * До начала рукопожатия серверный сокет передал бы данные открытым текстом, поэтому запись откладывается
+     */
+    virtual void write() override;
+
+    /**
+     * @brief beginConnect - Метод начнёт защищённое подключение с предъявлением сохранённого билета сеанса
+     * Подключение, начатое connectAsync, завершается вместе с рукопожатием.
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginConnect() override;
+
 private slots:
 
     /**
@@ -66,6 +76,16 @@ private slots:
      */
     void slot_onEncrypted();
 
+    /**
+     * @brief slot_onNewSessionTicketReceived - Слот, сохраняющий билет сеанса, выданный сервером после рукопожатия (TLS 1.3)
+     */
+    void slot_onNewSessionTicketReceived();
+
+    /**
+     * @brief slot_onEncryptedReadyRead - Слот, выполняющий чтение расшифрованных данных
+     */
+    void slot_onEncryptedReadyRead();
+
     /**
      * @brief slot_onPeerVerifyError - Слот, обрабатывающий ошибку идентификации надежно однорангового узла.
      * @param inSslError - Признак ошибки QSslError
@@ -104,6 +124,16 @@ private:
      */
     QSslSocket* getSslSocket();
 
+    /**
+     * @brief startServerEncryption - Метод начнёт рукопожатие серверного сокета в потоке соединения
+     */
+    void startServerEncryption();
+
+    /**
+     * @brief storeSessionTicket - Метод сохранит билет сеанса клиентского сокета
+     */
+    void storeSessionTicket();
+
 };
 //-----------------------------------------------------------------------------
 }
@@ -8,8 +8,8 @@
 using namespace net;
 
 //-----------------------------------------------------------------------------
-HMQtSslAsyncServer::HMQtSslAsyncServer(const std::uint16_t inPort, const CertificatePaths& inCerPaths, const ServCallbacks& inCallbacks) :
-    HMQtAbstractAsyncServer(inPort, inCallbacks),
+HMQtSslAsyncServer::HMQtSslAsyncServer(const std::uint16_t inPort, const CertificatePaths& inCerPaths, const ServCallbacks& inCallbacks, const std::size_t inWorkers) :
+    HMQtAbstractAsyncServer(inPort, inCallbacks, inWorkers),
     m_certificatePaths(inCerPaths)
 {
 
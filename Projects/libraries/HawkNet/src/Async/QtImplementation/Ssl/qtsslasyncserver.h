@@ -39,8 +39,12 @@ public:
 
     /**
      * @brief HMQtSslAsyncServer - Инициализирующий конструктор
+     * @param inPort - Прослушиваемый порт
+     * @param inCerPaths - Пути к файлам сертификата
+     * @param inCallbacks - Перечень калбеков
+     * @param inWorkers - Количество рабочих потоков, обслуживающих соединения (0 - соединения и их рукопожатия выполняются в потоке сервера)
      */
-    HMQtSslAsyncServer(const std::uint16_t inPort, const CertificatePaths& inCerPaths, const ServCallbacks& inCallbacks);
+    HMQtSslAsyncServer(const std::uint16_t inPort, const CertificatePaths& inCerPaths, const ServCallbacks& inCallbacks, const std::size_t inWorkers = 0);
 
     /**
      * @brief ~HMQtSslAsyncServer - Виртуальный деструктор по умолчанию
@@ -1,5 +1,8 @@
 #include "sslfuncs.h"
 
+#include <map>
+#include <mutex>
+
 #include <QFile>
 
 #include <systemerrorex.h>
@@ -93,10 +96,65 @@ QSslConfiguration makeSslConfiguration(const std::filesystem::path& inCertificat
             Result.addCaCertificate(Certificate);
             Result.setLocalCertificate(Certificate);
             Result.setPrivateKey(PrivateKeys);
+            Result.setSslOption(QSsl::SslOptionDisableSessionTickets, false); // Сервер выдаёт билеты для возобновления сеансов
         }
     }
 
     return Result;
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief The SessionTickets struct - Билеты сеансов TLS, сохранённые клиентскими соединениями процесса
+ */
+struct SessionTickets
+{
+    std::mutex m_defender;                          ///< Мьютекс, защищающий билеты
+    std::map<std::string, QByteArray> m_tickets;    ///< Билеты по адресу "хост:порт"
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief sessionTickets - Функция вернёт хранилище билетов сеансов процесса
+ * @return Вернёт хранилище билетов сеансов
+ */
+static SessionTickets& sessionTickets()
+{
+    static SessionTickets Result;
+    return Result;
+}
+//-----------------------------------------------------------------------------
+QByteArray findSessionTicket(const std::string& inHost, const std::uint16_t inPort)
+{
+    QByteArray Result;
+    SessionTickets& Tickets = sessionTickets();
+
+    std::lock_guard lg(Tickets.m_defender);
+    auto It = Tickets.m_tickets.find(inHost + ":" + std::to_string(inPort));
+
+    if (It != Tickets.m_tickets.end())
+        Result = It->second;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void storeSessionTicket(const std::string& inHost, const std::uint16_t inPort, const QByteArray& inTicket)
+{
+    SessionTickets& Tickets = sessionTickets();
+    const std::string Key = inHost + ":" + std::to_string(inPort);
+
+    std::lock_guard lg(Tickets.m_defender);
+
+    if (inTicket.isEmpty())
+        Tickets.m_tickets.erase(Key);
+    else
+        Tickets.m_tickets[Key] = inTicket;
+}
+//-----------------------------------------------------------------------------
+void clearSessionTickets()
+{
+    SessionTickets& Tickets = sessionTickets();
+
+    std::lock_guard lg(Tickets.m_defender);
+    Tickets.m_tickets.clear();
+}
+//-----------------------------------------------------------------------------
 } // namespace net
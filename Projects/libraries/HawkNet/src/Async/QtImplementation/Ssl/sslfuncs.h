@@ -10,6 +10,9 @@
 #include <QSslCertificate>
 #include <QSslConfiguration>
 
+#include <string>
+#include <cstdint>
+
 #include <errorcode.h>
 
 // filesystem подключаем после Qt иначе возникнет конфликт (официальный баг)
@@ -43,6 +46,28 @@ QSslKey readPrivateKey(const std::filesystem::path& inPrivateKeyPath, errors::er
  */
 QSslConfiguration makeSslConfiguration(const std::filesystem::path& inCertificatePath, const std::filesystem::path& inPrivateKeyPath, errors::error_code& outError);
 //-----------------------------------------------------------------------------
+/**
+ * @brief findSessionTicket - Функция вернёт сохранённый билет сеанса TLS сервера
+ * Билеты общие для всех клиентских соединений процесса: переподключение возобновит сеанс без полного рукопожатия
+ * @param inHost - Адрес хоста
+ * @param inPort - Порт хоста
+ * @return Вернёт билет сеанса (пустой, если билет не сохранён)
+ */
+QByteArray findSessionTicket(const std::string& inHost, const std::uint16_t inPort);
+//-----------------------------------------------------------------------------
+/**
+ * @brief storeSessionTicket - Функция сохранит билет сеанса TLS сервера
+ * @param inHost - Адрес хоста
+ * @param inPort - Порт хоста
+ * @param inTicket - Билет сеанса (пустой билет удалит сохранённый)
+ */
+void storeSessionTicket(const std::string& inHost, const std::uint16_t inPort, const QByteArray& inTicket);
+//-----------------------------------------------------------------------------
+/**
+ * @brief clearSessionTickets - Функция удалит все сохранённые билеты сеансов (следующие подключения выполнят полное рукопожатие)
+ */
+void clearSessionTickets();
+//-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 } // namespace net
@@ -0,0 +1,453 @@
+#include "uringasyncconnection.h"
+
+#include <cerrno>
+#include <cstring>
+#include <cassert>
+
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <neterrorcategory.h>
+
+#include "netutils.h"
+#include "Async/Posix/posixsocket.h"
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMUringAsyncConnection::HMUringAsyncConnection(const std::string& inHost, const uint16_t inPort, const ConCallbacks& inCallbacks) :
+    HMAbstractAsyncConnection(inCallbacks),
+    HMUringHandler(),
+    m_host(inHost),
+    m_port(inPort),
+    m_ownLoop(std::make_unique<HMUringLoop>())
+{
+    m_loop = m_ownLoop.get();
+    std::atomic_init(&m_status, eConnectionStatus::csDisconnected);
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+    m_connectTimer.setCallback([this]() { finishConnect(make_error_code(errors::eNetError::neTimeOut)); });
+}
+//-----------------------------------------------------------------------------
+HMUringAsyncConnection::HMUringAsyncConnection(const int inFd, HMUringLoop& inLoop, const ConCallbacks& inCallbacks) :
+    HMAbstractAsyncConnection(inCallbacks),
+    HMUringHandler(),
+    m_host(peerHost(inFd)),
+    m_port(localPort(inFd)),
+    m_loop(&inLoop),
+    m_fd(inFd)
+{
+    assert(m_fd >= 0); // Сокет должен быть валидным
+    std::atomic_init(&m_status, eConnectionStatus::csConnected);
+    m_deadlineTimer.setCallback([this]() { armTimers(); });
+}
+//-----------------------------------------------------------------------------
+HMUringAsyncConnection::~HMUringAsyncConnection()
+{
+    disconnect(); // Соединение снимается с цикла до освобождения памяти обработчика
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringAsyncConnection::connect(const std::chrono::milliseconds inWaitTime)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int NewFd = -1;
+
+    disconnect(); // Принудительный разрыв соединения
+
+    if (!m_ownLoop) // Серверное соединение не переподключается
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (!m_ownLoop->isRunning()) // Цикл клиента запускается при первом подключении
+        Error = m_ownLoop->start();
+
+    if (!Error)
+    {
+        m_status = eConnectionStatus::csConnecting;
+        NewFd = connectSocket(m_host, m_port, inWaitTime, Error);
+    }
+
+    if (!Error) // Сокет подключён, передаём его циклу
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = NewFd;
+        }
+
+        m_loop->invoke([this, &Error]() { Error = attach(); });
+    }
+
+    if (Error) // Подключение не состоялось
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = -1;
+        }
+
+        if (NewFd >= 0)
+            ::close(NewFd);
+
+        m_status = eConnectionStatus::csDisconnected;
+    }
+    else
+        Error = announceFraming(); // Согласуем режим кадрирования с сервером
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringAsyncConnection::connectAsync(const std::chrono::milliseconds inWaitTime)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    int NewFd = -1;
+
+    disconnect(); // Принудительный разрыв соединения
+
+    if (!m_ownLoop) // Серверное соединение не переподключается
+        Error = make_error_code(errors::eNetError::neSocketNotInit);
+    else if (!m_ownLoop->isRunning()) // Цикл клиента запускается при первом подключении
+        Error = m_ownLoop->start();
+
+    if (!Error)
+    {
+        m_status = eConnectionStatus::csConnecting;
+        NewFd = startConnect(m_host, m_port, Error);
+    }
+
+    if (!Error) // Подключение идёт, его завершение ядро сообщит готовностью сокета к записи
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = NewFd;
+        }
+
+        m_loop->invoke([this, &Error, inWaitTime]()
+        {
+            std::unique_ptr<UringOperation> Connect = std::make_unique<UringOperation>();
+            Connect->m_type = eUringOperation::uoConnect;
+            Connect->m_fd = m_fd;
+
+            {
+                std::lock_guard lg(m_writeDefender);
+                m_owner = m_loop->attach(this);
+                Connect->m_owner = m_owner;
+            }
+
+            Error = m_loop->submit(std::move(Connect));
+
+            if (Error)
+            {
+                m_loop->detach(m_owner);
+                std::lock_guard lg(m_writeDefender);
+                m_owner = 0;
+            }
+            else
+                m_loop->timers().schedule(m_connectTimer, std::chrono::steady_clock::now() + inWaitTime);
+        });
+    }
+
+    if (Error) // Подключение не началось
+    {
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_fd = -1;
+        }
+
+        if (NewFd >= 0)
+            ::close(NewFd);
+
+        m_status = eConnectionStatus::csDisconnected;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::disconnect()
+{
+    if (m_status != eConnectionStatus::csDisconnected) // Закрытое соединение уже снято с цикла
+        m_loop->invoke([this]() { closeSocket(make_error_code(errors::eNetError::neSuccess)); });
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::disconnectLater(const errors::error_code inReason)
+{
+    if (m_status != eConnectionStatus::csDisconnected) // Деструктор снимает соединение через invoke, поэтому задача выполнится раньше
+        m_loop->post([this, inReason]() { closeSocket(inReason); });
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::armTimers()
+{
+    if (!m_loop->inLoopThread())
+    {
+        if (m_status != eConnectionStatus::csDisconnected) // Как и у disconnectLater, задача выполнится раньше разрушения
+            m_loop->post([this]() { armTimers(); });
+    }
+    else
+    {
+        const std::chrono::steady_clock::time_point Next = (m_fd >= 0) ? checkTimers(std::chrono::steady_clock::now()) :
+                                                                         std::chrono::steady_clock::time_point::max();
+
+        if (Next == std::chrono::steady_clock::time_point::max())
+            m_deadlineTimer.cancel();
+        else
+            m_loop->timers().schedule(m_deadlineTimer, Next);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::retire(std::shared_ptr<HMAbstractConnection>&& inSelf)
+{
+    std::shared_ptr<HMAbstractConnection> Self = std::move(inSelf);
+
+    // Задача выполнится после текущей пачки событий, поэтому соединение не удаляется из своего же обработчика
+    if (!m_loop->post([this, Self]() { closeSocket(make_error_code(errors::eNetError::neSuccess)); }))
+        disconnect(); // Цикл остановлен: закрываем сразу, ссылка освободится при выходе
+}
+//-----------------------------------------------------------------------------
+eConnectionStatus HMUringAsyncConnection::status() const
+{
+    return m_status;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringAsyncConnection::attach()
+{
+    std::unique_ptr<UringOperation> Receive = std::make_unique<UringOperation>();
+    Receive->m_type = eUringOperation::uoRecv;
+    Receive->m_fd = m_fd;
+
+    {
+        std::lock_guard lg(m_writeDefender);
+        m_owner = m_loop->attach(this);
+        Receive->m_owner = m_owner;
+    }
+
+    errors::error_code Error = m_loop->submit(std::move(Receive)); // Одна операция читает сокет до его закрытия
+
+    if (Error)
+    {
+        m_loop->detach(m_owner);
+        std::lock_guard lg(m_writeDefender);
+        m_owner = 0;
+    }
+    else
+    {
+        m_status = eConnectionStatus::csConnected;
+        armTimers(); // Отсчёт простоя начинается с установки соединения
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::string HMUringAsyncConnection::getHost() const
+{
+    return m_host;
+}
+//-----------------------------------------------------------------------------
+uint16_t HMUringAsyncConnection::getPort() const
+{
+    return m_port;
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::afterWrite()
+{
+    bool Continue = true;
+
+    while (Continue) // Пока пачки отбрасываются закрытым сокетом, досушиваем очередь циклом, а не рекурсией через write()
+    {
+        HMAbstractAsyncConnection::afterWrite();
+
+        std::lock_guard lg(m_writeDefender);
+        Continue = m_batchSentBy == std::this_thread::get_id();
+        m_batchSentBy = std::thread::id();
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::prepateNextData(OutFrame&& inFrame)
+{
+    // Данные сообщения (собственные, разделяемые или сжатые) копируются только в буфер записи
+    std::uint8_t Flags = 0;
+    const FrameView Payload = encodePayload(inFrame, Flags);
+
+    std::lock_guard lg(m_writeDefender);
+
+    if (inFrame.m_mode == eFramingMode::fmLengthPrefixed) // Заголовок добавляется перед полезной нагрузкой, без экранирования
+    {
+        char Header[C_FRAME_HEADER_SIZE];
+        encodeFrameHeader(static_cast<std::uint32_t>(Payload.size()), Flags, Header);
+        m_writeBuffer.append(Header, C_FRAME_HEADER_SIZE);
+    }
+
+    m_writeBuffer.append(Payload); // Дописываем сообщение к пачке
+
+    // Собственным данным разделитель добавлен при постановке в очередь, разделяемые изменять нельзя
+    if (inFrame.m_shared && inFrame.m_mode != eFramingMode::fmLengthPrefixed && (Payload.empty() || Payload.back() != C_DATA_SEPARATOR))
+        m_writeBuffer.push_back(C_DATA_SEPARATOR);
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::write()
+{
+    std::unique_ptr<UringOperation> Send = std::make_unique<UringOperation>();
+    Send->m_type = eUringOperation::uoSend;
+
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        Send->m_fd = m_fd;
+        Send->m_owner = m_owner;
+        Send->m_data.swap(m_writeBuffer); // Память пачки переходит операции: ядро читает её до завершения отправки
+    }
+
+    // Операцию закрытого соединения цикл отбросит, поэтому очередь досушивает этот же поток
+    if (Send->m_owner == 0 || !m_loop->postOperation(std::move(Send)))
+    {
+        std::lock_guard lg(m_writeDefender);
+        m_batchSentBy = std::this_thread::get_id();
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMUringAsyncConnection::onCompletion(UringOperation& inOperation, const io_uring_cqe& inCqe)
+{
+    bool Result = false;
+
+    if (inOperation.m_type == eUringOperation::uoRecv)
+        Result = onReceive(inOperation, inCqe);
+    else if (inOperation.m_type == eUringOperation::uoSend)
+        Result = onSent(inOperation, inCqe);
+    else if (inOperation.m_type == eUringOperation::uoConnect)
+        finishConnect((inCqe.res < 0) ? convertingSocketError(-inCqe.res) : connectResult(m_fd));
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMUringAsyncConnection::onReceive(UringOperation& inOperation, const io_uring_cqe& inCqe)
+{
+    bool Result = false;
+
+    if (inCqe.flags & IORING_CQE_F_BUFFER) // Переносим данные в буфер приёма и сразу возвращаем буфер ядру
+    {
+        if (inCqe.res > 0)
+        {
+            const std::size_t Received = static_cast<std::size_t>(inCqe.res);
+            std::memcpy(m_readBuffer.prepare(Received), m_loop->buffer(inCqe), Received);
+            m_readBuffer.commit(Received);
+        }
+
+        m_loop->recycle(inCqe);
+    }
+
+    if (inCqe.res > 0)
+    {
+        markActivity();
+        readFrames(); // Обработчик может закрыть соединение
+    }
+
+    if (m_fd < 0) // Соединение закрыто обработчиком
+        Result = false;
+    else if (inCqe.res == 0) // Партнёр закрыл соединение штатно
+        closeSocket(make_error_code(errors::eNetError::neSuccess));
+    else if (inCqe.res < 0 && inCqe.res != -ENOBUFS) // ENOBUFS - ядру временно не хватило буферов, чтение просто продолжается
+        closeSocket(convertingSocketError(-inCqe.res));
+    else if (!(inCqe.flags & IORING_CQE_F_MORE)) // Многократное чтение прервано ядром, ставим заново
+    {
+        Result = !m_loop->resubmit(inOperation);
+
+        if (!Result)
+            closeSocket(make_error_code(errors::eNetError::neSocketResourceError));
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+bool HMUringAsyncConnection::onSent(UringOperation& inOperation, const io_uring_cqe& inCqe)
+{
+    bool Result = false;
+
+    if (inCqe.res > 0)
+    {
+        inOperation.m_offset += static_cast<std::size_t>(inCqe.res);
+
+        if (inOperation.m_offset < inOperation.m_data.size() && m_fd >= 0) // Сокет принял не всё, дописываем остаток
+            Result = !m_loop->resubmit(inOperation);
+    }
+
+    // Ошибку отправки (разрыв) обнаружит чтение, данные пачки при этом отбрасываются
+    if (!Result) // Пачка завершена, цикл продолжает запись очереди
+        afterWrite();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::readFrames()
+{
+    FrameInfo Frame; // Описание очередного кадра
+    errors::error_code Error;
+
+    // Обработчик может разорвать соединение и очистить буфер, поэтому его размер проверяется на каждой итерации
+    while (!m_readBuffer.empty() && nextFrame(m_readBuffer.data(), m_readBuffer.size(), Frame, Error)) // Пока в буфере есть полные кадры
+    {
+        onReadFrame(Frame, FrameView(m_readBuffer.data() + Frame.m_offset, Frame.m_length)); // Передаём кадр без копирования
+        m_readBuffer.consume(Frame.m_size); // Отбрасываем обработанный кадр сдвигом смещения
+    }
+
+    if (Error) // Поток повреждён, восстановить границы кадров невозможно
+    {
+        m_readBuffer.clear();
+        onError(Error);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::finishConnect(const errors::error_code inError)
+{
+    errors::error_code Error = inError;
+    m_connectTimer.cancel();
+
+    if (m_fd < 0 || m_status != eConnectionStatus::csConnecting) // Подключение уже завершено или прервано
+        return;
+
+    if (!Error) // Метка ожидания подключения снимается, чтение регистрируется под новой
+    {
+        m_loop->detach(m_owner);
+
+        {
+            std::lock_guard lg(m_writeDefender);
+            m_owner = 0;
+        }
+
+        Error = attach();
+    }
+
+    if (Error)
+        closeSocket(Error);
+    else
+        onConnected(announceFraming()); // Согласуем режим кадрирования с сервером
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncConnection::closeSocket(const errors::error_code inError)
+{
+    if (m_fd < 0) // Сокет уже закрыт
+        return;
+
+    const bool WasConnecting = m_status == eConnectionStatus::csConnecting; // Соединение ещё не было установлено
+
+    m_loop->detach(m_owner); // Оставшиеся завершения операций соединения цикл отбросит сам
+
+    {
+        std::lock_guard lg(m_writeDefender); // Дожидаемся записи, идущей из чужого потока
+        ::shutdown(m_fd, SHUT_RDWR); // Незавершённые операции держат сокет открытым, поэтому разрыв сообщаем партнёру явно
+        ::close(m_fd);
+        m_fd = -1;
+        m_owner = 0;
+        m_writeBuffer.clear();
+    }
+
+    m_readBuffer.clear();
+    m_deadlineTimer.cancel();
+    m_connectTimer.cancel();
+    m_status = eConnectionStatus::csDisconnected;
+    HMAbstractAsyncConnection::disconnect(); // Очищаем очередь отправки
+
+    if (WasConnecting) // Неустановленное соединение сообщает о неудавшемся подключении, а не о разрыве
+        onConnected((inError) ? inError : make_error_code(errors::eNetError::neNotConnected));
+    else
+    {
+        if (inError)
+            onError(inError);
+
+        onDisconnect(); // Как и у реализаций Qt, разрыв с любой стороны оповещает обработчик
+    }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+#ifndef HMURINGASYNCCONNECTION_H
+#define HMURINGASYNCCONNECTION_H
+
+/**
+ * @file uringasyncconnection.h
+ * @brief Содержит описание асинхронного соединения на io_uring
+ */
+
+#include <mutex>
+#include <memory>
+#include <string>
+
+#include "Buffers/receivebuffer.h"
+#include "Async/Abstract/abstractasyncconnection.h"
+#include "uringloop.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMUringAsyncConnection class - Класс, описывающий асинхронное TCP соединение на io_uring
+ * Чтение выполняется одной многократной операцией с буферами, выбираемыми ядром,
+ * отправка - операциями, которые цикл передаёт ядру пачкой. Калбеки вызываются в потоке цикла.
+ * Клиентское соединение владеет собственным циклом, серверное - использует цикл принявшего его сервера.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMUringAsyncConnection : public HMAbstractAsyncConnection, public HMUringHandler
+{
+public:
+
+    /**
+     * @brief HMUringAsyncConnection - Инициализирующий конструктор (Сторона клиента)
+     * @param inHost - Адрес хоста
+     * @param inPort - Рабочий порт хоста
+     * @param inCallbacks - Перечень калбеков
+     */
+    HMUringAsyncConnection(const std::string& inHost, const uint16_t inPort, const ConCallbacks& inCallbacks);
+
+    /**
+     * @brief HMUringAsyncConnection - Инициализирующий конструктор (Сторона сервера)
+     * @param inFd - Дескриптор принятого сокета
+     * @param inLoop - Цикл, обслуживающий сокет
+     * @param inCallbacks - Перечень калбеков
+     */
+    HMUringAsyncConnection(const int inFd, HMUringLoop& inLoop, const ConCallbacks& inCallbacks);
+
+    /**
+     * @brief ~HMUringAsyncConnection - Виртуальный деструктор
+     */
+    virtual ~HMUringAsyncConnection() override;
+
+    /**
+     * @brief connect - Метод произведёт подключение
+     * @param inWaitTime - Время ожидания подключения
+     * @return  Вернёт признак ошибки
+     */
+    virtual errors::error_code connect(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
+
+    /**
+     * @brief connectAsync - Метод начнёт подключение, не дожидаясь его завершения
+     * Завершение подключения сокета цикл ожидает операцией опроса его готовности к записи.
+     * @param inWaitTime - Время ожидания подключения
+     * @return Вернёт признак ошибки начала подключения
+     */
+    virtual errors::error_code connectAsync(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) override;
+
+    /**
+     * @brief disconnect - Метод разорвёт соединение (сокет закрывается в потоке цикла)
+     */
+    virtual void disconnect() override;
+
+    /**
+     * @brief retire - Метод передаст циклу закрытие сокета вместе с последней ссылкой на соединение
+     * @param inSelf - Последняя ссылка на это соединение
+     */
+    virtual void retire(std::shared_ptr<HMAbstractConnection>&& inSelf) override;
+
+    /**
+     * @brief status - Метод вернёт текущий статус соединения
+     * @return Вернёт текущий статус соединения
+     */
+    virtual eConnectionStatus status() const override;
+
+    /**
+     * @brief attach - Метод зарегистрирует соединение в цикле и начнёт чтение (только поток цикла)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code attach();
+
+    /**
+     * @brief getHost - Метод вернёт адрес хоста
+     * @return Вернёт адрес хоста
+     */
+    std::string getHost() const;
+
+    /**
+     * @brief getPort - Метод вернёт рабочй порт
+     * @return Вернёт рабочй порт
+     */
+    uint16_t getPort() const;
+
+protected:
+
+    /**
+     * @brief afterWrite - Метод продолжит запись циклом, пока пачки отбрасываются закрытым сокетом
+     */
+    virtual void afterWrite() override;
+
+    /**
+     * @brief prepateNextData - Метод добавит сообщение к подготавливаемой записи
+     * @param inFrame - Сообщение, подготовленное к отправке
+     */
+    virtual void prepateNextData(OutFrame&& inFrame) override;
+
+    /**
+     * @brief write - Отправка подготовленной пачки данных
+     * Пачка передаётся циклу операцией отправки, по её завершению цикл продолжает запись.
+     */
+    virtual void write() override;
+
+    /**
+     * @brief disconnectLater - Метод передаст закрытие сокета циклу, не дожидаясь его выполнения
+     * @param inReason - Причина разрыва (передаётся обработчику ошибок)
+     */
+    virtual void disconnectLater(const errors::error_code inReason) override;
+
+    /**
+     * @brief armTimers - Метод переставит таймер сроков соединения на колесе цикла (вызов из чужого потока передаётся циклу)
+     */
+    virtual void armTimers() override;
+
+    /**
+     * @brief onCompletion - Метод обработает завершение операции соединения (поток цикла)
+     * @param inOperation - Операция
+     * @param inCqe - Запись очереди завершений
+     * @return Вернёт true, если операция передана ядру повторно
+     */
+    virtual bool onCompletion(UringOperation& inOperation, const io_uring_cqe& inCqe) override;
+
+private:
+
+    std::string m_host = "";                            ///< Адрес хоста
+    uint16_t m_port = 0;                                ///< Рабочий порт
+
+    std::unique_ptr<HMUringLoop> m_ownLoop = nullptr;   ///< Собственный цикл клиентского соединения
+    HMUringLoop* m_loop = nullptr;                      ///< Цикл, обслуживающий сокет
+    std::atomic<eConnectionStatus> m_status;            ///< Текущий статус соединения
+
+    std::mutex m_writeDefender;         ///< Мьютекс, защищающий дескриптор и буфер отправки от закрытия во время записи
+    int m_fd = -1;                      ///< Дескриптор сокета
+    std::uint64_t m_owner = 0;          ///< Метка соединения в цикле (0 - не зарегистрировано)
+    std::string m_writeBuffer;          ///< Буфер, в котором собирается пачка на отправку
+    std::thread::id m_batchSentBy;      ///< Поток, чья пачка отброшена закрытым сокетом (он и продолжает досушивать очередь)
+
+    HMReceiveBuffer m_readBuffer;       ///< Буфер, в который происходит чтение (только поток цикла)
+    HMWheelTimer m_deadlineTimer;      ///< Таймер сроков (проверки связи и запросов) на колесе цикла (только поток цикла)
+    HMWheelTimer m_connectTimer;       ///< Таймер ожидания подключения, начатого connectAsync (только поток цикла)
+
+    /**
+     * @brief onReceive - Метод обработает завершение многократного чтения (поток цикла)
+     * @param inOperation - Операция чтения
+     * @param inCqe - Запись очереди завершений
+     * @return Вернёт true, если операция передана ядру повторно
+     */
+    bool onReceive(UringOperation& inOperation, const io_uring_cqe& inCqe);
+
+    /**
+     * @brief onSent - Метод обработает завершение отправки (поток цикла)
+     * @param inOperation - Операция отправки
+     * @param inCqe - Запись очереди завершений
+     * @return Вернёт true, если остаток данных передан ядру повторно
+     */
+    bool onSent(UringOperation& inOperation, const io_uring_cqe& inCqe);
+
+    /**
+     * @brief readFrames - Метод передаст обработчику все полные кадры буфера приёма (поток цикла)
+     */
+    void readFrames();
+
+    /**
+     * @brief finishConnect - Метод завершит подключение, начатое connectAsync, и оповестит обработчик (поток цикла)
+     * @param inError - Исход подключения
+     */
+    void finishConnect(const errors::error_code inError);
+
+    /**
+     * @brief closeSocket - Метод закроет сокет и оповестит обработчиков (поток цикла)
+     * Подключение, начатое connectAsync и прерванное закрытием, сообщается обработчику подключения, а не разрыва.
+     * @param inError - Причина закрытия (ошибка передаётся обработчику, если задана)
+     */
+    void closeSocket(const errors::error_code inError);
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMURINGASYNCCONNECTION_H
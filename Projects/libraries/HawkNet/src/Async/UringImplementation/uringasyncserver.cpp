@@ -0,0 +1,157 @@
+#include "uringasyncserver.h"
+
+#include <cerrno>
+#include <thread>
+#include <algorithm>
+
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <neterrorcategory.h>
+
+#include "uringasyncconnection.h"
+#include "Async/Posix/posixsocket.h"
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+// Acceptor
+//-----------------------------------------------------------------------------
+HMUringAsyncServer::Acceptor::Acceptor(HMUringAsyncServer& inServer, const int inFd) :
+    HMUringHandler(),
+    m_server(inServer),
+    m_fd(inFd),
+    m_loop(std::make_unique<HMUringLoop>())
+{
+
+}
+//-----------------------------------------------------------------------------
+HMUringAsyncServer::Acceptor::~Acceptor()
+{
+    m_loop->stop(); // Сначала останавливаем цикл: он отменит операцию приёма, державшую сокет
+    ::close(m_fd);
+}
+//-----------------------------------------------------------------------------
+bool HMUringAsyncServer::Acceptor::onCompletion(UringOperation& inOperation, const io_uring_cqe& inCqe)
+{
+    bool Result = false;
+
+    if (inCqe.res >= 0 && !m_server.admitConnection()) // Подключение сверх предела частоты закрываем, не создавая соединения
+        ::close(inCqe.res);
+    else if (inCqe.res >= 0) // Принято новое подключение
+    {
+        auto NewConnection = std::make_unique<HMUringAsyncConnection>(inCqe.res, *m_loop, m_server.m_Callbacks.m_conCalbacks);
+        errors::error_code Error = NewConnection->attach(); // Соединение обслуживается циклом, принявшим его
+
+        if (!Error)
+            m_server.onNewConnection(std::move(NewConnection)); // Отправляем его на регистрацию
+        else if (m_server.m_Callbacks.m_ErrorCallBack)
+            m_server.m_Callbacks.m_ErrorCallBack(Error);
+    }
+    else if (inCqe.res != -ECONNABORTED && m_server.m_Callbacks.m_ErrorCallBack) // Например, исчерпаны дескрипторы
+        m_server.m_Callbacks.m_ErrorCallBack(convertingSocketError(-inCqe.res));
+
+    if (!(inCqe.flags & IORING_CQE_F_MORE)) // Многократный приём прерван ядром, ставим заново
+    {
+        Result = !m_loop->resubmit(inOperation);
+
+        if (!Result && m_server.m_Callbacks.m_ErrorCallBack)
+            m_server.m_Callbacks.m_ErrorCallBack(make_error_code(errors::eNetError::neSocketResourceError));
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringAsyncServer::Acceptor::listen()
+{
+    m_owner = m_loop->attach(this);
+
+    std::unique_ptr<UringOperation> Accept = std::make_unique<UringOperation>();
+    Accept->m_type = eUringOperation::uoAccept;
+    Accept->m_owner = m_owner;
+    Accept->m_fd = m_fd;
+
+    return m_loop->submit(std::move(Accept)); // Одна операция принимает подключения до остановки сервера
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncServer::Acceptor::shutdown()
+{
+    m_loop->detach(m_owner); // Подключения, принятые после снятия, цикл закроет сам
+    ::shutdown(m_fd, SHUT_RD); // Слушающий сокет перестаёт принимать подключения в очередь
+    m_owner = 0;
+}
+//-----------------------------------------------------------------------------
+// HMUringAsyncServer
+//-----------------------------------------------------------------------------
+HMUringAsyncServer::HMUringAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops) :
+    HMAbstractAsyncServer(inCallbacks),
+    m_port(inPort),
+    m_loopsCount(inLoops)
+{
+
+}
+//-----------------------------------------------------------------------------
+HMUringAsyncServer::~HMUringAsyncServer()
+{
+    stop(); // При завершении обязательно останавливаем сервер
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringAsyncServer::start()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    stop(); // Принудительная остановка
+
+    std::size_t LoopsCount = m_loopsCount;
+
+    if (LoopsCount == 0) // Количество не задано, занимаем все ядра
+        LoopsCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (!portIsFree(m_port))
+        Error = make_error_code(errors::eNetError::neStartListenFail);
+
+    while (!Error && m_acceptors.size() < LoopsCount)
+    {
+        const int ListenFd = makeReusePortListener(m_port, Error);
+
+        if (!Error)
+        {
+            auto NewAcceptor = std::make_unique<Acceptor>(*this, ListenFd);
+            Error = NewAcceptor->m_loop->start();
+
+            if (!Error)
+            {
+                Acceptor* Handler = NewAcceptor.get();
+                NewAcceptor->m_loop->invoke([Handler, &Error]() { Error = Handler->listen(); });
+            }
+
+            m_acceptors.push_back(std::move(NewAcceptor)); // При ошибке будет освобождён вместе с остальными
+        }
+    }
+
+    if (Error) // Сервер не запущен целиком
+        m_acceptors.clear();
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMUringAsyncServer::isStarted() const
+{
+    return !m_acceptors.empty();
+}
+//-----------------------------------------------------------------------------
+void HMUringAsyncServer::stop()
+{
+    if (!isStarted()) // Если сервер не запущен то нет смысла
+        return;
+
+    for (const auto& CurrentAcceptor : m_acceptors) // Прекращаем приём, чтобы не пропустить соединения при закрытии
+    {
+        Acceptor* Handler = CurrentAcceptor.get();
+        Handler->m_loop->invoke([Handler]() { Handler->shutdown(); });
+    }
+
+    closeAllConnections(); // Закрываем все соединения (каждое в своём цикле)
+    m_acceptors.clear(); // Останавливаем циклы и закрываем слушающие сокеты
+}
+//-----------------------------------------------------------------------------
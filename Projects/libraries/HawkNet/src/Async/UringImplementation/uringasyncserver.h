@@ -0,0 +1,114 @@
+#ifndef HMURINGASYNCSERVER_H
+#define HMURINGASYNCSERVER_H
+
+/**
+ * @file uringasyncserver.h
+ * @brief Содержит описание асинхронного сервера на io_uring
+ */
+
+#include <memory>
+#include <vector>
+
+#include "Async/Abstract/abstractasyncserver.h"
+#include "uringloop.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMUringAsyncServer class - Класс, описывающий асинхронный TCP сервер на io_uring
+ * Как и у реализации epoll, каждый цикл слушает порт собственным сокетом с SO_REUSEPORT,
+ * а подключения принимает одна многократная операция приёма на цикл.
+ * Калбеки соединений вызываются в потоках циклов.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMUringAsyncServer : public HMAbstractAsyncServer
+{
+public:
+
+    /**
+     * @brief HMUringAsyncServer - Инициализирующий конструктор
+     * @param inPort - Прослушиваемый порт
+     * @param inCallbacks - Перечень калбеков
+     * @param inLoops - Количество циклов io_uring (0 - по количеству ядер)
+     */
+    HMUringAsyncServer(const std::uint16_t inPort, const ServCallbacks& inCallbacks, const std::size_t inLoops = 0);
+
+    /**
+     * @brief ~HMUringAsyncServer - Виртуальный деструктор
+     */
+    virtual ~HMUringAsyncServer() override;
+
+    /**
+     * @brief start - Метод запустит сервер
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code start() override;
+
+    /**
+     * @brief isStarted - Метод вернёт состояние сервера
+     * @return Вернёт состояние сервера
+     */
+    virtual bool isStarted() const override;
+
+    /**
+     * @brief stop - Метод остановит сервер
+     */
+    virtual void stop() override;
+
+private:
+
+    /**
+     * @brief The Acceptor class - Класс, принимающий подключения на сокете одного цикла
+     */
+    class Acceptor : public HMUringHandler
+    {
+    public:
+
+        /**
+         * @brief Acceptor - Инициализирующий конструктор
+         * @param inServer - Сервер, регистрирующий соединения
+         * @param inFd - Слушающий сокет
+         */
+        Acceptor(HMUringAsyncServer& inServer, const int inFd);
+
+        /**
+         * @brief ~Acceptor - Виртуальный деструктор (закрывает слушающий сокет)
+         */
+        virtual ~Acceptor() override;
+
+        /**
+         * @brief onCompletion - Метод зарегистрирует принятое подключение (поток цикла)
+         * @param inOperation - Операция приёма
+         * @param inCqe - Запись очереди завершений
+         * @return Вернёт true, если операция приёма передана ядру повторно
+         */
+        virtual bool onCompletion(UringOperation& inOperation, const io_uring_cqe& inCqe) override;
+
+        /**
+         * @brief listen - Метод зарегистрирует приёмник в цикле и начнёт приём (поток цикла)
+         * @return Вернёт признак ошибки
+         */
+        errors::error_code listen();
+
+        /**
+         * @brief shutdown - Метод прекратит приём подключений (поток цикла)
+         */
+        void shutdown();
+
+        HMUringAsyncServer& m_server;               ///< Сервер, регистрирующий соединения
+        const int m_fd = -1;                        ///< Слушающий сокет
+        std::unique_ptr<HMUringLoop> m_loop = nullptr; ///< Цикл, обслуживающий принятые соединения
+        std::uint64_t m_owner = 0;                  ///< Метка приёмника в цикле (0 - не зарегистрирован)
+    };
+
+    std::uint16_t m_port = 0;                           ///< Рабочий порт
+    const std::size_t m_loopsCount = 0;                 ///< Количество циклов
+    std::vector<std::unique_ptr<Acceptor>> m_acceptors; ///< Приёмники подключений со своими циклами
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMURINGASYNCSERVER_H
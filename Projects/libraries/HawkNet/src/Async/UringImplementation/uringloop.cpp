@@ -0,0 +1,691 @@
+#include "uringloop.h"
+
+#include <future>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+
+#include <neterrorcategory.h>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief ringSetup - Функция создаст кольцо io_uring (в glibc нет обёрток над системными вызовами io_uring)
+ * @param inEntries - Размер очереди отправки
+ * @param ioParams - Параметры кольца
+ * @return Вернёт дескриптор кольца или -1
+ */
+static int ringSetup(const unsigned inEntries, io_uring_params& ioParams)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, inEntries, &ioParams));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief ringEnter - Функция передаст ядру записи очереди отправки и дождётся завершений
+ * @param inRingFd - Дескриптор кольца
+ * @param inToSubmit - Количество передаваемых записей
+ * @param inMinComplete - Минимальное количество ожидаемых завершений
+ * @param inFlags - Флаги IORING_ENTER_*
+ * @param inTimeout - Предельное время ожидания завершений (nullptr - без ограничения)
+ * @return Вернёт количество принятых записей или -1 (ETIME - время ожидания истекло)
+ */
+static int ringEnter(const int inRingFd, const unsigned inToSubmit, const unsigned inMinComplete, const unsigned inFlags,
+                     const __kernel_timespec* inTimeout = nullptr)
+{
+    int Result = 0;
+
+    if (!inTimeout)
+        Result = static_cast<int>(::syscall(__NR_io_uring_enter, inRingFd, inToSubmit, inMinComplete, inFlags, nullptr, 0));
+    else
+    {
+        io_uring_getevents_arg Arg {}; // Расширенный аргумент (Linux 5.11) передаёт время ожидания без отдельной операции
+        Arg.ts = reinterpret_cast<std::uint64_t>(inTimeout);
+
+        Result = static_cast<int>(::syscall(__NR_io_uring_enter, inRingFd, inToSubmit, inMinComplete, inFlags | IORING_ENTER_EXT_ARG, &Arg, sizeof(Arg)));
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief ringRegister - Функция зарегистрирует в кольце ресурс
+ * @param inRingFd - Дескриптор кольца
+ * @param inOpcode - Код регистрации IORING_REGISTER_*
+ * @param inArg - Аргумент регистрации
+ * @param inArgsCount - Количество аргументов
+ * @return Вернёт 0 или -1
+ */
+static int ringRegister(const int inRingFd, const unsigned inOpcode, void* inArg, const unsigned inArgsCount)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, inRingFd, inOpcode, inArg, inArgsCount));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief mapRing - Функция отобразит область кольца в память
+ * @param inRingFd - Дескриптор кольца
+ * @param inSize - Размер области
+ * @param inOffset - Смещение области IORING_OFF_*
+ * @return Вернёт адрес отображения или nullptr
+ */
+static void* mapRing(const int inRingFd, const std::size_t inSize, const off_t inOffset)
+{
+    void* Result = ::mmap(nullptr, inSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, inRingFd, inOffset);
+    return (Result == MAP_FAILED) ? nullptr : Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief kernelAtLeast - Функция проверит версию ядра
+ * @param inMajor - Минимальная старшая версия
+ * @param inMinor - Минимальная младшая версия
+ * @return Вернёт true, если ядро не старше заданного
+ */
+static bool kernelAtLeast(const int inMajor, const int inMinor)
+{
+    bool Result = false;
+    utsname Name {};
+    int Major = 0;
+    int Minor = 0;
+
+    if (::uname(&Name) == 0 && std::sscanf(Name.release, "%d.%d", &Major, &Minor) == 2)
+        Result = Major > inMajor || (Major == inMajor && Minor >= inMinor);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+HMUringLoop::HMUringLoop() : hmcommon::HMNotCopyable()
+{
+    std::atomic_init(&m_threadID, std::thread::id());
+    std::atomic_init(&m_stopRequested, false);
+}
+//-----------------------------------------------------------------------------
+HMUringLoop::~HMUringLoop()
+{
+    stop();
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::isSupported()
+{
+    static const bool Supported = []() -> bool
+    {
+        bool Result = kernelAtLeast(6, 0); // Многократное чтение с выбором буфера появилось в 6.0
+        io_uring_params Params {};
+        const int RingFd = Result ? ringSetup(4, Params) : -1; // Кольцо может быть запрещено sysctl kernel.io_uring_disabled
+
+        Result = RingFd >= 0;
+
+        if (Result)
+        {
+            const std::size_t ProbeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+            std::vector<std::uint8_t> ProbeMemory(ProbeSize, 0);
+            io_uring_probe* Probe = reinterpret_cast<io_uring_probe*>(ProbeMemory.data());
+
+            Result = ringRegister(RingFd, IORING_REGISTER_PROBE, Probe, 256) == 0;
+
+            for (const std::uint8_t Opcode : { IORING_OP_ACCEPT, IORING_OP_RECV, IORING_OP_SEND, IORING_OP_POLL_ADD, IORING_OP_ASYNC_CANCEL, IORING_OP_PROVIDE_BUFFERS })
+                Result = Result && Opcode <= Probe->last_op && (Probe->ops[Opcode].flags & IO_URING_OP_SUPPORTED);
+
+            ::close(RingFd);
+        }
+
+        return Result;
+    }();
+
+    return Supported;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::start()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    stop(); // Принудительная остановка
+
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (m_wakeFd < 0)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+    else
+        Error = setupRing();
+
+    if (!Error)
+    {
+        {
+            std::lock_guard lg(m_tasksDefender);
+            m_acceptTasks = true;
+        }
+
+        m_stopRequested = false;
+        m_thread = std::thread(&HMUringLoop::run, this);
+    }
+    else
+        stop(); // Освобождаем частично созданные ресурсы
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::stop()
+{
+    if (m_thread.joinable())
+    {
+        assert(!inLoopThread()); // Поток не может дождаться сам себя
+        m_stopRequested = true;
+        wake();
+        m_thread.join();
+    }
+
+    releaseRing();
+
+    if (m_wakeFd >= 0)
+    {
+        ::close(m_wakeFd);
+        m_wakeFd = -1;
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::isRunning() const
+{
+    std::lock_guard lg(m_tasksDefender);
+    return m_acceptTasks;
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::inLoopThread() const
+{
+    return m_threadID.load() == std::this_thread::get_id();
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMUringLoop::attach(HMUringHandler* inHandler)
+{
+    assert(inHandler != nullptr);
+
+    const std::uint64_t Result = ++m_lastOwner; // Метки не переиспользуются, поэтому старые завершения не попадут к новому обработчику
+    m_handlers.emplace(Result, inHandler);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::detach(const std::uint64_t inOwner)
+{
+    m_handlers.erase(inOwner);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::submit(std::unique_ptr<UringOperation>&& inOperation)
+{
+    errors::error_code Error = prepare(inOperation.get());
+
+    if (!Error) // Операцией теперь владеет цикл, освобождается она по последнему завершению
+        inOperation.release();
+    else
+        inOperation.reset();
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::postOperation(std::unique_ptr<UringOperation>&& inOperation)
+{
+    bool Result = true;
+    UringOperation* Operation = inOperation.release(); // Задача цикла должна быть копируемой, поэтому владение передаётся указателем
+
+    if (inLoopThread()) // Обработчик может надолго занять поток цикла, поэтому его операцию ядро получает сразу
+    {
+        acceptOperation(Operation);
+        Result = enter(false);
+    }
+    else
+    {
+        Result = post([this, Operation]() { acceptOperation(Operation); });
+
+        if (!Result)
+            delete Operation;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::resubmit(UringOperation& inOperation)
+{
+    return prepare(&inOperation);
+}
+//-----------------------------------------------------------------------------
+const char* HMUringLoop::buffer(const io_uring_cqe& inCqe) const
+{
+    const std::size_t BufferID = inCqe.flags >> IORING_CQE_BUFFER_SHIFT;
+    return m_buffers + BufferID * C_URING_BUFFER_SIZE;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::recycle(const io_uring_cqe& inCqe)
+{
+    const std::uint16_t BufferID = static_cast<std::uint16_t>(inCqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+    // Ядро получит буфер раньше операций, поставленных после возврата, поэтому повторное чтение его уже увидит
+    [[maybe_unused]] errors::error_code Error = provideBuffers(BufferID, 1);
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::post(UringTaskFn&& inTask)
+{
+    bool Result = false;
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+
+        if (m_acceptTasks) // Остановленный цикл задачи не принимает, иначе они никогда не выполнятся
+        {
+            m_tasks.push_back(std::move(inTask));
+            Result = true;
+        }
+    }
+
+    if (Result)
+        wake();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::invoke(UringTaskFn&& inTask)
+{
+    if (inLoopThread())
+        inTask();
+    else
+    {
+        std::promise<void> Done;
+        std::future<void> DoneFuture = Done.get_future();
+        UringTaskFn Task = std::move(inTask);
+
+        if (post([&Task, &Done]() { Task(); Done.set_value(); }))
+            DoneFuture.wait();
+        else // Цикл остановлен: доступ к кольцу уже не конкурирует с ним
+            Task();
+    }
+}
+//-----------------------------------------------------------------------------
+HMTimerWheel& HMUringLoop::timers()
+{
+    return m_timers;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::setupRing()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    io_uring_params Params {};
+    Params.flags = IORING_SETUP_CQSIZE; // Многократные операции дают много завершений на одну запись
+    Params.cq_entries = C_URING_ENTRIES * 4;
+
+    m_ringFd = ringSetup(C_URING_ENTRIES, Params);
+
+    if (m_ringFd < 0)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+    else
+    {
+        m_sqRingSize = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+        m_cqRingSize = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+
+        if (Params.features & IORING_FEAT_SINGLE_MMAP) // Обе очереди лежат в одном отображении
+            m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+
+        m_sqesSize = Params.sq_entries * sizeof(io_uring_sqe);
+
+        m_sqRing = mapRing(m_ringFd, m_sqRingSize, IORING_OFF_SQ_RING);
+        m_cqRing = (Params.features & IORING_FEAT_SINGLE_MMAP) ? m_sqRing : mapRing(m_ringFd, m_cqRingSize, IORING_OFF_CQ_RING);
+        m_sqes = static_cast<io_uring_sqe*>(mapRing(m_ringFd, m_sqesSize, IORING_OFF_SQES));
+
+        if (!m_sqRing || !m_cqRing || !m_sqes)
+            Error = make_error_code(errors::eNetError::neSocketResourceError);
+    }
+
+    if (!Error)
+    {
+        char* Sq = static_cast<char*>(m_sqRing);
+        m_sqHead = reinterpret_cast<unsigned*>(Sq + Params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned*>(Sq + Params.sq_off.tail);
+        m_sqArray = reinterpret_cast<unsigned*>(Sq + Params.sq_off.array);
+        m_sqMask = *reinterpret_cast<unsigned*>(Sq + Params.sq_off.ring_mask);
+        m_sqEntries = *reinterpret_cast<unsigned*>(Sq + Params.sq_off.ring_entries);
+        m_sqLocalTail = *m_sqTail;
+
+        char* Cq = static_cast<char*>(m_cqRing);
+        m_cqHead = reinterpret_cast<unsigned*>(Cq + Params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(Cq + Params.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned*>(Cq + Params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(Cq + Params.cq_off.cqes);
+
+        m_buffersSize = C_URING_BUFFERS_COUNT * C_URING_BUFFER_SIZE;
+        void* Memory = ::mmap(nullptr, m_buffersSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (Memory == MAP_FAILED)
+        {
+            m_buffersSize = 0;
+            Error = make_error_code(errors::eNetError::neSocketResourceError);
+        }
+        else
+        {
+            m_buffers = static_cast<char*>(Memory);
+            Error = provideBuffers(0, C_URING_BUFFERS_COUNT); // Все буферы уходят ядру одной записью при первом ожидании цикла
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::releaseRing()
+{
+    if (m_ringFd >= 0) // Закрытие кольца освобождает и группу буферов
+    {
+        ::close(m_ringFd);
+        m_ringFd = -1;
+    }
+
+    if (m_buffers)
+        ::munmap(m_buffers, m_buffersSize);
+
+    if (m_sqes)
+        ::munmap(m_sqes, m_sqesSize);
+
+    if (m_cqRing && m_cqRing != m_sqRing)
+        ::munmap(m_cqRing, m_cqRingSize);
+
+    if (m_sqRing)
+        ::munmap(m_sqRing, m_sqRingSize);
+
+    m_buffers = nullptr;
+    m_sqes = nullptr;
+    m_cqRing = nullptr;
+    m_sqRing = nullptr;
+
+    m_handlers.clear();
+    m_inFlight = 0;
+}
+//-----------------------------------------------------------------------------
+io_uring_sqe* HMUringLoop::nextSqe()
+{
+    io_uring_sqe* Result = nullptr;
+
+    if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) // Очередь заполнена, передаём её ядру досрочно
+        enter(false);
+
+    if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) < m_sqEntries)
+    {
+        const unsigned Index = m_sqLocalTail & m_sqMask;
+        Result = &m_sqes[Index];
+        std::memset(Result, 0, sizeof(io_uring_sqe));
+        m_sqArray[Index] = Index;
+        ++m_sqLocalTail;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::provideBuffers(const std::uint16_t inFirst, const std::uint16_t inCount)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    io_uring_sqe* Sqe = nextSqe();
+
+    if (!Sqe)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+    else
+    {
+        Sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+        Sqe->flags = IOSQE_CQE_SKIP_SUCCESS; // Завершение придёт только при ошибке и будет отброшено
+        Sqe->fd = inCount;
+        Sqe->addr = reinterpret_cast<std::uint64_t>(m_buffers + std::size_t(inFirst) * C_URING_BUFFER_SIZE);
+        Sqe->len = C_URING_BUFFER_SIZE;
+        Sqe->off = inFirst;
+        Sqe->buf_group = C_URING_BUFFER_GROUP;
+        Sqe->user_data = 0;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::acceptOperation(UringOperation* inOperation)
+{
+    if (m_handlers.find(inOperation->m_owner) == m_handlers.end()) // Обработчик снят, пока операция шла к циклу
+        delete inOperation;
+    else if (prepare(inOperation)) // Кольцо не приняло операцию, завершаем её для обработчика сами
+    {
+        io_uring_cqe Cqe {};
+        Cqe.user_data = reinterpret_cast<std::uint64_t>(inOperation);
+        Cqe.res = -EAGAIN;
+
+        ++m_inFlight; // Завершение учитывается так же, как пришедшее от ядра
+        dispatch(Cqe);
+    }
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMUringLoop::prepare(UringOperation* inOperation)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    io_uring_sqe* Sqe = (m_ringFd >= 0) ? nextSqe() : nullptr;
+
+    if (!Sqe)
+        Error = make_error_code(errors::eNetError::neSocketResourceError);
+    else
+    {
+        Sqe->fd = inOperation->m_fd;
+        Sqe->user_data = reinterpret_cast<std::uint64_t>(inOperation);
+
+        switch (inOperation->m_type)
+        {
+            case eUringOperation::uoWake:
+            {
+                Sqe->opcode = IORING_OP_POLL_ADD;
+                Sqe->poll32_events = POLLIN;
+                Sqe->len = IORING_POLL_ADD_MULTI;
+                break;
+            }
+            case eUringOperation::uoAccept:
+            {
+                Sqe->opcode = IORING_OP_ACCEPT;
+                Sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+                Sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+                break;
+            }
+            case eUringOperation::uoRecv:
+            {
+                Sqe->opcode = IORING_OP_RECV;
+                Sqe->ioprio = IORING_RECV_MULTISHOT;
+                Sqe->flags = IOSQE_BUFFER_SELECT; // Буфер выбирает ядро в момент прихода данных
+                Sqe->buf_group = C_URING_BUFFER_GROUP;
+                break;
+            }
+            case eUringOperation::uoSend:
+            {
+                Sqe->opcode = IORING_OP_SEND;
+                Sqe->addr = reinterpret_cast<std::uint64_t>(inOperation->m_data.data() + inOperation->m_offset);
+                Sqe->len = static_cast<std::uint32_t>(inOperation->m_data.size() - inOperation->m_offset);
+                Sqe->msg_flags = MSG_NOSIGNAL;
+                break;
+            }
+            case eUringOperation::uoConnect:
+            {
+                Sqe->opcode = IORING_OP_POLL_ADD;
+                Sqe->poll32_events = POLLOUT;
+                break;
+            }
+            case eUringOperation::uoCancel:
+            {
+                Sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                Sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+                break;
+            }
+        }
+
+        ++m_inFlight;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMUringLoop::enter(const bool inWait, const std::chrono::milliseconds inTimeout)
+{
+    bool Result = true;
+    __kernel_timespec Timeout {};
+    Timeout.tv_sec = inTimeout.count() / 1000;
+    Timeout.tv_nsec = (inTimeout.count() % 1000) * 1000000;
+
+    __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE); // Публикуем накопленные записи
+    const unsigned ToSubmit = m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+
+    if (ToSubmit > 0 || inWait)
+    {
+        const int Entered = ringEnter(m_ringFd, ToSubmit, inWait ? 1 : 0, inWait ? IORING_ENTER_GETEVENTS : 0,
+                                      (inWait && inTimeout.count() >= 0) ? &Timeout : nullptr);
+
+        // EINTR - прерван сигналом, EBUSY/EAGAIN - ядру нужно сначала отдать завершения, ETIME - наступил срок таймера
+        if (Entered < 0 && errno != EINTR && errno != EBUSY && errno != EAGAIN && errno != ETIME)
+            Result = false;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::reap()
+{
+    unsigned Head = *m_cqHead; // Голову очереди завершений изменяет только поток цикла
+
+    while (Head != __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+    {
+        const io_uring_cqe Cqe = m_cqes[Head & m_cqMask];
+        __atomic_store_n(m_cqHead, ++Head, __ATOMIC_RELEASE); // Освобождаем запись до обработки: обработчик может передать ядру новые операции
+
+        dispatch(Cqe);
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::dispatch(const io_uring_cqe& inCqe)
+{
+    UringOperation* Operation = reinterpret_cast<UringOperation*>(inCqe.user_data);
+    const bool Final = !(inCqe.flags & IORING_CQE_F_MORE); // Последнее завершение операции
+    bool Keep = false;
+
+    if (!Operation) // Неудачная передача буферов: буфер выбывает из группы, чтение продолжится на остальных
+        return;
+
+    if (Final)
+        --m_inFlight;
+
+    if (Operation->m_owner == 0) // Служебные операции цикла
+    {
+        if (Operation->m_type == eUringOperation::uoWake)
+        {
+            std::uint64_t Counter = 0;
+            while (::read(m_wakeFd, &Counter, sizeof(Counter)) > 0) {} // Сбрасываем счётчик eventfd
+
+            if (Final && !m_stopRequested) // Многократное ожидание прервано ядром, ставим заново
+            {
+                armWake(Operation);
+                Keep = true;
+            }
+        }
+    }
+    else
+    {
+        auto It = m_handlers.find(Operation->m_owner);
+
+        if (It != m_handlers.end())
+            Keep = It->second->onCompletion(*Operation, inCqe);
+        else if (inCqe.flags & IORING_CQE_F_BUFFER) // Обработчик снят, но буфер нужно вернуть ядру
+            recycle(inCqe);
+        else if (Operation->m_type == eUringOperation::uoAccept && inCqe.res >= 0) // Подключение, принятое после снятия приёмника
+            ::close(inCqe.res);
+    }
+
+    if (Final && !Keep)
+        delete Operation;
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::armWake(UringOperation* inOperation)
+{
+    if (!inOperation)
+    {
+        std::unique_ptr<UringOperation> NewOperation = std::make_unique<UringOperation>();
+        NewOperation->m_type = eUringOperation::uoWake;
+        NewOperation->m_fd = m_wakeFd;
+
+        errors::error_code Error = submit(std::move(NewOperation));
+
+        if (Error) // Без пробуждения цикл не увидит ни задач, ни остановки
+            m_stopRequested = true;
+    }
+    else if (resubmit(*inOperation))
+    {
+        m_stopRequested = true;
+        delete inOperation;
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::run()
+{
+    m_threadID = std::this_thread::get_id();
+
+    armWake(nullptr);
+
+    while (!m_stopRequested)
+    {
+        if (!enter(true, m_timers.nextTimeout(std::chrono::steady_clock::now()))) // Кольцо испорчено, продолжать бессмысленно
+            break;
+
+        reap();
+        runTasks(); // Задачи выполняются после всей пачки завершений, их операции уйдут ядру следующим вызовом
+        m_timers.advance(std::chrono::steady_clock::now()); // Сработавшие таймеры, как и задачи, вне обработки пачки
+    }
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+        m_acceptTasks = false;
+    }
+
+    runTasks(); // Выполняем задачи, принятые до остановки: их могут ожидать чужие потоки
+    drain();
+    m_threadID = std::thread::id();
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::runTasks()
+{
+    std::vector<UringTaskFn> Tasks;
+
+    {
+        std::lock_guard lg(m_tasksDefender);
+        Tasks.swap(m_tasks);
+    }
+
+    for (UringTaskFn& Task : Tasks)
+        Task();
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::drain()
+{
+    m_handlers.clear(); // Завершения при остановке обработчикам не передаются
+
+    std::unique_ptr<UringOperation> Cancel = std::make_unique<UringOperation>();
+    Cancel->m_type = eUringOperation::uoCancel;
+
+    bool Proceed = !submit(std::move(Cancel));
+
+    // Память операций можно освободить только после их завершения ядром
+    while (Proceed && m_inFlight > 0)
+    {
+        Proceed = enter(true);
+        reap();
+    }
+}
+//-----------------------------------------------------------------------------
+void HMUringLoop::wake() const
+{
+    const std::uint64_t One = 1;
+
+    if (m_wakeFd >= 0)
+    {
+        [[maybe_unused]] const ssize_t Written = ::write(m_wakeFd, &One, sizeof(One)); // Переполнение счётчика означает, что цикл и так разбужен
+    }
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,341 @@
+#ifndef HMURINGLOOP_H
+#define HMURINGLOOP_H
+
+/**
+ * @file uringloop.h
+ * @brief Содержит описание цикла событий io_uring
+ */
+
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+#include <linux/io_uring.h>
+
+#include <HawkCommon.h>
+#include <errorcode.h>
+
+#include "Timers/timerwheel.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+constexpr unsigned C_URING_ENTRIES = 1024;          ///< Размер очереди отправки кольца (очередь завершений вчетверо больше)
+constexpr unsigned C_URING_BUFFERS_COUNT = 512;     ///< Количество буферов приёма, предоставленных ядру
+constexpr unsigned C_URING_BUFFER_SIZE = 8 * 1024;  ///< Размер буфера приёма (8 КБ)
+constexpr std::uint16_t C_URING_BUFFER_GROUP = 0;   ///< Идентификатор группы буферов приёма
+//-----------------------------------------------------------------------------
+/**
+ * @brief The eUringOperation enum - Перечень типов операций io_uring
+ */
+enum class eUringOperation
+{
+    uoWake,     ///< Ожидание пробуждения цикла (eventfd)
+    uoAccept,   ///< Многократный приём подключений
+    uoRecv,     ///< Многократное чтение в буферы группы
+    uoSend,     ///< Отправка данных
+    uoConnect,  ///< Однократное ожидание готовности подключающегося сокета к записи (завершения подключения)
+    uoCancel    ///< Отмена операций
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The UringOperation struct - Структура, описывающая операцию, переданную ядру
+ * Операция принадлежит циклу с момента передачи и до последнего завершения,
+ * поэтому память, с которой работает ядро, не освобождается вместе с обработчиком.
+ */
+struct UringOperation
+{
+    eUringOperation m_type = eUringOperation::uoWake;   ///< Тип операции
+    std::uint64_t m_owner = 0;                          ///< Метка обработчика операции (0 - сам цикл)
+    int m_fd = -1;                                      ///< Дескриптор, над которым выполняется операция
+    std::string m_data;                                 ///< Отправляемые данные (uoSend)
+    std::size_t m_offset = 0;                           ///< Количество уже отправленных байт (uoSend)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMUringHandler class - Интерфейс обработчика завершений операций
+ */
+class HMUringHandler
+{
+public:
+
+    /**
+     * @brief ~HMUringHandler - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMUringHandler() = default;
+
+    /**
+     * @brief onCompletion - Метод обработает завершение операции (вызывается в потоке цикла)
+     * @param inOperation - Операция
+     * @param inCqe - Запись очереди завершений
+     * @return Вернёт true, если операция передана ядру повторно и освобождать её нельзя
+     */
+    virtual bool onCompletion(UringOperation& inOperation, const io_uring_cqe& inCqe) = 0;
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief UringTaskFn - Тип задачи, выполняемой в потоке цикла
+ */
+typedef std::function<void()> UringTaskFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMUringLoop class - Класс, описывающий цикл событий io_uring в собственном потоке
+ * Кольцо работает напрямую через системные вызовы: операции копятся в очереди отправки
+ * и уходят ядру одним io_uring_enter на итерацию цикла вместе с ожиданием завершений.
+ * Для чтения ядру предоставляется группа буферов, из которой многократные операции сами выбирают буфер;
+ * освободившийся буфер возвращается в группу записью, уходящей ядру вместе с остальной пачкой.
+ * Обработчики регистрируются метками, поэтому завершения снятого обработчика просто отбрасываются.
+ * Ожидание завершений ограничено ближайшим сроком колеса таймеров цикла (IORING_ENTER_EXT_ARG).
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMUringLoop : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMUringLoop - Конструктор по умолчанию
+     */
+    HMUringLoop();
+
+    /**
+     * @brief ~HMUringLoop - Виртуальный деструктор (останавливает цикл)
+     */
+    virtual ~HMUringLoop() override;
+
+    /**
+     * @brief isSupported - Метод проверит, поддерживает ли ядро всё необходимое циклу
+     * (многократные приём и чтение, группы буферов; Linux 6.0 и новее)
+     * @return Вернёт признак поддержки
+     */
+    static bool isSupported();
+
+    /**
+     * @brief start - Метод создаст кольцо и запустит поток цикла
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code start();
+
+    /**
+     * @brief stop - Метод остановит поток цикла, выполнив уже переданные задачи и отменив операции
+     */
+    void stop();
+
+    /**
+     * @brief isRunning - Метод вернёт признак работы цикла (приёма задач)
+     * @return Вернёт признак работы цикла
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief inLoopThread - Метод проверит, выполняется ли вызов в потоке цикла
+     * @return Вернёт true для потока цикла
+     */
+    bool inLoopThread() const;
+
+    /**
+     * @brief attach - Метод зарегистрирует обработчик (только поток цикла)
+     * @param inHandler - Обработчик
+     * @return Вернёт метку обработчика для операций
+     */
+    std::uint64_t attach(HMUringHandler* inHandler);
+
+    /**
+     * @brief detach - Метод снимет обработчик с учёта, его незавершённые операции будут отброшены (только поток цикла)
+     * @param inOwner - Метка обработчика
+     */
+    void detach(const std::uint64_t inOwner);
+
+    /**
+     * @brief submit - Метод поместит операцию в очередь отправки кольца (только поток цикла)
+     * Ядру очередь передаётся при следующем ожидании завершений, одним вызовом на всю пачку.
+     * @param inOperation - Операция (при ошибке освобождается)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code submit(std::unique_ptr<UringOperation>&& inOperation);
+
+    /**
+     * @brief postOperation - Метод передаст операцию циклу из любого потока
+     * Операция снятого к этому моменту обработчика отбрасывается, а непринятая кольцом
+     * завершается для обработчика с ошибкой -EAGAIN, поэтому обработчик всегда узнает об её судьбе.
+     * Из потока цикла операция передаётся ядру сразу, не дожидаясь конца обработки пачки завершений.
+     * @param inOperation - Операция
+     * @return Вернёт false, если цикл остановлен и операция отброшена
+     */
+    bool postOperation(std::unique_ptr<UringOperation>&& inOperation);
+
+    /**
+     * @brief resubmit - Метод повторно поместит в очередь операцию, завершение которой сейчас обрабатывается
+     * @param inOperation - Операция
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code resubmit(UringOperation& inOperation);
+
+    /**
+     * @brief buffer - Метод вернёт буфер приёма, выбранный ядром
+     * @param inCqe - Запись очереди завершений с флагом IORING_CQE_F_BUFFER
+     * @return Вернёт указатель на данные буфера
+     */
+    const char* buffer(const io_uring_cqe& inCqe) const;
+
+    /**
+     * @brief recycle - Метод вернёт буфер приёма ядру
+     * @param inCqe - Запись очереди завершений с флагом IORING_CQE_F_BUFFER
+     */
+    void recycle(const io_uring_cqe& inCqe);
+
+    /**
+     * @brief post - Метод передаст задачу в поток цикла
+     * @param inTask - Задача
+     * @return Вернёт false, если цикл остановлен и задача не принята
+     */
+    bool post(UringTaskFn&& inTask);
+
+    /**
+     * @brief invoke - Метод выполнит задачу в потоке цикла и дождётся её завершения
+     * В потоке цикла или у остановленного цикла задача выполняется сразу.
+     * @param inTask - Задача
+     */
+    void invoke(UringTaskFn&& inTask);
+
+    /**
+     * @brief timers - Метод вернёт колесо таймеров цикла (только поток цикла)
+     * @return Вернёт колесо таймеров
+     */
+    HMTimerWheel& timers();
+
+private:
+
+    int m_ringFd = -1;                      ///< Дескриптор кольца
+    int m_wakeFd = -1;                      ///< Дескриптор eventfd для пробуждения цикла
+
+    void* m_sqRing = nullptr;               ///< Отображение кольца отправки
+    void* m_cqRing = nullptr;               ///< Отображение кольца завершений (совпадает с m_sqRing при IORING_FEAT_SINGLE_MMAP)
+    std::size_t m_sqRingSize = 0;           ///< Размер отображения кольца отправки
+    std::size_t m_cqRingSize = 0;           ///< Размер отображения кольца завершений
+    io_uring_sqe* m_sqes = nullptr;         ///< Массив записей очереди отправки
+    std::size_t m_sqesSize = 0;             ///< Размер отображения записей очереди отправки
+
+    unsigned* m_sqHead = nullptr;           ///< Голова очереди отправки (изменяет ядро)
+    unsigned* m_sqTail = nullptr;           ///< Хвост очереди отправки (изменяет цикл)
+    unsigned* m_sqArray = nullptr;          ///< Массив индексов записей очереди отправки
+    unsigned m_sqMask = 0;                  ///< Маска индекса очереди отправки
+    unsigned m_sqEntries = 0;               ///< Размер очереди отправки
+    unsigned m_sqLocalTail = 0;             ///< Хвост с ещё не опубликованными записями
+
+    unsigned* m_cqHead = nullptr;           ///< Голова очереди завершений (изменяет цикл)
+    unsigned* m_cqTail = nullptr;           ///< Хвост очереди завершений (изменяет ядро)
+    unsigned m_cqMask = 0;                  ///< Маска индекса очереди завершений
+    io_uring_cqe* m_cqes = nullptr;         ///< Массив записей очереди завершений
+
+    char* m_buffers = nullptr;              ///< Память буферов приёма
+    std::size_t m_buffersSize = 0;          ///< Размер отображения буферов приёма
+
+    std::thread m_thread;                   ///< Поток цикла
+    std::atomic<std::thread::id> m_threadID; ///< Идентификатор потока цикла
+    std::atomic_bool m_stopRequested;       ///< Флаг запроса остановки
+
+    std::uint64_t m_lastOwner = 0;                                  ///< Последняя выданная метка обработчика
+    std::unordered_map<std::uint64_t, HMUringHandler*> m_handlers;  ///< Зарегистрированные обработчики
+    std::size_t m_inFlight = 0;                                     ///< Количество операций, ещё не завершённых ядром
+
+    mutable std::mutex m_tasksDefender;     ///< Мьютекс, защищающий очередь задач
+    std::vector<UringTaskFn> m_tasks;       ///< Задачи, переданные из чужих потоков
+    bool m_acceptTasks = false;             ///< Признак приёма задач
+
+    HMTimerWheel m_timers;                  ///< Колесо таймеров цикла
+
+    /**
+     * @brief setupRing - Метод создаст кольцо, отобразит его очереди и передаст ядру буферы приёма
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code setupRing();
+
+    /**
+     * @brief releaseRing - Метод освободит кольцо и его отображения
+     */
+    void releaseRing();
+
+    /**
+     * @brief nextSqe - Метод выделит запись очереди отправки, при переполнении передав очередь ядру
+     * @return Вернёт запись или nullptr
+     */
+    io_uring_sqe* nextSqe();
+
+    /**
+     * @brief provideBuffers - Метод поместит в очередь передачу ядру непрерывного диапазона буферов приёма
+     * Успешная передача завершения не порождает, поэтому операцией не сопровождается.
+     * @param inFirst - Идентификатор первого буфера
+     * @param inCount - Количество буферов
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code provideBuffers(const std::uint16_t inFirst, const std::uint16_t inCount);
+
+    /**
+     * @brief acceptOperation - Метод поместит в очередь операцию, переданную postOperation (поток цикла)
+     * @param inOperation - Операция
+     */
+    void acceptOperation(UringOperation* inOperation);
+
+    /**
+     * @brief prepare - Метод заполнит запись очереди отправки по операции
+     * @param inOperation - Операция
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code prepare(UringOperation* inOperation);
+
+    /**
+     * @brief enter - Метод передаст ядру накопленные записи и при необходимости дождётся завершений
+     * @param inWait - Признак ожидания хотя бы одного завершения
+     * @param inTimeout - Предельное время ожидания (отрицательное - без ограничения)
+     * @return Вернёт false при неустранимой ошибке кольца
+     */
+    bool enter(const bool inWait, const std::chrono::milliseconds inTimeout = std::chrono::milliseconds(-1));
+
+    /**
+     * @brief reap - Метод обработает все записи очереди завершений
+     */
+    void reap();
+
+    /**
+     * @brief dispatch - Метод передаст завершение обработчику операции
+     * @param inCqe - Запись очереди завершений
+     */
+    void dispatch(const io_uring_cqe& inCqe);
+
+    /**
+     * @brief armWake - Метод поставит ожидание пробуждения цикла
+     * @param inOperation - Операция ожидания (nullptr - создать новую)
+     */
+    void armWake(UringOperation* inOperation);
+
+    /**
+     * @brief run - Метод, выполняемый в потоке цикла
+     */
+    void run();
+
+    /**
+     * @brief runTasks - Метод выполнит накопленные задачи
+     */
+    void runTasks();
+
+    /**
+     * @brief drain - Метод отменит все операции и дождётся их завершения (поток цикла при выходе)
+     */
+    void drain();
+
+    /**
+     * @brief wake - Метод разбудит поток цикла
+     */
+    void wake() const;
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMURINGLOOP_H
@@ -0,0 +1,177 @@
+#include "bytebuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMByteBuffer::HMByteBuffer(const FrameView inData)
+{
+    append(inData);
+}
+//-----------------------------------------------------------------------------
+HMByteBuffer::HMByteBuffer(const oByteStream& inStream) : HMByteBuffer(FrameView(inStream.str()))
+{
+
+}
+//-----------------------------------------------------------------------------
+HMByteBuffer::HMByteBuffer(HMByteBuffer&& inOther) noexcept
+{
+    take(inOther);
+}
+//-----------------------------------------------------------------------------
+HMByteBuffer& HMByteBuffer::operator=(HMByteBuffer&& inOther) noexcept
+{
+    if (this != &inOther)
+        take(inOther);
+
+    return *this;
+}
+//-----------------------------------------------------------------------------
+HMByteBuffer::operator iByteStream() const
+{
+    return iByteStream(str());
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::reserve(const std::size_t inSize)
+{
+    if (inSize > size())
+        ensureTail(inSize - size());
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::append(const FrameView inData)
+{
+    if (!inData.empty())
+        std::memcpy(extend(inData.size()), inData.data(), inData.size());
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::push_back(const char inByte)
+{
+    *extend(1) = inByte;
+}
+//-----------------------------------------------------------------------------
+char* HMByteBuffer::extend(const std::size_t inSize)
+{
+    ensureTail(inSize);
+
+    char* Result = storage() + m_end;
+    m_end += inSize;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::consume(const std::size_t inSize)
+{
+    m_begin += std::min(inSize, size());
+
+    if (m_begin == m_end) // Сообщение отброшено целиком, хранилище снова используется с начала
+        clear();
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::truncate(const std::size_t inSize)
+{
+    m_end = m_begin + std::min(inSize, size());
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::clear()
+{
+    m_begin = 0;
+    m_end = 0;
+}
+//-----------------------------------------------------------------------------
+const char* HMByteBuffer::data() const
+{
+    return storage() + m_begin;
+}
+//-----------------------------------------------------------------------------
+char* HMByteBuffer::data()
+{
+    return storage() + m_begin;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMByteBuffer::size() const
+{
+    return m_end - m_begin;
+}
+//-----------------------------------------------------------------------------
+bool HMByteBuffer::empty() const
+{
+    return m_begin == m_end;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMByteBuffer::capacity() const
+{
+    return m_capacity - m_begin;
+}
+//-----------------------------------------------------------------------------
+FrameView HMByteBuffer::view() const
+{
+    return FrameView(data(), size());
+}
+//-----------------------------------------------------------------------------
+FrameView HMByteBuffer::view(const std::size_t inOffset, const std::size_t inLength) const
+{
+    const std::size_t Offset = std::min(inOffset, size());
+    return FrameView(data() + Offset, std::min(inLength, size() - Offset));
+}
+//-----------------------------------------------------------------------------
+std::string HMByteBuffer::str() const
+{
+    return std::string(data(), size());
+}
+//-----------------------------------------------------------------------------
+char* HMByteBuffer::storage()
+{
+    return (m_heap) ? m_heap.get() : m_inline;
+}
+//-----------------------------------------------------------------------------
+const char* HMByteBuffer::storage() const
+{
+    return (m_heap) ? m_heap.get() : m_inline;
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::ensureTail(const std::size_t inSize)
+{
+    if (m_capacity - m_end < inSize) // В конце хранилища не хватает места
+    {
+        const std::size_t Size = size();
+
+        if (m_capacity - Size >= inSize) // Места хватит после сдвига сообщения в начало хранилища
+            std::memmove(storage(), data(), Size);
+        else // Расширяем хранилище
+        {
+            const std::size_t NewCapacity = std::max(m_capacity * 2, Size + inSize);
+            std::unique_ptr<char[]> NewHeap(new char[NewCapacity]); // Память не обнуляется: она сразу перезаписывается
+
+            std::memcpy(NewHeap.get(), data(), Size);
+            m_heap = std::move(NewHeap);
+            m_capacity = NewCapacity;
+        }
+
+        m_begin = 0;
+        m_end = Size;
+    }
+
+    assert(m_capacity - m_end >= inSize);
+}
+//-----------------------------------------------------------------------------
+void HMByteBuffer::take(HMByteBuffer& ioOther)
+{
+    m_heap = std::move(ioOther.m_heap);
+    m_capacity = ioOther.m_capacity;
+    m_begin = ioOther.m_begin;
+    m_end = ioOther.m_end;
+
+    if (!m_heap) // Встроенное хранилище не перемещается, копируем короткое сообщение
+    {
+        std::memcpy(m_inline, ioOther.m_inline + m_begin, size());
+        m_end -= m_begin;
+        m_begin = 0;
+    }
+
+    ioOther.m_capacity = C_BYTE_BUFFER_INLINE_CAPACITY;
+    ioOther.clear();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,216 @@
+#ifndef HMBYTEBUFFER_H
+#define HMBYTEBUFFER_H
+
+/**
+ * @file bytebuffer.h
+ * @brief Содержит описание буфера сообщения
+ */
+
+#include <memory>
+#include <cstddef>
+
+#include "nettypes.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+constexpr std::size_t C_BYTE_BUFFER_INLINE_CAPACITY = 64; ///< Ёмкость встроенного хранилища буфера сообщения (короткие сообщения не выделяют память)
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMByteBuffer class - Класс, описывающий перемещаемый буфер сообщения
+ * Короткие сообщения хранятся во встроенном хранилище, длинные - в куче. Буфер только перемещается:
+ * сообщение проходит от сокета до обработчика и очереди отправки без копирования данных.
+ * Очистка сохраняет выделенную память, а отбрасывание начала сообщения сдвигает только смещение.
+ *
+ * Для совместимости буфер создаётся из oByteStream и неявно преобразуется в iByteStream
+ * (с копированием данных).
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMByteBuffer
+{
+public:
+
+    /**
+     * @brief HMByteBuffer - Конструктор по умолчанию
+     */
+    HMByteBuffer() = default;
+
+    /**
+     * @brief HMByteBuffer - Инициализирующий конструктор
+     * @param inData - Копируемые в буфер данные
+     */
+    explicit HMByteBuffer(const FrameView inData);
+
+    /**
+     * @brief HMByteBuffer - Конструктор совместимости с потоковым интерфейсом (копирует данные потока)
+     * @param inStream - Поток отправляемых данных
+     */
+    HMByteBuffer(const oByteStream& inStream);
+
+    /**
+     * @brief HMByteBuffer - Конструктор перемещения
+     * @param inOther - Перемещаемый буфер (остаётся пустым)
+     */
+    HMByteBuffer(HMByteBuffer&& inOther) noexcept;
+
+    /**
+     * @brief HMByteBuffer - Запрещённый конструктор копирования
+     */
+    HMByteBuffer(const HMByteBuffer&) = delete;
+
+    /**
+     * @brief ~HMByteBuffer - Деструктор по умолчанию
+     */
+    ~HMByteBuffer() = default;
+
+    /**
+     * @brief operator = - Оператор перемещения
+     * @param inOther - Перемещаемый буфер (остаётся пустым)
+     * @return Вернёт ссылку на себя
+     */
+    HMByteBuffer& operator=(HMByteBuffer&& inOther) noexcept;
+
+    /**
+     * @brief operator = - Запрещённый оператор копирования
+     * @return ---
+     */
+    HMByteBuffer& operator=(const HMByteBuffer&) = delete;
+
+    /**
+     * @brief operator iByteStream - Преобразование для обработчиков, принимающих поток (копирует данные)
+     */
+    operator iByteStream() const;
+
+    /**
+     * @brief reserve - Метод обеспечит место под сообщение указанного размера без перераспределений
+     * @param inSize - Ожидаемый размер сообщения
+     */
+    void reserve(const std::size_t inSize);
+
+    /**
+     * @brief append - Метод допишет данные в конец сообщения
+     * @param inData - Дописываемые данные
+     */
+    void append(const FrameView inData);
+
+    /**
+     * @brief push_back - Метод допишет байт в конец сообщения
+     * @param inByte - Дописываемый байт
+     */
+    void push_back(const char inByte);
+
+    /**
+     * @brief extend - Метод увеличит сообщение и вернёт указатель на добавленные байты для заполнения
+     * Указатели, полученные ранее, после вызова становятся недействительными.
+     * @param inSize - Количество добавляемых байт
+     * @return Вернёт указатель на первый добавленный байт
+     */
+    char* extend(const std::size_t inSize);
+
+    /**
+     * @brief consume - Метод отбросит байты из начала сообщения без сдвига данных
+     * @param inSize - Количество отбрасываемых байт (ограничивается размером сообщения)
+     */
+    void consume(const std::size_t inSize);
+
+    /**
+     * @brief truncate - Метод укоротит сообщение до указанного размера
+     * @param inSize - Новый размер сообщения (не больше текущего)
+     */
+    void truncate(const std::size_t inSize);
+
+    /**
+     * @brief clear - Метод очистит сообщение, сохранив выделенную память
+     */
+    void clear();
+
+    /**
+     * @brief data - Метод вернёт указатель на начало сообщения
+     * @return Вернёт указатель на данные
+     */
+    const char* data() const;
+
+    /**
+     * @brief data - Метод вернёт указатель на начало сообщения
+     * @return Вернёт указатель на данные
+     */
+    char* data();
+
+    /**
+     * @brief size - Метод вернёт размер сообщения
+     * @return Вернёт размер сообщения
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief empty - Метод вернёт признак пустого сообщения
+     * @return Вернёт признак пустого сообщения
+     */
+    bool empty() const;
+
+    /**
+     * @brief capacity - Метод вернёт ёмкость буфера (без учёта отброшенного начала)
+     * @return Вернёт ёмкость буфера
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief view - Метод вернёт представление всего сообщения
+     * @return Вернёт представление (действительно до изменения буфера)
+     */
+    FrameView view() const;
+
+    /**
+     * @brief view - Метод вернёт представление части сообщения без копирования
+     * @param inOffset - Смещение начала части (ограничивается размером сообщения)
+     * @param inLength - Длина части (ограничивается остатком сообщения)
+     * @return Вернёт представление (действительно до изменения буфера)
+     */
+    FrameView view(const std::size_t inOffset, const std::size_t inLength) const;
+
+    /**
+     * @brief str - Метод вернёт копию сообщения в виде строки
+     * @return Вернёт строку
+     */
+    std::string str() const;
+
+private:
+
+    char m_inline[C_BYTE_BUFFER_INLINE_CAPACITY];           ///< Встроенное хранилище коротких сообщений
+    std::unique_ptr<char[]> m_heap = nullptr;               ///< Хранилище длинных сообщений
+    std::size_t m_capacity = C_BYTE_BUFFER_INLINE_CAPACITY; ///< Ёмкость используемого хранилища
+    std::size_t m_begin = 0;                                ///< Смещение начала сообщения
+    std::size_t m_end = 0;                                  ///< Смещение конца сообщения
+
+    /**
+     * @brief storage - Метод вернёт используемое хранилище
+     * @return Вернёт указатель на начало хранилища
+     */
+    char* storage();
+
+    /**
+     * @brief storage - Метод вернёт используемое хранилище
+     * @return Вернёт указатель на начало хранилища
+     */
+    const char* storage() const;
+
+    /**
+     * @brief ensureTail - Метод обеспечит свободное место в конце сообщения
+     * Отброшенное начало переиспользуется сдвигом, хранилище расширяется только при нехватке места.
+     * @param inSize - Требуемое количество байт
+     */
+    void ensureTail(const std::size_t inSize);
+
+    /**
+     * @brief take - Метод заберёт данные перемещаемого буфера и опустошит его
+     * @param ioOther - Перемещаемый буфер
+     */
+    void take(HMByteBuffer& ioOther);
+
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMBYTEBUFFER_H
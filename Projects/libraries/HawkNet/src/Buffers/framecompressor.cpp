@@ -0,0 +1,165 @@
+#include "framecompressor.h"
+
+#include <algorithm>
+
+#include <neterrorcategory.h>
+
+#if defined(HAWKNET_USE_ZLIB)
+#include <zlib.h>
+#else
+struct z_stream_s {}; // Без zlib состояние никогда не создаётся
+#endif
+
+using namespace net;
+
+// Конструкторы и деструкторы определены здесь: состояние zlib вне этой единицы трансляции не описано
+//-----------------------------------------------------------------------------
+HMFrameDeflater::HMFrameDeflater() = default;
+//-----------------------------------------------------------------------------
+HMFrameDeflater::~HMFrameDeflater()
+{
+    reset();
+}
+//-----------------------------------------------------------------------------
+bool HMFrameDeflater::isSupported()
+{
+#if defined(HAWKNET_USE_ZLIB)
+    return true;
+#else
+    return false;
+#endif
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMFrameDeflater::compress(const FrameView inData, const int inLevel, HMByteBuffer& outData)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    outData.clear();
+
+#if defined(HAWKNET_USE_ZLIB)
+    if (!m_stream) // Начинаем новый сеанс с пустым окном
+    {
+        m_stream = std::make_unique<z_stream_s>();
+
+        // Отрицательная разрядность окна - поток raw deflate без заголовка и контрольной суммы zlib
+        if (deflateInit2(m_stream.get(), std::clamp(inLevel, 1, 9), Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            m_stream = nullptr;
+            Error = make_error_code(errors::eNetError::neCompressionError);
+        }
+    }
+
+    if (!Error)
+    {
+        z_stream_s& Stream = *m_stream;
+        Stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(inData.data()));
+        Stream.avail_in = static_cast<uInt>(inData.size());
+
+        // Оценка покрывает несжимаемые данные, поэтому обычно хватает одного прохода
+        std::size_t Chunk = deflateBound(&Stream, static_cast<uLong>(inData.size())) + 16;
+        bool Flushed = false;
+
+        while (!Error && !Flushed)
+        {
+            Stream.next_out = reinterpret_cast<Bytef*>(outData.extend(Chunk));
+            Stream.avail_out = static_cast<uInt>(Chunk);
+
+            const int Status = deflate(&Stream, Z_SYNC_FLUSH); // Кадр завершается на границе байта, окно сохраняется
+            outData.truncate(outData.size() - Stream.avail_out);
+
+            if (Status != Z_OK && Status != Z_BUF_ERROR)
+                Error = make_error_code(errors::eNetError::neCompressionError);
+            else
+                Flushed = Stream.avail_out != 0; // Свободное место осталось - всё сжатое выдано
+        }
+    }
+#else
+    (void)inData;
+    (void)inLevel;
+    Error = make_error_code(errors::eNetError::neCompressionError);
+#endif
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMFrameDeflater::reset()
+{
+#if defined(HAWKNET_USE_ZLIB)
+    if (m_stream)
+        deflateEnd(m_stream.get());
+#endif
+
+    m_stream = nullptr;
+}
+//-----------------------------------------------------------------------------
+HMFrameInflater::HMFrameInflater() = default;
+//-----------------------------------------------------------------------------
+HMFrameInflater::~HMFrameInflater()
+{
+    reset();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMFrameInflater::decompress(const FrameView inData, const std::size_t inLimit, HMByteBuffer& outData)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    outData.clear();
+
+#if defined(HAWKNET_USE_ZLIB)
+    if (!m_stream) // Начинаем новый сеанс с пустым окном
+    {
+        m_stream = std::make_unique<z_stream_s>();
+
+        if (inflateInit2(m_stream.get(), -MAX_WBITS) != Z_OK)
+        {
+            m_stream = nullptr;
+            Error = make_error_code(errors::eNetError::neCompressionError);
+        }
+    }
+
+    if (!Error)
+    {
+        z_stream_s& Stream = *m_stream;
+        Stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(inData.data()));
+        Stream.avail_in = static_cast<uInt>(inData.size());
+
+        std::size_t Chunk = std::max<std::size_t>(inData.size() * 4, 4096); // Текст и разметка обычно сжимаются в 3-5 раз
+        bool Finished = false;
+
+        while (!Error && !Finished)
+        {
+            Chunk = std::min(Chunk, inLimit - outData.size() + 1); // Лишний байт обнаруживает превышение предела
+
+            Stream.next_out = reinterpret_cast<Bytef*>(outData.extend(Chunk));
+            Stream.avail_out = static_cast<uInt>(Chunk);
+
+            const int Status = inflate(&Stream, Z_SYNC_FLUSH);
+            outData.truncate(outData.size() - Stream.avail_out);
+
+            if (Status != Z_OK && Status != Z_BUF_ERROR) // Повреждённый поток или завершённый партнёром сеанс
+                Error = make_error_code(errors::eNetError::neCompressionError);
+            else if (outData.size() > inLimit)
+                Error = make_error_code(errors::eNetError::neFrameTooLarge);
+            else
+                Finished = Stream.avail_in == 0 && Stream.avail_out != 0; // Вход исчерпан и распакованное выдано целиком
+
+            Chunk *= 2;
+        }
+    }
+#else
+    (void)inData;
+    (void)inLimit;
+    Error = make_error_code(errors::eNetError::neCompressionError);
+#endif
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMFrameInflater::reset()
+{
+#if defined(HAWKNET_USE_ZLIB)
+    if (m_stream)
+        inflateEnd(m_stream.get());
+#endif
+
+    m_stream = nullptr;
+}
+//-----------------------------------------------------------------------------
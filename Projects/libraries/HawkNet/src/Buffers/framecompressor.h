@@ -0,0 +1,116 @@
+#ifndef HMFRAMECOMPRESSOR_H
+#define HMFRAMECOMPRESSOR_H
+
+/**
+ * @file framecompressor.h
+ * @brief Содержит описание сжатия и распаковки полезной нагрузки кадров
+ */
+
+#include <memory>
+#include <cstddef>
+
+#include <HawkCommon.h>
+#include <errorcode.h>
+
+#include "nettypes.h"
+#include "Buffers/bytebuffer.h"
+
+struct z_stream_s; // Состояние потока zlib (zlib.h подключается только реализацией)
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMFrameDeflater class - Класс, сжимающий полезную нагрузку отправляемых кадров
+ * Все кадры сеанса сжимаются одним потоком raw deflate, завершаемым Z_SYNC_FLUSH после каждого кадра:
+ * окно (словарь) переходит от кадра к кадру, а каждый кадр распаковывается сразу после приёма.
+ * Кадры должны распаковываться партнёром в порядке сжатия. Состояние (около 256 КБ)
+ * выделяется при первом сжатии и освобождается сбросом.
+ *
+ * Сжатие доступно, если библиотека собрана с zlib (HAWKNET_USE_ZLIB).
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMFrameDeflater : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMFrameDeflater - Конструктор по умолчанию
+     */
+    HMFrameDeflater();
+
+    /**
+     * @brief ~HMFrameDeflater - Виртуальный деструктор
+     */
+    virtual ~HMFrameDeflater() override;
+
+    /**
+     * @brief isSupported - Метод вернёт признак того, что библиотека собрана со сжатием
+     * @return Вернёт признак поддержки сжатия
+     */
+    static bool isSupported();
+
+    /**
+     * @brief compress - Метод сожмёт полезную нагрузку очередного кадра сеанса
+     * @param inData - Сжимаемые данные
+     * @param inLevel - Уровень сжатия (применяется при начале сеанса)
+     * @param outData - Сжатые данные (прежнее содержимое отбрасывается, память переиспользуется)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code compress(const FrameView inData, const int inLevel, HMByteBuffer& outData);
+
+    /**
+     * @brief reset - Метод завершит сеанс сжатия (следующий кадр начнёт сеанс с пустым окном)
+     */
+    void reset();
+
+private:
+
+    std::unique_ptr<z_stream_s> m_stream; ///< Состояние сеанса сжатия
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMFrameInflater class - Класс, распаковывающий полезную нагрузку принятых кадров
+ * Парный HMFrameDeflater: кадры сеанса распаковываются одним потоком в порядке приёма.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMFrameInflater : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMFrameInflater - Конструктор по умолчанию
+     */
+    HMFrameInflater();
+
+    /**
+     * @brief ~HMFrameInflater - Виртуальный деструктор
+     */
+    virtual ~HMFrameInflater() override;
+
+    /**
+     * @brief decompress - Метод распакует полезную нагрузку очередного кадра сеанса
+     * @param inData - Сжатые данные
+     * @param inLimit - Предельный размер распакованных данных (защита от "бомб" сжатия)
+     * @param outData - Распакованные данные (прежнее содержимое отбрасывается, память переиспользуется)
+     * @return Вернёт признак ошибки (после ошибки сеанс требует сброса)
+     */
+    errors::error_code decompress(const FrameView inData, const std::size_t inLimit, HMByteBuffer& outData);
+
+    /**
+     * @brief reset - Метод завершит сеанс распаковки
+     */
+    void reset();
+
+private:
+
+    std::unique_ptr<z_stream_s> m_stream; ///< Состояние сеанса распаковки
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMFRAMECOMPRESSOR_H
@@ -0,0 +1,75 @@
+#include "receivebuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMReceiveBuffer::HMReceiveBuffer(const std::size_t inCapacity) : hmcommon::HMNotCopyable(),
+    m_storage(std::max<std::size_t>(inCapacity, 1))
+{
+
+}
+//-----------------------------------------------------------------------------
+char* HMReceiveBuffer::prepare(const std::size_t inSize)
+{
+    if (m_storage.size() - m_writePos < inSize) // В хвосте не хватает места
+    {
+        const std::size_t Pending = size();
+
+        if (m_readPos != 0) // Сдвигаем необработанный остаток (как правило, неполный кадр) в начало
+        {
+            std::memmove(m_storage.data(), m_storage.data() + m_readPos, Pending);
+            m_readPos = 0;
+            m_writePos = Pending;
+        }
+
+        if (m_storage.size() - m_writePos < inSize) // Места всё ещё не хватает, расширяем буфер
+            m_storage.resize(std::max(m_storage.size() * 2, m_writePos + inSize));
+    }
+
+    return m_storage.data() + m_writePos;
+}
+//-----------------------------------------------------------------------------
+void HMReceiveBuffer::commit(const std::size_t inSize)
+{
+    assert(m_writePos + inSize <= m_storage.size()); // Записывать можно только в подготовленное место
+    m_writePos += inSize;
+}
+//-----------------------------------------------------------------------------
+void HMReceiveBuffer::consume(const std::size_t inSize)
+{
+    m_readPos += std::min(inSize, size());
+
+    if (m_readPos == m_writePos) // Всё обработано, следующая запись начнётся с начала без сдвига
+        clear();
+}
+//-----------------------------------------------------------------------------
+void HMReceiveBuffer::clear()
+{
+    m_readPos = 0;
+    m_writePos = 0;
+}
+//-----------------------------------------------------------------------------
+const char* HMReceiveBuffer::data() const
+{
+    return m_storage.data() + m_readPos;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMReceiveBuffer::size() const
+{
+    return m_writePos - m_readPos;
+}
+//-----------------------------------------------------------------------------
+bool HMReceiveBuffer::empty() const
+{
+    return m_readPos == m_writePos;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMReceiveBuffer::capacity() const
+{
+    return m_storage.size();
+}
+//-----------------------------------------------------------------------------
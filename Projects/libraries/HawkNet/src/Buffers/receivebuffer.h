@@ -0,0 +1,102 @@
+#ifndef HMRECEIVEBUFFER_H
+#define HMRECEIVEBUFFER_H
+
+/**
+ * @file receivebuffer.h
+ * @brief Содержит описание буфера приёма данных
+ */
+
+#include <vector>
+#include <cstddef>
+
+#include <HawkCommon.h>
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+constexpr std::size_t C_RECEIVE_BUFFER_INITIAL_CAPACITY = 16 * 1024; ///< Начальная ёмкость буфера приёма (16 КБ)
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMReceiveBuffer class - Класс, описывающий буфер приёма с потреблением по смещению
+ * Данные читаются из сокета прямо в свободный хвост буфера, а обработанные кадры отбрасываются
+ * сдвигом смещения чтения. Сдвиг остатка в начало выполняется только при нехватке места в хвосте,
+ * поэтому пачка из K кадров обрабатывается без перераспределений и копирования принятых данных.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMReceiveBuffer : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMReceiveBuffer - Инициализирующий конструктор
+     * @param inCapacity - Начальная ёмкость буфера
+     */
+    HMReceiveBuffer(const std::size_t inCapacity = C_RECEIVE_BUFFER_INITIAL_CAPACITY);
+
+    /**
+     * @brief ~HMReceiveBuffer - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMReceiveBuffer() override = default;
+
+    /**
+     * @brief prepare - Метод подготовит место под запись и вернёт указатель на него
+     * Указатели, полученные от data(), после вызова становятся недействительными.
+     * @param inSize - Требуемое количество байт
+     * @return Вернёт указатель на начало свободного места (не менее inSize байт)
+     */
+    char* prepare(const std::size_t inSize);
+
+    /**
+     * @brief commit - Метод отметит записанные в подготовленное место байты как принятые
+     * @param inSize - Количество записанных байт
+     */
+    void commit(const std::size_t inSize);
+
+    /**
+     * @brief consume - Метод отбросит обработанные байты из начала буфера
+     * @param inSize - Количество обработанных байт (ограничивается размером необработанных данных)
+     */
+    void consume(const std::size_t inSize);
+
+    /**
+     * @brief clear - Метод очистит буфер, сохранив выделенную память
+     */
+    void clear();
+
+    /**
+     * @brief data - Метод вернёт указатель на начало необработанных данных
+     * @return Вернёт указатель на данные
+     */
+    const char* data() const;
+
+    /**
+     * @brief size - Метод вернёт количество необработанных байт
+     * @return Вернёт количество байт
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief empty - Метод вернёт признак отсутствия необработанных данных
+     * @return Вернёт признак пустого буфера
+     */
+    bool empty() const;
+
+    /**
+     * @brief capacity - Метод вернёт ёмкость буфера
+     * @return Вернёт ёмкость буфера
+     */
+    std::size_t capacity() const;
+
+private:
+
+    std::vector<char> m_storage;    ///< Хранилище данных
+    std::size_t m_readPos = 0;      ///< Смещение начала необработанных данных
+    std::size_t m_writePos = 0;     ///< Смещение конца принятых данных
+
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMRECEIVEBUFFER_H
@@ -0,0 +1,550 @@
+#include "clientmanager.h"
+
+#include <cassert>
+#include <algorithm>
+
+#include <neterrorcategory.h>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+HMClientManager::HMClientManager(ConnectionFactoryFn&& inFactory, const ConCallbacks& inCallbacks,
+                                 const std::size_t inConnections, const ReconnectSettings& inSettings) :
+    hmcommon::HMNotCopyable(),
+    m_factory(std::move(inFactory)),
+    m_callbacks(inCallbacks),
+    m_connectionsCount(std::max<std::size_t>(inConnections, 1)),
+    m_settings(inSettings),
+    m_random(std::random_device()())
+{
+    assert(m_factory != nullptr); // Без фабрики соединения не сформировать
+}
+//-----------------------------------------------------------------------------
+HMClientManager::~HMClientManager()
+{
+    stop(); // Соединения разрываются до освобождения менеджера, чьи калбеки они вызывают
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMClientManager::start()
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    std::lock_guard lg(m_defender);
+
+    if (!m_running)
+    {
+        // Соединения формируются один раз и переподключаются сами
+        for (std::size_t Index = m_slots.size(); Index < m_connectionsCount && !Error; ++Index)
+        {
+            ConCallbacks Callbacks = m_callbacks;
+            Callbacks.m_DisconnectCallBack = [this, Index](const std::size_t inSenderID) { onDisconnect(Index, inSenderID); };
+            Callbacks.m_ConnectCallBack = [this, Index](const errors::error_code inError, const std::size_t inSenderID) { onConnect(Index, inError, inSenderID); };
+
+            Slot NewSlot;
+            NewSlot.m_connection = m_factory(Callbacks);
+
+            if (!NewSlot.m_connection)
+                Error = make_error_code(errors::eNetError::neSocketNotInit);
+            else
+                m_slots.push_back(std::move(NewSlot));
+        }
+
+        if (Error)
+            m_slots.clear();
+        else
+        {
+            for (Slot& Current : m_slots) // Первая попытка - сразу
+            {
+                Current.m_connected = false;
+                Current.m_attempt = 0;
+                Current.m_retryAt = std::chrono::steady_clock::now();
+            }
+
+            m_running = true;
+            m_stopping = false;
+            m_thread = std::thread(&HMClientManager::run, this);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::stop()
+{
+    bool WasRunning = false;
+
+    {
+        std::lock_guard lg(m_defender);
+        WasRunning = m_running;
+        m_stopping = true;
+    }
+
+    if (WasRunning)
+    {
+        m_wakeup.notify_all();
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+        // Запросы, прерванные разрывом, при остановке не повторяются (см. onResponse)
+        for (Slot& Current : m_slots)
+            Current.m_connection->disconnect();
+
+        std::unordered_map<std::uint64_t, ManagedRequest> Requests;
+
+        {
+            std::lock_guard lg(m_defender);
+            Requests.swap(m_requests);
+            m_waiting.clear();
+            m_outbox.clear();
+            m_sends.clear();
+            m_sendBytes = 0;
+
+            for (Slot& Current : m_slots)
+                Current.m_connected = false;
+
+            m_running = false;
+        }
+
+        for (auto& Request : Requests)
+            Request.second.m_callback(make_error_code(errors::eNetError::neNotConnected), HMByteBuffer());
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMClientManager::isConnected() const
+{
+    return connectedCount() != 0;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMClientManager::connectedCount() const
+{
+    std::lock_guard lg(m_defender);
+
+    return static_cast<std::size_t>(std::count_if(m_slots.begin(), m_slots.end(), [](const Slot& inSlot)
+    { return inSlot.m_connected && inSlot.m_connection->isConnected(); }));
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMClientManager::send(HMByteBuffer&& inData)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    HMConnection* Connection = nullptr;
+    std::uint64_t Key = 0;
+
+    if (inData.size() > C_FRAME_MAX_LENGTH - C_REQUEST_ID_SIZE) // Длина с идентификатором не поместится в заголовок
+        Error = make_error_code(errors::eNetError::neFrameTooLarge);
+    else
+    {
+        std::lock_guard lg(m_defender);
+
+        if (!m_running)
+            Error = make_error_code(errors::eNetError::neNotConnected);
+        else if (m_sendBytes + inData.size() > m_settings.m_outboxLimit)
+            Error = make_error_code(errors::eNetError::neSendQueueFull);
+        else
+        {
+            Key = ++m_lastSendKey;
+            m_sendBytes += inData.size();
+            m_sends[Key] = std::move(inData); // Данные хранятся до подтверждения: их копия уходит при каждой отправке
+
+            if ((Connection = pick()) == nullptr) // Соединений нет, данные уйдут после подключения
+            {
+                m_outbox.push_back(Key);
+                m_wakeup.notify_one();
+            }
+        }
+    }
+
+    if (Connection)
+        transmit(Key, Connection);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMClientManager::request(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                            const std::chrono::milliseconds inTimeout)
+{
+    errors::error_code Error = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+    assert(inCallback != nullptr); // Обработчик ответа должен быть задан
+
+    HMConnection* Connection = nullptr;
+    std::uint64_t Key = 0;
+
+    if (inData.size() > C_FRAME_MAX_LENGTH - C_REQUEST_ID_SIZE) // Длина с идентификатором не поместится в заголовок
+        Error = make_error_code(errors::eNetError::neFrameTooLarge);
+    else
+    {
+        std::lock_guard lg(m_defender);
+
+        if (!m_running)
+            Error = make_error_code(errors::eNetError::neNotConnected);
+        else
+        {
+            Key = ++m_lastRequestKey;
+
+            ManagedRequest& Request = m_requests[Key];
+            Request.m_data = std::move(inData); // Данные хранятся до ответа: их копия уходит при каждой отправке
+            Request.m_callback = std::move(inCallback);
+            Request.m_deadline = std::chrono::steady_clock::now() + inTimeout;
+
+            if ((Connection = pick()) == nullptr) // Запрос уйдёт после подключения, срок отсчитывается уже сейчас
+            {
+                m_waiting.push_back(Key);
+                m_wakeup.notify_one();
+            }
+        }
+    }
+
+    if (Connection)
+        dispatch(Key, Connection);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::run()
+{
+    typedef std::chrono::steady_clock::time_point TimePoint;
+    std::unique_lock ul(m_defender);
+
+    while (!m_stopping)
+    {
+        const TimePoint Now = std::chrono::steady_clock::now();
+        TimePoint Wake = TimePoint::max();
+        std::vector<ResponseCallBackFn> Expired;
+
+        // Запросы, не дождавшиеся соединения, завершаются по сроку
+        for (auto It = m_waiting.begin(); It != m_waiting.end();)
+        {
+            auto Request = m_requests.find(*It);
+
+            if (Request == m_requests.end()) // Уже завершён
+                It = m_waiting.erase(It);
+            else if (Request->second.m_deadline <= Now)
+            {
+                Expired.push_back(std::move(Request->second.m_callback));
+                m_requests.erase(Request);
+                It = m_waiting.erase(It);
+            }
+            else
+            {
+                Wake = std::min(Wake, Request->second.m_deadline);
+                ++It;
+            }
+        }
+
+        // Ближайшее соединение, которому пора подключаться
+        auto Due = std::find_if(m_slots.begin(), m_slots.end(), [Now](const Slot& inSlot)
+        { return !inSlot.m_connected && inSlot.m_retryAt <= Now; });
+
+        for (const Slot& Current : m_slots)
+            if (!Current.m_connected)
+                Wake = std::min(Wake, Current.m_retryAt);
+
+        if (!Expired.empty()) // Обработчики вызываются без блокировки
+        {
+            ul.unlock();
+
+            for (ResponseCallBackFn& Callback : Expired)
+                Callback(make_error_code(errors::eNetError::neTimeOut), HMByteBuffer());
+
+            ul.lock();
+        }
+        else if ((!m_outbox.empty() || !m_waiting.empty()) && pick() != nullptr)
+            flush(ul);
+        else if (Due != m_slots.end())
+        {
+            Slot& Current = *Due;
+            Current.m_retryAt = TimePoint::max(); // Попытка идёт, её исход сообщит onConnect
+            HMConnection* Connection = Current.m_connection.get();
+
+            // Подключение лишь начинается: недоступный сервер не задерживает остальные соединения
+            ul.unlock();
+            const errors::error_code Error = Connection->connectAsync(m_settings.m_connectTimeout);
+            ul.lock();
+
+            if (Error && Current.m_retryAt == TimePoint::max()) // Попытка не началась, onConnect не будет вызван
+                Current.m_retryAt = std::chrono::steady_clock::now() + backoff(Current.m_attempt++);
+        }
+        else if (Wake == TimePoint::max())
+            m_wakeup.wait(ul);
+        else
+            m_wakeup.wait_until(ul, Wake);
+    }
+}
+//-----------------------------------------------------------------------------
+std::chrono::steady_clock::duration HMClientManager::backoff(const std::size_t inAttempt)
+{
+    // Предел удваивается с каждой попыткой, задержка выбирается случайно от нуля до предела ("full jitter")
+    std::chrono::milliseconds::rep Limit = std::max<std::chrono::milliseconds::rep>(m_settings.m_initialDelay.count(), 1);
+
+    for (std::size_t Attempt = 0; Attempt < inAttempt && Limit < m_settings.m_maxDelay.count(); ++Attempt)
+        Limit *= 2;
+
+    Limit = std::min(Limit, m_settings.m_maxDelay.count());
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> Distribution(0, std::max<std::chrono::milliseconds::rep>(Limit, 0));
+
+    return std::chrono::milliseconds(Distribution(m_random));
+}
+//-----------------------------------------------------------------------------
+HMConnection* HMClientManager::pick()
+{
+    HMConnection* Result = nullptr;
+
+    for (std::size_t Index = 0; Index < m_slots.size() && !Result; ++Index)
+    {
+        const std::size_t SlotIndex = (m_nextSlot + Index) % m_slots.size();
+        const Slot& Current = m_slots[SlotIndex];
+
+        if (Current.m_connected && Current.m_connection->isConnected())
+        {
+            Result = Current.m_connection.get();
+            m_nextSlot = SlotIndex + 1; // Следующая отправка уйдёт через другое соединение
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::flush(std::unique_lock<std::mutex>& inLock)
+{
+    std::deque<std::uint64_t> Outbox;
+    std::deque<std::uint64_t> Waiting;
+
+    Outbox.swap(m_outbox);
+    Waiting.swap(m_waiting);
+
+    HMConnection* Connection = nullptr;
+
+    while (!Outbox.empty() && (Connection = pick()) != nullptr)
+    {
+        const std::uint64_t Key = Outbox.front();
+        Outbox.pop_front();
+
+        inLock.unlock();
+        transmit(Key, Connection);
+        inLock.lock();
+    }
+
+    while (!Waiting.empty() && (Connection = pick()) != nullptr)
+    {
+        const std::uint64_t Key = Waiting.front();
+        Waiting.pop_front();
+
+        inLock.unlock();
+        dispatch(Key, Connection);
+        inLock.lock();
+    }
+
+    // Неотправленное возвращается в начало очередей, сохраняя порядок
+    m_outbox.insert(m_outbox.begin(), Outbox.begin(), Outbox.end());
+    m_waiting.insert(m_waiting.begin(), Waiting.begin(), Waiting.end());
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::transmit(const std::uint64_t inKey, HMConnection* inConnection)
+{
+    assert(inConnection != nullptr);
+
+    bool Found = false;
+    HMByteBuffer Data;
+
+    {
+        std::lock_guard lg(m_defender);
+        auto It = m_sends.find(inKey);
+
+        if (It != m_sends.end())
+        {
+            Found = true;
+            Data = HMByteBuffer(It->second.view()); // Исходные данные остаются для повтора
+        }
+    }
+
+    if (Found)
+    {
+        const errors::error_code Error = inConnection->sendAcked(std::move(Data),
+            [this, inKey](const errors::error_code inError, HMByteBuffer&&) { onAck(inKey, inError); },
+            m_settings.m_ackTimeout);
+
+        if (Error == make_error_code(errors::eNetError::neNotConnected)) // Соединение разорвано до отправки
+        {
+            std::lock_guard lg(m_defender);
+            m_outbox.push_back(inKey);
+            m_wakeup.notify_one();
+        }
+        else if (Error) // Данные отклонены соединением, повтор не поможет
+        {
+            {
+                std::lock_guard lg(m_defender);
+                auto It = m_sends.find(inKey);
+
+                if (It != m_sends.end())
+                {
+                    m_sendBytes -= It->second.size();
+                    m_sends.erase(It);
+                }
+            }
+
+            if (m_callbacks.m_ErrorCallBack)
+                m_callbacks.m_ErrorCallBack(Error, 0);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::onAck(const std::uint64_t inKey, const errors::error_code inError)
+{
+    std::lock_guard lg(m_defender);
+    auto It = m_sends.find(inKey);
+
+    if (It != m_sends.end())
+    {
+        if (inError && m_running && !m_stopping) // Повтор через следующее установленное соединение
+        {
+            m_outbox.push_back(inKey);
+            m_wakeup.notify_one();
+        }
+        else
+        {
+            m_sendBytes -= It->second.size();
+            m_sends.erase(It);
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::dispatch(const std::uint64_t inKey, HMConnection* inConnection)
+{
+    assert(inConnection != nullptr);
+
+    bool Found = false;
+    HMByteBuffer Data;
+    std::chrono::milliseconds Remaining { 0 };
+
+    {
+        std::lock_guard lg(m_defender);
+        auto It = m_requests.find(inKey);
+
+        if (It != m_requests.end())
+        {
+            Found = true;
+            Data = HMByteBuffer(It->second.m_data.view()); // Исходные данные остаются для повтора
+            Remaining = std::chrono::ceil<std::chrono::milliseconds>(It->second.m_deadline - std::chrono::steady_clock::now());
+        }
+    }
+
+    if (Found)
+    {
+        if (Remaining.count() <= 0)
+            complete(inKey, make_error_code(errors::eNetError::neTimeOut), HMByteBuffer());
+        else
+        {
+            const errors::error_code Error = inConnection->request(std::move(Data),
+                [this, inKey](const errors::error_code inError, HMByteBuffer&& inData) { onResponse(inKey, inError, std::move(inData)); },
+                Remaining);
+
+            if (Error == make_error_code(errors::eNetError::neNotConnected)) // Соединение разорвано до отправки
+            {
+                std::lock_guard lg(m_defender);
+                m_waiting.push_back(inKey);
+                m_wakeup.notify_one();
+            }
+            else if (Error)
+                complete(inKey, Error, HMByteBuffer());
+        }
+    }
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::complete(const std::uint64_t inKey, const errors::error_code inError, HMByteBuffer&& inData)
+{
+    ResponseCallBackFn Callback = nullptr;
+
+    {
+        std::lock_guard lg(m_defender);
+        auto It = m_requests.find(inKey);
+
+        if (It != m_requests.end())
+        {
+            Callback = std::move(It->second.m_callback);
+            m_requests.erase(It);
+        }
+    }
+
+    if (Callback) // Обработчик вызывается без блокировки: он может отправить новый запрос
+        Callback(inError, std::move(inData));
+}
+//-----------------------------------------------------------------------------
+
+// ===================
+// Обработчики эвентов
+// ===================
+
+//-----------------------------------------------------------------------------
+void HMClientManager::onResponse(const std::uint64_t inKey, const errors::error_code inError, HMByteBuffer&& inData)
+{
+    bool Retry = false;
+
+    if (inError == make_error_code(errors::eNetError::neNotConnected)) // Ответ не придёт: соединение разорвано
+    {
+        std::lock_guard lg(m_defender);
+        auto It = m_requests.find(inKey);
+
+        if (It != m_requests.end() && !m_stopping && It->second.m_deadline > std::chrono::steady_clock::now())
+        {
+            m_waiting.push_back(inKey); // Повторим через следующее соединение
+            m_wakeup.notify_one();
+            Retry = true;
+        }
+    }
+
+    if (!Retry)
+        complete(inKey, inError, std::move(inData));
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::onConnect(const std::size_t inSlot, const errors::error_code inError, const std::size_t inSenderID)
+{
+    HMConnection* Orphan = nullptr; // Соединение, подключившееся после остановки менеджера
+
+    {
+        std::lock_guard lg(m_defender);
+        Slot& Current = m_slots[inSlot];
+
+        if (!m_running || m_stopping) // Подключение, поставленное в очередь потока Qt, могло завершиться после остановки
+            Orphan = (inError) ? nullptr : Current.m_connection.get();
+        else
+        {
+            if (!inError)
+            {
+                Current.m_connected = true;
+                Current.m_attempt = 0;
+            }
+            else
+                Current.m_retryAt = std::chrono::steady_clock::now() + backoff(Current.m_attempt++);
+
+            m_wakeup.notify_one(); // Накопленное уйдёт через новое соединение
+        }
+    }
+
+    if (Orphan)
+        Orphan->disconnect();
+
+    if (m_callbacks.m_ConnectCallBack)
+        m_callbacks.m_ConnectCallBack(inError, inSenderID);
+}
+//-----------------------------------------------------------------------------
+void HMClientManager::onDisconnect(const std::size_t inSlot, const std::size_t inSenderID)
+{
+    {
+        std::lock_guard lg(m_defender);
+
+        if (m_running && !m_stopping)
+        {
+            Slot& Current = m_slots[inSlot];
+
+            if (Current.m_connected) // Неудавшееся подключение переназначает onConnect
+            {
+                Current.m_connected = false;
+                Current.m_retryAt = std::chrono::steady_clock::now() + backoff(Current.m_attempt++);
+                m_wakeup.notify_one();
+            }
+        }
+    }
+
+    if (m_callbacks.m_DisconnectCallBack)
+        m_callbacks.m_DisconnectCallBack(inSenderID);
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,249 @@
+#ifndef HMCLIENTMANAGER_H
+#define HMCLIENTMANAGER_H
+
+/**
+ * @file clientmanager.h
+ * @brief Содержит описание менеджера клиентских соединений с автоматическим переподключением
+ */
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+#include <HawkCommon.h>
+#include <errorcode.h>
+
+#include "nettypes.h"
+#include "Interface/connection.h"
+#include "Async/Abstract/abstractasyncconnection.h"
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief ConnectionFactoryFn - Тип функции, формирующей клиентское соединение
+ * @param inCallbacks - Перечень калбеков, которые соединение должно вызывать
+ * @return Вернёт указатель на интерфейс соединения
+ */
+typedef std::function<std::unique_ptr<HMConnection>(const ConCallbacks& inCallbacks)> ConnectionFactoryFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMClientManager class - Класс, поддерживающий клиентские соединения с сервером
+ * Менеджер держит одно или несколько параллельных соединений (например, для объёмных медиаданных)
+ * и переподключает разорванные со случайной экспоненциальной задержкой (ReconnectSettings).
+ * Подключения начинает собственный поток менеджера, не дожидаясь их исхода (connectAsync),
+ * поэтому ни start, ни недоступный сервер одного из соединений не задерживают остальные.
+ *
+ * Отправки распределяются по установленным соединениям по кругу. Пока ни одно соединение не
+ * установлено, данные накапливаются и уходят после подключения.
+ * Данные send идут с подтверждением (sendAcked) и хранятся менеджером, пока сервер его не пришлёт:
+ * разорванная или не подтверждённая за m_ackTimeout отправка повторяется. Объём неподтверждённых
+ * данных ограничен m_outboxLimit. Доставка "хотя бы раз": сервер может получить данные повторно
+ * и не в порядке отправки.
+ * Запрос (request) считается подтверждённым ответом: если соединение разорвано раньше ответа,
+ * запрос повторяется после переподключения, пока не истечёт его срок. Поэтому сервер может
+ * получить запрос повторно.
+ *
+ * Подходят все реализации соединений. Соединения Qt сами переносят подключение и запись в поток,
+ * которому принадлежат, поэтому потоку, вызывающему фабрику, нужен цикл событий Qt.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMClientManager : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMClientManager - Инициализирующий конструктор
+     * @param inFactory - Функция, формирующая соединения
+     * @param inCallbacks - Перечень калбеков соединений
+     * @param inConnections - Количество параллельных соединений
+     * @param inSettings - Настройки переподключения
+     */
+    HMClientManager(ConnectionFactoryFn&& inFactory, const ConCallbacks& inCallbacks,
+                    const std::size_t inConnections = 1, const ReconnectSettings& inSettings = ReconnectSettings());
+
+    /**
+     * @brief ~HMClientManager - Виртуальный деструктор
+     */
+    virtual ~HMClientManager() override;
+
+    /**
+     * @brief start - Метод начнёт подключение соединений, не дожидаясь его
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code start();
+
+    /**
+     * @brief stop - Метод разорвёт соединения и прекратит переподключение
+     * Ожидающие запросы завершаются ошибкой neNotConnected, неподтверждённые данные отбрасываются.
+     * Идущие попытки подключения прерываются.
+     */
+    void stop();
+
+    /**
+     * @brief isConnected - Метод вернёт признак наличия установленного соединения
+     * @return Вернёт признак наличия установленного соединения
+     */
+    bool isConnected() const;
+
+    /**
+     * @brief connectedCount - Метод вернёт количество установленных соединений
+     * @return Вернёт количество установленных соединений
+     */
+    std::size_t connectedCount() const;
+
+    /**
+     * @brief send - Метод отправит данные через одно из соединений и повторит отправку до подтверждения
+     * @param inData - Отправляемые данные
+     * @return Вернёт признак ошибки (neSendQueueFull, если неподтверждённых данных накоплено слишком много)
+     */
+    errors::error_code send(HMByteBuffer&& inData);
+
+    /**
+     * @brief request - Метод отправит запрос, который будет повторён после переподключения до получения ответа
+     * @param inData - Данные запроса
+     * @param inCallback - Обработчик ответа (вызывается ровно один раз, если запрос принят)
+     * @param inTimeout - Время ожидания ответа с учётом повторов
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    errors::error_code request(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                               const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT);
+
+private:
+
+    /**
+     * @brief The Slot struct - Структура, описывающая одно из соединений менеджера
+     */
+    struct Slot
+    {
+        std::unique_ptr<HMConnection> m_connection = nullptr;   ///< Соединение
+        bool m_connected = false;                               ///< Признак установленного соединения
+        std::size_t m_attempt = 0;                              ///< Количество неудачных попыток подряд
+        std::chrono::steady_clock::time_point m_retryAt;        ///< Момент следующей попытки (max - попытка идёт или соединение установлено)
+    };
+
+    /**
+     * @brief The ManagedRequest struct - Структура, описывающая запрос, ожидающий ответа
+     */
+    struct ManagedRequest
+    {
+        HMByteBuffer m_data;                                ///< Данные запроса (для повтора)
+        ResponseCallBackFn m_callback = nullptr;            ///< Обработчик ответа
+        std::chrono::steady_clock::time_point m_deadline;   ///< Срок ожидания ответа
+    };
+
+    ConnectionFactoryFn m_factory = nullptr;    ///< Функция, формирующая соединения
+    ConCallbacks m_callbacks;                   ///< Калбеки пользователя
+    const std::size_t m_connectionsCount;       ///< Количество параллельных соединений
+    const ReconnectSettings m_settings;         ///< Настройки переподключения
+
+    mutable std::mutex m_defender;              ///< Мьютекс, защищающий состояние менеджера
+    std::condition_variable m_wakeup;           ///< Условие пробуждения потока менеджера
+    std::thread m_thread;                       ///< Поток подключения
+    bool m_running = false;                     ///< Признак запущенного менеджера
+    bool m_stopping = false;                    ///< Признак остановки менеджера
+
+    std::vector<Slot> m_slots;                  ///< Соединения
+    std::size_t m_nextSlot = 0;                 ///< Соединение для следующей отправки
+    std::mt19937 m_random;                      ///< Генератор разброса задержек
+
+    std::uint64_t m_lastSendKey = 0;            ///< Последний выданный ключ отправки
+    std::unordered_map<std::uint64_t, HMByteBuffer> m_sends; ///< Данные, ожидающие подтверждения
+    std::size_t m_sendBytes = 0;                ///< Объём неподтверждённых данных
+    std::deque<std::uint64_t> m_outbox;         ///< Ключи отправок, ожидающих соединения
+    std::uint64_t m_lastRequestKey = 0;         ///< Последний выданный ключ запроса
+    std::unordered_map<std::uint64_t, ManagedRequest> m_requests; ///< Запросы, ожидающие ответа
+    std::deque<std::uint64_t> m_waiting;        ///< Ключи запросов, ожидающих соединения
+
+    /**
+     * @brief run - Метод потока менеджера: подключает соединения и отправляет накопленное
+     */
+    void run();
+
+    /**
+     * @brief backoff - Метод выберет задержку очередной попытки подключения (под m_defender)
+     * @param inAttempt - Номер попытки (с нуля)
+     * @return Вернёт случайную задержку от нуля до предела попытки
+     */
+    std::chrono::steady_clock::duration backoff(const std::size_t inAttempt);
+
+    /**
+     * @brief pick - Метод выберет установленное соединение для отправки (под m_defender)
+     * @return Вернёт соединение или nullptr
+     */
+    HMConnection* pick();
+
+    /**
+     * @brief flush - Метод отправит ожидающие соединения данные и запросы
+     * @param inLock - Удерживаемая блокировка m_defender (на время отправки снимается)
+     */
+    void flush(std::unique_lock<std::mutex>& inLock);
+
+    /**
+     * @brief transmit - Метод отправит данные через соединение с ожиданием подтверждения
+     * @param inKey - Ключ отправки
+     * @param inConnection - Соединение
+     */
+    void transmit(const std::uint64_t inKey, HMConnection* inConnection);
+
+    /**
+     * @brief onAck - Метод обработает подтверждение отправки соединением
+     * Отправка, прерванная разрывом или не подтверждённая в срок, ожидает повтора.
+     * @param inKey - Ключ отправки
+     * @param inError - Признак ошибки
+     */
+    void onAck(const std::uint64_t inKey, const errors::error_code inError);
+
+    /**
+     * @brief dispatch - Метод отправит запрос через соединение
+     * @param inKey - Ключ запроса
+     * @param inConnection - Соединение
+     */
+    void dispatch(const std::uint64_t inKey, HMConnection* inConnection);
+
+    /**
+     * @brief complete - Метод завершит запрос и вызовет его обработчик
+     * @param inKey - Ключ запроса
+     * @param inError - Признак ошибки
+     * @param inData - Данные ответа
+     */
+    void complete(const std::uint64_t inKey, const errors::error_code inError, HMByteBuffer&& inData);
+
+    /**
+     * @brief onResponse - Метод обработает завершение запроса соединением
+     * Запрос, прерванный разрывом, ожидает следующего соединения.
+     * @param inKey - Ключ запроса
+     * @param inError - Признак ошибки
+     * @param inData - Данные ответа
+     */
+    void onResponse(const std::uint64_t inKey, const errors::error_code inError, HMByteBuffer&& inData);
+
+    /**
+     * @brief onConnect - Метод обработает исход попытки подключения
+     * Неудавшаяся попытка назначает следующую со случайной задержкой.
+     * @param inSlot - Номер соединения
+     * @param inError - Признак ошибки подключения
+     * @param inSenderID - Идентификатор соединения
+     */
+    void onConnect(const std::size_t inSlot, const errors::error_code inError, const std::size_t inSenderID);
+
+    /**
+     * @brief onDisconnect - Метод запланирует переподключение разорванного соединения
+     * @param inSlot - Номер соединения
+     * @param inSenderID - Идентификатор соединения
+     */
+    void onDisconnect(const std::size_t inSlot, const std::size_t inSenderID);
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMCLIENTMANAGER_H
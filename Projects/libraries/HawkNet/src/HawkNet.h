@@ -6,13 +6,26 @@
 #include "nettypes.h"
 #include "netutils.h"
 
+#include "Buffers/bytebuffer.h"
+#include "Buffers/receivebuffer.h"
+
 #include "Interface/server.h"
 #include "Interface/connection.h"
 
+#include "Client/clientmanager.h"
+
 #include "Async/QtImplementation/Simple/qtsimpleasyncserver.h"
 #include "Async/QtImplementation/Simple/qtsimpleasyncconnection.h"
 
 #include "Async/QtImplementation/Ssl/qtsslasyncserver.h"
 #include "Async/QtImplementation/Ssl/qtsslasyncconnection.h"
 
+#if defined(__linux__)
+#include "Async/EpollImplementation/epollasyncserver.h"
+#include "Async/EpollImplementation/epollasyncconnection.h"
+#include "Async/UringImplementation/uringasyncserver.h"
+#include "Async/UringImplementation/uringasyncconnection.h"
+#include "Async/Posix/nativefactory.h"
+#endif
+
 #endif // HAWKNET_H
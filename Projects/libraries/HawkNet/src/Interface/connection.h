@@ -7,15 +7,24 @@
  */
 
 #include <chrono>
+#include <functional>
 
 #include <errorcode.h>
 #include <HawkCommon.h>
 
 #include "nettypes.h"
+#include "Buffers/bytebuffer.h"
 
 namespace net
 {
 //-----------------------------------------------------------------------------
+/**
+ * @brief ResponseCallBackFn - Тип функции, принимающей ответ на запрос
+ * @param inError - Признак ошибки (neTimeOut - ответ не пришёл в срок, neNotConnected - соединение разорвано)
+ * @param inData - Ответ (пуст при ошибке; обработчик может забрать буфер себе без копирования)
+ */
+typedef std::function<void(const errors::error_code inError, HMByteBuffer&& inData)> ResponseCallBackFn;
+//-----------------------------------------------------------------------------
 /**
  * @brief The HMConnection class - Интерфейс, описывающий соединение
  *
@@ -43,6 +52,14 @@ public:
      */
     virtual errors::error_code connect(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) = 0;
 
+    /**
+     * @brief connectAsync - Метод начнёт подключение, не дожидаясь его завершения
+     * Исход подключения передаётся обработчику ConCallbacks::m_ConnectCallBack в потоке соединения.
+     * @param inWaitTime - Время ожидания подключения (по его истечении обработчик получит neTimeOut)
+     * @return Вернёт признак ошибки начала подключения (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code connectAsync(const std::chrono::milliseconds inWaitTime = std::chrono::seconds(5)) = 0;
+
     /**
      * @brief isConnected - Метод вернёт состояние подключение
      * @return Вернёт состояние подключения
@@ -65,7 +82,109 @@ public:
      * @param inData - Отправлемые данные
      * @return Вернёт признак ошибки
      */
-    virtual errors::error_code send(oByteStream&& inData) = 0;
+    virtual errors::error_code send(HMByteBuffer&& inData) = 0;
+
+    /**
+     * @brief sendShared - Метод отправит разделяемые данные без копирования в очередь отправки
+     * @param inData - Отправлемые данные (не должны изменяться до завершения отправки)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code sendShared(const SharedPayload& inData) = 0;
+
+    /**
+     * @brief request - Метод отправит запрос, не дожидаясь ответов на предыдущие
+     * @param inData - Данные запроса
+     * @param inCallback - Обработчик ответа (вызывается ровно один раз, если запрос принят к отправке)
+     * @param inTimeout - Время ожидания ответа
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code request(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                       const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) = 0;
+
+    /**
+     * @brief sendAcked - Метод отправит данные, доставку которых подтвердит партнёр
+     * Партнёр передаёт данные обработчику данных, как и отправленные send, и подтверждает их после обработки.
+     * @param inData - Отправляемые данные
+     * @param inCallback - Обработчик подтверждения (вызывается ровно один раз, если данные приняты к отправке)
+     * @param inTimeout - Время ожидания подтверждения
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code sendAcked(HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                         const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) = 0;
+
+    /**
+     * @brief respond - Метод отправит ответ на запрос партнёра
+     * @param inRequestID - Идентификатор запроса, переданный обработчику запросов
+     * @param inData - Данные ответа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code respond(const std::uint32_t inRequestID, HMByteBuffer&& inData) = 0;
+
+    /**
+     * @brief setFramingMode - Метод задаст режим кадрирования отправляемых сообщений
+     * @param inMode - Режим кадрирования
+     */
+    virtual void setFramingMode(const eFramingMode inMode) = 0;
+
+    /**
+     * @brief framingMode - Метод вернёт текущий режим кадрирования отправляемых сообщений
+     * @return Вернёт режим кадрирования
+     */
+    virtual eFramingMode framingMode() const = 0;
+
+    /**
+     * @brief setSendQueueLimits - Метод задаст пределы очереди отправки
+     * @param inLimits - Пределы очереди и реакция на их превышение
+     */
+    virtual void setSendQueueLimits(const SendQueueLimits& inLimits) = 0;
+
+    /**
+     * @brief sendQueueLimits - Метод вернёт пределы очереди отправки
+     * @return Вернёт пределы очереди отправки
+     */
+    virtual SendQueueLimits sendQueueLimits() const = 0;
+
+    /**
+     * @brief setCompression - Метод задаст сжатие отправляемых кадров
+     * @param inSettings - Настройки сжатия
+     */
+    virtual void setCompression(const CompressionSettings& inSettings) = 0;
+
+    /**
+     * @brief compression - Метод вернёт настройки сжатия отправляемых кадров
+     * @return Вернёт настройки сжатия
+     */
+    virtual CompressionSettings compression() const = 0;
+
+    /**
+     * @brief setHeartbeat - Метод задаст проверку связи и разрыв по простою
+     * @param inSettings - Настройки проверки связи
+     */
+    virtual void setHeartbeat(const HeartbeatSettings& inSettings) = 0;
+
+    /**
+     * @brief heartbeat - Метод вернёт настройки проверки связи и разрыва по простою
+     * @return Вернёт настройки проверки связи
+     */
+    virtual HeartbeatSettings heartbeat() const = 0;
+
+    /**
+     * @brief setRateLimits - Метод задаст пределы частоты входящих кадров
+     * @param inLimits - Пределы частоты
+     */
+    virtual void setRateLimits(const RateLimits& inLimits) = 0;
+
+    /**
+     * @brief rateLimits - Метод вернёт пределы частоты входящих кадров
+     * @return Вернёт пределы частоты
+     */
+    virtual RateLimits rateLimits() const = 0;
+
+    /**
+     * @brief stats - Метод вернёт статистику соединения
+     * @return Вернёт статистику соединения
+     */
+    virtual ConnectionStats stats() const = 0;
 
 };
 //-----------------------------------------------------------------------------
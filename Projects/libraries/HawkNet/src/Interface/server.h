@@ -80,14 +80,34 @@ public:
      * @param inData - Отправляемые данные
      * @return Вернёт признак ошибки
      */
-    virtual errors::error_code send(const size_t inID, oByteStream&& inData) = 0;
+    virtual errors::error_code send(const size_t inID, HMByteBuffer&& inData) = 0;
 
     /**
      * @brief sendToAll - Метод отправит данные всем подключённым клиентам
      * @param inData - Отправляемые данные
      * @return Вернёт контейнер, хранящий список ошибок (ключём является идентификатор соединения)
      */
-    virtual std::map<std::size_t, errors::error_code> sendToAll(oByteStream&& inData) = 0;
+    virtual std::map<std::size_t, errors::error_code> sendToAll(HMByteBuffer&& inData) = 0;
+
+    /**
+     * @brief request - Метод отправит запрос клиенту с указанным идентификатором
+     * @param inID - Идентификатор клиента-получателя
+     * @param inData - Данные запроса
+     * @param inCallback - Обработчик ответа (вызывается ровно один раз, если запрос принят к отправке)
+     * @param inTimeout - Время ожидания ответа
+     * @return Вернёт признак ошибки (при ошибке обработчик не вызывается)
+     */
+    virtual errors::error_code request(const std::size_t inID, HMByteBuffer&& inData, ResponseCallBackFn&& inCallback,
+                                       const std::chrono::milliseconds inTimeout = C_REQUEST_TIMEOUT) = 0;
+
+    /**
+     * @brief respond - Метод отправит ответ на запрос клиента с указанным идентификатором
+     * @param inID - Идентификатор клиента, приславшего запрос
+     * @param inRequestID - Идентификатор запроса, переданный обработчику запросов
+     * @param inData - Данные ответа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code respond(const std::size_t inID, const std::uint32_t inRequestID, HMByteBuffer&& inData) = 0;
 
     /**
      * @brief closeConnection - Метод разорвёт соединение
@@ -100,6 +120,51 @@ public:
      */
     virtual void closeAllConnections() = 0;
 
+    /**
+     * @brief setSendQueueLimits - Метод задаст пределы очереди отправки подключённым и будущим соединениям
+     * @param inLimits - Пределы очереди и реакция на их превышение
+     */
+    virtual void setSendQueueLimits(const SendQueueLimits& inLimits) = 0;
+
+    /**
+     * @brief setCompression - Метод задаст сжатие отправляемых кадров подключённым и будущим соединениям
+     * @param inSettings - Настройки сжатия
+     */
+    virtual void setCompression(const CompressionSettings& inSettings) = 0;
+
+    /**
+     * @brief setHeartbeat - Метод задаст проверку связи и разрыв по простою подключённым и будущим соединениям
+     * @param inSettings - Настройки проверки связи
+     */
+    virtual void setHeartbeat(const HeartbeatSettings& inSettings) = 0;
+
+    /**
+     * @brief setRateLimits - Метод задаст пределы частоты входящих кадров подключённым и будущим соединениям
+     * Каждое соединение получает собственные вёдра: один клиент не расходует запас других.
+     * @param inLimits - Пределы частоты
+     */
+    virtual void setRateLimits(const RateLimits& inLimits) = 0;
+
+    /**
+     * @brief setAcceptLimits - Метод задаст предел частоты подключений к серверу
+     * @param inLimits - Предел частоты подключений
+     */
+    virtual void setAcceptLimits(const AcceptLimits& inLimits) = 0;
+
+    /**
+     * @brief stats - Метод вернёт статистику сервера
+     * @return Вернёт статистику сервера
+     */
+    virtual ServerStats stats() const = 0;
+
+    /**
+     * @brief connectionStats - Метод вернёт статистику соединения
+     * @param inID - Идентификатор соединения
+     * @param outStats - Статистика соединения
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code connectionStats(const std::size_t inID, ConnectionStats& outStats) const = 0;
+
 };
 //-----------------------------------------------------------------------------
 }
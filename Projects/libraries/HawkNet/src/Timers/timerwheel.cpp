@@ -0,0 +1,215 @@
+#include "timerwheel.h"
+
+#include <cassert>
+#include <algorithm>
+
+using namespace net;
+
+//-----------------------------------------------------------------------------
+// HMWheelTimer
+//-----------------------------------------------------------------------------
+HMWheelTimer::HMWheelTimer(TimerFn&& inCallback) :
+    hmcommon::HMNotCopyable(),
+    m_callback(std::move(inCallback))
+{
+
+}
+//-----------------------------------------------------------------------------
+HMWheelTimer::~HMWheelTimer()
+{
+    cancel();
+}
+//-----------------------------------------------------------------------------
+void HMWheelTimer::setCallback(TimerFn&& inCallback)
+{
+    m_callback = std::move(inCallback);
+}
+//-----------------------------------------------------------------------------
+bool HMWheelTimer::isScheduled() const
+{
+    return m_wheel != nullptr;
+}
+//-----------------------------------------------------------------------------
+void HMWheelTimer::cancel()
+{
+    if (m_wheel)
+    {
+        m_wheel->unlink(*this);
+        --m_wheel->m_size;
+        m_wheel = nullptr;
+    }
+}
+//-----------------------------------------------------------------------------
+// HMTimerWheel
+//-----------------------------------------------------------------------------
+HMTimerWheel::HMTimerWheel(const std::chrono::milliseconds inTick, const std::chrono::steady_clock::time_point inOrigin) :
+    hmcommon::HMNotCopyable(),
+    m_origin(inOrigin),
+    m_tick(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::max(inTick, std::chrono::milliseconds(1))))
+{
+
+}
+//-----------------------------------------------------------------------------
+HMTimerWheel::~HMTimerWheel()
+{
+    for (std::size_t Level = 0; Level < C_TIMER_WHEEL_LEVELS; ++Level)
+        for (std::size_t Slot = 0; Slot < C_TIMER_WHEEL_SLOTS; ++Slot)
+            while (m_slots[Level][Slot])
+                m_slots[Level][Slot]->cancel();
+}
+//-----------------------------------------------------------------------------
+void HMTimerWheel::schedule(HMWheelTimer& inTimer, const std::chrono::steady_clock::time_point inDeadline)
+{
+    assert(inTimer.m_wheel == nullptr || inTimer.m_wheel == this); // Таймер принадлежит потоку одного колеса
+
+    inTimer.cancel();
+
+    // Срок округляется до шага вверх: таймер не срабатывает раньше срока
+    std::uint64_t Expiry = 0;
+
+    if (inDeadline > m_origin)
+        Expiry = static_cast<std::uint64_t>((inDeadline - m_origin + m_tick - std::chrono::steady_clock::duration(1)) / m_tick);
+
+    inTimer.m_expiry = std::max(Expiry, m_now + 1); // Текущий шаг уже обработан
+    inTimer.m_wheel = this;
+    ++m_size;
+
+    link(inTimer);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMTimerWheel::advance(const std::chrono::steady_clock::time_point inNow)
+{
+    std::size_t Result = 0;
+    const std::uint64_t Target = (inNow > m_origin) ? static_cast<std::uint64_t>((inNow - m_origin) / m_tick) : 0;
+
+    while (m_now < Target)
+    {
+        if (m_size == 0) // Пустое колесо перескакивает сразу к текущему шагу
+        {
+            m_now = Target;
+            break;
+        }
+
+        ++m_now;
+
+        // Сначала переносятся верхние уровни: их таймеры могут попасть в переносимую ниже ячейку
+        for (std::size_t Level = C_TIMER_WHEEL_LEVELS - 1; Level > 0; --Level)
+        {
+            const std::size_t Shift = Level * C_TIMER_WHEEL_LEVEL_BITS;
+
+            if ((m_now & ((std::uint64_t(1) << Shift) - 1)) == 0) // Нижний уровень прошёл полный оборот
+                cascade(Level, (m_now >> Shift) & (C_TIMER_WHEEL_SLOTS - 1));
+        }
+
+        const std::size_t Slot = m_now & (C_TIMER_WHEEL_SLOTS - 1);
+
+        while (HMWheelTimer* Timer = m_slots[0][Slot]) // Обработчик может поставить и снять другие таймеры
+        {
+            Timer->cancel();
+            ++Result;
+
+            if (Timer->m_callback)
+                Timer->m_callback();
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::chrono::milliseconds HMTimerWheel::nextTimeout(const std::chrono::steady_clock::time_point inNow) const
+{
+    std::chrono::milliseconds Result { -1 };
+
+    if (m_size != 0)
+    {
+        bool Upper = false; // Таймеры верхних уровней требуют переноса на обороте нижнего
+        for (std::size_t Level = 1; Level < C_TIMER_WHEEL_LEVELS; ++Level)
+            Upper = Upper || m_occupied[Level] != 0;
+
+        std::uint64_t Next = m_now + C_TIMER_WHEEL_SLOTS; // Дальше оборота нижнего уровня искать не нужно
+
+        for (std::uint64_t Tick = m_now + 1; Tick < m_now + C_TIMER_WHEEL_SLOTS; ++Tick)
+        {
+            const std::size_t Slot = Tick & (C_TIMER_WHEEL_SLOTS - 1);
+
+            if ((m_occupied[0] & (std::uint64_t(1) << Slot)) || (Slot == 0 && Upper))
+            {
+                Next = Tick;
+                break;
+            }
+        }
+
+        const std::chrono::steady_clock::time_point Deadline = m_origin + m_tick * Next;
+        Result = (Deadline > inNow) ? std::chrono::ceil<std::chrono::milliseconds>(Deadline - inNow) : std::chrono::milliseconds(0);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMTimerWheel::size() const
+{
+    return m_size;
+}
+//-----------------------------------------------------------------------------
+void HMTimerWheel::link(HMWheelTimer& inTimer)
+{
+    const std::uint64_t Delta = inTimer.m_expiry - m_now;
+    std::size_t Level = 0;
+
+    // Уровень выбирается по удалённости срока: на уровне L ячейка покрывает 64^L шагов
+    while (Level < C_TIMER_WHEEL_LEVELS - 1 && Delta >= (std::uint64_t(1) << ((Level + 1) * C_TIMER_WHEEL_LEVEL_BITS)))
+        ++Level;
+
+    const std::uint64_t Span = std::uint64_t(1) << (C_TIMER_WHEEL_LEVELS * C_TIMER_WHEEL_LEVEL_BITS);
+
+    if (Delta >= Span) // Срок за пределами охвата: таймер сработает раньше, владелец поставит его заново
+        inTimer.m_expiry = m_now + Span - 1;
+
+    inTimer.m_level = Level;
+    inTimer.m_slot = (inTimer.m_expiry >> (Level * C_TIMER_WHEEL_LEVEL_BITS)) & (C_TIMER_WHEEL_SLOTS - 1);
+
+    HMWheelTimer*& Head = m_slots[Level][inTimer.m_slot];
+    inTimer.m_prev = nullptr;
+    inTimer.m_next = Head;
+
+    if (Head)
+        Head->m_prev = &inTimer;
+
+    Head = &inTimer;
+    m_occupied[Level] |= std::uint64_t(1) << inTimer.m_slot;
+}
+//-----------------------------------------------------------------------------
+void HMTimerWheel::unlink(HMWheelTimer& inTimer)
+{
+    HMWheelTimer*& Head = m_slots[inTimer.m_level][inTimer.m_slot];
+
+    if (inTimer.m_prev)
+        inTimer.m_prev->m_next = inTimer.m_next;
+    else
+        Head = inTimer.m_next;
+
+    if (inTimer.m_next)
+        inTimer.m_next->m_prev = inTimer.m_prev;
+
+    if (!Head)
+        m_occupied[inTimer.m_level] &= ~(std::uint64_t(1) << inTimer.m_slot);
+
+    inTimer.m_prev = nullptr;
+    inTimer.m_next = nullptr;
+}
+//-----------------------------------------------------------------------------
+void HMTimerWheel::cascade(const std::size_t inLevel, const std::size_t inSlot)
+{
+    HMWheelTimer* Timer = m_slots[inLevel][inSlot];
+
+    m_slots[inLevel][inSlot] = nullptr;
+    m_occupied[inLevel] &= ~(std::uint64_t(1) << inSlot);
+
+    while (Timer) // Срок каждого таймера ячейки ближе одного её охвата, поэтому он опускается ниже
+    {
+        HMWheelTimer* Next = Timer->m_next;
+        link(*Timer);
+        Timer = Next;
+    }
+}
+//-----------------------------------------------------------------------------
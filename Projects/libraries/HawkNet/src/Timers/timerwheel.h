@@ -0,0 +1,178 @@
+#ifndef HMTIMERWHEEL_H
+#define HMTIMERWHEEL_H
+
+/**
+ * @file timerwheel.h
+ * @brief Содержит описание иерархического колеса таймеров
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+#include <HawkCommon.h>
+
+namespace net
+{
+//-----------------------------------------------------------------------------
+constexpr std::chrono::milliseconds C_TIMER_WHEEL_TICK { 10 };  ///< Шаг колеса таймеров по умолчанию
+constexpr std::size_t C_TIMER_WHEEL_LEVEL_BITS = 6;             ///< Разрядность номера ячейки уровня
+constexpr std::size_t C_TIMER_WHEEL_SLOTS = std::size_t(1) << C_TIMER_WHEEL_LEVEL_BITS; ///< Количество ячеек уровня
+constexpr std::size_t C_TIMER_WHEEL_LEVELS = 4;                 ///< Количество уровней (охват 64^4 шагов, около 46 часов при шаге 10 мс)
+//-----------------------------------------------------------------------------
+/**
+ * @brief TimerFn - Тип функции, вызываемой при срабатывании таймера
+ */
+typedef std::function<void()> TimerFn;
+//-----------------------------------------------------------------------------
+class HMTimerWheel;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMWheelTimer class - Класс, описывающий таймер колеса
+ * Таймер - узел списка ячейки колеса и не выделяет память при постановке и снятии.
+ * Таймер обслуживается потоком колеса: ставится, снимается и разрушается только в нём.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMWheelTimer : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMWheelTimer - Инициализирующий конструктор
+     * @param inCallback - Функция, вызываемая при срабатывании (в потоке колеса)
+     */
+    explicit HMWheelTimer(TimerFn&& inCallback = nullptr);
+
+    /**
+     * @brief ~HMWheelTimer - Виртуальный деструктор (снимает таймер с колеса)
+     */
+    virtual ~HMWheelTimer() override;
+
+    /**
+     * @brief setCallback - Метод задаст функцию, вызываемую при срабатывании
+     * @param inCallback - Функция, вызываемая при срабатывании (в потоке колеса)
+     */
+    void setCallback(TimerFn&& inCallback);
+
+    /**
+     * @brief isScheduled - Метод вернёт признак того, что таймер стоит на колесе
+     * @return Вернёт признак постановки таймера
+     */
+    bool isScheduled() const;
+
+    /**
+     * @brief cancel - Метод снимет таймер с колеса, если он поставлен
+     */
+    void cancel();
+
+private:
+
+    friend class HMTimerWheel;
+
+    TimerFn m_callback = nullptr;           ///< Функция, вызываемая при срабатывании
+    HMTimerWheel* m_wheel = nullptr;        ///< Колесо, на котором стоит таймер
+    HMWheelTimer* m_prev = nullptr;         ///< Предыдущий таймер ячейки
+    HMWheelTimer* m_next = nullptr;         ///< Следующий таймер ячейки
+    std::uint64_t m_expiry = 0;             ///< Шаг срабатывания
+    std::size_t m_level = 0;                ///< Уровень ячейки
+    std::size_t m_slot = 0;                 ///< Номер ячейки на уровне
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMTimerWheel class - Класс, описывающий иерархическое колесо таймеров
+ * Время делится на шаги; таймеры ближайших 64 шагов лежат в ячейках нижнего уровня,
+ * более дальние - в ячейках верхних уровней, каждая из которых покрывает в 64 раза больше шагов.
+ * Когда нижний уровень проходит полный оборот, ячейка верхнего уровня переносится вниз.
+ * Постановка и снятие таймера выполняются за O(1), а продвижение колеса затрагивает только
+ * сработавшие и переносимые таймеры, поэтому стоимость не зависит от числа ожидающих таймеров.
+ * Таймер срабатывает не раньше срока и не позже чем через шаг после него
+ * (срок дальше охвата колеса ограничивается охватом: владелец проверяет срок сам).
+ *
+ * Колесо не потокобезопасно и принадлежит одному потоку (циклу событий).
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMTimerWheel : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMTimerWheel - Инициализирующий конструктор
+     * @param inTick - Шаг колеса
+     * @param inOrigin - Момент начала отсчёта шагов
+     */
+    HMTimerWheel(const std::chrono::milliseconds inTick = C_TIMER_WHEEL_TICK,
+                 const std::chrono::steady_clock::time_point inOrigin = std::chrono::steady_clock::now());
+
+    /**
+     * @brief ~HMTimerWheel - Виртуальный деструктор (снимает оставшиеся таймеры)
+     */
+    virtual ~HMTimerWheel() override;
+
+    /**
+     * @brief schedule - Метод поставит таймер на колесо (поставленный ранее переносится)
+     * @param inTimer - Таймер (не должен стоять на другом колесе)
+     * @param inDeadline - Срок срабатывания (прошедший срок сработает на следующем шаге)
+     */
+    void schedule(HMWheelTimer& inTimer, const std::chrono::steady_clock::time_point inDeadline);
+
+    /**
+     * @brief advance - Метод продвинет колесо до указанного момента, вызвав сработавшие таймеры
+     * Таймеры могут ставить и снимать любые таймеры колеса, в том числе самих себя.
+     * @param inNow - Текущий момент
+     * @return Вернёт количество сработавших таймеров
+     */
+    std::size_t advance(const std::chrono::steady_clock::time_point inNow);
+
+    /**
+     * @brief nextTimeout - Метод вернёт время до ближайшего шага, на котором колесу есть что делать
+     * @param inNow - Текущий момент
+     * @return Вернёт время ожидания (-1 мс, если таймеров нет)
+     */
+    std::chrono::milliseconds nextTimeout(const std::chrono::steady_clock::time_point inNow) const;
+
+    /**
+     * @brief size - Метод вернёт количество поставленных таймеров
+     * @return Вернёт количество таймеров
+     */
+    std::size_t size() const;
+
+private:
+
+    friend class HMWheelTimer;
+
+    std::chrono::steady_clock::time_point m_origin;     ///< Момент начала отсчёта шагов
+    std::chrono::steady_clock::duration m_tick;         ///< Шаг колеса
+    std::uint64_t m_now = 0;                            ///< Последний обработанный шаг
+    std::size_t m_size = 0;                             ///< Количество поставленных таймеров
+
+    HMWheelTimer* m_slots[C_TIMER_WHEEL_LEVELS][C_TIMER_WHEEL_SLOTS] = {};  ///< Списки таймеров ячеек
+    std::uint64_t m_occupied[C_TIMER_WHEEL_LEVELS] = {};                    ///< Маски непустых ячеек уровней
+
+    /**
+     * @brief link - Метод поместит таймер в ячейку, соответствующую его шагу срабатывания
+     * @param inTimer - Таймер (шаг срабатывания не раньше текущего)
+     */
+    void link(HMWheelTimer& inTimer);
+
+    /**
+     * @brief unlink - Метод извлечёт таймер из его ячейки
+     * @param inTimer - Таймер
+     */
+    void unlink(HMWheelTimer& inTimer);
+
+    /**
+     * @brief cascade - Метод перенесёт таймеры ячейки верхнего уровня на нижние уровни
+     * @param inLevel - Уровень ячейки
+     * @param inSlot - Номер ячейки
+     */
+    void cascade(const std::size_t inLevel, const std::size_t inSlot);
+};
+//-----------------------------------------------------------------------------
+} // namespace net
+
+#endif // HMTIMERWHEEL_H
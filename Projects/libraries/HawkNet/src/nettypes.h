@@ -1,7 +1,12 @@
 #ifndef NETTYPES_H
 #define NETTYPES_H
 
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
 #include <sstream>
+#include <string_view>
 
 namespace net
 {
@@ -20,8 +25,12 @@ enum class eConnectionStatus
     csCount             ///< Счётчик
 };
 //-----------------------------------------------------------------------------
-typedef std::basic_istringstream<char> iByteStream; ///< Буфер получаемых данных
-typedef std::basic_ostringstream<char> oByteStream; ///< Буфер отправляемых данных
+class HMByteBuffer;
+//-----------------------------------------------------------------------------
+typedef std::basic_istringstream<char> iByteStream; ///< Поток получаемых данных (совместимость, см. HMByteBuffer)
+typedef std::basic_ostringstream<char> oByteStream; ///< Поток отправляемых данных (совместимость, см. HMByteBuffer)
+typedef std::shared_ptr<const HMByteBuffer> SharedPayload; ///< Неизменяемые данные, разделяемые очередями отправки нескольких соединений
+typedef std::string_view FrameView;                 ///< Представление принятого кадра без копирования (действительно только на время вызова обработчика)
 //-----------------------------------------------------------------------------
 constexpr char C_DATA_WRAP_END =    0x1D;   ///< Разделитель "обёртки" и потока даннх
 constexpr char C_DATA_SEPARATOR =   0x1E;   ///< Символ, разделяющий "сообщения" в потоке данных (RECORD SEPARATOR (RS) UP ARROW)
@@ -35,6 +44,186 @@ static const std::string C_WRAP_HEAD =      "WRAP_INFO";        ///< Загол
 static const std::string C_WRAP_SEQUENCE =  "replace_sequence"; ///< Подменяющая последоваетльность
 static const std::string C_WRAP_COUNT =     "replace_count";    ///< Количество произведённых замен
 //-----------------------------------------------------------------------------
+/**
+ * @brief The eFramingMode enum - Перечисление режимов кадрирования сообщений в потоке данных
+ */
+enum class eFramingMode : std::uint8_t
+{
+    fmSeparator = 0,    ///< Сообщения завершаются символом C_DATA_SEPARATOR (требует обёртки net::wrap)
+    fmLengthPrefixed,   ///< Сообщениям предшествует двоичный заголовок фиксированной длины
+
+    fmCount             ///< Счётчик
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The eQueueOverflowPolicy enum - Перечисление реакций на переполнение очереди отправки
+ */
+enum class eQueueOverflowPolicy : std::uint8_t
+{
+    qpReject = 0,       ///< Новое сообщение отклоняется с ошибкой neSendQueueFull
+    qpDropOldest,       ///< Из очереди выбрасываются самые старые сообщения
+    qpDisconnect,       ///< Соединение разрывается (медленный партнёр не должен расходовать память без предела)
+
+    qpCount             ///< Счётчик
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The SendQueueLimits struct - Структура, описывающая пределы очереди отправки соединения
+ * Пределы относятся к сообщениям, ещё не переданным на запись; 0 - предел не задан.
+ */
+struct SendQueueLimits
+{
+    std::size_t m_maxBytes = 0;                                     ///< Предельный объём сообщений в очереди
+    std::size_t m_maxMessages = 0;                                  ///< Предельное количество сообщений в очереди
+    eQueueOverflowPolicy m_policy = eQueueOverflowPolicy::qpReject; ///< Реакция на переполнение
+};
+//-----------------------------------------------------------------------------
+/*
+ * Двоичный заголовок кадра (C_FRAME_HEADER_SIZE байт):
+ * [0..1] - Магическая последовательность C_FRAME_MAGIC
+ * [2]    - Версия формата C_FRAME_VERSION
+ * [3]    - Флаги кадра C_FRAME_FLAG_*
+ * [4..7] - Длина полезной нагрузки (little-endian)
+ *
+ * Магическая последовательность начинается с C_DATA_SEPARATOR, с которого не может начинаться
+ * сообщение режима fmSeparator, поэтому оба режима однозначно различимы в одном потоке.
+ */
+constexpr char C_FRAME_MAGIC[] =                    { C_DATA_SEPARATOR, 'H' };  ///< Магическая последовательность заголовка кадра
+constexpr std::size_t C_FRAME_MAGIC_SIZE =          sizeof(C_FRAME_MAGIC);      ///< Размер магической последовательности
+constexpr std::uint8_t C_FRAME_VERSION =            1;                          ///< Версия формата заголовка кадра
+constexpr std::size_t C_FRAME_HEADER_SIZE =         C_FRAME_MAGIC_SIZE + 2 + sizeof(std::uint32_t); ///< Размер заголовка кадра
+constexpr std::uint32_t C_FRAME_MAX_LENGTH =        64 * 1024 * 1024;           ///< Максимальная длина полезной нагрузки кадра (64 МБ)
+//-----------------------------------------------------------------------------
+constexpr std::uint8_t C_FRAME_FLAG_HELLO =         0x01;   ///< Служебный кадр согласования режима кадрирования (не передаётся обработчику)
+constexpr std::uint8_t C_FRAME_FLAG_DEFLATE =       0x02;   ///< Полезная нагрузка сжата deflate в общем окне соединения
+constexpr std::uint8_t C_FRAME_FLAG_PING =          0x04;   ///< Служебный кадр проверки связи (партнёр отвечает кадром C_FRAME_FLAG_PONG)
+constexpr std::uint8_t C_FRAME_FLAG_PONG =          0x08;   ///< Служебный ответ на кадр проверки связи
+constexpr std::uint8_t C_FRAME_FLAG_REQUEST =       0x10;   ///< Запрос, ожидающий ответа (полезная нагрузка начинается с идентификатора запроса)
+constexpr std::uint8_t C_FRAME_FLAG_RESPONSE =      0x20;   ///< Ответ на запрос (полезная нагрузка начинается с идентификатора запроса)
+constexpr std::uint8_t C_FRAME_FLAG_ACKED =         0x40;   ///< Данные, доставку которых партнёр подтверждает пустым ответом (начинаются с идентификатора запроса)
+constexpr std::uint8_t C_FRAME_TAGGED_FLAGS =       C_FRAME_FLAG_REQUEST | C_FRAME_FLAG_RESPONSE | C_FRAME_FLAG_ACKED; ///< Флаги кадров с идентификатором запроса
+constexpr std::uint8_t C_FRAME_SERVICE_FLAGS =      C_FRAME_FLAG_HELLO | C_FRAME_FLAG_PING | C_FRAME_FLAG_PONG; ///< Флаги служебных кадров (не сжимаются)
+//-----------------------------------------------------------------------------
+/*
+ * Идентификатор запроса - первые C_REQUEST_ID_SIZE байт полезной нагрузки запроса и ответа (little-endian).
+ * Идентификаторы выдаются соединением-отправителем запросов, ответ повторяет идентификатор запроса,
+ * поэтому по одному соединению может идти сколько угодно запросов, а ответы - приходить в любом порядке.
+ * Данные с подтверждением (C_FRAME_FLAG_ACKED) используют те же идентификаторы: партнёр передаёт их
+ * обработчику данных и отвечает пустым ответом, когда обработчик вернул управление.
+ */
+constexpr std::size_t C_REQUEST_ID_SIZE =           sizeof(std::uint32_t);      ///< Размер идентификатора запроса
+constexpr std::chrono::milliseconds C_REQUEST_TIMEOUT { 5000 };                 ///< Время ожидания ответа на запрос по умолчанию
+//-----------------------------------------------------------------------------
+/*
+ * Полезная нагрузка кадра согласования - байт возможностей C_FRAME_CAPABILITY_* отправителя.
+ * Кадр согласования без полезной нагрузки означает отсутствие возможностей.
+ */
+constexpr std::uint8_t C_FRAME_CAPABILITY_DEFLATE = 0x01;   ///< Отправитель распаковывает кадры C_FRAME_FLAG_DEFLATE
+//-----------------------------------------------------------------------------
+/**
+ * @brief The CompressionSettings struct - Структура, описывающая сжатие отправляемых кадров
+ * Сжатие применяется только в режиме fmLengthPrefixed и только если партнёр сообщил о поддержке
+ * распаковки в кадре согласования. Сжатые кадры соединения используют общее окно deflate,
+ * поэтому повторяющиеся между сообщениями данные кодируются ссылками на предыдущие кадры.
+ */
+struct CompressionSettings
+{
+    bool m_enabled = false;             ///< Сжимать отправляемые кадры
+    std::size_t m_threshold = 512;      ///< Минимальный размер сжимаемой полезной нагрузки (короткие кадры не сжимаются)
+    int m_level = 1;                    ///< Уровень сжатия (1 - быстрее, 9 - сильнее; применяется к новому сеансу)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HeartbeatSettings struct - Структура, описывающая проверку связи и разрыв простаивающего соединения
+ * Простой отсчитывается от последних принятых данных. Партнёр отвечает на проверку связи автоматически,
+ * поэтому при m_interval меньше m_idleTimeout живое соединение без трафика не разрывается.
+ */
+struct HeartbeatSettings
+{
+    std::chrono::milliseconds m_interval { 0 };     ///< Простой, после которого партнёру отправляется кадр проверки связи (0 - не отправлять)
+    std::chrono::milliseconds m_idleTimeout { 0 };  ///< Простой, после которого соединение разрывается с ошибкой neIdleTimeout (0 - не разрывать)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The RateLimits struct - Структура, описывающая пределы частоты входящих кадров соединения
+ * Пределы работают как ведро жетонов: запас m_*Burst пополняется со скоростью m_*PerSecond.
+ * Кадр, для которого запас исчерпан, отбрасывается (сжатый - после распаковки, чтобы окно
+ * сжатия не рассинхронизировалось), а обработчик ошибок получает neRateLimited один раз на серию.
+ */
+struct RateLimits
+{
+    std::uint64_t m_framesPerSecond = 0;    ///< Предельная частота кадров (0 - без ограничения)
+    std::uint64_t m_frameBurst = 0;         ///< Запас кадров (0 - равен секундной частоте)
+    std::uint64_t m_bytesPerSecond = 0;     ///< Предельный поток полезной нагрузки, байт в секунду (0 - без ограничения)
+    std::uint64_t m_byteBurst = 0;          ///< Запас байт (0 - равен секундному потоку); последний кадр запаса может его превысить
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The AcceptLimits struct - Структура, описывающая предел частоты подключений к серверу
+ * Подключение сверх предела закрывается сразу после приёма, до создания соединения.
+ */
+struct AcceptLimits
+{
+    std::uint64_t m_connectionsPerSecond = 0;   ///< Предельная частота подключений (0 - без ограничения)
+    std::uint64_t m_burst = 0;                  ///< Запас подключений (0 - равен секундной частоте)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The ServerStats struct - Структура, описывающая статистику сервера
+ */
+struct ServerStats
+{
+    std::uint64_t m_acceptedConnections = 0;    ///< Количество принятых подключений
+    std::uint64_t m_rejectedConnections = 0;    ///< Количество подключений, отклонённых пределом частоты
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The ReconnectSettings struct - Структура, описывающая настройки переподключения клиента
+ * Задержка попытки выбирается случайно от нуля до предела, который удваивается с каждой неудачной
+ * попыткой (от m_initialDelay до m_maxDelay). Случайный разброс не даёт клиентам, потерявшим
+ * сервер одновременно, подключаться к нему одной волной.
+ */
+struct ReconnectSettings
+{
+    std::chrono::milliseconds m_initialDelay { 100 };       ///< Предел задержки первой попытки после разрыва
+    std::chrono::milliseconds m_maxDelay { 30000 };         ///< Наибольший предел задержки
+    std::chrono::milliseconds m_connectTimeout { 5000 };    ///< Время ожидания одной попытки подключения
+    std::chrono::milliseconds m_ackTimeout { C_REQUEST_TIMEOUT }; ///< Время ожидания подтверждения данных до повторной отправки
+    std::size_t m_outboxLimit = 4 * 1024 * 1024;            ///< Предельный объём неподтверждённых данных (байт)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The ConnectionStats struct - Структура, описывающая статистику соединения
+ */
+struct ConnectionStats
+{
+    std::uint64_t m_compressedFrames = 0;                   ///< Количество сжатых отправленных кадров
+    std::uint64_t m_compressInBytes = 0;                    ///< Объём сжатых кадров до сжатия
+    std::uint64_t m_compressOutBytes = 0;                   ///< Объём сжатых кадров после сжатия
+    std::chrono::nanoseconds m_compressTime { 0 };          ///< Время, затраченное на сжатие
+    double m_compressionRatio = 1.0;                        ///< Степень сжатия отправленных кадров (объём после / объём до)
+
+    std::uint64_t m_decompressedFrames = 0;                 ///< Количество распакованных принятых кадров
+    std::uint64_t m_decompressInBytes = 0;                  ///< Объём принятых кадров до распаковки
+    std::uint64_t m_decompressOutBytes = 0;                 ///< Объём принятых кадров после распаковки
+    std::chrono::nanoseconds m_decompressTime { 0 };        ///< Время, затраченное на распаковку
+
+    std::uint64_t m_limitedFrames = 0;                      ///< Количество входящих кадров, отброшенных пределами частоты
+    std::uint64_t m_limitedBytes = 0;                       ///< Объём отброшенных пределами частоты кадров
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The FrameInfo struct - Структура, описывающая кадр, найденный в потоке данных
+ */
+struct FrameInfo
+{
+    eFramingMode m_mode = eFramingMode::fmSeparator;    ///< Режим кадрирования кадра
+    std::uint8_t m_flags = 0;                           ///< Флаги кадра
+    std::size_t m_offset = 0;                           ///< Смещение полезной нагрузки от начала кадра
+    std::size_t m_length = 0;                           ///< Длина полезной нагрузки
+    std::size_t m_size = 0;                             ///< Полный размер кадра в потоке
+};
+//-----------------------------------------------------------------------------
 } // namespace net
 
 #endif // NETTYPES_H
@@ -1,27 +1,152 @@
 #include "netutils.h"
 
+#include <vector>
 #include <cassert>
+#include <cstring>
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HAWKNET_AVX2_DISPATCH // Ветка AVX2 собирается всегда и выбирается по процессору во время работы
+#endif
+
+#include <neterrorcategory.h>
+
 //-----------------------------------------------------------------------------
 /**
  * @brief makeMark - Функция сформирует замещающую последовательность
  * @param inRepSymbol - Главный символ замещающей последовательности
  * @param inRepeats - Количество повторов символа в замещающей последовательности
- * @return
+ * @return Вернёт замещающую последовательность
  */
-std::string makeMark(const char inRepSymbol, std::uint8_t inRepeats)
+std::string makeMark(const char inRepSymbol, const std::size_t inRepeats)
 {
     assert(inRepSymbol != '\0'); // Символ не должен быть пустым
     assert(inRepeats != 0); // Количество повторов не должно быть рано 0
 
-    std::string Result = "";
+    return "{" + std::string(inRepeats, inRepSymbol) + "}"; // Формируем последовательность замещения
+}
+#if defined(HAWKNET_AVX2_DISPATCH)
+//-----------------------------------------------------------------------------
+/**
+ * @brief countByteAvx2 - Функция подсчитает вхождения байта блоками по 32 байта инструкциями AVX2
+ * Собирается для AVX2 независимо от флагов компиляции, вызывать только на процессоре с AVX2.
+ * @param inData - Указатель на начало данных
+ * @param inSize - Размер данных
+ * @param inByte - Искомый байт
+ * @param ioPos - Позиция начала подсчёта, по завершению - позиция первого непросмотренного байта
+ * @return Вернёт количество вхождений в просмотренных байтах
+ */
+__attribute__((target("avx2")))
+static std::size_t countByteAvx2(const char* inData, const std::size_t inSize, const char inByte, std::size_t& ioPos)
+{
+    std::size_t Result = 0;
+    const __m256i Pattern = _mm256_set1_epi8(inByte);
+
+    while (inSize - ioPos >= sizeof(__m256i))
+    {
+        __m256i Counters = _mm256_setzero_si256();
+        const std::size_t BlockEnd = ioPos + std::min<std::size_t>((inSize - ioPos) / sizeof(__m256i), 255) * sizeof(__m256i);
+
+        for (; ioPos < BlockEnd; ioPos += sizeof(__m256i)) // Совпавший байт сравнения равен -1, вычитание увеличивает счётчик
+            Counters = _mm256_sub_epi8(Counters, _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(inData + ioPos)), Pattern));
+
+        const __m256i Sums = _mm256_sad_epu8(Counters, _mm256_setzero_si256()); // Суммы байтов по 64-битным половинам
+        const __m128i Halves = _mm_add_epi64(_mm256_castsi256_si128(Sums), _mm256_extracti128_si256(Sums, 1));
+        Result += static_cast<std::size_t>(_mm_cvtsi128_si32(Halves)) + static_cast<std::size_t>(_mm_extract_epi16(Halves, 4));
+    }
+
+    return Result;
+}
+#endif
+//-----------------------------------------------------------------------------
+/**
+ * @brief countByte - Функция подсчитает количество вхождений байта в данных
+ * Байты сравниваются по 32 (AVX2, если его поддерживает процессор) или 16 (SSE2) за инструкцию,
+ * совпадения копятся в байтовых счётчиках и сворачиваются не реже, чем через 255 блоков.
+ * Остаток досчитывается побайтно.
+ * @param inData - Указатель на начало данных
+ * @param inSize - Размер данных
+ * @param inByte - Искомый байт
+ * @return Вернёт количество вхождений
+ */
+std::size_t countByte(const char* inData, const std::size_t inSize, const char inByte)
+{
+    std::size_t Result = 0;
+    std::size_t Pos = 0;
+
+#if defined(HAWKNET_AVX2_DISPATCH)
+    static const bool HasAvx2 = __builtin_cpu_supports("avx2"); // Процессор проверяется однажды
+
+    if (HasAvx2)
+        Result += countByteAvx2(inData, inSize, inByte, Pos);
+#endif
+
+#if defined(__SSE2__)
+    const __m128i Pattern128 = _mm_set1_epi8(inByte);
+
+    while (inSize - Pos >= sizeof(__m128i))
+    {
+        __m128i Counters = _mm_setzero_si128();
+        const std::size_t BlockEnd = Pos + std::min<std::size_t>((inSize - Pos) / sizeof(__m128i), 255) * sizeof(__m128i);
+
+        for (; Pos < BlockEnd; Pos += sizeof(__m128i)) // Совпавший байт сравнения равен -1, вычитание увеличивает счётчик
+            Counters = _mm_sub_epi8(Counters, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inData + Pos)), Pattern128));
+
+        const __m128i Sums = _mm_sad_epu8(Counters, _mm_setzero_si128()); // Суммы байтов по 64-битным половинам
+        Result += static_cast<std::size_t>(_mm_cvtsi128_si32(Sums)) + static_cast<std::size_t>(_mm_extract_epi16(Sums, 4));
+    }
+#endif
+
+    for (; Pos < inSize; ++Pos) // Остаток (или все данные без SIMD)
+        Result += (inData[Pos] == inByte) ? 1 : 0;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief pickMark - Функция подберёт кратчайшую замещающую последовательность, не встречающуюся в данных
+ * Данные просматриваются один раз: для каждой "{" подсчитывается серия символов замены и
+ * отмечается её длина, если серия закрыта "}". Последовательность внутри не содержит скобок,
+ * поэтому замены не образуют с соседними данными новых вхождений.
+ * @param inData - Отправляемые данные
+ * @return Вернёт замещающую последовательность
+ */
+std::string pickMark(const net::FrameView inData)
+{
+    std::vector<bool> Taken; // Taken[N] - в данных встречается последовательность из N символов замены
+    const char* const End = inData.data() + inData.size();
+    const char* Pos = static_cast<const char*>(std::memchr(inData.data(), '{', inData.size()));
+
+    while (Pos) // memchr библиотеки C векторизован, поэтому поиск скобок не уступает ручному SIMD
+    {
+        const char* Run = Pos + 1;
+
+        while (Run != End && *Run == net::C_DATA_REPLACER) // Серия символов замены не содержит скобок, поэтому каждый байт просматривается единожды
+            ++Run;
+
+        const std::size_t Repeats = static_cast<std::size_t>(Run - Pos - 1);
+
+        if (Repeats != 0 && Run != End && *Run == '}') // Найдено вхождение последовательности длины Repeats
+        {
+            if (Taken.size() <= Repeats)
+                Taken.resize(Repeats + 1, false);
+
+            Taken[Repeats] = true;
+        }
+
+        Pos = static_cast<const char*>(std::memchr(Run, '{', static_cast<std::size_t>(End - Run)));
+    }
+
+    std::size_t Repeats = 1;
 
-    do
-    {  Result += inRepSymbol; } // Добавляем необходимое количество символов замены
-    while (--inRepeats);
+    while (Repeats < Taken.size() && Taken[Repeats]) // Первая свободная длина
+        ++Repeats;
 
-    return "{" + Result + "}"; // Формируем последовательность замещения
+    return makeMark(net::C_DATA_REPLACER, Repeats);
 }
 //-----------------------------------------------------------------------------
 nlohmann::json makeJsonWrap(const std::string& inReplaceSequence, const std::uint64_t inReplaceCount)
@@ -46,6 +171,34 @@ bool isJsonWrap(const nlohmann::json& inWrap)
             inWrap[net::C_WRAP_HEAD][net::C_WRAP_COUNT].is_number_unsigned();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief splitWrap - Функция разберёт заголовок обёртки и найдёт "обёрнутые" данные без их копирования
+ * @param inTextData - "Обёрнутые" данные
+ * @param outWrapInfo - Информация об обёртке
+ * @param outMessageData - Представление "обёрнутого" сообщения (указывает в inTextData)
+ * @return Вернёт признак успеха операции
+ */
+bool splitWrap(const net::FrameView inTextData, nlohmann::json& outWrapInfo, net::FrameView& outMessageData)
+{
+    bool Result = true;
+
+    const net::FrameView::size_type WrapEndFindRes = inTextData.find(net::C_DATA_WRAP_END);
+
+    if (WrapEndFindRes == net::FrameView::npos) // Разделитель обёртки не найден
+        Result = false;
+    else // Если найден символ разделиетель обёртки
+    {
+        outWrapInfo = nlohmann::json::parse(inTextData.data(), inTextData.data() + WrapEndFindRes, nullptr, false); // Пытаемся распарсить обёртку
+
+        if (outWrapInfo.is_discarded() || !isJsonWrap(outWrapInfo)) // Ошибка парсинга или обёртка не соответствует
+            Result = false;
+        else // Если парсинг прошёл успешно и JSON является заголовком обёртки
+            outMessageData = inTextData.substr(WrapEndFindRes + 1); // Возвращаем данные
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
 //nlohmann::json net::strToBinaryJson(const std::string& inStr)
 //{
 //    nlohmann::json Result;
@@ -80,97 +233,105 @@ bool isJsonWrap(const nlohmann::json& inWrap)
 //-----------------------------------------------------------------------------
 bool net::getWrapAndMessageData(const std::string& inTextData, nlohmann::json& outWrapInfo, std::string& outMessageData)
 {
-    bool Result = true;
-
-    std::string::size_type WrapEndFindRes = inTextData.find(net::C_DATA_WRAP_END);
-
-    if (WrapEndFindRes == std::string::npos) // Разделитель обёртки не найден
-        Result = false;
-    else // Если найден символ разделиетель обёртки
-    {
-        outWrapInfo = nlohmann::json::parse(inTextData.substr(0, WrapEndFindRes), nullptr, false); // Пытаемся распарсить обёртку
+    FrameView MessageData;
+    const bool Result = splitWrap(inTextData, outWrapInfo, MessageData);
 
-        if (outWrapInfo.is_discarded() || !isJsonWrap(outWrapInfo)) // Ошибка парсинга или обёртка не соответствует
-            Result = false;
-        else // Если парсинг прошёл успешно и JSON является заголовком обёртки
-            outMessageData = inTextData.substr(WrapEndFindRes + 1); // Возвращаем данные
-    }
+    if (Result)
+        outMessageData = std::string(MessageData);
 
     return Result;
 }
 //-----------------------------------------------------------------------------
-net::oByteStream net::wrap(oByteStream&& inData)
+net::HMByteBuffer net::wrap(HMByteBuffer&& inData)
 {
-    std::string StrData = inData.str();
+    const FrameView StrData = inData.view();
+    const std::size_t ReplaceCount = countByte(StrData.data(), StrData.size(), C_DATA_SEPARATOR); // Количество необходимых замен
 
-    std::uint64_t ReplaceCount = 0; // Количество произведённых замен
-    std::string ReplaceSequence = "";   // Заменяющая последовательность
-
-    std::string::size_type SeparatorFindResult = StrData.find(C_DATA_SEPARATOR); // Ищим разделитель в потоке передаваемых данных
+    if (ReplaceCount != 0) // Если резделитель присутствует в потоке
+    {
+        const std::string ReplaceSequence = pickMark(StrData); // Заменяющая последовательность
+        const std::string Head = makeJsonWrap(ReplaceSequence, ReplaceCount).dump() + C_DATA_WRAP_END;
 
-    if (SeparatorFindResult != std::string::npos) // Если резделитель присутствует в потоке
-    {   // Подбираем замещаюшую последовательность
-        std::uint64_t TryOfReplace = 0;     // Попытох подбора заменяющей последовательности
+        // Результат собирается за один проход в заранее выделенный буфер, без сдвига хвоста при каждой замене
+        HMByteBuffer Result;
+        Result.reserve(Head.size() + StrData.size() + ReplaceCount * (ReplaceSequence.size() - 1));
+        Result.append(Head);
 
-        std::string::size_type ReplacerFindResult = std::string::npos; // Результат поиска замещающей последовательности
+        const char* const End = StrData.data() + StrData.size();
+        const char* Begin = StrData.data(); // Начало ещё не перенесённых данных
+        const char* Separator = static_cast<const char*>(std::memchr(Begin, C_DATA_SEPARATOR, StrData.size()));
 
-        do
+        while (Separator)
         {
-            TryOfReplace++; // Увеличиваем счётчик подбора
-            ReplaceSequence = makeMark(C_DATA_REPLACER, TryOfReplace); // Формируем замещающую последовательность
-            ReplacerFindResult = StrData.find(ReplaceSequence); // Ищим замещающую последоваетльность
+            Result.append(FrameView(Begin, static_cast<std::size_t>(Separator - Begin))); // Переносим данные до разделителя
+            Result.append(ReplaceSequence); // И заменяем его подобранной последоваетльностью
+            Begin = Separator + 1;
+            Separator = static_cast<const char*>(std::memchr(Begin, C_DATA_SEPARATOR, static_cast<std::size_t>(End - Begin)));
         }
-        while (ReplacerFindResult != std::string::npos); // Подбираем, пока замещающая последоваетльность не перестанет встречаться в потоке
 
-        // Когда последовательность подобрана
-
-        do
-        {
-            ReplaceCount++;
-            StrData.replace(SeparatorFindResult, sizeof(C_DATA_SEPARATOR), ReplaceSequence); // Заменяем найденый разделитель на подобранную последоваетльность
-            SeparatorFindResult = StrData.find(C_DATA_SEPARATOR, SeparatorFindResult); // Снова разделитель в потоке передаваемых данных (начиная с позиции последней замены)
-        }
-        while (SeparatorFindResult != std::string::npos); // Пока найден разделитель в потоке передаваемых данных и это не последний символ
+        Result.append(FrameView(Begin, static_cast<std::size_t>(End - Begin)));
 
         // Формируем обёрнутую последовательность {JSON WRAP DATA}{WRAP SEPARATOR}{REPLACED STR DATA}
-        inData = oByteStream(makeJsonWrap(ReplaceSequence, ReplaceCount).dump() + C_DATA_WRAP_END + StrData);
+        inData = std::move(Result);
     }
 
     /*
      * Сценарии:
      * 1) Если в отправляемой последовательности присутствует запрещённый символ "разделитель потока"
      * то вернём "обёртку" в формате {JSON WRAP DATA}{WRAP SEPARATOR}{REPLACED STR DATA}
-     * 2) Если запрещённый символ не найден, то вернём данные без изменений
+     * 2) Если запрещённый символ не найден, то вернём данные без изменений (и без копирования)
      */
     return std::move(inData);
 }
 //-----------------------------------------------------------------------------
-net::iByteStream net::unwrap(iByteStream&& inData)
+net::HMByteBuffer net::unwrap(HMByteBuffer&& inData)
 {
     nlohmann::json JsonWrapData; // Данные обёртки
-    std::string WrapedData = ""; // "Обёрнутые" данные сообщения
+    FrameView WrapedData; // "Обёрнутые" данные сообщения
 
-    if (getWrapAndMessageData(inData.str(), JsonWrapData, WrapedData)) // Если получены данные обёртки и "обёрнутые" данные
+    if (splitWrap(inData.view(), JsonWrapData, WrapedData)) // Если получены данные обёртки и "обёрнутые" данные
     {
+        inData.consume(static_cast<std::size_t>(WrapedData.data() - inData.data())); // Отбрасываем заголовок сдвигом смещения
+
         if (JsonWrapData[C_WRAP_HEAD][C_WRAP_COUNT] > 0) // Если были замещения
-        {   // Нужно развернуть обратно
+        {   // Нужно развернуть обратно за один проход прямо в буфере: развёрнутые данные не длиннее обёрнутых
+            const std::string ReplaceSequence = JsonWrapData[C_WRAP_HEAD][C_WRAP_SEQUENCE].get<std::string>(); // Замещающая последовательность
             std::uint64_t ReplaceCount = 0; // Количество произведённых обратных замен
-            std::string ReplaceSequence = JsonWrapData[C_WRAP_HEAD][C_WRAP_SEQUENCE].get<std::string>(); // Замещающая последовательность
-            std::string::size_type ReplacerFindResult = WrapedData.find(ReplaceSequence); // Результат поиска замещающей последовательности
 
-            while (ReplacerFindResult != std::string::npos) // Восстанавливаем, пока замещающая последоваетльность не перестанет встречаться в потоке
-            {
-                ReplaceCount++; // Увеличиваем счётчик подбора
-                // Обратно заменим замещающую последовательность на разделитель потока даннх
-                WrapedData.replace(ReplacerFindResult, ReplaceSequence.size(), { C_DATA_SEPARATOR });
+            char* const Begin = inData.data();
+            const char* const End = Begin + inData.size();
+            const char* Read = Begin; // Начало ещё не перенесённых данных
+            char* Write = Begin; // Конец развёрнутых данных
 
-                ReplacerFindResult = WrapedData.find(ReplaceSequence); // Ищим замещающую последоваетльность
+            // Пустая последовательность (повреждённая обёртка) не заменяется
+            const char* Candidate = (ReplaceSequence.empty()) ? nullptr : static_cast<const char*>(std::memchr(Read, ReplaceSequence.front(), inData.size()));
+
+            while (Candidate)
+            {
+                const std::size_t Rest = static_cast<std::size_t>(End - Candidate);
+
+                // Вхождения последовательности не перекрываются, поэтому совпадение сразу заменяется разделителем
+                if (Rest >= ReplaceSequence.size() && std::memcmp(Candidate, ReplaceSequence.data(), ReplaceSequence.size()) == 0)
+                {
+                    ReplaceCount++;
+                    std::memmove(Write, Read, static_cast<std::size_t>(Candidate - Read));
+                    Write += Candidate - Read;
+                    *Write++ = C_DATA_SEPARATOR;
+                    Read = Candidate + ReplaceSequence.size();
+                    Candidate = Read;
+                }
+                else
+                    ++Candidate;
+
+                Candidate = static_cast<const char*>(std::memchr(Candidate, ReplaceSequence.front(), static_cast<std::size_t>(End - Candidate)));
             }
 
+            std::memmove(Write, Read, static_cast<std::size_t>(End - Read));
+            Write += End - Read;
+            inData.truncate(static_cast<std::size_t>(Write - Begin));
+
             assert(ReplaceCount == JsonWrapData[C_WRAP_HEAD][C_WRAP_COUNT].get<std::uint64_t>()); // Количество замещений и востановлений должно совпасть
         }
-
-        inData = iByteStream(WrapedData);
     }
 
     /*
@@ -182,4 +343,84 @@ net::iByteStream net::unwrap(iByteStream&& inData)
     return std::move(inData);
 }
 //-----------------------------------------------------------------------------
+net::oByteStream net::wrap(oByteStream&& inData)
+{
+    return oByteStream(wrap(HMByteBuffer(inData)).str());
+}
+//-----------------------------------------------------------------------------
+net::iByteStream net::unwrap(iByteStream&& inData)
+{
+    return iByteStream(unwrap(HMByteBuffer(FrameView(inData.str()))).str());
+}
+//-----------------------------------------------------------------------------
+
+
+void net::encodeFrameHeader(const std::uint32_t inLength, const std::uint8_t inFlags, char* outHeader)
+{
+    assert(outHeader != nullptr); // Буфер заголовка должен быть валидным
+
+    std::memcpy(outHeader, C_FRAME_MAGIC, C_FRAME_MAGIC_SIZE); // Магическая последовательность
+    outHeader[C_FRAME_MAGIC_SIZE] = static_cast<char>(C_FRAME_VERSION); // Версия формата
+    outHeader[C_FRAME_MAGIC_SIZE + 1] = static_cast<char>(inFlags); // Флаги кадра
+
+    for (std::size_t Byte = 0; Byte < sizeof(inLength); ++Byte) // Длина всегда в little-endian, независимо от платформы
+        outHeader[C_FRAME_MAGIC_SIZE + 2 + Byte] = static_cast<char>((inLength >> (Byte * 8)) & 0xFF);
+}
+//-----------------------------------------------------------------------------
+bool net::nextFrame(const char* inData, const std::size_t inSize, FrameInfo& outFrame, errors::error_code& outError)
+{
+    bool Result = false;
+    outError = make_error_code(errors::eNetError::neSuccess); // Изначально метим как успех
+
+    if (inSize == 0 || inData[0] != C_DATA_SEPARATOR) // Кадр режима fmSeparator
+    {
+        const char* SepPos = static_cast<const char*>(std::memchr(inData, C_DATA_SEPARATOR, inSize)); // Ищим разделитель потока
 
+        if (SepPos) // Сообщение принято полностью
+        {
+            Result = true;
+            outFrame.m_mode = eFramingMode::fmSeparator;
+            outFrame.m_flags = 0;
+            outFrame.m_offset = 0;
+            outFrame.m_length = static_cast<std::size_t>(SepPos - inData);
+            outFrame.m_size = outFrame.m_length + 1; // Вместе с разделителем
+        }
+    }
+    else if (inSize >= C_FRAME_MAGIC_SIZE) // Для определения режима требуется магическая последовательность целиком
+    {
+        if (std::memcmp(inData, C_FRAME_MAGIC, C_FRAME_MAGIC_SIZE) != 0) // Одиночный разделитель - пустое сообщение режима fmSeparator
+        {
+            Result = true;
+            outFrame.m_mode = eFramingMode::fmSeparator;
+            outFrame.m_flags = 0;
+            outFrame.m_offset = 0;
+            outFrame.m_length = 0;
+            outFrame.m_size = 1;
+        }
+        else if (inSize >= C_FRAME_HEADER_SIZE) // Заголовок принят полностью
+        {
+            const unsigned char* Header = reinterpret_cast<const unsigned char*>(inData);
+            std::uint32_t Length = 0;
+
+            for (std::size_t Byte = 0; Byte < sizeof(Length); ++Byte)
+                Length |= static_cast<std::uint32_t>(Header[C_FRAME_MAGIC_SIZE + 2 + Byte]) << (Byte * 8);
+
+            if (Header[C_FRAME_MAGIC_SIZE] != C_FRAME_VERSION) // Неизвестная версия формата
+                outError = make_error_code(errors::eNetError::neInvalidFrame);
+            else if (Length > C_FRAME_MAX_LENGTH) // Защищаемся от повреждённой длины
+                outError = make_error_code(errors::eNetError::neFrameTooLarge);
+            else if (inSize - C_FRAME_HEADER_SIZE >= Length) // Полезная нагрузка принята полностью
+            {
+                Result = true;
+                outFrame.m_mode = eFramingMode::fmLengthPrefixed;
+                outFrame.m_flags = Header[C_FRAME_MAGIC_SIZE + 1];
+                outFrame.m_offset = C_FRAME_HEADER_SIZE;
+                outFrame.m_length = Length;
+                outFrame.m_size = C_FRAME_HEADER_SIZE + Length;
+            }
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
\ No newline at end of file
@@ -3,7 +3,10 @@
 
 #include <nlohmann/json.hpp>
 
+#include <errorcode.h>
+
 #include "nettypes.h"
+#include "Buffers/bytebuffer.h"
 
 namespace net
 {
@@ -36,15 +39,48 @@ namespace net
  * @param inData - Отправляемые данные
  * @return Вернёт подготовленные к отправке данные
  */
+[[nodiscard]] HMByteBuffer wrap(HMByteBuffer&& inData);
+//-----------------------------------------------------------------------------
+/**
+ * @brief unwrap - Функция "развернёт" принятые обёрнутые данные (на месте, без копирования)
+ * @param inData - Принятые данные
+ * @return Вернёт распакованные данные
+ */
+[[nodiscard]] HMByteBuffer unwrap(HMByteBuffer&& inData);
+//-----------------------------------------------------------------------------
+/**
+ * @brief wrap - Функция "обернёт" отправляемые данные (совместимость с потоковым интерфейсом)
+ * @param inData - Отправляемые данные
+ * @return Вернёт подготовленные к отправке данные
+ */
 [[nodiscard]] oByteStream wrap(oByteStream&& inData);
 //-----------------------------------------------------------------------------
 /**
- * @brief unwrap - Функция "развернёт" принятые обёрнутые данные
+ * @brief unwrap - Функция "развернёт" принятые обёрнутые данные (совместимость с потоковым интерфейсом)
  * @param inData - Принятые данные
  * @return Вернёт распакованные данные
  */
 [[nodiscard]] iByteStream unwrap(iByteStream&& inData);
 //-----------------------------------------------------------------------------
+/**
+ * @brief encodeFrameHeader - Функция сформирует двоичный заголовок кадра режима fmLengthPrefixed
+ * @param inLength - Длина полезной нагрузки
+ * @param inFlags - Флаги кадра
+ * @param outHeader - Буфер заголовка (не менее C_FRAME_HEADER_SIZE байт)
+ */
+void encodeFrameHeader(const std::uint32_t inLength, const std::uint8_t inFlags, char* outHeader);
+//-----------------------------------------------------------------------------
+/**
+ * @brief nextFrame - Функция найдёт первый полностью принятый кадр в начале буфера
+ * Кадр режима fmLengthPrefixed определяется по заголовку за O(1), кадр режима fmSeparator - поиском разделителя.
+ * @param inData - Указатель на начало необработанных данных
+ * @param inSize - Размер необработанных данных
+ * @param outFrame - Описание найденного кадра
+ * @param outError - Признак ошибки (повреждённый заголовок кадра)
+ * @return Вернёт признак того, что кадр принят полностью
+ */
+[[nodiscard]] bool nextFrame(const char* inData, const std::size_t inSize, FrameInfo& outFrame, errors::error_code& outError);
+//-----------------------------------------------------------------------------
 } // namespace net
 
 #endif // HMNETUTILS_H
@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <neterrorcategory.h>
+#include <HawkNet.h>
+
+#include "HawkNetTest.hpp"
+
+//-----------------------------------------------------------------------------
+// Builder
+//-----------------------------------------------------------------------------
+/**
+ * @brief The EpollNetTestBuilder class - Класс-конструктор объектов теста EpollNet
+ */
+class EpollNetTestBuilder : public NetTestBuilder
+{
+public:
+
+    /**
+     * @brief EpollNetTestBuilder - Конскруктор по умолчанию
+     */
+    EpollNetTestBuilder() = default;
+
+    /**
+     * @brief ~EpollNetTestBuilder - Виртуальный деструктор по умолчанию
+     */
+    virtual ~EpollNetTestBuilder() override = default;
+
+    /**
+     * @brief make_server - Метод сконструирует сервер
+     * @param inCallBacks - Калбэки сервера
+     * @param inPort - Прослушиваемый порт
+     * @param inWorkers - Количество рабочих потоков сервера
+     * @return Вернёт указатель на интерфейс сервера
+     */
+    virtual std::unique_ptr<net::HMServer> make_server(net::ServCallbacks& inCallBacks,
+                                                       const std::uint16_t inPort = C_PORT,
+                                                       const std::size_t inWorkers = 0) override
+    {
+        return std::make_unique<net::HMEpollAsyncServer>(inPort, inCallBacks, inWorkers);
+    }
+
+    /**
+     * @brief make_client - Метод сконструерует соединение
+     * @param inCallBacks - Калбэки соединения
+     * @param inHost - Адрес хоста
+     * @param inPort - Порт хоста
+     * @return Веренёт указатель на интерфейс соединения
+     */
+    virtual std::unique_ptr<net::HMConnection> make_client(net::ConCallbacks& inCallBacks,
+                                                           const std::string inHost = C_HOST,
+                                                           const std::uint16_t inPort = C_PORT) override
+    {
+        return std::make_unique<net::HMEpollAsyncConnection>(inHost, inPort, inCallBacks);
+    }
+
+    /**
+     * @brief wait - Метод выполнит задержку потока для ожидания
+     * @param inWaitTime - Время ожидания
+     */
+    virtual void wait(const std::chrono::milliseconds& inWaitTime) override
+    {
+        std::this_thread::sleep_for(inWaitTime); // События обрабатываются потоками циклов epoll, достаточно просто подождать
+    }
+};
+//-----------------------------------------------------------------------------
+// Tests
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест создания сервера
+ */
+TEST(EpollNet, ServerStart)
+{
+    HawkNet_ServerStart(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест подключения клиента
+ */
+TEST(EpollNet, ClientConnect)
+{
+    HawkNet_ClientConnect(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест подключения клиента
+ */
+TEST(EpollNet, CliendReconnect)
+{
+    HawkNet_CliendReconnect(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения клиента
+ */
+TEST(EpollNet, ClientDisconnect)
+{
+    HawkNet_ClientDisconnect(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения всех клиентов
+ */
+TEST(EpollNet, ForcedDisconnectClient)
+{
+    HawkNet_ForcedDisconnectClient(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения всех клиентов
+ */
+TEST(EpollNet, ForcedDisconnectAllClients)
+{
+    HawkNet_ForcedDisconnectAllClients(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения сервера
+ */
+TEST(EpollNet, ServerStop)
+{
+    HawkNet_ServerStop(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обработки отключения клиента с обеих сторон
+ */
+TEST(EpollNet, CommonDisconnectEvents)
+{
+    HawkNet_CommonDisconnectEvents(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест присвоения идентификатора соединения
+ */
+TEST(EpollNet, SetConnectionID)
+{
+    HawkNet_SetConnectionID(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи данных: Сервер - клиент
+ */
+TEST(EpollNet, ServerToClientSendData)
+{
+    HawkNet_ServerToClientSendData(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи данны: Клиент - сервер
+ */
+TEST(EpollNet, ClientToServerSendData)
+{
+    HawkNet_ClientToServerSendData(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест эхо сервера
+ */
+TEST(EpollNet, Echo)
+{
+    HawkNet_Echo(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи двоичных данных в режиме кадров с заголовком
+ */
+TEST(EpollNet, LengthPrefixedFraming)
+{
+    HawkNet_LengthPrefixedFraming(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест приёма пачки мелких сообщений
+ */
+TEST(EpollNet, ReceiveBurst)
+{
+    HawkNet_ReceiveBurst(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обслуживания соединений рабочими потоками сервера
+ */
+TEST(EpollNet, WorkerThreads)
+{
+    HawkNet_WorkerThreads(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест нагрузки
+ */
+TEST(EpollNet, StressTest)
+{
+    HawkNet_StressTest(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения очереди отправки
+ */
+TEST(EpollNet, SendQueueLimits)
+{
+    HawkNet_SendQueueLimits(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест согласования и сжатия кадров
+ */
+TEST(EpollNet, Compression)
+{
+    HawkNet_Compression(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверки связи и разрыва по простою
+ */
+TEST(EpollNet, Heartbeat)
+{
+    HawkNet_Heartbeat(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест конвейерных запросов
+ */
+TEST(EpollNet, RequestPipelining)
+{
+    HawkNet_RequestPipelining(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест менеджера клиентских соединений
+ */
+TEST(EpollNet, ClientManager)
+{
+    HawkNet_ClientManager(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест перезапуска сервера под менеджером клиентских соединений
+ */
+TEST(EpollNet, ServerRestart)
+{
+    HawkNet_ServerRestart(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения частоты входящих кадров и соединений
+ */
+TEST(EpollNet, RateLimits)
+{
+    HawkNet_RateLimits(std::make_unique<EpollNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка тестировани функционала errors::error_code
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт признак успешности тестирования
+ */
+int main(int argc, char *argv[])
+{   
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS(); // Вернёт результат выполнения
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,592 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <random>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+#include <QCoreApplication>
+
+#include <nlohmann/json.hpp>
+
+#include <neterrorcategory.h>
+#include <HawkNet.h>
+#include <Async/QtImplementation/Ssl/sslfuncs.h>
+
+//-----------------------------------------------------------------------------
+// Const
+//-----------------------------------------------------------------------------
+static const std::string C_HOST = "127.0.0.1";                  ///< Адрес хоста
+constexpr std::uint16_t C_PORT = 57437;                         ///< Порт сервера
+constexpr auto C_TIMEOUT = std::chrono::seconds(60);            ///< Предельное время одного прогона
+constexpr std::size_t C_STAMP_SIZE = sizeof(std::int64_t);      ///< Размер метки времени отправки в начале сообщения
+constexpr std::size_t C_WRAP_SIZE = 4 * 1024 * 1024;            ///< Размер сообщения замера обёртывания
+constexpr std::size_t C_WRAP_ROUNDS = 8;                        ///< Количество повторов замера обёртывания
+//-----------------------------------------------------------------------------
+/**
+ * @brief The Settings struct - Структура, описывающая параметры прогона
+ */
+struct Settings
+{
+    std::size_t m_clients = 16;                                 ///< Количество одновременных клиентов
+    std::size_t m_messages = 20000;                             ///< Количество сообщений от каждого клиента
+    std::size_t m_payloadSize = 64;                             ///< Размер сообщения (не меньше метки времени)
+    std::size_t m_rate = 0;                                     ///< Частота отправки сообщений каждым клиентом в секунду (0 - без ограничения)
+    std::size_t m_window = 64;                                  ///< Количество сообщений клиента без ответа (0 - без ограничения)
+    std::size_t m_workers = std::max(std::thread::hardware_concurrency(), 1u); ///< Количество рабочих потоков сервера
+    std::size_t m_handshakes = 100;                             ///< Количество подключений каждого вида замера рукопожатий
+    std::string m_backend;                                      ///< Испытываемая реализация (пусто - все)
+    std::string m_jsonPath = "NetBench.json";                   ///< Путь к файлу результатов
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The Backend struct - Структура, описывающая испытываемую реализацию
+ */
+struct Backend
+{
+    std::string m_name;                                                                 ///< Название реализации
+    std::function<std::unique_ptr<net::HMServer>(net::ServCallbacks&)> m_makeServer;   ///< Конструктор сервера
+    std::function<std::unique_ptr<net::HMConnection>(net::ConCallbacks&)> m_makeClient; ///< Конструктор клиента
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The ClientState struct - Структура, описывающая ход прогона одного клиента
+ * Ячейки задержек выделяются до прогона. Поток, обрабатывающий данные клиента, заполняет ячейку
+ * очередного ответа и только затем увеличивает счётчик ответов, поэтому главный поток без мьютекса
+ * читает ячейки до прочитанного значения счётчика, даже если ответы ещё приходят после истечения времени.
+ */
+struct ClientState
+{
+    std::size_t m_sent = 0;                     ///< Количество отправленных сообщений (только главный поток)
+    std::atomic_size_t m_received = 0;          ///< Количество полученных ответов
+    std::vector<std::int64_t> m_latencies;      ///< Задержки ответов по порядку получения (нс, размер - количество сообщений)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The RunResult struct - Структура, описывающая результат прогона реализации
+ */
+struct RunResult
+{
+    std::string m_name;                         ///< Название реализации
+    std::string m_error;                        ///< Описание ошибки (пусто - без ошибок)
+    bool m_completed = false;                   ///< Признак получения всех ответов до истечения времени
+    std::size_t m_messages = 0;                 ///< Количество полученных ответов
+    double m_seconds = 0.0;                     ///< Время прогона
+    std::vector<std::int64_t> m_latencies;      ///< Упорядоченные задержки ответов (нс)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The WrapResult struct - Структура, описывающая результат замера обёртывания
+ */
+struct WrapResult
+{
+    bool m_measured = false;                    ///< Признак выполненного замера
+    bool m_valid = false;                       ///< Признак совпадения развёрнутых данных с исходными
+    double m_wrapMBps = 0.0;                    ///< Скорость обёртывания (МБ/с)
+    double m_unwrapMBps = 0.0;                  ///< Скорость развёртывания (МБ/с)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HandshakeResult struct - Структура, описывающая результат замера рукопожатий TLS
+ */
+struct HandshakeResult
+{
+    bool m_measured = false;                    ///< Признак выполненного замера
+    bool m_completed = false;                   ///< Признак доставки сообщений всех подключений
+    double m_fullRate = 0.0;                    ///< Частота полных рукопожатий (в секунду)
+    double m_resumedRate = 0.0;                 ///< Частота рукопожатий, возобновлённых по билету сеанса (в секунду)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief processUntil - Функция будет обрабатывать события Qt, пока не выполнится условие или не выйдет время
+ * @param inCondition - Условие завершения
+ * @return Вернёт признак выполнения условия
+ */
+static bool processUntil(const std::function<bool()>& inCondition)
+{
+    const auto TimeOut = std::chrono::steady_clock::now() + C_TIMEOUT;
+    bool Result = inCondition();
+
+    while (!Result && std::chrono::steady_clock::now() < TimeOut)
+    {
+        QCoreApplication::processEvents(); // Клиенты Qt живут в главном потоке, реализациям на циклах это не мешает
+        Result = inCondition();
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief nowNs - Функция вернёт текущий момент монотонных часов
+ * @return Вернёт количество наносекунд часов steady_clock
+ */
+static std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief percentile - Функция вернёт перцентиль упорядоченных задержек
+ * @param inLatencies - Упорядоченные задержки (нс)
+ * @param inQuantile - Доля (0..1)
+ * @return Вернёт задержку в микросекундах (0, если задержек нет)
+ */
+static double percentile(const std::vector<std::int64_t>& inLatencies, const double inQuantile)
+{
+    double Result = 0.0;
+
+    if (!inLatencies.empty())
+    {
+        const std::size_t Index = std::min(static_cast<std::size_t>(inQuantile * inLatencies.size()), inLatencies.size() - 1);
+        Result = inLatencies[Index] / 1000.0;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief runWrapBenchmark - Функция измерит скорость обёртывания и развёртывания данных режима fmSeparator
+ * Данные насыщены служебными символами обёртки (каждый четвёртый байт - разделитель потока), замер
+ * включает копирование в буфер отправки и из буфера приёма, как при передаче.
+ * @return Вернёт результат замера
+ */
+static WrapResult runWrapBenchmark()
+{
+    static const char C_SPECIAL[] = { net::C_DATA_SEPARATOR, net::C_DATA_SEPARATOR, '{', net::C_DATA_REPLACER, '}' };
+
+    WrapResult Result;
+    Result.m_measured = true;
+
+    std::mt19937 Generator(42);
+    std::uniform_int_distribution<int> Byte(0, 255);
+    std::string Source(C_WRAP_SIZE, '\0');
+
+    for (char& Symbol : Source)
+    {
+        const int Value = Byte(Generator);
+        Symbol = (Value < 128) ? C_SPECIAL[Value % sizeof(C_SPECIAL)] : static_cast<char>(Value);
+    }
+
+    net::HMByteBuffer Wrapped;
+    net::HMByteBuffer Unwrapped;
+
+    const auto WrapStart = std::chrono::steady_clock::now();
+
+    for (std::size_t Round = 0; Round < C_WRAP_ROUNDS; ++Round)
+        Wrapped = net::wrap(net::HMByteBuffer(net::FrameView(Source)));
+
+    const auto UnwrapStart = std::chrono::steady_clock::now();
+
+    for (std::size_t Round = 0; Round < C_WRAP_ROUNDS; ++Round)
+        Unwrapped = net::unwrap(net::HMByteBuffer(Wrapped.view()));
+
+    const auto End = std::chrono::steady_clock::now();
+
+    const double Megabytes = static_cast<double>(C_WRAP_SIZE * C_WRAP_ROUNDS) / (1024 * 1024);
+    Result.m_valid = Unwrapped.view() == Source;
+    Result.m_wrapMBps = Megabytes / std::chrono::duration<double>(UnwrapStart - WrapStart).count();
+    Result.m_unwrapMBps = Megabytes / std::chrono::duration<double>(End - UnwrapStart).count();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief runHandshakeBenchmark - Функция измерит частоту полных и возобновлённых по билету сеанса рукопожатий TLS
+ * Подключение считается установленным, когда сервер принял первое сообщение клиента: запись дожидается рукопожатия.
+ * Перед каждым полным рукопожатием билеты сеансов сбрасываются.
+ * @param inBackend - Испытываемая реализация (QtSsl)
+ * @param inSettings - Параметры прогона
+ * @return Вернёт результат замера
+ */
+static HandshakeResult runHandshakeBenchmark(const Backend& inBackend, const Settings& inSettings)
+{
+    HandshakeResult Result;
+    Result.m_measured = true;
+
+    std::atomic_size_t Received = 0;
+
+    net::ServCallbacks ServCallBacks;
+    ServCallBacks.m_conCalbacks.m_DataViewCallBack = [&Received](const net::FrameView, const std::size_t) { ++Received; };
+
+    std::unique_ptr<net::HMServer> Server = inBackend.m_makeServer(ServCallBacks);
+    errors::error_code Error = Server->start();
+
+    auto HandshakeRate = [&](const bool inResume) -> double
+    {
+        const auto Start = std::chrono::steady_clock::now();
+
+        for (std::size_t Index = 0; !Error && Index < inSettings.m_handshakes; ++Index)
+        {
+            if (!inResume)
+                net::clearSessionTickets(); // Без билета клиент выполнит полное рукопожатие
+
+            const std::size_t Expected = Received + 1;
+            net::ConCallbacks ClientCallBacks;
+            std::unique_ptr<net::HMConnection> Client = inBackend.m_makeClient(ClientCallBacks);
+
+            Error = Client->connect();
+
+            if (!Error)
+                Error = Client->send(net::HMByteBuffer(std::string("ping")));
+
+            if (!Error && !processUntil([&Received, Expected]() { return Received >= Expected; }))
+                Error = make_error_code(errors::eNetError::neTimeOut);
+
+            Client->disconnect();
+        }
+
+        return inSettings.m_handshakes / std::max(std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count(), 1e-9);
+    };
+
+    net::clearSessionTickets();
+
+    Result.m_fullRate = HandshakeRate(false);
+    Result.m_resumedRate = HandshakeRate(true);
+    Result.m_completed = !Error;
+
+    net::clearSessionTickets();
+    Server->stop();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief runBenchmark - Функция измерит пропускную способность и задержку реализации на петлевом интерфейсе
+ * Сервер возвращает каждое сообщение отправителю. Клиент кладёт в начало сообщения момент отправки,
+ * поэтому задержка - полный путь туда и обратно. Клиенты отправляют сообщения с заданной частотой,
+ * держа без ответа не больше m_window сообщений. Время отсчитывается до получения последнего ответа.
+ * @param inBackend - Испытываемая реализация
+ * @param inSettings - Параметры прогона
+ * @return Вернёт результат прогона
+ */
+static RunResult runBenchmark(const Backend& inBackend, const Settings& inSettings)
+{
+    RunResult Result;
+    Result.m_name = inBackend.m_name;
+
+    std::vector<ClientState> States(inSettings.m_clients);
+    std::unique_ptr<net::HMServer> Server;
+
+    net::ServCallbacks ServCallBacks;
+    ServCallBacks.m_conCalbacks.m_DataViewCallBack = [&Server](const net::FrameView inData, const std::size_t inSenderID)
+    {
+        [[maybe_unused]] const errors::error_code Error = Server->send(inSenderID, net::HMByteBuffer(inData)); // Потерянный ответ обнаружится по истечению времени
+    };
+
+    Server = inBackend.m_makeServer(ServCallBacks);
+    errors::error_code Error = Server->start();
+
+    std::vector<std::unique_ptr<net::HMConnection>> Clients;
+
+    while (!Error && Clients.size() < inSettings.m_clients)
+    {
+        ClientState& State = States[Clients.size()];
+        State.m_latencies.assign(inSettings.m_messages, 0);
+
+        net::ConCallbacks ClientCallBacks;
+        ClientCallBacks.m_DataViewCallBack = [&State](const net::FrameView inData, const std::size_t)
+        {
+            const std::size_t Slot = State.m_received.load(std::memory_order_relaxed); // Счётчик меняет только этот поток
+
+            if (Slot < State.m_latencies.size() && inData.size() >= C_STAMP_SIZE)
+            {
+                std::int64_t SentAt = 0;
+                std::memcpy(&SentAt, inData.data(), C_STAMP_SIZE);
+                State.m_latencies[Slot] = nowNs() - SentAt;
+            }
+
+            State.m_received.fetch_add(1, std::memory_order_release); // Публикуем заполненную ячейку
+        };
+
+        Clients.push_back(inBackend.m_makeClient(ClientCallBacks));
+        Clients.back()->setFramingMode(net::eFramingMode::fmLengthPrefixed); // Метка времени двоичная и может содержать разделитель
+        Error = Clients.back()->connect();
+    }
+
+    if (!Error && !processUntil([&Server, &inSettings]() { return Server->connectionCount() == inSettings.m_clients; }))
+        Error = make_error_code(errors::eNetError::neTimeOut);
+
+    if (!Error)
+    {
+        std::string Payload(inSettings.m_payloadSize, 'x');
+        const auto Start = std::chrono::steady_clock::now();
+        const auto TimeOut = Start + C_TIMEOUT;
+
+        while (!Error && !Result.m_completed && std::chrono::steady_clock::now() < TimeOut)
+        {
+            const double Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+            const std::size_t Due = (inSettings.m_rate == 0) ? inSettings.m_messages :
+                                    std::min(inSettings.m_messages, static_cast<std::size_t>(Elapsed * inSettings.m_rate) + 1);
+            Result.m_completed = true;
+
+            for (std::size_t Index = 0; !Error && Index < Clients.size(); ++Index) // Клиенты отправляют по очереди, чтобы нагрузить все соединения сразу
+            {
+                ClientState& State = States[Index];
+                const std::size_t Received = State.m_received.load(std::memory_order_acquire);
+
+                while (!Error && State.m_sent < Due && (inSettings.m_window == 0 || State.m_sent - Received < inSettings.m_window))
+                {
+                    const std::int64_t SentAt = nowNs();
+                    std::memcpy(Payload.data(), &SentAt, C_STAMP_SIZE);
+
+                    Error = Clients[Index]->send(net::HMByteBuffer(Payload));
+                    ++State.m_sent;
+                }
+
+                Result.m_completed = Result.m_completed && Received == inSettings.m_messages;
+            }
+
+            QCoreApplication::processEvents(); // Клиентам Qt нужен цикл событий главного потока
+            std::this_thread::yield(); // Отдаём ядро циклам соединений, если их потокам не хватает ядер
+        }
+
+        Result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+        for (ClientState& State : States) // Ответы, пришедшие после чтения счётчика, не учитываются и пишут в другие ячейки
+        {
+            const std::size_t Received = std::min(State.m_received.load(std::memory_order_acquire), State.m_latencies.size());
+            Result.m_latencies.insert(Result.m_latencies.end(), State.m_latencies.begin(), State.m_latencies.begin() + Received);
+            Result.m_messages += Received;
+        }
+
+        std::sort(Result.m_latencies.begin(), Result.m_latencies.end());
+    }
+
+    if (Error)
+        Result.m_error = Error.message();
+    else if (!Result.m_completed)
+        Result.m_error = make_error_code(errors::eNetError::neTimeOut).message();
+
+    for (const auto& Client : Clients)
+        Client->disconnect();
+
+    Server->stop();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief parseSettings - Функция разберёт аргументы командной строки
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @param outSettings - Параметры прогона
+ * @return Вернёт признак успешного разбора
+ */
+static bool parseSettings(int argc, char *argv[], Settings& outSettings)
+{
+    bool Result = true;
+
+    for (int Index = 1; Result && Index < argc; ++Index)
+    {
+        const std::string Name = argv[Index];
+        const char* Value = (Index + 1 < argc) ? argv[++Index] : nullptr;
+        char* End = nullptr;
+        const std::size_t Number = (Value) ? std::strtoull(Value, &End, 10) : 0;
+        const bool IsNumber = Value && End != Value && *End == '\0';
+
+        if (Name == "--backend" && Value)
+            outSettings.m_backend = Value;
+        else if (Name == "--json" && Value)
+            outSettings.m_jsonPath = Value;
+        else if (Name == "--clients" && IsNumber && Number > 0)
+            outSettings.m_clients = Number;
+        else if (Name == "--messages" && IsNumber && Number > 0)
+            outSettings.m_messages = Number;
+        else if (Name == "--size" && IsNumber)
+            outSettings.m_payloadSize = std::max(Number, C_STAMP_SIZE);
+        else if (Name == "--rate" && IsNumber)
+            outSettings.m_rate = Number;
+        else if (Name == "--window" && IsNumber)
+            outSettings.m_window = Number;
+        else if (Name == "--workers" && IsNumber && Number > 0)
+            outSettings.m_workers = Number;
+        else if (Name == "--handshakes" && IsNumber && Number > 0)
+            outSettings.m_handshakes = Number;
+        else
+            Result = false;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeReport - Функция сформирует машиночитаемый отчёт о прогонах
+ * @param inSettings - Параметры прогона
+ * @param inResults - Результаты прогонов
+ * @param inWrap - Результат замера обёртывания
+ * @param inHandshake - Результат замера рукопожатий TLS
+ * @return Вернёт отчёт в формате JSON
+ */
+static nlohmann::json makeReport(const Settings& inSettings, const std::vector<RunResult>& inResults,
+                                 const WrapResult& inWrap, const HandshakeResult& inHandshake)
+{
+    nlohmann::json Result;
+
+    const std::time_t Now = std::time(nullptr);
+    char TimeStamp[32] = {};
+    std::strftime(TimeStamp, sizeof(TimeStamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&Now));
+
+    Result["library"] = "HawkNet";
+    Result["version"] = HawkNet::getVersion();
+    Result["timestamp"] = TimeStamp;
+    Result["settings"] = { { "clients", inSettings.m_clients },
+                           { "messages_per_client", inSettings.m_messages },
+                           { "payload_bytes", inSettings.m_payloadSize },
+                           { "rate_per_client", inSettings.m_rate },
+                           { "window", inSettings.m_window },
+                           { "server_workers", inSettings.m_workers } };
+    Result["results"] = nlohmann::json::array();
+
+    for (const RunResult& Run : inResults)
+    {
+        const double Seconds = std::max(Run.m_seconds, 1e-9);
+
+        Result["results"].push_back({ { "backend", Run.m_name },
+                                      { "completed", Run.m_completed },
+                                      { "error", Run.m_error },
+                                      { "messages", Run.m_messages },
+                                      { "seconds", Run.m_seconds },
+                                      { "msgs_per_sec", Run.m_messages / Seconds },
+                                      { "mb_per_sec", Run.m_messages * inSettings.m_payloadSize / Seconds / (1024 * 1024) },
+                                      { "latency_us", { { "p50", percentile(Run.m_latencies, 0.5) },
+                                                        { "p99", percentile(Run.m_latencies, 0.99) },
+                                                        { "p999", percentile(Run.m_latencies, 0.999) },
+                                                        { "max", percentile(Run.m_latencies, 1.0) } } } });
+    }
+
+    if (inWrap.m_measured)
+        Result["wrap"] = { { "bytes", C_WRAP_SIZE * C_WRAP_ROUNDS },
+                           { "valid", inWrap.m_valid },
+                           { "wrap_mb_per_sec", inWrap.m_wrapMBps },
+                           { "unwrap_mb_per_sec", inWrap.m_unwrapMBps } };
+
+    if (inHandshake.m_measured)
+        Result["handshake"] = { { "connections", inSettings.m_handshakes },
+                                { "completed", inHandshake.m_completed },
+                                { "full_per_sec", inHandshake.m_fullRate },
+                                { "resumed_per_sec", inHandshake.m_resumedRate } };
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка измерения пропускной способности и задержки реализаций сервера
+ * Использование: HawkNet_NetBench [--backend Qt|QtSsl|epoll|io_uring|wrap|handshake] [--clients N] [--messages N]
+ * [--size BYTES] [--rate MSG_PER_SEC] [--window N] [--workers N] [--handshakes N] [--json PATH]
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт EXIT_FAILURE, если хотя бы один прогон не завершился
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication App(argc, argv); // Обязательно создаём как приложение Qt
+
+    Settings BenchSettings;
+
+    if (!parseSettings(argc, argv, BenchSettings))
+    {
+        std::printf("usage: %s [--backend Qt|QtSsl|epoll|io_uring|wrap|handshake] [--clients N] [--messages N] [--size BYTES]"
+                    " [--rate MSG_PER_SEC] [--window N] [--workers N] [--handshakes N] [--json PATH]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const std::size_t Workers = BenchSettings.m_workers; // Все реализации получают одинаковое количество потоков
+    std::vector<Backend> Backends;
+
+    Backends.push_back({ "Qt",
+                         [Workers](net::ServCallbacks& inCallBacks) { return std::make_unique<net::HMQtSimpleAsyncServer>(C_PORT, inCallBacks, Workers); },
+                         [](net::ConCallbacks& inCallBacks) { return std::make_unique<net::HMQtSimpleAsyncConnection>(C_HOST, C_PORT, inCallBacks); } });
+
+    net::CertificatePaths Certificate; // Сертификат создаётся при конфигурировании тестов QtSslNet
+    Certificate.m_certificatePath = std::filesystem::current_path() / "certificate.crt";
+    Certificate.m_privateKey = std::filesystem::current_path() / "privateKey.key";
+
+    if (std::filesystem::exists(Certificate.m_certificatePath) && std::filesystem::exists(Certificate.m_privateKey))
+        Backends.push_back({ "QtSsl",
+                             [Workers, Certificate](net::ServCallbacks& inCallBacks) { return std::make_unique<net::HMQtSslAsyncServer>(C_PORT, Certificate, inCallBacks, Workers); },
+                             [](net::ConCallbacks& inCallBacks) { return std::make_unique<net::HMQtSslAsyncConnection>(C_HOST, C_PORT, inCallBacks); } });
+    else
+        std::printf("certificate.crt/privateKey.key not found in the working directory, QtSsl skipped\n");
+
+#if defined(__linux__)
+    Backends.push_back({ "epoll",
+                         [Workers](net::ServCallbacks& inCallBacks) { return std::make_unique<net::HMEpollAsyncServer>(C_PORT, inCallBacks, Workers); },
+                         [](net::ConCallbacks& inCallBacks) { return std::make_unique<net::HMEpollAsyncConnection>(C_HOST, C_PORT, inCallBacks); } });
+
+    if (net::HMUringLoop::isSupported())
+        Backends.push_back({ "io_uring",
+                             [Workers](net::ServCallbacks& inCallBacks) { return std::make_unique<net::HMUringAsyncServer>(C_PORT, inCallBacks, Workers); },
+                             [](net::ConCallbacks& inCallBacks) { return std::make_unique<net::HMUringAsyncConnection>(C_HOST, C_PORT, inCallBacks); } });
+    else
+        std::printf("io_uring is not supported by the kernel, skipped\n");
+#endif
+
+    std::printf("%zu clients x %zu messages x %zu bytes, rate %zu msg/s, window %zu, %zu worker threads\n",
+                BenchSettings.m_clients, BenchSettings.m_messages, BenchSettings.m_payloadSize,
+                BenchSettings.m_rate, BenchSettings.m_window, Workers);
+
+    std::vector<RunResult> Results;
+    bool Success = true;
+
+    for (const Backend& CurrentBackend : Backends)
+    {
+        if (!BenchSettings.m_backend.empty() && BenchSettings.m_backend != CurrentBackend.m_name)
+            continue;
+
+        Results.push_back(runBenchmark(CurrentBackend, BenchSettings));
+        const RunResult& Run = Results.back();
+        const double Seconds = std::max(Run.m_seconds, 1e-9);
+
+        std::printf("%-8s %10zu msgs %8.3f s %12.0f msg/s %9.2f MB/s  p50 %8.1f us  p99 %8.1f us  p999 %8.1f us%s%s\n",
+                    Run.m_name.c_str(), Run.m_messages, Run.m_seconds, Run.m_messages / Seconds,
+                    Run.m_messages * BenchSettings.m_payloadSize / Seconds / (1024 * 1024),
+                    percentile(Run.m_latencies, 0.5), percentile(Run.m_latencies, 0.99), percentile(Run.m_latencies, 0.999),
+                    Run.m_error.empty() ? "" : "  failed: ", Run.m_error.c_str());
+
+        Success = Success && Run.m_completed;
+    }
+
+    WrapResult Wrap; // Обёртывание режима fmSeparator замеряется без сети
+
+    if (BenchSettings.m_backend.empty() || BenchSettings.m_backend == "wrap")
+    {
+        Wrap = runWrapBenchmark();
+        std::printf("wrap %9.1f MB/s  unwrap %9.1f MB/s%s\n", Wrap.m_wrapMBps, Wrap.m_unwrapMBps, Wrap.m_valid ? "" : "  failed: data mismatch");
+        Success = Success && Wrap.m_valid;
+    }
+
+    HandshakeResult Handshake; // Рукопожатия замеряются только для реализации с TLS
+
+    auto SslBackend = std::find_if(Backends.begin(), Backends.end(), [](const Backend& inBackend) { return inBackend.m_name == "QtSsl"; });
+
+    if (SslBackend != Backends.end() && (BenchSettings.m_backend.empty() || BenchSettings.m_backend == "handshake"))
+    {
+        Handshake = runHandshakeBenchmark(*SslBackend, BenchSettings);
+        std::printf("handshakes %zu  full %9.1f /s  resumed %9.1f /s%s\n", BenchSettings.m_handshakes,
+                    Handshake.m_fullRate, Handshake.m_resumedRate, Handshake.m_completed ? "" : "  failed: message not delivered");
+        Success = Success && Handshake.m_completed;
+    }
+
+    std::ofstream Report(BenchSettings.m_jsonPath);
+    Report << makeReport(BenchSettings, Results, Wrap, Handshake).dump(4) << std::endl;
+
+    if (Report)
+        std::printf("results written to %s\n", BenchSettings.m_jsonPath.c_str());
+    else
+    {
+        std::printf("failed to write %s\n", BenchSettings.m_jsonPath.c_str());
+        Success = false;
+    }
+
+    App.exit(EXIT_SUCCESS); // Завершаем работу QCoreApplication
+
+    return (Success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+//-----------------------------------------------------------------------------
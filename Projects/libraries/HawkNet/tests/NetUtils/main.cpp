@@ -1,10 +1,22 @@
 #include <gtest/gtest.h>
 
+#include <map>
+#include <set>
 #include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <cstring>
 
 #include <HawkNet.h>
+#include <neterrorcategory.h>
 #include <nlohmann/json.hpp>
 
+#include "Abstract/connectionregistry.h"
+#include "Abstract/tokenbucket.h"
+#include "Buffers/framecompressor.h"
+#include "Timers/timerwheel.h"
+
 //-----------------------------------------------------------------------------
 static const std::string Data = "0123456789";
 //-----------------------------------------------------------------------------
@@ -170,6 +182,968 @@ TEST(NetUtils, SendReceiveEmitation)
     ASSERT_EQ(Text, ReceiveText);
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief makeNoisyData - Функция сформирует случайные двоичные данные, насыщенные служебными символами обёртки
+ * Каждый четвёртый байт - разделитель потока, ещё столько же приходится на скобки и символ замены,
+ * поэтому в данных встречаются и готовые замещающие последовательности.
+ * @param inSize - Размер данных
+ * @param inSeed - Начальное значение генератора
+ * @return Вернёт сформированные данные
+ */
+std::string makeNoisyData(const std::size_t inSize, const unsigned inSeed)
+{
+    static const char C_SPECIAL[] = { net::C_DATA_SEPARATOR, net::C_DATA_SEPARATOR, '{', net::C_DATA_REPLACER, '}' };
+
+    std::mt19937 Generator(inSeed);
+    std::uniform_int_distribution<int> Byte(0, 255);
+    std::string Result(inSize, '\0');
+
+    for (char& Symbol : Result)
+    {
+        const int Value = Byte(Generator);
+        Symbol = (Value < 128) ? C_SPECIAL[Value % sizeof(C_SPECIAL)] : static_cast<char>(Value);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обёртывания случайных двоичных данных
+ */
+TEST(NetUtils, WrapRandomData)
+{
+    for (unsigned Seed = 0; Seed < 200; ++Seed)
+    {
+        const std::string Source = makeNoisyData(Seed * 7, Seed); // Включая пустые и короче SIMD-блока
+
+        const std::string Wrapped = net::wrap(net::oByteStream(Source)).str();
+        EXPECT_EQ(Wrapped.find(net::C_DATA_SEPARATOR), std::string::npos); // В обёрнутых данных не должно остаться разделителей
+        EXPECT_EQ(net::unwrap(net::iByteStream(Wrapped)).str(), Source); // Исходные и развёрнутые данные должны совпасть
+    }
+
+    {
+        std::string Source = Data + "{" + net::C_DATA_REPLACER + "}" + "{" + std::string(2, net::C_DATA_REPLACER) + "}" + net::C_DATA_SEPARATOR;
+
+        nlohmann::json WrapInfo;
+        std::string WrappedData = "";
+        ASSERT_TRUE(net::getWrapAndMessageData(net::wrap(net::oByteStream(Source)).str(), WrapInfo, WrappedData));
+
+        // Обе кратчайшие последовательности заняты данными, подбирается следующая
+        EXPECT_EQ(WrapInfo[net::C_WRAP_HEAD][net::C_WRAP_SEQUENCE].get<std::string>(), "{" + std::string(3, net::C_DATA_REPLACER) + "}");
+    }
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeFrame - Функция сформирует кадр режима fmLengthPrefixed
+ * @param inPayload - Полезная нагрузка
+ * @param inFlags - Флаги кадра
+ * @return Вернёт кадр
+ */
+std::string makeFrame(const std::string& inPayload, const std::uint8_t inFlags = 0)
+{
+    std::string Result(net::C_FRAME_HEADER_SIZE, '\0');
+    net::encodeFrameHeader(static_cast<std::uint32_t>(inPayload.size()), inFlags, Result.data());
+    return Result + inPayload;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест разбора кадров с двоичным заголовком
+ */
+TEST(NetUtils, LengthPrefixedFrame)
+{
+    std::string Payload = Data;
+    Payload.insert(5, 1, net::C_DATA_SEPARATOR); // Разделитель в полезной нагрузке не экранируется
+    Payload.insert(2, 1, '\0'); // Как и нулевой символ
+    Payload = net::C_DATA_SEPARATOR + Payload + net::C_DATA_SEPARATOR;
+
+    const std::string Frame = makeFrame(Payload, net::C_FRAME_FLAG_HELLO);
+    ASSERT_EQ(Frame.size(), net::C_FRAME_HEADER_SIZE + Payload.size());
+
+    net::FrameInfo Info;
+    errors::error_code Error;
+
+    for (std::size_t Size = 0; Size < Frame.size(); ++Size) // Кадр, принятый не полностью, не разбирается
+    {
+        EXPECT_FALSE(net::nextFrame(Frame.data(), Size, Info, Error));
+        EXPECT_FALSE(Error);
+    }
+
+    ASSERT_TRUE(net::nextFrame(Frame.data(), Frame.size(), Info, Error));
+    EXPECT_FALSE(Error);
+    EXPECT_EQ(Info.m_mode, net::eFramingMode::fmLengthPrefixed);
+    EXPECT_EQ(Info.m_flags, net::C_FRAME_FLAG_HELLO);
+    EXPECT_EQ(Info.m_size, Frame.size());
+    EXPECT_EQ(Frame.substr(Info.m_offset, Info.m_length), Payload); // Полезная нагрузка не изменилась
+
+    ASSERT_TRUE(net::nextFrame(makeFrame("").data(), net::C_FRAME_HEADER_SIZE, Info, Error)); // Пустой кадр допустим
+    EXPECT_EQ(Info.m_length, 0);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест разбора потока, содержащего кадры обоих режимов
+ */
+TEST(NetUtils, MixedFramesStream)
+{
+    const std::string Binary = std::string(3, net::C_DATA_SEPARATOR) + Data;
+    const std::string Stream = Data + net::C_DATA_SEPARATOR + makeFrame(Binary) + Data + net::C_DATA_SEPARATOR;
+
+    std::vector<std::string> Received;
+    std::size_t Offset = 0;
+    net::FrameInfo Info;
+    errors::error_code Error;
+
+    while (net::nextFrame(Stream.data() + Offset, Stream.size() - Offset, Info, Error))
+    {
+        Received.push_back(Stream.substr(Offset + Info.m_offset, Info.m_length));
+        Offset += Info.m_size;
+    }
+
+    EXPECT_FALSE(Error);
+    EXPECT_EQ(Offset, Stream.size()); // Весь поток разобран
+    EXPECT_EQ(Received, std::vector<std::string>({ Data, Binary, Data }));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест разбора повреждённых заголовков
+ */
+TEST(NetUtils, InvalidFrameHeader)
+{
+    net::FrameInfo Info;
+    errors::error_code Error;
+
+    std::string Frame = makeFrame(Data);
+    Frame[net::C_FRAME_MAGIC_SIZE] = static_cast<char>(net::C_FRAME_VERSION + 1); // Неизвестная версия
+
+    EXPECT_FALSE(net::nextFrame(Frame.data(), Frame.size(), Info, Error));
+    EXPECT_EQ(Error.value(), static_cast<std::int32_t>(errors::eNetError::neInvalidFrame));
+
+    Frame = std::string(net::C_FRAME_HEADER_SIZE, '\0');
+    net::encodeFrameHeader(net::C_FRAME_MAX_LENGTH + 1, 0, Frame.data()); // Длина больше допустимой
+
+    EXPECT_FALSE(net::nextFrame(Frame.data(), Frame.size(), Info, Error));
+    EXPECT_EQ(Error.value(), static_cast<std::int32_t>(errors::eNetError::neFrameTooLarge));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест буфера приёма с потреблением по смещению
+ */
+TEST(NetUtils, ReceiveBuffer)
+{
+    net::HMReceiveBuffer Buffer(16);
+    const std::string Stream = makeFrame(Data) + makeFrame(Data) + makeFrame(Data);
+
+    // Первая порция содержит полтора кадра
+    const std::size_t FirstPart = net::C_FRAME_HEADER_SIZE + Data.size() + 5;
+    std::memcpy(Buffer.prepare(FirstPart), Stream.data(), FirstPart);
+    Buffer.commit(FirstPart);
+
+    net::FrameInfo Info;
+    errors::error_code Error;
+    std::vector<std::string> Received;
+
+    auto ReadFrames = [&]()
+    {
+        while (!Buffer.empty() && net::nextFrame(Buffer.data(), Buffer.size(), Info, Error))
+        {
+            Received.emplace_back(net::FrameView(Buffer.data() + Info.m_offset, Info.m_length));
+            Buffer.consume(Info.m_size);
+        }
+    };
+
+    ReadFrames();
+    ASSERT_EQ(Received.size(), 1);
+    EXPECT_EQ(Buffer.size(), 5); // Неполный кадр остаётся в буфере
+
+    // Остаток потока требует сдвига неполного кадра и расширения буфера
+    const std::size_t SecondPart = Stream.size() - FirstPart;
+    std::memcpy(Buffer.prepare(SecondPart), Stream.data() + FirstPart, SecondPart);
+    Buffer.commit(SecondPart);
+
+    ReadFrames();
+    EXPECT_FALSE(Error);
+    EXPECT_TRUE(Buffer.empty());
+    EXPECT_EQ(Received, std::vector<std::string>(3, Data));
+
+    Buffer.consume(100); // Потребление сверх размера ограничивается
+    EXPECT_TRUE(Buffer.empty());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест буфера сообщения
+ */
+TEST(NetUtils, ByteBuffer)
+{
+    net::HMByteBuffer Short{ net::FrameView(Data) };
+    EXPECT_EQ(Short.view(), Data);
+    EXPECT_EQ(Short.capacity(), net::C_BYTE_BUFFER_INLINE_CAPACITY); // Короткое сообщение не выделяет память
+
+    net::HMByteBuffer MovedShort(std::move(Short));
+    EXPECT_EQ(MovedShort.view(), Data);
+    EXPECT_TRUE(Short.empty()); // Перемещённый буфер остаётся пустым
+
+    const std::string Long(net::C_BYTE_BUFFER_INLINE_CAPACITY * 4, 'x');
+    net::HMByteBuffer Buffer{ net::FrameView(Long) };
+    const char* Storage = Buffer.data();
+
+    net::HMByteBuffer Moved(std::move(Buffer));
+    EXPECT_EQ(Moved.data(), Storage); // Длинное сообщение перемещается без копирования
+    EXPECT_EQ(Moved.view(), Long);
+
+    Moved.consume(10); // Срезы не сдвигают данные
+    Moved.truncate(Data.size());
+    EXPECT_EQ(Moved.data(), Storage + 10);
+    EXPECT_EQ(Moved.view(2, 3), net::FrameView(Long).substr(12, 3));
+    EXPECT_EQ(Moved.view(Moved.size() + 1, 1), net::FrameView()); // Срез за пределами сообщения пуст
+
+    const std::size_t Capacity = Moved.capacity();
+    Moved.clear();
+    Moved.append(Long);
+    EXPECT_EQ(Moved.data(), Storage); // Очищенный буфер переиспользует память
+    EXPECT_EQ(Moved.capacity(), Capacity + 10);
+
+    Moved.clear();
+    std::memcpy(Moved.extend(Data.size()), Data.data(), Data.size()); // Заполнение без промежуточного буфера
+    Moved.push_back(net::C_DATA_SEPARATOR);
+    EXPECT_EQ(Moved.view(), Data + net::C_DATA_SEPARATOR);
+
+    // Совместимость с потоковым интерфейсом
+    const net::HMByteBuffer FromStream{ net::oByteStream(Data) };
+    EXPECT_EQ(FromStream.view(), Data);
+    EXPECT_EQ(static_cast<net::iByteStream>(FromStream).str(), Data);
+
+    // Развёртывание выполняется на месте, без копирования сообщения
+    net::HMByteBuffer Wrapped = net::wrap(net::HMByteBuffer(net::FrameView(Long + net::C_DATA_SEPARATOR + Long)));
+    const char* WrappedStorage = Wrapped.data();
+    const std::size_t WrappedSize = Wrapped.size();
+
+    const net::HMByteBuffer Unwrapped = net::unwrap(std::move(Wrapped));
+    EXPECT_EQ(Unwrapped.view(), Long + net::C_DATA_SEPARATOR + Long);
+    EXPECT_GT(Unwrapped.data(), WrappedStorage);
+    EXPECT_LT(Unwrapped.data(), WrappedStorage + WrappedSize);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест сжатия кадров с общим окном
+ */
+TEST(NetUtils, FrameCompression)
+{
+    net::HMFrameDeflater Deflater;
+    net::HMFrameInflater Inflater;
+    net::HMByteBuffer Compressed;
+    net::HMByteBuffer Decompressed;
+
+    std::mt19937 Generator(7);
+    std::string Message; // Типичное сообщение: разметка с повторяющимися полями и случайными значениями
+    for (std::size_t Index = 0; Index < 64; ++Index)
+        Message += "{\"id\":" + std::to_string(Generator()) + ",\"name\":\"client\",\"state\":\"connected\"}";
+
+    if (!net::HMFrameDeflater::isSupported()) // Библиотека собрана без zlib: сжатие отклоняется
+    {
+        EXPECT_EQ(Deflater.compress(Message, 1, Compressed), make_error_code(errors::eNetError::neCompressionError));
+        return;
+    }
+
+    ASSERT_FALSE(Deflater.compress(Message, 1, Compressed));
+    const std::size_t FirstSize = Compressed.size();
+    EXPECT_LT(FirstSize, Message.size() / 2);
+
+    ASSERT_FALSE(Inflater.decompress(Compressed.view(), net::C_FRAME_MAX_LENGTH, Decompressed));
+    EXPECT_EQ(Decompressed.view(), Message);
+
+    // Повтор сообщения кодируется ссылкой на окно предыдущего кадра
+    ASSERT_FALSE(Deflater.compress(Message, 1, Compressed));
+    EXPECT_LT(Compressed.size(), FirstSize / 4);
+
+    ASSERT_FALSE(Inflater.decompress(Compressed.view(), net::C_FRAME_MAX_LENGTH, Decompressed));
+    EXPECT_EQ(Decompressed.view(), Message);
+
+    // Несжимаемые данные и пустой кадр проходят без искажений
+    std::string Noise(70000, '\0');
+    for (char& Byte : Noise)
+        Byte = static_cast<char>(Generator());
+
+    for (const std::string& Payload : { Noise, std::string() })
+    {
+        ASSERT_FALSE(Deflater.compress(Payload, 1, Compressed));
+        ASSERT_FALSE(Inflater.decompress(Compressed.view(), net::C_FRAME_MAX_LENGTH, Decompressed));
+        EXPECT_EQ(Decompressed.view(), Payload);
+    }
+
+    // Новый сеанс сжатия распаковывается прежним окном: сброс отправителя не требует согласования
+    Deflater.reset();
+    ASSERT_FALSE(Deflater.compress(Message, 9, Compressed));
+    ASSERT_FALSE(Inflater.decompress(Compressed.view(), net::C_FRAME_MAX_LENGTH, Decompressed));
+    EXPECT_EQ(Decompressed.view(), Message);
+
+    // Распаковка ограничена пределом размера кадра
+    ASSERT_FALSE(Deflater.compress(Message, 1, Compressed));
+    EXPECT_EQ(Inflater.decompress(Compressed.view(), Message.size() - 1, Decompressed), make_error_code(errors::eNetError::neFrameTooLarge));
+
+    net::HMFrameInflater Corrupted;
+    EXPECT_EQ(Corrupted.decompress(std::string(16, '\xFF'), net::C_FRAME_MAX_LENGTH, Decompressed), make_error_code(errors::eNetError::neCompressionError));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief The TestAsyncConnection class - Соединение, записывающее пачки в память вместо сокета
+ */
+class TestAsyncConnection : public net::HMAbstractAsyncConnection
+{
+public:
+
+    std::vector<std::string> m_writes; ///< Выполненные записи
+    std::vector<std::uint8_t> m_flags; ///< Флаги подготовленных сообщений
+    errors::error_code m_disconnectReason; ///< Причина запрошенного разрыва
+
+    /**
+     * @brief TestAsyncConnection - Инициализирующий конструктор
+     * @param inCallbacks - Перечень калбеков
+     */
+    TestAsyncConnection(const net::ConCallbacks& inCallbacks = net::ConCallbacks()) : net::HMAbstractAsyncConnection(inCallbacks) {}
+
+    virtual errors::error_code connect(const std::chrono::milliseconds) override
+    { return make_error_code(errors::eNetError::neSuccess); }
+
+    virtual errors::error_code connectAsync(const std::chrono::milliseconds) override
+    { return make_error_code(errors::eNetError::neSuccess); }
+
+    virtual net::eConnectionStatus status() const override
+    { return net::eConnectionStatus::csConnected; }
+
+    virtual void retire(std::shared_ptr<net::HMAbstractConnection>&&) override {}
+
+    /**
+     * @brief complete - Метод имитирует подтверждение записи сокетом
+     */
+    void complete()
+    { afterWrite(); }
+
+    /**
+     * @brief check - Метод выполнит проверку сроков соединения в указанный момент
+     * @param inNow - Момент проверки
+     * @return Вернёт срок следующей проверки
+     */
+    std::chrono::steady_clock::time_point check(const std::chrono::steady_clock::time_point inNow)
+    { return checkTimers(inNow); }
+
+    /**
+     * @brief receive - Метод имитирует приём кадра режима fmLengthPrefixed
+     * @param inFlags - Флаги кадра
+     * @param inData - Полезная нагрузка кадра
+     */
+    void receive(const std::uint8_t inFlags, const net::FrameView inData = net::FrameView())
+    {
+        net::FrameInfo Frame;
+        Frame.m_mode = net::eFramingMode::fmLengthPrefixed;
+        Frame.m_flags = inFlags;
+        Frame.m_length = static_cast<std::uint32_t>(inData.size());
+
+        markActivity();
+        onReadFrame(Frame, inData);
+    }
+
+protected:
+
+    virtual void prepateNextData(net::OutFrame&& inFrame) override
+    {
+        m_flags.push_back(inFrame.m_flags);
+        m_pending += (inFrame.m_shared) ? inFrame.m_shared->str() + net::C_DATA_SEPARATOR : inFrame.m_data.str();
+    }
+
+    virtual void write() override
+    { m_writes.push_back(std::move(m_pending)); m_pending.clear(); }
+
+    virtual void disconnectLater(const errors::error_code inReason) override
+    { m_disconnectReason = inReason; }
+
+    virtual void armTimers() override {}
+
+private:
+
+    std::string m_pending; ///< Подготавливаемая запись
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест объединения очереди отправки в пачки
+ */
+TEST(NetUtils, WriteCoalescing)
+{
+    TestAsyncConnection Connection;
+    const std::string Sep(1, net::C_DATA_SEPARATOR);
+
+    for (const std::string Text : { "a", "b", "c" })
+        ASSERT_FALSE(Connection.send(net::oByteStream(Text)));
+
+    ASSERT_EQ(Connection.m_writes.size(), 1); // Первое сообщение записывается сразу, остальные ждут в очереди
+    EXPECT_EQ(Connection.m_writes[0], "a" + Sep);
+
+    Connection.complete();
+    ASSERT_EQ(Connection.m_writes.size(), 2); // Накопленные сообщения уходят одной записью
+    EXPECT_EQ(Connection.m_writes[1], "b" + Sep + "c" + Sep);
+
+    Connection.complete(); // Очередь пуста, запись завершается
+    ASSERT_EQ(Connection.m_writes.size(), 2);
+
+    const std::string Large(net::C_WRITE_BATCH_LIMIT * 2 / 3, 'z'); // Два таких сообщения превышают предел пачки
+    ASSERT_FALSE(Connection.send(net::oByteStream(Data)));
+
+    for (std::size_t Index = 0; Index < 3; ++Index)
+        ASSERT_FALSE(Connection.send(net::oByteStream(Large)));
+
+    Connection.complete();
+    ASSERT_EQ(Connection.m_writes.size(), 4);
+    EXPECT_EQ(Connection.m_writes[3].size(), (Large.size() + 1) * 2); // Пачка ограничена пределом
+
+    Connection.complete();
+    ASSERT_EQ(Connection.m_writes.size(), 5);
+    EXPECT_EQ(Connection.m_writes[4], Large + Sep);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест постановки разделяемых данных в очереди нескольких соединений
+ */
+TEST(NetUtils, SharedPayload)
+{
+    std::vector<TestAsyncConnection> Connections(3);
+    const net::SharedPayload Payload = std::make_shared<const net::HMByteBuffer>(net::FrameView(Data));
+
+    for (auto& Connection : Connections)
+        ASSERT_FALSE(Connection.send(net::oByteStream(Data))); // Занимаем запись, чтобы данные остались в очереди
+
+    for (auto& Connection : Connections)
+        ASSERT_FALSE(Connection.sendShared(Payload));
+
+    EXPECT_EQ(static_cast<std::size_t>(Payload.use_count()), Connections.size() + 1); // Очереди ссылаются на данные, а не копируют их
+
+    for (auto& Connection : Connections)
+    {
+        Connection.complete();
+        ASSERT_EQ(Connection.m_writes.size(), 2);
+        EXPECT_EQ(Connection.m_writes[1], Data + net::C_DATA_SEPARATOR);
+    }
+
+    EXPECT_EQ(Payload.use_count(), 1); // После записи ссылки освобождены
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест реакций на переполнение очереди отправки
+ */
+TEST(NetUtils, SendQueueLimits)
+{
+    std::size_t DrainedCount = 0;
+    net::ConCallbacks Callbacks;
+    Callbacks.m_DrainedCallBack = [&DrainedCount](const std::size_t) { DrainedCount++; };
+
+    const errors::error_code QueueFull = make_error_code(errors::eNetError::neSendQueueFull);
+    const std::string Sep(1, net::C_DATA_SEPARATOR);
+    net::SendQueueLimits Limits;
+    Limits.m_maxMessages = 2;
+
+    TestAsyncConnection Rejecting(Callbacks);
+    Rejecting.setSendQueueLimits(Limits);
+
+    for (const std::string Text : { "a", "b", "c" }) // Первое сообщение сразу уходит на запись, два остаются в очереди
+        ASSERT_FALSE(Rejecting.send(net::oByteStream(Text)));
+
+    EXPECT_EQ(Rejecting.send(net::oByteStream("d")), QueueFull);
+    EXPECT_EQ(DrainedCount, 0);
+
+    Rejecting.complete();
+    ASSERT_EQ(Rejecting.m_writes.size(), 2);
+    EXPECT_EQ(Rejecting.m_writes[1], "b" + Sep + "c" + Sep); // Отклонённое сообщение в очередь не попало
+    EXPECT_EQ(DrainedCount, 1); // Отправитель оповещён один раз
+
+    Rejecting.complete();
+    EXPECT_EQ(DrainedCount, 1);
+
+    Limits.m_policy = net::eQueueOverflowPolicy::qpDropOldest;
+    TestAsyncConnection Dropping(Callbacks);
+    Dropping.setSendQueueLimits(Limits);
+
+    for (const std::string Text : { "a", "b", "c", "d", "e" })
+        ASSERT_FALSE(Dropping.send(net::oByteStream(Text)));
+
+    Dropping.complete();
+    ASSERT_EQ(Dropping.m_writes.size(), 2);
+    EXPECT_EQ(Dropping.m_writes[1], "d" + Sep + "e" + Sep); // Вытеснены самые старые сообщения
+    EXPECT_EQ(DrainedCount, 2);
+
+    Limits.m_policy = net::eQueueOverflowPolicy::qpDisconnect;
+    Limits.m_maxMessages = 0;
+    Limits.m_maxBytes = 4;
+    TestAsyncConnection Disconnecting(Callbacks);
+    Disconnecting.setSendQueueLimits(Limits);
+
+    ASSERT_FALSE(Disconnecting.send(net::oByteStream("a")));
+    ASSERT_FALSE(Disconnecting.send(net::oByteStream("bcd"))); // Вместе с разделителем ровно 4 байта
+    EXPECT_FALSE(Disconnecting.m_disconnectReason);
+
+    EXPECT_EQ(Disconnecting.send(net::oByteStream("e")), QueueFull);
+    EXPECT_EQ(Disconnecting.m_disconnectReason, QueueFull); // Разрыв запрошен с причиной переполнения
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверки связи и разрыва по простою
+ */
+TEST(NetUtils, Heartbeat)
+{
+    using namespace std::chrono_literals;
+
+    TestAsyncConnection Connection;
+    EXPECT_EQ(Connection.check(std::chrono::steady_clock::now()), std::chrono::steady_clock::time_point::max()); // Проверка не настроена
+
+    net::HeartbeatSettings Settings;
+    Settings.m_interval = 100ms;
+    Settings.m_idleTimeout = 300ms;
+    Connection.setHeartbeat(Settings);
+
+    Connection.receive(net::C_FRAME_FLAG_PONG); // Начинаем отсчёт простоя с приёма данных
+    const auto Start = std::chrono::steady_clock::now();
+
+    EXPECT_LE(Connection.check(Start), Start + 100ms); // Следующая проверка - отправка проверки связи
+    EXPECT_TRUE(Connection.m_flags.empty());
+
+    const auto Next = Connection.check(Start + 100ms);
+    ASSERT_EQ(Connection.m_flags.size(), 1); // Отправлен кадр проверки связи
+    EXPECT_EQ(Connection.m_flags[0], net::C_FRAME_FLAG_PING);
+    EXPECT_EQ(Connection.framingMode(), net::eFramingMode::fmSeparator); // Служебный кадр не меняет режим отправки
+    EXPECT_GE(Next, Start + 100ms);
+    EXPECT_LE(Next, Start + 200ms);
+    EXPECT_FALSE(Connection.m_disconnectReason);
+
+    Connection.complete();
+    Connection.receive(net::C_FRAME_FLAG_PING); // На проверку связи партнёра отвечаем
+    ASSERT_EQ(Connection.m_flags.size(), 2);
+    EXPECT_EQ(Connection.m_flags[1], net::C_FRAME_FLAG_PONG);
+    EXPECT_EQ(Connection.framingMode(), net::eFramingMode::fmSeparator);
+
+    Connection.complete();
+    const auto Received = std::chrono::steady_clock::now(); // Приём сбросил отсчёт простоя
+    EXPECT_FALSE(Connection.check(Received + 250ms) == std::chrono::steady_clock::time_point::max());
+    EXPECT_FALSE(Connection.m_disconnectReason);
+
+    Connection.check(Received + 1s); // Партнёр молчит дольше m_idleTimeout
+    EXPECT_EQ(Connection.m_disconnectReason, make_error_code(errors::eNetError::neIdleTimeout));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест сопоставления запросов и ответов по идентификатору
+ */
+TEST(NetUtils, RequestPipelining)
+{
+    using namespace std::chrono_literals;
+
+    std::vector<std::pair<std::uint32_t, std::string>> Requests; // Принятые запросы партнёра
+    net::ConCallbacks Callbacks;
+    Callbacks.m_RequestCallBack = [&](const net::FrameView inData, const std::size_t, const std::uint32_t inRequestID)
+    { Requests.emplace_back(inRequestID, std::string(inData)); };
+
+    TestAsyncConnection Connection(Callbacks);
+    std::map<std::string, std::pair<errors::error_code, std::string>> Responses; // Результаты запросов по их данным
+
+    const auto Track = [&](const std::string& inName)
+    {
+        return [&Responses, inName](const errors::error_code inError, net::HMByteBuffer&& inData)
+        {
+            EXPECT_EQ(Responses.count(inName), 0); // Обработчик вызывается ровно один раз
+            Responses[inName] = { inError, inData.str() };
+        };
+    };
+
+    const auto IdOf = [](const std::string& inWrite)
+    {
+        std::uint32_t Result = 0;
+        for (std::size_t Index = 0; Index < net::C_REQUEST_ID_SIZE; ++Index)
+            Result |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(inWrite[Index])) << (Index * 8);
+        return Result;
+    };
+
+    const auto Tagged = [](const std::uint32_t inRequestID, const std::string& inData)
+    {
+        std::string Result(net::C_REQUEST_ID_SIZE, '\0');
+        for (std::size_t Index = 0; Index < net::C_REQUEST_ID_SIZE; ++Index)
+            Result[Index] = static_cast<char>((inRequestID >> (Index * 8)) & 0xFF);
+        return Result + inData;
+    };
+
+    // Три запроса уходят подряд, не дожидаясь ответов
+    for (const std::string Name : { "a", "b", "c" })
+    {
+        ASSERT_FALSE(Connection.request(net::oByteStream(Name), Track(Name), (Name == "c") ? 50ms : 5s));
+        Connection.complete();
+    }
+
+    ASSERT_EQ(Connection.m_writes.size(), 3);
+    std::vector<std::uint32_t> IDs;
+
+    for (std::size_t Index = 0; Index < Connection.m_writes.size(); ++Index)
+    {
+        ASSERT_EQ(Connection.m_flags[Index], net::C_FRAME_FLAG_REQUEST);
+        EXPECT_EQ(Connection.m_writes[Index].substr(net::C_REQUEST_ID_SIZE), std::string(1, char('a' + Index)));
+        IDs.push_back(IdOf(Connection.m_writes[Index]));
+    }
+
+    EXPECT_NE(IDs[0], IDs[1]);
+    EXPECT_NE(IDs[1], IDs[2]);
+
+    // Ответы приходят в обратном порядке и находят свои запросы
+    std::string Response = Tagged(IDs[1], "B");
+    Connection.receive(net::C_FRAME_FLAG_RESPONSE, Response);
+    Response = Tagged(IDs[0], "A");
+    Connection.receive(net::C_FRAME_FLAG_RESPONSE, Response);
+
+    ASSERT_EQ(Responses.size(), 2);
+    EXPECT_FALSE(Responses["a"].first);
+    EXPECT_EQ(Responses["a"].second, "A");
+    EXPECT_FALSE(Responses["b"].first);
+    EXPECT_EQ(Responses["b"].second, "B");
+
+    Connection.receive(net::C_FRAME_FLAG_RESPONSE, Response); // Повторный ответ отбрасывается
+    EXPECT_EQ(Responses.size(), 2);
+
+    // Срок запроса "c" истекает, запоздавший ответ отбрасывается
+    const auto Next = Connection.check(std::chrono::steady_clock::now() + 1s);
+    EXPECT_EQ(Next, std::chrono::steady_clock::time_point::max());
+    ASSERT_EQ(Responses.count("c"), 1);
+    EXPECT_EQ(Responses["c"].first, make_error_code(errors::eNetError::neTimeOut));
+
+    Response = Tagged(IDs[2], "C");
+    Connection.receive(net::C_FRAME_FLAG_RESPONSE, Response);
+    EXPECT_EQ(Responses["c"].first, make_error_code(errors::eNetError::neTimeOut));
+
+    // Запрос партнёра передаётся обработчику, ответ несёт его идентификатор
+    const std::string Incoming = Tagged(77, "ping");
+    Connection.receive(net::C_FRAME_FLAG_REQUEST, Incoming);
+    ASSERT_EQ(Requests.size(), 1);
+    EXPECT_EQ(Requests[0].first, 77u);
+    EXPECT_EQ(Requests[0].second, "ping");
+
+    ASSERT_FALSE(Connection.respond(Requests[0].first, net::oByteStream("pong")));
+    Connection.complete();
+    EXPECT_EQ(Connection.m_flags.back(), net::C_FRAME_FLAG_RESPONSE);
+    EXPECT_EQ(Connection.m_writes.back(), Incoming.substr(0, net::C_REQUEST_ID_SIZE) + "pong");
+
+    Connection.receive(net::C_FRAME_FLAG_REQUEST, "ab"); // Кадр короче идентификатора обработчику не передаётся
+    EXPECT_EQ(Requests.size(), 1);
+
+    // Разрыв соединения завершает ожидающие запросы
+    ASSERT_FALSE(Connection.request(net::oByteStream("d"), Track("d")));
+    Connection.disconnect();
+    ASSERT_EQ(Responses.count("d"), 1);
+    EXPECT_EQ(Responses["d"].first, make_error_code(errors::eNetError::neNotConnected));
+    EXPECT_TRUE(Responses["d"].second.empty());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест данных с подтверждением доставки
+ */
+TEST(NetUtils, AckedSend)
+{
+    using namespace std::chrono_literals;
+
+    std::vector<std::string> Received; // Данные, переданные обработчику
+    net::ConCallbacks Callbacks;
+    Callbacks.m_DataCallBack = [&](net::HMByteBuffer&& inData, const std::size_t) { Received.push_back(inData.str()); };
+
+    TestAsyncConnection Connection(Callbacks);
+    std::vector<errors::error_code> Acks; // Результаты ожидания подтверждений
+
+    const auto Track = [&Acks](const errors::error_code inError, net::HMByteBuffer&&) { Acks.push_back(inError); };
+
+    const auto Tagged = [](const std::uint32_t inRequestID, const std::string& inData)
+    {
+        std::string Result(net::C_REQUEST_ID_SIZE, '\0');
+        for (std::size_t Index = 0; Index < net::C_REQUEST_ID_SIZE; ++Index)
+            Result[Index] = static_cast<char>((inRequestID >> (Index * 8)) & 0xFF);
+        return Result + inData;
+    };
+
+    // Данные уходят кадром с идентификатором и ждут пустого ответа
+    ASSERT_FALSE(Connection.sendAcked(net::oByteStream("data"), Track, 5s));
+    Connection.complete();
+
+    ASSERT_EQ(Connection.m_writes.size(), 1);
+    ASSERT_EQ(Connection.m_flags[0], net::C_FRAME_FLAG_ACKED);
+    EXPECT_EQ(Connection.m_writes[0].substr(net::C_REQUEST_ID_SIZE), "data");
+    EXPECT_TRUE(Acks.empty());
+
+    std::string Ack = Connection.m_writes[0].substr(0, net::C_REQUEST_ID_SIZE);
+    Connection.receive(net::C_FRAME_FLAG_RESPONSE, Ack);
+    ASSERT_EQ(Acks.size(), 1);
+    EXPECT_FALSE(Acks[0]);
+
+    // Данные партнёра передаются обработчику данных и подтверждаются после него
+    const std::string Incoming = Tagged(42, "payload");
+    Connection.receive(net::C_FRAME_FLAG_ACKED, Incoming);
+    Connection.complete();
+
+    ASSERT_EQ(Received, std::vector<std::string>({ "payload" }));
+    EXPECT_EQ(Connection.m_flags.back(), net::C_FRAME_FLAG_RESPONSE);
+    EXPECT_EQ(Connection.m_writes.back(), Incoming.substr(0, net::C_REQUEST_ID_SIZE));
+
+    // Неподтверждённые данные завершаются по сроку и разрывом
+    ASSERT_FALSE(Connection.sendAcked(net::oByteStream("late"), Track, 50ms));
+    Connection.check(std::chrono::steady_clock::now() + 1s);
+    ASSERT_EQ(Acks.size(), 2);
+    EXPECT_EQ(Acks[1], make_error_code(errors::eNetError::neTimeOut));
+
+    ASSERT_FALSE(Connection.sendAcked(net::oByteStream("lost"), Track));
+    Connection.disconnect();
+    ASSERT_EQ(Acks.size(), 3);
+    EXPECT_EQ(Acks[2], make_error_code(errors::eNetError::neNotConnected));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест иерархического колеса таймеров
+ */
+TEST(NetUtils, TimerWheel)
+{
+    using namespace std::chrono_literals;
+
+    const auto Origin = std::chrono::steady_clock::now();
+    net::HMTimerWheel Wheel(10ms, Origin);
+    std::vector<int> Fired;
+
+    EXPECT_EQ(Wheel.nextTimeout(Origin), -1ms); // Пустое колесо ждать нечего
+
+    net::HMWheelTimer Near([&Fired]() { Fired.push_back(1); });
+    net::HMWheelTimer Far([&Fired]() { Fired.push_back(2); });
+    net::HMWheelTimer Cancelled([&Fired]() { Fired.push_back(3); });
+
+    Wheel.schedule(Near, Origin + 25ms);
+    Wheel.schedule(Far, Origin + 1h); // Срок на верхнем уровне колеса
+    Wheel.schedule(Cancelled, Origin + 25ms);
+    EXPECT_EQ(Wheel.size(), 3);
+    EXPECT_EQ(Wheel.nextTimeout(Origin), 30ms); // Срок округляется до шага вверх
+
+    Cancelled.cancel();
+    EXPECT_FALSE(Cancelled.isScheduled());
+
+    EXPECT_EQ(Wheel.advance(Origin + 24ms), 0); // Раньше срока таймер не срабатывает
+    EXPECT_EQ(Wheel.advance(Origin + 30ms), 1);
+    EXPECT_EQ(Fired, std::vector<int>({ 1 }));
+    EXPECT_FALSE(Near.isScheduled());
+
+    Wheel.schedule(Near, Origin + 50ms);
+    Wheel.schedule(Near, Origin + 2s); // Повторная постановка переносит таймер
+    EXPECT_EQ(Wheel.advance(Origin + 1s), 0);
+
+    EXPECT_EQ(Wheel.advance(Origin + 2s), 1); // Перенос с верхних уровней сохраняет срок
+    EXPECT_EQ(Fired, std::vector<int>({ 1, 1 }));
+
+    EXPECT_EQ(Wheel.advance(Origin + 1h - 10ms), 0);
+    EXPECT_EQ(Wheel.advance(Origin + 1h), 1);
+    EXPECT_EQ(Fired, std::vector<int>({ 1, 1, 2 }));
+    EXPECT_EQ(Wheel.size(), 0);
+
+    // Таймер, переставляющий себя из обработчика, срабатывает на каждом шаге
+    std::size_t Ticks = 0;
+    auto Now = Origin + 1h;
+    net::HMWheelTimer Periodic;
+    Periodic.setCallback([&]() { if (++Ticks < 5) Wheel.schedule(Periodic, Now); });
+
+    Wheel.schedule(Periodic, Now);
+    for (std::size_t Step = 0; Step < 10; ++Step)
+    {
+        Now += 10ms;
+        Wheel.advance(Now);
+    }
+
+    EXPECT_EQ(Ticks, 5);
+    EXPECT_EQ(Wheel.size(), 0);
+
+    // Много таймеров с разными сроками срабатывают строго по возрастанию сроков
+    std::vector<std::unique_ptr<net::HMWheelTimer>> Timers;
+    std::vector<std::chrono::milliseconds> Order;
+    std::mt19937 Generator(42);
+
+    for (std::size_t Index = 0; Index < 1000; ++Index)
+    {
+        const std::chrono::milliseconds Delay((Generator() % 100000) * 10); // Кратно шагу, до ~17 минут
+        Timers.push_back(std::make_unique<net::HMWheelTimer>([&Order, Delay]() { Order.push_back(Delay); }));
+        Wheel.schedule(*Timers.back(), Now + Delay);
+    }
+
+    for (auto Step = Now; Step <= Now + 1000s; Step += 10ms)
+        Wheel.advance(Step);
+
+    ASSERT_EQ(Order.size(), Timers.size());
+    EXPECT_TRUE(std::is_sorted(Order.begin(), Order.end()));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест выдачи идентификаторов реестром соединений
+ */
+TEST(NetUtils, ConnectionRegistry)
+{
+    net::HMConnectionRegistry Registry;
+    std::vector<std::shared_ptr<net::HMAbstractConnection>> Connections;
+    std::set<std::size_t> IDs;
+
+    for (std::size_t Index = 0; Index < 3; ++Index)
+    {
+        Connections.push_back(std::make_shared<TestAsyncConnection>());
+        const std::size_t ID = Registry.insert(Connections.back());
+
+        ASSERT_NE(ID, 0);
+        EXPECT_EQ(Connections.back()->getID(), ID); // Соединение получает выданный идентификатор
+        EXPECT_EQ(Registry.find(ID), Connections.back());
+        IDs.insert(ID);
+    }
+
+    EXPECT_EQ(IDs.size(), 3); // Идентификаторы уникальны
+    EXPECT_EQ(Registry.size(), 3);
+
+    const std::size_t StaleID = Connections[1]->getID();
+    EXPECT_EQ(Registry.extract(StaleID), Connections[1]);
+    EXPECT_EQ(Registry.extract(StaleID), nullptr); // Повторно не извлекается
+
+    const std::size_t ReusedID = Registry.insert(std::make_shared<TestAsyncConnection>()); // Занимает освобождённую ячейку
+    EXPECT_NE(ReusedID, StaleID); // Но с новым поколением
+    EXPECT_EQ(Registry.find(StaleID), nullptr); // Устаревший идентификатор нового владельца не находит
+    EXPECT_NE(Registry.find(ReusedID), nullptr);
+
+    constexpr std::size_t UserID = 24680; // Идентификатор, назначенный пользователем
+    const std::size_t FirstID = Connections[0]->getID();
+
+    EXPECT_EQ(Registry.rename(StaleID, UserID).value(), static_cast<std::int32_t>(errors::eNetError::neClientNotFound));
+    EXPECT_EQ(Registry.rename(FirstID, ReusedID).value(), static_cast<std::int32_t>(errors::eNetError::neClientIdAlredyExists));
+    EXPECT_FALSE(Registry.rename(FirstID, UserID));
+
+    EXPECT_EQ(Registry.find(UserID), Connections[0]);
+    EXPECT_EQ(Registry.find(FirstID), nullptr);
+    EXPECT_EQ(Connections[0]->getID(), UserID);
+
+    EXPECT_FALSE(Registry.rename(UserID, FirstID)); // Возврат прежнего идентификатора
+    EXPECT_EQ(Registry.find(FirstID), Connections[0]);
+    EXPECT_EQ(Registry.find(UserID), nullptr);
+
+    EXPECT_FALSE(Registry.rename(FirstID, UserID));
+    EXPECT_EQ(Registry.extract(UserID), Connections[0]); // Соединение под псевдонимом извлекается так же
+    EXPECT_EQ(Registry.find(UserID), nullptr);
+
+    EXPECT_EQ(Registry.size(), 2);
+    EXPECT_EQ(Registry.extractAll().size(), 2);
+    EXPECT_EQ(Registry.size(), 0);
+    EXPECT_TRUE(Registry.snapshot().empty());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ведра жетонов
+ */
+TEST(NetUtils, TokenBucket)
+{
+    using namespace std::chrono_literals;
+
+    net::HMTokenBucket Bucket;
+    const auto Start = std::chrono::steady_clock::now();
+
+    EXPECT_FALSE(Bucket.isLimited());
+    for (std::size_t Index = 0; Index < 1000; ++Index)
+        ASSERT_TRUE(Bucket.tryTake(1000000, Start)); // Без ограничения изъятия не считаются
+
+    Bucket.configure(10, 5); // 10 жетонов в секунду, запас 5
+    EXPECT_TRUE(Bucket.isLimited());
+
+    for (std::size_t Index = 0; Index < 5; ++Index)
+        EXPECT_TRUE(Bucket.tryTake(1, Start)); // Запас расходуется сразу
+
+    EXPECT_FALSE(Bucket.tryTake(1, Start));
+    EXPECT_FALSE(Bucket.tryTake(1, Start + 50ms)); // Жетон пополняется за 100 мс
+    EXPECT_TRUE(Bucket.tryTake(1, Start + 100ms));
+    EXPECT_FALSE(Bucket.tryTake(1, Start + 100ms));
+
+    EXPECT_TRUE(Bucket.tryTake(1, Start + 10s)); // Полное ведро не копит жетоны сверх запаса
+    std::size_t Taken = 1;
+    while (Bucket.tryTake(1, Start + 10s))
+        ++Taken;
+    EXPECT_EQ(Taken, 5);
+
+    // Изъятие больше запаса проходит из полного ведра в долг, следующие ждут его погашения
+    Bucket.configure(1000, 100);
+    EXPECT_TRUE(Bucket.tryTake(500, Start));
+    EXPECT_FALSE(Bucket.tryTake(1, Start + 300ms));
+    EXPECT_TRUE(Bucket.tryTake(1, Start + 450ms));
+
+    // Возвращённые жетоны снова доступны
+    Bucket.configure(10, 2);
+    EXPECT_TRUE(Bucket.tryTake(1, Start));
+    EXPECT_TRUE(Bucket.tryTake(1, Start));
+    EXPECT_FALSE(Bucket.tryTake(1, Start));
+    Bucket.refund(1);
+    EXPECT_TRUE(Bucket.tryTake(1, Start));
+    EXPECT_FALSE(Bucket.tryTake(1, Start));
+
+    // Конкурентные изъятия не превышают запас
+    constexpr std::size_t C_THREADS = 8;
+    Bucket.configure(1, 1000);
+    std::atomic_size_t Granted = 0;
+    std::vector<std::thread> Threads;
+
+    for (std::size_t Thread = 0; Thread < C_THREADS; ++Thread)
+        Threads.emplace_back([&]()
+        {
+            for (std::size_t Index = 0; Index < 1000; ++Index)
+                if (Bucket.tryTake(1, Start))
+                    ++Granted;
+        });
+
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(Granted, 1000);
+
+    Bucket.configure(0, 0); // Снятие ограничения
+    EXPECT_TRUE(Bucket.tryTake(1000000, Start));
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест пределов частоты входящих кадров соединения
+ */
+TEST(NetUtils, RateLimits)
+{
+    std::size_t Delivered = 0; // Кадры, переданные обработчику
+    std::vector<errors::error_code> Errors; // Ошибки соединения
+
+    net::ConCallbacks Callbacks;
+    Callbacks.m_DataCallBack = [&](net::HMByteBuffer&&, const std::size_t) { ++Delivered; };
+    Callbacks.m_ErrorCallBack = [&](const errors::error_code inError, const std::size_t) { Errors.push_back(inError); };
+
+    TestAsyncConnection Connection(Callbacks);
+
+    net::RateLimits Limits;
+    Limits.m_framesPerSecond = 1; // Пополнение за время теста не успеет
+    Limits.m_frameBurst = 3;
+    Connection.setRateLimits(Limits);
+    EXPECT_EQ(Connection.rateLimits().m_frameBurst, 3);
+
+    for (std::size_t Index = 0; Index < 10; ++Index)
+        Connection.receive(0, "data");
+
+    EXPECT_EQ(Delivered, 3);
+    ASSERT_EQ(Errors.size(), 1); // Об ошибке сообщается один раз на серию
+    EXPECT_EQ(Errors[0], make_error_code(errors::eNetError::neRateLimited));
+
+    const net::ConnectionStats Stats = Connection.stats();
+    EXPECT_EQ(Stats.m_limitedFrames, 7);
+    EXPECT_EQ(Stats.m_limitedBytes, 7 * std::strlen("data"));
+
+    // Предел потока байт
+    Limits = net::RateLimits();
+    Limits.m_bytesPerSecond = 1;
+    Limits.m_byteBurst = 10;
+    Connection.setRateLimits(Limits);
+
+    const std::string Big(64, 'x');
+    Connection.receive(0, Big); // Кадр больше запаса проходит из полного ведра в долг
+    Connection.receive(0, "y");
+    EXPECT_EQ(Delivered, 4);
+    EXPECT_EQ(Errors.size(), 2); // Новая серия после пропущенного кадра
+
+    Connection.setRateLimits(net::RateLimits()); // Снятие ограничения
+    Connection.receive(0, "z");
+    EXPECT_EQ(Delivered, 5);
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief main - Входная точка тестировани функционала errors::error_code
  * @param argc - Количество аргументов
@@ -33,12 +33,14 @@ public:
      * @brief make_server - Метод сконструирует сервер
      * @param inCallBacks - Калбэки сервера
      * @param inPort - Прослушиваемый порт
+     * @param inWorkers - Количество рабочих потоков сервера
      * @return Вернёт указатель на интерфейс сервера
      */
     virtual std::unique_ptr<net::HMServer> make_server(net::ServCallbacks& inCallBacks,
-                                                       const std::uint16_t inPort = C_PORT) override
+                                                       const std::uint16_t inPort = C_PORT,
+                                                       const std::size_t inWorkers = 0) override
     {
-        return std::make_unique<net::HMQtSimpleAsyncServer>(inPort, inCallBacks);
+        return std::make_unique<net::HMQtSimpleAsyncServer>(inPort, inCallBacks, inWorkers);
     }
 
     /**
@@ -168,6 +170,30 @@ TEST(QtSimpleNet, Echo)
     HawkNet_Echo(std::make_unique<QtSimpleNetTestBuilder>());
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи двоичных данных в режиме кадров с заголовком
+ */
+TEST(QtSimpleNet, LengthPrefixedFraming)
+{
+    HawkNet_LengthPrefixedFraming(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест приёма пачки мелких сообщений
+ */
+TEST(QtSimpleNet, ReceiveBurst)
+{
+    HawkNet_ReceiveBurst(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обслуживания соединений рабочими потоками сервера
+ */
+TEST(QtSimpleNet, WorkerThreads)
+{
+    HawkNet_WorkerThreads(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест нагрузки
  */
@@ -176,6 +202,62 @@ TEST(QtSimpleNet, StressTest)
     HawkNet_StressTest(std::make_unique<QtSimpleNetTestBuilder>());
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения очереди отправки
+ */
+TEST(QtSimpleNet, SendQueueLimits)
+{
+    HawkNet_SendQueueLimits(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест согласования и сжатия кадров
+ */
+TEST(QtSimpleNet, Compression)
+{
+    HawkNet_Compression(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверки связи и разрыва по простою
+ */
+TEST(QtSimpleNet, Heartbeat)
+{
+    HawkNet_Heartbeat(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест конвейерных запросов
+ */
+TEST(QtSimpleNet, RequestPipelining)
+{
+    HawkNet_RequestPipelining(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест менеджера клиентских соединений
+ */
+TEST(QtSimpleNet, ClientManager)
+{
+    HawkNet_ClientManager(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест перезапуска сервера под менеджером клиентских соединений
+ */
+TEST(QtSimpleNet, ServerRestart)
+{
+    HawkNet_ServerRestart(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения частоты входящих кадров и соединений
+ */
+TEST(QtSimpleNet, RateLimits)
+{
+    HawkNet_RateLimits(std::make_unique<QtSimpleNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief main - Входная точка тестировани функционала errors::error_code
  * @param argc - Количество аргументов
@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <chrono>
 
 #include <QCoreApplication>
 
 #include <neterrorcategory.h>
 #include <HawkNet.h>
+#include <Async/QtImplementation/Ssl/sslfuncs.h>
 
 #include "HawkNetTest.hpp"
 
@@ -33,17 +35,19 @@ public:
      * @brief make_server - Метод сконструирует сервер
      * @param inCallBacks - Калбэки сервера
      * @param inPort - Прослушиваемый порт
+     * @param inWorkers - Количество рабочих потоков сервера
      * @return Вернёт указатель на интерфейс сервера
      */
     virtual std::unique_ptr<net::HMServer> make_server(net::ServCallbacks& inCallBacks,
-                                                       const std::uint16_t inPort = C_PORT) override
+                                                       const std::uint16_t inPort = C_PORT,
+                                                       const std::size_t inWorkers = 0) override
     {
         net::CertificatePaths certificatePaths;
 
         certificatePaths.m_certificatePath = std::filesystem::current_path() / "certificate.crt";
         certificatePaths.m_privateKey = std::filesystem::current_path() / "privateKey.key";
 
-        return std::make_unique<net::HMQtSslAsyncServer>(inPort, certificatePaths, inCallBacks);
+        return std::make_unique<net::HMQtSslAsyncServer>(inPort, certificatePaths, inCallBacks, inWorkers);
     }
 
     /**
@@ -173,6 +177,30 @@ TEST(QtSslNet, Echo)
     HawkNet_Echo(std::make_unique<QtSslNetTestBuilder>());
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи двоичных данных в режиме кадров с заголовком
+ */
+TEST(QtSslNet, LengthPrefixedFraming)
+{
+    HawkNet_LengthPrefixedFraming(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест приёма пачки мелких сообщений
+ */
+TEST(QtSslNet, ReceiveBurst)
+{
+    HawkNet_ReceiveBurst(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обслуживания соединений рабочими потоками сервера
+ */
+TEST(QtSslNet, WorkerThreads)
+{
+    HawkNet_WorkerThreads(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест нагрузки
  */
@@ -181,6 +209,109 @@ TEST(QtSslNet, StressTest)
     HawkNet_StressTest(std::make_unique<QtSslNetTestBuilder>());
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения очереди отправки
+ */
+TEST(QtSslNet, SendQueueLimits)
+{
+    HawkNet_SendQueueLimits(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест согласования и сжатия кадров
+ */
+TEST(QtSslNet, Compression)
+{
+    HawkNet_Compression(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверки связи и разрыва по простою
+ */
+TEST(QtSslNet, Heartbeat)
+{
+    HawkNet_Heartbeat(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест конвейерных запросов
+ */
+TEST(QtSslNet, RequestPipelining)
+{
+    HawkNet_RequestPipelining(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест менеджера клиентских соединений
+ */
+TEST(QtSslNet, ClientManager)
+{
+    HawkNet_ClientManager(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест перезапуска сервера под менеджером клиентских соединений
+ */
+TEST(QtSslNet, ServerRestart)
+{
+    HawkNet_ServerRestart(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест возобновления сеанса по билету, выданному сервером при полном рукопожатии
+ */
+TEST(QtSslNet, SessionResumption)
+{
+    QtSslNetTestBuilder Builder;
+    net::ServCallbacks ServCallBacks;
+    net::ConCallbacks ClientCallBacks;
+    std::atomic_size_t Received = 0; // Количество сообщений, принятых сервером
+
+    ServCallBacks.m_conCalbacks.m_DataCallBack = [&](net::iByteStream&&, const std::size_t) -> void { ++Received; };
+
+    std::unique_ptr<net::HMServer> Server = Builder.make_server(ServCallBacks);
+    ASSERT_FALSE(Server->start()); // Ошибки быть не должно
+
+    // Подключение считается установленным, когда сервер принял первое сообщение: запись дожидается рукопожатия
+    auto ConnectAndSend = [&]() -> void
+    {
+        const std::size_t Expected = Received + 1;
+        std::unique_ptr<net::HMConnection> Client = Builder.make_client(ClientCallBacks);
+
+        EXPECT_FALSE(Client->connect()); // Ошибки быть не должно
+        EXPECT_FALSE(Client->send(net::oByteStream(std::string("ping"))));
+
+        const auto TimeOut = std::chrono::steady_clock::now() + C_WAIT_LONG * 10;
+        while (Received < Expected && std::chrono::steady_clock::now() < TimeOut)
+            QCoreApplication::processEvents(); // Рукопожатие клиента продвигается событиями текущего потока
+
+        EXPECT_EQ(Received, Expected); // Сообщение должно дойти до сервера
+        Client->disconnect();
+    };
+
+    net::clearSessionTickets(); // Без билета клиент выполнит полное рукопожатие
+    ConnectAndSend();
+
+    EXPECT_FALSE(net::findSessionTicket(C_HOST, C_PORT).isEmpty()); // Сервер должен выдать билет сеанса
+
+    ConnectAndSend(); // Клиент предъявит сохранённый билет
+
+    EXPECT_FALSE(net::findSessionTicket(C_HOST, C_PORT).isEmpty()); // Билет возобновлённого сеанса должен остаться сохранённым
+
+    net::clearSessionTickets();
+
+    Builder.wait(C_WAIT_NORM); // Ожидаем
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения частоты входящих кадров и соединений
+ */
+TEST(QtSslNet, RateLimits)
+{
+    HawkNet_RateLimits(std::make_unique<QtSslNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief main - Входная точка тестировани функционала errors::error_code
  * @param argc - Количество аргументов
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <map>
+#include <set>
+#include <mutex>
 #include <thread>
 #include <chrono>
 #include <random>
@@ -43,10 +46,12 @@ public:
      * @brief make_server - Метод сконструирует сервер
      * @param inCallBacks - Калбэки сервера
      * @param inPort - Прослушиваемый порт
+     * @param inWorkers - Количество рабочих потоков сервера
      * @return Вернёт указатель на интерфейс сервера
      */
     virtual std::unique_ptr<net::HMServer> make_server(net::ServCallbacks& inCallBacks,
-                                                       const std::uint16_t inPort = C_PORT) = 0;
+                                                       const std::uint16_t inPort = C_PORT,
+                                                       const std::size_t inWorkers = 0) = 0;
 
     /**
      * @brief make_client - Метод сконструерует соединение
@@ -633,6 +638,233 @@ void HawkNet_Echo(std::unique_ptr<NetTestBuilder>&& inBuilder)
     Server->stop();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_LengthPrefixedFraming - Тест передачи двоичных данных в режиме кадров с заголовком
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_LengthPrefixedFraming(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+    std::string BinaryData(4096, '\0'); // Двоичные данные, содержащие все значения байта, в т.ч. разделитель потока
+
+    for (std::size_t Index = 0; Index < BinaryData.size(); ++Index)
+        BinaryData[Index] = static_cast<char>(Index % 256);
+
+    net::iByteStream ServerConnectionReceived; // Полученные сервером данные
+    net::iByteStream EchoConnectionReceived; // Возвращённые данные
+    std::size_t ServerReceiveCount = 0; // Количество сообщений, полученных сервером
+    std::function<std::map<std::size_t, errors::error_code>(net::oByteStream&& inData)> SendToAll; // Функция отправки данных
+
+    // Инициализируем обрабутку событий
+    bool OnServ_ClientError = false; // Сервер, соединение обработало событие "ошибка"
+    bool OnClient_Error = false; // Клиент обработал событие "ошибка"
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack =    [&](net::iByteStream&& inData, const std::size_t) -> void
+    {
+        ServerReceiveCount++;
+        ServerConnectionReceived = std::move(inData);
+        if (SendToAll) SendToAll(net::oByteStream(ServerConnectionReceived.str()));
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack =   [&](const errors::error_code, const std::size_t) -> void                { OnServ_ClientError = true; };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_DataCallBack =                [&](net::iByteStream&& inData, const std::size_t) -> void               { EchoConnectionReceived = std::move(inData); };
+    ClientCallBacks.m_ErrorCallBack =               [&](const errors::error_code, const std::size_t) -> void                { OnClient_Error = true; };
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+    SendToAll = std::bind(&net::HMServer::sendToAll, Server.get(), std::placeholders::_1);
+
+    std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+    ASSERT_EQ(Client->framingMode(), net::eFramingMode::fmSeparator); // По умолчанию используется разделитель
+    Client->setFramingMode(net::eFramingMode::fmLengthPrefixed);
+
+    Error = Client->connect(); // Подключение сопровождается кадром согласования
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+    ASSERT_EQ(ServerReceiveCount, 0); // Кадр согласования не передаётся обработчику
+
+    Error = Client->send(net::oByteStream(BinaryData));
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    ASSERT_EQ(ServerReceiveCount, 1);
+    ASSERT_EQ(ServerConnectionReceived.str(), BinaryData); // Данные не должны быть искажены
+    ASSERT_EQ(EchoConnectionReceived.str(), BinaryData); // Сервер ответил в согласованном режиме
+    // Ошибок быть не должно
+    ASSERT_FALSE(OnServ_ClientError);
+    ASSERT_FALSE(OnClient_Error);
+
+    Client->disconnect();
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_ReceiveBurst - Тест приёма пачки мелких сообщений обработчиком без копирования
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_ReceiveBurst(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+    constexpr std::size_t MessageCount = 1000; // Количество сообщений в пачке
+
+    std::size_t ReceiveCount = 0; // Количество полученных сообщений
+    std::size_t OrderErrors = 0; // Количество сообщений, полученных не по порядку
+
+    // Инициализируем обрабутку событий
+    bool OnServ_ClientError = false; // Сервер, соединение обработало событие "ошибка"
+    bool OnClient_Error = false; // Клиент обработал событие "ошибка"
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataViewCallBack = [&](const net::FrameView inData, const std::size_t) -> void
+    {
+        if (inData != std::to_string(ReceiveCount)) OrderErrors++;
+        ReceiveCount++;
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack =   [&](const errors::error_code, const std::size_t) -> void                { OnServ_ClientError = true; };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_ErrorCallBack =               [&](const errors::error_code, const std::size_t) -> void                { OnClient_Error = true; };
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    for (const auto Mode : { net::eFramingMode::fmSeparator, net::eFramingMode::fmLengthPrefixed })
+    {
+        ReceiveCount = 0;
+        OrderErrors = 0;
+
+        std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+        Client->setFramingMode(Mode);
+        Error = Client->connect(); // Пытаемся подключится
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+        for (std::size_t Index = 0; Index < MessageCount; ++Index) // Отправляем сообщения без пауз, они придут пачками
+        {
+            Error = Client->send(net::oByteStream(std::to_string(Index)));
+            ASSERT_FALSE(Error); // Ошибки быть не должно
+        }
+
+        inBuilder->wait(C_WAIT_LONG); // Ожидаем
+
+        ASSERT_EQ(ReceiveCount, MessageCount); // Должны быть получены все сообщения
+        ASSERT_EQ(OrderErrors, 0); // Без искажений и в порядке отправки
+
+        Client->disconnect();
+        inBuilder->wait(C_WAIT_NORM); // Ожидаем
+    }
+
+    // Ошибок быть не должно
+    ASSERT_FALSE(OnServ_ClientError);
+    ASSERT_FALSE(OnClient_Error);
+
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_WorkerThreads - Тест обслуживания соединений рабочими потоками сервера
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_WorkerThreads(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+    constexpr std::size_t WorkersCount = 4; // Количество рабочих потоков
+    constexpr std::size_t ClientsCount = 8; // Количество клиентов
+
+    net::HMServer* ServerPtr = nullptr; // Сервер для ответа из обработчика
+    std::mutex ThreadsDefender;
+    std::set<std::thread::id> ServerThreads; // Потоки, в которых сервер обработал данные
+    std::atomic<std::size_t> Server_ClientError {0};
+    std::atomic<std::size_t> EchoErrors {0};
+
+    std::size_t ClientReceived = 0; // Калбэки клиентов выполняются в основном потоке
+    bool OnClient_Error = false;
+
+    // Инициализируем обрабутку событий
+    net::ServCallbacks ServCallBacks; // События сервера (выполняются в рабочих потоках)
+    ServCallBacks.m_conCalbacks.m_DataCallBack = [&](net::iByteStream&& inData, const std::size_t inID) -> void
+    {
+        {
+            std::lock_guard lg(ThreadsDefender);
+            ServerThreads.insert(std::this_thread::get_id());
+        }
+
+        if (ServerPtr->send(inID, net::oByteStream(inData.str()))) // Отвечаем из рабочего потока
+            EchoErrors++;
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack =   [&](const errors::error_code, const std::size_t) -> void                { Server_ClientError++; };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_DataCallBack =                [&](net::iByteStream&&, const std::size_t) -> void                      { ClientReceived++; };
+    ClientCallBacks.m_ErrorCallBack =               [&](const errors::error_code, const std::size_t) -> void                { OnClient_Error = true; };
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks, C_PORT, WorkersCount); // Создаём сервер с рабочими потоками
+    ServerPtr = Server.get();
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    std::vector<std::unique_ptr<net::HMConnection>> Clients(ClientsCount); // Подключаемые клиенты
+
+    for (auto& Client : Clients)
+    {
+        Client = inBuilder->make_client(ClientCallBacks);
+        Error = Client->connect(); // Пытаемся подключится
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+    ASSERT_EQ(Server->connectionCount(), ClientsCount); // Сервер должен зарегистрировать всех клиентов
+
+    for (auto& Client : Clients)
+    {
+        Error = Client->send(net::oByteStream("Ping"));
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    inBuilder->wait(C_WAIT_LONG); // Ожидаем
+
+    ASSERT_EQ(ClientReceived, ClientsCount); // Каждый клиент должен получить ответ из рабочего потока
+    ASSERT_EQ(EchoErrors, 0);
+
+    {
+        std::lock_guard lg(ThreadsDefender);
+        ASSERT_GT(ServerThreads.size(), 1); // Соединения распределены по нескольким потокам
+        ASSERT_EQ(ServerThreads.count(std::this_thread::get_id()), 0); // Данные не обрабатываются в потоке сервера
+    }
+
+    for (const auto& [ID, SendError] : Server->sendToAll(net::oByteStream("Broadcast"))) // Отправка из чужого для соединений потока
+        ASSERT_FALSE(SendError);
+
+    inBuilder->wait(C_WAIT_LONG); // Ожидаем
+    ASSERT_EQ(ClientReceived, ClientsCount * 2); // Рассылка должна дойти до всех клиентов
+
+    // Ошибок быть не должно
+    ASSERT_EQ(Server_ClientError, 0);
+    ASSERT_FALSE(OnClient_Error);
+
+    Server->stop(); // Соединения закрываются в своих рабочих потоках
+    ASSERT_EQ(Server->connectionCount(), 0);
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief HawkNet_StressTest - Тест нагрузки
  * @param inBuilder - Сборщик объектов теста
@@ -710,3 +942,828 @@ void HawkNet_StressTest(std::unique_ptr<NetTestBuilder>&& inBuilder)
     Server->stop();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_SendQueueLimits - Тест ограничения очереди отправки при медленном партнёре
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_SendQueueLimits(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+    constexpr std::size_t MessageCount = 64; // Количество сообщений
+    constexpr std::size_t MessageSize = 256 * 1024; // Размер сообщения: буферы сокетов заполняются за несколько сообщений
+
+    std::mutex ReceiveDefender; // Сервер принимает в своих потоках
+    std::size_t ReceiveCount = 0; // Количество полученных сообщений
+    std::string LastReceived; // Индекс последнего полученного сообщения
+    std::atomic_bool OnClient_Drained = false; // Клиент обработал событие "очередь освободилась"
+    std::atomic_bool OnClient_Disconnect = false; // Клиент обработал событие "отключение"
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataViewCallBack = [&](const net::FrameView inData, const std::size_t) -> void
+    {
+        if (inData.substr(0, inData.find(' ')) == "0") // Приёмник "задумывается", буферы сокетов гарантированно заполняются
+            std::this_thread::sleep_for(C_WAIT_LONG * 3);
+
+        std::lock_guard lg(ReceiveDefender);
+        ReceiveCount++;
+        LastReceived = std::string(inData.substr(0, inData.find(' ')));
+    };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_DrainedCallBack =             [&](const std::size_t) -> void                                          { OnClient_Drained = true; };
+    ClientCallBacks.m_DisconnectCallBack =          [&](const std::size_t) -> void                                          { OnClient_Disconnect = true; };
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    for (const auto Policy : { net::eQueueOverflowPolicy::qpReject, net::eQueueOverflowPolicy::qpDropOldest, net::eQueueOverflowPolicy::qpDisconnect })
+    {
+        {
+            std::lock_guard lg(ReceiveDefender); // Соединение прошлого прохода могло ещё не закрыться на сервере
+            ReceiveCount = 0;
+            LastReceived.clear();
+        }
+
+        OnClient_Drained = false;
+        OnClient_Disconnect = false;
+
+        net::SendQueueLimits Limits;
+        Limits.m_maxMessages = 4;
+        Limits.m_policy = Policy;
+
+        std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+        Client->setSendQueueLimits(Limits);
+        ASSERT_EQ(Client->sendQueueLimits().m_policy, Policy); // Ограничения должны быть применены
+
+        Error = Client->connect(); // Пытаемся подключится
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+        std::size_t Rejected = 0; // Количество отклонённых сообщений
+        for (std::size_t Index = 0; Index < MessageCount; ++Index) // Отправляем без пауз, быстрее чем принимает партнёр
+        {
+            std::string Message = std::to_string(Index) + " ";
+            Message.resize(MessageSize, 'x');
+
+            Error = Client->send(net::oByteStream(Message));
+
+            if (Error == make_error_code(errors::eNetError::neSendQueueFull))
+                Rejected++;
+            else if (Error) // Иначе допустима только отправка в соединение, разорванное из-за переполнения
+            {
+                ASSERT_EQ(Policy, net::eQueueOverflowPolicy::qpDisconnect);
+            }
+        }
+
+        inBuilder->wait(C_WAIT_LONG * 10); // Ожидаем
+
+        std::lock_guard lg(ReceiveDefender);
+
+        switch (Policy)
+        {
+            case net::eQueueOverflowPolicy::qpReject:
+            {
+                ASSERT_GT(Rejected, 0); // Очередь должна переполниться
+                ASSERT_EQ(ReceiveCount, MessageCount - Rejected); // Принятые сообщения доставлены все
+                ASSERT_TRUE(OnClient_Drained); // Отправитель оповещён об освобождении очереди
+                break;
+            }
+            case net::eQueueOverflowPolicy::qpDropOldest:
+            {
+                ASSERT_EQ(Rejected, 0); // Новые сообщения не отклоняются
+                ASSERT_LT(ReceiveCount, MessageCount); // Часть старых сообщений вытеснена
+                ASSERT_EQ(LastReceived, std::to_string(MessageCount - 1)); // Последнее сообщение доставлено
+                ASSERT_TRUE(OnClient_Drained);
+                break;
+            }
+            default:
+            {
+                ASSERT_GT(Rejected, 0); // Очередь должна переполниться
+                ASSERT_TRUE(OnClient_Disconnect); // И соединение разорвано
+                ASSERT_EQ(Client->status(), net::eConnectionStatus::csDisconnected);
+                break;
+            }
+        }
+
+        Client->disconnect();
+        inBuilder->wait(C_WAIT_NORM); // Ожидаем
+    }
+
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_Compression - Тест согласования и сжатия кадров
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_Compression(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+    constexpr std::size_t MessageCount = 8; // Количество сжимаемых сообщений
+
+    std::string Message; // Хорошо сжимаемое сообщение: разметка с повторяющимися полями
+    for (std::size_t Index = 0; Index < 128; ++Index)
+        Message += "{\"id\":" + std::to_string(Index) + ",\"name\":\"client\",\"state\":\"connected\"}";
+
+    const std::string Small = "ping"; // Сообщение короче порога сжатия
+
+    std::mutex ReceiveDefender; // Сервер принимает в своих потоках
+    std::vector<std::string> ServerReceived; // Полученные сервером сообщения
+    std::vector<std::string> ClientReceived; // Возвращённые сервером сообщения
+    std::size_t ServerConnectionID = 0; // Идентификатор соединения на сервере
+    std::function<errors::error_code(const std::size_t, net::HMByteBuffer&&)> Echo; // Функция ответа клиенту
+
+    // Инициализируем обрабутку событий
+    std::atomic_bool OnServ_ClientError = false; // Сервер, соединение обработало событие "ошибка"
+    std::atomic_bool OnClient_Error = false; // Клиент обработал событие "ошибка"
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack =    [&](net::HMByteBuffer&& inData, const std::size_t inSenderID) -> void
+    {
+        {
+            std::lock_guard lg(ReceiveDefender);
+            ServerReceived.push_back(inData.str());
+            ServerConnectionID = inSenderID;
+        }
+
+        if (Echo && Echo(inSenderID, std::move(inData))) // Распакованный буфер отправляется обратно без копирования
+            OnServ_ClientError = true;
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack =   [&](const errors::error_code, const std::size_t) -> void                { OnServ_ClientError = true; };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_DataViewCallBack =            [&](const net::FrameView inData, const std::size_t) -> void
+    {
+        std::lock_guard lg(ReceiveDefender);
+        ClientReceived.emplace_back(inData);
+    };
+    ClientCallBacks.m_ErrorCallBack =               [&](const errors::error_code, const std::size_t) -> void                { OnClient_Error = true; };
+
+    net::CompressionSettings Settings;
+    Settings.m_enabled = true;
+    Settings.m_threshold = 256;
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Server->setCompression(Settings); // Сжатие получат все соединения сервера
+    Echo = std::bind(&net::HMServer::send, Server.get(), std::placeholders::_1, std::placeholders::_2);
+
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+    Client->setFramingMode(net::eFramingMode::fmLengthPrefixed); // Сжатие согласуется кадром согласования
+    Client->setCompression(Settings);
+    ASSERT_TRUE(Client->compression().m_enabled);
+
+    Error = Client->connect(); // Пытаемся подключится
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем ответного кадра согласования
+
+    for (std::size_t Index = 0; Index < MessageCount; ++Index)
+        ASSERT_FALSE(Client->send(net::oByteStream(Message)));
+
+    ASSERT_FALSE(Client->send(net::oByteStream(Small)));
+    inBuilder->wait(C_WAIT_LONG); // Ожидаем
+
+    {
+        std::lock_guard lg(ReceiveDefender);
+        ASSERT_EQ(ServerReceived.size(), MessageCount + 1);
+        ASSERT_EQ(ClientReceived.size(), MessageCount + 1);
+
+        for (std::size_t Index = 0; Index < MessageCount; ++Index) // Данные не должны быть искажены
+        {
+            ASSERT_EQ(ServerReceived[Index], Message);
+            ASSERT_EQ(ClientReceived[Index], Message);
+        }
+
+        ASSERT_EQ(ServerReceived.back(), Small);
+        ASSERT_EQ(ClientReceived.back(), Small);
+    }
+
+    const net::ConnectionStats ClientStats = Client->stats();
+    net::ConnectionStats ServerStats;
+    ASSERT_FALSE(Server->connectionStats(ServerConnectionID, ServerStats));
+
+    if (net::HMFrameDeflater::isSupported()) // Без zlib партнёры не согласуют сжатие и обмениваются обычными кадрами
+    {
+        // Короткое сообщение не сжимается
+        ASSERT_EQ(ClientStats.m_compressedFrames, MessageCount);
+        ASSERT_EQ(ClientStats.m_decompressedFrames, MessageCount);
+        ASSERT_EQ(ServerStats.m_compressedFrames, MessageCount);
+        ASSERT_EQ(ServerStats.m_decompressedFrames, MessageCount);
+
+        ASSERT_EQ(ClientStats.m_compressInBytes, Message.size() * MessageCount);
+        ASSERT_EQ(ServerStats.m_decompressOutBytes, Message.size() * MessageCount);
+        ASSERT_EQ(ServerStats.m_decompressInBytes, ClientStats.m_compressOutBytes);
+        ASSERT_LT(ClientStats.m_compressionRatio, 0.1); // Повторы сообщений кодируются ссылками на окно
+        ASSERT_GT(ClientStats.m_compressTime.count(), 0);
+    }
+    else
+    {
+        ASSERT_EQ(ClientStats.m_compressedFrames, 0);
+        ASSERT_EQ(ServerStats.m_compressedFrames, 0);
+    }
+
+    // Ошибок быть не должно
+    ASSERT_FALSE(OnServ_ClientError);
+    ASSERT_FALSE(OnClient_Error);
+
+    Client->disconnect();
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_Heartbeat - Тест проверки связи и разрыва простаивающего соединения
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_Heartbeat(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+
+    // Инициализируем обрабутку событий
+    std::atomic_bool OnServ_Data = false; // Сервер получил данные
+    std::atomic_bool OnServ_ClientDisconnect = false; // Сервер обработал событие отключения клиента
+    std::atomic_bool OnServ_IdleTimeout = false; // Сервер разорвал соединение по простою
+    std::atomic_bool OnServ_OtherError = false; // Сервер обработал другую ошибку
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack =        [&](net::HMByteBuffer&&, const std::size_t) -> void   { OnServ_Data = true; };
+    ServCallBacks.m_conCalbacks.m_DisconnectCallBack =  [&](const std::size_t) -> void                        { OnServ_ClientDisconnect = true; };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack =       [&](const errors::error_code inError, const std::size_t) -> void
+    {
+        if (inError == make_error_code(errors::eNetError::neIdleTimeout))
+            OnServ_IdleTimeout = true;
+        else
+            OnServ_OtherError = true;
+    };
+
+    std::atomic_bool OnClient_Data = false; // Клиент получил данные
+    std::atomic_bool OnClient_Disconnect = false; // Клиент обработал событие отключения
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+    ClientCallBacks.m_DataCallBack =                    [&](net::HMByteBuffer&&, const std::size_t) -> void   { OnClient_Data = true; };
+    ClientCallBacks.m_DisconnectCallBack =              [&](const std::size_t) -> void                        { OnClient_Disconnect = true; };
+
+    net::HeartbeatSettings Settings;
+    Settings.m_interval = C_WAIT_NORM; // Проверка связи заметно чаще разрыва по простою
+    Settings.m_idleTimeout = C_WAIT_LONG * 2;
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Server->setHeartbeat(Settings);
+
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks); // Клиент сам проверку связи не ведёт
+    Error = Client->connect(); // Пытаемся подключится
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_LONG * 6); // Простой втрое дольше m_idleTimeout
+
+    // Клиент отвечает на проверку связи сам, поэтому молчащее соединение живо
+    ASSERT_TRUE(Client->isConnected());
+    ASSERT_EQ(Server->connectionCount(), 1);
+    ASSERT_FALSE(OnServ_ClientDisconnect);
+
+    // Служебные кадры обработчикам не передаются
+    ASSERT_FALSE(OnServ_Data);
+    ASSERT_FALSE(OnClient_Data);
+
+    Settings.m_interval = std::chrono::milliseconds(0); // Без проверки связи молчащий клиент простаивает
+    Server->setHeartbeat(Settings); // Настройки получают и подключённые соединения
+
+    inBuilder->wait(C_WAIT_LONG * 6); // Ожидаем
+
+    // Соединение разорвано сервером обычным путём
+    ASSERT_TRUE(OnServ_IdleTimeout);
+    ASSERT_TRUE(OnServ_ClientDisconnect);
+    ASSERT_TRUE(OnClient_Disconnect);
+    ASSERT_EQ(Server->connectionCount(), 0);
+    ASSERT_FALSE(Client->isConnected());
+    ASSERT_FALSE(OnServ_OtherError);
+
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_RequestPipelining - Тест конвейерных запросов с сопоставлением ответов и сроком ожидания
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_RequestPipelining(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+
+    /**
+     * @brief The Deferred struct - Запрос, ответ на который сервер отложил
+     */
+    struct Deferred
+    {
+        std::size_t m_senderID = 0;     ///< Идентификатор соединения
+        std::uint32_t m_requestID = 0;  ///< Идентификатор запроса
+        std::string m_data;             ///< Данные запроса
+    };
+
+    std::mutex Defender; // Мьютекс, защищающий результаты
+    std::vector<Deferred> Postponed; // Отложенные сервером запросы
+    std::vector<std::string> Completed; // Данные запросов в порядке получения ответов
+    std::map<std::string, std::pair<errors::error_code, std::string>> Responses; // Результаты запросов по их данным
+
+    std::unique_ptr<net::HMServer> Server;
+    std::atomic_bool OnServ_Data = false; // Сервер получил данные вне запросов
+
+    // Инициализируем обрабутку событий
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack = [&](net::HMByteBuffer&&, const std::size_t) -> void { OnServ_Data = true; };
+    ServCallBacks.m_conCalbacks.m_RequestCallBack = [&](const net::FrameView inData, const std::size_t inSenderID, const std::uint32_t inRequestID) -> void
+    {
+        const std::string Data(inData);
+
+        if (Data == "ignored") // Ответа не будет, запрос истечёт у клиента
+            return;
+
+        if (Data.front() % 2 == 0) // Чётные запросы сервер отвечает позже, в обратном порядке
+        {
+            std::lock_guard lg(Defender);
+            Postponed.push_back({ inSenderID, inRequestID, Data });
+        }
+        else // Нечётные - сразу
+            ASSERT_FALSE(Server->respond(inSenderID, inRequestID, net::oByteStream(Data + "!")));
+    };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+
+    const auto Track = [&](const std::string& inName)
+    {
+        return [&, inName](const errors::error_code inError, net::HMByteBuffer&& inData)
+        {
+            std::lock_guard lg(Defender);
+            Completed.push_back(inName);
+            Responses[inName] = { inError, inData.str() };
+        };
+    };
+
+    // Инициализируем соединения
+    Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+    Error = Client->connect(); // Пытаемся подключится
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    // Запросы уходят подряд, не дожидаясь ответов
+    const std::vector<std::string> Names = { "0", "1", "2", "3", "4", "5" };
+    for (const std::string& Name : Names)
+        ASSERT_FALSE(Client->request(net::oByteStream(Name), Track(Name), C_WAIT_LONG * 20));
+
+    ASSERT_FALSE(Client->request(net::oByteStream("ignored"), Track("ignored"), C_WAIT_NORM));
+
+    inBuilder->wait(C_WAIT_LONG * 2); // Срок игнорируемого запроса истёк, отложенные ещё ожидают
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Postponed.size(), 3);
+        ASSERT_EQ(Completed.size(), 4); // Нечётные и истёкший
+
+        ASSERT_EQ(Responses.count("ignored"), 1);
+        ASSERT_EQ(Responses["ignored"].first, make_error_code(errors::eNetError::neTimeOut));
+    }
+
+    for (auto It = Postponed.rbegin(); It != Postponed.rend(); ++It)
+        ASSERT_FALSE(Server->respond(It->m_senderID, It->m_requestID, net::oByteStream(It->m_data + "!")));
+
+    inBuilder->wait(C_WAIT_LONG); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Completed.size(), Names.size() + 1);
+
+        // Каждый ответ пришёл своему запросу, несмотря на порядок
+        for (const std::string& Name : Names)
+        {
+            ASSERT_FALSE(Responses[Name].first);
+            ASSERT_EQ(Responses[Name].second, Name + "!");
+        }
+
+        // Отложенные ответы завершили запросы позже отправленных после них и в обратном порядке
+        ASSERT_EQ(std::vector<std::string>(Completed.end() - 3, Completed.end()), std::vector<std::string>({ "4", "2", "0" }));
+    }
+
+    ASSERT_FALSE(OnServ_Data); // Запросы обработчику данных не передаются
+
+    Client->disconnect();
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_ClientManager - Тест менеджера клиентских соединений: фоновое подключение, переподключение, повтор запросов
+ * и неподтверждённых отправок
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_ClientManager(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+
+    std::mutex Defender; // Мьютекс, защищающий результаты
+    std::vector<std::string> Received; // Данные, принятые сервером
+    std::set<std::size_t> Senders; // Соединения, через которые пришли данные
+    std::map<std::string, std::pair<errors::error_code, std::string>> Responses; // Результаты запросов по их данным
+    std::atomic_size_t LostSeen = 0; // Сколько раз сервер принял запрос "lost"
+    std::atomic_size_t Connects = 0; // Успешные подключения менеджера
+    std::atomic_size_t Failures = 0; // Неудавшиеся попытки подключения
+
+    std::unique_ptr<net::HMServer> Server;
+
+    // Инициализируем обрабутку событий
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack = [&](net::HMByteBuffer&& inData, const std::size_t inSenderID) -> void
+    {
+        std::lock_guard lg(Defender);
+        Received.push_back(inData.str());
+        Senders.insert(inSenderID);
+    };
+    ServCallBacks.m_conCalbacks.m_RequestCallBack = [&](const net::FrameView inData, const std::size_t inSenderID, const std::uint32_t inRequestID) -> void
+    {
+        const std::string Data(inData);
+
+        if (Data == "lost" && LostSeen++ == 0) // Первый раз не отвечаем: соединение будет разорвано до ответа
+            return;
+
+        ASSERT_FALSE(Server->respond(inSenderID, inRequestID, net::oByteStream(Data + "!")));
+    };
+
+    const auto Track = [&](const std::string& inName)
+    {
+        return [&, inName](const errors::error_code inError, net::HMByteBuffer&& inData)
+        {
+            std::lock_guard lg(Defender);
+            Responses[inName] = { inError, inData.str() };
+        };
+    };
+
+    net::ReconnectSettings Settings;
+    Settings.m_initialDelay = C_WAIT_FAST;
+    Settings.m_maxDelay = C_WAIT_NORM;
+    Settings.m_connectTimeout = C_WAIT_LONG;
+    Settings.m_ackTimeout = C_WAIT_LONG * 2;
+
+    net::ConCallbacks ManagerCallbacks; // Исход каждой попытки передаётся и пользователю
+    ManagerCallbacks.m_ConnectCallBack = [&](const errors::error_code inError, const std::size_t) -> void
+    { (inError) ? ++Failures : ++Connects; };
+
+    net::HMClientManager Manager([&](const net::ConCallbacks& inCallbacks)
+    {
+        net::ConCallbacks Callbacks = inCallbacks;
+        return inBuilder->make_client(Callbacks);
+    }, ManagerCallbacks, 2, Settings);
+
+    // Сервера ещё нет: запуск не блокируется, данные и запрос ожидают подключения
+    Error = Manager.start();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_FALSE(Manager.isConnected());
+
+    ASSERT_FALSE(Manager.send(net::oByteStream("offline")));
+    ASSERT_FALSE(Manager.request(net::oByteStream("early"), Track("early"), C_WAIT_LONG * 20));
+
+    inBuilder->wait(C_WAIT_NORM); // Попытки без сервера завершаются неудачей и повторяются
+    ASSERT_GT(Failures, 0);
+
+    Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_LONG * 3); // Задержка попыток не превышает m_maxDelay
+
+    ASSERT_EQ(Manager.connectedCount(), 2);
+    ASSERT_EQ(Server->connectionCount(), 2);
+    ASSERT_EQ(Connects, 2);
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Received, std::vector<std::string>({ "offline" }));
+        ASSERT_FALSE(Responses["early"].first);
+        ASSERT_EQ(Responses["early"].second, "early!");
+    }
+
+    // Запрос без ответа повторяется после разрыва и переподключения
+    ASSERT_FALSE(Manager.request(net::oByteStream("lost"), Track("lost"), C_WAIT_LONG * 20));
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+    ASSERT_EQ(LostSeen, 1);
+
+    Server->closeAllConnections();
+    inBuilder->wait(C_WAIT_LONG * 3); // Ожидаем
+
+    ASSERT_EQ(Manager.connectedCount(), 2);
+    ASSERT_EQ(LostSeen, 2);
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Responses.count("lost"), 1);
+        ASSERT_FALSE(Responses["lost"].first);
+        ASSERT_EQ(Responses["lost"].second, "lost!");
+        Senders.clear();
+    }
+
+    // Отправки распределяются по обоим соединениям
+    for (std::size_t Index = 0; Index < 10; ++Index)
+        ASSERT_FALSE(Manager.send(net::oByteStream("bulk")));
+
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Received.size(), 11);
+        ASSERT_EQ(Senders.size(), 2);
+    }
+
+    // Без сервера запрос завершается по своему сроку
+    Server->stop();
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    ASSERT_FALSE(Manager.isConnected());
+    ASSERT_FALSE(Manager.request(net::oByteStream("late"), Track("late"), C_WAIT_NORM));
+
+    inBuilder->wait(C_WAIT_LONG * 2); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Responses.count("late"), 1);
+        ASSERT_EQ(Responses["late"].first, make_error_code(errors::eNetError::neTimeOut));
+    }
+
+    // Данные, отброшенные сервером без подтверждения, отправляются повторно
+    net::RateLimits Limits;
+    Limits.m_framesPerSecond = 1; // Второй кадр каждого соединения отбрасывается до пополнения запаса
+
+    Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Server->setRateLimits(Limits);
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_LONG * 3); // Ожидаем переподключения
+    ASSERT_EQ(Manager.connectedCount(), 2);
+
+    {
+        std::lock_guard lg(Defender);
+        Received.clear();
+    }
+
+    for (std::size_t Index = 0; Index < 4; ++Index) // По два кадра на соединение
+        ASSERT_FALSE(Manager.send(net::oByteStream("acked" + std::to_string(Index))));
+
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Received.size(), 2);
+    }
+
+    inBuilder->wait(std::chrono::milliseconds(2500)); // Запас соединений пополняется раз в секунду
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(std::multiset<std::string>(Received.begin(), Received.end()),
+                  std::multiset<std::string>({ "acked0", "acked1", "acked2", "acked3" }));
+    }
+
+    Manager.stop();
+    ASSERT_FALSE(Manager.isConnected());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_ServerRestart - Тест перезапуска сервера под менеджером клиентских соединений: разрыв со стороны
+ * сервера должен сбросить сеанс клиента (согласование, сжатие, ожидающие запросы), чтобы новый сеанс начался заново
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_ServerRestart(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+
+    std::string Message; // Хорошо сжимаемое сообщение: сжатие согласуется в каждом сеансе заново
+    for (std::size_t Index = 0; Index < 128; ++Index)
+        Message += "{\"id\":" + std::to_string(Index) + ",\"name\":\"client\",\"state\":\"connected\"}";
+
+    std::mutex Defender; // Мьютекс, защищающий результаты
+    std::map<std::string, std::pair<errors::error_code, std::string>> Responses; // Результаты запросов по их данным
+    std::atomic_size_t HoldSeen = 0; // Сколько раз сервер принял запрос "hold"
+    std::atomic_bool OnServ_ClientError = false; // Сервер, соединение обработало событие "ошибка"
+
+    std::unique_ptr<net::HMServer> Server;
+
+    net::CompressionSettings Compression;
+    Compression.m_enabled = true;
+    Compression.m_threshold = 256;
+
+    // Инициализируем обрабутку событий
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_RequestCallBack = [&](const net::FrameView inData, const std::size_t inSenderID, const std::uint32_t inRequestID) -> void
+    {
+        const std::string Data(inData);
+
+        if (Data == "hold" && HoldSeen++ == 0) // Первый раз не отвечаем: сервер будет остановлен до ответа
+            return;
+
+        if (Server->respond(inSenderID, inRequestID, net::oByteStream(Data.substr(0, 8) + "!")))
+            OnServ_ClientError = true;
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack = [&](const errors::error_code, const std::size_t) -> void { OnServ_ClientError = true; };
+
+    const auto Track = [&](const std::string& inName)
+    {
+        return [&, inName](const errors::error_code inError, net::HMByteBuffer&& inData)
+        {
+            std::lock_guard lg(Defender);
+            Responses[inName] = { inError, inData.str() };
+        };
+    };
+
+    const auto StartServer = [&]()
+    {
+        Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+        Server->setCompression(Compression); // Сжатие получат все соединения сервера
+        return Server->start(); // Пытаемся запустить сервер
+    };
+
+    Error = StartServer();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    net::ReconnectSettings Settings;
+    Settings.m_initialDelay = C_WAIT_FAST;
+    Settings.m_maxDelay = C_WAIT_NORM;
+    Settings.m_connectTimeout = C_WAIT_LONG;
+
+    net::HMClientManager Manager([&](const net::ConCallbacks& inCallbacks)
+    {
+        net::ConCallbacks Callbacks = inCallbacks;
+        std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(Callbacks);
+        Client->setFramingMode(net::eFramingMode::fmLengthPrefixed); // Сжатие согласуется кадром согласования
+        Client->setCompression(Compression);
+        return Client;
+    }, net::ConCallbacks(), 1, Settings);
+
+    Error = Manager.start();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_LONG * 3); // Ожидаем подключения
+    ASSERT_EQ(Manager.connectedCount(), 1);
+
+    ASSERT_FALSE(Manager.request(net::oByteStream("first" + Message), Track("first"), C_WAIT_LONG * 20));
+    ASSERT_FALSE(Manager.request(net::oByteStream("hold"), Track("hold"), C_WAIT_LONG * 20));
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_EQ(Responses.count("first"), 1);
+        ASSERT_EQ(Responses["first"].second, "first{\"i!");
+        ASSERT_EQ(Responses.count("hold"), 0); // Сервер ещё не ответил
+    }
+
+    // Разрыв со стороны сервера: ожидающий запрос завершается ошибкой и повторяется менеджером после переподключения
+    Server->stop();
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    ASSERT_FALSE(Manager.isConnected());
+    ASSERT_EQ(HoldSeen, 1);
+
+    Error = StartServer(); // Новый сервер ничего не знает о прежнем сеансе
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_LONG * 3); // Ожидаем переподключения
+    ASSERT_EQ(Manager.connectedCount(), 1);
+    ASSERT_EQ(HoldSeen, 2);
+
+    // Сжатие нового сеанса начинается с чистого словаря, иначе сервер не распакует кадр
+    ASSERT_FALSE(Manager.request(net::oByteStream("again" + Message), Track("again"), C_WAIT_LONG * 20));
+    inBuilder->wait(C_WAIT_NORM); // Ожидаем
+
+    {
+        std::lock_guard lg(Defender);
+        ASSERT_FALSE(Responses["hold"].first);
+        ASSERT_EQ(Responses["hold"].second, "hold!");
+        ASSERT_FALSE(Responses["again"].first);
+        ASSERT_EQ(Responses["again"].second, "again{\"i!");
+    }
+
+    ASSERT_FALSE(OnServ_ClientError); // Сервер не должен получить повреждённых кадров
+
+    Manager.stop();
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HawkNet_RateLimits - Тест ограничения частоты входящих кадров и новых соединений
+ * @param inBuilder - Сборщик объектов теста
+ */
+void HawkNet_RateLimits(std::unique_ptr<NetTestBuilder>&& inBuilder)
+{
+    ASSERT_TRUE(inBuilder); // Требуется валидный билдер
+    errors::error_code Error; // Метка ошибки
+
+    // Инициализируем обрабутку событий
+    std::atomic<std::size_t> OnServ_Data = 0; // Количество кадров, полученных сервером
+    std::atomic<std::size_t> OnServ_SenderID = 0; // Идентификатор отправителя
+    std::atomic<std::size_t> OnServ_RateLimited = 0; // Количество сообщений о превышении пределов
+    std::atomic_bool OnServ_OtherError = false; // Сервер обработал другую ошибку
+
+    net::ServCallbacks ServCallBacks; // События сервера
+    ServCallBacks.m_conCalbacks.m_DataCallBack = [&](net::HMByteBuffer&&, const std::size_t inSenderID) -> void
+    {
+        OnServ_SenderID = inSenderID;
+        ++OnServ_Data;
+    };
+    ServCallBacks.m_conCalbacks.m_ErrorCallBack = [&](const errors::error_code inError, const std::size_t) -> void
+    {
+        if (inError == make_error_code(errors::eNetError::neRateLimited))
+            ++OnServ_RateLimited;
+        else
+            OnServ_OtherError = true;
+    };
+
+    net::ConCallbacks ClientCallBacks; // События клиента
+
+    net::RateLimits Limits;
+    Limits.m_framesPerSecond = 1; // За время теста запас не пополняется
+    Limits.m_frameBurst = 5;
+
+    // Инициализируем соединения
+    std::unique_ptr<net::HMServer> Server = inBuilder->make_server(ServCallBacks); // Создаём сервер
+    Server->setRateLimits(Limits);
+
+    Error = Server->start(); // Пытаемся запустить сервер
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    std::unique_ptr<net::HMConnection> Client = inBuilder->make_client(ClientCallBacks);
+    Error = Client->connect(); // Пытаемся подключится
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    inBuilder->wait(C_WAIT_FAST); // Ожидаем
+
+    constexpr std::size_t C_FRAMES = 50;
+    for (std::size_t Index = 0; Index < C_FRAMES; ++Index)
+        ASSERT_FALSE(Client->send(net::oByteStream("data")));
+
+    inBuilder->wait(C_WAIT_LONG * 2); // Ожидаем
+
+    // Сервер принял только запас, остальное отброшено без разрыва соединения
+    ASSERT_EQ(OnServ_Data, Limits.m_frameBurst);
+    ASSERT_EQ(OnServ_RateLimited, 1); // О серии отброшенных кадров сообщается однажды
+    ASSERT_FALSE(OnServ_OtherError);
+    ASSERT_TRUE(Client->isConnected());
+
+    net::ConnectionStats Stats;
+    ASSERT_FALSE(Server->connectionStats(OnServ_SenderID, Stats));
+    ASSERT_EQ(Stats.m_limitedFrames, C_FRAMES - Limits.m_frameBurst);
+    ASSERT_EQ(Stats.m_limitedBytes, (C_FRAMES - Limits.m_frameBurst) * 4);
+
+    net::AcceptLimits Accept;
+    Accept.m_connectionsPerSecond = 1; // За время теста запас не пополняется
+    Accept.m_burst = 2;
+    Server->setAcceptLimits(Accept);
+
+    // Сверх запаса соединения принимаются ядром, но сразу закрываются сервером
+    std::vector<std::unique_ptr<net::HMConnection>> Clients;
+    for (std::size_t Index = 0; Index < 5; ++Index)
+    {
+        Clients.push_back(inBuilder->make_client(ClientCallBacks));
+        Error = Clients.back()->connect(); // Исход подключения зависит от реализации и не проверяется
+    }
+
+    inBuilder->wait(C_WAIT_LONG * 2); // Ожидаем
+
+    const net::ServerStats ServStats = Server->stats();
+    ASSERT_EQ(ServStats.m_acceptedConnections, 1 + Accept.m_burst);
+    ASSERT_EQ(ServStats.m_rejectedConnections, Clients.size() - Accept.m_burst);
+    ASSERT_EQ(Server->connectionCount(), 1 + Accept.m_burst);
+
+    for (std::unique_ptr<net::HMConnection>& Connection : Clients)
+        Connection->disconnect();
+
+    Client->disconnect();
+    Server->stop();
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <neterrorcategory.h>
+#include <HawkNet.h>
+
+#include "HawkNetTest.hpp"
+
+//-----------------------------------------------------------------------------
+// Builder
+//-----------------------------------------------------------------------------
+/**
+ * @brief The UringNetTestBuilder class - Класс-конструктор объектов теста UringNet (io_uring с откатом на epoll)
+ */
+class UringNetTestBuilder : public NetTestBuilder
+{
+public:
+
+    /**
+     * @brief UringNetTestBuilder - Конскруктор по умолчанию
+     */
+    UringNetTestBuilder() = default;
+
+    /**
+     * @brief ~UringNetTestBuilder - Виртуальный деструктор по умолчанию
+     */
+    virtual ~UringNetTestBuilder() override = default;
+
+    /**
+     * @brief make_server - Метод сконструирует сервер
+     * @param inCallBacks - Калбэки сервера
+     * @param inPort - Прослушиваемый порт
+     * @param inWorkers - Количество рабочих потоков сервера
+     * @return Вернёт указатель на интерфейс сервера
+     */
+    virtual std::unique_ptr<net::HMServer> make_server(net::ServCallbacks& inCallBacks,
+                                                       const std::uint16_t inPort = C_PORT,
+                                                       const std::size_t inWorkers = 0) override
+    {
+        return net::makeNativeServer(inPort, inCallBacks, inWorkers); // На ядре без поддержки io_uring будет выбран epoll
+    }
+
+    /**
+     * @brief make_client - Метод сконструерует соединение
+     * @param inCallBacks - Калбэки соединения
+     * @param inHost - Адрес хоста
+     * @param inPort - Порт хоста
+     * @return Веренёт указатель на интерфейс соединения
+     */
+    virtual std::unique_ptr<net::HMConnection> make_client(net::ConCallbacks& inCallBacks,
+                                                           const std::string inHost = C_HOST,
+                                                           const std::uint16_t inPort = C_PORT) override
+    {
+        return net::makeNativeConnection(inHost, inPort, inCallBacks);
+    }
+
+    /**
+     * @brief wait - Метод выполнит задержку потока для ожидания
+     * @param inWaitTime - Время ожидания
+     */
+    virtual void wait(const std::chrono::milliseconds& inWaitTime) override
+    {
+        std::this_thread::sleep_for(inWaitTime); // События обрабатываются потоками циклов io_uring (epoll), достаточно просто подождать
+    }
+};
+//-----------------------------------------------------------------------------
+// Tests
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест выбора реализации по поддержке io_uring ядром
+ */
+TEST(UringNet, NativeBackend)
+{
+    net::ServCallbacks ServCallBacks; // События сервера
+    net::ConCallbacks ClientCallBacks; // События клиента
+
+    std::unique_ptr<net::HMServer> Server = net::makeNativeServer(C_PORT, ServCallBacks, 1);
+    std::unique_ptr<net::HMConnection> Client = net::makeNativeConnection(C_HOST, C_PORT, ClientCallBacks);
+
+    const bool Supported = net::HMUringLoop::isSupported();
+
+    ASSERT_EQ(dynamic_cast<net::HMUringAsyncServer*>(Server.get()) != nullptr, Supported);
+    ASSERT_EQ(dynamic_cast<net::HMEpollAsyncServer*>(Server.get()) != nullptr, !Supported); // Без io_uring откатываемся на epoll
+    ASSERT_EQ(dynamic_cast<net::HMUringAsyncConnection*>(Client.get()) != nullptr, Supported);
+    ASSERT_EQ(dynamic_cast<net::HMEpollAsyncConnection*>(Client.get()) != nullptr, !Supported);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест создания сервера
+ */
+TEST(UringNet, ServerStart)
+{
+    HawkNet_ServerStart(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест подключения клиента
+ */
+TEST(UringNet, ClientConnect)
+{
+    HawkNet_ClientConnect(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест подключения клиента
+ */
+TEST(UringNet, CliendReconnect)
+{
+    HawkNet_CliendReconnect(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения клиента
+ */
+TEST(UringNet, ClientDisconnect)
+{
+    HawkNet_ClientDisconnect(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения всех клиентов
+ */
+TEST(UringNet, ForcedDisconnectClient)
+{
+    HawkNet_ForcedDisconnectClient(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения всех клиентов
+ */
+TEST(UringNet, ForcedDisconnectAllClients)
+{
+    HawkNet_ForcedDisconnectAllClients(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест отключения сервера
+ */
+TEST(UringNet, ServerStop)
+{
+    HawkNet_ServerStop(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обработки отключения клиента с обеих сторон
+ */
+TEST(UringNet, CommonDisconnectEvents)
+{
+    HawkNet_CommonDisconnectEvents(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест присвоения идентификатора соединения
+ */
+TEST(UringNet, SetConnectionID)
+{
+    HawkNet_SetConnectionID(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи данных: Сервер - клиент
+ */
+TEST(UringNet, ServerToClientSendData)
+{
+    HawkNet_ServerToClientSendData(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи данны: Клиент - сервер
+ */
+TEST(UringNet, ClientToServerSendData)
+{
+    HawkNet_ClientToServerSendData(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест эхо сервера
+ */
+TEST(UringNet, Echo)
+{
+    HawkNet_Echo(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест передачи двоичных данных в режиме кадров с заголовком
+ */
+TEST(UringNet, LengthPrefixedFraming)
+{
+    HawkNet_LengthPrefixedFraming(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест приёма пачки мелких сообщений
+ */
+TEST(UringNet, ReceiveBurst)
+{
+    HawkNet_ReceiveBurst(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест обслуживания соединений рабочими потоками сервера
+ */
+TEST(UringNet, WorkerThreads)
+{
+    HawkNet_WorkerThreads(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест нагрузки
+ */
+TEST(UringNet, StressTest)
+{
+    HawkNet_StressTest(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения очереди отправки
+ */
+TEST(UringNet, SendQueueLimits)
+{
+    HawkNet_SendQueueLimits(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест согласования и сжатия кадров
+ */
+TEST(UringNet, Compression)
+{
+    HawkNet_Compression(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверки связи и разрыва по простою
+ */
+TEST(UringNet, Heartbeat)
+{
+    HawkNet_Heartbeat(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест конвейерных запросов
+ */
+TEST(UringNet, RequestPipelining)
+{
+    HawkNet_RequestPipelining(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест менеджера клиентских соединений
+ */
+TEST(UringNet, ClientManager)
+{
+    HawkNet_ClientManager(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест перезапуска сервера под менеджером клиентских соединений
+ */
+TEST(UringNet, ServerRestart)
+{
+    HawkNet_ServerRestart(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест ограничения частоты входящих кадров и соединений
+ */
+TEST(UringNet, RateLimits)
+{
+    HawkNet_RateLimits(std::make_unique<UringNetTestBuilder>());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка тестировани функционала errors::error_code
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт признак успешности тестирования
+ */
+int main(int argc, char *argv[])
+{   
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS(); // Вернёт результат выполнения
+}
+//-----------------------------------------------------------------------------
@@ -3,8 +3,11 @@
 
 #include "datastorage/interface/datastorageinterface.h"
 #include "datastorage/interface/abstractdatastoragefunctional.h"
+#include "datastorage/changefeed/changefeed.h"
 #include "datastorage/combineddatastorage/combineddatastorage.h"
 #include "datastorage/cachedmemorydatastorage/cachedmemorydatastorage.h"
 #include "datastorage/jsondatastorage/jsondatastorage.h"
+#include "datastorage/lsmdatastorage/lsmdatastorage.h"
+#include "datastorage/asyncdatastorage/asyncdatastorage.h"
 
 #endif // DATASTORAGE_H
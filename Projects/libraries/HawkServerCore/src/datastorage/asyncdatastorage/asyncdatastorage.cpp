@@ -0,0 +1,223 @@
+#include "asyncdatastorage.h"
+
+#include <cassert>
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+HMAsyncDataStorage::HMAsyncDataStorage(std::shared_ptr<HMDataStorage> inStorage, const std::size_t inWorkers) : hmcommon::HMNotCopyable(),
+    m_storage(inStorage),
+    m_executor(inWorkers)
+{
+    assert(m_storage != nullptr);
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMDataStorage> HMAsyncDataStorage::storage() const
+{
+    return m_storage;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMAsyncDataStorage::pending() const
+{
+    return m_executor.pending();
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::open(const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage]() { return Storage->open(); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+bool HMAsyncDataStorage::is_open() const
+{
+    return m_storage->is_open();
+}
+//-----------------------------------------------------------------------------
+std::future<void> HMAsyncDataStorage::close()
+{
+    std::shared_ptr<std::promise<void>> Promise = std::make_shared<std::promise<void>>();
+    std::future<void> Result = Promise->get_future();
+
+    m_executor.post([Storage = m_storage, Promise]()
+    {
+        Storage->close();
+        Promise->set_value();
+    });
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUser]() { return Storage->addUser(inUser); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::updateUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUser]() { return Storage->updateUser(inUser); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>> HMAsyncDataStorage::findUserByUUID(const QUuid& inUserUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>([Storage = m_storage, inUserUUID]()
+    {
+        StorageResult<std::shared_ptr<hmcommon::HMUserInfo>> Result;
+        Result.m_value = Storage->findUserByUUID(inUserUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>> HMAsyncDataStorage::findUserByAuthentication(const QString& inLogin, const QByteArray& inPasswordHash, const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>([Storage = m_storage, inLogin, inPasswordHash]()
+    {
+        StorageResult<std::shared_ptr<hmcommon::HMUserInfo>> Result;
+        Result.m_value = Storage->findUserByAuthentication(inLogin, inPasswordHash, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::removeUser(const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUserUUID]() { return Storage->removeUser(inUserUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::setUserContacts(const QUuid& inUserUUID, const std::shared_ptr<std::set<QUuid>> inContacts, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUserUUID, inContacts]() { return Storage->setUserContacts(inUserUUID, inContacts); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::addUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUserUUID, inContactUUID]() { return Storage->addUserContact(inUserUUID, inContactUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::removeUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUserUUID, inContactUUID]() { return Storage->removeUserContact(inUserUUID, inContactUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::clearUserContacts(const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inUserUUID]() { return Storage->clearUserContacts(inUserUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> HMAsyncDataStorage::getUserContactList(const QUuid& inUserUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<std::set<QUuid>>>>([Storage = m_storage, inUserUUID]()
+    {
+        StorageResult<std::shared_ptr<std::set<QUuid>>> Result;
+        Result.m_value = Storage->getUserContactList(inUserUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> HMAsyncDataStorage::getUserGroups(const QUuid& inUserUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<std::set<QUuid>>>>([Storage = m_storage, inUserUUID]()
+    {
+        StorageResult<std::shared_ptr<std::set<QUuid>>> Result;
+        Result.m_value = Storage->getUserGroups(inUserUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::addGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroup]() { return Storage->addGroup(inGroup); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::updateGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroup]() { return Storage->updateGroup(inGroup); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>> HMAsyncDataStorage::findGroupByUUID(const QUuid& inGroupUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>>([Storage = m_storage, inGroupUUID]()
+    {
+        StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>> Result;
+        Result.m_value = Storage->findGroupByUUID(inGroupUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::removeGroup(const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroupUUID]() { return Storage->removeGroup(inGroupUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::setGroupUsers(const QUuid& inGroupUUID, const std::shared_ptr<std::set<QUuid>> inUsers, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroupUUID, inUsers]() { return Storage->setGroupUsers(inGroupUUID, inUsers); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::addGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroupUUID, inUserUUID]() { return Storage->addGroupUser(inGroupUUID, inUserUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::removeGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroupUUID, inUserUUID]() { return Storage->removeGroupUser(inGroupUUID, inUserUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::clearGroupUsers(const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inGroupUUID]() { return Storage->clearGroupUsers(inGroupUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> HMAsyncDataStorage::getGroupUserList(const QUuid& inGroupUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<std::set<QUuid>>>>([Storage = m_storage, inGroupUUID]()
+    {
+        StorageResult<std::shared_ptr<std::set<QUuid>>> Result;
+        Result.m_value = Storage->getGroupUserList(inGroupUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::addMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inMessage]() { return Storage->addMessage(inMessage); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::updateMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inMessage]() { return Storage->updateMessage(inMessage); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>>> HMAsyncDataStorage::findMessage(const QUuid& inMessageUUID, const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>& inCallBack)
+{
+    return post<StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>([Storage = m_storage, inMessageUUID]()
+    {
+        StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Result;
+        Result.m_value = Storage->findMessage(inMessageUUID, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>> HMAsyncDataStorage::findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, const AsyncCallBackFn<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>& inCallBack)
+{
+    return post<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>([Storage = m_storage, inGroupUUID, inRange]()
+    {
+        StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>> Result;
+        Result.m_value = Storage->findMessages(inGroupUUID, inRange, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>> HMAsyncDataStorage::findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, const AsyncCallBackFn<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>& inCallBack)
+{
+    return post<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>([Storage = m_storage, inGroupUUID, inCursor]()
+    {
+        StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>> Result;
+        Result.m_value = Storage->findMessagesPage(inGroupUUID, inCursor, Result.m_error);
+        return Result;
+    }, inCallBack);
+}
+//-----------------------------------------------------------------------------
+std::future<errors::error_code> HMAsyncDataStorage::removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack)
+{
+    return post<errors::error_code>([Storage = m_storage, inMessageUUID, inGroupUUID]() { return Storage->removeMessage(inMessageUUID, inGroupUUID); }, inCallBack);
+}
+//-----------------------------------------------------------------------------
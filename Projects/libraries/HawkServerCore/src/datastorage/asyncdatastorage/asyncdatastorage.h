@@ -0,0 +1,385 @@
+#ifndef HMASYNCDATASTORAGE_H
+#define HMASYNCDATASTORAGE_H
+
+/**
+ * @file asyncdatastorage.h
+ * @brief Содержит описание асинхронного фасада хранилища данных
+ */
+
+#include <future>
+
+#include <HawkLog.h>
+
+#include "storageexecutor.h"
+#include "datastorage/interface/datastorageinterface.h"
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The StorageResult struct - Структура, описывающая результат асинхронного запроса к хранилищу
+ */
+template <class ValueType>
+struct StorageResult
+{
+    ValueType m_value {};           ///< Результат запроса
+    errors::error_code m_error;     ///< Признак ошибки
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief AsyncCallBackFn - Тип функции-обработчика завершения асинхронного запроса
+ * Вызывается в потоке исполнителя после того, как результат передан в std::future; исключение обработчика только логируется
+ */
+template <class ResultType>
+using AsyncCallBackFn = std::function<void(const ResultType& inResult)>;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMAsyncDataStorage class - Класс, описывающий асинхронный фасад хранилища данных
+ * Каждый запрос выполняется потоком исполнителя, результат возвращается через std::future и,
+ * если передан, через обработчик завершения. Обработчик вызывается в потоке исполнителя,
+ * поэтому работа с объектами Qt в нём должна передаваться в их поток (например, через QMetaObject::invokeMethod).
+ * Поставлено может быть сколько угодно запросов, а выполняется одновременно столько, сколько у исполнителя потоков.
+ * Больше одного потока допустимо только для потокобезопасных хранилищ (например, HMLsmDataStorage),
+ * HMJsonDataStorage и HMCombinedDataStorage над ним должны обслуживаться одним потоком.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMAsyncDataStorage : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMAsyncDataStorage - Инициализирующий конструктор
+     * @param inStorage - Хранилище, к которому выполняются запросы
+     * @param inWorkers - Количество потоков исполнителя (больше одного только для потокобезопасных хранилищ)
+     */
+    HMAsyncDataStorage(std::shared_ptr<HMDataStorage> inStorage, const std::size_t inWorkers = 1);
+
+    /**
+     * @brief ~HMAsyncDataStorage - Виртуальный деструктор (дожидается выполнения поставленных запросов)
+     */
+    virtual ~HMAsyncDataStorage() override = default;
+
+    /**
+     * @brief storage - Метод вернёт хранилище, к которому выполняются запросы
+     * @return Вернёт указатель на хранилище
+     */
+    std::shared_ptr<HMDataStorage> storage() const;
+
+    /**
+     * @brief pending - Метод вернёт количество запросов, ожидающих выполнения
+     * @return Вернёт количество запросов в очереди
+     */
+    std::size_t pending() const;
+
+    // Хранилище
+
+    /**
+     * @brief open - Метод асинхронно откроет хранилище
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> open(const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief is_open - Метод вернёт признак открытости хранилища (синхронно)
+     * @return Вернёт признак открытости
+     */
+    bool is_open() const;
+
+    /**
+     * @brief close - Метод асинхронно закроет хранилище (запрос встаёт в очередь за ранее поставленными)
+     * @return Вернёт будущее завершение закрытия
+     */
+    std::future<void> close();
+
+    // Пользователи
+
+    /**
+     * @brief addUser - Метод асинхронно добавит нового пользователя
+     * @param inUser - Данные пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief updateUser - Метод асинхронно обновит данные пользователя
+     * @param inUser - Обновлённые данные пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> updateUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief findUserByUUID - Метод асинхронно найдёт пользователя по UUID
+     * @param inUserUUID - Uuid пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>> findUserByUUID(const QUuid& inUserUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>& inCallBack = nullptr);
+
+    /**
+     * @brief findUserByAuthentication - Метод асинхронно найдёт пользователя по данным аутентификации
+     * @param inLogin - Логин пользователя
+     * @param inPasswordHash - Хеш пароля пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>> findUserByAuthentication(const QString& inLogin, const QByteArray& inPasswordHash,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMUserInfo>>>& inCallBack = nullptr);
+
+    /**
+     * @brief removeUser - Метод асинхронно удалит пользователя
+     * @param inUserUUID - Uuid пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> removeUser(const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief setUserContacts - Метод асинхронно задаст пользователю список контактов
+     * @param inUserUUID - UUID пользователя
+     * @param inContacts - Список контактов
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> setUserContacts(const QUuid& inUserUUID, const std::shared_ptr<std::set<QUuid>> inContacts,
+            const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief addUserContact - Метод асинхронно добавит контакт пользователю
+     * @param inUserUUID - UUID пользователя
+     * @param inContactUUID - UUID контакта
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> addUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief removeUserContact - Метод асинхронно удалит контакт пользователя
+     * @param inUserUUID - UUID пользователя
+     * @param inContactUUID - UUID контакта
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> removeUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief clearUserContacts - Метод асинхронно очистит список контактов пользователя
+     * @param inUserUUID - UUID пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> clearUserContacts(const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief getUserContactList - Метод асинхронно вернёт список контактов пользователя
+     * @param inUserUUID - UUID пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> getUserContactList(const QUuid& inUserUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack = nullptr);
+
+    /**
+     * @brief getUserGroups - Метод асинхронно вернёт список групп пользователя
+     * @param inUserUUID - UUID пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> getUserGroups(const QUuid& inUserUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack = nullptr);
+
+    // Группы
+
+    /**
+     * @brief addGroup - Метод асинхронно добавит новую группу
+     * @param inGroup - Данные группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> addGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief updateGroup - Метод асинхронно обновит данные группы
+     * @param inGroup - Обновлённые данные группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> updateGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief findGroupByUUID - Метод асинхронно найдёт группу по UUID
+     * @param inGroupUUID - Uuid группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>> findGroupByUUID(const QUuid& inGroupUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>>& inCallBack = nullptr);
+
+    /**
+     * @brief removeGroup - Метод асинхронно удалит группу
+     * @param inGroupUUID - Uuid группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> removeGroup(const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief setGroupUsers - Метод асинхронно задаст группе список участников
+     * @param inGroupUUID - UUID группы
+     * @param inUsers - Список участников
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> setGroupUsers(const QUuid& inGroupUUID, const std::shared_ptr<std::set<QUuid>> inUsers,
+            const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief addGroupUser - Метод асинхронно добавит участника группы
+     * @param inGroupUUID - UUID группы
+     * @param inUserUUID - UUID пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> addGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief removeGroupUser - Метод асинхронно удалит участника группы
+     * @param inGroupUUID - UUID группы
+     * @param inUserUUID - UUID пользователя
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> removeGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief clearGroupUsers - Метод асинхронно очистит список участников группы
+     * @param inGroupUUID - UUID группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> clearGroupUsers(const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief getGroupUserList - Метод асинхронно вернёт список участников группы
+     * @param inGroupUUID - UUID группы
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<std::set<QUuid>>>> getGroupUserList(const QUuid& inGroupUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<std::set<QUuid>>>>& inCallBack = nullptr);
+
+    // Сообщения
+
+    /**
+     * @brief addMessage - Метод асинхронно добавит новое сообщение
+     * @param inMessage - Новое сообщение
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> addMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief updateMessage - Метод асинхронно обновит данные сообщения
+     * @param inMessage - Обновлённое сообщение
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> updateMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+    /**
+     * @brief findMessage - Метод асинхронно найдёт сообщение по UUID
+     * @param inMessageUUID - UUID сообщения
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>>> findMessage(const QUuid& inMessageUUID,
+            const AsyncCallBackFn<StorageResult<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>& inCallBack = nullptr);
+
+    /**
+     * @brief findMessages - Метод асинхронно вернёт список сообщений группы за промежуток времени
+     * @param inGroupUUID - UUID группы
+     * @param inRange - Временной промежуток
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange,
+            const AsyncCallBackFn<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>& inCallBack = nullptr);
+
+    /**
+     * @brief findMessagesPage - Метод асинхронно вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - UUID группы
+     * @param inCursor - Курсор выборки
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат поиска
+     */
+    std::future<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor,
+            const AsyncCallBackFn<StorageResult<std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>>>& inCallBack = nullptr);
+
+    /**
+     * @brief removeMessage - Метод асинхронно удалит сообщение
+     * @param inMessageUUID - UUID сообщения
+     * @param inGroupUUID - UUID группы сообщения
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий признак ошибки
+     */
+    std::future<errors::error_code> removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID, const AsyncCallBackFn<errors::error_code>& inCallBack = nullptr);
+
+private:
+
+    const std::shared_ptr<HMDataStorage> m_storage; ///< Хранилище, к которому выполняются запросы
+    HMStorageExecutor m_executor;                   ///< Исполнитель запросов (уничтожается первым)
+
+    /**
+     * @brief post - Метод поставит запрос в очередь исполнителя
+     * @param inRequest - Запрос к хранилищу
+     * @param inCallBack - Обработчик завершения
+     * @return Вернёт будущий результат запроса
+     */
+    template <class ResultType>
+    std::future<ResultType> post(std::function<ResultType()> inRequest, const AsyncCallBackFn<ResultType>& inCallBack);
+
+};
+//-----------------------------------------------------------------------------
+template <class ResultType>
+std::future<ResultType> HMAsyncDataStorage::post(std::function<ResultType()> inRequest, const AsyncCallBackFn<ResultType>& inCallBack)
+{
+    std::shared_ptr<std::promise<ResultType>> Promise = std::make_shared<std::promise<ResultType>>();
+    std::future<ResultType> Result = Promise->get_future();
+
+    m_executor.post([Promise, Request = std::move(inRequest), inCallBack]()
+    {
+        try
+        {
+            ResultType Value = Request();
+            Promise->set_value(Value); // Результат доступен ожидающим до вызова обработчика и не зависит от него
+
+            if (inCallBack)
+            {
+                try
+                {
+                    inCallBack(Value);
+                }
+                catch (...) // Результат уже передан, исключение обработчика только логируем
+                {
+                    LOG_ERROR("Asynchronous storage callback failed with exception");
+                }
+            }
+        }
+        catch (...) // Исключение не должно уничтожить поток исполнителя
+        {
+            LOG_ERROR("Asynchronous storage request failed with exception");
+            Promise->set_exception(std::current_exception());
+        }
+    });
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMASYNCDATASTORAGE_H
@@ -0,0 +1,76 @@
+#include "storageexecutor.h"
+
+#include <algorithm>
+
+#include <HawkLog.h>
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+HMStorageExecutor::HMStorageExecutor(const std::size_t inWorkers) : hmcommon::HMNotCopyable()
+{
+    const std::size_t Workers = std::max<std::size_t>(inWorkers, 1);
+    m_workers.reserve(Workers);
+
+    for (std::size_t Index = 0; Index < Workers; ++Index)
+        m_workers.emplace_back(&HMStorageExecutor::workerThreadFunc, this);
+}
+//-----------------------------------------------------------------------------
+HMStorageExecutor::~HMStorageExecutor()
+{
+    {
+        std::lock_guard lg(m_queueDefender);
+        m_stop = true;
+    }
+    m_queueChanged.notify_all(); // Будим все потоки, они доработают очередь и завершатся
+
+    for (std::thread& Worker : m_workers)
+        if (Worker.joinable())
+            Worker.join();
+}
+//-----------------------------------------------------------------------------
+void HMStorageExecutor::post(StorageTaskFn inTask)
+{
+    {
+        std::lock_guard lg(m_queueDefender);
+        m_queue.push_back(std::move(inTask));
+    }
+    m_queueChanged.notify_one();
+}
+//-----------------------------------------------------------------------------
+std::size_t HMStorageExecutor::pending() const
+{
+    std::lock_guard lg(m_queueDefender);
+    return m_queue.size();
+}
+//-----------------------------------------------------------------------------
+std::size_t HMStorageExecutor::workers() const
+{
+    return m_workers.size();
+}
+//-----------------------------------------------------------------------------
+void HMStorageExecutor::workerThreadFunc()
+{
+    LOG_DEBUG("Storage executor worker Started");
+
+    while (true)
+    {
+        StorageTaskFn Task = nullptr;
+
+        {
+            std::unique_lock ul(m_queueDefender);
+            m_queueChanged.wait(ul, [&] { return m_stop || !m_queue.empty(); });
+
+            if (m_queue.empty()) // Остановка и очередь пуста
+                break;
+
+            Task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        Task(); // Задача выполняется без блокировки очереди
+    }
+
+    LOG_DEBUG("Storage executor worker Finished");
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+#ifndef HMSTORAGEEXECUTOR_H
+#define HMSTORAGEEXECUTOR_H
+
+/**
+ * @file storageexecutor.h
+ * @brief Содержит описание исполнителя запросов к хранилищу данных
+ */
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+#include <HawkCommon.h>
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief StorageTaskFn - Тип задачи исполнителя хранилища
+ */
+typedef std::function<void()> StorageTaskFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMStorageExecutor class - Класс, описывающий пул потоков, выполняющих запросы к хранилищу
+ * Задачи выполняются в порядке поступления, при уничтожении исполнитель дожидается выполнения всех поставленных задач.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMStorageExecutor : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMStorageExecutor - Инициализирующий конструктор
+     * @param inWorkers - Количество рабочих потоков (не меньше одного)
+     */
+    explicit HMStorageExecutor(const std::size_t inWorkers = 1);
+
+    /**
+     * @brief ~HMStorageExecutor - Виртуальный деструктор
+     */
+    virtual ~HMStorageExecutor() override;
+
+    /**
+     * @brief post - Метод поставит задачу в очередь исполнителя
+     * @param inTask - Задача
+     */
+    void post(StorageTaskFn inTask);
+
+    /**
+     * @brief pending - Метод вернёт количество задач, ожидающих выполнения
+     * @return Вернёт количество задач в очереди
+     */
+    std::size_t pending() const;
+
+    /**
+     * @brief workers - Метод вернёт количество рабочих потоков
+     * @return Вернёт количество рабочих потоков
+     */
+    std::size_t workers() const;
+
+private:
+
+    mutable std::mutex m_queueDefender;         ///< Мьютекс, защищающий очередь задач
+    std::condition_variable m_queueChanged;     ///< Условная переменная появления задач (или остановки)
+    std::deque<StorageTaskFn> m_queue;          ///< Очередь задач
+    bool m_stop = false;                        ///< Признак остановки исполнителя
+
+    std::vector<std::thread> m_workers;         ///< Рабочие потоки
+
+    /**
+     * @brief workerThreadFunc - Функция рабочего потока
+     */
+    void workerThreadFunc();
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMSTORAGEEXECUTOR_H
@@ -37,6 +37,48 @@ void HMCachedMemoryDataStorage::close()
 {    
     HMAbstractCahceDataStorage::close();
     clearCached(); // При закрытии чистим кеш
+
+    std::lock_guard lg(m_transactionDefender);
+    m_transactionDepth = 0;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCachedMemoryDataStorage::beginTransaction()
+{
+    std::lock_guard lg(m_transactionDefender);
+    ++m_transactionDepth;
+
+    return make_error_code(errors::eDataStorageError::dsSuccess);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCachedMemoryDataStorage::commitTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально помечаем как успех
+
+    std::lock_guard lg(m_transactionDefender);
+
+    if (!m_transactionDepth)
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+        --m_transactionDepth; // Изменения кеша уже применены, фиксировать нечего
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCachedMemoryDataStorage::rollbackTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально помечаем как успех
+
+    std::lock_guard lg(m_transactionDefender);
+
+    if (!m_transactionDepth)
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {
+        clearCached(); // Кеш мог запомнить отменённые изменения, перечитаем данные из основного хранилища
+        m_transactionDepth = 0;
+    }
+
+    return Error;
 }
 //-----------------------------------------------------------------------------
 errors::error_code HMCachedMemoryDataStorage::addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser)
@@ -441,6 +483,14 @@ std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMCachedMemoryDataSto
     return std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>();
 }
 //-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMCachedMemoryDataStorage::findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const
+{
+    Q_UNUSED(inGroupUUID);
+    Q_UNUSED(inCursor);
+    outErrorCode = make_error_code(errors::eDataStorageError::dsMessageNotExists); // Чесно говорим, что сообщения не кешированы
+    return std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>();
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMCachedMemoryDataStorage::removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID)
 {
     Q_UNUSED(inMessageUUID);
@@ -448,15 +498,45 @@ errors::error_code HMCachedMemoryDataStorage::removeMessage(const QUuid& inMessa
     return make_error_code(errors::eDataStorageError::dsSuccess); // Наплевать, было сообщение в кеше или нет
 }
 //-----------------------------------------------------------------------------
+void HMCachedMemoryDataStorage::evictUser(const QUuid& inUserUUID)
+{
+    {
+        std::unique_lock ul(m_usersDefender); // Эксклюзивно блокируем доступ к пользователям
+        m_cachedUsers.erase(HMCachedUser(std::make_shared<hmcommon::HMUserInfo>(inUserUUID)));
+    }
+
+    std::unique_lock ul(m_userContactsDefender); // Эксклюзивно блокируем связи пользователь-контакты
+    m_cachedUserContacts.erase(HMCachedUserContacts(inUserUUID, std::make_shared<std::set<QUuid>>()));
+}
+//-----------------------------------------------------------------------------
+void HMCachedMemoryDataStorage::evictGroup(const QUuid& inGroupUUID)
+{
+    {
+        std::unique_lock ul(m_groupsDefender); // Эксклюзивно блокируем доступ к группам
+        m_cachedGroups.erase(HMCachedGroup(std::make_shared<hmcommon::HMGroupInfo>(inGroupUUID)));
+    }
+
+    std::unique_lock ul(m_userGroupUsersDefender); // Эксклюзивно блокируем участников групп
+    m_cachedGroupUsers.erase(HMCachedGroupUsers(inGroupUUID, std::make_shared<std::set<QUuid>>()));
+}
+//-----------------------------------------------------------------------------
+void HMCachedMemoryDataStorage::evictMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID)
+{
+    Q_UNUSED(inMessageUUID);
+    Q_UNUSED(inGroupUUID); // Сообщения не кешируются
+}
+//-----------------------------------------------------------------------------
 void HMCachedMemoryDataStorage::clearCached()
 {
     std::unique_lock ulu(m_usersDefender);
     std::unique_lock ulg(m_groupsDefender);
     std::unique_lock uluc(m_userContactsDefender);
+    std::unique_lock ulgu(m_userGroupUsersDefender);
 
     m_cachedGroups.clear();
     m_cachedUsers.clear();
     m_cachedUserContacts.clear();
+    m_cachedGroupUsers.clear();
 }
 //-----------------------------------------------------------------------------
 void HMCachedMemoryDataStorage::processCacheInThread()
@@ -6,6 +6,7 @@
  * @brief Содержит описание класса кеширующего хранилища данных
  */
 
+#include <mutex>
 #include <chrono>
 #include <shared_mutex>
 #include <unordered_set>
@@ -38,6 +39,9 @@ private:
     mutable std::shared_mutex m_userGroupUsersDefender;             ///< Мьютекс, защищающий перечень участников группы
     std::unordered_set<HMCachedGroupUsers> m_cachedGroupUsers;      ///< Кешированные перечни участников группы
 
+    std::mutex m_transactionDefender;                               ///< Мьютекс, защищающий глубину транзакции
+    std::size_t m_transactionDepth = 0;                             ///< Глубина вложенности транзакций
+
     /**
      * @brief clearCached - Метод очистит закешированные данные
      */
@@ -77,6 +81,27 @@ public:
      */
     virtual void close() override;
 
+    // Транзакции
+
+    /**
+     * @brief beginTransaction - Метод начнёт транзакцию (вложенный вызов только увеличит глубину)
+     * Кеш не откладывает изменения, поэтому откат транзакции сбрасывает его целиком
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginTransaction() override;
+
+    /**
+     * @brief commitTransaction - Метод завершит транзакцию (завершение внешней транзакции фиксирует изменения)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code commitTransaction() override;
+
+    /**
+     * @brief rollbackTransaction - Метод отменит все изменения транзакции (на любой глубине вложенности)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code rollbackTransaction() override;
+
     // Пользователи
 
     /**
@@ -267,6 +292,15 @@ public:
      */
     virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const override;
 
+    /**
+     * @brief findMessagesPage - Метод вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inCursor - Курсор (позиция, направление и размер страницы)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт не более inCursor.m_limit ближайших к курсору сообщений, упорядоченных по времени создания
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const override;
+
     /**
      * @brief removeMessage - Метод удалит сообщение
      * @param inMessageUUID - Uuid сообщения
@@ -275,6 +309,27 @@ public:
      */
     virtual errors::error_code removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID) override;
 
+    // Вытеснение
+
+    /**
+     * @brief evictUser - Метод вытеснит из кеша пользователя и его список контактов (следующий запрос перечитает их из основного хранилища)
+     * @param inUserUUID - Uuid пользователя
+     */
+    virtual void evictUser(const QUuid& inUserUUID) override;
+
+    /**
+     * @brief evictGroup - Метод вытеснит из кеша группу и список её участников
+     * @param inGroupUUID - Uuid группы
+     */
+    virtual void evictGroup(const QUuid& inGroupUUID) override;
+
+    /**
+     * @brief evictMessage - Метод вытеснит из кеша сообщение
+     * @param inMessageUUID - Uuid сообщения
+     * @param inGroupUUID - Uuid группы
+     */
+    virtual void evictMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID) override;
+
 protected:
 
     /**
@@ -0,0 +1,136 @@
+#include "changefeed.h"
+
+#include <algorithm>
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief roundCapacity - Функция округлит ёмкость очереди вверх до степени двойки
+ * @param inCapacity - Запрошенная ёмкость
+ * @return Вернёт ёмкость очереди
+ */
+static std::size_t roundCapacity(const std::size_t inCapacity)
+{
+    std::size_t Result = 1;
+
+    while (Result < inCapacity)
+        Result <<= 1;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+// HMChangeSubscription
+//-----------------------------------------------------------------------------
+HMChangeSubscription::HMChangeSubscription(const std::size_t inCapacity, ChangeNotifyFn inNotify) : hmcommon::HMNotCopyable(),
+    m_ring(roundCapacity(inCapacity)),
+    m_mask(m_ring.size() - 1),
+    m_notify(inNotify)
+{
+
+}
+//-----------------------------------------------------------------------------
+bool HMChangeSubscription::pop(ChangeEvent& outEvent)
+{
+    const std::size_t Head = m_head.load(std::memory_order_relaxed);
+
+    if (Head == m_tail.load(std::memory_order_acquire)) // Очередь пуста
+        return false;
+
+    outEvent = m_ring[Head & m_mask];
+    m_head.store(Head + 1, std::memory_order_release); // Освобождаем ячейку для ленты
+    return true;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMChangeSubscription::size() const
+{
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+}
+//-----------------------------------------------------------------------------
+std::size_t HMChangeSubscription::capacity() const
+{
+    return m_ring.size();
+}
+//-----------------------------------------------------------------------------
+std::size_t HMChangeSubscription::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+//-----------------------------------------------------------------------------
+bool HMChangeSubscription::push(const ChangeEvent& inEvent)
+{
+    const std::size_t Tail = m_tail.load(std::memory_order_relaxed);
+
+    if (Tail - m_head.load(std::memory_order_acquire) == m_ring.size()) // Очередь переполнена, подписчик не успевает
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_ring[Tail & m_mask] = inEvent;
+    m_tail.store(Tail + 1, std::memory_order_release); // Публикуем ячейку для подписчика
+    return true;
+}
+//-----------------------------------------------------------------------------
+// HMChangeFeed
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMChangeSubscription> HMChangeFeed::subscribe(const std::size_t inCapacity, ChangeNotifyFn inNotify)
+{
+    std::shared_ptr<HMChangeSubscription> Result = std::make_shared<HMChangeSubscription>(inCapacity, inNotify);
+
+    std::lock_guard lg(m_defender);
+    m_subscribers.push_back(Result);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMChangeFeed::publish(const eChangeType inType, const QUuid& inObject, const QUuid& inRelated)
+{
+    ChangeEvent Event;
+    std::vector<std::shared_ptr<HMChangeSubscription>> Notified; // Подписки, которые оповестим после освобождения мьютекса
+
+    {
+        std::lock_guard lg(m_defender); // Публикация под мьютексом делает ленту единственным писателем каждой очереди
+
+        Event.m_sequence = ++m_sequence;
+        Event.m_type = inType;
+        Event.m_object = inObject;
+        Event.m_related = inRelated;
+
+        auto It = m_subscribers.begin();
+
+        while (It != m_subscribers.end())
+        {
+            std::shared_ptr<HMChangeSubscription> Subscription = It->lock();
+
+            if (!Subscription) // Подписка отменена
+                It = m_subscribers.erase(It);
+            else
+            {
+                if (Subscription->push(Event) && Subscription->m_notify)
+                    Notified.push_back(std::move(Subscription));
+
+                ++It;
+            }
+        }
+    }
+
+    for (const auto& Subscription : Notified) // Оповещение вне мьютекса не задерживает других издателей и допускает обращение к ленте
+        Subscription->m_notify();
+
+    return Event.m_sequence;
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMChangeFeed::sequence() const
+{
+    std::lock_guard lg(m_defender);
+    return m_sequence;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMChangeFeed::subscribersCount() const
+{
+    std::lock_guard lg(m_defender);
+    return static_cast<std::size_t>(std::count_if(m_subscribers.cbegin(), m_subscribers.cend(),
+                                                  [](const std::weak_ptr<HMChangeSubscription>& inSubscription) { return !inSubscription.expired(); }));
+}
+//-----------------------------------------------------------------------------
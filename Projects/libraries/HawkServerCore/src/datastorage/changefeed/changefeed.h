@@ -0,0 +1,193 @@
+#ifndef HMCHANGEFEED_H
+#define HMCHANGEFEED_H
+
+/**
+ * @file changefeed.h
+ * @brief Содержит описание ленты изменений хранилища данных
+ */
+
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include <QUuid>
+
+#include <HawkCommon.h>
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+static constexpr std::size_t CHANGE_FEED_DEFAULT_CAPACITY = 1024; ///< Ёмкость очереди подписчика по умолчанию (событий)
+//-----------------------------------------------------------------------------
+/**
+ * @brief The eChangeType enum - Перечень типов изменений хранилища
+ */
+enum class eChangeType
+{
+    ctUserAdded,            ///< Добавлен пользователь (m_object - пользователь)
+    ctUserUpdated,          ///< Обновлён пользователь (m_object - пользователь)
+    ctUserRemoved,          ///< Удалён пользователь (m_object - пользователь)
+    ctUserContactsChanged,  ///< Изменён список контактов (m_object - пользователь, m_related - контакт или пустой UUID при замене списка)
+    ctGroupAdded,           ///< Добавлена группа (m_object - группа)
+    ctGroupUpdated,         ///< Обновлена группа (m_object - группа)
+    ctGroupRemoved,         ///< Удалена группа (m_object - группа)
+    ctGroupUsersChanged,    ///< Изменён список участников (m_object - группа, m_related - участник или пустой UUID при замене списка)
+    ctMessageAdded,         ///< Добавлено сообщение (m_object - сообщение, m_related - группа)
+    ctMessageUpdated,       ///< Обновлено сообщение (m_object - сообщение, m_related - группа)
+    ctMessageRemoved,       ///< Удалено сообщение (m_object - сообщение, m_related - группа)
+
+    ctCount
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The ChangeEvent struct - Структура, описывающая событие изменения хранилища
+ */
+struct ChangeEvent
+{
+    std::uint64_t m_sequence = 0;               ///< Порядковый номер события (монотонно возрастает, без пропусков)
+    eChangeType m_type = eChangeType::ctCount;  ///< Тип изменения
+    QUuid m_object;                             ///< UUID изменённого объекта
+    QUuid m_related;                            ///< UUID связанного объекта
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief ChangeNotifyFn - Тип функции-оповещения о появлении событий в очереди подписчика
+ * Вызывается в потоке, изменившем хранилище, поэтому должна быть лёгкой (например, будить поток подписчика)
+ */
+typedef std::function<void()> ChangeNotifyFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMChangeSubscription class - Класс, описывающий подписку на ленту изменений
+ * Содержит ограниченную кольцевую очередь без блокировок с одним писателем (лента) и одним читателем (подписчик).
+ * При переполнении новые события отбрасываются и учитываются в dropped(), а читатель видит разрыв в m_sequence.
+ * Подписка отменяется уничтожением последнего указателя на неё.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMChangeSubscription : public hmcommon::HMNotCopyable
+{
+    friend class HMChangeFeed;
+
+public:
+
+    /**
+     * @brief HMChangeSubscription - Инициализирующий конструктор
+     * @param inCapacity - Ёмкость очереди (округляется вверх до степени двойки)
+     * @param inNotify - Функция оповещения о новых событиях
+     */
+    HMChangeSubscription(const std::size_t inCapacity, ChangeNotifyFn inNotify = nullptr);
+
+    /**
+     * @brief ~HMChangeSubscription - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMChangeSubscription() override = default;
+
+    /**
+     * @brief pop - Метод извлечёт очередное событие (только поток подписчика)
+     * @param outEvent - Извлечённое событие
+     * @return Вернёт признак наличия события
+     */
+    bool pop(ChangeEvent& outEvent);
+
+    /**
+     * @brief size - Метод вернёт приблизительное количество событий в очереди
+     * @return Вернёт количество событий
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief capacity - Метод вернёт ёмкость очереди
+     * @return Вернёт ёмкость очереди
+     */
+    std::size_t capacity() const;
+
+    /**
+     * @brief dropped - Метод вернёт количество событий, отброшенных из-за переполнения очереди
+     * @return Вернёт количество отброшенных событий
+     */
+    std::size_t dropped() const;
+
+private:
+
+    std::vector<ChangeEvent> m_ring;                ///< Кольцевой буфер событий
+    const std::size_t m_mask;                       ///< Маска индекса кольцевого буфера
+    const ChangeNotifyFn m_notify;                  ///< Функция оповещения о новых событиях
+
+    alignas(64) std::atomic_size_t m_head {0};      ///< Индекс чтения (изменяет только подписчик)
+    alignas(64) std::atomic_size_t m_tail {0};      ///< Индекс записи (изменяет только лента)
+    std::atomic_size_t m_dropped {0};               ///< Количество отброшенных событий
+
+    /**
+     * @brief push - Метод поместит событие в очередь (только лента, под её мьютексом)
+     * @param inEvent - Событие
+     * @return Вернёт false, если очередь переполнена
+     */
+    bool push(const ChangeEvent& inEvent);
+
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMChangeFeed class - Класс, описывающий ленту изменений хранилища
+ * Присваивает событиям порядковые номера и раздаёт их всем живым подпискам.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMChangeFeed : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMChangeFeed - Конструктор по умолчанию
+     */
+    HMChangeFeed() = default;
+
+    /**
+     * @brief ~HMChangeFeed - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMChangeFeed() override = default;
+
+    /**
+     * @brief subscribe - Метод оформит подписку на события, опубликованные после её создания
+     * @param inCapacity - Ёмкость очереди подписчика
+     * @param inNotify - Функция оповещения о новых событиях
+     * @return Вернёт подписку
+     */
+    std::shared_ptr<HMChangeSubscription> subscribe(const std::size_t inCapacity = CHANGE_FEED_DEFAULT_CAPACITY, ChangeNotifyFn inNotify = nullptr);
+
+    /**
+     * @brief publish - Метод опубликует событие
+     * @param inType - Тип изменения
+     * @param inObject - UUID изменённого объекта
+     * @param inRelated - UUID связанного объекта
+     * @return Вернёт порядковый номер события
+     */
+    std::uint64_t publish(const eChangeType inType, const QUuid& inObject, const QUuid& inRelated = QUuid());
+
+    /**
+     * @brief sequence - Метод вернёт порядковый номер последнего опубликованного события
+     * @return Вернёт порядковый номер (0, если событий не было)
+     */
+    std::uint64_t sequence() const;
+
+    /**
+     * @brief subscribersCount - Метод вернёт количество живых подписок
+     * @return Вернёт количество подписок
+     */
+    std::size_t subscribersCount() const;
+
+private:
+
+    mutable std::mutex m_defender;                                  ///< Мьютекс, упорядочивающий публикацию
+    std::uint64_t m_sequence = 0;                                   ///< Порядковый номер последнего события
+    std::vector<std::weak_ptr<HMChangeSubscription>> m_subscribers; ///< Подписки
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMCHANGEFEED_H
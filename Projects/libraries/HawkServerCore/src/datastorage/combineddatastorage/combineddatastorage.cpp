@@ -48,11 +48,135 @@ bool HMCombinedDataStorage::is_open() const
 //-----------------------------------------------------------------------------
 void HMCombinedDataStorage::close()
 {
+    std::lock_guard lg(m_writeDefender); // Транзакция другого потока будет дождана
+
     if  (m_HardStorage->is_open()) // Если физическое хранилище открыто
         m_HardStorage->close(); // Закрываем
 
     if (m_CacheStorage && m_CacheStorage->is_open()) // Если кеширующее хранилище доступно и открыто
         m_CacheStorage->close(); // Закрываем
+
+    for (; m_transactionDepth; --m_transactionDepth) // Хранилища отбросили незавершённую транзакцию этого потока, освобождаем её блокировку
+        m_writeDefender.unlock();
+
+    m_transactionOwner = std::thread::id();
+    m_transactionChanges.clear();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCombinedDataStorage::beginTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        m_writeDefender.lock(); // Блокировка удерживается до завершения транзакции, изменения других потоков её дождутся
+        Error = m_HardStorage->beginTransaction(); // Сначала открываем транзакцию физического хранилища
+
+        if (!Error && m_CacheStorage) // Если транзакция открыта и доступен кеш
+        {
+            Error = m_CacheStorage->beginTransaction();
+
+            if (Error) // Транзакция должна быть открыта в обоих хранилищах
+            {
+                errors::error_code HardError = m_HardStorage->rollbackTransaction();
+                if (HardError) // Ошибки отката обрабатываем отдельно
+                    LOG_WARNING(HardError.message_qstr());
+            }
+        }
+
+        if (Error)
+            m_writeDefender.unlock();
+        else
+        {
+            ++m_transactionDepth;
+            m_transactionOwner = std::this_thread::get_id();
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCombinedDataStorage::commitTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (m_transactionOwner != std::this_thread::get_id()) // Завершить транзакцию может только открывший её поток
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {   // Поток владеет блокировкой записи, состояние транзакции принадлежит ему
+        std::size_t Released = 1; // Количество освобождаемых уровней блокировки
+        std::vector<ChangeEvent> Changes; // Изменения, о которых оповестим после фиксации
+
+        Error = m_HardStorage->commitTransaction(); // Фиксируем изменения физического хранилища
+
+        if (m_CacheStorage) // Если доступен кеш
+        {
+            errors::error_code CacheError = (Error) ? m_CacheStorage->rollbackTransaction() : m_CacheStorage->commitTransaction(); // Не удалось зафиксировать, кеш сбрасывается
+            if (CacheError) // Ошибки кеша обрабатывам отдельно
+                LOG_WARNING(CacheError.message_qstr());
+        }
+
+        if (Error) // Физическое хранилище откатило транзакцию целиком
+        {
+            Released = m_transactionDepth;
+            m_transactionDepth = 0;
+        }
+        else
+            --m_transactionDepth;
+
+        if (!m_transactionDepth) // Внешняя транзакция завершена
+        {
+            if (!Error)
+                Changes.swap(m_transactionChanges);
+
+            m_transactionChanges.clear();
+            m_transactionOwner = std::thread::id();
+        }
+
+        ++m_cacheGeneration; // Неудачная фиксация откатывает физическое хранилище, прочитанные в транзакции данные устарели
+
+        for (const ChangeEvent& Change : Changes) // Оповещаем подписчиков до освобождения блокировки, чтобы события других писателей не опередили транзакцию
+            m_changeFeed.publish(Change.m_type, Change.m_object, Change.m_related);
+
+        for (; Released; --Released)
+            m_writeDefender.unlock();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMCombinedDataStorage::rollbackTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (m_transactionOwner != std::this_thread::get_id()) // Отменить транзакцию может только открывший её поток
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {
+        Error = m_HardStorage->rollbackTransaction(); // Отменяем изменения физического хранилища
+
+        if (m_CacheStorage) // Если доступен кеш
+        {
+            errors::error_code CacheError = m_CacheStorage->rollbackTransaction(); // Сбрасываем кеш, запомнивший отменённые изменения
+            if (CacheError) // Ошибки кеша обрабатывам отдельно
+                LOG_WARNING(CacheError.message_qstr());
+        }
+
+        m_transactionChanges.clear(); // Об отменённых изменениях подписчики не узнают
+        m_transactionOwner = std::thread::id();
+        ++m_cacheGeneration; // Прочитанные в транзакции данные отменены и не должны попасть в кеш
+
+        for (; m_transactionDepth; --m_transactionDepth) // Освобождаем блокировку всех уровней вложенности
+            m_writeDefender.unlock();
+    }
+
+    return Error;
 }
 //-----------------------------------------------------------------------------
 errors::error_code HMCombinedDataStorage::addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser)
@@ -63,6 +187,8 @@ errors::error_code HMCombinedDataStorage::addUser(const std::shared_ptr<hmcommon
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inUser) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -72,10 +198,16 @@ errors::error_code HMCombinedDataStorage::addUser(const std::shared_ptr<hmcommon
             if (!Error && m_CacheStorage) // Если пользователь успешно добавлен в физическое хранилище и доступен кеш
             {
                 errors::error_code CacheError = m_CacheStorage->addUser(inUser); // Добавляем пользователя в кеш
-                if (CacheError) // Ошибки кеша обрабатывам отдельно
+                if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                {
                     LOG_WARNING(CacheError.message_qstr());
+                    m_CacheStorage->evictUser(inUser->m_uuid);
+                }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserAdded, inUser->m_uuid);
     }
 
     return Error;
@@ -89,6 +221,8 @@ errors::error_code HMCombinedDataStorage::updateUser(const std::shared_ptr<hmcom
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inUser) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -101,11 +235,17 @@ errors::error_code HMCombinedDataStorage::updateUser(const std::shared_ptr<hmcom
                 if (CacheError) // Не удалось обновить пользователя в кеше
                 {
                     CacheError = m_CacheStorage->addUser(inUser); // Добавляем в кеш обновлённый объект
-                    if (CacheError) // Если и добавление не прошло то обрабатываем ошибку отдельно
+                    if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                    {
                         LOG_WARNING(CacheError.message_qstr());
+                        m_CacheStorage->evictUser(inUser->m_uuid);
+                    }
                 }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserUpdated, inUser->m_uuid);
     }
 
     return Error;
@@ -131,9 +271,11 @@ std::shared_ptr<hmcommon::HMUserInfo> HMCombinedDataStorage::findUserByUUID(cons
 
         if (CacheError) // Если в кеше не удалось найти пользователя
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->findUserByUUID(inUserUUID, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если пользователь успешно найден в физическое хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если пользователь успешно найден в физическое хранилище и доступен кеш
             {   // Добавим его в кеш
                 CacheError = m_CacheStorage->addUser(Result);
                 if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -172,9 +314,11 @@ std::shared_ptr<hmcommon::HMUserInfo> HMCombinedDataStorage::findUserByAuthentic
         {   // Проверям что всётаки ошибка!
             if (CacheError) // Если в кеше не удалось найти пользователя
             {   // Ищим в физическом хранилище
+                const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
                 Result = m_HardStorage->findUserByAuthentication(inLogin, inPasswordHash, outErrorCode);
+                const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-                if (!outErrorCode && m_CacheStorage) // Если пользователь успешно найден в физическое хранилище и доступен кеш
+                if (!outErrorCode && m_CacheStorage && FillLock) // Если пользователь успешно найден в физическое хранилище и доступен кеш
                 {   // Добавим его в кеш
                     CacheError = m_CacheStorage->addUser(Result);
                     if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -198,14 +342,22 @@ errors::error_code HMCombinedDataStorage::removeUser(const QUuid& inUserUUID)
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->removeUser(inUserUUID); // Удаляем пользователя в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если пользователь успешно удалён в физическое хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->removeUser(inUserUUID); // Удаляем пользователя из кеша
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictUser(inUserUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserRemoved, inUserUUID);
     }
 
     return Error;
@@ -219,6 +371,8 @@ errors::error_code HMCombinedDataStorage::setUserContacts(const QUuid& inUserUUI
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inContacts) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -228,10 +382,16 @@ errors::error_code HMCombinedDataStorage::setUserContacts(const QUuid& inUserUUI
             if (!Error && m_CacheStorage) // Если связь успешно добавлена в физическое хранилище и доступен кеш
             {
                 errors::error_code CacheError = m_CacheStorage->setUserContacts(inUserUUID, inContacts); // Добавляем связь в кеш
-                if (CacheError) // Ошибки кеша обрабатывам отдельно
+                if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                {
                     LOG_WARNING(CacheError.message_qstr());
+                    m_CacheStorage->evictUser(inUserUUID);
+                }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserContactsChanged, inUserUUID);
     }
 
     return Error;
@@ -245,14 +405,22 @@ errors::error_code HMCombinedDataStorage::addUserContact(const QUuid& inUserUUID
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->addUserContact(inUserUUID, inContactUUID); // Пытаемся добавить контакт в связь в физического хранилища
 
         if (!Error && m_CacheStorage) // Если контакт успешно добавлен в связь физического хранилища и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->addUserContact(inUserUUID, inContactUUID); // Добавляем контакт в связь в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictUser(inUserUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserContactsChanged, inUserUUID, inContactUUID);
     }
 
     return Error;
@@ -266,14 +434,22 @@ errors::error_code HMCombinedDataStorage::removeUserContact(const QUuid& inUserU
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->removeUserContact(inUserUUID, inContactUUID); // Пытаемся удалить контакт из связи в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если контакт успешно удалён из связи в физическом хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->removeUserContact(inUserUUID, inContactUUID); // Удаляем контакт из связи в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictUser(inUserUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserContactsChanged, inUserUUID, inContactUUID);
     }
 
     return Error;
@@ -287,14 +463,22 @@ errors::error_code HMCombinedDataStorage::clearUserContacts(const QUuid& inUserU
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->clearUserContacts(inUserUUID); // Пытаемся удалить связь в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если связь удалена в физическом хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->clearUserContacts(inUserUUID); // Удаляем связь в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictUser(inUserUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctUserContactsChanged, inUserUUID);
     }
 
     return Error;
@@ -320,9 +504,11 @@ std::shared_ptr<std::set<QUuid>> HMCombinedDataStorage::getUserContactList(const
 
         if (CacheError) // Если в кеше не удалось найти связь
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->getUserContactList(inUserUUID, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если список контактов успешно найден в физическом хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если список контактов успешно найден в физическом хранилище и доступен кеш
             {
                 CacheError = m_CacheStorage->setUserContacts(inUserUUID, Result); // Добавим его в кеш
                 if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -378,6 +564,8 @@ errors::error_code HMCombinedDataStorage::addGroup(const std::shared_ptr<hmcommo
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inGroup) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -387,10 +575,16 @@ errors::error_code HMCombinedDataStorage::addGroup(const std::shared_ptr<hmcommo
             if (!Error && m_CacheStorage) // Если группа успешно добавлена в физическое хранилище и доступен кеш
             {
                 errors::error_code CacheError = m_CacheStorage->addGroup(inGroup); // Добавляем группу в кеш
-                if (CacheError) // Ошибки кеша обрабатывам отдельно
+                if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                {
                     LOG_WARNING(CacheError.message_qstr());
+                    m_CacheStorage->evictGroup(inGroup->m_uuid);
+                }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupAdded, inGroup->m_uuid);
     }
 
     return Error;
@@ -404,6 +598,8 @@ errors::error_code HMCombinedDataStorage::updateGroup(const std::shared_ptr<hmco
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inGroup) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -416,11 +612,17 @@ errors::error_code HMCombinedDataStorage::updateGroup(const std::shared_ptr<hmco
                 if (CacheError) // Если не удалось обновить объект
                 {
                     CacheError = m_CacheStorage->addGroup(inGroup); // То добавляем в кеш уже обновлённый объект
-                    if (CacheError) // Если и добавление не прошло
-                        LOG_WARNING(CacheError.message_qstr()); // Обрабатываем ошибку
+                    if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                    {
+                        LOG_WARNING(CacheError.message_qstr());
+                        m_CacheStorage->evictGroup(inGroup->m_uuid);
+                    }
                 }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupUpdated, inGroup->m_uuid);
     }
 
     return Error;
@@ -446,9 +648,11 @@ std::shared_ptr<hmcommon::HMGroupInfo> HMCombinedDataStorage::findGroupByUUID(co
 
         if (CacheError) // Если в кеше не удалось найти группу
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->findGroupByUUID(inGroupUUID, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если группа успешно найдена в физическое хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если группа успешно найдена в физическое хранилище и доступен кеш
             {   // Добавим её в кеш
                 CacheError = m_CacheStorage->addGroup(Result);
                 if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -471,14 +675,22 @@ errors::error_code HMCombinedDataStorage::removeGroup(const QUuid& inGroupUUID)
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->removeGroup(inGroupUUID); // Удаляем группу в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если группа успешно удалёна в физическое хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->removeGroup(inGroupUUID); // Удаляем группу из кеша
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictGroup(inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupRemoved, inGroupUUID);
     }
 
     return Error;
@@ -492,14 +704,22 @@ errors::error_code HMCombinedDataStorage::setGroupUsers(const QUuid& inGroupUUID
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->setGroupUsers(inGroupUUID, inUsers); // Пытаемся добавить связь в физическое хранилище
 
         if (!Error && m_CacheStorage) // Если связь успешно добавлена в физическое хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->setGroupUsers(inGroupUUID, inUsers); // Добавляем связь в кеш
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictGroup(inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupUsersChanged, inGroupUUID);
     }
 
     return Error;
@@ -513,14 +733,22 @@ errors::error_code HMCombinedDataStorage::addGroupUser(const QUuid& inGroupUUID,
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->addGroupUser(inGroupUUID, inUserUUID); // Пытаемся добавить пользователя в связь в физического хранилища
 
         if (!Error && m_CacheStorage) // Если пользователь успешно добавлен в связь физического хранилища и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->addGroupUser(inGroupUUID, inUserUUID); // Добавляем пользователя в связь в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictGroup(inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupUsersChanged, inGroupUUID, inUserUUID);
     }
 
     return Error;
@@ -534,14 +762,22 @@ errors::error_code HMCombinedDataStorage::removeGroupUser(const QUuid& inGroupUU
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->removeGroupUser(inGroupUUID, inUserUUID); // Пытаемся удалить контакт из связи в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если контакт успешно удалён из связи в физическом хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->removeGroupUser(inGroupUUID, inUserUUID); // Удаляем контакт из связи в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictGroup(inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupUsersChanged, inGroupUUID, inUserUUID);
     }
 
     return Error;
@@ -555,14 +791,22 @@ errors::error_code HMCombinedDataStorage::clearGroupUsers(const QUuid& inGroupUU
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->clearGroupUsers(inGroupUUID); // Пытаемся удалить связь в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если связь удалена в физическом хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->clearGroupUsers(inGroupUUID); // Удаляем связь в кеше
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictGroup(inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctGroupUsersChanged, inGroupUUID);
     }
 
     return Error;
@@ -588,9 +832,11 @@ std::shared_ptr<std::set<QUuid>> HMCombinedDataStorage::getGroupUserList(const Q
 
         if (CacheError) // Если в кеше не удалось найти связь
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->getGroupUserList(inGroupUUID, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если список окнтактов успешно найден в физическом хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если список окнтактов успешно найден в физическом хранилище и доступен кеш
             {
                 CacheError = m_CacheStorage->setGroupUsers(inGroupUUID, Result); // Добавим его в кеш
                 if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -613,6 +859,8 @@ errors::error_code HMCombinedDataStorage::addMessage(const std::shared_ptr<hmcom
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inMessage) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -622,10 +870,16 @@ errors::error_code HMCombinedDataStorage::addMessage(const std::shared_ptr<hmcom
             if (!Error && m_CacheStorage) // Если сообщение успешно добавлено в физическое хранилище и доступен кеш
             {
                 errors::error_code CacheError = m_CacheStorage->addMessage(inMessage); // Добавляем сообщение в кеш
-                if (CacheError) // Ошибки кеша обрабатывам отдельно
+                if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                {
                     LOG_WARNING(CacheError.message_qstr());
+                    m_CacheStorage->evictMessage(inMessage->m_uuid, inMessage->m_group);
+                }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctMessageAdded, inMessage->m_uuid, inMessage->m_group);
     }
 
     return Error;
@@ -639,6 +893,8 @@ errors::error_code HMCombinedDataStorage::updateMessage(const std::shared_ptr<hm
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         if (!inMessage) // Работаем только с валидным указателем
             Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
         else
@@ -648,10 +904,16 @@ errors::error_code HMCombinedDataStorage::updateMessage(const std::shared_ptr<hm
             if (!Error && m_CacheStorage) // Если сообщение успешно обновлено в физическом хранилище и доступен кеш
             {
                 errors::error_code CacheError = m_CacheStorage->updateMessage(inMessage); // Обновляем данные о сообщение в кеше
-                if (CacheError) // Ошибки кеша обрабатывам отдельно
+                if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+                {
                     LOG_WARNING(CacheError.message_qstr());
+                    m_CacheStorage->evictMessage(inMessage->m_uuid, inMessage->m_group);
+                }
             }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctMessageUpdated, inMessage->m_uuid, inMessage->m_group);
     }
 
     return Error;
@@ -677,9 +939,11 @@ std::shared_ptr<hmcommon::HMGroupInfoMessage> HMCombinedDataStorage::findMessage
 
         if (CacheError) // Если в кеше не удалось найти сообщение
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->findMessage(inMessageUUID, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если сообщение успешно найдено в физическом хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если сообщение успешно найдено в физическом хранилище и доступен кеш
             {   // Добавим его в кеш
                 CacheError = m_CacheStorage->addMessage(Result);
                 if (CacheError) // Ошибки кеша обрабатывам отдельно
@@ -714,9 +978,11 @@ std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMCombinedDataStorage
 
         if (CacheError) // Если в кеше не удалось найти сообщения
         {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
             Result = m_HardStorage->findMessages(inGroupUUID, inRange, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
 
-            if (!outErrorCode && m_CacheStorage) // Если сообщения успешно найдены в физическом хранилище и доступен кеш
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если сообщения успешно найдены в физическом хранилище и доступен кеш
             {   // Добавим их в кеш
                 for (const auto& Message : Result)
                 {
@@ -734,6 +1000,48 @@ std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMCombinedDataStorage
     return Result;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMCombinedDataStorage::findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const
+{
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Result;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        errors::error_code CacheError = make_error_code(errors::eDataStorageError::dsMessageNotExists); // Отдельный результат для поиска в кеше
+
+        if (m_CacheStorage) // Если доступен кеш
+        {
+            Result = m_CacheStorage->findMessagesPage(inGroupUUID, inCursor, CacheError); // Сначала ищим страницу в кеше
+            if (CacheError && CacheError.value() != static_cast<int32_t>(errors::eDataStorageError::dsMessageNotExists)) // Если ошибка отличается от "объект не найден"
+                 LOG_WARNING(CacheError.message_qstr()); // Пишим её в лог
+        }
+
+        if (CacheError) // Если в кеше не удалось найти страницу
+        {   // Ищим в физическом хранилище
+            const std::uint64_t Generation = m_cacheGeneration.load(); // Поколение изменений до чтения физического хранилища
+            Result = m_HardStorage->findMessagesPage(inGroupUUID, inCursor, outErrorCode);
+            const std::unique_lock<std::recursive_mutex> FillLock = lockCacheFill(Generation); // Кеш заполняется, только если хранилище не менялось после чтения
+
+            if (!outErrorCode && m_CacheStorage && FillLock) // Если сообщения успешно найдены в физическом хранилище и доступен кеш
+            {   // Добавим их в кеш
+                for (const auto& Message : Result)
+                {
+                    CacheError = m_CacheStorage->addMessage(Message);
+                    if (CacheError) // Ошибки кеша обрабатывам отдельно
+                        LOG_WARNING(CacheError.message_qstr());
+                }
+            }
+        }   // Поиск в самом хранилище
+
+        if (outErrorCode) // Если ошибка поиска страницы
+            Result.clear(); // На всякий случай сбросим результат
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMCombinedDataStorage::removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID)
 {
     errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
@@ -742,16 +1050,54 @@ errors::error_code HMCombinedDataStorage::removeMessage(const QUuid& inMessageUU
         Error = make_error_code(errors::eDataStorageError::dsNotOpen);
     else
     {
+        std::lock_guard lg(m_writeDefender); // Шаги физического хранилища и кеша не перемежаются с изменениями других потоков
+
         Error = m_HardStorage->removeMessage(inMessageUUID, inGroupUUID); // Удаляем сообщение в физическом хранилище
 
         if (!Error && m_CacheStorage) // Если сообщение успешно удалено в физическом хранилище и доступен кеш
         {
             errors::error_code CacheError = m_CacheStorage->removeMessage(inMessageUUID, inGroupUUID); // Удаляем сообщение из кеша
-            if (CacheError) // Ошибки кеша обрабатывам отдельно
+            if (CacheError) // Кеш не повторил изменение, вытесняем запись, чтобы не отдавать устаревшие данные
+            {
                 LOG_WARNING(CacheError.message_qstr());
+                m_CacheStorage->evictMessage(inMessageUUID, inGroupUUID);
+            }
         }
+
+        if (!Error) // Оповещаем подписчиков под блокировкой записи, чтобы порядок событий совпадал с порядком изменений
+            notifyChange(eChangeType::ctMessageRemoved, inMessageUUID, inGroupUUID);
     }
 
     return Error;
 }
 //-----------------------------------------------------------------------------
+std::shared_ptr<HMChangeSubscription> HMCombinedDataStorage::subscribe(const std::size_t inCapacity, ChangeNotifyFn inNotify)
+{
+    return m_changeFeed.subscribe(inCapacity, inNotify);
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMCombinedDataStorage::changeSequence() const
+{
+    return m_changeFeed.sequence();
+}
+//-----------------------------------------------------------------------------
+void HMCombinedDataStorage::notifyChange(const eChangeType inType, const QUuid& inObject, const QUuid& inRelated)
+{
+    ++m_cacheGeneration; // Прочитанные до изменения данные больше не попадут в кеш
+
+    if (m_transactionOwner == std::this_thread::get_id()) // Изменение транзакции может быть отменено, откладываем оповещение до фиксации
+        m_transactionChanges.push_back({ 0, inType, inObject, inRelated });
+    else
+        m_changeFeed.publish(inType, inObject, inRelated);
+}
+//-----------------------------------------------------------------------------
+std::unique_lock<std::recursive_mutex> HMCombinedDataStorage::lockCacheFill(const std::uint64_t inGeneration) const
+{
+    std::unique_lock<std::recursive_mutex> Result(m_writeDefender, std::try_to_lock); // Читатель не ждёт писателей и транзакции
+
+    if (Result && m_cacheGeneration.load() != inGeneration) // Хранилище изменилось после чтения, данные могли устареть
+        Result.unlock();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
@@ -6,10 +6,15 @@
  * @brief Содержит описание комбинированного хранилища данных (физическое\хешированное)
  */
 
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "datastorage/interface/abstractharddatastorage.h"
 #include "datastorage/interface/abstractcahcedatastorage.h"
+#include "datastorage/changefeed/changefeed.h"
 
 namespace hmservcommon::datastorage
 {
@@ -26,6 +31,13 @@ private:
 
     std::shared_ptr<HMAbstractHardDataStorage> m_HardStorage = nullptr;     ///< Физическое хранилище данных
     std::shared_ptr<HMAbstractCahceDataStorage> m_CacheStorage = nullptr;   ///< Кеширующее хранилище данных
+    HMChangeFeed m_changeFeed;                                              ///< Лента изменений хранилища
+
+    mutable std::recursive_mutex m_writeDefender;                           ///< Мьютекс, упорядочивающий изменения (транзакция удерживает его до завершения)
+    std::atomic<std::uint64_t> m_cacheGeneration {0};                       ///< Поколение изменений (растёт с каждым изменением, фиксацией и откатом)
+    std::atomic<std::thread::id> m_transactionOwner;                        ///< Поток, открывший транзакцию
+    std::size_t m_transactionDepth = 0;                                     ///< Глубина вложенности транзакций
+    std::vector<ChangeEvent> m_transactionChanges;                          ///< Изменения транзакции, о которых оповестим после фиксации
 
 public:
 
@@ -57,9 +69,32 @@ public:
 
     /**
      * @brief close - Метод закроет хранилище данных
+     * Незавершённая транзакция этого потока отбрасывается, транзакция другого потока будет дождана
      */
     virtual void close() override;
 
+    // Транзакции
+
+    /**
+     * @brief beginTransaction - Метод начнёт транзакцию (вложенный вызов только увеличит глубину)
+     * Транзакция открывается в обоих хранилищах, при сбое фиксации кеш сбрасывается.
+     * Транзакция принадлежит открывшему её потоку: завершить её может только он, а изменения других потоков ждут её завершения
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginTransaction() override;
+
+    /**
+     * @brief commitTransaction - Метод завершит транзакцию (завершение внешней транзакции фиксирует изменения)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code commitTransaction() override;
+
+    /**
+     * @brief rollbackTransaction - Метод отменит все изменения транзакции (на любой глубине вложенности)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code rollbackTransaction() override;
+
     // Пользователи
 
     /**
@@ -250,6 +285,15 @@ public:
      */
     virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const override;
 
+    /**
+     * @brief findMessagesPage - Метод вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inCursor - Курсор (позиция, направление и размер страницы)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт не более inCursor.m_limit ближайших к курсору сообщений, упорядоченных по времени создания
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const override;
+
     /**
      * @brief removeMessage - Метод удалит сообщение
      * @param inMessageUUID - Uuid сообщения
@@ -258,6 +302,40 @@ public:
      */
     virtual errors::error_code removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID) override;
 
+    // Лента изменений
+
+    /**
+     * @brief subscribe - Метод оформит подписку на изменения хранилища
+     * @param inCapacity - Ёмкость очереди подписчика (при переполнении события отбрасываются)
+     * @param inNotify - Функция оповещения о новых событиях (вызывается в потоке, изменившем хранилище)
+     * @return Вернёт подписку, действующую пока на неё есть указатели
+     */
+    std::shared_ptr<HMChangeSubscription> subscribe(const std::size_t inCapacity = CHANGE_FEED_DEFAULT_CAPACITY, ChangeNotifyFn inNotify = nullptr);
+
+    /**
+     * @brief changeSequence - Метод вернёт порядковый номер последнего изменения хранилища
+     * @return Вернёт порядковый номер изменения
+     */
+    std::uint64_t changeSequence() const;
+
+private:
+
+    /**
+     * @brief notifyChange - Метод оповестит подписчиков об изменении (вызывается под блокировкой записи; в открытой транзакции - при её фиксации)
+     * @param inType - Тип изменения
+     * @param inObject - UUID изменённого объекта
+     * @param inRelated - UUID связанного объекта
+     */
+    void notifyChange(const eChangeType inType, const QUuid& inObject, const QUuid& inRelated = QUuid());
+
+    /**
+     * @brief lockCacheFill - Метод захватит блокировку записи для заполнения кеша данными, прочитанными из физического хранилища
+     * Не ждёт других писателей: если блокировка занята или хранилище изменилось после чтения, заполнение пропускается
+     * @param inGeneration - Поколение изменений на момент чтения физического хранилища
+     * @return Вернёт блокировку (не захваченную, если заполнять кеш нельзя)
+     */
+    std::unique_lock<std::recursive_mutex> lockCacheFill(const std::uint64_t inGeneration) const;
+
 };
 //-----------------------------------------------------------------------------
 } // namespace hmservcommon::datastorage
@@ -67,6 +67,27 @@ public:
      */
     virtual void close() override;
 
+    // Вытеснение
+
+    /**
+     * @brief evictUser - Метод вытеснит из кеша пользователя и его список контактов (следующий запрос перечитает их из основного хранилища)
+     * @param inUserUUID - Uuid пользователя
+     */
+    virtual void evictUser(const QUuid& inUserUUID) = 0;
+
+    /**
+     * @brief evictGroup - Метод вытеснит из кеша группу и список её участников
+     * @param inGroupUUID - Uuid группы
+     */
+    virtual void evictGroup(const QUuid& inGroupUUID) = 0;
+
+    /**
+     * @brief evictMessage - Метод вытеснит из кеша сообщение
+     * @param inMessageUUID - Uuid сообщения
+     * @param inGroupUUID - Uuid группы
+     */
+    virtual void evictMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID) = 0;
+
     void setCacheLifeTime(const std::chrono::milliseconds inCacheLifeTime);
 
     std::chrono::milliseconds getCacheLifeTime() const;
@@ -62,6 +62,28 @@ public:
      */
     virtual void close() = 0;
 
+    // Транзакции
+
+    /**
+     * @brief beginTransaction - Метод начнёт транзакцию (вложенный вызов только увеличит глубину)
+     * Изменения до commitTransaction попадают на носитель атомарно, одной записью.
+     * Транзакцию завершает открывший её поток
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginTransaction() = 0;
+
+    /**
+     * @brief commitTransaction - Метод завершит транзакцию (завершение внешней транзакции фиксирует изменения)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code commitTransaction() = 0;
+
+    /**
+     * @brief rollbackTransaction - Метод отменит все изменения транзакции (на любой глубине вложенности)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code rollbackTransaction() = 0;
+
     // Пользователи
 
     /**
@@ -252,6 +274,15 @@ public:
      */
     virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const = 0;
 
+    /**
+     * @brief findMessagesPage - Метод вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inCursor - Курсор (позиция, направление и размер страницы)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт не более inCursor.m_limit ближайших к курсору сообщений, упорядоченных по времени создания
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const = 0;
+
     /**
      * @brief removeMessage - Метод удалит сообщение
      * @param inMessageUUID - Uuid сообщения
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <fstream>
+#include <map>
 #include <algorithm>
 
 #include <HawkLog.h>
@@ -95,6 +96,14 @@ void HMJsonDataStorage::close()
 {
     if (is_open()) // Только при "открытом файле"
     {
+        if (m_transactionDepth) // Незавершённая транзакция не фиксируется
+        {
+            LOG_WARNING("Uncommitted transaction rolled back on close");
+            m_json = std::move(m_transactionBackup);
+            m_transactionBackup = nlohmann::json();
+            m_transactionDepth = 0;
+        }
+
         errors::error_code Error = write(); // Вызываем запись
 
         if (Error)
@@ -104,6 +113,62 @@ void HMJsonDataStorage::close()
     }
 }
 //-----------------------------------------------------------------------------
+errors::error_code HMJsonDataStorage::beginTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!m_transactionDepth) // Внешняя транзакция запоминает состояние для отката
+            m_transactionBackup = m_json;
+
+        ++m_transactionDepth;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMJsonDataStorage::commitTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (!m_transactionDepth)
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else if (!--m_transactionDepth) // Завершена внешняя транзакция
+    {
+        Error = write(); // Единственная запись на носитель за всю транзакцию
+
+        if (Error) // Зафиксировать не удалось, возвращаемся к состоянию на носителе
+            m_json = std::move(m_transactionBackup);
+
+        m_transactionBackup = nlohmann::json();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMJsonDataStorage::rollbackTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (!m_transactionDepth)
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {
+        m_json = std::move(m_transactionBackup); // Возвращаем состояние на начало внешней транзакции
+        m_transactionBackup = nlohmann::json();
+        m_transactionDepth = 0;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMJsonDataStorage::addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser)
 {
     errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
@@ -124,12 +189,15 @@ errors::error_code HMJsonDataStorage::addUser(const std::shared_ptr<hmcommon::HM
 
                 if (!Error) // Если объект сформирован корректно
                 {
+                    beginSavepoint(); // Пользователь и его список контактов добавляются атомарно
                     m_json[J_USERS].push_back(NewUser); // Добавляем пользователя в конец
 
                     Error = onCreateUser(inUser->m_uuid);
 
-                    if (Error) // Если при создании списка контактов поисходит ошибка
-                        m_json[J_USERS].erase(m_json[J_USERS].size() - 1); // Удаляем полседнего добавленного пользователя
+                    if (Error) // Откат удалит добавленного пользователя
+                        rollbackSavepoint();
+                    else
+                        releaseSavepoint();
                 }
             }
         }
@@ -246,9 +314,16 @@ errors::error_code HMJsonDataStorage::removeUser(const QUuid& inUserUUID)
 
         if (UserIt != m_json[J_USERS].cend()) // Если пользователь существует
         {
+            beginSavepoint(); // Каскадное удаление связей затрагивает пользователей и группы, при ошибке откатываем только изменённые
+
             Error = onRemoveUser(inUserUUID);
-            if (!Error) // Если список контактов пользователей корректо удалён
+            if (Error) // Не удалось удалить связи пользователя
+                rollbackSavepoint();
+            else
+            {
+                releaseSavepoint();
                 m_json[J_USERS].erase(UserIt); // Удаляем пользователя
+            }
         }
         // Если не найден пользователь на удаление то это не ошибка
     }
@@ -930,6 +1005,67 @@ std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMJsonDataStorage::fi
     return Result;
 }
 //-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMJsonDataStorage::findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const
+{
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Result;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (!inCursor.m_time.isValid() || inCursor.m_limit == 0 || inCursor.m_direction == hmcommon::eMsgPageDirection::pdCount)
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorretData);
+    else
+    {
+        typedef std::pair<QDateTime, std::string> MessagePos; // Позиция сообщения в ленте группы {Время создания, UUID}
+        // Курсор без UUID сообщения стоит перед всеми сообщениями своего времени
+        const MessagePos Anchor(inCursor.m_time, (inCursor.m_message.isNull()) ? std::string() : inCursor.m_message.toString().toStdString());
+        const bool After = (inCursor.m_direction == hmcommon::eMsgPageDirection::pdAfter);
+        const std::string GroupUUID = inGroupUUID.toString().toStdString(); // Единоразово запоминаем UUID
+
+        std::map<MessagePos, const nlohmann::json*> Page; // Не более m_limit ближайших к курсору сообщений
+
+        for (const nlohmann::json& MessageObject : m_json[J_MESSAGES])
+        {
+            errors::error_code ValidError = m_validator.checkMessage(MessageObject); // Проверяем валидность объекта сообщения
+            if (ValidError)
+                LOG_WARNING(ValidError.message_qstr()); // Повреждённное сообщение игнорируется
+            else if (MessageObject[J_MESSAGE_GROUP_UUID].get<std::string>() == GroupUUID) // Сообщение в группе
+            {
+                MessagePos Pos(QDateTime::fromString(QString::fromStdString(MessageObject[J_MESSAGE_REGDATE].get<std::string>()), TIME_FORMAT),
+                               MessageObject[J_MESSAGE_UUID].get<std::string>());
+
+                if ((After) ? (Anchor < Pos) : (Pos < Anchor)) // Сообщение лежит в нужную сторону от курсора
+                {
+                    Page.emplace(std::move(Pos), &MessageObject);
+
+                    if (Page.size() > inCursor.m_limit) // Вытесняем самое дальнее от курсора сообщение
+                        Page.erase((After) ? std::prev(Page.end()) : Page.begin());
+                }
+            }
+        }
+
+        if (Page.empty()) // Сообщения не найдены
+            outErrorCode = make_error_code(errors::eDataStorageError::dsMessageNotExists);
+        else // Сообщения найдены (map уже упорядочен по времени)
+        {
+            Result.reserve(Page.size());
+
+            for (const auto& [Pos, MessageObject] : Page)
+            {   // Все сообщения на странице гарантированно валидны
+                errors::error_code ConvertErr;
+                std::shared_ptr<hmcommon::HMGroupInfoMessage> MSG = jsonToMessage(*MessageObject, ConvertErr); // Преобразуем объект в сообщение
+
+                if (ConvertErr)
+                    LOG_WARNING(ConvertErr.message_qstr());
+                else
+                    Result.push_back(MSG); // Помещаем сообщение в итоговый контейнер
+            }
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMJsonDataStorage::removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID)
 {
     errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
@@ -988,7 +1124,14 @@ nlohmann::json& HMJsonDataStorage::findUser(const QUuid &inUserUUID, errors::err
         if (UserIt == m_json[J_USERS].end()) // Если пользователь не найден
             outErrorCode = make_error_code(errors::eDataStorageError::dsUserNotExists);
         else // Пользователь успешно найден
+        {
+            const std::size_t Index = static_cast<std::size_t>(UserIt - m_json[J_USERS].begin());
+
+            if (m_savepoint && Index < m_savepoint->m_usersCount) // Объект может измениться, запоминаем его исходную копию для отката
+                m_savepoint->m_users.try_emplace(Index, UserIt.value());
+
             return UserIt.value(); // ЕДИНСТВЕННЫЙ УСПЕШНЫЙ СЛУЧАЙ
+        }
     }
 
     return INVALID_NODE; // ВО ВСЕХ ПРОВАЛЬНЫХ СЛУЧАЯХ ВЕРНЁМ НЕ ВАЛИДНЫЙ ОБЪЕКТ
@@ -1050,7 +1193,14 @@ nlohmann::json& HMJsonDataStorage::findGroup(const QUuid &inGroupUUID, errors::e
         if (GroupIt == m_json[J_GROUPS].end()) // Если группа не найдена
             outErrorCode = make_error_code(errors::eDataStorageError::dsGroupNotExists);
         else // Группа найдена
+        {
+            const std::size_t Index = static_cast<std::size_t>(GroupIt - m_json[J_GROUPS].begin());
+
+            if (m_savepoint && Index < m_savepoint->m_groupsCount) // Объект может измениться, запоминаем его исходную копию для отката
+                m_savepoint->m_groups.try_emplace(Index, GroupIt.value());
+
             return GroupIt.value();
+        }
     }
 
     return INVALID_NODE; // ВО ВСЕХ ПРОВАЛЬНЫХ СЛУЧАЯХ ВЕРНЁМ НЕ ВАЛИДНЫЙ ОБЪЕКТ
@@ -1087,6 +1237,41 @@ const nlohmann::json& HMJsonDataStorage::findConstGroup(const QUuid &inGroupUUID
     return INVALID_NODE; // ВО ВСЕХ ПРОВАЛЬНЫХ СЛУЧАЯХ ВЕРНЁМ НЕ ВАЛИДНЫЙ ОБЪЕКТ
 }
 //-----------------------------------------------------------------------------
+void HMJsonDataStorage::beginSavepoint()
+{
+    m_savepoint.emplace();
+    m_savepoint->m_usersCount = m_json[J_USERS].size();
+    m_savepoint->m_groupsCount = m_json[J_GROUPS].size();
+}
+//-----------------------------------------------------------------------------
+void HMJsonDataStorage::releaseSavepoint()
+{
+    m_savepoint.reset();
+}
+//-----------------------------------------------------------------------------
+void HMJsonDataStorage::rollbackSavepoint()
+{
+    if (m_savepoint) // Точка сохранения создана
+    {
+        nlohmann::json& Users = m_json[J_USERS];
+        nlohmann::json& Groups = m_json[J_GROUPS];
+
+        for (auto& [Index, User] : m_savepoint->m_users) // Возвращаем исходные копии изменённых пользователей
+            Users[Index] = std::move(User);
+
+        for (auto& [Index, Group] : m_savepoint->m_groups) // Возвращаем исходные копии изменённых групп
+            Groups[Index] = std::move(Group);
+
+        if (Users.size() > m_savepoint->m_usersCount) // Удаляем добавленных после точки пользователей
+            Users.erase(Users.begin() + static_cast<std::ptrdiff_t>(m_savepoint->m_usersCount), Users.end());
+
+        if (Groups.size() > m_savepoint->m_groupsCount) // Удаляем добавленные после точки группы
+            Groups.erase(Groups.begin() + static_cast<std::ptrdiff_t>(m_savepoint->m_groupsCount), Groups.end());
+
+        m_savepoint.reset();
+    }
+}
+//-----------------------------------------------------------------------------
 errors::error_code HMJsonDataStorage::onCreateUser(const QUuid &inUserUUID)
 {
     /*
@@ -1350,16 +1535,27 @@ errors::error_code HMJsonDataStorage::write() const
     }
     else // Объект файл
     {
-        std::ofstream outFile(m_jsonPath, std::ios_base::out);
+        std::filesystem::path TempPath = m_jsonPath; // Пишем во временный файл, чтобы сбой не повредил прежнее состояние
+        TempPath += ".tmp";
+
+        std::ofstream outFile(TempPath, std::ios_base::out);
         outFile << m_json; // Пишем JSON в файл
+        outFile.flush();
 
         if (outFile.bad())
             Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail); // Помечаем как ошибку
         else
             Error = make_error_code(errors::eDataStorageError::dsSuccess); // Помечаем как успешную запись
 
-        outFile.flush();
         outFile.close();
+
+        if (!Error)
+            std::filesystem::rename(TempPath, m_jsonPath, Error); // Атомарно подменяем файл хранилища
+        else
+        {
+            std::error_code RemoveError; // Ошибка удаления не должна скрыть ошибку записи
+            std::filesystem::remove(TempPath, RemoveError);
+        }
     }
 
     return Error;
@@ -6,6 +6,8 @@
  * @brief Содержит описание класса хранилища данных в файле JSON
  */
 
+#include <map>
+#include <optional>
 #include <filesystem>
 
 #include <nlohmann/json.hpp>
@@ -26,12 +28,28 @@ class HMJsonDataStorage : public HMAbstractHardDataStorage
 {
 private:
 
+    /**
+     * @brief The Savepoint struct - Структура, описывающая точку сохранения внутри многошаговой операции
+     * Хранит только копии изменённых объектов, поэтому откат не копирует хранилище целиком и не пишет файл
+     */
+    struct Savepoint
+    {
+        std::size_t m_usersCount = 0;                           ///< Количество пользователей на момент создания точки
+        std::size_t m_groupsCount = 0;                          ///< Количество групп на момент создания точки
+        std::map<std::size_t, nlohmann::json> m_users;          ///< Исходные копии изменённых пользователей (ключ - индекс)
+        std::map<std::size_t, nlohmann::json> m_groups;         ///< Исходные копии изменённых групп (ключ - индекс)
+    };
+
     const std::filesystem::path m_jsonPath;                     ///< Путь к json файлу
     nlohmann::json m_json;                                      ///< json файл
     nlohmann::json m_invalidObject = nlohmann::json::object();  ///< Не валидный json объект
 
     HMJsonDataStorageValidator m_validator;                     ///< Валидатор формата данных
 
+    nlohmann::json m_transactionBackup;                         ///< Состояние хранилища на момент начала внешней транзакции
+    std::size_t m_transactionDepth = 0;                         ///< Глубина вложенности транзакций
+    std::optional<Savepoint> m_savepoint;                       ///< Активная точка сохранения многошаговой операции
+
 public:
 
     /**
@@ -65,6 +83,27 @@ public:
      */
     virtual void close() override;
 
+    // Транзакции
+
+    /**
+     * @brief beginTransaction - Метод начнёт транзакцию (вложенный вызов только увеличит глубину)
+     * Внешняя транзакция запоминает состояние в памяти, файл записывается один раз при её фиксации
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginTransaction() override;
+
+    /**
+     * @brief commitTransaction - Метод завершит транзакцию (завершение внешней транзакции фиксирует изменения)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code commitTransaction() override;
+
+    /**
+     * @brief rollbackTransaction - Метод отменит все изменения транзакции (на любой глубине вложенности)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code rollbackTransaction() override;
+
     // Пользователи
 
     /**
@@ -255,6 +294,15 @@ public:
      */
     virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const override;
 
+    /**
+     * @brief findMessagesPage - Метод вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inCursor - Курсор (позиция, направление и размер страницы)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт не более inCursor.m_limit ближайших к курсору сообщений, упорядоченных по времени создания
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const override;
+
     /**
      * @brief removeMessage - Метод удалит сообщение
      * @param inMessageUUID - Uuid сообщения
@@ -305,6 +353,22 @@ private:
      */
     const nlohmann::json& findConstGroup(const QUuid &inGroupUUID, errors::error_code& outErrorCode) const;
 
+    /**
+     * @brief beginSavepoint - Метод создаст точку сохранения многошаговой операции (вложенные точки не поддерживаются)
+     * После создания точки допускаются изменение существующих пользователей и групп через findUser/findGroup и добавление новых в конец
+     */
+    void beginSavepoint();
+
+    /**
+     * @brief releaseSavepoint - Метод освободит точку сохранения, сохранив изменения
+     */
+    void releaseSavepoint();
+
+    /**
+     * @brief rollbackSavepoint - Метод вернёт пользователей и группы к состоянию на момент создания точки сохранения
+     */
+    void rollbackSavepoint();
+
     /**
      * @brief onCreateUser - Метод выполнится при создании пользователя
      * @param inUserUUID - Uuid пользователя
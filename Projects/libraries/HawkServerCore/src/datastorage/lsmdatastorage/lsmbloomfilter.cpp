@@ -0,0 +1,80 @@
+#include "lsmbloomfilter.h"
+
+#include <algorithm>
+
+#include "lsmdatastorageconst.h"
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+HMLsmBloomFilter::HMLsmBloomFilter(const std::size_t inKeysCount) :
+    m_hashCount(LSM_BLOOM_HASH_COUNT),
+    m_bits(std::max<std::size_t>(8, (inKeysCount * LSM_BLOOM_BITS_PER_KEY + 7) / 8), 0) // Не меньше 64 бит
+{
+
+}
+//-----------------------------------------------------------------------------
+HMLsmBloomFilter::HMLsmBloomFilter(const std::uint32_t inHashCount, std::vector<std::uint8_t>&& inBits) :
+    m_hashCount(inHashCount),
+    m_bits(std::move(inBits))
+{
+
+}
+//-----------------------------------------------------------------------------
+void HMLsmBloomFilter::add(const std::string& inKey)
+{
+    if (m_bits.empty())
+        return;
+
+    const std::uint64_t Hash = hash(inKey);
+    const std::uint64_t BitsCount = m_bits.size() * 8;
+    // Двойное хеширование: h(i) = h1 + i * h2
+    const std::uint32_t H1 = static_cast<std::uint32_t>(Hash);
+    const std::uint32_t H2 = static_cast<std::uint32_t>(Hash >> 32) | 1; // Шаг должен быть нечётным
+
+    for (std::uint32_t Index = 0; Index < m_hashCount; ++Index)
+    {
+        const std::uint64_t Bit = (static_cast<std::uint64_t>(H1) + static_cast<std::uint64_t>(Index) * H2) % BitsCount;
+        m_bits[Bit / 8] |= static_cast<std::uint8_t>(1 << (Bit % 8));
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMLsmBloomFilter::mayContain(const std::string& inKey) const
+{
+    if (m_bits.empty()) // Пустой фильтр ничего не отсеивает
+        return true;
+
+    const std::uint64_t Hash = hash(inKey);
+    const std::uint64_t BitsCount = m_bits.size() * 8;
+    const std::uint32_t H1 = static_cast<std::uint32_t>(Hash);
+    const std::uint32_t H2 = static_cast<std::uint32_t>(Hash >> 32) | 1;
+
+    for (std::uint32_t Index = 0; Index < m_hashCount; ++Index)
+    {
+        const std::uint64_t Bit = (static_cast<std::uint64_t>(H1) + static_cast<std::uint64_t>(Index) * H2) % BitsCount;
+        if (!(m_bits[Bit / 8] & (1 << (Bit % 8)))) // Хотя бы один бит не взведён
+            return false; // Ключа гарантированно нет
+    }
+
+    return true;
+}
+//-----------------------------------------------------------------------------
+std::uint32_t HMLsmBloomFilter::hashCount() const
+{ return m_hashCount; }
+//-----------------------------------------------------------------------------
+const std::vector<std::uint8_t>& HMLsmBloomFilter::bits() const
+{ return m_bits; }
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmBloomFilter::hash(const std::string& inKey)
+{
+    std::uint64_t Result = 14695981039346656037ULL; // FNV offset basis
+
+    for (const char& Char : inKey)
+    {
+        Result ^= static_cast<std::uint8_t>(Char);
+        Result *= 1099511628211ULL; // FNV prime
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
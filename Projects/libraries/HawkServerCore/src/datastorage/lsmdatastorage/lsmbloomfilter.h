@@ -0,0 +1,86 @@
+#ifndef HMLSMBLOOMFILTER_H
+#define HMLSMBLOOMFILTER_H
+
+/**
+ * @file lsmbloomfilter.h
+ * @brief Содержит описание фильтра Блума сегментов LSM хранилища
+ */
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmBloomFilter class - Класс, описывающий фильтр Блума сегмента
+ * Позволяет без чтения сегмента с диска отсеять ключи, которых в сегменте гарантированно нет
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmBloomFilter
+{
+public:
+
+    /**
+     * @brief HMLsmBloomFilter - Конструктор по умолчанию (пустой фильтр пропускает любой ключ)
+     */
+    HMLsmBloomFilter() = default;
+
+    /**
+     * @brief HMLsmBloomFilter - Инициализирующий конструктор
+     * @param inKeysCount - Ожидаемое количество ключей
+     */
+    explicit HMLsmBloomFilter(const std::size_t inKeysCount);
+
+    /**
+     * @brief HMLsmBloomFilter - Инициализирующий конструктор (восстановление из сегмента)
+     * @param inHashCount - Количество хеш функций
+     * @param inBits - Битовое поле фильтра
+     */
+    HMLsmBloomFilter(const std::uint32_t inHashCount, std::vector<std::uint8_t>&& inBits);
+
+    /**
+     * @brief add - Метод добавит ключ в фильтр
+     * @param inKey - Добавляемый ключ
+     */
+    void add(const std::string& inKey);
+
+    /**
+     * @brief mayContain - Метод проверит, может ли ключ находиться в сегменте
+     * @param inKey - Проверяемый ключ
+     * @return Вернёт false, если ключа гарантированно нет
+     */
+    bool mayContain(const std::string& inKey) const;
+
+    /**
+     * @brief hashCount - Метод вернёт количество хеш функций
+     * @return Вернёт количество хеш функций
+     */
+    std::uint32_t hashCount() const;
+
+    /**
+     * @brief bits - Метод вернёт битовое поле фильтра
+     * @return Вернёт битовое поле фильтра
+     */
+    const std::vector<std::uint8_t>& bits() const;
+
+    /**
+     * @brief hash - Функция стабильного (не зависящего от реализации STL) хеширования ключа
+     * @param inKey - Хешируемый ключ
+     * @return Вернёт 64 битный хеш FNV-1a
+     */
+    static std::uint64_t hash(const std::string& inKey);
+
+private:
+
+    std::uint32_t m_hashCount = 0;      ///< Количество хеш функций
+    std::vector<std::uint8_t> m_bits;   ///< Битовое поле фильтра
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMLSMBLOOMFILTER_H
@@ -0,0 +1,1631 @@
+#include "lsmdatastorage.h"
+
+#include <deque>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#include <HawkLog.h>
+#include <systemerrorex.h>
+#include <datastorageerrorcategory.h>
+
+#include "datastorage/jsondatastorage/jsondatastorageconst.h"
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief uuidToKey - Функция сформирует ключ хранилища для UUID'а
+ * @param inPrefix - Префикс ключа
+ * @param inUUID - UUID объекта
+ * @return Вернёт ключ хранилища
+ */
+static std::string uuidToKey(const std::string& inPrefix, const QUuid& inUUID)
+{
+    return inPrefix + inUUID.toString().toStdString();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief timelinePrefix - Функция сформирует префикс ленты сообщений группы
+ * @param inGroupUUID - UUID группы
+ * @return Вернёт префикс ключей ленты
+ */
+static std::string timelinePrefix(const QUuid& inGroupUUID)
+{
+    return uuidToKey(LSM_KEY_TIMELINE, inGroupUUID) + ":";
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief timeToKey - Функция преобразует время в строку, лексикографический порядок которой совпадает с хронологическим
+ * @param inTime - Время
+ * @return Вернёт строку из 16 шестнадцатеричных символов
+ */
+static std::string timeToKey(const QDateTime& inTime)
+{   // Смещаем знаковое значение, чтобы отрицательные времена оказались перед положительными
+    const std::uint64_t Value = static_cast<std::uint64_t>(inTime.toMSecsSinceEpoch()) ^ (std::uint64_t(1) << 63);
+
+    std::ostringstream Stream;
+    Stream << std::hex << std::uppercase << std::setw(16) << std::setfill('0') << Value;
+    return Stream.str();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief timelineKey - Функция сформирует ключ сообщения в ленте группы
+ * @param inMessage - Сообщение
+ * @return Вернёт ключ сообщения в ленте группы
+ */
+static std::string timelineKey(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage)
+{
+    return timelinePrefix(inMessage->m_group) + timeToKey(inMessage->m_createTime) + ":" + inMessage->m_uuid.toString().toStdString();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief encode - Функция преобразует объект в двоичное представление (CBOR)
+ * @param inObject - Объект
+ * @return Вернёт двоичное представление объекта
+ */
+static std::string encode(const nlohmann::json& inObject)
+{
+    const std::vector<std::uint8_t> Bytes = nlohmann::json::to_cbor(inObject);
+    return std::string(Bytes.cbegin(), Bytes.cend());
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief findUUID - Функция найдёт UUID в массиве json
+ * @param inArray - Массив UUID'ов
+ * @param inUUID - Искомый UUID
+ * @return Вернёт итератор на найденный элемент или end()
+ */
+static nlohmann::json::iterator findUUID(nlohmann::json& inArray, const std::string& inUUID)
+{
+    return std::find_if(inArray.begin(), inArray.end(), [&inUUID](const nlohmann::json& Val)
+    { return Val.get<std::string>() == inUUID; });
+}
+//-----------------------------------------------------------------------------
+HMLsmDataStorage::HMLsmDataStorage(const std::filesystem::path& inDirPath, const std::size_t inMemTableLimit, const std::size_t inCompactionTrigger) :
+    HMAbstractHardDataStorage(), // Инициализируем предка
+    m_engine(inDirPath, inMemTableLimit, inCompactionTrigger)
+{
+
+}
+//-----------------------------------------------------------------------------
+HMLsmDataStorage::~HMLsmDataStorage()
+{
+    close();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::open()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    close();
+
+    Error = m_engine.open(); // Загружаем сегменты и восстанавливаем журнал
+
+    if (!Error)
+    {
+        if (m_engine.empty()) // Новое хранилище
+            Error = makeDefault();
+        else // Существующее хранилище, проверяем версию формата
+        {
+            std::string Version;
+
+            if (!m_engine.get(LSM_KEY_VERSION, Version, Error) && !Error) // Версия не записана
+                Error = make_error_code(errors::eSystemErrorEx::seIncorrecVersion);
+            else if (!Error && Version != LSM_FORMAT_VESION) // Версия не совпала
+                Error = make_error_code(errors::eSystemErrorEx::seIncorrecVersion);
+        }
+
+        if (Error)
+            m_engine.close();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmDataStorage::is_open() const
+{
+    return m_engine.is_open();
+}
+//-----------------------------------------------------------------------------
+void HMLsmDataStorage::close()
+{
+    {
+        std::lock_guard lg(m_writeDefender); // Транзакция другого потока будет дождана
+
+        if (m_transactionDepth) // Незавершённая транзакция этого потока не фиксируется
+        {
+            LOG_WARNING("Uncommitted transaction rolled back on close");
+            m_transactionWrites.clear();
+            m_transactionOwner = std::thread::id();
+
+            for (; m_transactionDepth; --m_transactionDepth) // Освобождаем блокировку всех уровней вложенности
+                m_writeDefender.unlock();
+        }
+    }
+
+    m_engine.close(); // Все данные будут сброшены в сегменты
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::beginTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        m_writeDefender.lock(); // Блокировка удерживается до завершения транзакции, изменения других потоков её дождутся
+        m_transactionOwner = std::this_thread::get_id();
+        ++m_transactionDepth;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::commitTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (m_transactionOwner != std::this_thread::get_id()) // Завершить транзакцию может только открывший её поток
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {   // Поток владеет блокировкой записи, изменения транзакции принадлежат ему
+        if (!--m_transactionDepth) // Завершена внешняя транзакция
+        {
+            if (!m_transactionWrites.empty())
+            {
+                HMLsmWriteBatch Batch;
+
+                for (const auto& [Key, Value] : m_transactionWrites)
+                {
+                    if (Value)
+                        Batch.put(Key, *Value);
+                    else
+                        Batch.remove(Key);
+                }
+
+                Error = m_engine.write(Batch); // Вся транзакция попадёт в журнал одной записью
+                m_transactionWrites.clear(); // При ошибке изменения транзакции теряются, как при откате
+            }
+
+            m_transactionOwner = std::thread::id();
+        }
+
+        m_writeDefender.unlock();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::rollbackTransaction()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (m_transactionOwner != std::this_thread::get_id()) // Отменить транзакцию может только открывший её поток
+        Error = make_error_code(errors::eDataStorageError::dsTransactionNotStarted);
+    else
+    {
+        m_transactionWrites.clear(); // Изменения транзакции ещё не попали в хранилище, достаточно их забыть
+        m_transactionOwner = std::thread::id();
+
+        for (; m_transactionDepth; --m_transactionDepth) // Освобождаем блокировку всех уровней вложенности
+            m_writeDefender.unlock();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::compact()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+        Error = m_engine.compact();
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inUser) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            Error = checkNewUserUnique(inUser); // Проверяем пользователья на уникальность
+
+            if (!Error) // Если проверка на уникальность прошла успешно
+            {
+                nlohmann::json NewUser = userToJson(inUser, Error); // Формируем объект пользователя
+
+                if (!Error) // Если объект сформирован корректно
+                {
+                    HMLsmWriteBatch Batch;
+                    Batch.put(LSM_KEY_LOGIN + inUser->getLogin().toStdString(), inUser->m_uuid.toString().toStdString()); // Индекс логина
+
+                    Error = commit({ { uuidToKey(LSM_KEY_USER, inUser->m_uuid), NewUser } }, Batch);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::updateUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inUser) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            ObjectCache Cache;
+            HMLsmWriteBatch Batch;
+            nlohmann::json* User = cachedUser(inUser->m_uuid, Cache, Error); // Запрашиваем пользователя из хранилища
+
+            if (!Error) // Если пользователь успешно найден
+            {
+                nlohmann::json UpdateUser = userToJson(inUser, Error); // Формируем объект пользователя
+
+                if (!Error) // Если объект сформирован корректно
+                {   // Связи пользователя обновлением не затрагиваются
+                    UpdateUser[J_USER_CONTACTS] = (*User)[J_USER_CONTACTS];
+                    UpdateUser[J_USER_GROUPS] = (*User)[J_USER_GROUPS];
+
+                    const std::string OldLogin = (*User)[J_USER_LOGIN].get<std::string>();
+                    const std::string NewLogin = UpdateUser[J_USER_LOGIN].get<std::string>();
+
+                    if (OldLogin != NewLogin) // Логин изменился, переносим индекс
+                    {
+                        std::string LoginOwner;
+
+                        if (get(LSM_KEY_LOGIN + NewLogin, LoginOwner, Error) && LoginOwner != inUser->m_uuid.toString().toStdString())
+                            Error = make_error_code(errors::eDataStorageError::dsUserLoginAlreadyRegistered);
+                        else if (!Error)
+                        {
+                            Batch.remove(LSM_KEY_LOGIN + OldLogin);
+                            Batch.put(LSM_KEY_LOGIN + NewLogin, inUser->m_uuid.toString().toStdString());
+                        }
+                    }
+
+                    if (!Error)
+                    {
+                        *User = UpdateUser; // Обновляем данные пользователя
+                        Error = commit(Cache, Batch);
+                    }
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMUserInfo> HMLsmDataStorage::findUserByUUID(const QUuid &inUserUUID, errors::error_code &outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMUserInfo> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        const nlohmann::json User = findUser(inUserUUID, outErrorCode); // Запрашиваем пользователя из хранилища
+        if (!outErrorCode) // Если пользователь успешно найден
+            Result = jsonToUser(User, outErrorCode); // Преобразуем JSON объект в пользователя
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMUserInfo> HMLsmDataStorage::findUserByAuthentication(const QString &inLogin, const QByteArray &inPasswordHash, errors::error_code &outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMUserInfo> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::string UserUUID;
+
+        if (!get(LSM_KEY_LOGIN + inLogin.toStdString(), UserUUID, outErrorCode)) // Ищим пользователя по индексу логина
+        {
+            if (!outErrorCode) // Логин не зарегистрирован
+                outErrorCode = make_error_code(errors::eDataStorageError::dsUserNotExists);
+        }
+        else
+        {
+            const nlohmann::json User = findUser(QUuid::fromString(QString::fromStdString(UserUUID)), outErrorCode);
+
+            if (!outErrorCode) // Пользователь найден
+            {
+                if (m_validator.jsonToByteArr(User[J_USER_PASS]) != inPasswordHash) // Срваниваем PasswordHash с заданным
+                    outErrorCode = make_error_code(errors::eDataStorageError::dsUserPasswordIncorrect); // Хеш пароля не совпал
+                else // Хеш пароля совпал
+                {
+                    Result = jsonToUser(User, outErrorCode); // Преобразуем JSON объект в пользователя
+                    if (outErrorCode)
+                        Result = nullptr;
+                }
+            }
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::removeUser(const QUuid& inUserUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        nlohmann::json* User = cachedUser(inUserUUID, Cache, Error); // Ищим пользователя
+
+        if (Error.value() == static_cast<int>(errors::eDataStorageError::dsUserNotExists))
+            Error = make_error_code(errors::eDataStorageError::dsSuccess); // Если не найден пользователь на удаление то это не ошибка
+        else if (!Error) // Пользователь существует
+        {
+            const std::string Login = (*User)[J_USER_LOGIN].get<std::string>();
+            const nlohmann::json Contacts = (*User)[J_USER_CONTACTS];
+            const nlohmann::json Groups = (*User)[J_USER_GROUPS];
+
+            for (const auto& ContactUUID : Contacts) // Удаляем пользователя из контактов его контактов
+            {
+                errors::error_code UnlinkError = unlinkContacts(inUserUUID, QUuid::fromString(QString::fromStdString(ContactUUID.get<std::string>())), Cache);
+                if (UnlinkError) // Ошибки удаления связей обрабатываем отдельно
+                    LOG_WARNING(UnlinkError.message_qstr());
+            }
+
+            for (const auto& GroupUUID : Groups) // Удаляем пользователя из всех групп, в которых он соcтоит
+            {
+                errors::error_code UnlinkError = unlinkGroupUser(QUuid::fromString(QString::fromStdString(GroupUUID.get<std::string>())), inUserUUID, Cache);
+                if (UnlinkError) // Ошибки удаления связей обрабатываем отдельно
+                    LOG_WARNING(UnlinkError.message_qstr());
+            }
+
+            const std::string UserKey = uuidToKey(LSM_KEY_USER, inUserUUID);
+            Cache.erase(UserKey); // Сам пользователь не перезаписывается, а удаляется
+
+            HMLsmWriteBatch Batch;
+            Batch.remove(UserKey);
+            Batch.remove(LSM_KEY_LOGIN + Login);
+
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::setUserContacts(const QUuid& inUserUUID, const std::shared_ptr<std::set<QUuid>> inContacts)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inContacts) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            ObjectCache Cache;
+            Error = unlinkAllContacts(inUserUUID, Cache); // Очищаем текущие контакты
+
+            for (auto It = inContacts->cbegin(); !Error && It != inContacts->cend(); ++It)
+                Error = linkContacts(inUserUUID, *It, Cache); // Добавляем контакт пользователю
+
+            if (!Error) // Изменения попадут в хранилище только целиком
+            {
+                HMLsmWriteBatch Batch;
+                Error = commit(Cache, Batch);
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::addUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = linkContacts(inUserUUID, inContactUUID, Cache); // Связываем пользователя с контактом
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::removeUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = unlinkContacts(inUserUUID, inContactUUID, Cache); // Разрываем связь пользователя с контактом
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::clearUserContacts(const QUuid& inUserUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = unlinkAllContacts(inUserUUID, Cache);
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<std::set<QUuid>> HMLsmDataStorage::getUserContactList(const QUuid& inUserUUID, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<std::set<QUuid>> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        const nlohmann::json User = findUser(inUserUUID, outErrorCode); // Ищим пользователя
+
+        if (!outErrorCode) // Пользователь успешно найден
+        {
+            Result = std::make_shared<std::set<QUuid>>();
+
+            for (const auto& ContactUUID : User[J_USER_CONTACTS]) // Перебираем спимок контактов
+                Result->insert(QUuid::fromString(QString::fromStdString(ContactUUID.get<std::string>())));
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<std::set<QUuid>> HMLsmDataStorage::getUserGroups(const QUuid& inUserUUID, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<std::set<QUuid>> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        const nlohmann::json User = findUser(inUserUUID, outErrorCode); // Ищим пользователя
+
+        if (!outErrorCode) // Если пользователь успешно найден
+        {
+            Result = std::make_shared<std::set<QUuid>>(); // Инициализируем результат
+            for (const auto& GroupUUID : User[J_USER_GROUPS]) // Перебираем все группы пользователя
+                Result->insert(QUuid::fromString(QString::fromStdString(GroupUUID.get<std::string>())));
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::addGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inGroup) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            Error = checkNewGroupUnique(inGroup); // Проверяем группу на уникальность
+
+            if (!Error) // Если проверка на уникальность прошла успешно
+            {
+                nlohmann::json NewGroup = groupToJson(inGroup, Error); // Формируем объект группы
+
+                if (!Error) // Если объект сформирован корректно
+                {
+                    HMLsmWriteBatch Batch;
+                    Error = commit({ { uuidToKey(LSM_KEY_GROUP, inGroup->m_uuid), NewGroup } }, Batch);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::updateGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inGroup) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            ObjectCache Cache;
+            nlohmann::json* Group = cachedGroup(inGroup->m_uuid, Cache, Error);
+
+            if (!Error)
+            {
+                nlohmann::json UpdateGroup = groupToJson(inGroup, Error); // Формируем объект группы
+
+                if (!Error) // Если объект сформирован корректно
+                {
+                    UpdateGroup[J_GROUP_USERS] = (*Group)[J_GROUP_USERS]; // Участники группы обновлением не затрагиваются
+                    *Group = UpdateGroup;
+
+                    HMLsmWriteBatch Batch;
+                    Error = commit(Cache, Batch);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMGroupInfo> HMLsmDataStorage::findGroupByUUID(const QUuid &inGroupUUID, errors::error_code &outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMGroupInfo> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        const nlohmann::json Group = findGroup(inGroupUUID, outErrorCode); // Запрашиваем группу из хранилища
+        if (!outErrorCode) // Если группа успешно найдена
+            Result = jsonToGroup(Group, outErrorCode); // Преобразуем JSON объект в группу
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::removeGroup(const QUuid& inGroupUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        nlohmann::json* Group = cachedGroup(inGroupUUID, Cache, Error); // Ищим группу
+
+        if (Error.value() == static_cast<int>(errors::eDataStorageError::dsGroupNotExists))
+            Error = make_error_code(errors::eDataStorageError::dsSuccess); // Если не найдена группа на удаление то это не ошибка
+        else if (!Error) // Группа существует
+        {
+            const nlohmann::json Users = (*Group)[J_GROUP_USERS];
+
+            for (const auto& UserUUID : Users) // Удаляем группу из списков групп её участников
+            {
+                errors::error_code UnlinkError = unlinkGroupUser(inGroupUUID, QUuid::fromString(QString::fromStdString(UserUUID.get<std::string>())), Cache);
+                if (UnlinkError) // Ошибки удаления связей обрабатываем отдельно
+                    LOG_WARNING(UnlinkError.message_qstr());
+            }
+
+            const std::string GroupKey = uuidToKey(LSM_KEY_GROUP, inGroupUUID);
+            Cache.erase(GroupKey); // Сама группа не перезаписывается, а удаляется
+
+            HMLsmWriteBatch Batch;
+            Batch.remove(GroupKey);
+
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::setGroupUsers(const QUuid& inGroupUUID, const std::shared_ptr<std::set<QUuid>> inUsers)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inUsers) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            ObjectCache Cache;
+            Error = unlinkAllGroupUsers(inGroupUUID, Cache); // Очищаем текущий состав группы
+
+            for (auto It = inUsers->cbegin(); !Error && It != inUsers->cend(); ++It)
+                Error = linkGroupUser(inGroupUUID, *It, Cache); // Добавляем пользователя в группу
+
+            if (!Error) // Изменения попадут в хранилище только целиком
+            {
+                HMLsmWriteBatch Batch;
+                Error = commit(Cache, Batch);
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::addGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = linkGroupUser(inGroupUUID, inUserUUID, Cache);
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::removeGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = unlinkGroupUser(inGroupUUID, inUserUUID, Cache);
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::clearGroupUsers(const QUuid& inGroupUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        ObjectCache Cache;
+        Error = unlinkAllGroupUsers(inGroupUUID, Cache);
+
+        if (!Error)
+        {
+            HMLsmWriteBatch Batch;
+            Error = commit(Cache, Batch);
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<std::set<QUuid>> HMLsmDataStorage::getGroupUserList(const QUuid& inGroupUUID, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<std::set<QUuid>> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        const nlohmann::json Group = findGroup(inGroupUUID, outErrorCode); // Ищим группу
+
+        if (!outErrorCode) // Если группа успешно найдена
+        {
+            Result = std::make_shared<std::set<QUuid>>(); // Инициализируем результат
+            for (const auto& UserUUID : Group[J_GROUP_USERS]) // Перебираем всех участников группы
+                Result->insert(QUuid::fromString(QString::fromStdString(UserUUID.get<std::string>())));
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::addMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inMessage) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            const std::string MessageKey = uuidToKey(LSM_KEY_MESSAGE, inMessage->m_uuid);
+            std::string TimelineKey;
+
+            if (get(MessageKey, TimelineKey, Error)) // Если сообщение с таким UUID уже существует
+                Error = make_error_code(errors::eDataStorageError::dsMessageAlreadyExists);
+            else if (!Error) // Нет такого сообщения
+            {
+                const nlohmann::json Group = findGroup(inMessage->m_group, Error); // Добавляем только для существующей группы
+
+                if (!Error)
+                {
+                    nlohmann::json NewMessage = messageToJson(inMessage, Error); // Формируем объект сообщения
+
+                    if (!Error) // Если объект сформирован корректно
+                    {
+                        HMLsmWriteBatch Batch;
+                        TimelineKey = timelineKey(inMessage);
+
+                        Batch.put(MessageKey, TimelineKey);             // Индекс UUID сообщения
+                        Batch.put(TimelineKey, encode(NewMessage));     // Сообщение в ленте группы
+
+                        Error = apply(Batch);
+                    }
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::updateMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (!inMessage) // Работаем только с валидным указателем
+            Error = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+        else
+        {
+            std::lock_guard lg(m_writeDefender);
+
+            const std::string MessageKey = uuidToKey(LSM_KEY_MESSAGE, inMessage->m_uuid);
+            std::string OldTimelineKey;
+
+            if (!get(MessageKey, OldTimelineKey, Error))
+            {
+                if (!Error) // Если сообщение не найдено
+                    Error = make_error_code(errors::eDataStorageError::dsMessageNotExists);
+            }
+            else // Сообщение найдено
+            {
+                nlohmann::json UpdateMessage = messageToJson(inMessage, Error); // Формируем объект сообщения
+
+                if (!Error) // Если объект сформирован корректно
+                {
+                    HMLsmWriteBatch Batch;
+                    const std::string NewTimelineKey = timelineKey(inMessage);
+
+                    if (NewTimelineKey != OldTimelineKey) // Сменилось время или группа, переносим сообщение в ленте
+                    {
+                        Batch.remove(OldTimelineKey);
+                        Batch.put(MessageKey, NewTimelineKey);
+                    }
+
+                    Batch.put(NewTimelineKey, encode(UpdateMessage));
+                    Error = apply(Batch);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMGroupInfoMessage> HMLsmDataStorage::findMessage(const QUuid& inMessageUUID, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMGroupInfoMessage> Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::string TimelineKey;
+        nlohmann::json Message;
+
+        if (get(uuidToKey(LSM_KEY_MESSAGE, inMessageUUID), TimelineKey, outErrorCode) && // Ищим ключ сообщения в ленте
+            readObject(TimelineKey, Message, outErrorCode)) // Читаем сообщение из ленты
+        {
+            Result = jsonToMessage(Message, outErrorCode); // Преобразуем JSON объект в сообщение
+
+            if (outErrorCode)
+                Result = nullptr;
+        }
+        else if (!outErrorCode) // Если сообщение не найдено
+            outErrorCode = make_error_code(errors::eDataStorageError::dsMessageNotExists);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMLsmDataStorage::findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const
+{
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Result;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        if (inRange.m_from <= inRange.m_to) // Пустой диапазон сканировать не имеет смысла
+        {
+            const std::string Prefix = timelinePrefix(inGroupUUID);
+            // Лента группы отсортирована по времени, ';' следует сразу за ':' и замыкает все сообщения с временем inRange.m_to
+            outErrorCode = scan(Prefix + timeToKey(inRange.m_from), Prefix + timeToKey(inRange.m_to) + ";",
+                                [&](const std::string&, const LsmValue& inValue)
+            {
+                errors::error_code ConvertErr;
+                std::shared_ptr<hmcommon::HMGroupInfoMessage> MSG = decodeMessage(*inValue, ConvertErr); // Преобразуем запись в сообщение
+
+                if (ConvertErr) // Повреждённное сообщение игнорируется
+                    LOG_WARNING(ConvertErr.message_qstr());
+                else
+                    Result.push_back(MSG); // Помещаем сообщение в итоговый контейнер
+
+                return true;
+            });
+        }
+
+        if (outErrorCode)
+            Result.clear();
+        else if (Result.empty()) // Сообщения не найдены
+            outErrorCode = make_error_code(errors::eDataStorageError::dsMessageNotExists);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> HMLsmDataStorage::findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const
+{
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Result;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else if (!inCursor.m_time.isValid() || inCursor.m_limit == 0 || inCursor.m_direction == hmcommon::eMsgPageDirection::pdCount)
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorretData);
+    else
+    {
+        const std::string Prefix = timelinePrefix(inGroupUUID);
+        // Курсор без UUID сообщения стоит перед всеми сообщениями своего времени
+        const std::string Anchor = Prefix + timeToKey(inCursor.m_time) + ((inCursor.m_message.isNull()) ? std::string() : ":" + inCursor.m_message.toString().toStdString());
+        std::deque<std::string> Page; // Не более m_limit записей, упорядоченных по времени
+
+        if (inCursor.m_direction == hmcommon::eMsgPageDirection::pdAfter)
+        {   // Начинаем сразу за курсором, ';' следует за ':' и замыкает ленту группы
+            outErrorCode = scan(Anchor + '\0', Prefix.substr(0, Prefix.size() - 1) + ";", [&](const std::string&, const LsmValue& inValue)
+            {
+                Page.push_back(*inValue);
+                return Page.size() < inCursor.m_limit; // Прекращаем перебор, как только страница заполнена
+            });
+        }
+        else
+        {   // Перебор возможен только вперёд, поэтому идём от курсора назад удваивающимися окнами
+            std::string Upper = Anchor;
+            std::chrono::milliseconds Window = LSM_PAGE_WINDOW;
+            bool Exhausted = false;
+
+            while (!outErrorCode && !Exhausted && Page.size() < inCursor.m_limit)
+            {
+                std::string Lower = Prefix;
+
+                if (Window >= LSM_PAGE_MAX_WINDOW) // Окно стало слишком большим, дочитываем ленту с начала
+                    Exhausted = true;
+                else
+                    Lower += timeToKey(inCursor.m_time.addMSecs(-Window.count()));
+
+                const std::size_t Need = inCursor.m_limit - Page.size();
+                std::deque<std::string> Chunk; // Последние Need записей окна
+
+                outErrorCode = scan(Lower, Upper, [&](const std::string&, const LsmValue& inValue)
+                {
+                    Chunk.push_back(*inValue);
+
+                    if (Chunk.size() > Need) // Вытесняем самую дальнюю от курсора запись
+                        Chunk.pop_front();
+
+                    return true;
+                });
+
+                Page.insert(Page.begin(), Chunk.begin(), Chunk.end());
+                Upper = std::move(Lower);
+                Window *= 2;
+            }
+        }
+
+        if (!outErrorCode)
+        {
+            Result.reserve(Page.size());
+
+            for (const std::string& Value : Page)
+            {
+                errors::error_code ConvertErr;
+                std::shared_ptr<hmcommon::HMGroupInfoMessage> MSG = decodeMessage(Value, ConvertErr); // Преобразуем запись в сообщение
+
+                if (ConvertErr) // Повреждённное сообщение игнорируется
+                    LOG_WARNING(ConvertErr.message_qstr());
+                else
+                    Result.push_back(MSG); // Помещаем сообщение в итоговый контейнер
+            }
+        }
+
+        if (outErrorCode)
+            Result.clear();
+        else if (Result.empty()) // Сообщения не найдены
+            outErrorCode = make_error_code(errors::eDataStorageError::dsMessageNotExists);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open()) // Хранилище должно быть открыто
+        Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        std::lock_guard lg(m_writeDefender);
+
+        const std::string MessageKey = uuidToKey(LSM_KEY_MESSAGE, inMessageUUID);
+        const std::string Prefix = timelinePrefix(inGroupUUID);
+        std::string TimelineKey;
+
+        if (get(MessageKey, TimelineKey, Error) && TimelineKey.compare(0, Prefix.size(), Prefix) == 0) // Сообщение существует и принадлежит группе
+        {
+            HMLsmWriteBatch Batch;
+            Batch.remove(MessageKey);
+            Batch.remove(TimelineKey);
+
+            Error = apply(Batch);
+        }
+        // Если не найдено сообщение на удаление то это не ошибка
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::makeDefault()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    HMLsmWriteBatch Batch;
+    Batch.put(LSM_KEY_VERSION, LSM_FORMAT_VESION); // Задаём версию формата
+
+    Error = apply(Batch);
+
+    if (!Error)
+    {   // Формируем пользователя администратора
+        std::shared_ptr<hmcommon::HMUserInfo> AdminUser = std::make_shared<hmcommon::HMUserInfo>(QUuid::createUuid());
+        AdminUser->setName("Administrator");
+        AdminUser->setLogin("Admin@gmail.com");
+        AdminUser->setPassword("password");
+        AdminUser->setSex(hmcommon::eSex::sNotSpecified);
+
+        Error = addUser(AdminUser); // Добавляем администратора
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmDataStorage::get(const std::string& inKey, std::string& outValue, errors::error_code& outErrorCode) const
+{
+    LsmValue Pending;
+    bool Found = false;
+
+    if (m_transactionOwner == std::this_thread::get_id()) // Изменения транзакции видит только её поток
+    {
+        auto FindRes = m_transactionWrites.find(inKey);
+
+        if (FindRes != m_transactionWrites.cend()) // Ключ изменён в открытой транзакции
+        {
+            Found = true;
+            Pending = FindRes->second;
+        }
+    }
+
+    bool Result = false;
+
+    if (!Found) // Ключ транзакцией не затронут
+        Result = m_engine.get(inKey, outValue, outErrorCode);
+    else
+    {
+        outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess);
+        Result = Pending.has_value(); // Метка удаления означает отсутствие значения
+
+        if (Result)
+            outValue = std::move(*Pending);
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::scan(const std::string& inFrom, const std::string& inTo, const LsmScanCallBackFn& inCallBack) const
+{
+    LsmMemTable Pending; // Копия изменений транзакции из диапазона (обработчик может изменять хранилище)
+
+    if (m_transactionOwner == std::this_thread::get_id() && !m_transactionWrites.empty()) // Изменения транзакции видит только её поток
+        Pending.insert(m_transactionWrites.lower_bound(inFrom), m_transactionWrites.lower_bound(inTo));
+
+    if (Pending.empty()) // Диапазон транзакцией не затронут, перебираем хранилище напрямую
+        return m_engine.scan(inFrom, inTo, inCallBack);
+
+    auto PendingIt = Pending.cbegin();
+    bool Continue = true;
+
+    auto EmitPending = [&](const std::string* inBound) // Выдаём отложенные записи с ключами меньше inBound
+    {
+        while (Continue && PendingIt != Pending.cend() && (!inBound || PendingIt->first < *inBound))
+        {
+            if (PendingIt->second) // Метки удаления пропускаются
+                Continue = inCallBack(PendingIt->first, PendingIt->second);
+
+            ++PendingIt;
+        }
+    };
+
+    errors::error_code Error = m_engine.scan(inFrom, inTo, [&](const std::string& inKey, const LsmValue& inValue)
+    {
+        EmitPending(&inKey);
+
+        if (Continue)
+        {
+            if (PendingIt != Pending.cend() && PendingIt->first == inKey) // Значение транзакции новее значения хранилища
+            {
+                if (PendingIt->second)
+                    Continue = inCallBack(PendingIt->first, PendingIt->second);
+
+                ++PendingIt;
+            }
+            else
+                Continue = inCallBack(inKey, inValue);
+        }
+
+        return Continue;
+    });
+
+    if (!Error)
+        EmitPending(nullptr); // Оставшиеся отложенные записи следуют за последней записью хранилища
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::apply(const HMLsmWriteBatch& inBatch)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (m_transactionOwner == std::this_thread::get_id()) // Поток открыл транзакцию, откладываем изменения до её фиксации
+    {
+        for (const auto& [Key, Value] : inBatch.records())
+            m_transactionWrites[Key] = Value;
+    }
+    else
+        Error = m_engine.write(inBatch);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmDataStorage::readObject(const std::string& inKey, nlohmann::json& outObject, errors::error_code& outErrorCode) const
+{
+    std::string Value;
+    bool Result = get(inKey, Value, outErrorCode);
+
+    if (Result)
+    {
+        outObject = nlohmann::json::from_cbor(Value, true, false); // Разбираем без исключений
+
+        if (outObject.is_discarded()) // Запись повреждена
+        {
+            outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorretData);
+            outObject = nlohmann::json::object();
+            Result = false;
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json HMLsmDataStorage::findUser(const QUuid& inUserUUID, errors::error_code& outErrorCode) const
+{
+    nlohmann::json Result = nlohmann::json::object();
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!readObject(uuidToKey(LSM_KEY_USER, inUserUUID), Result, outErrorCode))
+    {
+        if (!outErrorCode) // Если пользователь не найден
+            outErrorCode = make_error_code(errors::eDataStorageError::dsUserNotExists);
+    }
+    else
+        outErrorCode = m_validator.checkUser(Result); // Проверяем валидность объекта пользователя
+
+    if (outErrorCode)
+        Result = nlohmann::json::object();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json HMLsmDataStorage::findGroup(const QUuid& inGroupUUID, errors::error_code& outErrorCode) const
+{
+    nlohmann::json Result = nlohmann::json::object();
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!readObject(uuidToKey(LSM_KEY_GROUP, inGroupUUID), Result, outErrorCode))
+    {
+        if (!outErrorCode) // Если группа не найдена
+            outErrorCode = make_error_code(errors::eDataStorageError::dsGroupNotExists);
+    }
+    else
+        outErrorCode = m_validator.checkGroup(Result); // Проверяем валидность объекта группы
+
+    if (outErrorCode)
+        Result = nlohmann::json::object();
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json* HMLsmDataStorage::cachedUser(const QUuid& inUserUUID, ObjectCache& ioCache, errors::error_code& outErrorCode) const
+{
+    nlohmann::json* Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    const std::string Key = uuidToKey(LSM_KEY_USER, inUserUUID);
+    auto FindRes = ioCache.find(Key);
+
+    if (FindRes != ioCache.end()) // Пользователь уже в рабочем наборе
+        Result = &FindRes->second;
+    else
+    {
+        nlohmann::json User = findUser(inUserUUID, outErrorCode);
+
+        if (!outErrorCode)
+            Result = &ioCache.emplace(Key, std::move(User)).first->second;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json* HMLsmDataStorage::cachedGroup(const QUuid& inGroupUUID, ObjectCache& ioCache, errors::error_code& outErrorCode) const
+{
+    nlohmann::json* Result = nullptr;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    const std::string Key = uuidToKey(LSM_KEY_GROUP, inGroupUUID);
+    auto FindRes = ioCache.find(Key);
+
+    if (FindRes != ioCache.end()) // Группа уже в рабочем наборе
+        Result = &FindRes->second;
+    else
+    {
+        nlohmann::json Group = findGroup(inGroupUUID, outErrorCode);
+
+        if (!outErrorCode)
+            Result = &ioCache.emplace(Key, std::move(Group)).first->second;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::commit(const ObjectCache& inCache, HMLsmWriteBatch& ioBatch)
+{
+    for (const auto& [Key, Object] : inCache)
+        ioBatch.put(Key, encode(Object));
+
+    return apply(ioBatch); // Весь набор попадёт в журнал одной записью
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::linkContacts(const QUuid& inUserUUID, const QUuid& inContactUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (inUserUUID == inContactUUID) // Если пользователю пытаемся добавить в контакты его самого
+        Error = make_error_code(errors::eSystemErrorEx::seIncorretData);
+    else
+    {
+        nlohmann::json* User = cachedUser(inUserUUID, ioCache, Error); // Ищим пользователя
+
+        if (!Error) // Пользователь найден
+        {
+            const std::string ContactUUID = inContactUUID.toString().toStdString();
+
+            if (findUUID((*User)[J_USER_CONTACTS], ContactUUID) != (*User)[J_USER_CONTACTS].end()) // Если контакт уже добавлен в список
+                Error = make_error_code(errors::eDataStorageError::dsUserContactRelationAlredyExists);
+            else
+            {
+                nlohmann::json* Contact = cachedUser(inContactUUID, ioCache, Error); // Ищим контакт
+
+                if (!Error) // Контакт найден, связываем с обеих сторон
+                {
+                    const std::string UserUUID = inUserUUID.toString().toStdString();
+
+                    (*User)[J_USER_CONTACTS].push_back(ContactUUID);
+
+                    if (findUUID((*Contact)[J_USER_CONTACTS], UserUUID) == (*Contact)[J_USER_CONTACTS].end()) // По другому быть не должно
+                        (*Contact)[J_USER_CONTACTS].push_back(UserUUID);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::unlinkContacts(const QUuid& inUserUUID, const QUuid& inContactUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    nlohmann::json* User = cachedUser(inUserUUID, ioCache, Error); // Ищим пользователя
+
+    if (!Error) // Пользователь найден
+    {
+        const std::string ContactUUID = inContactUUID.toString().toStdString();
+        auto FindContact = findUUID((*User)[J_USER_CONTACTS], ContactUUID);
+
+        if (FindContact == (*User)[J_USER_CONTACTS].end()) // Если контакт не найден
+            Error = make_error_code(errors::eDataStorageError::dsUserContactNotExists);
+        else
+        {
+            nlohmann::json* Contact = cachedUser(inContactUUID, ioCache, Error); // Ищим контакт
+
+            if (!Error) // Контакт найден, разрываем связь с обеих сторон
+            {
+                auto FindUser = findUUID((*Contact)[J_USER_CONTACTS], inUserUUID.toString().toStdString());
+
+                if (FindUser == (*Contact)[J_USER_CONTACTS].end()) // Обратная связь отсутствует
+                    Error = make_error_code(errors::eDataStorageError::dsUserContactNotExists);
+                else
+                {
+                    (*Contact)[J_USER_CONTACTS].erase(FindUser);
+                    (*User)[J_USER_CONTACTS].erase(FindContact);
+                }
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::unlinkAllContacts(const QUuid& inUserUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    nlohmann::json* User = cachedUser(inUserUUID, ioCache, Error); // Ищим пользователя
+
+    if (!Error)
+    {
+        const nlohmann::json Contacts = (*User)[J_USER_CONTACTS]; // Копия, так как список изменяется при разрыве связей
+
+        for (auto It = Contacts.cbegin(); !Error && It != Contacts.cend(); ++It)
+            Error = unlinkContacts(inUserUUID, QUuid::fromString(QString::fromStdString(It->get<std::string>())), ioCache);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::linkGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    nlohmann::json* Group = cachedGroup(inGroupUUID, ioCache, Error); // Ищим группу
+
+    if (!Error) // Группа успешно найдена
+    {
+        const std::string UserUUID = inUserUUID.toString().toStdString();
+
+        if (findUUID((*Group)[J_GROUP_USERS], UserUUID) != (*Group)[J_GROUP_USERS].end()) // Если пользователь уже в группе
+            Error = make_error_code(errors::eDataStorageError::dsGroupUserRelationAlredyExists);
+        else
+        {
+            nlohmann::json* User = cachedUser(inUserUUID, ioCache, Error); // Ищим пользователя
+
+            if (!Error) // Пользователь успешно найден
+            {
+                const std::string GroupUUID = inGroupUUID.toString().toStdString();
+
+                (*Group)[J_GROUP_USERS].push_back(UserUUID); // Добавляем пользователя в группу
+
+                if (findUUID((*User)[J_USER_GROUPS], GroupUUID) == (*User)[J_USER_GROUPS].end()) // По другому быть не должно
+                    (*User)[J_USER_GROUPS].push_back(GroupUUID); // Добавляем группу в список групп пользователя
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::unlinkGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    nlohmann::json* Group = cachedGroup(inGroupUUID, ioCache, Error); // Ищим группу
+
+    if (!Error) // Группа успешно найдена
+    {
+        auto FindUser = findUUID((*Group)[J_GROUP_USERS], inUserUUID.toString().toStdString());
+
+        if (FindUser == (*Group)[J_GROUP_USERS].end()) // Если пользователя нет в группе
+            Error = make_error_code(errors::eDataStorageError::dsGroupUserRelationNotExists);
+        else
+        {
+            nlohmann::json* User = cachedUser(inUserUUID, ioCache, Error); // Ищим пользователя
+
+            if (!Error) // Пользователь успешно найден
+            {
+                auto FindGroup = findUUID((*User)[J_USER_GROUPS], inGroupUUID.toString().toStdString());
+
+                if (FindGroup != (*User)[J_USER_GROUPS].end()) // По другому быть не должно
+                    (*User)[J_USER_GROUPS].erase(FindGroup); // Удаляем группу из списка групп пользователя
+
+                (*Group)[J_GROUP_USERS].erase(FindUser); // Удаляем пользователя из группы
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmDataStorage::unlinkAllGroupUsers(const QUuid& inGroupUUID, ObjectCache& ioCache) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    nlohmann::json* Group = cachedGroup(inGroupUUID, ioCache, Error); // Ищим группу
+
+    if (!Error)
+    {
+        const nlohmann::json Users = (*Group)[J_GROUP_USERS]; // Копия, так как список изменяется при удалении участников
+
+        for (auto It = Users.cbegin(); !Error && It != Users.cend(); ++It)
+            Error = unlinkGroupUser(inGroupUUID, QUuid::fromString(QString::fromStdString(It->get<std::string>())), ioCache);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMUserInfo> HMLsmDataStorage::jsonToUser(const nlohmann::json& inUserObject, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMUserInfo> Result = nullptr;
+    outErrorCode = m_validator.checkUser(inUserObject); // Проверяем валидность пользователя
+
+    if (!outErrorCode) // Если объект валиден
+    {   // Инициализируем экземпляр класса пользователя
+        Result = std::make_shared<hmcommon::HMUserInfo>(QUuid::fromString(QString::fromStdString(inUserObject[J_USER_UUID].get<std::string>())),
+                                                    QDateTime::fromString(QString::fromStdString(inUserObject[J_USER_REGDATE].get<std::string>()), TIME_FORMAT));
+
+        Result->setLogin(QString::fromStdString(inUserObject[J_USER_LOGIN].get<std::string>()));
+        Result->setPasswordHash(m_validator.jsonToByteArr(inUserObject[J_USER_PASS]));
+        Result->setName(QString::fromStdString(inUserObject[J_USER_NAME].get<std::string>()));
+        Result->setSex(inUserObject[J_USER_SEX].get<hmcommon::eSex>());
+        Result->setBirthday(QDate::fromString(QString::fromStdString(inUserObject[J_USER_BIRTHDAY].get<std::string>())));
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json HMLsmDataStorage::userToJson(std::shared_ptr<hmcommon::HMUserInfo> inUser, errors::error_code& outErrorCode) const
+{
+    nlohmann::json Result = nlohmann::json::value_type::object();
+    outErrorCode = make_error_code(errors::eSystemErrorEx::seSuccess);
+
+    if (!inUser) // Проверяем валидность указателя
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+    else // Объект валиден
+    {
+        Result[J_USER_UUID] = inUser->m_uuid.toString().toStdString();
+        Result[J_USER_REGDATE] = inUser->m_registrationDate.toString(TIME_FORMAT).toStdString();
+        Result[J_USER_LOGIN] = inUser->getLogin().toStdString();
+        Result[J_USER_PASS] = m_validator.byteArrToJson(inUser->getPasswordHash());
+        Result[J_USER_NAME] = inUser->getName().toStdString();
+        Result[J_USER_SEX] = static_cast<std::uint32_t>(inUser->getSex());
+        Result[J_USER_BIRTHDAY] = inUser->getBirthday().toString().toStdString();
+        // Так же создаём пустые массивы контактов и групп
+        Result[J_USER_CONTACTS] = nlohmann::json::array();
+        Result[J_USER_GROUPS] = nlohmann::json::array();
+
+        outErrorCode = m_validator.checkUser(Result); // Заранее проверяем корректность создаваемого пользователя
+
+        if (outErrorCode)
+            Result.clear();
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMGroupInfo> HMLsmDataStorage::jsonToGroup(const nlohmann::json& inGroupObject, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMGroupInfo> Result = nullptr;
+    outErrorCode = m_validator.checkGroup(inGroupObject); // Проверяем валидность группы
+
+    if (!outErrorCode) // Если объект валиден
+    {
+        Result = std::make_shared<hmcommon::HMGroupInfo>(QUuid::fromString(QString::fromStdString(inGroupObject[J_GROUP_UUID].get<std::string>())),
+                                                     QDateTime::fromString(QString::fromStdString(inGroupObject[J_GROUP_REGDATE].get<std::string>()), TIME_FORMAT));
+
+        Result->setName(QString::fromStdString(inGroupObject[J_GROUP_NAME].get<std::string>()));
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json HMLsmDataStorage::groupToJson(std::shared_ptr<hmcommon::HMGroupInfo> inGroup, errors::error_code& outErrorCode) const
+{
+    nlohmann::json Result = nlohmann::json::value_type::object();
+    outErrorCode = make_error_code(errors::eSystemErrorEx::seSuccess);
+
+    if (!inGroup) // Проверяем валидность указателя
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+    else // Объект валиден
+    {
+        Result[J_GROUP_UUID] = inGroup->m_uuid.toString().toStdString();
+        Result[J_GROUP_REGDATE] = inGroup->m_registrationDate.toString(TIME_FORMAT).toStdString();
+        Result[J_GROUP_NAME] = inGroup->getName().toStdString();
+        // Так же создаём пустой массив пользователей группы
+        Result[J_GROUP_USERS] = nlohmann::json::array();
+
+        outErrorCode = m_validator.checkGroup(Result); // Заранее проверяем корректность создаваемой группы
+
+        if (outErrorCode)
+            Result.clear();
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMGroupInfoMessage> HMLsmDataStorage::jsonToMessage(const nlohmann::json& inMessageObject, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMGroupInfoMessage> Result = nullptr;
+    outErrorCode = m_validator.checkMessage(inMessageObject); // Проверяем валидность сообщения
+
+    if (!outErrorCode) // Если объект валиден
+    {
+        Result = std::make_shared<hmcommon::HMGroupInfoMessage>(QUuid::fromString(QString::fromStdString(inMessageObject[J_MESSAGE_UUID].get<std::string>())),
+                                                            QUuid::fromString(QString::fromStdString(inMessageObject[J_MESSAGE_GROUP_UUID].get<std::string>())),
+                                                            QDateTime::fromString(QString::fromStdString(inMessageObject[J_MESSAGE_REGDATE].get<std::string>()), TIME_FORMAT));
+
+        hmcommon::MsgData Data(inMessageObject[J_MESSAGE_TYPE].get<hmcommon::eMsgType>(), m_validator.jsonToByteArr(inMessageObject[J_MESSAGE_DATA]));
+        outErrorCode = Result->setMessage(Data);
+
+        if (outErrorCode)
+            Result = nullptr;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<hmcommon::HMGroupInfoMessage> HMLsmDataStorage::decodeMessage(const std::string& inValue, errors::error_code& outErrorCode) const
+{
+    std::shared_ptr<hmcommon::HMGroupInfoMessage> Result = nullptr;
+    const nlohmann::json MessageObject = nlohmann::json::from_cbor(inValue, true, false);
+
+    if (MessageObject.is_discarded())
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorretData);
+    else
+        Result = jsonToMessage(MessageObject, outErrorCode); // Преобразуем объект в сообщение
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+nlohmann::json HMLsmDataStorage::messageToJson(std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, errors::error_code& outErrorCode) const
+{
+    nlohmann::json Result = nlohmann::json::value_type::object();
+    outErrorCode = make_error_code(errors::eSystemErrorEx::seSuccess);
+
+    if (!inMessage) // Проверяем валидность указателя
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seInvalidPtr);
+    else // Объект валиден
+    {
+        Result[J_MESSAGE_UUID] = inMessage->m_uuid.toString().toStdString();
+        Result[J_MESSAGE_GROUP_UUID] = inMessage->m_group.toString().toStdString();
+        Result[J_MESSAGE_REGDATE] = inMessage->m_createTime.toString(TIME_FORMAT).toStdString();
+
+        hmcommon::MsgData Data = inMessage->getMesssage();
+
+        Result[J_MESSAGE_TYPE] = static_cast<std::uint32_t>(Data.m_type);
+        Result[J_MESSAGE_DATA] = m_validator.byteArrToJson(Data.m_data);
+
+        outErrorCode = m_validator.checkMessage(Result); // Заранее проверяем корректность создаваемого сообщения
+
+        if (outErrorCode)
+            Result.clear();
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
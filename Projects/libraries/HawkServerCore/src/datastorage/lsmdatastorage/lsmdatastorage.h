@@ -0,0 +1,520 @@
+#ifndef LSMDATASTORAGE_H
+#define LSMDATASTORAGE_H
+
+/**
+ * @file lsmdatastorage.h
+ * @brief Содержит описание класса хранилища данных на основе встраиваемого LSM хранилища
+ */
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <filesystem>
+
+#include <nlohmann/json.hpp>
+
+#include "lsmengine.h"
+#include "datastorage/jsondatastorage/jsondatastoragevalidator.h"
+#include "datastorage/interface/abstractharddatastorage.h"
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmDataStorage class - Класс, описывающий хранилище данных сервера на основе LSM хранилища
+ * Каждая сущность хранится отдельной записью (CBOR), изменения применяются точечно,
+ * а многоключевые операции записываются в журнал одним атомарным набором.
+ * Транзакция принадлежит открывшему её потоку: до её фиксации изменения копятся в памяти поверх LSM хранилища,
+ * видны только этому потоку и попадают в журнал одним набором при завершении внешней транзакции.
+ * Пока транзакция открыта, изменения других потоков ждут её завершения, а их чтения видят только записанные данные.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmDataStorage : public HMAbstractHardDataStorage
+{
+private:
+
+    using ObjectCache = std::map<std::string, nlohmann::json>; ///< Рабочий набор изменяемых объектов (ключ -> объект)
+
+    HMLsmEngine m_engine;                       ///< LSM хранилище ключ-значение
+    HMJsonDataStorageValidator m_validator;     ///< Валидатор формата данных
+
+    std::recursive_mutex m_writeDefender;       ///< Мьютекс, упорядочивающий операции чтение-изменение-запись (транзакция удерживает его до завершения)
+
+    std::atomic<std::thread::id> m_transactionOwner;    ///< Поток, открывший транзакцию
+    LsmMemTable m_transactionWrites;                    ///< Изменения открытой транзакции, ещё не записанные в хранилище
+    std::size_t m_transactionDepth = 0;                 ///< Глубина вложенности транзакций
+
+public:
+
+    /**
+     * @brief HMLsmDataStorage - Инициализирующий конструктор
+     * @param inDirPath - Путь к директории хранилища
+     * @param inMemTableLimit - Размер memtable (байт), при превышении которого она сбрасывается в сегмент
+     * @param inCompactionTrigger - Количество сегментов, при достижении которого запускается уплотнение
+     */
+    HMLsmDataStorage(const std::filesystem::path& inDirPath,
+                     const std::size_t inMemTableLimit = LSM_DEFAULT_MEMTABLE_LIMIT,
+                     const std::size_t inCompactionTrigger = LSM_DEFAULT_COMPACTION_TRIGGER);
+
+    /**
+     * @brief ~HMLsmDataStorage - Виртуальный деструктор
+     */
+    virtual ~HMLsmDataStorage() override;
+
+
+    // Хранилище
+
+    /**
+     * @brief open - Метод откроет хранилище данных
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code open() override;
+
+    /**
+     * @brief is_open - Метод вернёт признак открытости хранилища данных
+     * @return Вернёт признак открытости
+     */
+    virtual bool is_open() const override;
+
+    /**
+     * @brief close - Метод закроет хранилище данных
+     */
+    virtual void close() override;
+
+    // Транзакции
+
+    /**
+     * @brief beginTransaction - Метод начнёт транзакцию (вложенный вызов только увеличит глубину)
+     * Изменения копятся в памяти и попадают в журнал одним набором при фиксации внешней транзакции.
+     * Транзакция принадлежит вызвавшему потоку, изменения других потоков ждут её завершения
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code beginTransaction() override;
+
+    /**
+     * @brief commitTransaction - Метод завершит транзакцию (завершение внешней транзакции фиксирует изменения)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code commitTransaction() override;
+
+    /**
+     * @brief rollbackTransaction - Метод отменит все изменения транзакции (на любой глубине вложенности)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code rollbackTransaction() override;
+
+    /**
+     * @brief compact - Метод сбросит данные на диск и уплотнит сегменты хранилища
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code compact();
+
+    // Пользователи
+
+    /**
+     * @brief addUser - Метод добавит нового пользователя
+     * @param inUser - Добавляемый пользователь
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code addUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser) override;
+
+    /**
+     * @brief updateUser - Метод обновит данные пользователя
+     * @param inUser - Обновляемый пользователь
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code updateUser(const std::shared_ptr<hmcommon::HMUserInfo> inUser) override;
+
+    /**
+     * @brief findUserByUUID - Метод найдёт пользователя по его uuid
+     * @param inUserUUID - Uuid пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр пользователя или nullptr
+     */
+    virtual std::shared_ptr<hmcommon::HMUserInfo> findUserByUUID(const QUuid& inUserUUID, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief findUserByAuthentication - Метод найдёт пользователя по его данным аутентификации
+     * @param inLogin - Логин пользователя
+     * @param inPasswordHash - Хеш пароля пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр пользователя или nullptr
+     */
+    virtual std::shared_ptr<hmcommon::HMUserInfo> findUserByAuthentication(const QString& inLogin, const QByteArray& inPasswordHash, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief removeUser - Метод удалит пользователя
+     * @param inUserUUID - Uuid удаляемого пользователя
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code removeUser(const QUuid& inUserUUID) override;
+
+    /**
+     * @brief setUserContacts - Метод задаст пользователю список контактов
+     * @param inUserUUID - Uuid пользователья
+     * @param inContacts - Список контактов
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code setUserContacts(const QUuid& inUserUUID, const std::shared_ptr<std::set<QUuid>> inContacts) override;
+
+    /**
+     * @brief addUserContact - Метод добавит контакт пользователю
+     * @param inUserUUID - Uuid пользователя
+     * @param inContactUUID - Uuid контакта
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code addUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID) override;
+
+    /**
+     * @brief removeUserContact - Метод удалит контакт пользователя
+     * @param inUserUUID - Uuid пользователя
+     * @param inContactUUID - Uuid контакта
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code removeUserContact(const QUuid& inUserUUID, const QUuid& inContactUUID) override;
+
+    /**
+     * @brief clearUserContacts - Метод очистит контакты пользователя
+     * @param inUserUUID - Uuid пользователя
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code clearUserContacts(const QUuid& inUserUUID) override;
+
+    /**
+     * @brief getUserContactList - Метод вернёт список контактов пользователя
+     * @param inUserUUID - Uuid пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт список контактов пользователя
+     */
+    virtual std::shared_ptr<std::set<QUuid>> getUserContactList(const QUuid& inUserUUID, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief getUserGroups - Метод вернёт список групп пользователя
+     * @param inUserUUID - Uuid пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт список UUID'ов групп пользователя
+     */
+    virtual std::shared_ptr<std::set<QUuid>> getUserGroups(const QUuid& inUserUUID, errors::error_code& outErrorCode) const override;
+
+    // Группы
+
+    /**
+     * @brief addGroup - Метод добавит новую группу
+     * @param inGroup - Добавляемая группа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code addGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup) override;
+
+    /**
+     * @brief updateGroup - Метод обновит данные группы
+     * @param inGroup - Обновляемая группа
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code updateGroup(const std::shared_ptr<hmcommon::HMGroupInfo> inGroup) override;
+
+    /**
+     * @brief findGroupByUUID - Метод найдёт пользователя по его uuid
+     * @param inGroupUUID - Uuid группы
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр группы или nullptr
+     */
+    virtual std::shared_ptr<hmcommon::HMGroupInfo> findGroupByUUID(const QUuid& inGroupUUID, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief removeGroup - Метод удалит группу
+     * @param inGroupUUID - Uuid удаляемой группы
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code removeGroup(const QUuid& inGroupUUID) override;
+
+    /**
+     * @brief setGroupUsers - Метод задаст список членов группы
+     * @param inGroupUUID - Uuid группы
+     * @param inUsers - Список пользователей группы (UUID'ы)
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code setGroupUsers(const QUuid& inGroupUUID, const std::shared_ptr<std::set<QUuid>> inUsers) override;
+
+    /**
+     * @brief setGroupUsers - Метод добавит пользователя в группу
+     * @param inGroupUUID - Uuid группы
+     * @param inUserUUID - UUID пользователя
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code addGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID) override;
+
+    /**
+     * @brief removeGroupUser - Метод удалит пользователя из группы
+     * @param inGroupUUID - Uuid группы
+     * @param inUserUUID - Uuid пользователя
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code removeGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID) override;
+
+    /**
+     * @brief clearGroupUsers - Метод очистит список членов группы
+     * @param inGroupUUID - Uuid группы
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code clearGroupUsers(const QUuid& inGroupUUID) override;
+
+    /**
+     * @brief getGroupUserList - Метод вернёт список UUID'ов членов группы
+     * @param inGroupUUID - Uuid группы
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт список UUID'ов пользователей группы
+     */
+    virtual std::shared_ptr<std::set<QUuid>> getGroupUserList(const QUuid& inGroupUUID, errors::error_code& outErrorCode) const override;
+
+    // Сообщения
+
+    /**
+     * @brief addMessage - Метод добавит новое сообщение
+     * @param inMessage - Добавляемое сообщение
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code addMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage) override;
+
+    /**
+     * @brief updateMessage - Метод обновит данные сообщения
+     * @param inMessage - Обновляемое сообщение
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code updateMessage(const std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage) override;
+
+    /**
+     * @brief findMessage - Метод найдёт сообщение по его uuid
+     * @param inMessageUUID - Uuid сообщения
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр сообщения или nullptr
+     */
+    virtual std::shared_ptr<hmcommon::HMGroupInfoMessage> findMessage(const QUuid& inMessageUUID, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief findMessages - Метод вернёт перечень сообщений группы за куазаный промежуток времени
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inRange - Временной диапозон
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт перечень сообщений
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessages(const QUuid& inGroupUUID, const hmcommon::MsgRange& inRange, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief findMessagesPage - Метод вернёт страницу сообщений группы относительно курсора
+     * @param inGroupUUID - Uuid группы, которой пренадлежат сообщения
+     * @param inCursor - Курсор (позиция, направление и размер страницы)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт не более inCursor.m_limit ближайших к курсору сообщений, упорядоченных по времени создания
+     */
+    virtual std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> findMessagesPage(const QUuid& inGroupUUID, const hmcommon::MsgCursor& inCursor, errors::error_code& outErrorCode) const override;
+
+    /**
+     * @brief removeMessage - Метод удалит сообщение
+     * @param inMessageUUID - Uuid сообщения
+     * @param inGroupUUID - Uuid группы
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code removeMessage(const QUuid& inMessageUUID, const QUuid& inGroupUUID) override;
+
+protected:
+
+    /**
+     * @brief makeDefault - Метод сформирует дефолтную структуру хранилища
+     * @return Вернёт признак ошибки
+     */
+    virtual errors::error_code makeDefault() override;
+
+private:
+
+    /**
+     * @brief get - Метод найдёт значение по ключу с учётом изменений транзакции вызывающего потока
+     * @param inKey - Ключ
+     * @param outValue - Найденное значение
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт признак наличия значения
+     */
+    bool get(const std::string& inKey, std::string& outValue, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief scan - Метод переберёт актуальные записи диапазона [inFrom, inTo) с учётом изменений транзакции вызывающего потока
+     * @param inFrom - Начало диапазона (включительно)
+     * @param inTo - Конец диапазона (исключительно)
+     * @param inCallBack - Обработчик записи (вернёт false для прекращения перебора)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code scan(const std::string& inFrom, const std::string& inTo, const LsmScanCallBackFn& inCallBack) const;
+
+    /**
+     * @brief apply - Метод применит набор изменений (в транзакции вызывающего потока набор откладывается до её фиксации)
+     * @param inBatch - Набор изменений
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code apply(const HMLsmWriteBatch& inBatch);
+
+    /**
+     * @brief readObject - Метод прочитает объект из хранилища
+     * @param inKey - Ключ объекта
+     * @param outObject - Прочитанный объект
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт признак наличия объекта
+     */
+    bool readObject(const std::string& inKey, nlohmann::json& outObject, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief findUser - Метод прочитает json объект пользователя из хранилища
+     * @param inUserUUID - UUID пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт json объект пользователя (пустой объект в случае ошибки)
+     */
+    nlohmann::json findUser(const QUuid& inUserUUID, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief findGroup - Метод прочитает json объект группы из хранилища
+     * @param inGroupUUID - UUID группы
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт json объект группы (пустой объект в случае ошибки)
+     */
+    nlohmann::json findGroup(const QUuid& inGroupUUID, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief cachedUser - Метод вернёт объект пользователя из рабочего набора (при необходимости загрузит его)
+     * @param inUserUUID - UUID пользователя
+     * @param ioCache - Рабочий набор
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на объект пользователя или nullptr
+     */
+    nlohmann::json* cachedUser(const QUuid& inUserUUID, ObjectCache& ioCache, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief cachedGroup - Метод вернёт объект группы из рабочего набора (при необходимости загрузит его)
+     * @param inGroupUUID - UUID группы
+     * @param ioCache - Рабочий набор
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на объект группы или nullptr
+     */
+    nlohmann::json* cachedGroup(const QUuid& inGroupUUID, ObjectCache& ioCache, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief commit - Метод атомарно запишет рабочий набор и дополнительные изменения в хранилище
+     * @param inCache - Рабочий набор
+     * @param ioBatch - Дополнительные изменения
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code commit(const ObjectCache& inCache, HMLsmWriteBatch& ioBatch);
+
+    /**
+     * @brief linkContacts - Метод свяжет пользователя с контактом в рабочем наборе (с обеих сторон)
+     * @param inUserUUID - Uuid пользователя
+     * @param inContactUUID - Uuid контакта
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code linkContacts(const QUuid& inUserUUID, const QUuid& inContactUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief unlinkContacts - Метод разорвёт связь пользователя с контактом в рабочем наборе (с обеих сторон)
+     * @param inUserUUID - Uuid пользователя
+     * @param inContactUUID - Uuid контакта
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code unlinkContacts(const QUuid& inUserUUID, const QUuid& inContactUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief unlinkAllContacts - Метод разорвёт все связи пользователя с контактами в рабочем наборе
+     * @param inUserUUID - Uuid пользователя
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code unlinkAllContacts(const QUuid& inUserUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief linkGroupUser - Метод добавит пользователя в группу в рабочем наборе
+     * @param inGroupUUID - Uuid группы
+     * @param inUserUUID - Uuid пользователя
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code linkGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief unlinkGroupUser - Метод удалит пользователя из группы в рабочем наборе
+     * @param inGroupUUID - Uuid группы
+     * @param inUserUUID - Uuid пользователя
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code unlinkGroupUser(const QUuid& inGroupUUID, const QUuid& inUserUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief unlinkAllGroupUsers - Метод удалит всех участников группы в рабочем наборе
+     * @param inGroupUUID - Uuid группы
+     * @param ioCache - Рабочий набор
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code unlinkAllGroupUsers(const QUuid& inGroupUUID, ObjectCache& ioCache) const;
+
+    /**
+     * @brief jsonToUser - Метод преобразует Json объект в экземпляр пользователя
+     * @param inUserObject - Объект Json содержащий пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр пользователя или nullptr
+     */
+    std::shared_ptr<hmcommon::HMUserInfo> jsonToUser(const nlohmann::json& inUserObject, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief userToJson - Метод преобразует пользователя в объект Json
+     * @param inUser - Указатель на пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт объект Json
+     */
+    nlohmann::json userToJson(std::shared_ptr<hmcommon::HMUserInfo> inUser, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief jsonToGroup - Метод преобразует Json объект в экземпляр группы
+     * @param inGroupObject - Объект Json содержащий группу
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр группы или nullptr
+     */
+    std::shared_ptr<hmcommon::HMGroupInfo> jsonToGroup(const nlohmann::json& inGroupObject, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief groupToJson - Метод преобразует группу в объект Json
+     * @param inGroup - Указатель на группу
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт объект Json
+     */
+    nlohmann::json groupToJson(std::shared_ptr<hmcommon::HMGroupInfo> inGroup, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief jsonToMessage - Метод преобразует Json объект в экземпляр сообщения
+     * @param inMessageObject - Объект Json содержащий сообщение
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр сообщения или nullptr
+     */
+    std::shared_ptr<hmcommon::HMGroupInfoMessage> jsonToMessage(const nlohmann::json& inMessageObject, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief decodeMessage - Метод преобразует двоичное представление (CBOR) в экземпляр сообщения
+     * @param inValue - Двоичное представление сообщения
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на экземпляр сообщения или nullptr
+     */
+    std::shared_ptr<hmcommon::HMGroupInfoMessage> decodeMessage(const std::string& inValue, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief messageToJson - Метод преобразует сообщение в объект Json
+     * @param inMessage - Указатель на сообщение
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт объект Json
+     */
+    nlohmann::json messageToJson(std::shared_ptr<hmcommon::HMGroupInfoMessage> inMessage, errors::error_code& outErrorCode) const;
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // LSMDATASTORAGE_H
@@ -0,0 +1,40 @@
+#ifndef LSMDATASTORAGECONST_H
+#define LSMDATASTORAGECONST_H
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+// Базовые параметры
+//-----------------------------------------------------------------------------
+static const std::string LSM_FORMAT_VESION          = "0.0.0.1";
+static const std::string LSM_SEGMENT_EXTENSION      = ".hmseg";     ///< Расширение файлов сегментов
+static const std::string LSM_WAL_EXTENSION          = ".hmwal";     ///< Расширение файлов журнала упреждающей записи
+static const std::string LSM_TMP_EXTENSION          = ".hmtmp";     ///< Расширение временных файлов (незавершённое уплотнение)
+//-----------------------------------------------------------------------------
+static constexpr std::uint32_t LSM_SEGMENT_MAGIC    = 0x484D5347;   ///< Сигнатура файла сегмента ("HMSG")
+static constexpr std::uint32_t LSM_SEGMENT_VERSION  = 2;            ///< Версия формата сегмента
+static constexpr std::uint32_t LSM_INDEX_STEP       = 16;           ///< Шаг разреженного индекса сегмента (записей)
+static constexpr std::uint32_t LSM_BLOOM_BITS_PER_KEY = 10;         ///< Количество бит фильтра Блума на ключ (~1% ложных срабатываний)
+static constexpr std::uint32_t LSM_BLOOM_HASH_COUNT = 7;            ///< Количество хеш функций фильтра Блума
+//-----------------------------------------------------------------------------
+static constexpr std::size_t LSM_DEFAULT_MEMTABLE_LIMIT = 4 * 1024 * 1024;  ///< Размер memtable (байт), при превышении которого она сбрасывается в сегмент
+static constexpr std::size_t LSM_DEFAULT_COMPACTION_TRIGGER = 4;            ///< Количество сегментов, при достижении которого запускается уплотнение
+static constexpr std::size_t LSM_MAX_IMMUTABLE_TABLES = 4;                  ///< Количество несброшенных memtable, при котором запись сбрасывает их сама
+static constexpr std::size_t LSM_MAX_GROUP_COMMIT_SIZE = 1024 * 1024;       ///< Объём кадров журнала (байт), объединяемых в одну запись на носитель
+static constexpr std::chrono::milliseconds LSM_MAINTENANCE_SLEEP(100);     ///< Период фонового потока сброса и уплотнения
+static constexpr std::chrono::milliseconds LSM_PAGE_WINDOW(60 * 60 * 1000); ///< Начальное окно поиска страницы сообщений "до курсора" (удваивается)
+static constexpr std::chrono::milliseconds LSM_PAGE_MAX_WINDOW(std::int64_t(1) << 42); ///< Окно, после которого страница ищется с начала ленты (~139 лет)
+//-----------------------------------------------------------------------------
+// Префиксы ключей хранилища
+//-----------------------------------------------------------------------------
+static const std::string LSM_KEY_VERSION            = "V";          ///< Версия формата хранилища
+static const std::string LSM_KEY_USER               = "U:";         ///< U:{UUID пользователя} -> объект пользователя
+static const std::string LSM_KEY_LOGIN              = "L:";         ///< L:{Логин} -> UUID пользователя
+static const std::string LSM_KEY_GROUP              = "G:";         ///< G:{UUID группы} -> объект группы
+static const std::string LSM_KEY_MESSAGE            = "M:";         ///< M:{UUID сообщения} -> ключ сообщения в ленте группы
+static const std::string LSM_KEY_TIMELINE           = "T:";         ///< T:{UUID группы}:{Время}:{UUID сообщения} -> объект сообщения
+//-----------------------------------------------------------------------------
+
+#endif // LSMDATASTORAGECONST_H
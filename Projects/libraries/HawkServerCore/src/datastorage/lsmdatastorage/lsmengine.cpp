@@ -0,0 +1,875 @@
+#include "lsmengine.h"
+
+#include <map>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <functional>
+
+#include <HawkLog.h>
+#include <systemerrorex.h>
+#include <datastorageerrorcategory.h>
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief parseSequence - Функция извлечёт порядковый номер из имени файла хранилища
+ * @param inPath - Путь к файлу
+ * @param outSequence - Порядковый номер
+ * @return Вернёт признак успеха операции
+ */
+static bool parseSequence(const std::filesystem::path& inPath, std::uint64_t& outSequence)
+{
+    const std::string Stem = inPath.stem().string();
+
+    if (Stem.empty() || !std::all_of(Stem.cbegin(), Stem.cend(), [](const char Char) { return Char >= '0' && Char <= '9'; }))
+        return false; // Посторонний файл
+
+    outSequence = std::stoull(Stem);
+    return true;
+}
+//-----------------------------------------------------------------------------
+void HMLsmWriteBatch::put(const std::string& inKey, const std::string& inValue)
+{ m_records.emplace_back(inKey, inValue); }
+//-----------------------------------------------------------------------------
+void HMLsmWriteBatch::remove(const std::string& inKey)
+{ m_records.emplace_back(inKey, std::nullopt); }
+//-----------------------------------------------------------------------------
+bool HMLsmWriteBatch::empty() const
+{ return m_records.empty(); }
+//-----------------------------------------------------------------------------
+const std::vector<std::pair<std::string, LsmValue>>& HMLsmWriteBatch::records() const
+{ return m_records; }
+//-----------------------------------------------------------------------------
+HMLsmEngine::HMLsmEngine(const std::filesystem::path& inDirPath, const std::size_t inMemTableLimit, const std::size_t inCompactionTrigger) :
+    HMNotCopyable(),
+    m_dirPath(inDirPath),
+    m_memTableLimit(inMemTableLimit),
+    m_compactionTrigger(std::max<std::size_t>(2, inCompactionTrigger)) // Уплотнять один сегмент нет смысла
+{
+
+}
+//-----------------------------------------------------------------------------
+HMLsmEngine::~HMLsmEngine()
+{
+    close();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::open()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    close();
+
+    if (std::filesystem::exists(m_dirPath, Error))
+    {
+        if (!Error && !std::filesystem::is_directory(m_dirPath, Error) && !Error)
+            Error = make_error_code(errors::eSystemErrorEx::seObjectNotDir); // Путь указывает не на директорию
+    }
+    else if (!Error) // Директории нет, создаём новое хранилище
+        std::filesystem::create_directories(m_dirPath, Error);
+
+    std::map<std::uint64_t, std::filesystem::path> SegmentFiles; // Файлы сегментов по порядковым номерам
+    std::map<std::uint64_t, std::filesystem::path> WalFiles; // Файлы журналов по порядковым номерам
+    std::vector<std::filesystem::path> ObsoletePaths; // Файлы сегментов, заменённых результатом уплотнения
+
+    if (!Error)
+    {
+        for (const auto& Entry : std::filesystem::directory_iterator(m_dirPath, Error))
+        {
+            std::uint64_t Sequence = 0;
+            const std::filesystem::path& FilePath = Entry.path();
+
+            if (FilePath.extension() == LSM_TMP_EXTENSION) // Остатки прерванного сброса или уплотнения
+            {
+                errors::error_code RemoveError;
+                std::filesystem::remove(FilePath, RemoveError);
+            }
+            else if (parseSequence(FilePath, Sequence))
+            {
+                if (FilePath.extension() == LSM_SEGMENT_EXTENSION)
+                    SegmentFiles.emplace(Sequence, FilePath);
+                else if (FilePath.extension() == LSM_WAL_EXTENSION)
+                    WalFiles.emplace(Sequence, FilePath);
+            }
+        }
+    }
+
+    if (!Error)
+    {
+        std::lock_guard wl(m_walDefender);
+        std::unique_lock ul(m_defender);
+
+        for (const auto& [Sequence, FilePath] : SegmentFiles) // Загружаем сегменты от старых к новым
+        {
+            std::shared_ptr<HMLsmSegment> Segment = HMLsmSegment::load(FilePath, Sequence, Error);
+
+            if (Error)
+                break;
+            else
+                m_segments.push_back(Segment);
+        }
+
+        if (!Error) // Отбрасываем сегменты, уже заменённые результатом уплотнения (сбой помешал удалить их файлы)
+        {
+            std::vector<std::shared_ptr<HMLsmSegment>> Actual;
+            std::uint64_t CoveredFrom = std::numeric_limits<std::uint64_t>::max();
+
+            for (auto It = m_segments.crbegin(); It != m_segments.crend(); ++It) // От новых к старым
+            {
+                if ((*It)->sequence() >= CoveredFrom)
+                    ObsoletePaths.push_back((*It)->path());
+                else
+                {
+                    Actual.insert(Actual.begin(), *It);
+                    CoveredFrom = std::min(CoveredFrom, (*It)->firstSequence());
+                }
+            }
+
+            m_segments = std::move(Actual); // Заодно закрываем файлы отброшенных сегментов
+        }
+
+        if (!Error)
+        {
+            const std::uint64_t LastSegment = (m_segments.empty()) ? 0 : m_segments.back()->sequence();
+            m_nextSequence = LastSegment + 1;
+
+            for (const auto& [Sequence, FilePath] : WalFiles) // Восстанавливаем не сброшенные изменения
+            {
+                m_nextSequence = std::max(m_nextSequence, Sequence + 1);
+
+                if (Sequence <= LastSegment) // Журнал уже сброшен в сегмент, но не успел удалиться
+                {
+                    errors::error_code RemoveError;
+                    std::filesystem::remove(FilePath, RemoveError);
+                }
+                else
+                {
+                    Error = replayWal(FilePath);
+
+                    if (Error)
+                        break;
+                    else
+                        m_memTableWals.push_back(Sequence);
+                }
+            }
+
+            if (!Error)
+                Error = openNewWal();
+        }
+
+        if (Error) // Сбрасываем частично загруженное состояние
+        {
+            m_segments.clear();
+            m_memTable.clear();
+            m_memTableWals.clear();
+            m_memTableSize = 0;
+        }
+        else
+            m_isOpen = true;
+    }
+
+    for (const auto& ObsoletePath : ObsoletePaths) // Файлы отброшены в любом случае и больше не нужны
+    {
+        errors::error_code RemoveError;
+        std::filesystem::remove(ObsoletePath, RemoveError);
+    }
+
+    if (!Error) // Запускаем фоновый поток сброса и уплотнения
+    {
+        m_threadControl.start();
+        m_maintenanceThread = std::thread(std::bind(&HMLsmEngine::maintenanceThreadFunc, this));
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmEngine::is_open() const
+{
+    std::shared_lock sl(m_defender);
+    return m_isOpen;
+}
+//-----------------------------------------------------------------------------
+void HMLsmEngine::close()
+{
+    stopMaintenanceThread(); // Дальнейшее обслуживание выполняем в текущем потоке
+    std::lock_guard wl(m_walDefender); // Группы записи больше не получат журнал
+
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    {
+        std::unique_lock ul(m_defender);
+
+        if (!m_isOpen)
+            return;
+
+        Error = rotateMemTable(false); // Текущая memtable так же должна попасть на диск
+    }
+
+    if (!Error)
+        Error = flushImmutables();
+
+    if (Error) // Не сброшенные данные останутся в журналах и будут восстановлены при следующем открытии
+        LOG_ERROR(Error.message_qstr());
+
+    std::unique_lock ul(m_defender);
+
+    if (m_memTable.empty()) // Журналы пустой memtable больше не нужны
+    {
+        for (const std::uint64_t Sequence : m_memTableWals)
+        {
+            errors::error_code RemoveError;
+            std::filesystem::remove(filePath(Sequence, LSM_WAL_EXTENSION), RemoveError);
+        }
+    }
+
+    if (m_wal.is_open())
+        m_wal.close();
+
+    m_memTable.clear();
+    m_memTableSize = 0;
+    m_memTableWals.clear();
+    m_immutables.clear();
+    m_segments.clear();
+    m_isOpen = false;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmEngine::empty() const
+{
+    std::shared_lock sl(m_defender);
+
+    return m_memTable.empty() && m_immutables.empty() &&
+            std::all_of(m_segments.cbegin(), m_segments.cend(), [](const std::shared_ptr<HMLsmSegment>& Segment)
+    { return Segment->recordsCount() == 0; });
+}
+//-----------------------------------------------------------------------------
+bool HMLsmEngine::get(const std::string& inKey, std::string& outValue, errors::error_code& outErrorCode) const
+{
+    bool Found = false; // Признак того, что ключ встретился (значение или метка удаления)
+    LsmValue Value;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    std::shared_lock sl(m_defender);
+
+    if (!m_isOpen)
+        outErrorCode = make_error_code(errors::eDataStorageError::dsNotOpen);
+    else
+    {
+        auto FindRes = m_memTable.find(inKey); // Сначала самые свежие данные
+
+        if (FindRes != m_memTable.end())
+        {
+            Found = true;
+            Value = FindRes->second;
+        }
+
+        for (auto It = m_immutables.crbegin(); !Found && It != m_immutables.crend(); ++It) // Затем неизменяемые memtable от новых к старым
+        {
+            auto TableFindRes = It->m_table->find(inKey);
+
+            if (TableFindRes != It->m_table->end())
+            {
+                Found = true;
+                Value = TableFindRes->second;
+            }
+        }
+
+        for (auto It = m_segments.crbegin(); !Found && !outErrorCode && It != m_segments.crend(); ++It) // И наконец сегменты от новых к старым
+            Found = (*It)->get(inKey, Value, outErrorCode);
+    }
+
+    if (Found && Value) // Метка удаления означает отсутствие значения
+        outValue = std::move(*Value);
+
+    return Found && Value && !outErrorCode;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::scan(const std::string& inFrom, const std::string& inTo, const LsmScanCallBackFn& inCallBack) const
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    std::vector<std::unique_ptr<HMLsmSegmentReader>> Readers;   // Читатели снимка сегментов (от старых к новым)
+    std::vector<std::shared_ptr<const LsmMemTable>> Tables;     // Снимок memtable (от старых к новым)
+
+    {
+        std::shared_lock sl(m_defender);
+
+        if (!m_isOpen)
+            Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+        else
+        {
+            // Файлы открываются под блокировкой: уплотнение заменяет и удаляет их только под уникальной блокировкой,
+            // а открытый дескриптор сохраняет доступ к прежнему файлу до конца сканирования
+            for (const auto& Segment : m_segments)
+                Readers.push_back(std::make_unique<HMLsmSegmentReader>(Segment));
+
+            for (const ImmutableTable& Table : m_immutables)
+                Tables.push_back(Table.m_table);
+
+            // Изменяемая memtable копируется только в пределах диапазона (не больше её лимита)
+            auto TableEnd = (inTo.empty()) ? m_memTable.end() : m_memTable.lower_bound(inTo);
+            Tables.push_back(std::make_shared<const LsmMemTable>(m_memTable.lower_bound(inFrom), TableEnd));
+        }
+    } // Слияние и обработчик выполняются без блокировки, обработчик может обращаться к хранилищу
+
+    std::vector<ScanSource> Sources; // Источники слияния в порядке возрастания свежести
+
+    for (auto It = Readers.begin(); !Error && It != Readers.end(); ++It)
+    {
+        ScanSource Source;
+        Source.m_reader = std::move(*It);
+        Error = Source.m_reader->seek(inFrom);
+        Sources.push_back(std::move(Source));
+    }
+
+    for (const auto& Table : Tables)
+    {
+        ScanSource Source;
+        Source.m_table = Table;
+        Source.m_it = Table->lower_bound(inFrom);
+        Sources.push_back(std::move(Source));
+    }
+
+    auto InRange = [&inTo](const ScanSource& inSource) { return inSource.valid() && (inTo.empty() || inSource.key() < inTo); };
+    bool Continue = true;
+
+    while (!Error && Continue)
+    {
+        const ScanSource* Newest = nullptr; // Источник с наименьшим ключом (при равных ключах - самый свежий)
+
+        for (const ScanSource& Source : Sources)
+            if (InRange(Source) && (!Newest || !(Newest->key() < Source.key())))
+                Newest = &Source;
+
+        if (!Newest) // Диапазон исчерпан
+            break;
+
+        const std::string Key = Newest->key();
+        const LsmValue Value = Newest->value();
+
+        for (auto It = Sources.begin(); !Error && It != Sources.end(); ++It) // Пропускаем устаревшие версии ключа
+            if (It->valid() && It->key() == Key)
+                Error = It->next();
+
+        if (!Error && Value) // Метки удаления пропускаем
+            Continue = inCallBack(Key, Value);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::write(const HMLsmWriteBatch& inBatch)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (inBatch.empty())
+        return Error;
+
+    // Формируем кадр журнала {размер}{контрольная сумма}{количество записей}{записи} до захвата блокировки
+    std::string Payload;
+    appendU32(Payload, static_cast<std::uint32_t>(inBatch.records().size()));
+    for (const auto& [Key, Value] : inBatch.records())
+        appendRecord(Payload, Key, Value);
+
+    std::string Frame;
+    Frame.reserve(Payload.size() + 2 * sizeof(std::uint32_t));
+    appendU32(Frame, static_cast<std::uint32_t>(Payload.size()));
+    appendU32(Frame, checksum(Payload.data(), Payload.size()));
+    Frame.append(Payload);
+
+    PendingWrite Pending;
+    Pending.m_batch = &inBatch;
+    Pending.m_frame = &Frame;
+
+    std::unique_lock WritersLock(m_writersDefender);
+    m_writers.push_back(&Pending);
+
+    // Ждём, пока набор запишет лидер чужой группы, или пока сами не станем лидером
+    Pending.m_condition.wait(WritersLock, [this, &Pending]() { return Pending.m_done || m_writers.front() == &Pending; });
+
+    if (Pending.m_done)
+        return Pending.m_error;
+
+    std::vector<PendingWrite*> Group; // Лидер забирает все ожидающие наборы в пределах ограничения объёма
+    std::size_t GroupSize = 0;
+
+    for (PendingWrite* Writer : m_writers)
+    {
+        if (!Group.empty() && GroupSize + Writer->m_frame->size() > LSM_MAX_GROUP_COMMIT_SIZE)
+            break;
+
+        Group.push_back(Writer);
+        GroupSize += Writer->m_frame->size();
+    }
+
+    WritersLock.unlock(); // Пока группа пишется, в очередь встают наборы следующей
+
+    bool NeedFlush = false;
+    Error = commitGroup(Group, NeedFlush);
+
+    WritersLock.lock();
+
+    for (PendingWrite* Writer : Group) // Будим только участников группы, а не всю очередь
+    {
+        m_writers.pop_front();
+        Writer->m_error = Error;
+        Writer->m_done = true;
+        Writer->m_condition.notify_one();
+    }
+
+    if (!m_writers.empty()) // Будим лидера следующей группы
+        m_writers.front()->m_condition.notify_one();
+
+    WritersLock.unlock();
+
+    if (NeedFlush) // Притормаживаем запись, сбрасывая memtable в текущем потоке
+    {
+        errors::error_code FlushError = flushImmutables();
+        if (FlushError) // Данные уже в журнале, запись считается успешной
+            LOG_WARNING(FlushError.message_qstr());
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::commitGroup(const std::vector<PendingWrite*>& inGroup, bool& outNeedFlush)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    outNeedFlush = false;
+
+    std::string GroupFrames; // Кадры группы подряд: при восстановлении журнал читается по кадрам
+    if (inGroup.size() > 1)
+    {
+        std::size_t GroupSize = 0;
+        for (const PendingWrite* Writer : inGroup)
+            GroupSize += Writer->m_frame->size();
+
+        GroupFrames.reserve(GroupSize);
+        for (const PendingWrite* Writer : inGroup)
+            GroupFrames.append(*Writer->m_frame);
+    }
+
+    std::lock_guard wl(m_walDefender); // Журнал не сменится и не закроется, пока группа пишется
+
+    {
+        std::shared_lock sl(m_defender);
+
+        if (!m_isOpen)
+            Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+    }
+
+    if (!Error) // Единственная синхронизация на всю группу, чтение хранилища её не ждёт
+        Error = m_wal.append((inGroup.size() > 1) ? GroupFrames : *inGroup.front()->m_frame);
+
+    if (!Error)
+    {
+        std::unique_lock ul(m_defender);
+
+        for (const PendingWrite* Writer : inGroup) // Наборы применяются в порядке записи в журнал
+        {
+            for (const auto& [Key, Value] : Writer->m_batch->records())
+            {
+                m_memTableSize += recordSize(Key, Value);
+                m_memTable[Key] = Value;
+            }
+        }
+
+        if (m_memTableSize >= m_memTableLimit) // memtable переполнена
+            Error = rotateMemTable(true);
+
+        outNeedFlush = m_immutables.size() >= LSM_MAX_IMMUTABLE_TABLES; // Фоновый поток не успевает
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::compact()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    {
+        std::lock_guard wl(m_walDefender);
+        std::unique_lock ul(m_defender);
+
+        if (!m_isOpen)
+            Error = make_error_code(errors::eDataStorageError::dsNotOpen);
+        else
+            Error = rotateMemTable(true);
+    }
+
+    if (!Error)
+        Error = flushImmutables();
+
+    if (!Error)
+        Error = compactSegments(true);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+std::size_t HMLsmEngine::segmentsCount() const
+{
+    std::shared_lock sl(m_defender);
+    return m_segments.size();
+}
+//-----------------------------------------------------------------------------
+std::filesystem::path HMLsmEngine::filePath(const std::uint64_t inSequence, const std::string& inExtension) const
+{
+    std::ostringstream Name;
+    Name << std::setw(20) << std::setfill('0') << inSequence << inExtension; // Имена сортируются так же как номера
+
+    return m_dirPath / Name.str();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::replayWal(const std::filesystem::path& inPath)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    std::ifstream WalFile(inPath, std::ios_base::in | std::ios_base::binary);
+
+    if (!WalFile.is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else
+    {
+        std::uint32_t FrameSize = 0;
+        std::uint32_t FrameChecksum = 0;
+
+        while (readU32(WalFile, FrameSize) && readU32(WalFile, FrameChecksum))
+        {
+            std::string Payload(FrameSize, '\0');
+
+            if (!WalFile.read(Payload.data(), FrameSize) || checksum(Payload.data(), Payload.size()) != FrameChecksum)
+            {   // Оборванный хвост журнала: набор изменений не был записан полностью и не применяется
+                LOG_WARNING(QString::fromStdString("Incomplete WAL frame dropped: " + inPath.string()));
+                break;
+            }
+
+            std::istringstream PayloadStream(Payload);
+            std::uint32_t Count = 0;
+            std::string Key;
+            LsmValue Value;
+
+            if (!readU32(PayloadStream, Count))
+                Error = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+
+            for (std::uint32_t Index = 0; !Error && Index < Count; ++Index)
+            {
+                if (!readRecord(PayloadStream, Key, Value))
+                    Error = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+                else
+                {
+                    m_memTableSize += recordSize(Key, Value);
+                    m_memTable[Key] = Value;
+                }
+            }
+
+            if (Error)
+                break;
+        }
+
+        WalFile.close();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::openNewWal()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    m_walSequence = m_nextSequence++;
+    Error = m_wal.open(filePath(m_walSequence, LSM_WAL_EXTENSION));
+
+    if (!Error) // Иначе после сбоя может пропасть сам файл журнала вместе с подтверждёнными изменениями
+        Error = syncDirectory(m_dirPath);
+
+    if (!Error)
+        m_memTableWals.push_back(m_walSequence);
+    else
+        m_wal.close();
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::rotateMemTable(const bool inOpenNewWal)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!m_memTable.empty()) // Пустую memtable сбрасывать нет смысла
+    {
+        if (m_wal.is_open())
+            m_wal.close();
+
+        ImmutableTable Table;
+        Table.m_sequence = m_walSequence; // Номер сегмента совпадает с номером последнего журнала memtable
+        Table.m_table = std::make_shared<const LsmMemTable>(std::move(m_memTable));
+        Table.m_walSequences = std::move(m_memTableWals);
+
+        m_immutables.push_back(std::move(Table));
+
+        m_memTable = LsmMemTable();
+        m_memTableWals.clear();
+        m_memTableSize = 0;
+
+        if (inOpenNewWal)
+            Error = openNewWal();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::flushImmutables()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    std::lock_guard lg(m_maintenanceDefender);
+
+    while (!Error)
+    {
+        ImmutableTable Table;
+
+        {
+            std::shared_lock sl(m_defender);
+
+            if (m_immutables.empty())
+                break; // Всё сброшено
+
+            Table = m_immutables.front(); // Самая старая memtable сбрасывается первой
+        }
+
+        const std::filesystem::path TmpPath = filePath(Table.m_sequence, LSM_TMP_EXTENSION);
+        const std::filesystem::path SegmentPath = filePath(Table.m_sequence, LSM_SEGMENT_EXTENSION);
+
+        {
+            HMLsmSegmentWriter Writer(TmpPath, Table.m_table->size(), Table.m_sequence);
+
+            for (const auto& [Key, Value] : *Table.m_table) // Метки удаления сохраняются: они перекрывают более старые сегменты
+            {
+                Error = Writer.add(Key, Value);
+                if (Error)
+                    break;
+            }
+
+            if (!Error)
+                Error = Writer.finish();
+        }
+
+        if (!Error) // Сегмент появляется под своим именем только полностью записанным
+            std::filesystem::rename(TmpPath, SegmentPath, Error);
+
+        if (!Error) // Журналы удаляются только после того, как сегмент окажется на носителе под своим именем
+            Error = syncDirectory(m_dirPath);
+
+        std::shared_ptr<HMLsmSegment> Segment = nullptr;
+        if (!Error)
+            Segment = HMLsmSegment::load(SegmentPath, Table.m_sequence, Error);
+
+        if (Error)
+        {
+            errors::error_code RemoveError;
+            std::filesystem::remove(TmpPath, RemoveError);
+        }
+        else
+        {
+            {
+                std::unique_lock ul(m_defender);
+                m_segments.push_back(Segment);
+                m_immutables.pop_front();
+            }
+
+            for (const std::uint64_t Sequence : Table.m_walSequences) // Журналы сброшенной memtable больше не нужны
+            {
+                errors::error_code RemoveError;
+                std::filesystem::remove(filePath(Sequence, LSM_WAL_EXTENSION), RemoveError);
+
+                if (RemoveError)
+                    LOG_WARNING(RemoveError.message_qstr());
+            }
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::compactSegments(const bool inForce)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    std::lock_guard lg(m_maintenanceDefender);
+
+    std::vector<std::shared_ptr<HMLsmSegment>> Inputs; // Уплотняемые сегменты (от старых к новым)
+
+    {
+        std::shared_lock sl(m_defender);
+        Inputs = m_segments;
+    }
+
+    if (Inputs.empty() || (!inForce && Inputs.size() < m_compactionTrigger))
+        return Error;
+
+    // Результат занимает номер самого нового из уплотняемых сегментов и заменяет все сегменты, начиная с самого старого
+    const std::uint64_t Sequence = Inputs.back()->sequence();
+    const std::uint64_t FirstSequence = Inputs.front()->firstSequence();
+    const std::filesystem::path TmpPath = filePath(Sequence, LSM_TMP_EXTENSION);
+
+    std::uint64_t ExpectedCount = 0;
+    std::vector<std::unique_ptr<HMLsmSegmentReader>> Readers;
+
+    for (const auto& Segment : Inputs)
+    {
+        ExpectedCount += Segment->recordsCount();
+        Readers.push_back(std::make_unique<HMLsmSegmentReader>(Segment));
+
+        Error = Readers.back()->seek("");
+        if (Error)
+            break;
+    }
+
+    if (!Error)
+    {
+        HMLsmSegmentWriter Writer(TmpPath, ExpectedCount, FirstSequence);
+
+        while (!Error) // K-путевое слияние отсортированных сегментов
+        {
+            const std::string* MinKey = nullptr;
+
+            for (const auto& Reader : Readers)
+                if (Reader->valid() && (!MinKey || Reader->key() < *MinKey))
+                    MinKey = &Reader->key();
+
+            if (!MinKey) // Все сегменты прочитаны
+                break;
+
+            const std::string Key = *MinKey;
+            LsmValue Value;
+
+            for (const auto& Reader : Readers) // От старых к новым: побеждает значение из самого нового сегмента
+            {
+                if (Reader->valid() && Reader->key() == Key)
+                {
+                    Value = Reader->value();
+                    Error = Reader->next();
+
+                    if (Error)
+                        break;
+                }
+            }
+
+            // Уплотняются все сегменты, а файлы заменённых, не удалённые из-за сбоя, отбрасываются при открытии,
+            // поэтому метки удаления больше ничего не перекрывают
+            if (!Error && Value)
+                Error = Writer.add(Key, Value);
+        }
+
+        if (!Error)
+            Error = Writer.finish();
+    }
+
+    Readers.clear(); // Закрываем файлы уплотняемых сегментов
+
+    std::vector<std::filesystem::path> ObsoletePaths; // Файлы сегментов, заменённых результатом
+
+    if (!Error)
+    {
+        std::unique_lock ul(m_defender);
+
+        std::filesystem::rename(TmpPath, filePath(Sequence, LSM_SEGMENT_EXTENSION), Error); // Подменяем самый новый из уплотнённых сегментов
+
+        std::shared_ptr<HMLsmSegment> Merged = nullptr;
+        if (!Error)
+            Merged = HMLsmSegment::load(filePath(Sequence, LSM_SEGMENT_EXTENSION), Sequence, Error);
+
+        if (!Error)
+        {   // Сегменты добавляются только в конец, поэтому уплотнённые по прежнему занимают начало списка
+            m_segments.erase(m_segments.begin(), m_segments.begin() + static_cast<std::ptrdiff_t>(Inputs.size()));
+            m_segments.insert(m_segments.begin(), Merged);
+
+            for (auto It = Inputs.cbegin(); It + 1 < Inputs.cend(); ++It) // Файл самого нового уже заменён результатом
+                ObsoletePaths.push_back((*It)->path());
+        }
+    }
+
+    // Закрываем файлы устаревших сегментов без блокировки: освобождение места заменённого файла может быть долгим
+    Inputs.clear();
+
+    if (!Error) // Заменённые сегменты удаляются только после того, как результат окажется на носителе под своим именем
+        Error = syncDirectory(m_dirPath);
+
+    for (auto It = ObsoletePaths.cbegin(); !Error && It != ObsoletePaths.cend(); ++It)
+    {
+        errors::error_code RemoveError;
+        std::filesystem::remove(*It, RemoveError);
+
+        if (RemoveError)
+            LOG_WARNING(RemoveError.message_qstr());
+    }
+
+    if (Error)
+    {
+        errors::error_code RemoveError;
+        std::filesystem::remove(TmpPath, RemoveError);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+void HMLsmEngine::maintenanceThreadFunc()
+{
+    LOG_DEBUG("LSM maintenanceThreadFunc Started");
+
+    while (m_threadControl.doWork())
+    {
+        errors::error_code Error = flushImmutables(); // Сбрасываем переполненные memtable
+
+        if (Error)
+            LOG_ERROR(Error.message_qstr());
+        else
+        {
+            Error = compactSegments(false); // Уплотняем сегменты, если их накопилось слишком много
+
+            if (Error)
+                LOG_ERROR(Error.message_qstr());
+        }
+
+        m_threadControl.wait_for(LSM_MAINTENANCE_SLEEP);
+    }
+
+    LOG_DEBUG("LSM maintenanceThreadFunc Finished");
+}
+//-----------------------------------------------------------------------------
+void HMLsmEngine::stopMaintenanceThread()
+{
+    if (m_threadControl.doWork())
+    {
+        m_threadControl.stop();
+
+        if (m_maintenanceThread.joinable())
+            m_maintenanceThread.join(); // Ожидаем завершения потока
+    }
+}
+//-----------------------------------------------------------------------------
+bool HMLsmEngine::ScanSource::valid() const
+{
+    return (m_reader) ? m_reader->valid() : m_it != m_table->end();
+}
+//-----------------------------------------------------------------------------
+const std::string& HMLsmEngine::ScanSource::key() const
+{
+    return (m_reader) ? m_reader->key() : m_it->first;
+}
+//-----------------------------------------------------------------------------
+const LsmValue& HMLsmEngine::ScanSource::value() const
+{
+    return (m_reader) ? m_reader->value() : m_it->second;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmEngine::ScanSource::next()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (m_reader)
+        Error = m_reader->next();
+    else
+        ++m_it;
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
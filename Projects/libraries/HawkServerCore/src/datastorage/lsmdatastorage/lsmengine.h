@@ -0,0 +1,307 @@
+#ifndef HMLSMENGINE_H
+#define HMLSMENGINE_H
+
+/**
+ * @file lsmengine.h
+ * @brief Содержит описание встраиваемого журнально-структурированного (LSM) хранилища ключ-значение
+ */
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <shared_mutex>
+#include <condition_variable>
+
+#include <threadwaitcontrol.h>
+
+#include "lsmfile.h"
+#include "lsmsegment.h"
+#include "lsmdatastorageconst.h"
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmWriteBatch class - Класс, описывающий набор изменений, применяемых атомарно
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmWriteBatch
+{
+public:
+
+    /**
+     * @brief HMLsmWriteBatch - Конструктор по умолчанию
+     */
+    HMLsmWriteBatch() = default;
+
+    /**
+     * @brief put - Метод добавит в набор запись значения
+     * @param inKey - Ключ
+     * @param inValue - Значение
+     */
+    void put(const std::string& inKey, const std::string& inValue);
+
+    /**
+     * @brief remove - Метод добавит в набор метку удаления
+     * @param inKey - Ключ
+     */
+    void remove(const std::string& inKey);
+
+    /**
+     * @brief empty - Метод вернёт признак пустого набора
+     * @return Вернёт признак пустого набора
+     */
+    bool empty() const;
+
+    /**
+     * @brief records - Метод вернёт записи набора в порядке добавления
+     * @return Вернёт записи набора
+     */
+    const std::vector<std::pair<std::string, LsmValue>>& records() const;
+
+private:
+
+    std::vector<std::pair<std::string, LsmValue>> m_records; ///< Записи набора
+
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmEngine class - Класс, описывающий встраиваемое LSM хранилище ключ-значение
+ * Запись: журнал упреждающей записи (WAL) + отсортированная таблица в памяти (memtable).
+ * При переполнении memtable становится неизменяемой и фоновым потоком сбрасывается в сегмент на диске.
+ * Фоновый поток так же уплотняет сегменты, когда их становится слишком много.
+ * Журнал и сегменты записываются на носитель до подтверждения записи и публикации сегмента, поэтому
+ * сбой в любой момент не теряет подтверждённых изменений и не возвращает удалённых.
+ * Чтение: memtable -> неизменяемые memtable -> сегменты (от новых к старым, с фильтром Блума).
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmEngine : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMLsmEngine - Инициализирующий конструктор
+     * @param inDirPath - Путь к директории хранилища
+     * @param inMemTableLimit - Размер memtable (байт), при превышении которого она сбрасывается в сегмент
+     * @param inCompactionTrigger - Количество сегментов, при достижении которого запускается уплотнение
+     */
+    HMLsmEngine(const std::filesystem::path& inDirPath,
+                const std::size_t inMemTableLimit = LSM_DEFAULT_MEMTABLE_LIMIT,
+                const std::size_t inCompactionTrigger = LSM_DEFAULT_COMPACTION_TRIGGER);
+
+    /**
+     * @brief ~HMLsmEngine - Виртуальный деструктор
+     */
+    virtual ~HMLsmEngine() override;
+
+    /**
+     * @brief open - Метод откроет хранилище (загрузит сегменты и восстановит memtable из журнала)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code open();
+
+    /**
+     * @brief is_open - Метод вернёт признак открытости хранилища
+     * @return Вернёт признак открытости
+     */
+    bool is_open() const;
+
+    /**
+     * @brief close - Метод сбросит все данные в сегменты и закроет хранилище
+     */
+    void close();
+
+    /**
+     * @brief empty - Метод вернёт признак отсутствия каких либо данных в хранилище
+     * @return Вернёт признак пустого хранилища
+     */
+    bool empty() const;
+
+    /**
+     * @brief get - Метод найдёт значение по ключу
+     * @param inKey - Ключ
+     * @param outValue - Найденное значение
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт признак наличия значения
+     */
+    bool get(const std::string& inKey, std::string& outValue, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief scan - Метод переберёт актуальные записи с ключами из диапазона [inFrom, inTo) по возрастанию ключа
+     * Источники сливаются потоково, поэтому прерванный обработчиком перебор не читает оставшуюся часть диапазона
+     * @param inFrom - Начало диапазона (включительно)
+     * @param inTo - Конец диапазона (исключительно)
+     * @param inCallBack - Обработчик записи (вернёт false для прекращения перебора)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code scan(const std::string& inFrom, const std::string& inTo, const LsmScanCallBackFn& inCallBack) const;
+
+    /**
+     * @brief write - Метод атомарно применит набор изменений (одна запись в журнал на весь набор)
+     * Одновременные вызовы объединяются: наборы, ожидающие своей очереди, записываются на носитель одной синхронизацией
+     * @param inBatch - Набор изменений
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code write(const HMLsmWriteBatch& inBatch);
+
+    /**
+     * @brief compact - Метод синхронно сбросит memtable и уплотнит все сегменты в один
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code compact();
+
+    /**
+     * @brief segmentsCount - Метод вернёт количество сегментов на диске
+     * @return Вернёт количество сегментов
+     */
+    std::size_t segmentsCount() const;
+
+private:
+
+    /**
+     * @brief The ImmutableTable struct - Неизменяемая memtable, ожидающая сброса на диск
+     */
+    struct ImmutableTable
+    {
+        std::uint64_t m_sequence = 0;                   ///< Порядковый номер будущего сегмента
+        std::shared_ptr<const LsmMemTable> m_table;     ///< Данные
+        std::vector<std::uint64_t> m_walSequences;      ///< Журналы, которые можно удалить после сброса
+    };
+
+    /**
+     * @brief The PendingWrite struct - Набор изменений, ожидающий записи в журнал
+     */
+    struct PendingWrite
+    {
+        const HMLsmWriteBatch* m_batch = nullptr;       ///< Набор изменений
+        const std::string* m_frame = nullptr;           ///< Кадр журнала набора
+        errors::error_code m_error;                     ///< Результат записи
+        bool m_done = false;                            ///< Признак завершения записи лидером группы
+        std::condition_variable m_condition;            ///< Условие завершения записи или получения лидерства
+    };
+
+    /**
+     * @brief The ScanSource struct - Источник слияния при сканировании (сегмент или memtable)
+     */
+    struct ScanSource
+    {
+        std::unique_ptr<HMLsmSegmentReader> m_reader;   ///< Читатель сегмента (nullptr для memtable)
+        std::shared_ptr<const LsmMemTable> m_table;     ///< Memtable, удерживаемая на время сканирования
+        LsmMemTable::const_iterator m_it;               ///< Текущая запись memtable
+
+        /**
+         * @brief valid - Метод вернёт признак наличия текущей записи
+         * @return Вернёт признак наличия текущей записи
+         */
+        bool valid() const;
+
+        /**
+         * @brief key - Метод вернёт ключ текущей записи
+         * @return Вернёт ключ текущей записи
+         */
+        const std::string& key() const;
+
+        /**
+         * @brief value - Метод вернёт значение текущей записи
+         * @return Вернёт значение текущей записи
+         */
+        const LsmValue& value() const;
+
+        /**
+         * @brief next - Метод перейдёт к следующей записи
+         * @return Вернёт признак ошибки
+         */
+        errors::error_code next();
+    };
+
+    const std::filesystem::path m_dirPath;              ///< Путь к директории хранилища
+    const std::size_t m_memTableLimit;                  ///< Размер memtable, при превышении которого она сбрасывается
+    const std::size_t m_compactionTrigger;              ///< Количество сегментов, при достижении которого запускается уплотнение
+
+    mutable std::shared_mutex m_defender;               ///< Мьютекс, защищающий состояние хранилища
+    bool m_isOpen = false;                              ///< Признак открытости хранилища
+    LsmMemTable m_memTable;                             ///< Изменяемая memtable
+    std::size_t m_memTableSize = 0;                     ///< Приблизительный размер memtable (байт)
+    std::vector<std::uint64_t> m_memTableWals;          ///< Журналы, покрывающие изменяемую memtable
+    std::deque<ImmutableTable> m_immutables;            ///< Неизменяемые memtable (от старых к новым)
+    std::vector<std::shared_ptr<HMLsmSegment>> m_segments; ///< Сегменты (от старых к новым)
+    std::mutex m_walDefender;                           ///< Мьютекс, защищающий журнал (захватывается до m_defender)
+    HMLsmWalFile m_wal;                                 ///< Текущий журнал упреждающей записи
+    std::uint64_t m_walSequence = 0;                    ///< Порядковый номер текущего журнала
+    std::uint64_t m_nextSequence = 1;                   ///< Следующий свободный порядковый номер
+
+    std::mutex m_writersDefender;                       ///< Мьютекс, защищающий очередь записи
+    std::deque<PendingWrite*> m_writers;                ///< Очередь записи (первый - лидер текущей группы)
+
+    std::mutex m_maintenanceDefender;                   ///< Мьютекс, упорядочивающий сброс и уплотнение
+    hmcommon::HMThreadWaitControl m_threadControl;      ///< Контролёр фонового потока
+    std::thread m_maintenanceThread;                    ///< Фоновый поток сброса и уплотнения
+
+    /**
+     * @brief filePath - Метод сформирует путь к файлу хранилища
+     * @param inSequence - Порядковый номер
+     * @param inExtension - Расширение файла
+     * @return Вернёт путь к файлу
+     */
+    std::filesystem::path filePath(const std::uint64_t inSequence, const std::string& inExtension) const;
+
+    /**
+     * @brief replayWal - Метод восстановит изменения из журнала в memtable
+     * @param inPath - Путь к журналу
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code replayWal(const std::filesystem::path& inPath);
+
+    /**
+     * @brief commitGroup - Метод запишет группу наборов изменений в журнал одной синхронизацией и применит их к memtable
+     * @param inGroup - Группа наборов изменений (в порядке очереди)
+     * @param outNeedFlush - Признак необходимости сбросить неизменяемые memtable
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code commitGroup(const std::vector<PendingWrite*>& inGroup, bool& outNeedFlush);
+
+    /**
+     * @brief openNewWal - Метод откроет новый журнал (вызывается под m_defender)
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code openNewWal();
+
+    /**
+     * @brief rotateMemTable - Метод сделает текущую memtable неизменяемой (вызывается под m_defender)
+     * @param inOpenNewWal - Признак необходимости открыть новый журнал
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code rotateMemTable(const bool inOpenNewWal);
+
+    /**
+     * @brief flushImmutables - Метод сбросит все неизменяемые memtable в сегменты
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code flushImmutables();
+
+    /**
+     * @brief compactSegments - Метод уплотнит все сегменты в один
+     * @param inForce - Признак уплотнения вне зависимости от количества сегментов
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code compactSegments(const bool inForce);
+
+    /**
+     * @brief maintenanceThreadFunc - Функция фонового потока сброса и уплотнения
+     */
+    void maintenanceThreadFunc();
+
+    /**
+     * @brief stopMaintenanceThread - Метод остановит фоновый поток
+     */
+    void stopMaintenanceThread();
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMLSMENGINE_H
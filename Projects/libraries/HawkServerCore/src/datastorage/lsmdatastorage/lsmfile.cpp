@@ -0,0 +1,173 @@
+#include "lsmfile.h"
+
+#include <cerrno>
+
+#include <QtGlobal>
+
+#if defined(Q_OS_WIN) // Определения для WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else // Определения для POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <systemerrorex.h>
+#include <datastorageerrorcategory.h>
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+/**
+ * @brief syncDescriptor - Функция дождётся записи на носитель данных открытого файла
+ * @param inDescriptor - Дескриптор файла
+ * @return Вернёт признак успеха операции
+ */
+static bool syncDescriptor(const int inDescriptor)
+{
+#if defined(Q_OS_WIN)
+    return _commit(inDescriptor) == 0;
+#else
+    return ::fsync(inDescriptor) == 0;
+#endif
+}
+//-----------------------------------------------------------------------------
+errors::error_code hmservcommon::datastorage::syncFile(const std::filesystem::path& inPath)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+#if defined(Q_OS_WIN)
+    const int Descriptor = _wopen(inPath.c_str(), _O_RDWR | _O_BINARY); // _commit требует права на запись
+#else
+    const int Descriptor = ::open(inPath.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+
+    if (Descriptor < 0)
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else
+    {
+        if (!syncDescriptor(Descriptor))
+            Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+
+#if defined(Q_OS_WIN)
+        _close(Descriptor);
+#else
+        ::close(Descriptor);
+#endif
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code hmservcommon::datastorage::syncDirectory(const std::filesystem::path& inPath)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+#if defined(Q_OS_WIN)
+    Q_UNUSED(inPath); // Изменения директории NTFS записывает в собственный журнал, синхронизировать нечего
+#else
+    const int Descriptor = ::open(inPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (Descriptor < 0)
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else
+    {
+        if (!syncDescriptor(Descriptor))
+            Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+
+        ::close(Descriptor);
+    }
+#endif
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+HMLsmWalFile::~HMLsmWalFile()
+{
+    close();
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmWalFile::open(const std::filesystem::path& inPath)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    close();
+
+#if defined(Q_OS_WIN)
+    m_descriptor = _wopen(inPath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    m_descriptor = ::open(inPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+
+    if (m_descriptor < 0)
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+
+    m_size = 0;
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmWalFile::is_open() const
+{
+    return m_descriptor >= 0;
+}
+//-----------------------------------------------------------------------------
+void HMLsmWalFile::close()
+{
+    if (is_open())
+    {
+#if defined(Q_OS_WIN)
+        _close(m_descriptor);
+#else
+        ::close(m_descriptor);
+#endif
+        m_descriptor = -1;
+    }
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmWalFile::append(const std::string& inData)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seFileNotOpen);
+    else
+    {
+        std::size_t Written = 0;
+
+        while (!Error && Written < inData.size()) // Запись может пройти частично
+        {
+#if defined(Q_OS_WIN)
+            const int Result = _write(m_descriptor, inData.data() + Written, static_cast<unsigned int>(inData.size() - Written));
+#else
+            const ssize_t Result = ::write(m_descriptor, inData.data() + Written, inData.size() - Written);
+
+            if (Result < 0 && errno == EINTR) // Прервано сигналом, повторяем
+                continue;
+#endif
+            if (Result <= 0)
+                Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+            else
+                Written += static_cast<std::size_t>(Result);
+        }
+
+        if (!Error && !syncDescriptor(m_descriptor))
+            Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+
+        if (!Error)
+            m_size += inData.size();
+        else // Отрезаем частично записанные данные, иначе следующие порции окажутся за повреждённым кадром
+        {
+#if defined(Q_OS_WIN)
+            _chsize_s(m_descriptor, static_cast<__int64>(m_size));
+            _lseeki64(m_descriptor, static_cast<__int64>(m_size), SEEK_SET);
+#else
+            if (::ftruncate(m_descriptor, static_cast<off_t>(m_size)) == 0)
+                ::lseek(m_descriptor, static_cast<off_t>(m_size), SEEK_SET);
+#endif
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
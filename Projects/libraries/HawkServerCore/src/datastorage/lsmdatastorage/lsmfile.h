@@ -0,0 +1,88 @@
+#ifndef HMLSMFILE_H
+#define HMLSMFILE_H
+
+/**
+ * @file lsmfile.h
+ * @brief Содержит описание функций надёжной записи файлов LSM хранилища
+ */
+
+#include <string>
+#include <cstdint>
+#include <filesystem>
+
+#include <errorcode.h>
+#include <notcopyable.h>
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief syncFile - Функция дождётся записи содержимого файла на носитель
+ * @param inPath - Путь к файлу
+ * @return Вернёт признак ошибки
+ */
+errors::error_code syncFile(const std::filesystem::path& inPath);
+//-----------------------------------------------------------------------------
+/**
+ * @brief syncDirectory - Функция дождётся записи на носитель содержимого директории (созданных, переименованных и удалённых файлов)
+ * @param inPath - Путь к директории
+ * @return Вернёт признак ошибки
+ */
+errors::error_code syncDirectory(const std::filesystem::path& inPath);
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmWalFile class - Класс файла журнала упреждающей записи
+ * Каждая дописанная порция данных записывается на носитель до возврата из append
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmWalFile : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMLsmWalFile - Конструктор по умолчанию
+     */
+    HMLsmWalFile() = default;
+
+    /**
+     * @brief ~HMLsmWalFile - Виртуальный деструктор
+     */
+    virtual ~HMLsmWalFile() override;
+
+    /**
+     * @brief open - Метод создаст пустой файл журнала
+     * @param inPath - Путь к файлу
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code open(const std::filesystem::path& inPath);
+
+    /**
+     * @brief is_open - Метод вернёт признак открытого файла
+     * @return Вернёт признак открытого файла
+     */
+    bool is_open() const;
+
+    /**
+     * @brief close - Метод закроет файл
+     */
+    void close();
+
+    /**
+     * @brief append - Метод допишет данные в конец файла и дождётся их записи на носитель
+     * @param inData - Данные
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code append(const std::string& inData);
+
+private:
+
+    int m_descriptor = -1;      ///< Дескриптор файла
+    std::uint64_t m_size = 0;   ///< Размер записанных на носитель данных
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMLSMFILE_H
@@ -0,0 +1,109 @@
+#include "lsmrecord.h"
+
+using namespace hmservcommon::datastorage;
+
+//-----------------------------------------------------------------------------
+void hmservcommon::datastorage::appendU32(std::string& outBuffer, const std::uint32_t inValue)
+{
+    for (std::size_t Byte = 0; Byte < sizeof(inValue); ++Byte)
+        outBuffer.push_back(static_cast<char>((inValue >> (Byte * 8)) & 0xFF));
+}
+//-----------------------------------------------------------------------------
+void hmservcommon::datastorage::appendU64(std::string& outBuffer, const std::uint64_t inValue)
+{
+    for (std::size_t Byte = 0; Byte < sizeof(inValue); ++Byte)
+        outBuffer.push_back(static_cast<char>((inValue >> (Byte * 8)) & 0xFF));
+}
+//-----------------------------------------------------------------------------
+bool hmservcommon::datastorage::readU32(std::istream& inStream, std::uint32_t& outValue)
+{
+    unsigned char Buffer[sizeof(std::uint32_t)];
+
+    if (!inStream.read(reinterpret_cast<char*>(Buffer), sizeof(Buffer)))
+        return false;
+
+    outValue = 0;
+    for (std::size_t Byte = 0; Byte < sizeof(Buffer); ++Byte)
+        outValue |= static_cast<std::uint32_t>(Buffer[Byte]) << (Byte * 8);
+
+    return true;
+}
+//-----------------------------------------------------------------------------
+bool hmservcommon::datastorage::readU64(std::istream& inStream, std::uint64_t& outValue)
+{
+    unsigned char Buffer[sizeof(std::uint64_t)];
+
+    if (!inStream.read(reinterpret_cast<char*>(Buffer), sizeof(Buffer)))
+        return false;
+
+    outValue = 0;
+    for (std::size_t Byte = 0; Byte < sizeof(Buffer); ++Byte)
+        outValue |= static_cast<std::uint64_t>(Buffer[Byte]) << (Byte * 8);
+
+    return true;
+}
+//-----------------------------------------------------------------------------
+void hmservcommon::datastorage::appendRecord(std::string& outBuffer, const std::string& inKey, const LsmValue& inValue)
+{
+    outBuffer.push_back(static_cast<char>((inValue) ? eLsmRecordType::rtPut : eLsmRecordType::rtRemove)); // Тип записи
+    appendU32(outBuffer, static_cast<std::uint32_t>(inKey.size()));
+    outBuffer.append(inKey);
+
+    if (inValue) // Метка удаления значения не имеет
+    {
+        appendU32(outBuffer, static_cast<std::uint32_t>(inValue->size()));
+        outBuffer.append(*inValue);
+    }
+}
+//-----------------------------------------------------------------------------
+bool hmservcommon::datastorage::readRecord(std::istream& inStream, std::string& outKey, LsmValue& outValue)
+{
+    char Type = 0;
+    std::uint32_t Size = 0;
+
+    if (!inStream.get(Type) || static_cast<std::uint8_t>(Type) >= static_cast<std::uint8_t>(eLsmRecordType::rtCount))
+        return false; // Конец потока или повреждённая запись
+
+    if (!readU32(inStream, Size))
+        return false;
+
+    outKey.resize(Size);
+    if (Size && !inStream.read(outKey.data(), Size))
+        return false;
+
+    if (static_cast<eLsmRecordType>(Type) == eLsmRecordType::rtRemove)
+        outValue = std::nullopt;
+    else
+    {
+        if (!readU32(inStream, Size))
+            return false;
+
+        std::string Value(Size, '\0');
+        if (Size && !inStream.read(Value.data(), Size))
+            return false;
+
+        outValue = std::move(Value);
+    }
+
+    return true;
+}
+//-----------------------------------------------------------------------------
+std::size_t hmservcommon::datastorage::recordSize(const std::string& inKey, const LsmValue& inValue)
+{
+    return sizeof(std::uint8_t) + sizeof(std::uint32_t) + inKey.size() +
+            ((inValue) ? sizeof(std::uint32_t) + inValue->size() : 0);
+}
+//-----------------------------------------------------------------------------
+std::uint32_t hmservcommon::datastorage::checksum(const char* inData, const std::size_t inSize)
+{
+    std::uint32_t Result = 2166136261U; // FNV offset basis
+
+    for (std::size_t Index = 0; Index < inSize; ++Index)
+    {
+        Result ^= static_cast<std::uint8_t>(inData[Index]);
+        Result *= 16777619U; // FNV prime
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,106 @@
+#ifndef HMLSMRECORD_H
+#define HMLSMRECORD_H
+
+/**
+ * @file lsmrecord.h
+ * @brief Содержит описание записей LSM хранилища и функций их (де)сериализации
+ */
+
+#include <map>
+#include <string>
+#include <istream>
+#include <cstdint>
+#include <optional>
+#include <functional>
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+typedef std::optional<std::string> LsmValue;                ///< Значение записи (std::nullopt - метка удаления)
+typedef std::map<std::string, LsmValue> LsmMemTable;        ///< Отсортированная таблица записей в памяти
+//-----------------------------------------------------------------------------
+/**
+ * @brief LsmScanCallBackFn - Тип функции-обработчика записи при сканировании
+ * @param inKey - Ключ записи
+ * @param inValue - Значение записи
+ * @return Вернёт признак необходимости продолжать сканирование
+ */
+typedef std::function<bool(const std::string& inKey, const LsmValue& inValue)> LsmScanCallBackFn;
+//-----------------------------------------------------------------------------
+/**
+ * @brief The eLsmRecordType enum - Перечисление типов записей
+ */
+enum class eLsmRecordType : std::uint8_t
+{
+    rtPut = 0,      ///< Запись значения
+    rtRemove,       ///< Метка удаления
+
+    rtCount         ///< Счётчик
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief appendU32 - Функция допишет в буфер 32 битное число (little-endian)
+ * @param outBuffer - Буфер
+ * @param inValue - Записываемое значение
+ */
+void appendU32(std::string& outBuffer, const std::uint32_t inValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief appendU64 - Функция допишет в буфер 64 битное число (little-endian)
+ * @param outBuffer - Буфер
+ * @param inValue - Записываемое значение
+ */
+void appendU64(std::string& outBuffer, const std::uint64_t inValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief readU32 - Функция прочитает из потока 32 битное число (little-endian)
+ * @param inStream - Поток
+ * @param outValue - Прочитанное значение
+ * @return Вернёт признак успеха операции
+ */
+bool readU32(std::istream& inStream, std::uint32_t& outValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief readU64 - Функция прочитает из потока 64 битное число (little-endian)
+ * @param inStream - Поток
+ * @param outValue - Прочитанное значение
+ * @return Вернёт признак успеха операции
+ */
+bool readU64(std::istream& inStream, std::uint64_t& outValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief appendRecord - Функция допишет в буфер запись в формате {тип}{длина ключа}{ключ}[{длина значения}{значение}]
+ * @param outBuffer - Буфер
+ * @param inKey - Ключ записи
+ * @param inValue - Значение записи
+ */
+void appendRecord(std::string& outBuffer, const std::string& inKey, const LsmValue& inValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief readRecord - Функция прочитает запись из потока
+ * @param inStream - Поток
+ * @param outKey - Ключ записи
+ * @param outValue - Значение записи
+ * @return Вернёт признак успеха операции
+ */
+bool readRecord(std::istream& inStream, std::string& outKey, LsmValue& outValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief recordSize - Функция вернёт размер записи в сериализованном виде
+ * @param inKey - Ключ записи
+ * @param inValue - Значение записи
+ * @return Вернёт размер записи в байтах
+ */
+std::size_t recordSize(const std::string& inKey, const LsmValue& inValue);
+//-----------------------------------------------------------------------------
+/**
+ * @brief checksum - Функция подсчитает контрольную сумму (FNV-1a 32)
+ * @param inData - Указатель на данные
+ * @param inSize - Размер данных
+ * @return Вернёт контрольную сумму
+ */
+std::uint32_t checksum(const char* inData, const std::size_t inSize);
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMLSMRECORD_H
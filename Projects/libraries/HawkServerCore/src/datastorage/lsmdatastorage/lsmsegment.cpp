@@ -0,0 +1,340 @@
+#include "lsmsegment.h"
+
+#include <algorithm>
+
+#include <systemerrorex.h>
+#include <datastorageerrorcategory.h>
+
+#include "lsmfile.h"
+#include "lsmdatastorageconst.h"
+
+using namespace hmservcommon::datastorage;
+
+static constexpr std::uint64_t C_FOOTER_SIZE = 4 * sizeof(std::uint64_t) + 2 * sizeof(std::uint32_t); ///< Размер футера сегмента
+static constexpr std::size_t C_WRITE_BUFFER_SIZE = 64 * 1024; ///< Размер буфера записи сегмента
+
+//-----------------------------------------------------------------------------
+HMLsmSegment::HMLsmSegment(const std::filesystem::path& inPath, const std::uint64_t inSequence) :
+    HMNotCopyable(),
+    m_path(inPath),
+    m_sequence(inSequence)
+{
+
+}
+//-----------------------------------------------------------------------------
+std::shared_ptr<HMLsmSegment> HMLsmSegment::load(const std::filesystem::path& inPath, const std::uint64_t inSequence, errors::error_code& outErrorCode)
+{
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    std::shared_ptr<HMLsmSegment> Result(new HMLsmSegment(inPath, inSequence)); // Конструктор закрыт, make_shared недоступен
+
+    Result->m_file.open(inPath, std::ios_base::in | std::ios_base::binary);
+
+    if (!Result->m_file.is_open())
+        outErrorCode = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else
+    {
+        std::ifstream& File = Result->m_file;
+        File.seekg(0, std::ios_base::end);
+        const std::uint64_t FileSize = static_cast<std::uint64_t>(File.tellg());
+
+        std::uint64_t IndexOffset = 0;
+        std::uint64_t BloomOffset = 0;
+        std::uint32_t Magic = 0;
+        std::uint32_t Version = 0;
+
+        if (FileSize < C_FOOTER_SIZE) // Файл короче футера
+            outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+        else
+        {
+            File.seekg(static_cast<std::streamoff>(FileSize - C_FOOTER_SIZE));
+            // Читаем футер
+            if (!readU64(File, IndexOffset) || !readU64(File, BloomOffset) || !readU64(File, Result->m_recordsCount) ||
+                    !readU64(File, Result->m_firstSequence) || !readU32(File, Magic) || !readU32(File, Version))
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+            else if (Magic != LSM_SEGMENT_MAGIC || Version != LSM_SEGMENT_VERSION) // Чужой файл или неизвестный формат
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorrecVersion);
+            else if (IndexOffset > BloomOffset || BloomOffset > FileSize - C_FOOTER_SIZE || Result->m_firstSequence > inSequence) // Смещения областей или номера не согласованы
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seIncorretData);
+        }
+
+        if (!outErrorCode) // Читаем разреженный индекс
+        {
+            Result->m_dataEnd = IndexOffset;
+            File.seekg(static_cast<std::streamoff>(IndexOffset));
+
+            std::uint32_t IndexCount = 0;
+            if (!readU32(File, IndexCount))
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+            else
+            {
+                Result->m_index.resize(IndexCount);
+
+                for (IndexEntry& Entry : Result->m_index)
+                {
+                    std::uint32_t KeySize = 0;
+
+                    if (!readU32(File, KeySize))
+                        outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+                    else
+                    {
+                        Entry.m_key.resize(KeySize);
+                        if ((KeySize && !File.read(Entry.m_key.data(), KeySize)) || !readU64(File, Entry.m_offset))
+                            outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+                    }
+
+                    if (outErrorCode)
+                        break;
+                }
+            }
+        }
+
+        if (!outErrorCode) // Читаем фильтр Блума
+        {
+            File.seekg(static_cast<std::streamoff>(BloomOffset));
+
+            std::uint32_t HashCount = 0;
+            std::uint32_t BitsSize = 0;
+
+            if (!readU32(File, HashCount) || !readU32(File, BitsSize))
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+            else
+            {
+                std::vector<std::uint8_t> Bits(BitsSize);
+
+                if (BitsSize && !File.read(reinterpret_cast<char*>(Bits.data()), BitsSize))
+                    outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+                else
+                    Result->m_bloom = HMLsmBloomFilter(HashCount, std::move(Bits));
+            }
+        }
+
+        File.clear(); // Сбрасываем флаги потока после позиционирования
+    }
+
+    if (outErrorCode)
+        Result = nullptr;
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmSegment::sequence() const
+{ return m_sequence; }
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmSegment::firstSequence() const
+{ return m_firstSequence; }
+//-----------------------------------------------------------------------------
+const std::filesystem::path& HMLsmSegment::path() const
+{ return m_path; }
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmSegment::recordsCount() const
+{ return m_recordsCount; }
+//-----------------------------------------------------------------------------
+bool HMLsmSegment::get(const std::string& inKey, LsmValue& outValue, errors::error_code& outErrorCode) const
+{
+    bool Result = false;
+    outErrorCode = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!m_index.empty() && m_bloom.mayContain(inKey)) // Фильтр Блума отсеивает большинство промахов без обращения к диску
+    {
+        std::string Key;
+        LsmValue Value;
+
+        std::lock_guard lg(m_fileDefender);
+
+        m_file.clear();
+        m_file.seekg(static_cast<std::streamoff>(indexLowerBound(inKey)));
+
+        // Ключ может находиться только в пределах одного шага индекса
+        for (std::uint32_t Step = 0; Step < LSM_INDEX_STEP && static_cast<std::uint64_t>(m_file.tellg()) < m_dataEnd; ++Step)
+        {
+            if (!readRecord(m_file, Key, Value))
+            {
+                outErrorCode = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+                break;
+            }
+
+            if (Key == inKey) // Запись найдена
+            {
+                outValue = std::move(Value);
+                Result = true;
+                break;
+            }
+            else if (Key > inKey) // Записи отсортированы, дальше искать нет смысла
+                break;
+        }
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmSegment::indexLowerBound(const std::string& inKey) const
+{
+    // Ищем последний элемент индекса, ключ которого не больше искомого
+    auto It = std::upper_bound(m_index.cbegin(), m_index.cend(), inKey, [](const std::string& Key, const IndexEntry& Entry)
+    { return Key < Entry.m_key; });
+
+    return (It == m_index.cbegin()) ? 0 : std::prev(It)->m_offset;
+}
+//-----------------------------------------------------------------------------
+std::uint64_t HMLsmSegment::dataEnd() const
+{ return m_dataEnd; }
+//-----------------------------------------------------------------------------
+HMLsmSegmentReader::HMLsmSegmentReader(std::shared_ptr<const HMLsmSegment> inSegment) :
+    HMNotCopyable(),
+    m_segment(inSegment)
+{
+    if (m_segment)
+        m_file.open(m_segment->path(), std::ios_base::in | std::ios_base::binary);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmSegmentReader::seek(const std::string& inKey)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    m_valid = false;
+
+    if (!m_segment || !m_file.is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seFileNotOpen);
+    else
+    {
+        m_file.clear();
+        m_file.seekg(static_cast<std::streamoff>(m_segment->indexLowerBound(inKey)));
+
+        do
+        {   // Пропускаем записи, ключ которых меньше заданного
+            Error = next();
+        }
+        while (!Error && m_valid && m_key < inKey);
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+bool HMLsmSegmentReader::valid() const
+{ return m_valid; }
+//-----------------------------------------------------------------------------
+const std::string& HMLsmSegmentReader::key() const
+{ return m_key; }
+//-----------------------------------------------------------------------------
+const LsmValue& HMLsmSegmentReader::value() const
+{ return m_value; }
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmSegmentReader::next()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+    m_valid = false;
+
+    if (!m_segment || !m_file.is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seFileNotOpen);
+    else if (static_cast<std::uint64_t>(m_file.tellg()) < m_segment->dataEnd()) // Область записей не закончилась
+    {
+        if (!readRecord(m_file, m_key, m_value))
+            Error = make_error_code(errors::eSystemErrorEx::seReadFileFail);
+        else
+            m_valid = true;
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+HMLsmSegmentWriter::HMLsmSegmentWriter(const std::filesystem::path& inPath, const std::size_t inExpectedCount, const std::uint64_t inFirstSequence) :
+    HMNotCopyable(),
+    m_path(inPath),
+    m_firstSequence(inFirstSequence),
+    m_file(inPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc),
+    m_bloom(inExpectedCount)
+{
+    m_buffer.reserve(C_WRITE_BUFFER_SIZE);
+    m_index.reserve(inExpectedCount / LSM_INDEX_STEP + 1);
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmSegmentWriter::add(const std::string& inKey, const LsmValue& inValue)
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!m_file.is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else
+    {
+        if (m_recordsCount % LSM_INDEX_STEP == 0) // Каждая LSM_INDEX_STEP запись попадает в разреженный индекс
+            m_index.push_back({ inKey, m_offset + m_buffer.size() });
+
+        m_bloom.add(inKey);
+        appendRecord(m_buffer, inKey, inValue);
+        ++m_recordsCount;
+
+        if (m_buffer.size() >= C_WRITE_BUFFER_SIZE)
+            Error = flushBuffer();
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmSegmentWriter::finish()
+{
+    errors::error_code Error = flushBuffer(); // Сбрасываем оставшиеся записи
+
+    if (!Error)
+    {
+        const std::uint64_t IndexOffset = m_offset;
+        // Разреженный индекс
+        appendU32(m_buffer, static_cast<std::uint32_t>(m_index.size()));
+        for (const HMLsmSegment::IndexEntry& Entry : m_index)
+        {
+            appendU32(m_buffer, static_cast<std::uint32_t>(Entry.m_key.size()));
+            m_buffer.append(Entry.m_key);
+            appendU64(m_buffer, Entry.m_offset);
+        }
+
+        const std::uint64_t BloomOffset = m_offset + m_buffer.size();
+        // Фильтр Блума
+        appendU32(m_buffer, m_bloom.hashCount());
+        appendU32(m_buffer, static_cast<std::uint32_t>(m_bloom.bits().size()));
+        m_buffer.append(reinterpret_cast<const char*>(m_bloom.bits().data()), m_bloom.bits().size());
+        // Футер
+        appendU64(m_buffer, IndexOffset);
+        appendU64(m_buffer, BloomOffset);
+        appendU64(m_buffer, m_recordsCount);
+        appendU64(m_buffer, m_firstSequence);
+        appendU32(m_buffer, LSM_SEGMENT_MAGIC);
+        appendU32(m_buffer, LSM_SEGMENT_VERSION);
+
+        Error = flushBuffer();
+
+        if (!Error)
+        {
+            m_file.flush();
+            if (m_file.bad())
+                Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+        }
+    }
+
+    m_file.close();
+
+    if (!Error) // Сегмент публикуется переименованием, которое не должно опередить запись данных на носитель
+        Error = syncFile(m_path);
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
+errors::error_code HMLsmSegmentWriter::flushBuffer()
+{
+    errors::error_code Error = make_error_code(errors::eDataStorageError::dsSuccess); // Изначально метим как успех
+
+    if (!m_file.is_open())
+        Error = make_error_code(errors::eSystemErrorEx::seOpenFileFail);
+    else if (!m_buffer.empty())
+    {
+        m_file.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+
+        if (m_file.bad())
+            Error = make_error_code(errors::eSystemErrorEx::seOutputOperationFail);
+        else
+        {
+            m_offset += m_buffer.size();
+            m_buffer.clear();
+        }
+    }
+
+    return Error;
+}
+//-----------------------------------------------------------------------------
@@ -0,0 +1,241 @@
+#ifndef HMLSMSEGMENT_H
+#define HMLSMSEGMENT_H
+
+/**
+ * @file lsmsegment.h
+ * @brief Содержит описание неизменяемого отсортированного сегмента LSM хранилища
+ */
+
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+#include <errorcode.h>
+#include <notcopyable.h>
+
+#include "lsmrecord.h"
+#include "lsmbloomfilter.h"
+
+namespace hmservcommon::datastorage
+{
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmSegment class - Класс, описывающий неизменяемый отсортированный сегмент на диске
+ * Формат файла: {записи по возрастанию ключа}{разреженный индекс}{фильтр Блума}{футер}
+ * Футер хранит наименьший порядковый номер, данные которого содержит сегмент: результат уплотнения
+ * заменяет все сегменты с номерами от него до своего, поэтому их не удалённые файлы распознаются при открытии.
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmSegment : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief The IndexEntry struct - Элемент разреженного индекса сегмента
+     */
+    struct IndexEntry
+    {
+        std::string m_key;          ///< Ключ записи
+        std::uint64_t m_offset = 0; ///< Смещение записи от начала файла
+    };
+
+    /**
+     * @brief ~HMLsmSegment - Виртуальный деструктор по умолчанию
+     */
+    virtual ~HMLsmSegment() override = default;
+
+    /**
+     * @brief load - Метод загрузит сегмент (индекс и фильтр Блума) с диска
+     * @param inPath - Путь к файлу сегмента
+     * @param inSequence - Порядковый номер сегмента
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт загруженный сегмент или nullptr
+     */
+    static std::shared_ptr<HMLsmSegment> load(const std::filesystem::path& inPath, const std::uint64_t inSequence, errors::error_code& outErrorCode);
+
+    /**
+     * @brief sequence - Метод вернёт порядковый номер сегмента (больше - новее)
+     * @return Вернёт порядковый номер сегмента
+     */
+    std::uint64_t sequence() const;
+
+    /**
+     * @brief firstSequence - Метод вернёт наименьший порядковый номер, данные которого содержит сегмент
+     * @return Вернёт номер самого старого уплотнённого в сегмент сегмента (для сброшенной memtable - собственный номер)
+     */
+    std::uint64_t firstSequence() const;
+
+    /**
+     * @brief path - Метод вернёт путь к файлу сегмента
+     * @return Вернёт путь к файлу сегмента
+     */
+    const std::filesystem::path& path() const;
+
+    /**
+     * @brief recordsCount - Метод вернёт количество записей в сегменте
+     * @return Вернёт количество записей в сегменте
+     */
+    std::uint64_t recordsCount() const;
+
+    /**
+     * @brief get - Метод найдёт запись по ключу
+     * @param inKey - Искомый ключ
+     * @param outValue - Значение записи (std::nullopt если запись является меткой удаления)
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт признак наличия записи в сегменте
+     */
+    bool get(const std::string& inKey, LsmValue& outValue, errors::error_code& outErrorCode) const;
+
+    /**
+     * @brief indexLowerBound - Метод вернёт смещение, с которого нужно начинать поиск ключа
+     * @param inKey - Искомый ключ
+     * @return Вернёт смещение записи от начала файла
+     */
+    std::uint64_t indexLowerBound(const std::string& inKey) const;
+
+    /**
+     * @brief dataEnd - Метод вернёт смещение конца области записей
+     * @return Вернёт смещение конца области записей
+     */
+    std::uint64_t dataEnd() const;
+
+private:
+
+    /**
+     * @brief HMLsmSegment - Инициализирующий конструктор
+     * @param inPath - Путь к файлу сегмента
+     * @param inSequence - Порядковый номер сегмента
+     */
+    HMLsmSegment(const std::filesystem::path& inPath, const std::uint64_t inSequence);
+
+    const std::filesystem::path m_path;     ///< Путь к файлу сегмента
+    const std::uint64_t m_sequence;         ///< Порядковый номер сегмента
+
+    std::uint64_t m_firstSequence = 0;      ///< Наименьший порядковый номер, данные которого содержит сегмент
+    std::uint64_t m_dataEnd = 0;            ///< Смещение конца области записей
+    std::uint64_t m_recordsCount = 0;       ///< Количество записей
+    std::vector<IndexEntry> m_index;        ///< Разреженный индекс
+    HMLsmBloomFilter m_bloom;               ///< Фильтр Блума
+
+    mutable std::mutex m_fileDefender;      ///< Мьютекс, защищающий файл сегмента
+    mutable std::ifstream m_file;           ///< Файл сегмента, открытый на чтение
+
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmSegmentReader class - Класс последовательного чтения сегмента (используется при сканировании и уплотнении)
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmSegmentReader : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMLsmSegmentReader - Инициализирующий конструктор
+     * @param inSegment - Читаемый сегмент
+     */
+    explicit HMLsmSegmentReader(std::shared_ptr<const HMLsmSegment> inSegment);
+
+    /**
+     * @brief seek - Метод переместит чтение на первую запись с ключом не меньше заданного
+     * @param inKey - Ключ
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code seek(const std::string& inKey);
+
+    /**
+     * @brief valid - Метод вернёт признак наличия текущей записи
+     * @return Вернёт признак наличия текущей записи
+     */
+    bool valid() const;
+
+    /**
+     * @brief key - Метод вернёт ключ текущей записи
+     * @return Вернёт ключ текущей записи
+     */
+    const std::string& key() const;
+
+    /**
+     * @brief value - Метод вернёт значение текущей записи
+     * @return Вернёт значение текущей записи
+     */
+    const LsmValue& value() const;
+
+    /**
+     * @brief next - Метод перейдёт к следующей записи
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code next();
+
+private:
+
+    std::shared_ptr<const HMLsmSegment> m_segment;  ///< Читаемый сегмент
+    std::ifstream m_file;                           ///< Собственный дескриптор файла сегмента
+
+    bool m_valid = false;                           ///< Признак наличия текущей записи
+    std::string m_key;                              ///< Ключ текущей записи
+    LsmValue m_value;                               ///< Значение текущей записи
+
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMLsmSegmentWriter class - Класс, формирующий файл сегмента из отсортированного потока записей
+ *
+ * @authors Alekseev_s
+ * @date 19.10.2026
+ */
+class HMLsmSegmentWriter : public hmcommon::HMNotCopyable
+{
+public:
+
+    /**
+     * @brief HMLsmSegmentWriter - Инициализирующий конструктор
+     * @param inPath - Путь к формируемому файлу
+     * @param inExpectedCount - Ожидаемое количество записей (для расчёта размера фильтра Блума)
+     * @param inFirstSequence - Наименьший порядковый номер, данные которого содержит сегмент
+     */
+    HMLsmSegmentWriter(const std::filesystem::path& inPath, const std::size_t inExpectedCount, const std::uint64_t inFirstSequence);
+
+    /**
+     * @brief add - Метод добавит запись (ключи обязаны поступать по возрастанию)
+     * @param inKey - Ключ записи
+     * @param inValue - Значение записи
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code add(const std::string& inKey, const LsmValue& inValue);
+
+    /**
+     * @brief finish - Метод допишет индекс, фильтр Блума и футер, закроет файл и дождётся его записи на носитель
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code finish();
+
+private:
+
+    const std::filesystem::path m_path;                 ///< Путь к формируемому файлу
+    const std::uint64_t m_firstSequence;                ///< Наименьший порядковый номер, данные которого содержит сегмент
+    std::ofstream m_file;                               ///< Формируемый файл
+
+    std::string m_buffer;                               ///< Буфер записи
+    std::uint64_t m_offset = 0;                         ///< Текущее смещение в файле
+    std::uint64_t m_recordsCount = 0;                   ///< Количество записей
+    std::vector<HMLsmSegment::IndexEntry> m_index;      ///< Разреженный индекс
+    HMLsmBloomFilter m_bloom;                           ///< Фильтр Блума
+
+    /**
+     * @brief flushBuffer - Метод сбросит буфер в файл
+     * @return Вернёт признак ошибки
+     */
+    errors::error_code flushBuffer();
+
+};
+//-----------------------------------------------------------------------------
+} // namespace hmservcommon::datastorage
+
+#endif // HMLSMSEGMENT_H
@@ -19,7 +19,7 @@ HMServerCore::HMServerCore()
 //    m_accountBuilder = std::make_unique<builders::HMAccountBuilder>(m_dataStorage); // Формируем билдер и передаём в него хранилище
 
     net::ServCallbacks CallBacks;
-    m_server = std::make_unique<net::HMQtSimpleAsyncServer>(24680, CallBacks);
+    m_server = std::make_unique<net::HMQtSimpleAsyncServer>(24680, CallBacks, net::HMQtWorkerPool::idealWorkersCount()); // Соединения обслуживаются рабочими потоками
 }
 //-----------------------------------------------------------------------------
 HMServerCore::~HMServerCore()
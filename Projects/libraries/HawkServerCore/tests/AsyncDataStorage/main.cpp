@@ -0,0 +1,187 @@
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <HawkCommonTestUtils.hpp>
+
+#include <datastorageerrorcategory.h>
+#include <datastorage/lsmdatastorage/lsmdatastorage.h>
+#include <datastorage/jsondatastorage/jsondatastorage.h>
+#include <datastorage/asyncdatastorage/asyncdatastorage.h>
+
+//-----------------------------------------------------------------------------
+using namespace hmservcommon::datastorage;
+//-----------------------------------------------------------------------------
+const std::filesystem::path C_JSON_PATH = std::filesystem::current_path() / "AsyncDataStorage.json";
+const std::filesystem::path C_LSM_PATH = std::filesystem::current_path() / "AsyncLsmDataStorage";
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeStorage - Метод создаст асинхронный фасад над хранилищем
+ * @param inWorkers - Количество потоков исполнителя (больше одного - LSM хранилище, т.к. JSON не потокобезопасно)
+ * @return Вернёт экземпляр асинхронного хранилища
+ */
+std::unique_ptr<HMAsyncDataStorage> makeStorage(const std::size_t inWorkers = 1)
+{
+    errors::error_code Error; // Метка ошибки
+    std::shared_ptr<HMDataStorage> Storage = nullptr;
+
+    if (inWorkers > 1)
+    {
+        std::filesystem::remove_all(C_LSM_PATH, Error); // Удаляем старое хранилище
+        Storage = std::make_shared<HMLsmDataStorage>(C_LSM_PATH);
+    }
+    else
+    {
+        if (std::filesystem::exists(C_JSON_PATH, Error))
+            std::filesystem::remove(C_JSON_PATH, Error); // Удаляем старое хранилище
+
+        Storage = std::make_shared<HMJsonDataStorage>(C_JSON_PATH);
+    }
+
+    return std::make_unique<HMAsyncDataStorage>(Storage, inWorkers);
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит открытие и закрытие хранилища через фасад
+ */
+TEST(AsyncDataStorage, openClose)
+{
+    std::unique_ptr<HMAsyncDataStorage> Storage = makeStorage();
+
+    ASSERT_FALSE(Storage->open().get()); // Ошибки быть не должно
+    EXPECT_TRUE(Storage->is_open()); // Хранилище должно считаться открытым
+
+    Storage->close().wait();
+    EXPECT_FALSE(Storage->is_open()); // Хранилище должно считаться закрытым
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит получение результата через обработчик завершения
+ */
+TEST(AsyncDataStorage, callBack)
+{
+    std::unique_ptr<HMAsyncDataStorage> Storage = makeStorage();
+    ASSERT_FALSE(Storage->open().get()); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+    std::promise<QUuid> FoundGroup;
+
+    Storage->addGroup(NewGroup);
+    Storage->findGroupByUUID(NewGroup->m_uuid, [&](const StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>>& inResult)
+    {   // Обработчик вызывается в потоке исполнителя
+        FoundGroup.set_value((!inResult.m_error && inResult.m_value) ? inResult.m_value->m_uuid : QUuid());
+    });
+
+    EXPECT_EQ(FoundGroup.get_future().get(), NewGroup->m_uuid); // Запросы одного потока выполняются по порядку
+
+    StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>> Result = Storage->findGroupByUUID(QUuid::createUuid()).get();
+    EXPECT_EQ(Result.m_value, nullptr);
+    EXPECT_EQ(Result.m_error.value(), static_cast<int32_t>(errors::eDataStorageError::dsGroupNotExists));
+
+    Storage->close().wait();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что исключение обработчика не затрагивает результат запроса и исполнитель
+ */
+TEST(AsyncDataStorage, callBackException)
+{
+    std::unique_ptr<HMAsyncDataStorage> Storage = makeStorage();
+    ASSERT_FALSE(Storage->open().get()); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+
+    std::future<errors::error_code> AddResult = Storage->addGroup(NewGroup, [](const errors::error_code&)
+    {
+        throw std::runtime_error("callback failure");
+    });
+
+    EXPECT_FALSE(AddResult.get()); // Результат передан до вызова обработчика
+
+    StorageResult<std::shared_ptr<hmcommon::HMGroupInfo>> Found = Storage->findGroupByUUID(NewGroup->m_uuid).get(); // Исполнитель продолжает работу
+    EXPECT_FALSE(Found.m_error);
+    EXPECT_NE(Found.m_value, nullptr);
+
+    Storage->close().wait();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит одновременное выполнение множества запросов
+ */
+TEST(AsyncDataStorage, inFlight)
+{
+    std::unique_ptr<HMAsyncDataStorage> Storage = makeStorage(4);
+    ASSERT_FALSE(Storage->open().get()); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+    ASSERT_FALSE(Storage->addGroup(NewGroup).get()); // Ошибки быть не должно
+
+    const std::size_t MESSAGES = 100;
+    const QDateTime BaseTime = QDateTime::currentDateTime();
+    std::vector<std::future<errors::error_code>> Results;
+    std::atomic_size_t CallBacks = 0;
+    std::promise<void> AllCallBacks; // Обработчик вызывается после готовности результата, поэтому ждём его отдельно
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index) // Ставим все запросы, не дожидаясь результатов
+    {
+        hmcommon::MsgData TextData(hmcommon::eMsgType::mtText, ("Текст сообщения " + QString::number(Index)).toLocal8Bit());
+        Results.push_back(Storage->addMessage(testscommon::make_groupmessage(TextData, QUuid::createUuid(), NewGroup->m_uuid, BaseTime.addMSecs(static_cast<qint64>(Index))),
+                                              [&](const errors::error_code&) { if (++CallBacks == MESSAGES) AllCallBacks.set_value(); }));
+    }
+
+    for (auto& Result : Results)
+        EXPECT_FALSE(Result.get()); // Ошибки быть не должно
+
+    ASSERT_EQ(AllCallBacks.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready); // Каждый запрос должен вызвать обработчик
+    EXPECT_EQ(CallBacks.load(), MESSAGES);
+
+    auto Found = Storage->findMessages(NewGroup->m_uuid, hmcommon::MsgRange(BaseTime, BaseTime.addMSecs(static_cast<qint64>(MESSAGES)))).get();
+    EXPECT_FALSE(Found.m_error); // Ошибки быть не должно
+    EXPECT_EQ(Found.m_value.size(), MESSAGES);
+
+    Storage->close().wait();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что уничтожение фасада дожидается поставленных запросов
+ */
+TEST(AsyncDataStorage, drainOnDestroy)
+{
+    std::shared_ptr<HMDataStorage> HardStorage;
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+    std::future<errors::error_code> AddResult;
+
+    {
+        std::unique_ptr<HMAsyncDataStorage> Storage = makeStorage();
+        HardStorage = Storage->storage();
+
+        Storage->open();
+        AddResult = Storage->addGroup(NewGroup); // Результат не ожидаем
+    }
+
+    ASSERT_EQ(AddResult.wait_for(std::chrono::seconds(0)), std::future_status::ready); // Запрос уже выполнен
+    EXPECT_FALSE(AddResult.get());
+
+    errors::error_code Error;
+    EXPECT_NE(HardStorage->findGroupByUUID(NewGroup->m_uuid, Error), nullptr);
+    EXPECT_FALSE(Error);
+
+    HardStorage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка тестировани функционала HMAsyncDataStorage
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт признак успешности тестирования
+ */
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+//-----------------------------------------------------------------------------
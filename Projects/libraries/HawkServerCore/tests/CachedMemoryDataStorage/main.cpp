@@ -233,6 +233,14 @@ TEST(CachedMemoryDataStorage, findMessages)
     CachedDataStorage_FindMessagesTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит постраничный поиск сообщений относительно курсора
+ */
+TEST(CachedMemoryDataStorage, findMessagesPage)
+{
+    CachedDataStorage_FindMessagesPageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест проверит удаление сообщения
  */
@@ -241,6 +249,38 @@ TEST(CachedMemoryDataStorage, removeMessage)
     CachedDataStorage_RemoveMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что отмена транзакции сбрасывает кеш
+ */
+TEST(CachedMemoryDataStorage, transaction)
+{
+    errors::error_code Error;
+    std::unique_ptr<HMDataStorage> CachedStorage = makeStorage(); // Создаём кеширующее хранилище
+
+    Error = CachedStorage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    Error = CachedStorage->rollbackTransaction(); // Пытаемся отменить не начатую транзакцию
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+
+    std::shared_ptr<hmcommon::HMUserInfo> CommittedUser = testscommon::make_user_info();
+    std::shared_ptr<hmcommon::HMUserInfo> RolledBackUser = testscommon::make_user_info(QUuid::createUuid(), "Other@login.com");
+
+    ASSERT_FALSE(CachedStorage->beginTransaction());
+    ASSERT_FALSE(CachedStorage->addUser(CommittedUser));
+    ASSERT_FALSE(CachedStorage->commitTransaction());
+
+    ASSERT_FALSE(CachedStorage->beginTransaction());
+    ASSERT_FALSE(CachedStorage->addUser(RolledBackUser));
+    ASSERT_FALSE(CachedStorage->rollbackTransaction());
+
+    std::shared_ptr<hmcommon::HMUserInfo> FindUser = CachedStorage->findUserByUUID(RolledBackUser->m_uuid, Error);
+    EXPECT_EQ(FindUser, nullptr); // Кеш не должен хранить отменённые изменения
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsUserNotExists));
+
+    CachedStorage->close();
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест проверит кеширование объектов
  */
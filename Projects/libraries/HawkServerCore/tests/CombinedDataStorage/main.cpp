@@ -1,4 +1,5 @@
 #include <chrono>
+#include <functional>
 
 #include <gtest/gtest.h>
 
@@ -251,6 +252,14 @@ TEST(CombinedDataStorage, findMessages)
     HardDataStorage_FindMessagesTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит постраничный поиск сообщений относительно курсора
+ */
+TEST(CombinedDataStorage, findMessagesPage)
+{
+    HardDataStorage_FindMessagesPageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест проверит удаление сообщения
  */
@@ -259,6 +268,14 @@ TEST(CombinedDataStorage, removeMessage)
     HardDataStorage_RemoveMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит транзакции хранилища
+ */
+TEST(CombinedDataStorage, transaction)
+{
+    HardDataStorage_TransactionTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест проверит кеширование объектов
  */
@@ -438,6 +455,187 @@ TEST(CombinedDataStorage, CacheTest)
     Storage->close();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит ленту изменений хранилища
+ */
+TEST(CombinedDataStorage, changeFeed)
+{
+    errors::error_code Error; // Метка ошибки
+
+    std::unique_ptr<HMDataStorage> BaseStorage = makeStorage();
+    HMCombinedDataStorage* Storage = dynamic_cast<HMCombinedDataStorage*>(BaseStorage.get());
+    ASSERT_NE(Storage, nullptr);
+
+    std::size_t Notifications = 0;
+    std::shared_ptr<HMChangeSubscription> Subscription = Storage->subscribe(4, [&]() { ++Notifications; }); // Маленькая очередь для проверки переполнения
+    std::shared_ptr<HMChangeSubscription> Unused = Storage->subscribe(); // Подписка, которую никто не читает, не должна мешать
+
+    Error = Storage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+
+    ASSERT_FALSE(Storage->addUser(NewUser));
+    ASSERT_FALSE(Storage->addGroup(NewGroup));
+    ASSERT_FALSE(Storage->addGroupUser(NewGroup->m_uuid, NewUser->m_uuid));
+    EXPECT_TRUE(Storage->addGroup(NewGroup)); // Неудачное изменение не должно порождать событие
+
+    ChangeEvent Event;
+    ASSERT_TRUE(Subscription->pop(Event));
+    EXPECT_EQ(Event.m_sequence, 1u);
+    EXPECT_EQ(Event.m_type, eChangeType::ctUserAdded);
+    EXPECT_EQ(Event.m_object, NewUser->m_uuid);
+
+    ASSERT_TRUE(Subscription->pop(Event));
+    EXPECT_EQ(Event.m_sequence, 2u);
+    EXPECT_EQ(Event.m_type, eChangeType::ctGroupAdded);
+    EXPECT_EQ(Event.m_object, NewGroup->m_uuid);
+
+    ASSERT_TRUE(Subscription->pop(Event));
+    EXPECT_EQ(Event.m_sequence, 3u);
+    EXPECT_EQ(Event.m_type, eChangeType::ctGroupUsersChanged);
+    EXPECT_EQ(Event.m_object, NewGroup->m_uuid);
+    EXPECT_EQ(Event.m_related, NewUser->m_uuid);
+
+    EXPECT_FALSE(Subscription->pop(Event)); // Больше событий нет
+    EXPECT_EQ(Storage->changeSequence(), 3u);
+    EXPECT_EQ(Notifications, 3u);
+
+    for (std::size_t Index = 0; Index < 6; ++Index) // Переполняем очередь подписчика
+    {
+        hmcommon::MsgData TextData(hmcommon::eMsgType::mtText, "Текст сообщения");
+        ASSERT_FALSE(Storage->addMessage(testscommon::make_groupmessage(TextData, QUuid::createUuid(), NewGroup->m_uuid)));
+    }
+
+    EXPECT_EQ(Subscription->dropped(), 2u); // В очередь поместились только 4 события
+
+    std::uint64_t LastSequence = 3;
+    while (Subscription->pop(Event)) // Оставшиеся события идут по порядку
+    {
+        EXPECT_EQ(Event.m_type, eChangeType::ctMessageAdded);
+        EXPECT_EQ(Event.m_related, NewGroup->m_uuid);
+        EXPECT_EQ(Event.m_sequence, ++LastSequence);
+    }
+
+    EXPECT_EQ(LastSequence, 7u);
+    EXPECT_EQ(Unused->dropped(), 0u); // Ёмкости по умолчанию хватает
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что лента изменений оповещает только о зафиксированных изменениях транзакции
+ */
+TEST(CombinedDataStorage, transactionChangeFeed)
+{
+    errors::error_code Error; // Метка ошибки
+
+    std::unique_ptr<HMDataStorage> BaseStorage = makeStorage();
+    HMCombinedDataStorage* Storage = dynamic_cast<HMCombinedDataStorage*>(BaseStorage.get());
+    ASSERT_NE(Storage, nullptr);
+
+    std::shared_ptr<HMChangeSubscription> Subscription = Storage->subscribe();
+
+    Error = Storage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+    ChangeEvent Event;
+
+    ASSERT_FALSE(Storage->beginTransaction());
+    ASSERT_FALSE(Storage->addUser(NewUser));
+    EXPECT_FALSE(Subscription->pop(Event)); // До фиксации подписчики не оповещаются
+    ASSERT_FALSE(Storage->rollbackTransaction());
+    EXPECT_FALSE(Subscription->pop(Event)); // Об отменённых изменениях подписчики не узнают
+
+    ASSERT_FALSE(Storage->beginTransaction());
+    ASSERT_FALSE(Storage->addUser(NewUser));
+    ASSERT_FALSE(Storage->addGroup(NewGroup));
+    EXPECT_EQ(Subscription->size(), 0u);
+    ASSERT_FALSE(Storage->commitTransaction());
+
+    ASSERT_TRUE(Subscription->pop(Event));
+    EXPECT_EQ(Event.m_sequence, 1u); // Отменённая транзакция не расходует порядковые номера
+    EXPECT_EQ(Event.m_type, eChangeType::ctUserAdded);
+    EXPECT_EQ(Event.m_object, NewUser->m_uuid);
+
+    ASSERT_TRUE(Subscription->pop(Event));
+    EXPECT_EQ(Event.m_sequence, 2u);
+    EXPECT_EQ(Event.m_type, eChangeType::ctGroupAdded);
+    EXPECT_EQ(Event.m_object, NewGroup->m_uuid);
+
+    EXPECT_FALSE(Subscription->pop(Event)); // Больше событий нет
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит принадлежность транзакции открывшему её потоку
+ */
+TEST(CombinedDataStorage, transactionOwner)
+{
+    HardDataStorage_TransactionOwnerTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief The HMReadHookJsonDataStorage class - Класс, описывающий физическое хранилище, выполняющее действие сразу после чтения пользователя
+ */
+class HMReadHookJsonDataStorage : public HMJsonDataStorage
+{
+public:
+
+    using HMJsonDataStorage::HMJsonDataStorage;
+
+    mutable std::function<void()> m_afterRead;  ///< Однократное действие после чтения пользователя
+
+    /**
+     * @brief findUserByUUID - Метод найдёт пользователя и выполнит действие после чтения
+     * @param inUserUUID - UUID пользователя
+     * @param outErrorCode - Признак ошибки
+     * @return Вернёт указатель на пользователя или nullptr
+     */
+    virtual std::shared_ptr<hmcommon::HMUserInfo> findUserByUUID(const QUuid& inUserUUID, errors::error_code& outErrorCode) const override
+    {
+        std::shared_ptr<hmcommon::HMUserInfo> Result = HMJsonDataStorage::findUserByUUID(inUserUUID, outErrorCode);
+
+        if (m_afterRead) // Изменяем хранилище между чтением и заполнением кеша
+            std::exchange(m_afterRead, nullptr)();
+
+        return Result;
+    }
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что удалённый во время чтения пользователь не возвращается в кеш
+ */
+TEST(CombinedDataStorage, cacheFillAfterRemove)
+{
+    errors::error_code Error; // Метка ошибки
+
+    if (std::filesystem::exists(C_JSON_PATH)) // Если физическое хранилище существует
+        std::filesystem::remove(C_JSON_PATH, Error);
+
+    std::shared_ptr<HMReadHookJsonDataStorage> HardStorage = std::make_shared<HMReadHookJsonDataStorage>(C_JSON_PATH);
+    HMCombinedDataStorage Storage(HardStorage, std::make_shared<HMCachedMemoryDataStorage>());
+
+    ASSERT_FALSE(Storage.open());
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+    ASSERT_FALSE(HardStorage->addUser(NewUser)); // Пользователь есть только в физическом хранилище
+
+    HardStorage->m_afterRead = [&]() { EXPECT_FALSE(Storage.removeUser(NewUser->m_uuid)); };
+
+    EXPECT_NE(Storage.findUserByUUID(NewUser->m_uuid, Error), nullptr); // Чтение успело до удаления
+    EXPECT_FALSE(Error);
+
+    EXPECT_EQ(Storage.findUserByUUID(NewUser->m_uuid, Error), nullptr); // Прочитанный до удаления пользователь не попал в кеш
+    EXPECT_EQ(Error, make_error_code(errors::eDataStorageError::dsUserNotExists));
+
+    Storage.close();
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief main - Входная точка тестировани функционала HMCombinedDataStorage
  * @param argc - Количество аргументов
@@ -1,10 +1,12 @@
 #include <memory>
+#include <fstream>
 #include <filesystem>
 
 #include <gtest/gtest.h>
 
 #include <HawkServerCoreHardDataStorageTest.hpp>
 #include <datastorage/jsondatastorage/jsondatastorage.h>
+#include <datastorage/jsondatastorage/jsondatastorageconst.h>
 
 //-----------------------------------------------------------------------------
 const std::filesystem::path C_JSON_PATH = std::filesystem::current_path() / "DataStorage.json";
@@ -253,6 +255,14 @@ TEST(JsonDataStorage, findMessages)
     HardDataStorage_FindMessagesTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит постраничный поиск сообщений относительно курсора
+ */
+TEST(JsonDataStorage, findMessagesPage)
+{
+    HardDataStorage_FindMessagesPageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест проверит удаление сообщения
  */
@@ -261,6 +271,76 @@ TEST(JsonDataStorage, removeMessage)
     HardDataStorage_RemoveMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит транзакции хранилища
+ */
+TEST(JsonDataStorage, transaction)
+{
+    HardDataStorage_TransactionTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит откат каскадного удаления пользователя, прерванного на середине
+ */
+TEST(JsonDataStorage, removeUserRollback)
+{
+    std::shared_ptr<hmcommon::HMUserInfo> User = testscommon::make_user_info(QUuid::createUuid(), "User@login");
+    std::shared_ptr<hmcommon::HMUserInfo> Contact = testscommon::make_user_info(QUuid::createUuid(), "Contact@login");
+    std::shared_ptr<hmcommon::HMUserInfo> Broken = testscommon::make_user_info(QUuid::createUuid(), "Broken@login");
+    std::shared_ptr<hmcommon::HMGroupInfo> Group = testscommon::make_group_info();
+
+    {
+        std::unique_ptr<HMDataStorage> Storage = makeStorage();
+        ASSERT_FALSE(Storage->open());
+
+        ASSERT_FALSE(Storage->addUser(User));
+        ASSERT_FALSE(Storage->addUser(Contact));
+        ASSERT_FALSE(Storage->addUser(Broken));
+        ASSERT_FALSE(Storage->addUserContact(User->m_uuid, Contact->m_uuid));
+        ASSERT_FALSE(Storage->addUserContact(User->m_uuid, Broken->m_uuid));
+        ASSERT_FALSE(Storage->addGroup(Group));
+        ASSERT_FALSE(Storage->addGroupUser(Group->m_uuid, User->m_uuid));
+
+        Storage->close();
+    }
+
+    {   // Разрываем обратную связь контакта, чтобы каскадное удаление не смогло завершиться
+        nlohmann::json Json;
+        std::ifstream(C_JSON_PATH) >> Json;
+
+        for (nlohmann::json& UserObject : Json[J_USERS])
+        {
+            if (UserObject[J_USER_UUID].get<std::string>() == Broken->m_uuid.toString().toStdString())
+                UserObject[J_USER_CONTACTS] = nlohmann::json::array();
+        }
+
+        std::ofstream(C_JSON_PATH) << Json;
+    }
+
+    std::unique_ptr<HMDataStorage> Storage = makeStorage(C_JSON_PATH, false);
+    ASSERT_FALSE(Storage->open());
+
+    EXPECT_TRUE(Storage->removeUser(User->m_uuid)); // Удаление должно прерваться
+
+    errors::error_code Error;
+    EXPECT_NE(Storage->findUserByUUID(User->m_uuid, Error), nullptr); // Пользователь остался в хранилище
+    EXPECT_FALSE(Error);
+
+    std::shared_ptr<std::set<QUuid>> Contacts = Storage->getUserContactList(User->m_uuid, Error);
+    ASSERT_FALSE(Error);
+    EXPECT_EQ(*Contacts, std::set<QUuid>({ Contact->m_uuid, Broken->m_uuid })); // Контакты пользователя восстановлены
+
+    Contacts = Storage->getUserContactList(Contact->m_uuid, Error);
+    ASSERT_FALSE(Error);
+    EXPECT_EQ(*Contacts, std::set<QUuid>({ User->m_uuid })); // Уже разорванная обратная связь восстановлена
+
+    std::shared_ptr<std::set<QUuid>> Groups = Storage->getUserGroups(User->m_uuid, Error);
+    ASSERT_FALSE(Error);
+    EXPECT_EQ(*Groups, std::set<QUuid>({ Group->m_uuid })); // Пользователь остался в группе
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief TEST - Тест сохранения хранилища в JSON
  */
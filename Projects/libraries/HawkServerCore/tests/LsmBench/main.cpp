@@ -0,0 +1,190 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+#include <datastorage/lsmdatastorage/lsmengine.h>
+
+//-----------------------------------------------------------------------------
+// Const
+//-----------------------------------------------------------------------------
+constexpr std::size_t C_KEY_WIDTH = 16;                         ///< Ширина ключа (ключи сортируются так же как номера)
+//-----------------------------------------------------------------------------
+/**
+ * @brief The Settings struct - Структура, описывающая параметры прогона
+ */
+struct Settings
+{
+    std::size_t m_writers = 64;                                 ///< Количество одновременно пишущих потоков
+    std::size_t m_inserts = 4096;                               ///< Количество вставок от каждого потока
+    std::size_t m_batch = 1;                                    ///< Количество записей в одном наборе изменений
+    std::size_t m_valueSize = 64;                               ///< Размер значения (байт)
+    std::size_t m_minRate = 100000;                             ///< Требуемая скорость вставки в секунду (0 - не проверять)
+    std::filesystem::path m_path = "LsmBench";                  ///< Директория хранилища (удаляется до и после прогона)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief The RunResult struct - Структура, описывающая результат прогона
+ */
+struct RunResult
+{
+    std::size_t m_inserts = 0;                                  ///< Количество подтверждённых вставок
+    double m_seconds = 0.0;                                     ///< Длительность прогона
+    std::string m_error;                                        ///< Описание ошибки (пусто - прогон завершён)
+};
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeKey - Функция сформирует ключ вставки
+ * @param inWriter - Номер пишущего потока
+ * @param inIndex - Номер вставки потока
+ * @return Вернёт ключ
+ */
+static std::string makeKey(const std::size_t inWriter, const std::size_t inIndex)
+{
+    std::string Key = std::to_string(inWriter * 1000000000ull + inIndex);
+    return std::string(C_KEY_WIDTH - std::min(Key.size(), C_KEY_WIDTH), '0') + Key;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief runBenchmark - Функция измерит скорость вставки в журнально-структурированное хранилище
+ * Каждая вставка подтверждается только после записи журнала на носитель, одновременные вставки объединяются группами
+ * @param inSettings - Параметры прогона
+ * @return Вернёт результат прогона
+ */
+static RunResult runBenchmark(const Settings& inSettings)
+{
+    RunResult Result;
+    errors::error_code Error;
+
+    std::filesystem::remove_all(inSettings.m_path, Error);
+    Error = errors::error_code();
+
+    {
+        hmservcommon::datastorage::HMLsmEngine Engine(inSettings.m_path);
+        Error = Engine.open();
+
+        if (Error)
+            Result.m_error = Error.message();
+        else
+        {
+            const std::string Value(inSettings.m_valueSize, 'V');
+            std::atomic<std::size_t> Inserts(0);
+            std::atomic<bool> Failed(false);
+            std::vector<std::thread> Writers;
+
+            const auto Start = std::chrono::steady_clock::now();
+
+            for (std::size_t Writer = 0; Writer < inSettings.m_writers; ++Writer)
+            {
+                Writers.emplace_back([&, Writer]()
+                {
+                    for (std::size_t Index = 0; !Failed && Index < inSettings.m_inserts; Index += inSettings.m_batch)
+                    {
+                        hmservcommon::datastorage::HMLsmWriteBatch Batch;
+                        const std::size_t BatchEnd = std::min(Index + inSettings.m_batch, inSettings.m_inserts);
+
+                        for (std::size_t Key = Index; Key < BatchEnd; ++Key)
+                            Batch.put(makeKey(Writer, Key), Value);
+
+                        if (Engine.write(Batch))
+                            Failed = true;
+                        else
+                            Inserts += BatchEnd - Index;
+                    }
+                });
+            }
+
+            for (auto& Writer : Writers)
+                Writer.join();
+
+            Result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+            Result.m_inserts = Inserts;
+
+            if (Failed)
+                Result.m_error = "write failed";
+
+            Engine.close();
+        }
+    }
+
+    std::filesystem::remove_all(inSettings.m_path, Error);
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief parseSettings - Функция разберёт аргументы командной строки
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @param outSettings - Параметры прогона
+ * @return Вернёт признак успешного разбора
+ */
+static bool parseSettings(int argc, char *argv[], Settings& outSettings)
+{
+    bool Result = true;
+
+    for (int Index = 1; Result && Index < argc; ++Index)
+    {
+        const std::string Name = argv[Index];
+        const char* Value = (Index + 1 < argc) ? argv[++Index] : nullptr;
+        char* End = nullptr;
+        const std::size_t Number = (Value) ? std::strtoull(Value, &End, 10) : 0;
+        const bool IsNumber = Value && End != Value && *End == '\0';
+
+        if (Name == "--path" && Value)
+            outSettings.m_path = Value;
+        else if (Name == "--writers" && IsNumber && Number > 0)
+            outSettings.m_writers = Number;
+        else if (Name == "--inserts" && IsNumber && Number > 0)
+            outSettings.m_inserts = Number;
+        else if (Name == "--batch" && IsNumber && Number > 0)
+            outSettings.m_batch = Number;
+        else if (Name == "--size" && IsNumber)
+            outSettings.m_valueSize = Number;
+        else if (Name == "--min-rate" && IsNumber)
+            outSettings.m_minRate = Number;
+        else
+            Result = false;
+    }
+
+    return Result;
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка измерения скорости вставки в журнально-структурированное хранилище
+ * Использование: HawkServerCore_LsmBench [--writers N] [--inserts N] [--batch N] [--size BYTES] [--min-rate INSERTS_PER_SEC] [--path DIR]
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт EXIT_FAILURE, если прогон не завершился или скорость ниже требуемой
+ */
+int main(int argc, char *argv[])
+{
+    Settings BenchSettings;
+
+    if (!parseSettings(argc, argv, BenchSettings))
+    {
+        std::printf("usage: %s [--writers N] [--inserts N] [--batch N] [--size BYTES] [--min-rate INSERTS_PER_SEC] [--path DIR]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("%zu writers x %zu inserts, batch %zu, value %zu bytes\n",
+                BenchSettings.m_writers, BenchSettings.m_inserts, BenchSettings.m_batch, BenchSettings.m_valueSize);
+
+    const RunResult Run = runBenchmark(BenchSettings);
+    const double Rate = Run.m_inserts / std::max(Run.m_seconds, 1e-9);
+    const bool Success = Run.m_error.empty() && Rate >= BenchSettings.m_minRate;
+
+    std::printf("lsm %10zu inserts %8.3f s %12.0f inserts/s%s%s\n", Run.m_inserts, Run.m_seconds, Rate,
+                Run.m_error.empty() ? "" : "  failed: ", Run.m_error.c_str());
+
+    if (Run.m_error.empty() && !Success)
+        std::printf("below the required %zu inserts/s\n", BenchSettings.m_minRate);
+
+    return (Success) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+//-----------------------------------------------------------------------------
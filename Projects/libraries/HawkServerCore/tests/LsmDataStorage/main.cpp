@@ -0,0 +1,723 @@
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <HawkServerCoreHardDataStorageTest.hpp>
+#include <datastorage/lsmdatastorage/lsmengine.h>
+#include <datastorage/lsmdatastorage/lsmdatastorage.h>
+
+//-----------------------------------------------------------------------------
+const std::filesystem::path C_LSM_PATH = std::filesystem::current_path() / "LsmDataStorage";
+//-----------------------------------------------------------------------------
+/**
+ * @brief makeStorage - Метод создаст экземпляр хранилища
+ * @param inStoragePath - Путь к хранилищу
+ * @param inRemoveOld - Флаг, требующий удаления старого хранилища, если оно существует
+ * @return Вернёт экземпляр хранилища
+ */
+std::unique_ptr<HMDataStorage> makeStorage(const std::filesystem::path& inStoragePath = C_LSM_PATH, const bool inRemoveOld = true)
+{
+    errors::error_code Error; // Метка ошибки
+
+    if (inRemoveOld && std::filesystem::exists(inStoragePath, Error)) // При необходимости
+        std::filesystem::remove_all(inStoragePath, Error); // Удаляем хранилище по указанному пути
+
+    return std::make_unique<HMLsmDataStorage>(inStoragePath); // Создаём экземпляр хранилища HMLsmDataStorage
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит попытку открытия хранилища
+ */
+TEST(LsmDataStorage, open)
+{
+    errors::error_code Error;
+
+    {   // Попытка открыть хранилище (ИСТОЧНИК ФАЙЛ)
+        std::filesystem::path FilePath = std::filesystem::temp_directory_path(Error) / "LDS_OFP";
+        ASSERT_FALSE(Error);
+
+        std::ofstream(FilePath).close(); // Создаём временный файл
+
+        std::unique_ptr<HMDataStorage> Storage = makeStorage(FilePath, false); // Создаём LSM хранилище с путём к файлу
+        Error = Storage->open(); // Пытаемся открыть по невалидному пути
+
+        // Результат должен вернуть ошибку не соответствия пути директории
+        ASSERT_TRUE(Error.value() == static_cast<int32_t>(errors::eSystemErrorEx::seObjectNotDir));
+        ASSERT_FALSE(Storage->is_open()); // Хранилище не должно считаться открытым
+
+        std::filesystem::remove(FilePath, Error); // Удаляем временный файл
+    }
+
+    {   // Попытка открыть хранилище (Источник не существующая директория)
+        std::unique_ptr<HMDataStorage> Storage = makeStorage(C_LSM_PATH); // Создаём LSM хранилище с путём к директории
+
+        Error = Storage->open();
+
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+        EXPECT_TRUE(Storage->is_open()); // Хранилище должно считаться открытым
+
+        Storage->close();
+    }
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит добавление пользователя
+ */
+TEST(LsmDataStorage, addUser)
+{
+    HardDataStorage_AddUserTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит обновление пользователя
+ */
+TEST(LsmDataStorage, updateUser)
+{
+    HardDataStorage_UpdateUserTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит поиск пользователья по UUID
+ */
+TEST(LsmDataStorage, findUserByUUID)
+{
+    HardDataStorage_FindUserByUUIDTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит поиск пользователья по данным аутентификации
+ */
+TEST(LsmDataStorage, findUserByAuthentication)
+{
+    HardDataStorage_FindUserByAuthenticationTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление пользователя из хранилище
+ */
+TEST(LsmDataStorage, removeUser)
+{
+    HardDataStorage_RemoveUserTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит создание связи пользователь-контакты (НЕ ДОЛЖНО ВЫПОЛНЯТЬСЯ ПОЛЬЗОВАТЕЛЕМ)
+ */
+TEST(LsmDataStorage, setUserContacts)
+{
+    HardDataStorage_SetUserContactsTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит добавление контакта пользователю
+ */
+TEST(LsmDataStorage, addUserContact)
+{
+    HardDataStorage_AddUserContactTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление контакта пользователя
+ */
+TEST(LsmDataStorage, removeUserContact)
+{
+    HardDataStorage_RemoveUserContactTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление связи пользователь-контакты (НЕ ДОЛЖНО ВЫПОЛНЯТЬСЯ ПОЛЬЗОВАТЕЛЕМ)
+ */
+TEST(LsmDataStorage, clearUserContacts)
+{
+    HardDataStorage_ClearUserContactsTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит получение списка контатков пользователя
+ */
+TEST(LsmDataStorage, getUserContactList)
+{
+    HardDataStorage_GetUserContactListTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит получение списка UUID'ов групп пользователя
+ */
+TEST(LsmDataStorage, getUserGroups)
+{
+    HardDataStorage_GetUserGroupsTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит добавление группы
+ */
+TEST(LsmDataStorage, addGroup)
+{
+    HardDataStorage_AddGroupTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит обновление группы
+ */
+TEST(LsmDataStorage, updateGroup)
+{
+    HardDataStorage_UpdateGroupTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит поиск группы по UUID
+ */
+TEST(LsmDataStorage, findGroupByUUID)
+{
+    HardDataStorage_FindGroupByUUIDTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление группы
+ */
+TEST(LsmDataStorage, removeGroup)
+{
+    HardDataStorage_RemoveGroupTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит присвоение списка участников группе
+ */
+TEST(LsmDataStorage, setGroupUsers)
+{
+    HardDataStorage_SetGroupUsersTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит добавление пользователя в группу
+ */
+TEST(LsmDataStorage, addGroupUser)
+{
+    HardDataStorage_AddGroupUserTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление пользователя из группы
+ */
+TEST(LsmDataStorage, removeGroupUser)
+{
+    HardDataStorage_RemoveGroupUserTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит очистку списка участников группы
+ */
+TEST(LsmDataStorage, clearGroupUsers)
+{
+    HardDataStorage_ClearGroupUsersTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит получение списка UUID'ов участников группы
+ */
+TEST(LsmDataStorage, getGroupUserList)
+{
+    HardDataStorage_GetGroupUserListTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит добовление сообщения
+ */
+TEST(LsmDataStorage, addMessage)
+{
+    HardDataStorage_AddMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит обновление сообщения
+ */
+TEST(LsmDataStorage, updateMessage)
+{
+    HardDataStorage_UpdateMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит поиск сообщения по UUID
+ */
+TEST(LsmDataStorage, findMessage)
+{
+    HardDataStorage_FindMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит поиск перечня сообщений по временному промежутку
+ */
+TEST(LsmDataStorage, findMessages)
+{
+    HardDataStorage_FindMessagesTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит постраничный поиск сообщений относительно курсора
+ */
+TEST(LsmDataStorage, findMessagesPage)
+{
+    HardDataStorage_FindMessagesPageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит удаление сообщения
+ */
+TEST(LsmDataStorage, removeMessage)
+{
+    HardDataStorage_RemoveMessageTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит транзакции хранилища
+ */
+TEST(LsmDataStorage, transaction)
+{
+    HardDataStorage_TransactionTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит принадлежность транзакции открывшему её потоку
+ */
+TEST(LsmDataStorage, transactionOwner)
+{
+    HardDataStorage_TransactionOwnerTest(makeStorage()); // Создаём хранилище и выполняем тест
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что изменения транзакции не видны другим потокам до её фиксации
+ */
+TEST(LsmDataStorage, transactionIsolation)
+{
+    errors::error_code Error; // Метка ошибки
+    std::unique_ptr<HMDataStorage> Storage = makeStorage();
+
+    Error = Storage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+
+    ASSERT_FALSE(Storage->beginTransaction());
+    ASSERT_FALSE(Storage->addUser(NewUser));
+
+    std::shared_ptr<hmcommon::HMUserInfo> FindUser = Storage->findUserByUUID(NewUser->m_uuid, Error);
+    ASSERT_FALSE(Error); // Свои изменения транзакция видит
+    EXPECT_NE(FindUser, nullptr);
+
+    std::thread([&]()
+    {
+        FindUser = Storage->findUserByUUID(NewUser->m_uuid, Error); // Другой поток видит только записанные данные
+    }).join();
+
+    EXPECT_EQ(FindUser, nullptr);
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsUserNotExists));
+
+    ASSERT_FALSE(Storage->commitTransaction());
+
+    std::thread([&]()
+    {
+        FindUser = Storage->findUserByUUID(NewUser->m_uuid, Error); // После фиксации изменения видны всем
+    }).join();
+
+    EXPECT_FALSE(Error);
+    EXPECT_NE(FindUser, nullptr);
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест сохранения хранилища на диск
+ */
+TEST(LsmDataStorage, CheckLsmSave)
+{
+    errors::error_code Error; // Метка ошибки
+    std::unique_ptr<HMDataStorage> Storage = makeStorage(); // Создаём LSM хранилище
+
+    Error = Storage->open(); // Пытаемся открыть хранилище
+
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_TRUE(Storage->is_open()); // Хранилище должно считаться открытым
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info(); // Формируем пользователя
+
+    Error = Storage->addUser(NewUser);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    // Формируем для пользователя список контактов
+    const std::size_t ContactsCount = 5;
+    std::array<std::shared_ptr<hmcommon::HMUserInfo>, ContactsCount> Contacts;
+
+    for (std::size_t Index = 0; Index < ContactsCount; ++Index)
+    {
+        QString ContactLogin = "Contact@login." + QString::number(Index); // У каждого пользователья должен быть уникальный UUID и логин
+        Contacts[Index] = testscommon::make_user_info(QUuid::createUuid(), ContactLogin);
+        Contacts[Index]->setName("User contact " + QString::number(Index));
+        // Добавляем контакт в хранилище (Потому что контакт должен существовать)
+        Error = Storage->addUser(Contacts[Index]);
+        EXPECT_FALSE(Error);
+        // Добавляем контакт пользователю
+        Error = Storage->addUserContact(NewUser->m_uuid, Contacts[Index]->m_uuid);
+        EXPECT_FALSE(Error);
+    }
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info(); // Формируем новую группу
+
+    Error = Storage->addGroup(NewGroup);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    // Добавляем сообщения в группу
+
+    const size_t MESSAGES = 5;
+    std::array<std::shared_ptr<hmcommon::HMGroupInfoMessage>, MESSAGES> Messages;
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index)
+    {
+        hmcommon::MsgData Data(hmcommon::eMsgType::mtText, "ТЕКСТ сообщения");
+        Messages[Index] = testscommon::make_groupmessage(Data, QUuid::createUuid(), NewGroup->m_uuid);
+
+        Error = Storage->addMessage(Messages[Index]);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    // Добавляем участников в группу (из ранее созданных пользователей)
+    for (std::size_t Index = 0; Index < ContactsCount; ++Index)
+    {
+        Error = Storage->addGroupUser(NewGroup->m_uuid, Contacts[Index]->m_uuid);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    std::shared_ptr<std::set<QUuid>> GroupUsers = Storage->getGroupUserList(NewGroup->m_uuid, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_NE(GroupUsers, nullptr); // Должен вернуться валидный указатель
+    EXPECT_EQ(Contacts.size(), GroupUsers->size()); // Количество контактов должно совпасть
+
+    // Переоткрываем хранилище
+    Storage->close();
+    Error = Storage->open(); // Пытаемся открыть хранилище
+
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_TRUE(Storage->is_open()); // Хранилище должно считаться открытым
+
+    std::shared_ptr<hmcommon::HMUserInfo> FindUser = Storage->findUserByUUID(NewUser->m_uuid, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_NE(FindUser, nullptr); // Должен вернуться валидный указатель
+
+    std::shared_ptr<hmcommon::HMGroupInfo> FindGroup = Storage->findGroupByUUID(NewGroup->m_uuid, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_NE(FindGroup, nullptr); // Должен вернуться валидный указатель
+
+    EXPECT_EQ(NewGroup->m_uuid, FindGroup->m_uuid);
+    EXPECT_EQ(NewGroup->m_registrationDate, FindGroup->m_registrationDate);
+    EXPECT_EQ(NewGroup->getName(), FindGroup->getName());
+
+    // А теперь сравниваем все параметры записанного и считанного
+    EXPECT_EQ(NewUser->m_uuid, FindUser->m_uuid);
+    EXPECT_EQ(NewUser->m_registrationDate, FindUser->m_registrationDate);
+    EXPECT_EQ(NewUser->getName(), FindUser->getName());
+    EXPECT_EQ(NewUser->getLogin(), FindUser->getLogin());
+    EXPECT_EQ(NewUser->getPasswordHash(), FindUser->getPasswordHash());
+    EXPECT_EQ(NewUser->getSex(), FindUser->getSex());
+    EXPECT_EQ(NewUser->getBirthday(), FindUser->getBirthday());
+
+    std::shared_ptr<std::set<QUuid>> FindUCList = Storage->getUserContactList(FindUser->m_uuid, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_NE(FindUCList, nullptr); // Должен вернуться валидный указатель
+    ASSERT_EQ(FindUCList->size(), MESSAGES); // Количество контактов должно быть прежним
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index)
+        ASSERT_NE(FindUCList->find(Contacts[Index]->m_uuid), FindUCList->end()); // Проверяем что контакт есть в списке
+
+    std::shared_ptr<std::set<QUuid>> FindGroupUsers = Storage->getGroupUserList(NewGroup->m_uuid, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_NE(FindGroupUsers, nullptr); // Должен вернуться валидный указатель
+    EXPECT_EQ(*GroupUsers, *FindGroupUsers); // Сравниваем UUID'ы участников группы
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index)
+    {
+        std::shared_ptr<hmcommon::HMGroupInfoMessage> FindRes = Storage->findMessage(Messages[Index]->m_uuid, Error);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+        ASSERT_NE(FindGroup, nullptr); // Должен вернуться валидный указатель
+
+        EXPECT_EQ(Messages[Index]->m_uuid, FindRes->m_uuid);
+        EXPECT_EQ(Messages[Index]->m_group, FindRes->m_group);
+        EXPECT_EQ(Messages[Index]->m_createTime, FindRes->m_createTime);
+
+        auto Data1 = Messages[Index]->getMesssage();
+        auto Data2 = FindRes->getMesssage();
+
+        EXPECT_EQ(Data1.m_type, Data2.m_type);
+        EXPECT_EQ(Data1.m_data, Data2.m_data);
+    }
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит сброс данных в сегменты, уплотнение и восстановление после переоткрытия
+ */
+TEST(LsmDataStorage, compaction)
+{
+    errors::error_code Error; // Метка ошибки
+    std::filesystem::remove_all(C_LSM_PATH, Error);
+
+    // Маленькая memtable, чтобы данные гарантированно попали в несколько сегментов
+    std::unique_ptr<HMLsmDataStorage> Storage = std::make_unique<HMLsmDataStorage>(C_LSM_PATH, 4 * 1024, 2);
+
+    Error = Storage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info(); // Формируем новую группу
+    Error = Storage->addGroup(NewGroup);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    const std::size_t MESSAGES = 500;
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> Messages;
+    const QDateTime BaseTime = QDateTime::currentDateTime();
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index)
+    {
+        hmcommon::MsgData Data(hmcommon::eMsgType::mtText, "ТЕКСТ сообщения " + QString::number(Index));
+        Messages.push_back(testscommon::make_groupmessage(Data, QUuid::createUuid(), NewGroup->m_uuid, BaseTime.addMSecs(static_cast<qint64>(Index))));
+
+        Error = Storage->addMessage(Messages.back());
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    for (std::size_t Index = 0; Index < MESSAGES; Index += 2) // Удаляем каждое второе сообщение
+    {
+        Error = Storage->removeMessage(Messages[Index]->m_uuid, NewGroup->m_uuid);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    Error = Storage->compact();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    // Переоткрываем хранилище
+    Storage->close();
+    Error = Storage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> FindRes = Storage->findMessages(NewGroup->m_uuid, hmcommon::MsgRange(BaseTime, BaseTime.addMSecs(static_cast<qint64>(MESSAGES))), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_EQ(FindRes.size(), MESSAGES / 2); // Должны остаться только не удалённые сообщения
+
+    for (std::size_t Index = 0; Index < FindRes.size(); ++Index) // Сообщения отсортированы по времени
+        EXPECT_EQ(FindRes[Index]->m_uuid, Messages[Index * 2 + 1]->m_uuid);
+
+    Storage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что сбой между публикацией результата уплотнения и удалением заменённых сегментов не возвращает удалённые ключи
+ */
+TEST(LsmDataStorage, interruptedCompaction)
+{
+    errors::error_code Error; // Метка ошибки
+    const std::filesystem::path EnginePath = C_LSM_PATH / "Engine";
+    const std::filesystem::path BackupPath = C_LSM_PATH / "Backup";
+
+    std::filesystem::remove_all(C_LSM_PATH, Error);
+    std::filesystem::create_directories(BackupPath, Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    // Значение и его метка удаления попадают в разные сегменты (закрытие сбрасывает memtable)
+    for (const bool Remove : { false, true })
+    {
+        hmservcommon::datastorage::HMLsmEngine Engine(EnginePath);
+        ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+
+        hmservcommon::datastorage::HMLsmWriteBatch Batch;
+        if (Remove)
+            Batch.remove("Removed");
+        else
+        {
+            Batch.put("Removed", "Value");
+            Batch.put("Kept", "Value");
+        }
+
+        ASSERT_FALSE(Engine.write(Batch)); // Ошибки быть не должно
+        Engine.close();
+    }
+
+    for (const auto& Entry : std::filesystem::directory_iterator(EnginePath)) // Сохраняем сегменты до уплотнения
+        std::filesystem::copy_file(Entry.path(), BackupPath / Entry.path().filename());
+
+    {
+        hmservcommon::datastorage::HMLsmEngine Engine(EnginePath);
+        ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+        EXPECT_EQ(Engine.segmentsCount(), 2u);
+
+        ASSERT_FALSE(Engine.compact()); // Ошибки быть не должно
+        EXPECT_EQ(Engine.segmentsCount(), 1u); // Уплотнённый сегмент не содержит метки удаления
+        Engine.close();
+    }
+
+    // Возвращаем удалённые уплотнением файлы, как если бы сбой случился до их удаления
+    for (const auto& Entry : std::filesystem::directory_iterator(BackupPath))
+        if (!std::filesystem::exists(EnginePath / Entry.path().filename()))
+            std::filesystem::copy_file(Entry.path(), EnginePath / Entry.path().filename());
+
+    hmservcommon::datastorage::HMLsmEngine Engine(EnginePath);
+    ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+    EXPECT_EQ(Engine.segmentsCount(), 1u); // Заменённые сегменты должны быть отброшены
+
+    std::string Value;
+    EXPECT_FALSE(Engine.get("Removed", Value, Error)); // Удалённый ключ не должен вернуться
+    EXPECT_FALSE(Error); // Ошибки быть не должно
+    EXPECT_TRUE(Engine.get("Kept", Value, Error)); // Остальные данные на месте
+    EXPECT_EQ(Value, "Value");
+
+    Engine.close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что сканирование, идущее одновременно с уплотнением, видит согласованные данные
+ */
+TEST(LsmDataStorage, scanDuringCompaction)
+{
+    errors::error_code Error; // Метка ошибки
+    const std::filesystem::path EnginePath = C_LSM_PATH / "Engine";
+    const std::size_t KEYS = 128;
+    const std::size_t COMPACTIONS = 24;
+
+    std::filesystem::remove_all(C_LSM_PATH, Error);
+
+    auto MakeKey = [](const std::size_t inIndex)
+    {
+        std::string Key = std::to_string(inIndex);
+        return std::string(4 - Key.size(), '0') + Key; // Ключи сортируются так же как номера
+    };
+
+    // Маленькая memtable сбрасывается в сегменты на ходу, уплотнение запускается только явно
+    hmservcommon::datastorage::HMLsmEngine Engine(EnginePath, 256, std::numeric_limits<std::size_t>::max());
+    ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+
+    std::atomic<bool> Stop(false);
+    std::atomic<std::size_t> Scans(0);
+    errors::error_code WriteError;
+
+    std::thread Writer([&]()
+    {
+        for (std::size_t Compaction = 0; !WriteError && Compaction < COMPACTIONS; ++Compaction)
+        {
+            for (std::size_t Index = 0; !WriteError && Index < KEYS; ++Index) // Перезаписываем все ключи тем же значением
+            {
+                hmservcommon::datastorage::HMLsmWriteBatch Batch;
+                Batch.put(MakeKey(Index), "Value");
+                WriteError = Engine.write(Batch);
+            }
+
+            if (!WriteError) // Уплотнение заменяет файлы сегментов, которые могут читаться сканированием
+                WriteError = Engine.compact();
+        }
+
+        Stop = true;
+    });
+
+    while (!Stop || !Scans) // Сканируем, пока идут уплотнения
+    {
+        std::size_t Count = 0;
+        bool Consistent = true;
+
+        Error = Engine.scan("", "", [&](const std::string& inKey, const hmservcommon::datastorage::LsmValue& inValue)
+        {
+            Consistent &= (inKey == MakeKey(Count) && inValue && *inValue == "Value");
+            ++Count;
+            return Consistent;
+        });
+
+        ASSERT_FALSE(Error) << Error.message(); // Файлы сегментов снимка не должны пропадать
+        ASSERT_TRUE(Consistent); // Записи должны читаться по индексу своего сегмента
+
+        if (Scans) // Первое сканирование могло опередить запись
+            ASSERT_EQ(Count, KEYS);
+
+        if (Count == KEYS)
+            ++Scans;
+    }
+
+    Writer.join();
+    EXPECT_FALSE(WriteError); // Ошибки быть не должно
+
+    Engine.close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief TEST - Тест проверит, что наборы изменений, записанные одновременно (группами), переживают переоткрытие
+ */
+TEST(LsmDataStorage, groupCommit)
+{
+    errors::error_code Error; // Метка ошибки
+    const std::filesystem::path EnginePath = C_LSM_PATH / "Engine";
+    const std::size_t WRITERS = 16;
+    const std::size_t WRITES = 256;
+
+    std::filesystem::remove_all(C_LSM_PATH, Error);
+
+    {
+        hmservcommon::datastorage::HMLsmEngine Engine(EnginePath);
+        ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+
+        std::atomic<std::size_t> Failures(0);
+        std::vector<std::thread> Writers;
+
+        for (std::size_t Writer = 0; Writer < WRITERS; ++Writer)
+        {
+            Writers.emplace_back([&, Writer]()
+            {
+                for (std::size_t Index = 0; Index < WRITES; ++Index)
+                {
+                    hmservcommon::datastorage::HMLsmWriteBatch Batch;
+                    Batch.put(std::to_string(Writer) + ":" + std::to_string(Index), std::to_string(Index));
+                    Batch.put(std::to_string(Writer) + ":Last", std::to_string(Index)); // Наборы потока применяются по порядку
+
+                    if (Engine.write(Batch))
+                        ++Failures;
+                }
+            });
+        }
+
+        for (auto& Writer : Writers)
+            Writer.join();
+
+        EXPECT_EQ(Failures, 0);
+    } // Деструктор закроет хранилище
+
+    hmservcommon::datastorage::HMLsmEngine Engine(EnginePath);
+    ASSERT_FALSE(Engine.open()); // Ошибки быть не должно
+
+    for (std::size_t Writer = 0; Writer < WRITERS; ++Writer)
+    {
+        std::string Value;
+
+        for (std::size_t Index = 0; Index < WRITES; ++Index)
+        {
+            ASSERT_TRUE(Engine.get(std::to_string(Writer) + ":" + std::to_string(Index), Value, Error));
+            EXPECT_EQ(Value, std::to_string(Index));
+        }
+
+        ASSERT_TRUE(Engine.get(std::to_string(Writer) + ":Last", Value, Error));
+        EXPECT_EQ(Value, std::to_string(WRITES - 1));
+    }
+
+    Engine.close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief main - Входная точка тестировани функционала HMLsmDataStorage
+ * @param argc - Количество аргументов
+ * @param argv - Перечень аргументов
+ * @return Вернёт признак успешности тестирования
+ */
+int main(int argc, char *argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
+//-----------------------------------------------------------------------------
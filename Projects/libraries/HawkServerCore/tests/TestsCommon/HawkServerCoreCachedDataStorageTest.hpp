@@ -716,6 +716,15 @@ void CachedDataStorage_FindMessagesTest(std::unique_ptr<HMDataStorage> inCachedD
     ASSERT_TRUE(true); // Кеширование сообщений не поддерживается
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief CachedDataStorage_FindMessagesPageTest - Тест кеширующего хранилища, проверяющий постраничный поиск сообщений
+ * @param inCachedDataStorage - Тестируемое кеширующее хранилище
+ */
+void CachedDataStorage_FindMessagesPageTest(std::unique_ptr<HMDataStorage> inCachedDataStorage)
+{
+    ASSERT_TRUE(true); // Кеширование сообщений не поддерживается
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief CachedDataStorage_RemoveMessageTest - Тест физического хранилища, проверяющий удаление сообщения
  * @param inCachedDataStorage - Тестируемое физическое хранилище
@@ -1,6 +1,8 @@
 #ifndef HAWKSERVERCOREHARDDATASTORAGETEST_HPP
 #define HAWKSERVERCOREHARDDATASTORAGETEST_HPP
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <memory>
 
@@ -1006,6 +1008,83 @@ void HardDataStorage_FindMessagesTest(std::unique_ptr<HMDataStorage> inHardDataS
     inHardDataStorage->close();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief HardDataStorage_FindMessagesPageTest - Тест физического хранилища, проверяющий постраничный поиск сообщений
+ * @param inHardDataStorage - Тестируемое физическое хранилище
+ */
+void HardDataStorage_FindMessagesPageTest(std::unique_ptr<HMDataStorage> inHardDataStorage)
+{
+    errors::error_code Error; // Метка ошибки
+
+    Error = inHardDataStorage->open(); // Пытаемся открыть хранилище
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_TRUE(inHardDataStorage->is_open()); // Хранилище должно считаться открытым
+
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+
+    Error = inHardDataStorage->addGroup(NewGroup); // добавляем группу сообщения
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    const size_t MESSAGES = 7;
+    const QDateTime BaseTime = QDateTime::currentDateTime();
+    std::array<std::shared_ptr<hmcommon::HMGroupInfoMessage>, MESSAGES> Messages;
+
+    for (std::size_t Index = 0; Index < MESSAGES; ++Index)
+    {   // Первое сообщение сильно старше остальных, чтобы поиск "до курсора" ушёл далеко в прошлое
+        const QDateTime Time = (Index == 0) ? BaseTime.addDays(-30) : BaseTime.addMSecs(static_cast<qint64>(Index * 10));
+        hmcommon::MsgData TextData(hmcommon::eMsgType::mtText, ("Текст сообщения " + QString::number(Index)).toLocal8Bit()); // Формируем данные сообщения
+        Messages[Index] = testscommon::make_groupmessage(TextData, QUuid::createUuid(), NewGroup->m_uuid, Time); // Формируем сообщение группы
+
+        Error = inHardDataStorage->addMessage(Messages[Index]);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+    }
+
+    // Проверит, что страница совпадает с сообщениями [inFirst, inFirst + inCount)
+    auto CheckPage = [&](const std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>>& inPage, const std::size_t inFirst, const std::size_t inCount)
+    {
+        ASSERT_EQ(inPage.size(), inCount);
+
+        for (std::size_t Index = 0; Index < inCount; ++Index)
+        {
+            EXPECT_EQ(inPage[Index]->m_uuid, Messages[inFirst + Index]->m_uuid);
+            EXPECT_EQ(inPage[Index]->m_createTime, Messages[inFirst + Index]->m_createTime);
+            EXPECT_EQ(inPage[Index]->getMesssage().m_data, Messages[inFirst + Index]->getMesssage().m_data);
+        }
+    };
+
+    std::vector<std::shared_ptr<hmcommon::HMGroupInfoMessage>> FindRes;
+    // Курсор по времени включает сообщения этого времени при поиске "после"
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(Messages[0]->m_createTime, hmcommon::eMsgPageDirection::pdAfter, 3), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    CheckPage(FindRes, 0, 3);
+    // Следующая страница от последнего полученного сообщения (само сообщение не входит)
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(FindRes.back()->m_createTime, hmcommon::eMsgPageDirection::pdAfter, 3, FindRes.back()->m_uuid), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    CheckPage(FindRes, 3, 3);
+    // Страница, на которой осталось меньше сообщений, чем лимит
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(FindRes.back()->m_createTime, hmcommon::eMsgPageDirection::pdAfter, 3, FindRes.back()->m_uuid), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    CheckPage(FindRes, 6, 1);
+    // Ближайшие к курсору сообщения "до"
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(Messages[5]->m_createTime, hmcommon::eMsgPageDirection::pdBefore, 2, Messages[5]->m_uuid), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    CheckPage(FindRes, 3, 2);
+    // Поиск "до" должен дойти до самого старого сообщения
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(Messages[2]->m_createTime, hmcommon::eMsgPageDirection::pdBefore, 5, Messages[2]->m_uuid), Error);
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    CheckPage(FindRes, 0, 2);
+    // Курсор по времени исключает сообщения этого времени при поиске "до"
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(Messages[0]->m_createTime, hmcommon::eMsgPageDirection::pdBefore, 3), Error);
+    ASSERT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsMessageNotExists)); // Сообщений до первого нет
+    EXPECT_TRUE(FindRes.empty());
+    // Пустая страница не имеет смысла
+    FindRes = inHardDataStorage->findMessagesPage(NewGroup->m_uuid, hmcommon::MsgCursor(BaseTime, hmcommon::eMsgPageDirection::pdAfter, 0), Error);
+    ASSERT_EQ(Error.value(), static_cast<int32_t>(errors::eSystemErrorEx::seIncorretData));
+    EXPECT_TRUE(FindRes.empty());
+
+    inHardDataStorage->close();
+}
+//-----------------------------------------------------------------------------
 /**
  * @brief HardDataStorage_RemoveMessageTest - Тест физического хранилища, проверяющий удаление сообщения
  * @param inHardDataStorage - Тестируемое физическое хранилище
@@ -1041,5 +1120,146 @@ void HardDataStorage_RemoveMessageTest(std::unique_ptr<HMDataStorage> inHardData
     inHardDataStorage->close();
 }
 //-----------------------------------------------------------------------------
+/**
+ * @brief HardDataStorage_TransactionTest - Тест физического хранилища, проверяющий транзакции
+ * @param inHardDataStorage - Тестируемое физическое хранилище
+ */
+void HardDataStorage_TransactionTest(std::unique_ptr<HMDataStorage> inHardDataStorage)
+{
+    errors::error_code Error;
+
+    Error = inHardDataStorage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+    ASSERT_TRUE(inHardDataStorage->is_open()); // Хранилище должно считаться открытым
+
+    Error = inHardDataStorage->commitTransaction(); // Пытаемся завершить не начатую транзакцию
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+
+    Error = inHardDataStorage->rollbackTransaction(); // Пытаемся отменить не начатую транзакцию
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+    std::shared_ptr<hmcommon::HMGroupInfo> NewGroup = testscommon::make_group_info();
+
+    {   // Отмена транзакции
+        Error = inHardDataStorage->beginTransaction();
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        ASSERT_FALSE(inHardDataStorage->addUser(NewUser));
+        ASSERT_FALSE(inHardDataStorage->addGroup(NewGroup));
+        ASSERT_FALSE(inHardDataStorage->addGroupUser(NewGroup->m_uuid, NewUser->m_uuid));
+
+        std::shared_ptr<hmcommon::HMUserInfo> FindUser = inHardDataStorage->findUserByUUID(NewUser->m_uuid, Error);
+        ASSERT_FALSE(Error); // Изменения транзакции должны быть видны до её завершения
+        ASSERT_NE(FindUser, nullptr);
+
+        Error = inHardDataStorage->rollbackTransaction();
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        FindUser = inHardDataStorage->findUserByUUID(NewUser->m_uuid, Error);
+        EXPECT_EQ(FindUser, nullptr); // Пользователь должен исчезнуть вместе с транзакцией
+        EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsUserNotExists));
+
+        std::shared_ptr<hmcommon::HMGroupInfo> FindGroup = inHardDataStorage->findGroupByUUID(NewGroup->m_uuid, Error);
+        EXPECT_EQ(FindGroup, nullptr); // Группа должна исчезнуть вместе с транзакцией
+        EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsGroupNotExists));
+    }
+
+    {   // Отмена внешней транзакции отменяет и завершённую вложенную
+        ASSERT_FALSE(inHardDataStorage->beginTransaction());
+        ASSERT_FALSE(inHardDataStorage->beginTransaction());
+        ASSERT_FALSE(inHardDataStorage->addUser(NewUser));
+        ASSERT_FALSE(inHardDataStorage->commitTransaction()); // Завершаем вложенную транзакцию
+
+        Error = inHardDataStorage->rollbackTransaction(); // Отменяем внешнюю
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        std::shared_ptr<hmcommon::HMUserInfo> FindUser = inHardDataStorage->findUserByUUID(NewUser->m_uuid, Error);
+        EXPECT_EQ(FindUser, nullptr); // Пользователь не должен сохраниться
+        EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsUserNotExists));
+
+        Error = inHardDataStorage->commitTransaction(); // Отмена завершила транзакцию целиком
+        EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+    }
+
+    {   // Фиксация транзакции
+        ASSERT_FALSE(inHardDataStorage->beginTransaction());
+        ASSERT_FALSE(inHardDataStorage->addUser(NewUser));
+        ASSERT_FALSE(inHardDataStorage->addGroup(NewGroup));
+        ASSERT_FALSE(inHardDataStorage->addGroupUser(NewGroup->m_uuid, NewUser->m_uuid));
+
+        Error = inHardDataStorage->commitTransaction();
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        inHardDataStorage->close(); // Зафиксированные изменения должны пережить переоткрытие хранилища
+
+        Error = inHardDataStorage->open();
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+
+        std::shared_ptr<hmcommon::HMUserInfo> FindUser = inHardDataStorage->findUserByUUID(NewUser->m_uuid, Error);
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+        ASSERT_NE(FindUser, nullptr); // Пользователь должен быть найден
+
+        std::shared_ptr<std::set<QUuid>> GroupUsers = inHardDataStorage->getGroupUserList(NewGroup->m_uuid, Error); // Запрашиваем список участников группы
+        ASSERT_FALSE(Error); // Ошибки быть не должно
+        ASSERT_NE(GroupUsers, nullptr); // Должен вернуться валидный указаетль
+        EXPECT_NE(GroupUsers->find(NewUser->m_uuid), GroupUsers->cend()); // Пользователь должен быть участником группы
+    }
+
+    inHardDataStorage->close();
+}
+//-----------------------------------------------------------------------------
+/**
+ * @brief HardDataStorage_TransactionOwnerTest - Тест хранилища, проверяющий принадлежность транзакции открывшему её потоку
+ * @param inDataStorage - Тестируемое хранилище
+ */
+void HardDataStorage_TransactionOwnerTest(std::unique_ptr<HMDataStorage> inDataStorage)
+{
+    errors::error_code Error;
+
+    Error = inDataStorage->open();
+    ASSERT_FALSE(Error); // Ошибки быть не должно
+
+    std::shared_ptr<hmcommon::HMUserInfo> NewUser = testscommon::make_user_info();
+    std::shared_ptr<hmcommon::HMUserInfo> OtherUser = testscommon::make_user_info(QUuid::createUuid(), "OtherUser@login.com");
+
+    ASSERT_FALSE(inDataStorage->beginTransaction());
+    ASSERT_FALSE(inDataStorage->addUser(NewUser));
+
+    std::atomic<bool> Added(false);
+    errors::error_code OtherCommitError;
+    errors::error_code OtherRollbackError;
+    errors::error_code OtherAddError;
+
+    std::thread Other([&]()
+    {
+        OtherCommitError = inDataStorage->commitTransaction(); // Чужую транзакцию завершить нельзя
+        OtherRollbackError = inDataStorage->rollbackTransaction(); // Как и отменить
+        OtherAddError = inDataStorage->addUser(OtherUser); // Изменение дождётся завершения транзакции
+        Added = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(Added); // Пока транзакция открыта, изменение другого потока ждёт
+
+    Error = inDataStorage->rollbackTransaction();
+    Other.join();
+
+    ASSERT_FALSE(Error); // Транзакция принадлежит этому потоку
+    EXPECT_EQ(OtherCommitError.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+    EXPECT_EQ(OtherRollbackError.value(), static_cast<int32_t>(errors::eDataStorageError::dsTransactionNotStarted));
+    EXPECT_FALSE(OtherAddError); // Изменение другого потока не входит в отменённую транзакцию
+
+    std::shared_ptr<hmcommon::HMUserInfo> FindUser = inDataStorage->findUserByUUID(NewUser->m_uuid, Error);
+    EXPECT_EQ(FindUser, nullptr); // Пользователь транзакции отменён
+    EXPECT_EQ(Error.value(), static_cast<int32_t>(errors::eDataStorageError::dsUserNotExists));
+
+    FindUser = inDataStorage->findUserByUUID(OtherUser->m_uuid, Error);
+    EXPECT_FALSE(Error); // Пользователь другого потока сохранён
+    EXPECT_NE(FindUser, nullptr);
+
+    inDataStorage->close();
+}
+//-----------------------------------------------------------------------------
 
 #endif // HAWKSERVERCOREHARDDATASTORAGETEST_HPP
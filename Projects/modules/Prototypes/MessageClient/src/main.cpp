@@ -50,7 +50,7 @@ int main(int argc, char *argv[])
         LOG_ERROR(Error.message_qstr());
     else
     {
-        LOG_INFO("Клиент успешно подключен к серверу.");
+        LOG_INFO("Клиент подключается к серверу.");
 
         QObject::connect(&Interactive, &QInteractive::sig_sendMessage, &PClient, &PrototypeClient::slot_send);
         Thread.start();
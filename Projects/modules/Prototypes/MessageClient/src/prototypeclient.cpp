@@ -16,27 +16,33 @@ errors::error_code PrototypeClient::connect(const std::string& inHost, const std
 {
     disconnect();
 
-    m_client = makeClient(inHost, inPort);
-    assert(m_client != nullptr);
+    m_client = std::make_unique<net::HMClientManager>([this, inHost, inPort](const net::ConCallbacks& inCallBacks)
+    {
+        std::unique_ptr<net::HMConnection> Connection = makeClient(inHost, inPort, inCallBacks);
+        assert(Connection != nullptr);
+        Connection->setFramingMode(net::eFramingMode::fmLengthPrefixed); // Двоичные заголовки не требуют обёртки данных
+
+        return Connection;
+    }, makeCallBacks());
 
-    return m_client->connect();
+    return m_client->start(); // Недоступный сервер не блокирует вызывающего: менеджер повторит попытку сам
 }
 //-----------------------------------------------------------------------------
 void PrototypeClient::disconnect()
 {
-    if (m_client && m_client->isConnected())
+    if (m_client)
     {
-        m_client->disconnect();
+        m_client->stop();
         m_client = nullptr;
     }
 }
 //-----------------------------------------------------------------------------
-errors::error_code PrototypeClient::send(net::oByteStream&& inData)
+errors::error_code PrototypeClient::send(net::HMByteBuffer&& inData)
 {
     if (!m_client)
         return make_error_code(errors::eNetError::neSocketNotInit);
 
-    return m_client->send(net::wrap(std::move(inData)));
+    return m_client->send(std::move(inData));
 }
 //-----------------------------------------------------------------------------
 net::ConCallbacks PrototypeClient::makeCallBacks()
@@ -44,34 +50,47 @@ net::ConCallbacks PrototypeClient::makeCallBacks()
     net::ConCallbacks CallBacks;
 
     CallBacks.m_DataCallBack =        std::bind(&PrototypeClient::onReceiveData, this, std::placeholders::_1, std::placeholders::_2);
+    CallBacks.m_ConnectCallBack =     std::bind(&PrototypeClient::onConnect, this, std::placeholders::_1, std::placeholders::_2);
     CallBacks.m_DisconnectCallBack =  std::bind(&PrototypeClient::onDisconnect, this, std::placeholders::_1);
     CallBacks.m_ErrorCallBack =       std::bind(&PrototypeClient::onError, this, std::placeholders::_1, std::placeholders::_2);
 
     return CallBacks;
 }
 //-----------------------------------------------------------------------------
-std::unique_ptr<net::HMConnection> PrototypeClient::makeClient(const std::string& inHost, const std::uint16_t inPort)
+std::unique_ptr<net::HMConnection> PrototypeClient::makeClient(const std::string& inHost, const std::uint16_t inPort, const net::ConCallbacks& inCallBacks)
 {
 #if (NET_IMPLEMENTATION==NET_IMPLEMENTATION_QT_SIMPLE)  // Сетевая реализация QtSimple
     LOG_INFO("QtSimple implementation client create");
-    return std::make_unique<net::HMQtSimpleAsyncConnection>(inHost, inPort, makeCallBacks());
+    return std::make_unique<net::HMQtSimpleAsyncConnection>(inHost, inPort, inCallBacks);
 #elif (NET_IMPLEMENTATION==NET_IMPLEMENTATION_QT_SSL)   // Сетевая реализация QtSsl
     LOG_INFO("QtSsl implementation client create");
-    return std::make_unique<net::HMQtSslAsyncConnection>(inHost, inPort, makeCallBacks());
+    return std::make_unique<net::HMQtSslAsyncConnection>(inHost, inPort, inCallBacks);
+#elif (NET_IMPLEMENTATION==NET_IMPLEMENTATION_EPOLL)     // Сетевая реализация epoll
+    LOG_INFO("Epoll implementation client create");
+    return std::make_unique<net::HMEpollAsyncConnection>(inHost, inPort, inCallBacks);
 #else
     return nullptr; // АХТУНГ ТОВАРИЩИ!
 #endif
 }
 //-----------------------------------------------------------------------------
-void PrototypeClient::onReceiveData(net::iByteStream&& inData, const std::size_t inSenderID)
+void PrototypeClient::onReceiveData(net::HMByteBuffer&& inData, const std::size_t inSenderID)
 {
     HM_UNUSED(inSenderID);
-    inData = net::unwrap(std::move(inData));
-    QString Text = QString::fromStdString(inData.str());
+    QString Text = QString::fromUtf8(inData.data(), static_cast<int>(inData.size()));
 
     LOG_TEXT(Text);
 }
 //-----------------------------------------------------------------------------
+void PrototypeClient::onConnect(const errors::error_code inError, const std::size_t inSenderID)
+{
+    HM_UNUSED(inSenderID);
+
+    if (inError)
+        LOG_ERROR("Connect failed: " + inError.message_qstr());
+    else
+        LOG_INFO("Connected");
+}
+//-----------------------------------------------------------------------------
 void PrototypeClient::onDisconnect(const std::size_t inSenderID)
 {
     HM_UNUSED(inSenderID);
@@ -88,5 +107,5 @@ void PrototypeClient::onError(const errors::error_code inError, const std::size_
 
 errors::error_code PrototypeClient::slot_send(std::string inStrData)
 {
-    return send(net::oByteStream(inStrData));
+    return send(net::HMByteBuffer(inStrData));
 }
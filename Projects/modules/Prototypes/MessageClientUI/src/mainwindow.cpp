@@ -44,7 +44,7 @@ void MainWindow::on_btnConnect_clicked()
     }
     else
     {
-        Str = "Connected";
+        Str = "Connecting"; // Исход подключения сообщит клиент
         LOG_INFO(Str);
     }
 
@@ -63,7 +63,7 @@ void MainWindow::on_btnSend_clicked()
     if (Text.empty())
         return;
 
-    errors::error_code Error = m_client.send(net::oByteStream(Text));
+    errors::error_code Error = m_client.send(net::HMByteBuffer(Text));
 
     if (Error)
     {
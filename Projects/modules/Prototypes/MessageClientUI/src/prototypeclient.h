@@ -24,7 +24,8 @@ public:
     ~PrototypeClient();
 
     /**
-     * @brief connect - Метод установит соединение с сервером
+     * @brief connect - Метод начнёт подключение к серверу, не дожидаясь его
+     * Разорванное соединение переподключается автоматически, исход попыток сообщается в лог.
      * @param inHost - Адрес хоста
      * @param inPort - Рабочий порт
      * @return Вернёт признак ошибки
@@ -41,12 +42,12 @@ public:
      * @param inData - Отправляемые данные
      * @return Вернёт признак ошибки
      */
-    errors::error_code send(net::oByteStream&& inData);
+    errors::error_code send(net::HMByteBuffer&& inData);
 
 
 private:
 
-    std::unique_ptr<net::HMConnection> m_client = nullptr; ///< Клиент
+    std::unique_ptr<net::HMClientManager> m_client = nullptr; ///< Клиент
 
     /**
      * @brief makeCallBacks - Метод сформирует калбэки
@@ -55,12 +56,13 @@ private:
     net::ConCallbacks makeCallBacks();
 
     /**
-     * @brief makeClient - Метод сформирует клиент
+     * @brief makeClient - Метод сформирует соединение клиента
      * @param inHost - Адрес хоста
      * @param inPort - Рабочий порт
-     * @return Вернёт указатель на сформерованный клиент
+     * @param inCallBacks - Калбэки соединения
+     * @return Вернёт указатель на сформерованное соединение
      */
-    std::unique_ptr<net::HMConnection> makeClient(const std::string& inHost, const std::uint16_t inPort);
+    std::unique_ptr<net::HMConnection> makeClient(const std::string& inHost, const std::uint16_t inPort, const net::ConCallbacks& inCallBacks);
 
     // Call Backs
 
@@ -69,7 +71,14 @@ private:
      * @param inData - Полученные данные
      * @param inSenderID - Идентификатор соединения
      */
-    void onReceiveData(net::iByteStream&& inData, const std::size_t inSenderID);
+    void onReceiveData(net::HMByteBuffer&& inData, const std::size_t inSenderID);
+
+    /**
+     * @brief onConnect - Завершена попытка подключения
+     * @param inError - Метка ошибки
+     * @param inSenderID - Идентификатор соединения
+     */
+    void onConnect(const errors::error_code inError, const std::size_t inSenderID);
 
     /**
      * @brief onDisconnect - Соединение разорвано
@@ -48,7 +48,7 @@ std::unique_ptr<net::HMServer> PrototypeServer::make_server(const std::int16_t i
 {
 #if (NET_IMPLEMENTATION==NET_IMPLEMENTATION_QT_SIMPLE)  // Сетевая реализация QtSimple
     LOG_INFO("QtSimple implementation server create");
-    return std::make_unique<net::HMQtSimpleAsyncServer>(inPort, makeCallBacks());
+    return std::make_unique<net::HMQtSimpleAsyncServer>(inPort, makeCallBacks(), net::HMQtWorkerPool::idealWorkersCount()); // Соединения обслуживаются рабочими потоками
 #elif (NET_IMPLEMENTATION==NET_IMPLEMENTATION_QT_SSL)   // Сетевая реализация QtSsl
     net::CertificatePaths certificatePaths;
 
@@ -56,7 +56,10 @@ std::unique_ptr<net::HMServer> PrototypeServer::make_server(const std::int16_t i
     certificatePaths.m_privateKey = std::filesystem::current_path() / "privateKey.key";
 
     LOG_INFO("QtSsl implementation server create");
-    return std::make_unique<net::HMQtSslAsyncServer>(inPort, certificatePaths, makeCallBacks());
+    return std::make_unique<net::HMQtSslAsyncServer>(inPort, certificatePaths, makeCallBacks(), net::HMQtWorkerPool::idealWorkersCount()); // Рукопожатия выполняются рабочими потоками
+#elif (NET_IMPLEMENTATION==NET_IMPLEMENTATION_EPOLL)     // Сетевая реализация epoll
+    LOG_INFO("Epoll implementation server create");
+    return std::make_unique<net::HMEpollAsyncServer>(inPort, makeCallBacks());
 #else
     return nullptr; // АХТУНГ ТОВАРИЩИ!
 #endif
@@ -67,18 +70,17 @@ void PrototypeServer::onNewConnection(const std::size_t inConnectionID)
     LOG_INFO("Client connected: [" + QString::number(inConnectionID) + "]");
 }
 //-----------------------------------------------------------------------------
-void PrototypeServer::onReceiveData(net::iByteStream&& inData, const std::size_t inSenderID)
+void PrototypeServer::onReceiveData(net::HMByteBuffer&& inData, const std::size_t inSenderID)
 {
     if (!m_server)
         return;
 
     {
         std::lock_guard lg(m_dataReceiveDefender);
-        LOG_TEXT("[" + QString::number(inSenderID) + "]: " + QString::fromStdString(inData.str()));
+        LOG_TEXT("[" + QString::number(inSenderID) + "]: " + QString::fromUtf8(inData.data(), static_cast<int>(inData.size())));
     }
 
-    net::oByteStream Data(inData.str());
-    auto SendResults = m_server->sendToAll(std::move(Data));
+    auto SendResults = m_server->sendToAll(std::move(inData)); // Принятый буфер рассылается всем без копирования
 
     for (const auto& SendRes : SendResults)
         LOG_ERROR("Send to [" + QString::number(SendRes.first) + "] ERROR: " + SendRes.second.message_qstr());
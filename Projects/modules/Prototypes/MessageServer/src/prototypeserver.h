@@ -63,7 +63,7 @@ private:
      * @param inData - Полученные данные
      * @param inSenderID - Идентификатор соединения
      */
-    void onReceiveData(net::iByteStream&& inData, const std::size_t inSenderID);
+    void onReceiveData(net::HMByteBuffer&& inData, const std::size_t inSenderID);
 
     /**
      * @brief onClientDisconnect - Соединение разорвано
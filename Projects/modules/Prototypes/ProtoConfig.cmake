@@ -4,8 +4,10 @@ set(EXECUTABLE_OUTPUT_PATH "${EXECUTABLE_OUTPUT_PATH}/prototypes")            #
 #====================================================================
 set(NET_IMPLEMENTATION_QT_SIMPLE 0) # Реализация сети на простом Qt Socket
 set(NET_IMPLEMENTATION_QT_SSL 1)    # Реализация сети на Qt Socket SSL
+set(NET_IMPLEMENTATION_EPOLL 2)     # Реализация сети на epoll (только Linux)
 #====================================================================
 # Иммитируем перечисление всех реалихаций
 add_definitions(-DNET_IMPLEMENTATION_QT_SIMPLE=${NET_IMPLEMENTATION_QT_SIMPLE})
 add_definitions(-DNET_IMPLEMENTATION_QT_SSL=${NET_IMPLEMENTATION_QT_SSL})
+add_definitions(-DNET_IMPLEMENTATION_EPOLL=${NET_IMPLEMENTATION_EPOLL})
 #====================================================================